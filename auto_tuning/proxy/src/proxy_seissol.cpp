@@ -97,8 +97,10 @@ using namespace proxy::device;
 using namespace proxy::cpu;
 #endif
 
-enum Kernel { all = 0, local, neigh, ader, localwoader, neigh_dr, godunov_dr };
-char const* Kernels[] = {"all", "local", "neigh", "ader", "localwoader", "neigh_dr", "godunov_dr"};
+enum Kernel { all = 0, local, neigh, ader, localwoader, neigh_dr, godunov_dr, friction_lsw, friction_rs_aging, friction_rs_slip, neigh_batched, subsample, subsample_fused,
+              neigh_plasticity, neigh_integrate, neigh_plasticity_integrate };
+char const* Kernels[] = {"all", "local", "neigh", "ader", "localwoader", "neigh_dr", "godunov_dr", "friction_lsw", "friction_rs_aging", "friction_rs_slip", "neigh_batched", "subsample", "subsample_fused",
+                         "neigh_plasticity", "neigh_integrate", "neigh_plasticity_integrate"};
 
 void testKernel(unsigned kernel, unsigned timesteps) {
   unsigned t = 0;
@@ -120,6 +122,16 @@ void testKernel(unsigned kernel, unsigned timesteps) {
         computeNeighboringIntegration();
       }
       break;
+    case neigh_batched:
+      // the neighboring integration of accelerators is always batched
+      for (; t < timesteps; ++t) {
+#ifdef ACL_DEVICE
+        computeNeighboringIntegration();
+#else
+        computeBatchedNeighboringIntegration();
+#endif
+      }
+      break;
     case ader:
       for (; t < timesteps; ++t) {
         computeAderIntegration();
@@ -137,6 +149,42 @@ void testKernel(unsigned kernel, unsigned timesteps) {
       for (; t < timesteps; ++t) {
         computeDynRupGodunovState();
       }
+#endif
+      break;
+    case friction_lsw:
+    case friction_rs_aging:
+    case friction_rs_slip:
+#ifdef ACL_DEVICE
+      logError() << "the friction kernels have not been implemented for acl. device";
+#else
+      for (; t < timesteps; ++t) {
+        computeDynRupFriction();
+      }
+#endif
+      break;
+    case subsample:
+    case subsample_fused:
+      // the wave field output is always computed on the host
+      for (; t < timesteps; ++t) {
+        proxy::cpu::computeSubsampling(kernel == subsample_fused);
+      }
+      break;
+    // the neighbor loop for every combination of the runtime physics features (neigh is the elastic loop)
+    case neigh_plasticity:
+    case neigh_integrate:
+    case neigh_plasticity_integrate:
+#ifdef ACL_DEVICE
+      logError() << "the physics features have not been implemented for acl. device";
+#else
+      for (; t < timesteps; ++t) {
+        if (kernel == neigh_plasticity) {
+          computeNeighboringIntegration<true, false>();
+        } else if (kernel == neigh_integrate) {
+          computeNeighboringIntegration<false, true>();
+        } else {
+          computeNeighboringIntegration<true, true>();
+        }
+      }
 #endif
       break;
     default:
@@ -175,7 +223,7 @@ int main(int argc, char* argv[]) {
   }
   
   bool enableDynamicRupture = false;
-  if (kernel == neigh_dr || kernel == godunov_dr) {
+  if (kernel == neigh_dr || kernel == godunov_dr || kernel == friction_lsw || kernel == friction_rs_aging || kernel == friction_rs_slip) {
     enableDynamicRupture = true;
   }
 
@@ -194,10 +242,35 @@ int main(int argc, char* argv[]) {
 
   printf("Allocating fake data...\n");
   initGlobalData();
-  cells = initDataStructures(cells, enableDynamicRupture);
+  bool const usePlasticity = (kernel == neigh_plasticity || kernel == neigh_plasticity_integrate);
+  bool const integrateQuantities = (kernel == neigh_integrate || kernel == neigh_plasticity_integrate);
+  cells = initDataStructures(cells, enableDynamicRupture, usePlasticity, integrateQuantities);
+  if (usePlasticity) {
+    initPlasticityData();
+  }
+  switch (kernel) {
+    case friction_lsw:
+      initFrictionData(seissol::kernels::FrictionSolver::Law::LinearSlipWeakening);
+      break;
+    case friction_rs_aging:
+      initFrictionData(seissol::kernels::FrictionSolver::Law::RateAndStateAgingLaw);
+      break;
+    case friction_rs_slip:
+      initFrictionData(seissol::kernels::FrictionSolver::Law::RateAndStateSlipLaw);
+      break;
+    default:
+      break;
+  }
 #ifdef ACL_DEVICE
   initDataStructuresOnDevice();
+#else
+  if (kernel == neigh_batched) {
+    initNeighborBatches();
+  }
 #endif // ACL_DEVICE
+  if (kernel == subsample || kernel == subsample_fused) {
+    initSubsampling();
+  }
   printf("...done\n\n");
 
   struct timeval start_time, end_time;
@@ -245,6 +318,11 @@ int main(int argc, char* argv[]) {
       break;
     case neigh:
     case neigh_dr:
+    case neigh_batched:
+    // the flops of the plasticity and the integration of the quantities are not counted
+    case neigh_plasticity:
+    case neigh_integrate:
+    case neigh_plasticity_integrate:
       flop_fun = &flops_neigh_actual;
       bytes_fun = &bytes_neigh;
       break;
@@ -257,9 +335,18 @@ int main(int argc, char* argv[]) {
       bytes_fun = &noestimate;
       break;
     case godunov_dr:
+    // the friction law evaluation is not counted, only the space-time interpolation
+    case friction_lsw:
+    case friction_rs_aging:
+    case friction_rs_slip:
       flop_fun = &flops_drgod_actual;
       bytes_fun = &noestimate;
       break;
+    case subsample:
+    case subsample_fused:
+      flop_fun = &flops_subsample_actual;
+      bytes_fun = &bytes_subsample;
+      break;
   }
   
   seissol_flops actual_flops = (*flop_fun)(timesteps);
@@ -286,6 +373,7 @@ int main(int argc, char* argv[]) {
   printf("=================================================\n");
   printf("\n");
 
+  delete m_subsampler;
   delete m_ltsTree;
   delete m_dynRupTree;
   delete m_allocator;
@@ -58,19 +58,25 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <Initializer/tree/LTSTree.hpp>
 #include <Initializer/DynamicRupture.h>
+#include <Kernels/FrictionSolver.h>
 #include <Initializer/GlobalData.h>
 #include <Solver/time_stepping/MiniSeisSol.cpp>
 #include <yateto.h>
+#include <cmath>
 #include <unordered_set>
 
+#include <Initializer/BatchRecorders/Recorders.h>
+#include <Geometry/refinement/RefinerUtils.h>
+#include <Geometry/refinement/VariableSubSampler.h>
+
 #ifdef ACL_DEVICE
 #include <device.h>
-#include <unordered_set>
-#include <Initializer/BatchRecorders/Recorders.h>
 #endif
 
 seissol::initializers::LTSTree               *m_ltsTree{nullptr};
 seissol::initializers::LTS                   m_lts;
+/// integrals of all quantities, the same work as PostProcessor::integrateQuantities with a full integration mask
+seissol::initializers::Variable<real[9]>     m_integrals;
 seissol::initializers::LTSTree               *m_dynRupTree{nullptr};
 seissol::initializers::DynamicRupture        m_dynRup;
 
@@ -83,11 +89,17 @@ seissol::kernels::Time      m_timeKernel;
 seissol::kernels::Local     m_localKernel;
 seissol::kernels::Neighbor  m_neighborKernel;
 seissol::kernels::DynamicRupture m_dynRupKernel;
+seissol::kernels::FrictionSolver m_frictionSolver;
 
 seissol::memory::ManagedAllocator *m_allocator{nullptr};
 
 real m_timeStepWidthSimulation = (real)1.0;
 
+seissol::refinement::VariableSubsampler<double> *m_subsampler{nullptr};
+std::vector<double> m_subsamplerDofs;
+std::vector<unsigned> m_subsamplerCellMap;
+std::vector<std::vector<double>> m_subsamplerOutput;
+
 namespace tensor = seissol::tensor;
 
 void initGlobalData() {
@@ -110,10 +122,13 @@ void initGlobalData() {
   m_dynRupKernel.setGlobalData(&m_globalDataOnHost);
 }
 
-unsigned int initDataStructures(unsigned int i_cells, bool enableDynamicRupture) {
+unsigned int initDataStructures(unsigned int i_cells, bool enableDynamicRupture, bool usePlasticity, bool integrateQuantities) {
   // init RNG
   srand48(i_cells);
-  m_lts.addTo(*m_ltsTree);
+  m_lts.addTo(*m_ltsTree, usePlasticity);
+  if (integrateQuantities) {
+    m_ltsTree->addVar(m_integrals, seissol::initializers::LayerMask(Ghost), PAGESIZE_HEAP, seissol::memory::Standard);
+  }
   m_ltsTree->setNumberOfTimeClusters(1);
   m_ltsTree->fixate();
   
@@ -198,9 +213,87 @@ unsigned int initDataStructures(unsigned int i_cells, bool enableDynamicRupture)
   return i_cells;
 }
 
-#ifdef ACL_DEVICE
-void initDataStructuresOnDevice() {
+/// TPV13-like plastic parameters, the initial shear stress lies around the yield stress such that about half of the cells yield
+void initPlasticityData() {
+  seissol::initializers::Layer& layer = m_ltsTree->child(0).child<Interior>();
+  PlasticityData* plasticity = layer.var(m_lts.plasticity);
+  double const angularFriction = std::atan(0.85);
+
+  for (unsigned cell = 0; cell < layer.getNumberOfCells(); ++cell) {
+    for (unsigned s = 0; s < 6; ++s) {
+      plasticity[cell].initialLoading[s] = (s < 3) ? -60.0e6 : 0.0;
+    }
+    // Drucker-Prager yield stress: cohesion * cos(phi) - mean stress * sin(phi) = 40 MPa
+    plasticity[cell].initialLoading[3] = 40.0e6 * (0.9 + 0.2 * drand48());
+    plasticity[cell].cohesionTimesCosAngularFriction = 1.0e6 * std::cos(angularFriction);
+    plasticity[cell].sinAngularFriction = std::sin(angularFriction);
+    plasticity[cell].mufactor = 1.0 / (2.0 * 3.0e10);
+    plasticity[cell].evaluate = true;
+  }
+}
+
+void initFrictionData(seissol::kernels::FrictionSolver::Law law) {
+  using Law = seissol::kernels::FrictionSolver::Law;
+  constexpr unsigned ld = seissol::initializers::numberOfPaddedDRPoints;
+
+  seissol::kernels::FrictionSolver::Parameters parameters;
+  parameters.law = law;
+  parameters.t0 = 0.1;
+  parameters.rsF0 = 0.6;
+  parameters.rsA = 0.008;
+  parameters.rsB = 0.012;
+  parameters.rsSl0 = 0.02;
+  parameters.rsSr0 = 1.0e-6;
+  m_frictionSolver.setParameters(parameters);
+  m_dynRupKernel.setTimeStepWidth(1.0e-3);
+
+  // TPV5-like parameters, the shear stress exceeds the static strength at some of the points
+  seissol::initializers::Layer& interior = m_dynRupTree->child(0).child<Interior>();
+  real (*initialStressInFaultCS)[6][ld] = interior.var(m_dynRup.initialStressInFaultCS);
+  real (*cohesion)[ld] = interior.var(m_dynRup.cohesion);
+  real (*muS)[ld] = interior.var(m_dynRup.muS);
+  real (*muD)[ld] = interior.var(m_dynRup.muD);
+  real (*dC)[ld] = interior.var(m_dynRup.dC);
+  real (*forcedRuptureTime)[ld] = interior.var(m_dynRup.forcedRuptureTime);
+  real (*mu)[ld] = interior.var(m_dynRup.mu);
+  real (*slipRate1)[ld] = interior.var(m_dynRup.slipRate1);
+  real (*stateVariable)[ld] = interior.var(m_dynRup.stateVariable);
+  bool (*ruptureFront)[ld] = interior.var(m_dynRup.ruptureFront);
+  bool (*dynStressPending)[ld] = interior.var(m_dynRup.dynStressPending);
+  bool* magnitudeOutput = interior.var(m_dynRup.magnitudeOutput);
+  seissol::model::IsotropicWaveSpeeds* waveSpeedsPlus = interior.var(m_dynRup.waveSpeedsPlus);
+  seissol::model::IsotropicWaveSpeeds* waveSpeedsMinus = interior.var(m_dynRup.waveSpeedsMinus);
+
+  for (unsigned face = 0; face < interior.getNumberOfCells(); ++face) {
+    waveSpeedsPlus[face] = {2670.0, 6000.0, 3464.0};
+    waveSpeedsMinus[face] = {2670.0, 6000.0, 3464.0};
+    magnitudeOutput[face] = true;
+    for (unsigned point = 0; point < ld; ++point) {
+      for (unsigned s = 0; s < 6; ++s) {
+        initialStressInFaultCS[face][s][point] = 0.0;
+      }
+      initialStressInFaultCS[face][0][point] = -120.0e6;
+      initialStressInFaultCS[face][3][point] = 70.0e6 + 15.0e6 * drand48();
+      cohesion[face][point] = 0.0;
+      muS[face][point] = 0.677;
+      muD[face][point] = 0.525;
+      dC[face][point] = 0.4;
+      forcedRuptureTime[face][point] = 1.0e9;
+      ruptureFront[face][point] = true;
+      dynStressPending[face][point] = true;
+      if (law == Law::RateAndStateAgingLaw || law == Law::RateAndStateSlipLaw) {
+        mu[face][point] = parameters.rsF0;
+        slipRate1[face][point] = 1.0e-16;
+        stateVariable[face][point] = parameters.rsSl0 / parameters.rsSr0;
+      } else {
+        mu[face][point] = muS[face][point];
+      }
+    }
+  }
+}
 
+/// Sizes and allocates the scratch pads of the batched computations
+void allocateScratchPads() {
   // estimate sizes required for scratch pads
   constexpr unsigned totalDerivativesSize = yateto::computeFamilySize<tensor::dQ>();
   unsigned derivativesCounter = 0;
@@ -244,17 +337,55 @@ void initDataStructuresOnDevice() {
   }
 
   layer.setScratchpadSize(m_lts.idofsScratch, idofsCounter * tensor::I::size() * sizeof(real));
+#ifdef ACL_DEVICE
   layer.setScratchpadSize(m_lts.derivativesScratch, derivativesCounter * totalDerivativesSize * sizeof(real));
+#endif // ACL_DEVICE
   m_ltsTree->allocateScratchPads();
+}
 
+#ifdef ACL_DEVICE
+void initDataStructuresOnDevice() {
+  allocateScratchPads();
 
   seissol::initializers::recording::CompositeRecorder recorder;
   recorder.addRecorder(new seissol::initializers::recording::LocalIntegrationRecorder);
   recorder.addRecorder(new seissol::initializers::recording::NeighIntegrationRecorder);
+  recorder.record(m_lts, m_ltsTree->child(0).child<Interior>());
+}
+#else // ACL_DEVICE
+/// Records the batches of the neighbor integration on the host (see proxy::cpu::computeBatchedNeighboringIntegration)
+void initNeighborBatches() {
+  allocateScratchPads();
 
-#ifdef USE_PLASTICITY
-  recorder.addRecorder(new seissol::initializers::recording::PlasticityRecorder);
+  seissol::initializers::recording::NeighIntegrationRecorder recorder;
+  recorder.record(m_lts, m_ltsTree->child(0).child<Interior>());
+}
+#endif // ACL_DEVICE
+
+/// Sets up the subsampling of the wave field output with the "Divide by 32" refiner
+void initSubsampling() {
+  seissol::initializers::Layer& layer = m_ltsTree->child(0).child<Interior>();
+  real (*dofs)[tensor::Q::size()] = layer.var(m_lts.dofs);
+  unsigned numberOfCells = layer.getNumberOfCells();
+
+  // the wave field writer subsamples double precision copies of the dofs
+  m_subsamplerDofs.resize(numberOfCells * tensor::Q::size());
+  m_subsamplerCellMap.resize(numberOfCells);
+#ifdef _OPENMP
+  #pragma omp parallel for schedule(static)
 #endif
-  recorder.record(m_lts, layer);
+  for (unsigned cell = 0; cell < numberOfCells; ++cell) {
+    for (unsigned i = 0; i < tensor::Q::size(); ++i) {
+      m_subsamplerDofs[cell * tensor::Q::size() + i] = dofs[cell][i];
+    }
+    m_subsamplerCellMap[cell] = cell;
+  }
+
+  seissol::refinement::DivideTetrahedronBy32<double> refiner;
+  m_subsampler = new seissol::refinement::VariableSubsampler<double>(numberOfCells,
+                                                                     refiner,
+                                                                     CONVERGENCE_ORDER,
+                                                                     tensor::Q::Shape[1],
+                                                                     tensor::Q::Shape[0]);
+  m_subsamplerOutput.assign(tensor::Q::Shape[1], std::vector<double>(numberOfCells * refiner.getDivisionCount()));
 }
-#endif // ACL_DEVICE
\ No newline at end of file
@@ -49,6 +49,17 @@ double bytes_all(unsigned int i_timesteps) {
   return bytes_local(i_timesteps) + bytes_neigh(i_timesteps);
 }
 
+double bytes_subsample(unsigned int i_timesteps) {
+  unsigned nrOfCells = m_ltsTree->child(0).child<Interior>().getNumberOfCells();
+
+  // reads the dofs and writes one value per sub cell and quantity
+  double bytes = sizeof(double) * (tensor::Q::size() + 32.0 * m_subsamplerOutput.size());
+  double elems = static_cast<double>(nrOfCells);
+  double timesteps = static_cast<double>(i_timesteps);
+
+  return elems * timesteps * bytes;
+}
+
 double noestimate(unsigned) {
   return 0.0;
 }
@@ -118,6 +118,20 @@ seissol_flops flops_drgod_actual(unsigned int i_timesteps) {
   return ret;
 }
 
+seissol_flops flops_subsample_actual(unsigned int i_timesteps) {
+  seissol_flops ret;
+
+  // one multiply-add per basis function, sub cell and quantity
+  double basisFunctions = CONVERGENCE_ORDER * (CONVERGENCE_ORDER + 1) * (CONVERGENCE_ORDER + 2) / 6;
+  double subCells = 32.0;
+  double quantities = static_cast<double>(m_subsamplerOutput.size());
+  double nrOfCells = m_ltsTree->child(0).child<Interior>().getNumberOfCells();
+  ret.d_nonZeroFlops = 2.0 * basisFunctions * subCells * quantities * nrOfCells * i_timesteps;
+  ret.d_hardwareFlops = ret.d_nonZeroFlops;
+
+  return ret;
+}
+
 seissol_flops flops_local_actual(unsigned int i_timesteps) {
   seissol_flops ret;
   seissol_flops tmp;
@@ -26,6 +26,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
 #include <generated_code/tensor.h>
+#include <Kernels/Plasticity.h>
+#include <cmath>
 
 namespace tensor = seissol::tensor;
 namespace kernels = seissol::kernels;
@@ -123,12 +125,19 @@ namespace proxy::cpu {
   #endif
   }
 
+  /// Cell loop of the neighbor integration, instantiated for the physics features like TimeCluster::computeNeighboringIntegrationCells
+  template<bool UsePlasticity = false, bool IntegrateQuantities = false>
   void computeNeighboringIntegration() {
     auto&                     layer                           = m_ltsTree->child(0).child<Interior>();
     unsigned                  nrOfCells                       = layer.getNumberOfCells();
     real*                     (*faceNeighbors)[4]             = layer.var(m_lts.faceNeighbors);
     CellDRMapping             (*drMapping)[4]                 = layer.var(m_lts.drMapping);
     CellLocalInformation*       cellInformation               = layer.var(m_lts.cellInformation);
+    PlasticityData*             plasticity                    = layer.var(m_lts.plasticity);
+    real                      (*pstrain)[7]                   = layer.var(m_lts.pstrain);
+    real                      (*integrals)[9]                 = IntegrateQuantities ? layer.var(m_integrals) : nullptr;
+    // relaxation time Tv = 0.05 s
+    double const              relaxTime                       = 1.0 - std::exp(-m_timeStepWidthSimulation / 0.05);
 
     kernels::NeighborData::Loader loader;
     loader.load(m_lts, layer);
@@ -188,6 +197,22 @@ namespace proxy::cpu {
                                                  l_timeIntegrated
   #endif
                                                  );
+
+      if constexpr (UsePlasticity) {
+        if (!seissol::kernels::Plasticity::skipPlasticity(&m_globalDataOnHost, &plasticity[l_cell], data.dofs)) {
+          seissol::kernels::Plasticity::computePlasticity( relaxTime,
+                                                           m_timeStepWidthSimulation,
+                                                           &m_globalDataOnHost,
+                                                           &plasticity[l_cell],
+                                                           data.dofs,
+                                                           pstrain[l_cell] );
+        }
+      }
+      if constexpr (IntegrateQuantities) {
+        for (unsigned quantity = 0; quantity < 9; ++quantity) {
+          integrals[l_cell][quantity] += data.dofs[NUMBER_OF_ALIGNED_BASIS_FUNCTIONS * quantity] * m_timeStepWidthSimulation;
+        }
+      }
     }
 
   #ifdef _OPENMP
@@ -195,6 +220,32 @@ namespace proxy::cpu {
   #endif
   }
 
+  void computeBatchedNeighboringIntegration() {
+    auto&                     layer                           = m_ltsTree->child(0).child<Interior>();
+    ConditionalBatchTableT&   table                           = layer.getCondBatchTable();
+
+    seissol::kernels::TimeCommon::computeBatchedIntegrals( m_timeKernel,
+                                                           0.0,
+                                                           (double)m_timeStepWidthSimulation,
+                                                           table );
+    m_neighborKernel.computeBatchedNeighborsIntegral(table);
+  }
+
+  /// Subsamples all quantities for the wave field output, one variable after another or fused
+  void computeSubsampling(bool fused) {
+    if (fused) {
+      std::vector<double*> outData;
+      for (auto& output : m_subsamplerOutput) {
+        outData.push_back(output.data());
+      }
+      m_subsampler->get(m_subsamplerDofs.data(), m_subsamplerCellMap.data(), outData.data());
+    } else {
+      for (unsigned variable = 0; variable < m_subsamplerOutput.size(); ++variable) {
+        m_subsampler->get(m_subsamplerDofs.data(), m_subsamplerCellMap.data(), variable, m_subsamplerOutput[variable].data());
+      }
+    }
+  }
+
   void computeDynRupGodunovState()
   {
     seissol::initializers::Layer& layerData = m_dynRupTree->child(0).child<Interior>();
@@ -221,4 +272,60 @@ namespace proxy::cpu {
                                               timeDerivativeMinus[prefetchFace] );
     }
   }
+
+  void computeDynRupFriction()
+  {
+    seissol::initializers::Layer& layerData = m_dynRupTree->child(0).child<Interior>();
+    DRFaceInformation* faceInformation = layerData.var(m_dynRup.faceInformation);
+    DRGodunovData* godunovData = layerData.var(m_dynRup.godunovData);
+    real** timeDerivativePlus = layerData.var(m_dynRup.timeDerivativePlus);
+    real** timeDerivativeMinus = layerData.var(m_dynRup.timeDerivativeMinus);
+    real (*imposedStatePlus)[tensor::QInterpolated::size()] = layerData.var(m_dynRup.imposedStatePlus);
+    real (*imposedStateMinus)[tensor::QInterpolated::size()] = layerData.var(m_dynRup.imposedStateMinus);
+    seissol::model::IsotropicWaveSpeeds* waveSpeedsPlus = layerData.var(m_dynRup.waveSpeedsPlus);
+    seissol::model::IsotropicWaveSpeeds* waveSpeedsMinus = layerData.var(m_dynRup.waveSpeedsMinus);
+    unsigned const numberOfFaces = layerData.getNumberOfCells();
+    unsigned const blockSize = kernels::FrictionSolver::BlockSize;
+
+  #ifdef _OPENMP
+    #pragma omp parallel for schedule(static)
+  #endif
+    for (unsigned blockStart = 0; blockStart < numberOfFaces; blockStart += blockSize) {
+      alignas(ALIGNMENT) real QInterpolatedPlus[CONVERGENCE_ORDER][tensor::QInterpolated::size()];
+      alignas(ALIGNMENT) real QInterpolatedMinus[CONVERGENCE_ORDER][tensor::QInterpolated::size()];
+      kernels::FrictionSolver::FaultStresses faultStresses;
+      unsigned const numberOfBlockFaces = std::min(blockSize, numberOfFaces - blockStart);
+
+      for (unsigned blockFace = 0; blockFace < numberOfBlockFaces; ++blockFace) {
+        unsigned face = blockStart + blockFace;
+        unsigned prefetchFace = (face < numberOfFaces-1) ? face+1 : face;
+        m_dynRupKernel.spaceTimeInterpolation(  faceInformation[face],
+                                               &m_globalDataOnHost,
+                                               &godunovData[face],
+                                                timeDerivativePlus[face],
+                                                timeDerivativeMinus[face],
+                                                QInterpolatedPlus,
+                                                QInterpolatedMinus,
+                                                timeDerivativePlus[prefetchFace],
+                                                timeDerivativeMinus[prefetchFace] );
+        m_frictionSolver.computeFaultStresses(  blockFace,
+                                                QInterpolatedPlus,
+                                                QInterpolatedMinus,
+                                                waveSpeedsPlus[face],
+                                                waveSpeedsMinus[face],
+                                                m_dynRupKernel.timeWeights,
+                                                faultStresses,
+                                                imposedStatePlus[face],
+                                                imposedStateMinus[face] );
+      }
+      m_frictionSolver.evaluate(  layerData,
+                                 &m_dynRup,
+                                  blockStart,
+                                  numberOfBlockFaces,
+                                  faultStresses,
+                                  0.0,
+                                  m_dynRupKernel.timePoints,
+                                  m_dynRupKernel.timeWeights );
+    }
+  }
 } // namespace proxy::cpu
@@ -54,7 +54,6 @@ set(RUPTURE_OPTIONS quadrature cellaverage)
 set_property(CACHE DYNAMIC_RUPTURE_METHOD PROPERTY STRINGS ${RUPTURE_OPTIONS})
 
 
-option(PLASTICITY "Use plasticity")
 set(PLASTICITY_METHOD "nb" CACHE STRING "Dynamic rupture method: nb (nodal basis) is faster, ip (interpolation points) possibly more accurate. Recommended: nb")
 set(PLASTICITY_OPTIONS nb ip)
 set_property(CACHE PLASTICITY_METHOD PROPERTY STRINGS ${PLASTICITY_OPTIONS})
@@ -68,6 +67,8 @@ set(MEMORY_LAYOUT "auto" CACHE FILEPATH "A file with a specific memory layout or
 
 option(COMMTHREAD "Use a communication thread for MPI+MP." OFF)
 
+option(SINGLE_PRECISION_COMMUNICATION "Communicate the time-integrated buffers and derivatives in single precision (double precision only)." OFF)
+
 
 set(LOG_LEVEL "warning" CACHE STRING "Log level for the code")
 set(LOG_LEVEL_OPTIONS "debug" "info" "warning" "error")
@@ -165,6 +166,15 @@ if ("${EQUATIONS}" MATCHES "viscoelastic.?" AND ${NUMBER_OF_MECHANISMS} LESS 1)
 endif()
 
 
+if (SINGLE_PRECISION_COMMUNICATION AND NOT "${PRECISION}" STREQUAL "double")
+    message(FATAL_ERROR "SINGLE_PRECISION_COMMUNICATION requires PRECISION=double.")
+endif()
+
+if (SINGLE_PRECISION_COMMUNICATION AND NOT ${DEVICE_ARCH} STREQUAL "none")
+    message(FATAL_ERROR "SINGLE_PRECISION_COMMUNICATION is not supported for GPUs.")
+endif()
+
+
 # derive a byte representation of real numbers
 if ("${PRECISION}" STREQUAL "double")
     set(REAL_SIZE_IN_BYTES 8)
@@ -89,3 +89,14 @@ def addKernels(generator, aderdg):
   QAtPoint = OptionalDimTensor('QAtPoint', aderdg.Q.optName(), aderdg.Q.optSize(), aderdg.Q.optPos(), (numberOfQuantities,))
   evaluateDOFSAtPoint = QAtPoint['p'] <= aderdg.Q['kp'] * basisFunctionsAtPoint['k']
   generator.add('evaluateDOFSAtPoint', evaluateDOFSAtPoint)
+
+  ## Batched receiver output: all receivers of a cell at several sample times.
+  ## Each slice QAtTimes[:,:,n] has the memory layout of Q such that the time
+  ## kernel may write the Taylor expansion directly to it.
+  receiversPerBatch = 4
+  samplesPerBatch = 4
+  basisFunctionsAtPoints = Tensor('basisFunctionsAtPoints', (numberOf3DBasisFunctions, receiversPerBatch))
+  QAtTimes = OptionalDimTensor('QAtTimes', aderdg.Q.optName(), aderdg.Q.optSize(), aderdg.Q.optPos(), (numberOf3DBasisFunctions, numberOfQuantities, samplesPerBatch), alignStride=True)
+  QAtPoints = OptionalDimTensor('QAtPoints', aderdg.Q.optName(), aderdg.Q.optSize(), aderdg.Q.optPos(), (numberOfQuantities, receiversPerBatch, samplesPerBatch))
+  evaluateDOFSAtPoints = QAtPoints['prn'] <= QAtTimes['kpn'] * basisFunctionsAtPoints['kr']
+  generator.add('evaluateDOFSAtPoints', evaluateDOFSAtPoints)
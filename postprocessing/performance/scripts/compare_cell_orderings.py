@@ -0,0 +1,89 @@
+#!/usr/bin/env python3
+##
+# @file
+# This file is part of SeisSol.
+#
+# @section LICENSE
+# Copyright (c) 2020, SeisSol Group
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are met:
+#
+# 1. Redistributions of source code must retain the above copyright notice,
+#    this list of conditions and the following disclaimer.
+#
+# 2. Redistributions in binary form must reproduce the above copyright notice,
+#    this list of conditions and the following disclaimer in the documentation
+#    and/or other materials provided with the distribution.
+#
+# 3. Neither the name of the copyright holder nor the names of its
+#    contributors may be used to endorse or promote products derived from this
+#    software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+# AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+# IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+# ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+# LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+# CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+# SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+# INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+# CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+# ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+# POSSIBILITY OF SUCH DAMAGE.
+#
+# @section DESCRIPTION
+# Benchmarks the orderings of the interior cells (SEISSOL_CELL_ORDERING) by the time per element of the neighbor
+# integration, which SeisSol derives in the regression analysis of the compute kernels (requires MPI).
+# Example:
+#   compare_cell_orderings.py --launcher "mpiexec -n 2" ./SeisSol_Release_dhsw_4_elastic parameters.par
+#
+
+import argparse
+import os
+import re
+import shlex
+import statistics
+import subprocess
+
+l_commandLineParser = argparse.ArgumentParser( description='Compares the neighbor integration time of the SeisSol cell orderings.' )
+l_commandLineParser.add_argument( 'executable', type=str, help='path to the SeisSol executable' )
+l_commandLineParser.add_argument( 'parameterFile', type=str, help='path to the parameter file' )
+l_commandLineParser.add_argument( '--launcher', type=str, default='', help='launcher prepended to the executable, e.g. "mpiexec -n 3"' )
+l_commandLineParser.add_argument( '--repetitions', type=int, default=3, help='number of runs per ordering' )
+l_commandLineParser.add_argument( '--orderings', type=str, nargs='+', default=['mesh', 'hilbert', 'rcm'], help='cell orderings to compare' )
+l_arguments = l_commandLineParser.parse_args()
+
+l_patterns = { 'wall':     re.compile(r'Elapsed time \(via clock_gettime\):\s*([0-9.eE+-]+)'),
+               'neighbor': re.compile(r'computeNeighboringIntegration\s*\(per element\):\s*([0-9.eE+-]+)'),
+               'local':    re.compile(r'computeLocalIntegration\s*\(per element\):\s*([0-9.eE+-]+)') }
+
+def run( i_ordering ):
+  l_environment = dict( os.environ )
+  l_environment['SEISSOL_CELL_ORDERING'] = i_ordering
+  l_command = shlex.split( l_arguments.launcher ) + [ l_arguments.executable, l_arguments.parameterFile ]
+  l_output = subprocess.run( l_command, env=l_environment, stdout=subprocess.PIPE, stderr=subprocess.STDOUT,
+                             universal_newlines=True, check=True ).stdout
+
+  l_times = {}
+  for l_key, l_pattern in l_patterns.items():
+    l_match = l_pattern.search( l_output )
+    if l_match is None:
+      raise RuntimeError( 'Could not find the ' + l_key + ' time in the output of ' + ' '.join(l_command) )
+    l_times[l_key] = float( l_match.group(1) )
+  return l_times
+
+l_results = {}
+for l_ordering in l_arguments.orderings:
+  l_results[l_ordering] = [ run( l_ordering ) for l_repetition in range( l_arguments.repetitions ) ]
+
+print( '{:<10} {:>14} {:>26} {:>23}'.format( 'ordering', 'wall (median)', 'neighbor per elem (median)', 'local per elem (median)' ) )
+for l_ordering, l_runs in l_results.items():
+  l_medians = { l_key: statistics.median( [ l_run[l_key] for l_run in l_runs ] ) for l_key in l_patterns }
+  print( '{:<10} {:>14.4f} {:>26.4e} {:>23.4e}'.format( l_ordering, l_medians['wall'], l_medians['neighbor'], l_medians['local'] ) )
+
+l_reference = statistics.median( [ l_run['neighbor'] for l_run in l_results[l_arguments.orderings[0]] ] )
+for l_ordering in l_arguments.orderings[1:]:
+  l_neighbor = statistics.median( [ l_run['neighbor'] for l_run in l_results[l_ordering] ] )
+  print( 'speedup of the neighbor integration with {} over {}: {:.3f}'.format( l_ordering, l_arguments.orderings[0], l_reference / l_neighbor ) )
@@ -0,0 +1,95 @@
+#!/usr/bin/env python3
+##
+# @file
+# This file is part of SeisSol.
+#
+# @section LICENSE
+# Copyright (c) 2020, SeisSol Group
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are met:
+#
+# 1. Redistributions of source code must retain the above copyright notice,
+#    this list of conditions and the following disclaimer.
+#
+# 2. Redistributions in binary form must reproduce the above copyright notice,
+#    this list of conditions and the following disclaimer in the documentation
+#    and/or other materials provided with the distribution.
+#
+# 3. Neither the name of the copyright holder nor the names of its
+#    contributors may be used to endorse or promote products derived from this
+#    software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+# AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+# IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+# ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+# LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+# CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+# SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+# INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+# CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+# ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+# POSSIBILITY OF SUCH DAMAGE.
+#
+# @section DESCRIPTION
+# Benchmarks the HDF5 checkpoint modes (SEISSOL_CHECKPOINT_COMPRESSION, SEISSOL_CHECKPOINT_DELTA).
+# The parameter file must use checkPointBackend = 'hdf5' and a checkpoint interval that yields several checkpoints.
+# Existing checkpoints with the given prefix are removed before each run, e.g.
+#   compare_checkpoint_modes.py --launcher "mpiexec -n 4" ./SeisSol_Release_dhsw_6_elastic parameters.par ../output/check
+#
+
+import argparse
+import glob
+import os
+import re
+import shlex
+import statistics
+import subprocess
+
+l_commandLineParser = argparse.ArgumentParser( description='Compares bytes written and time per checkpoint of the HDF5 checkpoint modes.' )
+l_commandLineParser.add_argument( 'executable', type=str, help='path to the SeisSol executable' )
+l_commandLineParser.add_argument( 'parameterFile', type=str, help='path to the parameter file' )
+l_commandLineParser.add_argument( 'checkPointFile', type=str, help='checkPointFile of the parameter file' )
+l_commandLineParser.add_argument( '--launcher', type=str, default='', help='launcher prepended to the executable, e.g. "mpiexec -n 3"' )
+l_commandLineParser.add_argument( '--level', type=int, default=4, help='deflate level for the compressed modes' )
+l_arguments = l_commandLineParser.parse_args()
+
+l_modes = { 'plain':            { 'SEISSOL_CHECKPOINT_COMPRESSION': '0',                       'SEISSOL_CHECKPOINT_DELTA': '0' },
+            'delta':            { 'SEISSOL_CHECKPOINT_COMPRESSION': '0',                       'SEISSOL_CHECKPOINT_DELTA': '1' },
+            'compressed':       { 'SEISSOL_CHECKPOINT_COMPRESSION': str(l_arguments.level), 'SEISSOL_CHECKPOINT_DELTA': '0' },
+            'compressed+delta': { 'SEISSOL_CHECKPOINT_COMPRESSION': str(l_arguments.level), 'SEISSOL_CHECKPOINT_DELTA': '1' } }
+
+l_writtenPattern = re.compile(r'Checkpoint backend: Wrote\s*([0-9]+)\s*of\s*([0-9]+)\s*bytes of the (wave field|fault), storage size\s*([0-9]+)')
+l_timePattern = re.compile(r'Checkpoint backend: Time for this checkpoint:\s*([0-9.eE+-]+)')
+
+def run( i_mode ):
+  for l_file in glob.glob( l_arguments.checkPointFile + '*' ):
+    os.remove( l_file )
+
+  l_environment = dict( os.environ )
+  l_environment.update( l_modes[i_mode] )
+  l_command = shlex.split( l_arguments.launcher ) + [ l_arguments.executable, l_arguments.parameterFile ]
+  l_output = subprocess.run( l_command, env=l_environment, stdout=subprocess.PIPE, stderr=subprocess.STDOUT,
+                             universal_newlines=True, check=True ).stdout
+
+  # sum up the wave field and the fault per checkpoint
+  l_written = []
+  l_storage = []
+  for l_match in l_writtenPattern.finditer( l_output ):
+    if l_match.group(3) == 'wave field':
+      l_written.append( 0 )
+      l_storage.append( 0 )
+    l_written[-1] += int( l_match.group(1) )
+    l_storage[-1] += int( l_match.group(4) )
+  l_times = [ float(l_match.group(1)) for l_match in l_timePattern.finditer( l_output ) ]
+  if not l_written or not l_times:
+    raise RuntimeError( 'Could not find any checkpoint in the output of ' + ' '.join(l_command) )
+  return l_written, l_storage, l_times
+
+print( '{:<18} {:>12} {:>22} {:>22} {:>20}'.format( 'mode', 'checkpoints', 'written [MiB] (mean)', 'storage [MiB] (mean)', 'time [s] (median)' ) )
+for l_mode in l_modes:
+  l_written, l_storage, l_times = run( l_mode )
+  print( '{:<18} {:>12} {:>22.2f} {:>22.2f} {:>20.4f}'.format( l_mode, len(l_times),
+         statistics.mean( l_written ) / 2**20, statistics.mean( l_storage ) / 2**20, statistics.median( l_times ) ) )
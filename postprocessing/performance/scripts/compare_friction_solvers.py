@@ -0,0 +1,86 @@
+#!/usr/bin/env python3
+##
+# @file
+# This file is part of SeisSol.
+#
+# @section LICENSE
+# Copyright (c) 2020, SeisSol Group
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are met:
+#
+# 1. Redistributions of source code must retain the above copyright notice,
+#    this list of conditions and the following disclaimer.
+#
+# 2. Redistributions in binary form must reproduce the above copyright notice,
+#    this list of conditions and the following disclaimer in the documentation
+#    and/or other materials provided with the distribution.
+#
+# 3. Neither the name of the copyright holder nor the names of its
+#    contributors may be used to endorse or promote products derived from this
+#    software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+# AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+# IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+# ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+# LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+# CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+# SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+# INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+# CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+# ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+# POSSIBILITY OF SUCH DAMAGE.
+#
+# @section DESCRIPTION
+# Benchmarks the Fortran friction law evaluation against the layer-wise friction solver (SEISSOL_FRICTION_SOLVER).
+# Pass one parameter file per friction law, e.g. the SCEC TPV5 (linear slip weakening) and TPV101/102 (rate-and-state) setups:
+#   compare_friction_solvers.py --launcher "mpiexec -n 2" ./SeisSol_Release_dhsw_4_elastic tpv5.par tpv101.par
+#
+
+import argparse
+import os
+import re
+import shlex
+import statistics
+import subprocess
+
+l_commandLineParser = argparse.ArgumentParser( description='Compares the dynamic rupture time of the SeisSol friction solvers.' )
+l_commandLineParser.add_argument( 'executable', type=str, help='path to the SeisSol executable' )
+l_commandLineParser.add_argument( 'parameterFiles', type=str, nargs='+', help='parameter files, one per friction law' )
+l_commandLineParser.add_argument( '--launcher', type=str, default='', help='launcher prepended to the executable, e.g. "mpiexec -n 3"' )
+l_commandLineParser.add_argument( '--repetitions', type=int, default=3, help='number of runs per friction solver' )
+l_commandLineParser.add_argument( '--solvers', type=str, nargs='+', default=['fortran', 'batched'], help='friction solvers to compare' )
+l_arguments = l_commandLineParser.parse_args()
+
+l_patterns = { 'wall':          re.compile(r'Elapsed time \(via clock_gettime\):\s*([0-9.eE+-]+)'),
+               'dynamicRupture': re.compile(r'computeDynamicRupture\s*\(per element\):\s*([0-9.eE+-]+)'),
+               'law':           re.compile(r'Evaluating friction law\s*([0-9]+)') }
+
+def run( i_parameterFile, i_solver ):
+  l_environment = dict( os.environ )
+  l_environment['SEISSOL_FRICTION_SOLVER'] = i_solver
+  l_command = shlex.split( l_arguments.launcher ) + [ l_arguments.executable, i_parameterFile ]
+  l_output = subprocess.run( l_command, env=l_environment, stdout=subprocess.PIPE, stderr=subprocess.STDOUT,
+                             universal_newlines=True, check=True ).stdout
+
+  l_values = {}
+  for l_key, l_pattern in l_patterns.items():
+    l_match = l_pattern.search( l_output )
+    if l_match is None:
+      raise RuntimeError( 'Could not find ' + l_key + ' in the output of ' + ' '.join(l_command) )
+    l_values[l_key] = float( l_match.group(1) )
+  return l_values
+
+print( '{:<24} {:>4} {:<8} {:>14} {:>22}'.format( 'parameter file', 'law', 'solver', 'wall (median)', 'DR per face (median)' ) )
+for l_parameterFile in l_arguments.parameterFiles:
+  l_medians = {}
+  for l_solver in l_arguments.solvers:
+    l_runs = [ run( l_parameterFile, l_solver ) for l_repetition in range( l_arguments.repetitions ) ]
+    l_wall = statistics.median( [ l_run['wall'] for l_run in l_runs ] )
+    l_dynamicRupture = statistics.median( [ l_run['dynamicRupture'] for l_run in l_runs ] )
+    l_medians[l_solver] = l_dynamicRupture
+    print( '{:<24} {:>4} {:<8} {:>14.4f} {:>22.4e}'.format( os.path.basename(l_parameterFile), int(l_runs[0]['law']), l_solver, l_wall, l_dynamicRupture ) )
+  for l_solver in l_arguments.solvers[1:]:
+    print( '  speedup of {} over {} (dynamic rupture): {:.3f}'.format( l_solver, l_arguments.solvers[0], l_medians[l_arguments.solvers[0]] / l_medians[l_solver] ) )
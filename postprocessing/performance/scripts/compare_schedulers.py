@@ -0,0 +1,90 @@
+#!/usr/bin/env python3
+##
+# @file
+# This file is part of SeisSol.
+#
+# @section LICENSE
+# Copyright (c) 2020, SeisSol Group
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are met:
+#
+# 1. Redistributions of source code must retain the above copyright notice,
+#    this list of conditions and the following disclaimer.
+#
+# 2. Redistributions in binary form must reproduce the above copyright notice,
+#    this list of conditions and the following disclaimer in the documentation
+#    and/or other materials provided with the distribution.
+#
+# 3. Neither the name of the copyright holder nor the names of its
+#    contributors may be used to endorse or promote products derived from this
+#    software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+# AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+# IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+# ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+# LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+# CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+# SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+# INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+# CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+# ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+# POSSIBILITY OF SUCH DAMAGE.
+#
+# @section DESCRIPTION
+# Benchmarks the queue based scheduler against the task graph scheduler (SEISSOL_SCHEDULER).
+# Example (minimal test mesh, parameter file referencing src/tests/minimal/mesh/sample):
+#   compare_schedulers.py --launcher "mpiexec -n 3" --repetitions 3 ./SeisSol_Release_dhsw_4_elastic parameters.par
+#
+
+import argparse
+import os
+import re
+import shlex
+import statistics
+import subprocess
+
+l_commandLineParser = argparse.ArgumentParser( description='Compares the wall time of the SeisSol schedulers.' )
+l_commandLineParser.add_argument( 'executable', type=str, help='path to the SeisSol executable' )
+l_commandLineParser.add_argument( 'parameterFile', type=str, help='path to the parameter file' )
+l_commandLineParser.add_argument( '--launcher', type=str, default='', help='launcher prepended to the executable, e.g. "mpiexec -n 3"' )
+l_commandLineParser.add_argument( '--repetitions', type=int, default=3, help='number of runs per scheduler' )
+l_commandLineParser.add_argument( '--chunkSize', type=int, default=256, help='value of SEISSOL_TASKGRAPH_CHUNK_SIZE' )
+l_commandLineParser.add_argument( '--schedulers', type=str, nargs='+', default=['queues', 'taskgraph'], help='schedulers to compare' )
+l_arguments = l_commandLineParser.parse_args()
+
+l_patterns = { 'wall':    re.compile(r'Elapsed time \(via clock_gettime\):\s*([0-9.eE+-]+)'),
+               'kernels': re.compile(r'Total time spent in compute kernels:\s*([0-9.eE+-]+)') }
+
+def run( i_scheduler ):
+  l_environment = dict( os.environ )
+  l_environment['SEISSOL_SCHEDULER'] = i_scheduler
+  l_environment['SEISSOL_TASKGRAPH_CHUNK_SIZE'] = str( l_arguments.chunkSize )
+  l_command = shlex.split( l_arguments.launcher ) + [ l_arguments.executable, l_arguments.parameterFile ]
+  l_output = subprocess.run( l_command, env=l_environment, stdout=subprocess.PIPE, stderr=subprocess.STDOUT,
+                             universal_newlines=True, check=True ).stdout
+
+  l_times = {}
+  for l_key, l_pattern in l_patterns.items():
+    l_match = l_pattern.search( l_output )
+    if l_match is None:
+      raise RuntimeError( 'Could not find the ' + l_key + ' time in the output of ' + ' '.join(l_command) )
+    l_times[l_key] = float( l_match.group(1) )
+  return l_times
+
+l_results = {}
+for l_scheduler in l_arguments.schedulers:
+  l_results[l_scheduler] = [ run( l_scheduler ) for l_repetition in range( l_arguments.repetitions ) ]
+
+print( '{:<12} {:>14} {:>14} {:>18}'.format( 'scheduler', 'wall (median)', 'wall (min)', 'kernels (median)' ) )
+for l_scheduler, l_runs in l_results.items():
+  l_wall = [ l_run['wall'] for l_run in l_runs ]
+  l_kernels = [ l_run['kernels'] for l_run in l_runs ]
+  print( '{:<12} {:>14.4f} {:>14.4f} {:>18.4f}'.format( l_scheduler, statistics.median(l_wall), min(l_wall), statistics.median(l_kernels) ) )
+
+l_reference = statistics.median( [ l_run['wall'] for l_run in l_results[l_arguments.schedulers[0]] ] )
+for l_scheduler in l_arguments.schedulers[1:]:
+  l_wall = statistics.median( [ l_run['wall'] for l_run in l_results[l_scheduler] ] )
+  print( 'speedup of {} over {}: {:.3f}'.format( l_scheduler, l_arguments.schedulers[0], l_reference / l_wall ) )
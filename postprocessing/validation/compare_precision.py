@@ -0,0 +1,92 @@
+#!/usr/bin/env python3
+##
+# @file
+# This file is part of SeisSol.
+#
+# @section LICENSE
+# Copyright (c) 2020, SeisSol Group
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are met:
+#
+# 1. Redistributions of source code must retain the above copyright notice,
+#    this list of conditions and the following disclaimer.
+#
+# 2. Redistributions in binary form must reproduce the above copyright notice,
+#    this list of conditions and the following disclaimer in the documentation
+#    and/or other materials provided with the distribution.
+#
+# 3. Neither the name of the copyright holder nor the names of its
+#    contributors may be used to endorse or promote products derived from this
+#    software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+# AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+# IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+# ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+# LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+# CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+# SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+# INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+# CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+# ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+# POSSIBILITY OF SUCH DAMAGE.
+#
+# @section DESCRIPTION
+# Compares the error norms of a double precision and a build with single precision communication (SINGLE_PRECISION_COMMUNICATION).
+# Both executables run the same convergence test, e.g. a planar wave with an enabled analysis.
+# Example:
+#   compare_precision.py --launcher "mpiexec -n 4" ./SeisSol_Release_dhsw_4_elastic ./SeisSol_Release_dhsw_4_elastic_spcomm parameters.par
+#
+
+import argparse
+import re
+import shlex
+import subprocess
+import sys
+
+l_commandLineParser = argparse.ArgumentParser( description='Checks the accuracy of the single precision communication against a double precision run.' )
+l_commandLineParser.add_argument( 'reference', type=str, help='path to the double precision SeisSol executable' )
+l_commandLineParser.add_argument( 'executable', type=str, help='path to the SeisSol executable with single precision communication' )
+l_commandLineParser.add_argument( 'parameterFile', type=str, help='path to the parameter file of the convergence test' )
+l_commandLineParser.add_argument( '--launcher', type=str, default='', help='launcher prepended to the executables, e.g. "mpiexec -n 4"' )
+l_commandLineParser.add_argument( '--rtol', type=float, default=0.05, help='tolerated relative deviation of the error norms' )
+l_commandLineParser.add_argument( '--atol', type=float, default=1.0e-6, help='tolerated absolute deviation of the error norms' )
+l_arguments = l_commandLineParser.parse_args()
+
+l_pattern = re.compile( r'(L1|L2|LInf)\s*,\s*var\[\s*(\d+)\s*\]\s*=\s*([0-9.eE+-]+)' )
+
+def run( i_executable ):
+  l_command = shlex.split( l_arguments.launcher ) + [ i_executable, l_arguments.parameterFile ]
+  l_output = subprocess.run( l_command, stdout=subprocess.PIPE, stderr=subprocess.STDOUT,
+                             universal_newlines=True, check=True ).stdout
+
+  # the analysis is printed once per simulation, the last one wins
+  l_errors = {}
+  for l_match in l_pattern.finditer( l_output ):
+    l_errors[ (l_match.group(1), int(l_match.group(2))) ] = float( l_match.group(3) )
+  if not l_errors:
+    raise RuntimeError( 'Could not find the error norms in the output of ' + ' '.join(l_command) + ', is the analysis enabled?' )
+  return l_errors
+
+l_reference = run( l_arguments.reference )
+l_errors = run( l_arguments.executable )
+
+l_failed = False
+print( '{:<6} {:>5} {:>16} {:>16} {:>12}'.format( 'norm', 'var', 'double', 'spcomm', 'rel. dev.' ) )
+for l_key in sorted( l_reference.keys(), key=lambda l_k: (l_k[1], l_k[0]) ):
+  if l_key not in l_errors:
+    print( 'missing {} of var {} in the run with single precision communication'.format( *l_key ) )
+    l_failed = True
+    continue
+  l_deviation = abs( l_errors[l_key] - l_reference[l_key] )
+  l_relative = l_deviation / max( l_reference[l_key], sys.float_info.min )
+  l_ok = l_deviation <= l_arguments.rtol * l_reference[l_key] + l_arguments.atol
+  l_failed = l_failed or not l_ok
+  print( '{:<6} {:>5} {:>16.6e} {:>16.6e} {:>12.3e}{}'.format( l_key[0], l_key[1], l_reference[l_key], l_errors[l_key], l_relative, '' if l_ok else '  FAILED' ) )
+
+if l_failed:
+  print( 'The error norms of the run with single precision communication deviate from the double precision run.' )
+  sys.exit( 1 )
+print( 'The error norms of both runs agree.' )
@@ -0,0 +1,110 @@
+#!/usr/bin/env python3
+##
+# @file
+# This file is part of SeisSol.
+#
+# @section LICENSE
+# Copyright (c) 2020, SeisSol Group
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are met:
+#
+# 1. Redistributions of source code must retain the above copyright notice,
+#    this list of conditions and the following disclaimer.
+#
+# 2. Redistributions in binary form must reproduce the above copyright notice,
+#    this list of conditions and the following disclaimer in the documentation
+#    and/or other materials provided with the distribution.
+#
+# 3. Neither the name of the copyright holder nor the names of its
+#    contributors may be used to endorse or promote products derived from this
+#    software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+# AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+# IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+# ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+# LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+# CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+# SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+# INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+# CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+# ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+# POSSIBILITY OF SUCH DAMAGE.
+#
+# @section DESCRIPTION
+# Converts the binary receiver files (SEISSOL_RECEIVER_OUTPUT=binary) to the ASCII receiver files, e.g.
+#   receivers2dat.py output/prefix-receivers-*.bin
+#
+
+import argparse
+import array
+import re
+import struct
+import sys
+
+l_commandLineParser = argparse.ArgumentParser( description='Converts binary receiver files to one ASCII file per receiver.' )
+l_commandLineParser.add_argument( 'files', type=str, nargs='+', help='binary receiver files (*-receivers-*.bin)' )
+l_commandLineParser.add_argument( '--output', type=str, default=None, help='output prefix (default: prefix of the binary files)' )
+l_arguments = l_commandLineParser.parse_args()
+
+MAGIC = b'SEISRECV'
+VARIABLES = 0
+POINT = 1
+SAMPLES = 2
+
+l_variables = None
+l_points = {}
+l_samples = {}
+
+for l_fileName in l_arguments.files:
+  l_prefix = l_arguments.output or re.sub(r'-receivers-[0-9]+\.bin$', '', l_fileName)
+  with open( l_fileName, 'rb' ) as l_file:
+    l_data = l_file.read()
+  if l_data[0:8] != MAGIC:
+    raise ValueError( l_fileName + ' is not a binary receiver file' )
+  l_version, = struct.unpack_from( '<Q', l_data, 8 )
+  if l_version != 1:
+    raise ValueError( 'Unsupported version {} of '.format(l_version) + l_fileName )
+
+  l_offset = 16
+  while l_offset < len(l_data):
+    l_type, l_pointId, l_size = struct.unpack_from( '<IIQ', l_data, l_offset )
+    l_offset += 16
+    l_payload = l_data[l_offset:l_offset+l_size]
+    l_offset += l_size
+
+    if l_type == VARIABLES:
+      l_variables = l_payload.decode().strip()
+    elif l_type == POINT:
+      # restarted simulations repeat the points
+      l_coordinates = struct.unpack_from( '<3d', l_payload )
+      l_rank, = struct.unpack_from( '<q', l_payload, 24 )
+      l_points[l_pointId] = (l_prefix, l_coordinates, l_rank)
+      l_samples.setdefault( l_pointId, [] )
+    elif l_type == SAMPLES:
+      l_values = array.array( 'd' )
+      l_values.frombytes( l_payload )
+      if sys.byteorder != 'little':
+        l_values.byteswap()
+      l_samples[l_pointId].append( l_values )
+    else:
+      raise ValueError( 'Unknown record type {} in '.format(l_type) + l_fileName )
+
+l_numberOfColumns = len( l_variables.split(',') )
+
+for l_pointId in sorted(l_points):
+  l_prefix, l_coordinates, l_rank = l_points[l_pointId]
+  l_name = '{}-receiver-{:05d}'.format( l_prefix, l_pointId+1 )
+  if l_rank >= 0:
+    l_name += '-{:05d}'.format( l_rank )
+  with open( l_name + '.dat', 'w' ) as l_out:
+    l_out.write( 'TITLE = "Temporal Signal for receiver number {:05d}"\n'.format( l_pointId+1 ) )
+    l_out.write( 'VARIABLES = {}\n'.format( l_variables ) )
+    for l_dim in range(3):
+      l_out.write( '# x{}       {:.12e}\n'.format( l_dim+1, l_coordinates[l_dim] ) )
+    for l_values in l_samples[l_pointId]:
+      for l_row in range( len(l_values) // l_numberOfColumns ):
+        l_out.write( ''.join( '  {:.15e}'.format(l_value) for l_value in l_values[l_row*l_numberOfColumns:(l_row+1)*l_numberOfColumns] ) + '\n' )
+  print( 'Wrote ' + l_name + '.dat' )
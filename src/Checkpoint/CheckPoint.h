@@ -110,6 +110,9 @@ private:
 	/** Was the checkpoint loaded */
 	bool m_loaded;
 
+	/** Was the checkpoint written with a different partitioning */
+	bool m_redistributed;
+
 public:
 	CheckPoint(unsigned long identifier)
 		: m_identifier(identifier),
@@ -120,7 +123,7 @@ public:
 		  m_odd(0), // Start with even checkpoint
 		  m_numTotalElems(0), m_fileOffset(0),
 		  m_groupSize(0), m_numGroupElems(0), m_groupOffset(0),
-		  m_loaded(false)
+		  m_loaded(false), m_redistributed(false)
 	{}
 
 	virtual ~CheckPoint() {}
@@ -140,6 +143,15 @@ public:
 		m_loaded = true;
 	}
 
+	/**
+	 * @return True if the loaded checkpoint was written with a different partitioning.
+	 *  The old files cannot be reused for writing in this case.
+	 */
+	bool redistributed() const
+	{
+		return m_redistributed;
+	}
+
 	/**
 	 * Update checkpoint symlink
 	 */
@@ -337,6 +349,14 @@ protected:
 		return m_loaded;
 	}
 
+	/**
+	 * Should be called when a checkpoint was loaded with a different partitioning
+	 */
+	void setRedistributed()
+	{
+		m_redistributed = true;
+	}
+
 #ifdef USE_MPI
 	MPI_Comm comm() const
 	{
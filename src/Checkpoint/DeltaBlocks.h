@@ -0,0 +1,216 @@
+/**
+ * @file
+ * This file is part of SeisSol.
+ *
+ * @section LICENSE
+ * Copyright (c) 2020, SeisSol Group
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @section DESCRIPTION
+ * Detects blocks of a checkpoint that do not need to be written again.
+ */
+
+#ifndef CHECKPOINT_DELTA_BLOCKS_H
+#define CHECKPOINT_DELTA_BLOCKS_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace seissol
+{
+
+namespace checkpoint
+{
+
+/**
+ * Checkpoints alternate between two files. A block is still valid in a file
+ * if it did not change since the checkpoint written to the same file, i.e.
+ * two checkpoints ago. This is the case for quiet regions of the wave field and
+ * for parts of the fault that are locked or already stopped slipping.
+ *
+ * Blocks are compared by a 64 bit hash. A hash collision keeps the old content
+ * of the block in the file. To bound the lifetime of such a block, every block
+ * can be rewritten periodically.
+ */
+class DeltaBlocks
+{
+private:
+	/** Size of the data in bytes */
+	unsigned long m_size;
+
+	/** Size of a block in bytes */
+	unsigned long m_blockSize;
+
+	/** Hashes of the blocks in the even and the odd file */
+	std::vector<uint64_t> m_hashes[2];
+
+	/** Do the hashes belong to the content of the file? */
+	bool m_valid[2];
+
+	/** Write all blocks every m_fullInterval updates of a file (0 = never) */
+	unsigned long m_fullInterval;
+
+	/** Number of updates of the even and the odd file */
+	unsigned long m_updates[2];
+
+	/** Blocks that changed in the last update */
+	std::vector<char> m_changed;
+
+public:
+	DeltaBlocks()
+		: m_size(0), m_blockSize(1), m_fullInterval(0)
+	{
+		m_valid[0] = m_valid[1] = false;
+		m_updates[0] = m_updates[1] = 0;
+	}
+
+	/**
+	 * @param size Size of the data in bytes
+	 * @param blockSize Size of a block in bytes
+	 * @param fullInterval Write all blocks of a file every fullInterval updates (0 = never)
+	 */
+	void init(unsigned long size, unsigned long blockSize, unsigned long fullInterval = 0)
+	{
+		m_size = size;
+		m_blockSize = std::max(blockSize, 1ul);
+		m_fullInterval = fullInterval;
+
+		const unsigned long numBlocks = (size + m_blockSize - 1) / m_blockSize;
+		for (unsigned int i = 0; i < 2; i++) {
+			m_hashes[i].assign(numBlocks, 0);
+			m_valid[i] = false;
+			m_updates[i] = 0;
+		}
+		m_changed.assign(numBlocks, 1);
+	}
+
+	/**
+	 * Compares the data with the content of the file and marks the changed blocks.
+	 * Afterwards, the changed blocks must be written to the file.
+	 *
+	 * @return The number of bytes in changed blocks
+	 */
+	unsigned long update(int odd, const void* data)
+	{
+		const unsigned char* bytes = static_cast<const unsigned char*>(data);
+
+		const bool full = !m_valid[odd] || (m_fullInterval > 0 && m_updates[odd] % m_fullInterval == 0);
+		m_updates[odd]++;
+
+		unsigned long changedSize = 0;
+		for (unsigned long i = 0; i < numBlocks(); i++) {
+			const unsigned long size = blockEnd(i) - i * m_blockSize;
+			const uint64_t h = hash(bytes + i * m_blockSize, size);
+
+			m_changed[i] = full || h != m_hashes[odd][i];
+			m_hashes[odd][i] = h;
+			if (m_changed[i])
+				changedSize += size;
+		}
+		m_valid[odd] = true;
+
+		return changedSize;
+	}
+
+	unsigned long numBlocks() const
+	{
+		return m_changed.size();
+	}
+
+	unsigned long blockSize() const
+	{
+		return m_blockSize;
+	}
+
+	/**
+	 * @return The end of the block in bytes
+	 */
+	unsigned long blockEnd(unsigned long block) const
+	{
+		return std::min((block + 1) * m_blockSize, m_size);
+	}
+
+	bool changed(unsigned long block) const
+	{
+		return m_changed[block];
+	}
+
+	/**
+	 * @param blockSize Requested block size in bytes (1 selects the default)
+	 * @param unit Size of the units in which the blocks are selected in bytes
+	 * @return True if the block size is 1 or a positive multiple of unit
+	 */
+	static bool validBlockSize(long blockSize, unsigned long unit)
+	{
+		return blockSize == 1 || (blockSize > 1 && static_cast<unsigned long>(blockSize) % unit == 0);
+	}
+
+private:
+	static uint64_t rotl(uint64_t x, int r)
+	{
+		return (x << r) | (x >> (64 - r));
+	}
+
+	/**
+	 * Hashes the data with four independent lanes (similar to xxHash64)
+	 */
+	static uint64_t hash(const unsigned char* data, unsigned long size)
+	{
+		const uint64_t prime1 = 11400714785074694791ull;
+		const uint64_t prime2 = 14029467366897019727ull;
+
+		uint64_t lanes[4] = {prime1 + prime2, prime2, 0, prime1};
+		unsigned long i = 0;
+		for (; i + 4 * sizeof(uint64_t) <= size; i += 4 * sizeof(uint64_t)) {
+			for (unsigned int l = 0; l < 4; l++) {
+				uint64_t word;
+				memcpy(&word, data + i + l * sizeof(uint64_t), sizeof(uint64_t));
+				lanes[l] = rotl(lanes[l] + word * prime2, 31) * prime1;
+			}
+		}
+
+		uint64_t h = rotl(lanes[0], 1) + rotl(lanes[1], 7) + rotl(lanes[2], 12) + rotl(lanes[3], 18);
+		for (; i < size; i++)
+			h = rotl(h ^ (data[i] * prime1), 11) * prime2;
+
+		h ^= size;
+		h ^= h >> 33;
+		h *= prime2;
+		h ^= h >> 29;
+		return h;
+	}
+};
+
+}
+
+}
+
+#endif // CHECKPOINT_DELTA_BLOCKS_H
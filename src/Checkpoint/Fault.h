@@ -72,14 +72,28 @@ private:
 	/** Number of boundary points per side */
 	unsigned int m_numBndGP;
 
+	/** Global ids of the dynamic rupture sides (or NULL if the mesh has no global ids) */
+	const unsigned long* m_faceIds;
+
 public:
 	Fault(unsigned long identifier)
 		: CheckPoint(identifier),
-		  m_numSides(0), m_numBndGP(0)
+		  m_numSides(0), m_numBndGP(0),
+		  m_faceIds(0L)
 	{}
 
 	virtual ~Fault() {}
 
+	/**
+	 * Set the global face ids, required to load checkpoints with a different partitioning.
+	 *
+	 * Must be called before init().
+	 */
+	void setFaceIds(const unsigned long* faceIds)
+	{
+		m_faceIds = faceIds;
+	}
+
 	/**
 	 * @return True of a valid checkpoint is available
 	 */
@@ -209,6 +223,11 @@ protected:
 		return m_numBndGP;
 	}
 
+	const unsigned long* faceIds() const
+	{
+		return m_faceIds;
+	}
+
 	/** Names of the different variables we need to store */
 	static const char* VAR_NAMES[NUM_VARIABLES];
 };
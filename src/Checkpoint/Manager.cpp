@@ -43,10 +43,10 @@
 #include "Manager.h"
 #include "SeisSol.h"
 
-bool seissol::checkpoint::Manager::init(real* dofs, unsigned int numDofs,
+bool seissol::checkpoint::Manager::init(real* dofs, unsigned int numDofs, const unsigned long* cellIds, unsigned int numCells,
 		double* mu, double* slipRate1, double* slipRate2, double* slip, double* slip1, double* slip2,
 		double* state, double* strength, unsigned int numSides, unsigned int numBndGP,
-		int &faultTimeStep)
+		const unsigned long* faceIds, int &faultTimeStep)
 {
 		if (m_backend == DISABLED) {
 			// Always allocate the header struct because other still use it
@@ -90,12 +90,22 @@ bool seissol::checkpoint::Manager::init(real* dofs, unsigned int numDofs,
 		addBuffer(state, m_numDRDofs * sizeof(double));
 		addBuffer(strength, m_numDRDofs * sizeof(double));
 
+		// Buffers for the global ids
+		id = addBuffer(cellIds, (cellIds ? numCells : 0) * sizeof(unsigned long));
+		assert(id == CELL_IDS);
+		id = addBuffer(faceIds, (faceIds ? numSides : 0) * sizeof(unsigned long));
+		assert(id == FAULT_IDS);
+
 		//
 		// Initialization for loading checkpoints
 		//
 		waveField->setFilename(m_filename.c_str());
 		fault->setFilename(m_filename.c_str());
 
+		if (cellIds)
+			waveField->setCellIds(cellIds, numCells);
+		fault->setFaceIds(faceIds);
+
 		int exists = waveField->init(m_header.size(), numDofs, seissol::SeisSol::main.asyncIO().groupSize());
 		exists &= fault->init(numSides, numBndGP,
 			seissol::SeisSol::main.asyncIO().groupSize());
@@ -116,6 +126,12 @@ bool seissol::checkpoint::Manager::init(real* dofs, unsigned int numDofs,
 			waveField->initHeader(m_header);
 		}
 
+		// Files written with a different partitioning cannot be reused
+		int redistributed = waveField->redistributed() || fault->redistributed();
+#ifdef USE_MPI
+		MPI_Allreduce(MPI_IN_PLACE, &redistributed, 1, MPI_INT, MPI_LOR, seissol::MPI::mpi.comm());
+#endif // USE_MPI
+
 		waveField->close();
 		fault->close();
 
@@ -123,15 +139,19 @@ bool seissol::checkpoint::Manager::init(real* dofs, unsigned int numDofs,
 		delete fault;
 
 		sendBuffer(FILENAME,  m_filename.size()+1);
+		sendBuffer(CELL_IDS);
+		sendBuffer(FAULT_IDS);
 
 		// Initialize the executor
 		CheckpointInitParam param;
 		param.backend = m_backend;
 		param.numBndGP = numBndGP;
-		param.loaded = exists;
+		param.loaded = exists && !redistributed;
 		callInit(param);
 
 		removeBuffer(FILENAME);
+		removeBuffer(CELL_IDS);
+		removeBuffer(FAULT_IDS);
 
 		return exists;
 }
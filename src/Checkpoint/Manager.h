@@ -113,6 +113,16 @@ public:
 		m_filename = filename;
 	}
 
+	Backend backend() const
+	{
+		return m_backend;
+	}
+
+	const std::string& filename() const
+	{
+		return m_filename;
+	}
+
 
 	/**
 	 * This is called on all ranks
@@ -130,12 +140,15 @@ public:
 	/**
 	 * Initialize checkpointing and load the last checkpoint if present
 	 *
+	 * @param cellIds Global ids of the cells (or NULL), required to load checkpoints
+	 *  written with a different partitioning
+	 * @param faceIds Global ids of the dynamic rupture sides (or NULL)
 	 * @return True is a checkpoint was loaded, false otherwise
 	 */
-	bool init(real* dofs, unsigned int numDofs,
+	bool init(real* dofs, unsigned int numDofs, const unsigned long* cellIds, unsigned int numCells,
 			double* mu, double* slipRate1, double* slipRate2, double* slip, double* slip1, double* slip2,
 			double* state, double* strength, unsigned int numSides, unsigned int numBndGP,
-			int &faultTimeStep);
+			const unsigned long* faceIds, int &faultTimeStep);
 
 	/**
 	 * Write a checkpoint for the current time
@@ -56,7 +56,10 @@ enum BufferTags {
 	FILENAME = 0,
 	HEADER = 1,
 	DOFS = 2,
-	DR_DOFS0 = 3
+	DR_DOFS0 = 3,
+	/** Global ids, follow the 8 dynamic rupture buffers */
+	CELL_IDS = 11,
+	FAULT_IDS = 12
 };
 
 /**
@@ -111,6 +114,12 @@ public:
 		m_waveField->setFilename(filename);
 		m_fault->setFilename(filename);
 
+		if (info.bufferSize(CELL_IDS) > 0)
+			m_waveField->setCellIds(static_cast<const unsigned long*>(info.buffer(CELL_IDS)),
+				info.bufferSize(CELL_IDS) / sizeof(unsigned long));
+		if (info.bufferSize(FAULT_IDS) > 0)
+			m_fault->setFaceIds(static_cast<const unsigned long*>(info.buffer(FAULT_IDS)));
+
 		m_waveField->init(info.bufferSize(HEADER), info.bufferSize(DOFS) / sizeof(real));
 		m_fault->init(info.bufferSize(DR_DOFS0) / param.numBndGP / sizeof(double), param.numBndGP);
 
@@ -147,6 +156,8 @@ public:
 		m_waveField->writePrepare(info.buffer(HEADER), info.bufferSize(HEADER));
 		m_fault->writePrepare(param.faultTimeStep);
 
+		logInfo(seissol::MPI::mpi.rank()) << "Checkpoint backend: Time for this checkpoint:" << m_stopwatch.split();
+
 		m_stopwatch.pause();
 	}
 
@@ -0,0 +1,252 @@
+/**
+ * @file
+ * This file is part of SeisSol.
+ *
+ * @section LICENSE
+ * Copyright (c) 2020, SeisSol Group
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @section DESCRIPTION
+ * Exchanges data stored by global ids between an arbitrary and the current partitioning.
+ */
+
+#include "Parallel/MPI.h"
+
+#include <cstring>
+#include <unordered_map>
+#include <utility>
+
+#include "Redistributor.h"
+
+namespace
+{
+
+/** Offers and requests sent to the directory */
+struct IdEntry
+{
+	unsigned long id;
+	/** Index on the rank that holds or requires the value */
+	unsigned long index;
+};
+
+/** Requests forwarded from the directory to the rank that holds the value */
+struct ForwardEntry
+{
+	/** Index on the holding rank */
+	unsigned long index;
+	unsigned long requester;
+	/** Index on the requesting rank */
+	unsigned long requestIndex;
+};
+
+/**
+ * Sorts the entries by the destination rank
+ */
+template<typename T>
+void pack(const std::vector<std::pair<int, T> > &entries, int partitions,
+	std::vector<char> &sendBuffer, std::vector<int> &sendCounts)
+{
+	sendCounts.assign(partitions, 0);
+	for (typename std::vector<std::pair<int, T> >::const_iterator it = entries.begin();
+			it != entries.end(); ++it)
+		sendCounts[it->first]++;
+
+	std::vector<unsigned long> offsets(partitions, 0);
+	for (int i = 1; i < partitions; i++)
+		offsets[i] = offsets[i-1] + sendCounts[i-1];
+
+	sendBuffer.resize(entries.size() * sizeof(T));
+	for (typename std::vector<std::pair<int, T> >::const_iterator it = entries.begin();
+			it != entries.end(); ++it)
+		memcpy(&sendBuffer[(offsets[it->first]++) * sizeof(T)], &it->second, sizeof(T));
+}
+
+}
+
+const unsigned long seissol::checkpoint::Redistributor::INVALID_ID;
+
+#ifdef USE_MPI
+seissol::checkpoint::Redistributor::Redistributor(MPI_Comm comm)
+	: m_comm(comm)
+{
+	MPI_Comm_rank(comm, &m_rank);
+	MPI_Comm_size(comm, &m_partitions);
+}
+#else // USE_MPI
+seissol::checkpoint::Redistributor::Redistributor()
+	: m_rank(0), m_partitions(1)
+{
+}
+#endif // USE_MPI
+
+unsigned long seissol::checkpoint::Redistributor::redistribute(size_t valueSize,
+	unsigned long numAvailable, const unsigned long* availableIds, const void* availableValues,
+	unsigned long numRequired, const unsigned long* requiredIds, void* requiredValues) const
+{
+	std::vector<char> sendBuffer;
+	std::vector<int> sendCounts;
+
+	// Send offers to the directory
+	std::vector<std::pair<int, IdEntry> > entries;
+	entries.reserve(numAvailable);
+	for (unsigned long i = 0; i < numAvailable; i++) {
+		if (availableIds[i] == INVALID_ID)
+			continue;
+		IdEntry entry = {availableIds[i], i};
+		entries.push_back(std::make_pair(static_cast<int>(availableIds[i] % m_partitions), entry));
+	}
+	pack(entries, m_partitions, sendBuffer, sendCounts);
+
+	std::vector<char> offers;
+	std::vector<int> offerCounts;
+	exchange(sizeof(IdEntry), sendBuffer, sendCounts, offers, offerCounts);
+
+	// Send requests to the directory
+	entries.clear();
+	entries.reserve(numRequired);
+	for (unsigned long i = 0; i < numRequired; i++) {
+		if (requiredIds[i] == INVALID_ID)
+			continue;
+		IdEntry entry = {requiredIds[i], i};
+		entries.push_back(std::make_pair(static_cast<int>(requiredIds[i] % m_partitions), entry));
+	}
+	pack(entries, m_partitions, sendBuffer, sendCounts);
+	std::vector<std::pair<int, IdEntry> >().swap(entries);
+
+	std::vector<char> requests;
+	std::vector<int> requestCounts;
+	exchange(sizeof(IdEntry), sendBuffer, sendCounts, requests, requestCounts);
+
+	// Build the directory, the first offer wins
+	std::unordered_map<unsigned long, std::pair<int, unsigned long> > directory;
+	const IdEntry* offerEntries = reinterpret_cast<const IdEntry*>(offers.data());
+	unsigned long k = 0;
+	for (int p = 0; p < m_partitions; p++) {
+		for (int i = 0; i < offerCounts[p]; i++, k++)
+			directory.insert(std::make_pair(offerEntries[k].id, std::make_pair(p, offerEntries[k].index)));
+	}
+	std::vector<char>().swap(offers);
+
+	// Forward the requests to the holders
+	unsigned long numMissing = 0;
+	std::vector<std::pair<int, ForwardEntry> > forwards;
+	const IdEntry* requestEntries = reinterpret_cast<const IdEntry*>(requests.data());
+	k = 0;
+	for (int p = 0; p < m_partitions; p++) {
+		for (int i = 0; i < requestCounts[p]; i++, k++) {
+			std::unordered_map<unsigned long, std::pair<int, unsigned long> >::const_iterator holder
+				= directory.find(requestEntries[k].id);
+			if (holder == directory.end()) {
+				numMissing++;
+				continue;
+			}
+
+			ForwardEntry forward = {holder->second.second, static_cast<unsigned long>(p), requestEntries[k].index};
+			forwards.push_back(std::make_pair(holder->second.first, forward));
+		}
+	}
+	std::vector<char>().swap(requests);
+	pack(forwards, m_partitions, sendBuffer, sendCounts);
+	std::vector<std::pair<int, ForwardEntry> >().swap(forwards);
+
+	std::vector<char> forwarded;
+	std::vector<int> forwardCounts;
+	exchange(sizeof(ForwardEntry), sendBuffer, sendCounts, forwarded, forwardCounts);
+
+	// Send the values to the requesters (request index followed by the value)
+	const size_t entrySize = sizeof(unsigned long) + valueSize;
+	const ForwardEntry* forwardEntries = reinterpret_cast<const ForwardEntry*>(forwarded.data());
+	const unsigned long numForwarded = forwarded.size() / sizeof(ForwardEntry);
+
+	sendCounts.assign(m_partitions, 0);
+	for (unsigned long i = 0; i < numForwarded; i++)
+		sendCounts[forwardEntries[i].requester]++;
+	std::vector<unsigned long> offsets(m_partitions, 0);
+	for (int p = 1; p < m_partitions; p++)
+		offsets[p] = offsets[p-1] + sendCounts[p-1];
+
+	sendBuffer.resize(numForwarded * entrySize);
+	for (unsigned long i = 0; i < numForwarded; i++) {
+		char* entry = &sendBuffer[(offsets[forwardEntries[i].requester]++) * entrySize];
+		memcpy(entry, &forwardEntries[i].requestIndex, sizeof(unsigned long));
+		memcpy(entry + sizeof(unsigned long),
+			static_cast<const char*>(availableValues) + forwardEntries[i].index * valueSize, valueSize);
+	}
+	std::vector<char>().swap(forwarded);
+
+	std::vector<char> values;
+	std::vector<int> valueCounts;
+	exchange(entrySize, sendBuffer, sendCounts, values, valueCounts);
+	std::vector<char>().swap(sendBuffer);
+
+	const unsigned long numValues = values.size() / entrySize;
+	for (unsigned long i = 0; i < numValues; i++) {
+		unsigned long index;
+		memcpy(&index, &values[i * entrySize], sizeof(unsigned long));
+		memcpy(static_cast<char*>(requiredValues) + index * valueSize,
+			&values[i * entrySize + sizeof(unsigned long)], valueSize);
+	}
+
+#ifdef USE_MPI
+	MPI_Allreduce(MPI_IN_PLACE, &numMissing, 1, MPI_UNSIGNED_LONG, MPI_SUM, m_comm);
+#endif // USE_MPI
+
+	return numMissing;
+}
+
+void seissol::checkpoint::Redistributor::exchange(size_t entrySize,
+	const std::vector<char> &sendBuffer, const std::vector<int> &sendCounts,
+	std::vector<char> &recvBuffer, std::vector<int> &recvCounts) const
+{
+#ifdef USE_MPI
+	recvCounts.resize(m_partitions);
+	MPI_Alltoall(const_cast<int*>(sendCounts.data()), 1, MPI_INT, recvCounts.data(), 1, MPI_INT, m_comm);
+
+	std::vector<int> sendDispls(m_partitions, 0);
+	std::vector<int> recvDispls(m_partitions, 0);
+	for (int p = 1; p < m_partitions; p++) {
+		sendDispls[p] = sendDispls[p-1] + sendCounts[p-1];
+		recvDispls[p] = recvDispls[p-1] + recvCounts[p-1];
+	}
+	recvBuffer.resize(static_cast<size_t>(recvDispls[m_partitions-1] + recvCounts[m_partitions-1]) * entrySize);
+
+	// Count entries instead of bytes to avoid overflows
+	MPI_Datatype entryType;
+	MPI_Type_contiguous(entrySize, MPI_BYTE, &entryType);
+	MPI_Type_commit(&entryType);
+
+	MPI_Alltoallv(const_cast<char*>(sendBuffer.data()), const_cast<int*>(sendCounts.data()), sendDispls.data(), entryType,
+		recvBuffer.data(), recvCounts.data(), recvDispls.data(), entryType, m_comm);
+
+	MPI_Type_free(&entryType);
+#else // USE_MPI
+	recvBuffer = sendBuffer;
+	recvCounts = sendCounts;
+#endif // USE_MPI
+}
@@ -0,0 +1,118 @@
+/**
+ * @file
+ * This file is part of SeisSol.
+ *
+ * @section LICENSE
+ * Copyright (c) 2020, SeisSol Group
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @section DESCRIPTION
+ * Exchanges data stored by global ids between an arbitrary and the current partitioning.
+ */
+
+#ifndef CHECKPOINT_REDISTRIBUTOR_H
+#define CHECKPOINT_REDISTRIBUTOR_H
+
+#ifdef USE_MPI
+#include <mpi.h>
+#endif // USE_MPI
+
+#include <cstddef>
+#include <vector>
+
+namespace seissol
+{
+
+namespace checkpoint
+{
+
+/**
+ * Moves values identified by global ids from the ranks that read them
+ * to the ranks that require them.
+ *
+ * The ranks are connected by a directory: The rank <code>id % partitions</code>
+ * knows which rank holds the value with a given id.
+ */
+class Redistributor
+{
+public:
+	/** Marks entries that should neither be sent nor received */
+	static const unsigned long INVALID_ID = ~0ul;
+
+private:
+#ifdef USE_MPI
+	MPI_Comm m_comm;
+#endif // USE_MPI
+
+	int m_rank;
+
+	int m_partitions;
+
+public:
+#ifdef USE_MPI
+	Redistributor(MPI_Comm comm);
+#else // USE_MPI
+	Redistributor();
+#endif // USE_MPI
+
+	/**
+	 * Collective operation. Ids may be available several times, in which case
+	 * an arbitrary copy is used.
+	 *
+	 * Requires four exchanges (offers and requests to the directory, forwarded
+	 * requests to the holders, values to the requesters), each consisting of
+	 * an MPI_Alltoall of the counts and an MPI_Alltoallv of the entries.
+	 *
+	 * @param valueSize Size of one value in bytes
+	 * @param availableIds Global ids of the values read by this rank
+	 * @param availableValues The values read by this rank
+	 * @param requiredIds Global ids of the values required on this rank (may contain duplicates)
+	 * @param[out] requiredValues Buffer for the required values
+	 * @return The total number of required ids that are not available on any rank
+	 */
+	unsigned long redistribute(size_t valueSize,
+		unsigned long numAvailable, const unsigned long* availableIds, const void* availableValues,
+		unsigned long numRequired, const unsigned long* requiredIds, void* requiredValues) const;
+
+private:
+	/**
+	 * Sends <code>sendCounts[p]</code> entries with <code>entrySize</code> bytes to rank <code>p</code>
+	 *
+	 * @param sendBuffer The entries, sorted by the destination rank
+	 * @param[out] recvCounts The number of entries received from each rank
+	 */
+	void exchange(size_t entrySize, const std::vector<char> &sendBuffer, const std::vector<int> &sendCounts,
+		std::vector<char> &recvBuffer, std::vector<int> &recvCounts) const;
+};
+
+}
+
+}
+
+#endif // CHECKPOINT_REDISTRIBUTOR_H
@@ -75,6 +75,12 @@ private:
 	/** Number of dofs */
 	unsigned long m_numDofs;
 
+	/** Global ids of the cells (or NULL if the mesh has no global ids) */
+	const unsigned long* m_cellIds;
+
+	/** Number of cells */
+	unsigned long m_numCells;
+
 	/** Number of (local) iterations we need to save all data (due to the 2GB limit) */
 	unsigned int m_iterations;
 
@@ -89,6 +95,7 @@ public:
 		: CheckPoint(identifier),
 		  m_header(0L),
 		  m_dofs(0L), m_numDofs(0),
+		  m_cellIds(0L), m_numCells(0),
 		  m_iterations(0), m_totalIterations(0),
 		  m_dofsPerIteration((1ul<<30) / sizeof(real))
 	{}
@@ -108,6 +115,19 @@ public:
 		m_header = &header;
 	}
 
+	/**
+	 * Set the global cell ids, required to load checkpoints with a different partitioning.
+	 *
+	 * Must be called before init(). The degrees of freedom of all cells must have the same size.
+	 *
+	 * @param cellIds Global id for each cell, invalid cells are marked with std::numeric_limits<unsigned long>::max()
+	 */
+	void setCellIds(const unsigned long* cellIds, unsigned long numCells)
+	{
+		m_cellIds = cellIds;
+		m_numCells = numCells;
+	}
+
 	/**
 	 * Initialize checkpointing
 	 *
@@ -240,6 +260,16 @@ protected:
 		return m_numDofs;
 	}
 
+	const unsigned long* cellIds() const
+	{
+		return m_cellIds;
+	}
+
+	unsigned long numCells() const
+	{
+		return m_numCells;
+	}
+
 	unsigned int iterations() const
 	{
 		return m_iterations;
@@ -45,15 +45,18 @@
 
 #include <hdf5.h>
 
+#include "utils/env.h"
 #include "utils/logger.h"
 #include "utils/path.h"
 
 #include "H5ErrHandler.h"
 #include "Checkpoint/CheckPoint.h"
+#include "Checkpoint/DeltaBlocks.h"
 #ifdef USE_MPI
 #include "Checkpoint/MPIInfo.h"
 #endif // USE_MPI
 #include "Initializer/preProcessorMacros.fpp"
+#include "Kernels/precision.hpp"
 
 namespace seissol
 {
@@ -73,12 +76,40 @@ private:
 	/** Property list for data access */
 	hid_t m_h5XferList;
 
+	/** Deflate level for new data sets (0 disables compression) */
+	int m_compression;
+
+	/** Only write blocks that changed since the last checkpoint in the same file */
+	bool m_delta;
+
+	/** Rewrite all blocks of a file every m_deltaFullInterval checkpoints (0 = never) */
+	unsigned long m_deltaFullInterval;
+
+	/** Size of the chunks and the delta blocks in bytes */
+	unsigned long m_chunkSize;
+
 public:
 	CheckPoint(unsigned long identifier)
 		: seissol::checkpoint::CheckPoint(identifier),
-		m_h5XferList(-1)
+		m_h5XferList(-1),
+		m_compression(utils::Env::get<int>("SEISSOL_CHECKPOINT_COMPRESSION", 0)),
+		m_delta(utils::Env::get<bool>("SEISSOL_CHECKPOINT_DELTA", false)),
+		m_deltaFullInterval(utils::Env::get<unsigned long>("SEISSOL_CHECKPOINT_DELTA_FULL_INTERVAL", 0)),
+		m_chunkSize(8ul << 20)
 	{
 		m_h5files[0] = m_h5files[1] = -1;
+
+		// The delta blocks are selected in units of real
+		int blockSize = utils::Env::get<int>("SEISSOL_CHECKPOINT_BLOCK_SIZE", 1);
+		if (!DeltaBlocks::validBlockSize(blockSize, sizeof(real)))
+			logError() << "SEISSOL_CHECKPOINT_BLOCK_SIZE must be 1 or a positive multiple of" << sizeof(real) << "bytes.";
+		if (blockSize > 1)
+			m_chunkSize = blockSize;
+
+		if (m_compression < 0 || m_compression > 9)
+			logError() << "SEISSOL_CHECKPOINT_COMPRESSION must be between 0 and 9.";
+		if (m_compression > 0 && H5Zfilter_avail(H5Z_FILTER_DEFLATE) <= 0)
+			logError() << "The HDF5 library does not support deflate compression for checkpoints.";
 	}
 
 	virtual ~CheckPoint()
@@ -167,6 +198,53 @@ protected:
 		return m_h5XferList;
 	}
 
+	bool delta() const
+	{
+		return m_delta;
+	}
+
+	unsigned long deltaFullInterval() const
+	{
+		return m_deltaFullInterval;
+	}
+
+	unsigned long chunkSize() const
+	{
+		return m_chunkSize;
+	}
+
+	/**
+	 * Sets the layout of a new data set. With compression, the data set is chunked
+	 * and compressed with the shuffle and the deflate filter.
+	 *
+	 * @param chunkDims Size of a chunk (ignored without compression)
+	 */
+	void setLayout(hid_t h5plist, int dims, const hsize_t* chunkDims) const
+	{
+		if (m_compression > 0) {
+			checkH5Err(H5Pset_chunk(h5plist, dims, chunkDims));
+			checkH5Err(H5Pset_shuffle(h5plist));
+			checkH5Err(H5Pset_deflate(h5plist, m_compression));
+		} else {
+			checkH5Err(H5Pset_layout(h5plist, H5D_CONTIGUOUS));
+			checkH5Err(H5Pset_alloc_time(h5plist, H5D_ALLOC_TIME_EARLY));
+		}
+	}
+
+	/**
+	 * Prints the number of bytes passed to HDF5 by all ranks and the size of the data in the file
+	 */
+	void logWrittenBytes(const char* name, unsigned long writtenBytes, unsigned long totalBytes, hsize_t storageSize) const
+	{
+		unsigned long bytes[2] = {writtenBytes, totalBytes};
+#ifdef USE_MPI
+		MPI_Allreduce(MPI_IN_PLACE, bytes, 2, MPI_UNSIGNED_LONG, MPI_SUM, comm());
+#endif // USE_MPI
+
+		logInfo(rank()) << "Checkpoint backend: Wrote" << bytes[0] << "of" << bytes[1] << "bytes of the" << name
+			<< utils::nospace << ", storage size" << utils::space << storageSize << "bytes.";
+	}
+
 	/**
 	 * Open a check point file
 	 *
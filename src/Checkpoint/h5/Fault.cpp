@@ -37,7 +37,11 @@
  * @section DESCRIPTION
  */
 
+#include <algorithm>
+#include <vector>
+
 #include "Fault.h"
+#include "Checkpoint/Redistributor.h"
 
 #ifdef USE_MPI
 #include "Checkpoint/MPIInfo.h"
@@ -59,6 +63,13 @@ bool seissol::checkpoint::h5::Fault::init(unsigned int numSides, unsigned int nu
 	m_h5fSpaceData = H5Screate_simple(2, fileSize, 0L);
 	checkH5Err(m_h5fSpaceData);
 
+	if (delta()) {
+		// Blocks contain complete sides
+		const unsigned long sideSize = numBndGP * sizeof(double);
+		for (unsigned int i = 0; i < NUM_VARIABLES; i++)
+			m_deltaBlocks[i].init(numSides * sideSize, std::max(chunkSize() / sideSize, 1ul) * sideSize, deltaFullInterval());
+	}
+
 	setupXferList();
 
 	return exists();
@@ -83,6 +94,14 @@ void seissol::checkpoint::h5::Fault::load(int &timestepFault, double* mu, double
 	checkH5Err(H5Aread(h5attr, H5T_NATIVE_INT, &timestepFault));
 	checkH5Err(H5Aclose(h5attr));
 
+	double* data[NUM_VARIABLES] = {mu, slipRate1, slipRate2, slip, slip1, slip2, state, strength};
+
+	if (!samePartitioning(h5file)) {
+		loadRedistributed(h5file, data);
+		checkH5Err(H5Fclose(h5file));
+		return;
+	}
+
 	// Set the memory space (this is the same for all variables)
 	hsize_t count[2] = {numSides(), numBndGP()};
 	hid_t h5memSpace = H5Screate_simple(2, count, 0L);
@@ -92,8 +111,6 @@ void seissol::checkpoint::h5::Fault::load(int &timestepFault, double* mu, double
 	// Offset for the file space
 	hsize_t fStart[2] = {fileOffset(), 0};
 
-	double* data[NUM_VARIABLES] = {mu, slipRate1, slipRate2, slip, slip1, slip2, state, strength};
-
 	// Read the data
 	for (unsigned int i = 0; i < NUM_VARIABLES; i++) {
 		hid_t h5data = H5Dopen(h5file, VAR_NAMES[i], H5P_DEFAULT);
@@ -142,13 +159,28 @@ void seissol::checkpoint::h5::Fault::write(int timestepFault)
 	checkH5Err(H5Sselect_all(h5memSpace));
 	checkH5Err(H5Sselect_hyperslab(m_h5fSpaceData, H5S_SELECT_SET, fStart, 0L, count, 0L));
 
+	const unsigned long varSize = numSides() * numBndGP() * sizeof(double);
+	unsigned long writtenBytes = 0;
+	hsize_t storageSize = 0;
 	for (unsigned int i = 0; i < NUM_VARIABLES; i++) {
+		// Only write sides that changed since the last checkpoint in this file
+		if (delta()) {
+			writtenBytes += m_deltaBlocks[i].update(odd(), data(i));
+			selectSides(h5memSpace, m_deltaBlocks[i]);
+		} else {
+			writtenBytes += varSize;
+		}
+
 		checkH5Err(H5Dwrite(m_h5data[odd()][i], H5T_NATIVE_DOUBLE, h5memSpace, m_h5fSpaceData,
 				h5XferList(), data(i)));
+
+		storageSize += H5Dget_storage_size(m_h5data[odd()][i]);
 	}
 
 	checkH5Err(H5Sclose(h5memSpace));
 
+	logWrittenBytes("fault", writtenBytes, NUM_VARIABLES * varSize, storageSize);
+
 	EPIK_USER_END(r_write_fault);
 	SCOREP_USER_REGION_END(r_write_fault);
 
@@ -163,6 +195,9 @@ bool seissol::checkpoint::h5::Fault::validate(hid_t h5file) const
 	// Turn of error printing
 	H5ErrHandler errHandler;
 
+	// Checkpoints with global face ids can be loaded with any partitioning
+	bool canRedistribute = faceIds() && H5Lexists(h5file, "faceIds", H5P_DEFAULT) > 0;
+
 	// Check dimensions
 	for (unsigned int i = 0; i < NUM_VARIABLES; i++) {
 		hid_t h5data = H5Dopen(h5file, VAR_NAMES[i], H5P_DEFAULT);
@@ -190,7 +225,7 @@ bool seissol::checkpoint::h5::Fault::validate(hid_t h5file) const
 				isValid = false;
 				logWarning(rank()) << "Could not get dimension sizes for" << VAR_NAMES[i] << "of checkpoint.";
 			} else {
-				if (dimSize[0] != numTotalElems()) {
+				if (dimSize[0] != numTotalElems() && !canRedistribute) {
 					isValid = false;
 					logWarning(rank()) << "Number of elements for" << VAR_NAMES[i] << "in checkpoint does not match.";
 				}
@@ -257,18 +292,196 @@ hid_t seissol::checkpoint::h5::Fault::initFile(int odd, const char* filename)
 		checkH5Err(H5Sclose(h5spaceScalar));
 
 		// Variables
+		hsize_t chunk[2] = {std::max(std::min(chunkSize() / (numBndGP() * sizeof(double)), numTotalElems()), 1ul),
+			numBndGP()};
 		for (unsigned int i = 0; i < NUM_VARIABLES; i++) {
 			h5plist = H5Pcreate(H5P_DATASET_CREATE);
 			checkH5Err(h5plist);
-			checkH5Err(H5Pset_layout(h5plist, H5D_CONTIGUOUS));
-			checkH5Err(H5Pset_alloc_time(h5plist, H5D_ALLOC_TIME_EARLY));
+			setLayout(h5plist, 2, chunk);
 			m_h5data[odd][i] = H5Dcreate(h5file, VAR_NAMES[i], H5T_IEEE_F64LE, m_h5fSpaceData,
 				H5P_DEFAULT, h5plist, H5P_DEFAULT);
 			checkH5Err(m_h5data[odd][i]);
 			checkH5Err(H5Pclose(h5plist));
 		}
+
+		// Global face ids
+		if (faceIds()) {
+			hsize_t fileSize = numTotalElems();
+			hid_t h5space = H5Screate_simple(1, &fileSize, 0L);
+			checkH5Err(h5space);
+			hid_t h5data = H5Dcreate(h5file, "faceIds", H5T_STD_U64LE, h5space,
+				H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+			checkH5Err(h5data);
+
+			hsize_t fStart = fileOffset();
+			hsize_t count = numSides();
+			hid_t h5memSpace = H5Screate_simple(1, &count, 0L);
+			checkH5Err(h5memSpace);
+			checkH5Err(H5Sselect_all(h5memSpace));
+			checkH5Err(H5Sselect_hyperslab(h5space, H5S_SELECT_SET, &fStart, 0L, &count, 0L));
+			checkH5Err(H5Dwrite(h5data, H5T_NATIVE_ULONG, h5memSpace, h5space,
+				h5XferList(), faceIds()));
+			checkH5Err(H5Sclose(h5memSpace));
+			checkH5Err(H5Sclose(h5space));
+			checkH5Err(H5Dclose(h5data));
+		}
 	}
 
 	return h5file;
 }
 
+bool seissol::checkpoint::h5::Fault::samePartitioning(hid_t h5file)
+{
+	int same = 1;
+
+	hid_t h5data = H5Dopen(h5file, VAR_NAMES[0], H5P_DEFAULT);
+	checkH5Err(h5data);
+	hid_t h5space = H5Dget_space(h5data);
+	checkH5Err(h5space);
+	hsize_t dimSize[2];
+	checkH5Err(H5Sget_simple_extent_dims(h5space, dimSize, 0L));
+	checkH5Err(H5Sclose(h5space));
+	checkH5Err(H5Dclose(h5data));
+	if (dimSize[0] != numTotalElems())
+		same = 0;
+
+	// The same number of sides does not imply the same partitioning
+	if (same && faceIds() && H5Lexists(h5file, "faceIds", H5P_DEFAULT) > 0) {
+		h5data = H5Dopen(h5file, "faceIds", H5P_DEFAULT);
+		checkH5Err(h5data);
+		h5space = H5Dget_space(h5data);
+		checkH5Err(h5space);
+
+		std::vector<unsigned long> fileIds(numSides());
+		hsize_t fStart = fileOffset();
+		hsize_t count = numSides();
+		hid_t h5memSpace = H5Screate_simple(1, &count, 0L);
+		checkH5Err(h5memSpace);
+		checkH5Err(H5Sselect_all(h5memSpace));
+		checkH5Err(H5Sselect_hyperslab(h5space, H5S_SELECT_SET, &fStart, 0L, &count, 0L));
+		checkH5Err(H5Dread(h5data, H5T_NATIVE_ULONG, h5memSpace, h5space,
+				h5XferList(), fileIds.data()));
+		checkH5Err(H5Sclose(h5memSpace));
+		checkH5Err(H5Sclose(h5space));
+		checkH5Err(H5Dclose(h5data));
+
+		if (!std::equal(faceIds(), faceIds() + numSides(), fileIds.begin()))
+			same = 0;
+	}
+
+#ifdef USE_MPI
+	MPI_Allreduce(MPI_IN_PLACE, &same, 1, MPI_INT, MPI_LAND, comm());
+#endif // USE_MPI
+
+	return same;
+}
+
+void seissol::checkpoint::h5::Fault::loadRedistributed(hid_t h5file, double* const data[NUM_VARIABLES])
+{
+	logInfo(rank()) << "Checkpoint was written with a different partitioning, redistributing the fault";
+
+	setRedistributed();
+
+	// Every rank reads a contiguous part of the sides
+	hid_t h5data = H5Dopen(h5file, "faceIds", H5P_DEFAULT);
+	checkH5Err(h5data);
+	hid_t h5space = H5Dget_space(h5data);
+	checkH5Err(h5space);
+	hsize_t numFileSides;
+	checkH5Err(H5Sget_simple_extent_dims(h5space, &numFileSides, 0L));
+
+	const unsigned long firstSide = numFileSides * rank() / partitions();
+	const unsigned long numReadSides = numFileSides * (rank() + 1) / partitions() - firstSide;
+
+	std::vector<unsigned long> readIds(std::max(numReadSides, 1ul));
+	hsize_t fStart[2] = {firstSide, 0};
+	hsize_t count[2] = {std::max(numReadSides, 1ul), numBndGP()};
+	hid_t h5memSpace = H5Screate_simple(1, count, 0L);
+	checkH5Err(h5memSpace);
+	if (numReadSides > 0) {
+		count[0] = numReadSides;
+		checkH5Err(H5Sselect_all(h5memSpace));
+		checkH5Err(H5Sselect_hyperslab(h5space, H5S_SELECT_SET, fStart, 0L, count, 0L));
+	} else {
+		checkH5Err(H5Sselect_none(h5memSpace));
+		checkH5Err(H5Sselect_none(h5space));
+	}
+	checkH5Err(H5Dread(h5data, H5T_NATIVE_ULONG, h5memSpace, h5space,
+			h5XferList(), readIds.data()));
+	checkH5Err(H5Sclose(h5memSpace));
+	checkH5Err(H5Sclose(h5space));
+	checkH5Err(H5Dclose(h5data));
+
+	// Read all variables of these sides
+	std::vector<double> readData(std::max(numReadSides, 1ul) * NUM_VARIABLES * numBndGP());
+	std::vector<double> varData(std::max(numReadSides, 1ul) * numBndGP());
+	h5memSpace = H5Screate_simple(2, count, 0L);
+	checkH5Err(h5memSpace);
+	if (numReadSides > 0)
+		checkH5Err(H5Sselect_all(h5memSpace));
+	else
+		checkH5Err(H5Sselect_none(h5memSpace));
+
+	for (unsigned int i = 0; i < NUM_VARIABLES; i++) {
+		h5data = H5Dopen(h5file, VAR_NAMES[i], H5P_DEFAULT);
+		checkH5Err(h5data);
+		hid_t h5fSpace = H5Dget_space(h5data);
+		checkH5Err(h5fSpace);
+
+		if (numReadSides > 0)
+			checkH5Err(H5Sselect_hyperslab(h5fSpace, H5S_SELECT_SET, fStart, 0L, count, 0L));
+		else
+			checkH5Err(H5Sselect_none(h5fSpace));
+
+		checkH5Err(H5Dread(h5data, H5T_NATIVE_DOUBLE, h5memSpace, h5fSpace,
+				h5XferList(), varData.data()));
+
+		checkH5Err(H5Sclose(h5fSpace));
+		checkH5Err(H5Dclose(h5data));
+
+		// Store all variables of a side contiguously
+		for (unsigned long j = 0; j < numReadSides; j++)
+			std::copy(&varData[j*numBndGP()], &varData[j*numBndGP()] + numBndGP(),
+				&readData[(j*NUM_VARIABLES + i) * numBndGP()]);
+	}
+	checkH5Err(H5Sclose(h5memSpace));
+
+	// Send the variables to the new owners
+	std::vector<double> sideData(numSides() * NUM_VARIABLES * numBndGP());
+#ifdef USE_MPI
+	Redistributor redistributor(comm());
+#else // USE_MPI
+	Redistributor redistributor;
+#endif // USE_MPI
+	unsigned long numMissing = redistributor.redistribute(NUM_VARIABLES * numBndGP() * sizeof(double),
+		numReadSides, readIds.data(), readData.data(),
+		numSides(), faceIds(), sideData.data());
+	if (numMissing > 0)
+		logError() << "Checkpoint does not contain" << numMissing << "dynamic rupture sides of the mesh.";
+
+	for (unsigned int i = 0; i < NUM_VARIABLES; i++) {
+		for (unsigned int j = 0; j < numSides(); j++)
+			std::copy(&sideData[(j*NUM_VARIABLES + i) * numBndGP()], &sideData[(j*NUM_VARIABLES + i) * numBndGP()] + numBndGP(),
+				&data[i][j*numBndGP()]);
+	}
+}
+
+
+void seissol::checkpoint::h5::Fault::selectSides(hid_t h5memSpace, const DeltaBlocks &deltaBlocks)
+{
+	checkH5Err(H5Sselect_none(h5memSpace));
+	checkH5Err(H5Sselect_none(m_h5fSpaceData));
+
+	const unsigned long sideSize = numBndGP() * sizeof(double);
+	for (unsigned long block = 0; block < deltaBlocks.numBlocks(); block++) {
+		if (!deltaBlocks.changed(block))
+			continue;
+
+		const unsigned long firstSide = block * deltaBlocks.blockSize() / sideSize;
+		hsize_t mStart[2] = {firstSide, 0};
+		hsize_t fStart[2] = {fileOffset() + firstSide, 0};
+		hsize_t count[2] = {deltaBlocks.blockEnd(block) / sideSize - firstSide, numBndGP()};
+		checkH5Err(H5Sselect_hyperslab(h5memSpace, H5S_SELECT_OR, mStart, 0L, count, 0L));
+		checkH5Err(H5Sselect_hyperslab(m_h5fSpaceData, H5S_SELECT_OR, fStart, 0L, count, 0L));
+	}
+}
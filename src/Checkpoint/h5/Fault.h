@@ -57,6 +57,7 @@
 #include "utils/logger.h"
 
 #include "CheckPoint.h"
+#include "Checkpoint/DeltaBlocks.h"
 #include "Checkpoint/Fault.h"
 #include "Initializer/preProcessorMacros.fpp"
 #include "Initializer/typedefs.hpp"
@@ -91,6 +92,9 @@ private:
 	/** Identifiers for the file space of the data set */
 	hid_t m_h5fSpaceData;
 
+	/** Changed blocks of the variables */
+	DeltaBlocks m_deltaBlocks[NUM_VARIABLES];
+
 public:
 	Fault()
 		: seissol::checkpoint::CheckPoint(IDENTIFIER),
@@ -139,6 +143,22 @@ private:
 
 	hid_t initFile(int odd, const char* filename);
 
+	/**
+	 * Checks whether the checkpoint was written with the current partitioning
+	 * (collective operation)
+	 */
+	bool samePartitioning(hid_t h5file);
+
+	/**
+	 * Load a checkpoint written with a different partitioning
+	 */
+	void loadRedistributed(hid_t h5file, double* const data[NUM_VARIABLES]);
+
+	/**
+	 * Selects the changed sides of a variable in the memory and the file space
+	 */
+	void selectSides(hid_t h5memSpace, const DeltaBlocks &deltaBlocks);
+
 private:
 	static const unsigned long IDENTIFIER = 0x7A127;
 };
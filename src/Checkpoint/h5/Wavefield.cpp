@@ -39,13 +39,16 @@
 
 #include "Parallel/MPI.h"
 
+#include <algorithm>
 #include <cassert>
+#include <vector>
 
 #include "utils/env.h"
 #include "utils/mathutils.h"
 #include "utils/stringutils.h"
 
 #include "Wavefield.h"
+#include "Checkpoint/Redistributor.h"
 
 #ifdef USE_MPI
 #include "Checkpoint/MPIInfo.h"
@@ -65,6 +68,20 @@ bool seissol::checkpoint::h5::Wavefield::init(size_t headerSize, unsigned long n
 	m_h5fSpaceData = H5Screate_simple(1, &fileSize, 0L);
 	checkH5Err(m_h5fSpaceData);
 
+	if (cellIds()) {
+		// Position of the cells in the file
+		m_numTotalCells = numCells();
+		m_cellOffset = numCells();
+#ifdef USE_MPI
+		MPI_Allreduce(MPI_IN_PLACE, &m_numTotalCells, 1, MPI_UNSIGNED_LONG, MPI_SUM, comm());
+		MPI_Scan(MPI_IN_PLACE, &m_cellOffset, 1, MPI_UNSIGNED_LONG, MPI_SUM, comm());
+#endif // USE_MPI
+		m_cellOffset -= numCells();
+	}
+
+	if (delta())
+		m_deltaBlocks.init(numDofs * sizeof(real), chunkSize(), deltaFullInterval());
+
 	setupXferList();
 
 	return exists();
@@ -85,6 +102,12 @@ void seissol::checkpoint::h5::Wavefield::load(real* dofs)
 	checkH5Err(H5Aread(h5attr, m_h5headerType, header().data()));
 	checkH5Err(H5Aclose(h5attr));
 
+	if (!samePartitioning(h5file)) {
+		loadRedistributed(h5file, dofs);
+		checkH5Err(H5Fclose(h5file));
+		return;
+	}
+
 	// Get dataset
 	hid_t h5data = H5Dopen(h5file, "values", H5P_DEFAULT);
 	checkH5Err(h5data);
@@ -153,15 +176,18 @@ void seissol::checkpoint::h5::Wavefield::write(const void* header, size_t header
 	EPIK_USER_START(r_write_wavefield);
 	SCOREP_USER_REGION_BEGIN(r_write_wavefield, "checkpoint_write_wavefield", SCOREP_USER_REGION_TYPE_COMMON);
 
+	// Find blocks that changed since the last checkpoint in this file
+	unsigned long writtenBytes = numDofs() * sizeof(real);
+	if (delta())
+		writtenBytes = m_deltaBlocks.update(odd(), dofs());
+
 	// Write the wave field
 	unsigned int offset = 0;
-	hsize_t fStart = fileOffset();
 	hsize_t count = dofsPerIteration();
 	hid_t h5memSpace = H5Screate_simple(1, &count, 0L);
 	checkH5Err(h5memSpace);
-	checkH5Err(H5Sselect_all(h5memSpace));
 	for (unsigned int i = 0; i < totalIterations()-1; i++) {
-		checkH5Err(H5Sselect_hyperslab(m_h5fSpaceData, H5S_SELECT_SET, &fStart, 0L, &count, 0L));
+		selectDofs(h5memSpace, offset, count);
 
 		checkH5Err(H5Dwrite(m_h5data[odd()], H5T_NATIVE_DOUBLE, h5memSpace, m_h5fSpaceData,
 				h5XferList(), &const_cast<real*>(dofs())[offset]));
@@ -169,7 +195,6 @@ void seissol::checkpoint::h5::Wavefield::write(const void* header, size_t header
 		// We are finished in less iterations, read data twice
 		// so everybody needs the same number of iterations
 		if (i < iterations()-1) {
-			fStart += count;
 			offset += count;
 		}
 	}
@@ -179,12 +204,13 @@ void seissol::checkpoint::h5::Wavefield::write(const void* header, size_t header
 	count = numDofs() - (iterations() - 1) * count;
 	h5memSpace = H5Screate_simple(1, &count, 0L);
 	checkH5Err(h5memSpace);
-	checkH5Err(H5Sselect_all(h5memSpace));
-	checkH5Err(H5Sselect_hyperslab(m_h5fSpaceData, H5S_SELECT_SET, &fStart, 0L, &count, 0L));
+	selectDofs(h5memSpace, offset, count);
 	checkH5Err(H5Dwrite(m_h5data[odd()], H5T_NATIVE_DOUBLE, h5memSpace, m_h5fSpaceData,
 			h5XferList(), &dofs()[offset]));
 	checkH5Err(H5Sclose(h5memSpace));
 
+	logWrittenBytes("wave field", writtenBytes, numDofs() * sizeof(real), H5Dget_storage_size(m_h5data[odd()]));
+
 	EPIK_USER_END(r_write_wavefield);
 	SCOREP_USER_REGION_END(r_write_wavefield);
 
@@ -206,10 +232,15 @@ bool seissol::checkpoint::h5::Wavefield::validate(hid_t h5file) const
 		return false;
 	}
 
+	// Checkpoints with global cell ids can be loaded with any partitioning
+	bool canRedistribute = cellIds()
+		&& H5Lexists(h5file, "cellIds", H5P_DEFAULT) > 0
+		&& H5Lexists(h5file, "cellOffsets", H5P_DEFAULT) > 0;
+
 	int p;
 	herr_t err = H5Aread(h5attr, H5T_NATIVE_INT, &p);
 	checkH5Err(H5Aclose(h5attr));
-	if (err < 0 || p != partitions()) {
+	if (err < 0 || (p != partitions() && !canRedistribute)) {
 		logWarning(rank()) << "Partitions in checkpoint do not match.";
 		return false;
 	}
@@ -240,7 +271,7 @@ bool seissol::checkpoint::h5::Wavefield::validate(hid_t h5file) const
 			isValid = false;
 			logWarning(rank()) << "Could not get dimension sizes of checkpoint.";
 		} else {
-			if (dimSize != numTotalElems()) {
+			if (dimSize != numTotalElems() && !canRedistribute) {
 				isValid = false;
 				logWarning(rank()) << "Number of elements in checkpoint does not match.";
 			}
@@ -306,13 +337,285 @@ hid_t seissol::checkpoint::h5::Wavefield::initFile(int odd, const char* filename
 		// Variable
 		h5plist = H5Pcreate(H5P_DATASET_CREATE);
 		checkH5Err(h5plist);
-		checkH5Err(H5Pset_layout(h5plist, H5D_CONTIGUOUS));
-		checkH5Err(H5Pset_alloc_time(h5plist, H5D_ALLOC_TIME_EARLY));
+		hsize_t chunk = std::max(std::min(chunkSize() / sizeof(double), numTotalElems()), 1ul);
+		setLayout(h5plist, 1, &chunk);
 		m_h5data[odd] = H5Dcreate(h5file, "values", H5T_IEEE_F64LE, m_h5fSpaceData,
 				H5P_DEFAULT, h5plist, H5P_DEFAULT);
 		checkH5Err(m_h5data[odd]);
 		checkH5Err(H5Pclose(h5plist));
+
+		if (cellIds())
+			writeCellIds(h5file);
 	}
 
 	return h5file;
 }
+
+bool seissol::checkpoint::h5::Wavefield::samePartitioning(hid_t h5file)
+{
+	int same = 1;
+
+	hid_t h5attr = H5Aopen(h5file, "partitions", H5P_DEFAULT);
+	checkH5Err(h5attr);
+	int p;
+	checkH5Err(H5Aread(h5attr, H5T_NATIVE_INT, &p));
+	checkH5Err(H5Aclose(h5attr));
+	if (p != partitions())
+		same = 0;
+
+	hid_t h5data = H5Dopen(h5file, "values", H5P_DEFAULT);
+	checkH5Err(h5data);
+	hid_t h5space = H5Dget_space(h5data);
+	checkH5Err(h5space);
+	hsize_t dimSize;
+	checkH5Err(H5Sget_simple_extent_dims(h5space, &dimSize, 0L));
+	checkH5Err(H5Sclose(h5space));
+	checkH5Err(H5Dclose(h5data));
+	if (dimSize != numTotalElems())
+		same = 0;
+
+	// The same number of partitions does not imply the same partitioning
+	if (same && cellIds() && H5Lexists(h5file, "cellIds", H5P_DEFAULT) > 0) {
+		h5data = H5Dopen(h5file, "cellIds", H5P_DEFAULT);
+		checkH5Err(h5data);
+		h5space = H5Dget_space(h5data);
+		checkH5Err(h5space);
+		checkH5Err(H5Sget_simple_extent_dims(h5space, &dimSize, 0L));
+
+		if (dimSize != m_numTotalCells) {
+			same = 0;
+		} else {
+			std::vector<unsigned long> fileIds(std::max(numCells(), 1ul));
+
+			hsize_t fStart = m_cellOffset;
+			hsize_t count = std::max(numCells(), 1ul);
+			hid_t h5memSpace = H5Screate_simple(1, &count, 0L);
+			checkH5Err(h5memSpace);
+			if (numCells() > 0) {
+				count = numCells();
+				checkH5Err(H5Sselect_all(h5memSpace));
+				checkH5Err(H5Sselect_hyperslab(h5space, H5S_SELECT_SET, &fStart, 0L, &count, 0L));
+			} else {
+				checkH5Err(H5Sselect_none(h5memSpace));
+				checkH5Err(H5Sselect_none(h5space));
+			}
+			checkH5Err(H5Dread(h5data, H5T_NATIVE_ULONG, h5memSpace, h5space,
+					h5XferList(), fileIds.data()));
+			checkH5Err(H5Sclose(h5memSpace));
+
+			if (!std::equal(cellIds(), cellIds() + numCells(), fileIds.begin()))
+				same = 0;
+		}
+
+		checkH5Err(H5Sclose(h5space));
+		checkH5Err(H5Dclose(h5data));
+	}
+
+#ifdef USE_MPI
+	MPI_Allreduce(MPI_IN_PLACE, &same, 1, MPI_INT, MPI_LAND, comm());
+#endif // USE_MPI
+
+	return same;
+}
+
+void seissol::checkpoint::h5::Wavefield::loadRedistributed(hid_t h5file, real* dofs)
+{
+	logInfo(rank()) << "Checkpoint was written with a different partitioning, redistributing the wave field";
+
+	setRedistributed();
+
+	// All cells have the same number of dofs
+	unsigned long dofsPerCell = (numCells() > 0 ? numDofs() / numCells() : 0);
+#ifdef USE_MPI
+	MPI_Allreduce(MPI_IN_PLACE, &dofsPerCell, 1, MPI_UNSIGNED_LONG, MPI_MAX, comm());
+#endif // USE_MPI
+	if (dofsPerCell == 0)
+		return;
+
+	// Position of the partitions in the file
+	hid_t h5data = H5Dopen(h5file, "cellOffsets", H5P_DEFAULT);
+	checkH5Err(h5data);
+	hid_t h5space = H5Dget_space(h5data);
+	checkH5Err(h5space);
+	hsize_t offsetsSize[2];
+	checkH5Err(H5Sget_simple_extent_dims(h5space, offsetsSize, 0L));
+	checkH5Err(H5Sclose(h5space));
+	std::vector<unsigned long> cellOffsets(offsetsSize[0] * 2);
+	checkH5Err(H5Dread(h5data, H5T_NATIVE_ULONG, H5S_ALL, H5S_ALL, h5XferList(), cellOffsets.data()));
+	checkH5Err(H5Dclose(h5data));
+
+	// Every rank reads a contiguous part of the cells
+	h5data = H5Dopen(h5file, "cellIds", H5P_DEFAULT);
+	checkH5Err(h5data);
+	h5space = H5Dget_space(h5data);
+	checkH5Err(h5space);
+	hsize_t numFileCells;
+	checkH5Err(H5Sget_simple_extent_dims(h5space, &numFileCells, 0L));
+
+	const unsigned long firstCell = numFileCells * rank() / partitions();
+	const unsigned long lastCell = numFileCells * (rank() + 1) / partitions();
+	const unsigned long numReadCells = lastCell - firstCell;
+
+	std::vector<unsigned long> readIds(std::max(numReadCells, 1ul));
+	hsize_t fStart = firstCell;
+	hsize_t count = std::max(numReadCells, 1ul);
+	hid_t h5memSpace = H5Screate_simple(1, &count, 0L);
+	checkH5Err(h5memSpace);
+	if (numReadCells > 0) {
+		count = numReadCells;
+		checkH5Err(H5Sselect_all(h5memSpace));
+		checkH5Err(H5Sselect_hyperslab(h5space, H5S_SELECT_SET, &fStart, 0L, &count, 0L));
+	} else {
+		checkH5Err(H5Sselect_none(h5memSpace));
+		checkH5Err(H5Sselect_none(h5space));
+	}
+	checkH5Err(H5Dread(h5data, H5T_NATIVE_ULONG, h5memSpace, h5space,
+			h5XferList(), readIds.data()));
+	checkH5Err(H5Sclose(h5memSpace));
+	checkH5Err(H5Sclose(h5space));
+	checkH5Err(H5Dclose(h5data));
+
+	// Read the dofs of these cells
+	h5data = H5Dopen(h5file, "values", H5P_DEFAULT);
+	checkH5Err(h5data);
+	hid_t h5fSpace = H5Dget_space(h5data);
+	checkH5Err(h5fSpace);
+
+	std::vector<real> readDofs(std::max(numReadCells * dofsPerCell, 1ul));
+
+	// Work around 2 GB limit in MPI-IO
+	const unsigned long cellsPerIteration = std::max(dofsPerIteration() / dofsPerCell, 1ul);
+	unsigned int iterations = (numReadCells + cellsPerIteration - 1) / cellsPerIteration;
+#ifdef USE_MPI
+	MPI_Allreduce(MPI_IN_PLACE, &iterations, 1, MPI_UNSIGNED, MPI_MAX, comm());
+#endif // USE_MPI
+
+	for (unsigned int i = 0; i < iterations; i++) {
+		const unsigned long start = std::min(firstCell + i * cellsPerIteration, lastCell);
+		const unsigned long end = std::min(start + cellsPerIteration, lastCell);
+
+		// The cells may be spread over several partitions of the file
+		checkH5Err(H5Sselect_none(h5fSpace));
+		const unsigned long numWriters = offsetsSize[0];
+		for (unsigned long w = 0; w < numWriters; w++) {
+			const unsigned long writerStart = cellOffsets[w*2];
+			const unsigned long writerEnd = (w+1 < numWriters ? cellOffsets[(w+1)*2] : numFileCells);
+			const unsigned long lo = std::max(start, writerStart);
+			const unsigned long hi = std::min(end, writerEnd);
+			if (lo >= hi)
+				continue;
+
+			hsize_t dofStart = cellOffsets[w*2+1] + (lo - writerStart) * dofsPerCell;
+			hsize_t dofCount = (hi - lo) * dofsPerCell;
+			checkH5Err(H5Sselect_hyperslab(h5fSpace, H5S_SELECT_OR, &dofStart, 0L, &dofCount, 0L));
+		}
+
+		count = std::max((end - start) * dofsPerCell, 1ul);
+		h5memSpace = H5Screate_simple(1, &count, 0L);
+		checkH5Err(h5memSpace);
+		if (end > start)
+			checkH5Err(H5Sselect_all(h5memSpace));
+		else
+			checkH5Err(H5Sselect_none(h5memSpace));
+
+		checkH5Err(H5Dread(h5data, H5T_NATIVE_DOUBLE, h5memSpace, h5fSpace,
+				h5XferList(), readDofs.data() + (start - firstCell) * dofsPerCell));
+		checkH5Err(H5Sclose(h5memSpace));
+	}
+
+	checkH5Err(H5Sclose(h5fSpace));
+	checkH5Err(H5Dclose(h5data));
+
+	// Send the dofs to the new owners
+#ifdef USE_MPI
+	Redistributor redistributor(comm());
+#else // USE_MPI
+	Redistributor redistributor;
+#endif // USE_MPI
+	unsigned long numMissing = redistributor.redistribute(dofsPerCell * sizeof(real),
+		numReadCells, readIds.data(), readDofs.data(),
+		numCells(), cellIds(), dofs);
+	if (numMissing > 0)
+		logError() << "Checkpoint does not contain" << numMissing << "cells of the mesh.";
+}
+
+void seissol::checkpoint::h5::Wavefield::writeCellIds(hid_t h5file)
+{
+	// Global cell ids
+	hsize_t fileSize = m_numTotalCells;
+	hid_t h5space = H5Screate_simple(1, &fileSize, 0L);
+	checkH5Err(h5space);
+	hid_t h5data = H5Dcreate(h5file, "cellIds", H5T_STD_U64LE, h5space,
+			H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+	checkH5Err(h5data);
+
+	hsize_t fStart = m_cellOffset;
+	hsize_t count = std::max(numCells(), 1ul);
+	hid_t h5memSpace = H5Screate_simple(1, &count, 0L);
+	checkH5Err(h5memSpace);
+	if (numCells() > 0) {
+		count = numCells();
+		checkH5Err(H5Sselect_all(h5memSpace));
+		checkH5Err(H5Sselect_hyperslab(h5space, H5S_SELECT_SET, &fStart, 0L, &count, 0L));
+	} else {
+		checkH5Err(H5Sselect_none(h5memSpace));
+		checkH5Err(H5Sselect_none(h5space));
+	}
+	checkH5Err(H5Dwrite(h5data, H5T_NATIVE_ULONG, h5memSpace, h5space,
+			h5XferList(), cellIds()));
+	checkH5Err(H5Sclose(h5memSpace));
+	checkH5Err(H5Sclose(h5space));
+	checkH5Err(H5Dclose(h5data));
+
+	// First cell and first dof of each partition
+	hsize_t offsetsSize[2] = {static_cast<hsize_t>(partitions()), 2};
+	h5space = H5Screate_simple(2, offsetsSize, 0L);
+	checkH5Err(h5space);
+	h5data = H5Dcreate(h5file, "cellOffsets", H5T_STD_U64LE, h5space,
+			H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+	checkH5Err(h5data);
+
+	hsize_t offsetsStart[2] = {static_cast<hsize_t>(rank()), 0};
+	hsize_t offsetsCount[2] = {1, 2};
+	h5memSpace = H5Screate_simple(2, offsetsCount, 0L);
+	checkH5Err(h5memSpace);
+	checkH5Err(H5Sselect_hyperslab(h5space, H5S_SELECT_SET, offsetsStart, 0L, offsetsCount, 0L));
+	unsigned long offsets[2] = {m_cellOffset, fileOffset()};
+	checkH5Err(H5Dwrite(h5data, H5T_NATIVE_ULONG, h5memSpace, h5space,
+			h5XferList(), offsets));
+	checkH5Err(H5Sclose(h5memSpace));
+	checkH5Err(H5Sclose(h5space));
+	checkH5Err(H5Dclose(h5data));
+}
+
+void seissol::checkpoint::h5::Wavefield::selectDofs(hid_t h5memSpace, unsigned long offset, hsize_t count)
+{
+	if (!delta()) {
+		hsize_t fStart = fileOffset() + offset;
+		checkH5Err(H5Sselect_all(h5memSpace));
+		checkH5Err(H5Sselect_hyperslab(m_h5fSpaceData, H5S_SELECT_SET, &fStart, 0L, &count, 0L));
+		return;
+	}
+
+	checkH5Err(H5Sselect_none(h5memSpace));
+	checkH5Err(H5Sselect_none(m_h5fSpaceData));
+	if (count == 0)
+		return;
+
+	// Select the changed blocks only
+	const unsigned long dofsPerBlock = m_deltaBlocks.blockSize() / sizeof(real);
+	const unsigned long end = offset + count;
+	for (unsigned long block = offset / dofsPerBlock; block <= (end - 1) / dofsPerBlock; block++) {
+		if (!m_deltaBlocks.changed(block))
+			continue;
+
+		const unsigned long blockStart = std::max(block * dofsPerBlock, offset);
+		const unsigned long blockEnd = std::min(m_deltaBlocks.blockEnd(block) / sizeof(real), end);
+
+		hsize_t mStart = blockStart - offset;
+		hsize_t fStart = fileOffset() + blockStart;
+		hsize_t blockCount = blockEnd - blockStart;
+		checkH5Err(H5Sselect_hyperslab(h5memSpace, H5S_SELECT_OR, &mStart, 0L, &blockCount, 0L));
+		checkH5Err(H5Sselect_hyperslab(m_h5fSpaceData, H5S_SELECT_OR, &fStart, 0L, &blockCount, 0L));
+	}
+}
@@ -56,6 +56,7 @@
 #include "utils/logger.h"
 
 #include "CheckPoint.h"
+#include "Checkpoint/DeltaBlocks.h"
 #include "Checkpoint/Wavefield.h"
 #include "Initializer/typedefs.hpp"
 
@@ -89,13 +90,23 @@ private:
 	/** Identifiers for the file space of the data set */
 	hid_t m_h5fSpaceData;
 
+	/** Total number of cells (only used with global cell ids) */
+	unsigned long m_numTotalCells;
+
+	/** Offset of the cells in the file (only used with global cell ids) */
+	unsigned long m_cellOffset;
+
+	/** Changed blocks of the dofs */
+	DeltaBlocks m_deltaBlocks;
+
 public:
 	Wavefield()
 		: seissol::checkpoint::CheckPoint(IDENTIFIER),
 		seissol::checkpoint::Wavefield(IDENTIFIER),
 		CheckPoint(IDENTIFIER),
 		m_h5headerType(-1),
-		m_h5fSpaceData(-1)
+		m_h5fSpaceData(-1),
+		m_numTotalCells(0), m_cellOffset(0)
 	{
 		m_h5header[0] = m_h5header[1] = -1;
 		m_h5data[0] = m_h5data[1] = -1;
@@ -133,6 +144,28 @@ protected:
 	hid_t initFile(int odd, const char* filename);
 
 private:
+	/**
+	 * Checks whether the checkpoint was written with the current partitioning
+	 * (collective operation)
+	 */
+	bool samePartitioning(hid_t h5file);
+
+	/**
+	 * Load a checkpoint written with a different partitioning
+	 */
+	void loadRedistributed(hid_t h5file, real* dofs);
+
+	/**
+	 * Writes the global cell ids and the positions of the partitions
+	 */
+	void writeCellIds(hid_t h5file);
+
+	/**
+	 * Selects the dofs in [offset, offset+count) that need to be written
+	 * in the memory and the file space
+	 */
+	void selectDofs(hid_t h5memSpace, unsigned long offset, hsize_t count);
+
 	static const unsigned long IDENTIFIER = 0x7A93F;
 };
 
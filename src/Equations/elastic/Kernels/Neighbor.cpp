@@ -75,6 +75,7 @@
 #pragma message "compiling boundary kernel with assertions"
 #endif
 
+#include <algorithm>
 #include <cassert>
 #include <stdint.h>
 
@@ -242,7 +243,78 @@ void seissol::kernels::Neighbor::computeBatchedNeighborsIntegral(ConditionalBatc
     resetDeviceCurrentState(streamCounter);
   }
 #else
-  assert(false && "no implementation provided");
+  // Every cell is in at most one batch per face, hence the batches of a face update distinct cells.
+  // The faces are processed in the same order as in computeNeighborsIntegral.
+#ifdef _OPENMP
+  #pragma omp parallel
+#endif
+  {
+    for (size_t face = 0; face < 4; face++) {
+      // regular and periodic
+      for (size_t faceRelation = 0; faceRelation < (*FaceRelations::Count); ++faceRelation) {
+        ConditionalKey key(*KernelNames::NeighborFlux,
+                           (FaceKinds::Regular || FaceKinds::Periodic),
+                           face,
+                           faceRelation);
+
+        auto found = table.find(key);
+        if (found != table.end()) {
+          BatchTable &entry = found->second;
+          const unsigned numElements = (entry.content[*EntityId::Dofs])->getSize();
+          real** dofs = (entry.content[*EntityId::Dofs])->getPointers();
+          real** idofs = (entry.content[*EntityId::Idofs])->getPointers();
+          real** aminusT = (entry.content[*EntityId::AminusT])->getPointers();
+
+          // the flux matrices of this face relation stay in cache for the whole batch
+          kernel::neighboringFlux nfKrnl = m_nfKrnlPrototype;
+#ifdef _OPENMP
+          #pragma omp for schedule(static) nowait
+#endif
+          for (unsigned element = 0; element < numElements; ++element) {
+            assert(reinterpret_cast<uintptr_t>(idofs[element]) % ALIGNMENT == 0);
+            nfKrnl.Q = dofs[element];
+            nfKrnl.I = idofs[element];
+            nfKrnl.AminusT = aminusT[element];
+            nfKrnl._prefetch.I = idofs[std::min(element + 1, numElements - 1)];
+            nfKrnl.execute(faceRelation % 3, (faceRelation / 3) % 4, face);
+          }
+        }
+      }
+
+      // dynamic rupture
+      for (unsigned faceRelation = 0; faceRelation < (*DrFaceRelations::Count); ++faceRelation) {
+        ConditionalKey key(*KernelNames::NeighborFlux,
+                           *FaceKinds::DynamicRupture,
+                           face,
+                           faceRelation);
+
+        auto found = table.find(key);
+        if (found != table.end()) {
+          BatchTable &entry = found->second;
+          const unsigned numElements = (entry.content[*EntityId::Dofs])->getSize();
+          real** dofs = (entry.content[*EntityId::Dofs])->getPointers();
+          real** godunov = (entry.content[*EntityId::Godunov])->getPointers();
+          real** fluxSolver = (entry.content[*EntityId::FluxSolver])->getPointers();
+
+          dynamicRupture::kernel::nodalFlux drKrnl = m_drKrnlPrototype;
+#ifdef _OPENMP
+          #pragma omp for schedule(static) nowait
+#endif
+          for (unsigned element = 0; element < numElements; ++element) {
+            assert(reinterpret_cast<uintptr_t>(godunov[element]) % ALIGNMENT == 0);
+            drKrnl.fluxSolver = fluxSolver[element];
+            drKrnl.QInterpolated = godunov[element];
+            drKrnl.Q = dofs[element];
+            drKrnl._prefetch.I = godunov[std::min(element + 1, numElements - 1)];
+            drKrnl.execute(faceRelation % 4, faceRelation / 4);
+          }
+        }
+      }
+#ifdef _OPENMP
+      #pragma omp barrier
+#endif
+    }
+  }
 #endif
 }
 
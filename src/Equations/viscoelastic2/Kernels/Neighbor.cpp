@@ -139,6 +139,11 @@ void seissol::kernels::Neighbor::computeNeighborsIntegral(  NeighborData&
   nKrnl.execute();
 }
 
+void seissol::kernels::Neighbor::computeBatchedNeighborsIntegral(ConditionalBatchTableT &table) {
+  // not supported, as the neighboring flux of all faces is accumulated per cell in Qext
+  assert(false && "no implementation provided");
+}
+
 void seissol::kernels::Neighbor::flopsNeighborsIntegral(const FaceType i_faceTypes[4],
                                                         const int i_neighboringIndices[4][2],
                                                         CellDRMapping const (&cellDrMapping)[4],
@@ -0,0 +1,140 @@
+/**
+ * @file
+ * This file is part of SeisSol.
+ *
+ * @section LICENSE
+ * Copyright (c) 2020, SeisSol Group
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @section DESCRIPTION
+ * Bounding volume hierarchy over the elements of a mesh.
+ */
+
+#include "ElementIndex.h"
+
+#include <algorithm>
+#include <limits>
+
+seissol::ElementIndex::ElementIndex(const MeshReader& mesh)
+	: m_elements(mesh.getElements().size()), m_maxExtent(0)
+{
+	for (unsigned i = 0; i < m_elements.size(); i++)
+		m_elements[i] = i;
+
+	build(mesh);
+}
+
+seissol::ElementIndex::ElementIndex(const MeshReader& mesh, const std::vector<unsigned>& elements)
+	: m_elements(elements), m_maxExtent(0)
+{
+	build(mesh);
+}
+
+void seissol::ElementIndex::build(const MeshReader& mesh)
+{
+	const std::vector<Element>& elements = mesh.getElements();
+	const std::vector<Vertex>& vertices = mesh.getVertices();
+
+	if (m_elements.empty())
+		return;
+
+	// Barycenters and extents of the elements
+	std::vector<VrtxCoords> centers(elements.size());
+	for (unsigned i = 0; i < m_elements.size(); i++) {
+		const Element& element = elements[m_elements[i]];
+		for (int j = 0; j < 3; j++) {
+			double min = std::numeric_limits<double>::max();
+			double max = std::numeric_limits<double>::lowest();
+			double sum = 0;
+			for (int k = 0; k < 4; k++) {
+				const double x = vertices[element.vertices[k]].coords[j];
+				min = std::min(min, x);
+				max = std::max(max, x);
+				sum += x;
+			}
+			centers[m_elements[i]][j] = .25 * sum;
+			m_maxExtent = std::max(m_maxExtent, max - min);
+		}
+	}
+
+	struct Range {
+		unsigned node;
+		unsigned begin;
+		unsigned end;
+	};
+	std::vector<Range> ranges;
+
+	m_nodes.reserve(2 * (m_elements.size() / LEAF_SIZE + 1));
+	m_nodes.push_back(Node());
+	ranges.push_back({0, 0, static_cast<unsigned>(m_elements.size())});
+
+	while (!ranges.empty()) {
+		const Range range = ranges.back();
+		ranges.pop_back();
+
+		Node node;
+		for (int j = 0; j < 3; j++) {
+			node.min[j] = std::numeric_limits<double>::max();
+			node.max[j] = std::numeric_limits<double>::lowest();
+		}
+		for (unsigned i = range.begin; i < range.end; i++) {
+			const Element& element = elements[m_elements[i]];
+			for (int k = 0; k < 4; k++) {
+				for (int j = 0; j < 3; j++) {
+					node.min[j] = std::min(node.min[j], vertices[element.vertices[k]].coords[j]);
+					node.max[j] = std::max(node.max[j], vertices[element.vertices[k]].coords[j]);
+				}
+			}
+		}
+
+		if (range.end - range.begin <= LEAF_SIZE) {
+			node.first = range.begin;
+			node.count = range.end - range.begin;
+		} else {
+			int axis = 0;
+			for (int j = 1; j < 3; j++) {
+				if (node.max[j] - node.min[j] > node.max[axis] - node.min[axis])
+					axis = j;
+			}
+
+			const unsigned mid = range.begin + (range.end - range.begin) / 2;
+			std::nth_element(m_elements.begin() + range.begin, m_elements.begin() + mid, m_elements.begin() + range.end,
+				[&centers, axis](unsigned a, unsigned b) { return centers[a][axis] < centers[b][axis]; });
+
+			node.first = m_nodes.size();
+			node.count = 0;
+			m_nodes.push_back(Node());
+			m_nodes.push_back(Node());
+			ranges.push_back({node.first, range.begin, mid});
+			ranges.push_back({node.first + 1, mid, range.end});
+		}
+
+		m_nodes[range.node] = node;
+	}
+}
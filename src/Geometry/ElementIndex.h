@@ -0,0 +1,138 @@
+/**
+ * @file
+ * This file is part of SeisSol.
+ *
+ * @section LICENSE
+ * Copyright (c) 2020, SeisSol Group
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @section DESCRIPTION
+ * Bounding volume hierarchy over the elements of a mesh.
+ */
+
+#ifndef GEOMETRY_ELEMENTINDEX_H
+#define GEOMETRY_ELEMENTINDEX_H
+
+#include <vector>
+
+#include "MeshReader.h"
+
+namespace seissol
+{
+
+/**
+ * Finds the elements whose bounding box contains a point in O(log n).
+ *
+ * The hierarchy is built top-down by splitting the elements at the median
+ * of their barycenters along the longest axis of the node.
+ */
+class ElementIndex
+{
+private:
+	struct Node {
+		double min[3];
+		double max[3];
+		/** First element (leaf) or first child (inner node) */
+		unsigned first;
+		/** Number of elements, 0 for inner nodes */
+		unsigned count;
+	};
+
+	/** Maximum number of elements in a leaf */
+	static const unsigned LEAF_SIZE = 8;
+
+	/** Maximum depth of the hierarchy (the median split keeps it balanced) */
+	static const unsigned MAX_DEPTH = 64;
+
+	std::vector<Node> m_nodes;
+
+	/** Element ids ordered by the leaves */
+	std::vector<unsigned> m_elements;
+
+	/** Largest extent of all element bounding boxes */
+	double m_maxExtent;
+
+public:
+	/**
+	 * Builds the index over all elements of the mesh
+	 */
+	explicit ElementIndex(const MeshReader& mesh);
+
+	/**
+	 * Builds the index over a subset of the elements of the mesh
+	 */
+	ElementIndex(const MeshReader& mesh, const std::vector<unsigned>& elements);
+
+	/**
+	 * Calls <code>visit(element)</code> for all elements whose bounding box
+	 * contains the point. The elements are not visited in a particular order.
+	 *
+	 * @param tolerance Tolerance of the barycentric coordinates. A point whose
+	 *  barycentric coordinates are all at least <code>-tolerance</code> lies at most
+	 *  <code>3 * tolerance</code> times the element extent outside of the bounding box,
+	 *  hence the bounding boxes are enlarged by this amount.
+	 */
+	template<typename Visitor>
+	void forEachCandidate(const double point[3], Visitor visit, double tolerance = 0.) const
+	{
+		if (m_nodes.empty())
+			return;
+
+		const double slack = 3. * tolerance * m_maxExtent;
+
+		unsigned stack[MAX_DEPTH];
+		unsigned top = 0;
+		stack[top++] = 0;
+		while (top > 0) {
+			const Node& node = m_nodes[stack[--top]];
+
+			bool outside = false;
+			for (int i = 0; i < 3; i++) {
+				outside |= point[i] < node.min[i] - slack || point[i] > node.max[i] + slack;
+			}
+			if (outside)
+				continue;
+
+			if (node.count > 0) {
+				for (unsigned i = node.first; i < node.first + node.count; i++)
+					visit(m_elements[i]);
+			} else {
+				stack[top++] = node.first;
+				stack[top++] = node.first + 1;
+			}
+		}
+	}
+
+private:
+	void build(const MeshReader& mesh);
+};
+
+}
+
+#endif // GEOMETRY_ELEMENTINDEX_H
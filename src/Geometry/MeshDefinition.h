@@ -54,9 +54,13 @@ typedef int ElemMPIIndices[4];
 typedef int ElemMaterial;
 
 typedef int ElemFaultTags[4];
+/** Global ids of the faces (only set if the mesh reader provides global ids) */
+typedef unsigned long ElemFaceGlobalIds[4];
 
 struct Element {
 	int localId;
+	/** Global id of the element (only set if the mesh reader provides global ids) */
+	unsigned long globalId;
 	ElemVertices vertices;
 	int rank;
 	ElemNeighbors neighbors;
@@ -70,6 +74,7 @@ struct Element {
 	/** Material of the element */
 	ElemMaterial material;
    ElemFaultTags faultTags; // member of struct Element
+	ElemFaceGlobalIds faceGlobalIds;
 };
 
 typedef double VrtxCoords[3];
@@ -112,6 +117,9 @@ struct Fault {
 	int neighborElement;
 	int neighborSide;
 
+	/** Global id of the fault face (only set if the mesh reader provides global ids) */
+	unsigned long globalId;
+
 	/** Normal of the fault face */
 	VrtxCoords normal;
 
@@ -120,6 +128,21 @@ struct Fault {
 	VrtxCoords tangent2;
 };
 
+/**
+ * Layout of the material parameters per element, which are evaluated while reading the mesh.
+ * The parameters are followed by the maximum wave speed and the S-wave speed.
+ */
+enum class MaterialLayout {
+	/** No parameters available */
+	None,
+	/** rho, mu, lambda */
+	Elastic,
+	/** rho, mu, lambda, Qp, Qs */
+	Viscoelastic,
+	/** rho, c11, ..., c16, c22, ..., c26, c33, ..., c66 */
+	Anisotropic
+};
+
 struct MPINeighbor {
 	/** Local ID of the MPI neighbor */
 	int localID;
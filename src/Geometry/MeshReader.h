@@ -76,9 +76,21 @@ protected:
 	/** Has a plus fault side */
 	bool m_hasPlusFault;
 
+	/** Elements and faces have partition independent global ids */
+	bool m_hasGlobalIds;
+
+	/** Material parameters of the elements, if evaluated by the reader */
+	std::vector<double> m_materialValues;
+
+	/** Number of material parameters per element */
+	unsigned m_numberOfMaterialValues;
+
+	/** Layout of the material parameters */
+	MaterialLayout m_materialLayout;
+
 protected:
 	MeshReader(int rank)
-		: m_rank(rank), m_hasPlusFault(false)
+		: m_rank(rank), m_hasPlusFault(false), m_hasGlobalIds(false), m_numberOfMaterialValues(0), m_materialLayout(MaterialLayout::None)
 	{}
 
 public:
@@ -121,6 +133,43 @@ public:
 		return m_hasPlusFault;
 	}
 
+	bool hasGlobalIds() const
+	{
+		return m_hasGlobalIds;
+	}
+
+	/**
+	 * Material parameters per element, which were evaluated while reading the mesh
+	 * (see LtsWeights::materialValues), or empty.
+	 */
+	const std::vector<double>& getMaterialValues() const
+	{
+		return m_materialValues;
+	}
+
+	unsigned getNumberOfMaterialValues() const
+	{
+		return m_numberOfMaterialValues;
+	}
+
+	/**
+	 * Layout of the material parameters, the model setup only reuses them if it matches its model.
+	 */
+	MaterialLayout getMaterialLayout() const
+	{
+		return m_materialLayout;
+	}
+
+	/**
+	 * Discards the material parameters, e.g. if the mesh is transformed after reading.
+	 */
+	void discardMaterialValues()
+	{
+		m_materialValues.clear();
+		m_numberOfMaterialValues = 0;
+		m_materialLayout = MaterialLayout::None;
+	}
+
   void displaceMesh(double const displacement[3])
   {
     for (unsigned vertexNo = 0; vertexNo < m_vertices.size(); ++vertexNo) {
@@ -128,6 +177,10 @@ public:
         m_vertices[vertexNo].coords[i] += displacement[i];
       }
     }
+    // the material was evaluated at the original coordinates
+    if (displacement[0] != 0.0 || displacement[1] != 0.0 || displacement[2] != 0.0) {
+      discardMaterialValues();
+    }
   }
 
   // scalingMatrix is stored column-major, i.e.
@@ -142,6 +195,13 @@ public:
         m_vertices[vertexNo].coords[i] = scalingMatrix[0][i] * x + scalingMatrix[1][i] * y + scalingMatrix[2][i] * z;
       }
     }
+    for (unsigned i = 0; i < 3; ++i) {
+      for (unsigned j = 0; j < 3; ++j) {
+        if (scalingMatrix[i][j] != ((i == j) ? 1.0 : 0.0)) {
+          discardMaterialValues();
+        }
+      }
+    }
   }
 
 	/**
@@ -177,6 +237,7 @@ public:
 				}
 
 				Fault f;
+				f.globalId = m_hasGlobalIds ? i->faceGlobalIds[j] : 0;
 
 				// Detect +/- side
 				// Computes the distance between the bary center of the tetrahedron and the face
@@ -314,8 +314,14 @@ void read_mesh_puml_c(const char* meshfile, const char* checkPointFile, bool has
 
 	bool readPartitionFromFile = seissol::SeisSol::main.simulator().checkPointingEnabled();
 
+	seissol::initializers::InitializationCache& initializationCache = seissol::SeisSol::main.initializationCache();
+	initializationCache.setUp(meshfile, easiVelocityModel, clusterRate, seissol::SeisSol::main.physicsFeatures().plasticity);
+
 	seissol::initializers::time_stepping::LtsWeights ltsWeights(easiVelocityModel, clusterRate);
-	seissol::SeisSol::main.setMeshReader(new seissol::PUMLReader(meshfile, checkPointFile, &ltsWeights, tpwgt, readPartitionFromFile));
+	seissol::SeisSol::main.setMeshReader(new seissol::PUMLReader(meshfile, checkPointFile, &ltsWeights, tpwgt, readPartitionFromFile, &initializationCache));
+	if (ltsWeights.isOptimized()) {
+		seissol::SeisSol::main.getLtsLayout().setOptimizedClustering(ltsWeights.rate(), ltsWeights.maximumClusterId());
+	}
 
 	read_mesh(rank, seissol::SeisSol::main.meshReader(), hasFault, displacement, scalingMatrix);
 
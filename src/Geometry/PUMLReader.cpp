@@ -49,6 +49,7 @@
 #include "Monitoring/instrumentation.fpp"
 
 #include "Initializer/time_stepping/LtsWeights.h"
+#include "Initializer/InitializationCache.h"
 
 #include <hdf5.h>
 #include <sstream>
@@ -73,22 +74,31 @@ public:
 /**
  * @todo Cleanup this code
  */
-seissol::PUMLReader::PUMLReader(const char *meshFile, const char* checkPointFile, initializers::time_stepping::LtsWeights* ltsWeights, double tpwgt, bool readPartitionFromFile)
+seissol::PUMLReader::PUMLReader(const char *meshFile, const char* checkPointFile, initializers::time_stepping::LtsWeights* ltsWeights, double tpwgt, bool readPartitionFromFile, initializers::InitializationCache* initializationCache)
 	: MeshReader(MPI::mpi.rank())
 {
 	PUML::TETPUML puml;
 	puml.setComm(MPI::mpi.comm());
 
 	read(puml, meshFile);
-  
-	if (ltsWeights != nullptr) {
-		generatePUML(puml);
-		ltsWeights->computeWeights(puml);
+
+	// the partitioning of a checkpoint takes precedence over the initialization cache
+	std::vector<int> cellPartition;
+	if (readPartitionFromFile || !readCachedPartition(puml, ltsWeights, initializationCache, cellPartition)) {
+		if (ltsWeights != nullptr) {
+			generatePUML(puml);
+			ltsWeights->computeWeights(puml);
+		}
+		partition(puml, ltsWeights, tpwgt, meshFile, readPartitionFromFile, checkPointFile, initializationCache, cellPartition);
 	}
-	partition(puml, ltsWeights, tpwgt, meshFile, readPartitionFromFile, checkPointFile);
 
 	generatePUML(puml);
 
+	// the material was evaluated for the weights, hence the model setup can reuse it
+	if (ltsWeights != nullptr && ltsWeights->materialLayout() != MaterialLayout::None) {
+		redistributeMaterial(puml, cellPartition, *ltsWeights);
+	}
+
 	getMesh(puml);
 }
 
@@ -103,6 +113,13 @@ void seissol::PUMLReader::read(PUML::TETPUML &puml, const char* meshFile)
 	puml.addData((file + ":/boundary").c_str(), PUML::CELL);
 }
 
+std::string seissol::PUMLReader::partitionFileName(const char* checkPointFile)
+{
+	std::ostringstream os;
+	os << checkPointFile<<"_partitions_o" <<CONVERGENCE_ORDER<<"_n"<< seissol::MPI::mpi.size() << ".h5";
+	return os.str();
+}
+
 int seissol::PUMLReader::readPartition(PUML::TETPUML &puml, int* partition, const char* checkPointFile)
 {
 	/*
@@ -134,9 +151,7 @@ int seissol::PUMLReader::readPartition(PUML::TETPUML &puml, int* partition, cons
 	hid_t plist_id = H5Pcreate(H5P_FILE_ACCESS);
 	H5Pset_fapl_mpio(plist_id, seissol::MPI::mpi.comm(), info);
 
-	std::ostringstream os;
-	os << checkPointFile<<"_partitions_o" <<CONVERGENCE_ORDER<<"_n"<< nrank << ".h5";
-	std::string fname = os.str();
+	std::string fname = partitionFileName(checkPointFile);
 
 	std::ifstream ifile(fname.c_str());
 	if (!ifile) { 
@@ -207,9 +222,7 @@ void seissol::PUMLReader::writePartition(PUML::TETPUML &puml, int* partition, co
 	hid_t plist_id = H5Pcreate(H5P_FILE_ACCESS);
 	H5Pset_fapl_mpio(plist_id, seissol::MPI::mpi.comm(), info);
 
-	std::ostringstream os;
-	os << checkPointFile<<"_partitions_o" <<CONVERGENCE_ORDER<<"_n"<< nrank << ".h5";
-	std::string fname = os.str();
+	std::string fname = partitionFileName(checkPointFile);
 
 	hid_t file = H5Fcreate(fname.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, plist_id);
 	H5Pclose(plist_id);
@@ -239,16 +252,74 @@ void seissol::PUMLReader::writePartition(PUML::TETPUML &puml, int* partition, co
 	H5Fclose(file);
 }
 
+bool seissol::PUMLReader::readRankCosts(const char* checkPointFile, std::vector<double>& rankCosts)
+{
+	// the costs are tiny, hence every rank reads them independently
+	std::string fname = partitionFileName(checkPointFile);
+	hid_t file = H5Fopen(fname.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+	if (file < 0)
+		logError() << "Could not open" << fname;
+
+	bool found = false;
+	if (H5Lexists(file, "/cost", H5P_DEFAULT) > 0) {
+		hid_t dataset = H5Dopen2(file, "/cost", H5P_DEFAULT);
+		hid_t filespace = H5Dget_space(dataset);
+		hsize_t dim[2];
+		H5Sget_simple_extent_dims(filespace, dim, NULL);
+		if (dim[0] != static_cast<hsize_t>(seissol::MPI::mpi.size()) || dim[1] != 2)
+			logError() << "The costs in" << fname << "do not match the number of ranks";
+
+		rankCosts.resize(dim[0] * dim[1]);
+		if (H5Dread(dataset, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT, rankCosts.data()) < 0)
+			logError() << "An error occured when reading the rank costs with HDF5";
+		H5Sclose(filespace);
+		H5Dclose(dataset);
+		found = true;
+	}
+	H5Fclose(file);
+
+	return found;
+}
+
+void seissol::PUMLReader::writeRankCosts(const char* checkPointFile, std::vector<double> const& rankCosts)
+{
+	if (seissol::MPI::mpi.rank() == 0) {
+		std::string fname = partitionFileName(checkPointFile);
+		hid_t file = H5Fopen(fname.c_str(), H5F_ACC_RDWR, H5P_DEFAULT);
+		if (file < 0)
+			logError() << "Could not open" << fname;
+		if (H5Lexists(file, "/cost", H5P_DEFAULT) > 0)
+			H5Ldelete(file, "/cost", H5P_DEFAULT);
+
+		const hsize_t dim[] = {rankCosts.size() / 2, 2};
+		hid_t filespace = H5Screate_simple(2, dim, NULL);
+		hid_t dataset = H5Dcreate(file, "/cost", H5T_NATIVE_DOUBLE, filespace, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+		if (H5Dwrite(dataset, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT, rankCosts.data()) < 0)
+			logError() << "An error occured when writing the rank costs with HDF5";
+		H5Sclose(filespace);
+		H5Dclose(dataset);
+		H5Fclose(file);
+
+		logInfo(0) << "Measured costs of the ranks written to" << fname;
+	}
+
+#ifdef USE_MPI
+	MPI_Barrier(seissol::MPI::mpi.comm());
+#endif // USE_MPI
+}
+
 void seissol::PUMLReader::partition(  PUML::TETPUML &puml,
                                       initializers::time_stepping::LtsWeights* ltsWeights,
                                       double tpwgt,
                                       const char *meshFile,
                                       bool readPartitionFromFile,
-                                      const char *checkPointFile )
+                                      const char *checkPointFile,
+                                      initializers::InitializationCache* initializationCache,
+                                      std::vector<int>& partition )
 {
 	SCOREP_USER_REGION("PUMLReader_partition", SCOREP_USER_REGION_TYPE_FUNCTION);
 
-	int* partition = new int[puml.numOriginalCells()];
+	partition.resize(puml.numOriginalCells());
 
   auto partitionMetis = [&] {
     PUML::TETPartitionMetis metis(puml.originalCells(), puml.numOriginalCells());
@@ -267,7 +338,7 @@ void seissol::PUMLReader::partition(  PUML::TETPUML &puml,
     double* nodeWeights = &tpwgt;
 #endif
 
-    metis.partition(partition, ltsWeights->vertexWeights(), ltsWeights->nWeightsPerVertex(), nodeWeights, 1.01);
+    metis.partition(partition.data(), ltsWeights->vertexWeights(), ltsWeights->nWeightsPerVertex(), nodeWeights, 1.01);
 
 #ifdef USE_MPI
     delete[] nodeWeights;
@@ -278,14 +349,133 @@ void seissol::PUMLReader::partition(  PUML::TETPUML &puml,
     int status = readPartition(puml, &partition[0], checkPointFile);
     if (status < 0) {
       partitionMetis();
-      writePartition(puml, partition, checkPointFile);
+      writePartition(puml, partition.data(), checkPointFile);
+    } else {
+      // the previous run measured the costs of its ranks, see seissol::Rebalancer
+      std::vector<double> rankCosts;
+      if (ltsWeights != nullptr && readRankCosts(checkPointFile, rankCosts)) {
+        ltsWeights->applyRankCosts(partition.data(), rankCosts);
+        partitionMetis();
+        // the new partition file has no costs, such that further restarts keep the partitioning
+        writePartition(puml, partition.data(), checkPointFile);
+        logInfo(seissol::MPI::mpi.rank()) << "Rebalanced partitioning written to" << partitionFileName(checkPointFile);
+      }
     }
   } else {
     partitionMetis();
+    if (initializationCache != nullptr && initializationCache->enabled()) {
+      std::uint64_t const fingerprint = puml.numOriginalCells();
+      initializationCache->write("partition", fingerprint, partition);
+      initializationCache->write("clustering", fingerprint, std::vector<unsigned>{ltsWeights->rate(),
+                                                                                 ltsWeights->maximumClusterId(),
+                                                                                 ltsWeights->isOptimized() ? 1u : 0u});
+    }
   }
 
-	puml.partition(partition);
-	delete [] partition;
+	puml.partition(partition.data());
+}
+
+bool seissol::PUMLReader::readCachedPartition(PUML::TETPUML &puml, initializers::time_stepping::LtsWeights* ltsWeights, initializers::InitializationCache* initializationCache, std::vector<int>& partition)
+{
+	if (initializationCache == nullptr || !initializationCache->enabled() || ltsWeights == nullptr) {
+		return false;
+	}
+
+	// the cells are distributed evenly before the partitioning
+	std::uint64_t const fingerprint = puml.numOriginalCells();
+	std::vector<unsigned> clustering;
+	if (!initializationCache->read("partition", fingerprint, partition)
+	    || !initializationCache->read("clustering", fingerprint, clustering)) {
+		return false;
+	}
+	assert(partition.size() == puml.numOriginalCells() && clustering.size() == 3);
+
+	ltsWeights->setClustering(clustering[0], clustering[1], clustering[2] != 0);
+	puml.partition(partition.data());
+	return true;
+}
+
+void seissol::PUMLReader::redistributeMaterial(const PUML::TETPUML &puml, const std::vector<int> &partition, const initializers::time_stepping::LtsWeights &ltsWeights)
+{
+	SCOREP_USER_REGION("PUMLReader_redistributeMaterial", SCOREP_USER_REGION_TYPE_FUNCTION);
+
+	const int nrank = seissol::MPI::mpi.size();
+	const unsigned numberOfValues = ltsWeights.numberOfMaterialValues();
+	const std::vector<double>& values = ltsWeights.materialValues();
+	const unsigned long numberOfOriginalCells = puml.numOriginalCells();
+	assert(partition.size() == numberOfOriginalCells);
+
+	// the original cells are distributed in blocks of consecutive global ids
+	unsigned long offset = 0;
+#ifdef USE_MPI
+	MPI_Exscan(&numberOfOriginalCells, &offset, 1, MPI_UNSIGNED_LONG, MPI_SUM, seissol::MPI::mpi.comm());
+	if (seissol::MPI::mpi.rank() == 0) {
+		offset = 0;
+	}
+#endif // USE_MPI
+
+	std::vector<int> sendCounts(nrank, 0);
+	for (unsigned long cell = 0; cell < numberOfOriginalCells; ++cell) {
+		++sendCounts[partition[cell]];
+	}
+	std::vector<int> sendOffsets(nrank + 1, 0);
+	for (int rk = 0; rk < nrank; ++rk) {
+		sendOffsets[rk + 1] = sendOffsets[rk] + sendCounts[rk];
+	}
+
+	std::vector<unsigned long> sendIds(numberOfOriginalCells);
+	std::vector<double> sendValues(numberOfOriginalCells * numberOfValues);
+	std::vector<int> position(sendOffsets.begin(), sendOffsets.end() - 1);
+	for (unsigned long cell = 0; cell < numberOfOriginalCells; ++cell) {
+		int target = position[partition[cell]]++;
+		sendIds[target] = offset + cell;
+		std::copy_n(&values[cell * numberOfValues], numberOfValues, &sendValues[target * numberOfValues]);
+	}
+
+	const std::vector<PUML::TETPUML::cell_t> &cells = puml.cells();
+	std::vector<unsigned long> recvIds;
+	std::vector<double> recvValues;
+#ifdef USE_MPI
+	std::vector<int> recvCounts(nrank);
+	MPI_Alltoall(sendCounts.data(), 1, MPI_INT, recvCounts.data(), 1, MPI_INT, seissol::MPI::mpi.comm());
+	std::vector<int> recvOffsets(nrank + 1, 0);
+	for (int rk = 0; rk < nrank; ++rk) {
+		recvOffsets[rk + 1] = recvOffsets[rk] + recvCounts[rk];
+	}
+	if (static_cast<unsigned>(recvOffsets[nrank]) != cells.size())
+		logError() << "Received the material of" << recvOffsets[nrank] << "cells instead of" << cells.size();
+
+	recvIds.resize(cells.size());
+	MPI_Alltoallv(sendIds.data(), sendCounts.data(), sendOffsets.data(), MPI_UNSIGNED_LONG,
+		recvIds.data(), recvCounts.data(), recvOffsets.data(), MPI_UNSIGNED_LONG, seissol::MPI::mpi.comm());
+
+	// the values are sent in units of one cell
+	MPI_Datatype cellType;
+	MPI_Type_contiguous(numberOfValues, MPI_DOUBLE, &cellType);
+	MPI_Type_commit(&cellType);
+	recvValues.resize(cells.size() * numberOfValues);
+	MPI_Alltoallv(sendValues.data(), sendCounts.data(), sendOffsets.data(), cellType,
+		recvValues.data(), recvCounts.data(), recvOffsets.data(), cellType, seissol::MPI::mpi.comm());
+	MPI_Type_free(&cellType);
+#else // USE_MPI
+	recvIds.swap(sendIds);
+	recvValues.swap(sendValues);
+#endif // USE_MPI
+
+	std::unordered_map<unsigned long, unsigned int> g2l;
+	for (unsigned int cell = 0; cell < cells.size(); ++cell) {
+		g2l[cells[cell].gid()] = cell;
+	}
+
+	m_materialLayout = ltsWeights.materialLayout();
+	m_numberOfMaterialValues = numberOfValues;
+	m_materialValues.resize(cells.size() * numberOfValues);
+	for (unsigned int i = 0; i < recvIds.size(); ++i) {
+		auto it = g2l.find(recvIds[i]);
+		if (it == g2l.end())
+			logError() << "Received the material of the unknown cell" << recvIds[i];
+		std::copy_n(&recvValues[i * numberOfValues], numberOfValues, &m_materialValues[it->second * numberOfValues]);
+	}
 }
 
 void seissol::PUMLReader::generatePUML(PUML::TETPUML &puml)
@@ -312,8 +502,10 @@ void seissol::PUMLReader::getMesh(const PUML::TETPUML &puml)
 
 	// Compute everything local
 	m_elements.resize(cells.size());
+	m_hasGlobalIds = true;
 	for (unsigned int i = 0; i < cells.size(); i++) {
 		m_elements[i].localId = i;
+		m_elements[i].globalId = cells[i].gid();
 
 		// Vertices
 		PUML::Downward::vertices(puml, cells[i], reinterpret_cast<unsigned int*>(m_elements[i].vertices));
@@ -324,6 +516,8 @@ void seissol::PUMLReader::getMesh(const PUML::TETPUML &puml)
 		int neighbors[4];
 		PUML::Neighbor::face(puml, i, neighbors);
 		for (unsigned int j = 0; j < 4; j++) {
+			m_elements[i].faceGlobalIds[FACE_PUML2SEISSOL[j]] = faces[faceids[j]].gid();
+
 			if (neighbors[j] < 0) {
 				m_elements[i].neighbors[FACE_PUML2SEISSOL[j]] = cells.size();
 
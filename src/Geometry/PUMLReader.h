@@ -38,6 +38,9 @@
 #ifndef PUMLREADER_H
 #define PUMLREADER_H
 
+#include <string>
+#include <vector>
+
 #include "MeshReader.h"
 #include "Parallel/MPI.h"
 
@@ -50,6 +53,7 @@ namespace PUML
 
 namespace seissol {
   namespace initializers {
+    class InitializationCache;
     namespace time_stepping {
       class LtsWeights;
     }
@@ -61,7 +65,21 @@ namespace seissol
 class PUMLReader : public MeshReader
 {
 public:
-        PUMLReader(const char* meshFile, const char* checkPointFile, initializers::time_stepping::LtsWeights* ltsWeights = nullptr, double tpwgt = 1.0, bool readPartitionFromFile = false);
+        PUMLReader(const char* meshFile, const char* checkPointFile, initializers::time_stepping::LtsWeights* ltsWeights = nullptr, double tpwgt = 1.0, bool readPartitionFromFile = false, initializers::InitializationCache* initializationCache = nullptr);
+
+	/**
+	 * Name of the file which stores the partitioning
+	 */
+	static std::string partitionFileName(const char* checkPointFile);
+
+	/**
+	 * Stores the measured costs of all ranks in the partition file,
+	 * such that the next run rebalances the partitioning.
+	 * Must be called by all ranks, only rank 0 writes.
+	 *
+	 * @param rankCosts Two costs per rank, see LtsWeights::applyRankCosts.
+	 */
+	static void writeRankCosts(const char* checkPointFile, std::vector<double> const& rankCosts);
 
 private:
 	/**
@@ -72,9 +90,16 @@ private:
 	/**
 	 * Create the partitioning
 	 */
-	void partition(PUML::TETPUML &puml, initializers::time_stepping::LtsWeights* ltsWeights, double tpwgt, const char *meshFile, bool readPartitionFromFile, const char* checkPointFile);
+	void partition(PUML::TETPUML &puml, initializers::time_stepping::LtsWeights* ltsWeights, double tpwgt, const char *meshFile, bool readPartitionFromFile, const char* checkPointFile, initializers::InitializationCache* initializationCache, std::vector<int>& partition);
+	bool readCachedPartition(PUML::TETPUML &puml, initializers::time_stepping::LtsWeights* ltsWeights, initializers::InitializationCache* initializationCache, std::vector<int>& partition);
+
+	/**
+	 * Sends the material parameters of the original cells to the ranks of the partitioning
+	 */
+	void redistributeMaterial(const PUML::TETPUML &puml, const std::vector<int> &partition, const initializers::time_stepping::LtsWeights &ltsWeights);
 	int readPartition(PUML::TETPUML &puml, int* partition, const char *checkPointFile);
 	void writePartition(PUML::TETPUML &puml, int* partition, const char *checkPointFile);
+	bool readRankCosts(const char* checkPointFile, std::vector<double>& rankCosts);
 	/**
 	 * Generate the PUML data structure
 	 */
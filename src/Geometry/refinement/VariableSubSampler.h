@@ -42,6 +42,7 @@
 
 #include <cassert>
 #include <algorithm>
+#include <vector>
 
 #include <Eigen/Dense>
 
@@ -62,6 +63,12 @@ class VariableSubsampler
 private:
     std::vector<basisFunction::SampledBasisFunctions<T> > m_BasisFunctions;
 
+    /** The sampled basis functions of all sub cells (sub cells x basis functions) */
+    Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> m_basisMatrix;
+
+    /** Number of cells evaluated with one matrix-matrix product */
+    static constexpr unsigned int kCellsPerBlock = 16;
+
     /** The original number of cells (without refinement) */
     const unsigned int m_numCells;
 
@@ -92,6 +99,18 @@ public:
 
     void get(const double* inData, const unsigned int* cellMap,
             int variable, double* outData) const;
+
+    /**
+     * Evaluates all variables in one pass over the cells.
+     * The sub cell values of all variables of a block of cells are computed
+     * with one matrix-matrix product of the sampled basis functions
+     * and the gathered degrees of freedom.
+     *
+     * @param outData The output buffer of every variable, nullptr for variables
+     *  which are not required
+     */
+    void get(const double* inData, const unsigned int* cellMap,
+            double* const* outData) const;
 };
 
 //------------------------------------------------------------------------------
@@ -124,6 +143,13 @@ VariableSubsampler<T>::VariableSubsampler(
 
     delete [] subCells;
     delete [] additionalVertices;
+
+    m_basisMatrix.resize(kSubCellsPerCell, m_BasisFunctions[0].m_data.size());
+    for (unsigned int i = 0; i < kSubCellsPerCell; i++) {
+        for (unsigned int j = 0; j < m_BasisFunctions[i].m_data.size(); j++) {
+            m_basisMatrix(i, j) = m_BasisFunctions[i].m_data[j];
+        }
+    }
 }
 
 //------------------------------------------------------------------------------
@@ -146,6 +172,60 @@ void VariableSubsampler<T>::get(const double* inData,  const unsigned int* cellM
 
 //------------------------------------------------------------------------------
 
+template<typename T>
+void VariableSubsampler<T>::get(const double* inData,  const unsigned int* cellMap,
+        double* const* outData) const
+{
+    std::vector<unsigned int> variables;
+    for (unsigned int v = 0; v < kNumVariables; v++) {
+        if (outData[v] != nullptr)
+            variables.push_back(v);
+    }
+    if (variables.empty())
+        return;
+
+    const unsigned int numBasisFunctions = m_basisMatrix.cols();
+    const unsigned int numVariables = variables.size();
+    const unsigned int numBlocks = (m_numCells + kCellsPerBlock - 1) / kCellsPerBlock;
+
+#ifdef _OPENMP
+    #pragma omp parallel
+#endif
+    {
+        // one column per cell and variable
+        Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> dofs(numBasisFunctions, kCellsPerBlock * numVariables);
+        Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> samples(kSubCellsPerCell, kCellsPerBlock * numVariables);
+
+#ifdef _OPENMP
+        #pragma omp for schedule(static)
+#endif
+        for (unsigned int block = 0; block < numBlocks; ++block) {
+            const unsigned int firstCell = block * kCellsPerBlock;
+            const unsigned int numCells = std::min(kCellsPerBlock, m_numCells - firstCell);
+            const unsigned int numColumns = numCells * numVariables;
+
+            for (unsigned int c = 0; c < numCells; ++c) {
+                for (unsigned int v = 0; v < numVariables; ++v) {
+                    dofs.col(c * numVariables + v) = Eigen::Map<const Eigen::VectorXd>(
+                        &inData[getInVarOffset(firstCell + c, variables[v], cellMap)],
+                        numBasisFunctions).template cast<T>();
+                }
+            }
+
+            samples.leftCols(numColumns).noalias() = m_basisMatrix * dofs.leftCols(numColumns);
+
+            for (unsigned int c = 0; c < numCells; ++c) {
+                for (unsigned int v = 0; v < numVariables; ++v) {
+                    std::copy_n(samples.col(c * numVariables + v).data(), kSubCellsPerCell,
+                        &outData[variables[v]][getOutVarOffset(firstCell + c, 0)]);
+                }
+            }
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+
 } // namespace
 }
 
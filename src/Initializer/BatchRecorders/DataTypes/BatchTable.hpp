@@ -1,49 +1,69 @@
 #ifndef SEISSOL_POINTERSTABLE_HPP
 #define SEISSOL_POINTERSTABLE_HPP
 
-#ifdef ACL_DEVICE
-
 #include "Condition.hpp"
 #include "EncodedConstants.hpp"
-#include <device.h>
+#include <Kernels/precision.hpp>
+#include <array>
+#include <cassert>
 #include <string>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
+#ifdef ACL_DEVICE
+#include <device.h>
+#endif // ACL_DEVICE
+
 namespace seissol::initializers::recording {
 
+/**
+ * Pointers to the data of all elements of a batch.
+ * With accelerators, the pointers are copied to the device;
+ * otherwise, the batch is executed on the host (see SEISSOL_NEIGHBOR_INTEGRATION).
+ * */
 class BatchPointers {
 public:
   explicit BatchPointers(std::vector<real *> collectedPointers)
       : pointers(std::move(collectedPointers)), devicePtrs(nullptr) {
+#ifdef ACL_DEVICE
     if (!pointers.empty()) {
       devicePtrs = (real **)device.api->allocGlobMem(pointers.size() * sizeof(real *));
       device.api->copyTo(devicePtrs, pointers.data(), pointers.size() * sizeof(real *));
     }
+#endif // ACL_DEVICE
   }
 
   BatchPointers(const BatchPointers &other) : pointers(other.pointers), devicePtrs(nullptr) {
+#ifdef ACL_DEVICE
     if (!pointers.empty()) {
       if (other.devicePtrs != nullptr) {
         devicePtrs = (real **)device.api->allocGlobMem(other.pointers.size() * sizeof(real *));
         device.api->copyBetween(devicePtrs, other.devicePtrs, other.pointers.size() * sizeof(real *));
       }
     }
+#endif // ACL_DEVICE
   }
 
   BatchPointers &operator=(const BatchPointers &Other) = delete;
 
   virtual ~BatchPointers() {
+#ifdef ACL_DEVICE
     if (devicePtrs != nullptr) {
       device.api->freeMem(devicePtrs);
       devicePtrs = nullptr;
     }
+#endif // ACL_DEVICE
   }
 
   real **getPointers() {
+#ifdef ACL_DEVICE
     assert(devicePtrs != nullptr && "requested batch has not been recorded");
     return devicePtrs;
+#else
+    assert(!pointers.empty() && "requested batch has not been recorded");
+    return pointers.data();
+#endif // ACL_DEVICE
   }
   size_t getSize() {
     return pointers.size();
@@ -52,7 +72,9 @@ public:
 private:
   std::vector<real *> pointers{};
   real **devicePtrs{nullptr};
+#ifdef ACL_DEVICE
   device::DeviceInstance &device = device::DeviceInstance::getInstance();
+#endif // ACL_DEVICE
 };
 
 /**
@@ -78,11 +100,4 @@ public:
 
 } // namespace seissol::initializers::recording
 
-#else  // ACL_DEVICE
-namespace seissol::initializers::recording {
-// Provide a dummy implementation for a pure CPU execution
-struct BatchTable {};
-} // namespace seissol::initializers::recording
-#endif // ACL_DEVICE
-
 #endif // SEISSOL_POINTERSTABLE_HPP
@@ -4,7 +4,9 @@
 #include <yateto.h>
 
 
+#ifdef ACL_DEVICE
 using namespace device;
+#endif
 using namespace seissol::initializers;
 using namespace seissol::initializers::recording;
 
@@ -125,8 +127,13 @@ void NeighIntegrationRecorder::recordNeighbourFluxIntegrals() {
 
             regularPeriodicDofs[face][faceRelation].push_back(static_cast<real *>(data.dofs));
             regularPeriodicIDofs[face][faceRelation].push_back(idofsAddressRegistry[neighbourBufferPtr]);
+#ifdef ACL_DEVICE
             regularPeriodicAminusT[face][faceRelation].push_back(
                 static_cast<real *>(data.neighIntegrationOnDevice.nAmNm1[face]));
+#else
+            regularPeriodicAminusT[face][faceRelation].push_back(
+                static_cast<real *>(data.neighboringIntegration.nAmNm1[face]));
+#endif
             break;
           }
           case FaceType::freeSurface: {
@@ -145,6 +152,13 @@ void NeighIntegrationRecorder::recordNeighbourFluxIntegrals() {
           }
           case FaceType::outflow:
             break;
+#ifndef ACL_DEVICE
+          // handled by the local integration on the host
+          case FaceType::analytical:
+          case FaceType::freeSurfaceGravity:
+          case FaceType::dirichlet:
+            break;
+#else
           case FaceType::analytical: {
             logError() << "analytical boundary condition is not supported in batched computations";
             break;
@@ -157,6 +171,7 @@ void NeighIntegrationRecorder::recordNeighbourFluxIntegrals() {
             logError() << "dirichlet boundary condition is not supported in batched computations";
             break;
           }
+#endif
           default: {
             logError() << "unknown boundary condition type: " << static_cast<int>(data.cellInformation.faceTypes[face]);
             }
@@ -43,10 +43,15 @@
 #include <Initializer/typedefs.hpp>
 #include <Initializer/tree/LTSTree.hpp>
 #include <generated_code/tensor.h>
+#include <generated_code/init.h>
 
 namespace seissol {
   namespace initializers {
     struct DynamicRupture;
+
+    //! Number of Gauss points on a fault face and the padded leading dimension of QInterpolated
+    constexpr unsigned numberOfDRPoints = tensor::QInterpolated::Shape[0];
+    constexpr unsigned numberOfPaddedDRPoints = init::QInterpolated::Stop[0] - init::QInterpolated::Start[0];
   }
 }
 
@@ -67,6 +72,30 @@ struct seissol::initializers::DynamicRupture {
   Variable<DRFaceInformation>                                       faceInformation;
   Variable<model::IsotropicWaveSpeeds>                              waveSpeedsPlus;
   Variable<model::IsotropicWaveSpeeds>                              waveSpeedsMinus;
+
+  // Friction solver: parameters and state per Gauss point (structure of arrays)
+  Variable<real[6][numberOfPaddedDRPoints]>                         initialStressInFaultCS;
+  Variable<real[numberOfPaddedDRPoints]>                            cohesion;
+  Variable<real[numberOfPaddedDRPoints]>                            muS;
+  Variable<real[numberOfPaddedDRPoints]>                            muD;
+  Variable<real[numberOfPaddedDRPoints]>                            dC;
+  Variable<real[numberOfPaddedDRPoints]>                            forcedRuptureTime;
+  Variable<real[numberOfPaddedDRPoints]>                            mu;
+  Variable<real[numberOfPaddedDRPoints]>                            slip;
+  Variable<real[numberOfPaddedDRPoints]>                            slip1;
+  Variable<real[numberOfPaddedDRPoints]>                            slip2;
+  Variable<real[numberOfPaddedDRPoints]>                            slipRate1;
+  Variable<real[numberOfPaddedDRPoints]>                            slipRate2;
+  Variable<real[numberOfPaddedDRPoints]>                            stateVariable;
+  Variable<real[numberOfPaddedDRPoints]>                            tractionXY;
+  Variable<real[numberOfPaddedDRPoints]>                            tractionXZ;
+  Variable<real[numberOfPaddedDRPoints]>                            ruptureTime;
+  Variable<real[numberOfPaddedDRPoints]>                            dynStressTime;
+  Variable<real[numberOfPaddedDRPoints]>                            peakSlipRate;
+  Variable<bool[numberOfPaddedDRPoints]>                            ruptureFront;
+  Variable<bool[numberOfPaddedDRPoints]>                            dynStressPending;
+  Variable<real>                                                    averagedSlip;
+  Variable<bool>                                                    magnitudeOutput;
   
   
   void addTo(LTSTree& tree) {
@@ -81,6 +110,28 @@ struct seissol::initializers::DynamicRupture {
     tree.addVar(         faceInformation,             mask,                 1,      seissol::memory::Standard );
     tree.addVar(          waveSpeedsPlus,             mask,                 1,      seissol::memory::Standard );
     tree.addVar(         waveSpeedsMinus,             mask,                 1,      seissol::memory::Standard );
+    tree.addVar(  initialStressInFaultCS,             mask,         ALIGNMENT,      seissol::memory::Standard );
+    tree.addVar(                cohesion,             mask,         ALIGNMENT,      seissol::memory::Standard );
+    tree.addVar(                     muS,             mask,         ALIGNMENT,      seissol::memory::Standard );
+    tree.addVar(                     muD,             mask,         ALIGNMENT,      seissol::memory::Standard );
+    tree.addVar(                      dC,             mask,         ALIGNMENT,      seissol::memory::Standard );
+    tree.addVar(       forcedRuptureTime,             mask,         ALIGNMENT,      seissol::memory::Standard );
+    tree.addVar(                      mu,             mask,         ALIGNMENT,      seissol::memory::Standard );
+    tree.addVar(                    slip,             mask,         ALIGNMENT,      seissol::memory::Standard );
+    tree.addVar(                   slip1,             mask,         ALIGNMENT,      seissol::memory::Standard );
+    tree.addVar(                   slip2,             mask,         ALIGNMENT,      seissol::memory::Standard );
+    tree.addVar(               slipRate1,             mask,         ALIGNMENT,      seissol::memory::Standard );
+    tree.addVar(               slipRate2,             mask,         ALIGNMENT,      seissol::memory::Standard );
+    tree.addVar(           stateVariable,             mask,         ALIGNMENT,      seissol::memory::Standard );
+    tree.addVar(              tractionXY,             mask,         ALIGNMENT,      seissol::memory::Standard );
+    tree.addVar(              tractionXZ,             mask,         ALIGNMENT,      seissol::memory::Standard );
+    tree.addVar(             ruptureTime,             mask,         ALIGNMENT,      seissol::memory::Standard );
+    tree.addVar(           dynStressTime,             mask,         ALIGNMENT,      seissol::memory::Standard );
+    tree.addVar(            peakSlipRate,             mask,         ALIGNMENT,      seissol::memory::Standard );
+    tree.addVar(            ruptureFront,             mask,                 1,      seissol::memory::Standard );
+    tree.addVar(        dynStressPending,             mask,                 1,      seissol::memory::Standard );
+    tree.addVar(            averagedSlip,             mask,                 1,      seissol::memory::Standard );
+    tree.addVar(         magnitudeOutput,             mask,                 1,      seissol::memory::Standard );
   }
 };
 #endif
@@ -0,0 +1,265 @@
+/**
+ * @file
+ * This file is part of SeisSol.
+ *
+ * @section LICENSE
+ * Copyright (c) 2020, SeisSol Group
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @section DESCRIPTION
+ * On-disk cache of derived initialization data.
+ **/
+
+#include "InitializationCache.h"
+
+#include <cerrno>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iterator>
+#include <sstream>
+#include <sys/stat.h>
+
+#include <Kernels/precision.hpp>
+#include <Geometry/MeshReader.h>
+#include <Parallel/MPI.h>
+
+#include <utils/env.h>
+#include <utils/logger.h>
+
+namespace {
+  //! Header of every file of the cache
+  struct EntryHeader {
+    char magic[8];
+    std::uint64_t key;
+    std::uint64_t fingerprint;
+    std::uint64_t elementSize;
+    std::uint64_t size;
+    std::uint64_t checksum;
+  };
+
+  constexpr char Magic[8] = {'S', 'E', 'I', 'S', 'I', 'N', 'I', '1'};
+
+  enum EntryState {
+    Missing = 0,
+    Invalid = 1,
+    Valid = 2
+  };
+
+  //! Options of the build, which change the cached data
+  std::string buildConfiguration() {
+    std::ostringstream config;
+    config << "order=" << CONVERGENCE_ORDER << ";real=" << sizeof(real);
+#ifdef NUMBER_OF_RELAXATION_MECHANISMS
+    config << ";mechanisms=" << NUMBER_OF_RELAXATION_MECHANISMS;
+#endif
+#ifdef USE_ELASTIC
+    config << ";elastic";
+#endif
+#if defined USE_VISCOELASTIC || defined USE_VISCOELASTIC2
+    config << ";viscoelastic";
+#endif
+#ifdef USE_ANISOTROPIC
+    config << ";anisotropic";
+#endif
+    return config.str();
+  }
+}
+
+std::uint64_t seissol::initializers::InitializationCache::hash( void const* data,
+                                                                std::size_t size,
+                                                                std::uint64_t seed ) {
+  unsigned char const* bytes = static_cast<unsigned char const*>(data);
+  std::uint64_t result = seed;
+  for (std::size_t i = 0; i < size; ++i) {
+    result ^= bytes[i];
+    result *= 1099511628211ull;
+  }
+  return result;
+}
+
+std::uint64_t seissol::initializers::InitializationCache::meshFingerprint( MeshReader const& meshReader ) {
+  std::vector<Element> const& elements = meshReader.getElements();
+  std::vector<Vertex> const& vertices = meshReader.getVertices();
+
+  std::uint64_t fingerprint = hash(nullptr, 0);
+  for (auto const& element : elements) {
+    for (unsigned vertex = 0; vertex < 4; ++vertex) {
+      fingerprint = hash(vertices[ element.vertices[vertex] ].coords, sizeof(VrtxCoords), fingerprint);
+    }
+    fingerprint = hash(&element.material, sizeof(element.material), fingerprint);
+  }
+  return fingerprint;
+}
+
+void seissol::initializers::InitializationCache::setUp( std::string const& meshFile,
+                                                        std::string const& materialFile,
+                                                        unsigned clusterRate,
+                                                        bool plasticity ) {
+  const int rank = seissol::MPI::mpi.rank();
+
+  m_directory = utils::Env::get<std::string>("SEISSOL_INIT_CACHE", "");
+  if (m_directory.empty()) {
+    return;
+  }
+
+  if (rank == 0) {
+    std::ostringstream input;
+    input << buildConfiguration() << ";ranks=" << seissol::MPI::mpi.size() << ";rate=" << clusterRate;
+    if (plasticity) {
+      input << ";plasticity";
+    }
+
+    struct stat meshStat;
+    if (stat(meshFile.c_str(), &meshStat) != 0) {
+      logError() << "Could not read the mesh file" << meshFile;
+    }
+    input << ";mesh=" << meshFile << ':' << meshStat.st_size << ':' << meshStat.st_mtime;
+
+    // the partitioning depends on the clustering and the weights
+    for (char const* variable : { "SEISSOL_LTS_CLUSTERING", "SEISSOL_LTS_MAX_RATE", "SEISSOL_LTS_ELEMENT_COST",
+                                  "SEISSOL_LTS_CLUSTER_OVERHEAD", "SEISSOL_LTS_DR_COST", "SEISSOL_LTS_PLASTICITY_COST",
+                                  "SEISSOL_LTS_GRAVITY_COST", "SEISSOL_PARTITION_CONSTRAINTS" }) {
+      input << ';' << variable << '=' << utils::Env::get<std::string>(variable, "");
+    }
+
+    std::string const config = input.str();
+    m_key = hash(config.data(), config.size());
+
+    std::ifstream material(materialFile, std::ios::binary);
+    if (!material) {
+      logError() << "Could not read the material file" << materialFile;
+    }
+    std::string const content((std::istreambuf_iterator<char>(material)), std::istreambuf_iterator<char>());
+    m_key = hash(content.data(), content.size(), m_key);
+
+    int ret = mkdir(m_directory.c_str(), S_IRWXU | S_IRWXG | S_IRWXO);
+    if (ret < 0 && errno != EEXIST) {
+      logError() << "Could not create the initialization cache" << m_directory;
+    }
+  }
+
+#ifdef USE_MPI
+  // the key has to be the same on all ranks, and all ranks have to see the directory
+  MPI_Bcast(&m_key, 1, MPI_UINT64_T, 0, seissol::MPI::mpi.comm());
+#endif // USE_MPI
+
+  logInfo(rank) << "Using the initialization cache" << m_directory << "with key" << keyString();
+}
+
+std::string seissol::initializers::InitializationCache::keyString() const {
+  std::ostringstream os;
+  os << std::hex << std::setw(16) << std::setfill('0') << m_key;
+  return os.str();
+}
+
+std::string seissol::initializers::InitializationCache::fileName( std::string const& name ) const {
+  std::ostringstream os;
+  os << m_directory << '/' << keyString() << '_' << name << "_r" << seissol::MPI::mpi.rank() << ".bin";
+  return os.str();
+}
+
+bool seissol::initializers::InitializationCache::readBytes( std::string const& name,
+                                                            std::uint64_t fingerprint,
+                                                            std::size_t elementSize,
+                                                            std::vector<char>& bytes ) {
+  if (!enabled()) {
+    return false;
+  }
+
+  int state = Missing;
+  std::ifstream file(fileName(name), std::ios::binary);
+  if (file) {
+    state = Invalid;
+    EntryHeader header;
+    if (file.read(reinterpret_cast<char*>(&header), sizeof(header))
+        && std::memcmp(header.magic, Magic, sizeof(Magic)) == 0
+        && header.key == m_key
+        && header.fingerprint == fingerprint
+        && header.elementSize == elementSize
+        && header.size % elementSize == 0) {
+      bytes.resize(header.size);
+      if (file.read(bytes.data(), header.size) && hash(bytes.data(), bytes.size()) == header.checksum) {
+        state = Valid;
+      }
+    }
+  }
+
+  int states[2] = {state, -state};
+#ifdef USE_MPI
+  MPI_Allreduce(MPI_IN_PLACE, states, 2, MPI_INT, MPI_MIN, seissol::MPI::mpi.comm());
+#endif // USE_MPI
+  int const minimumState = states[0];
+  int const maximumState = -states[1];
+
+  const int rank = seissol::MPI::mpi.rank();
+  if (minimumState == Valid) {
+    logInfo(rank) << "Read" << name << "from the initialization cache.";
+    return true;
+  }
+  if (minimumState == Invalid || maximumState == Valid) {
+    logWarning(rank) << "The" << name << "in the initialization cache do not match the current run. Recomputing.";
+  }
+  bytes.clear();
+  return false;
+}
+
+void seissol::initializers::InitializationCache::writeBytes( std::string const& name,
+                                                             std::uint64_t fingerprint,
+                                                             std::size_t elementSize,
+                                                             void const* data,
+                                                             std::size_t size ) {
+  if (!enabled()) {
+    return;
+  }
+
+  EntryHeader header;
+  std::memcpy(header.magic, Magic, sizeof(Magic));
+  header.key = m_key;
+  header.fingerprint = fingerprint;
+  header.elementSize = elementSize;
+  header.size = size;
+  header.checksum = hash(data, size);
+
+  // a partially written file must never be read, hence we write to a temporary file first
+  std::string const finalName = fileName(name);
+  std::string const temporaryName = finalName + ".tmp";
+  {
+    std::ofstream file(temporaryName, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<char const*>(&header), sizeof(header));
+    file.write(static_cast<char const*>(data), size);
+    if (!file) {
+      logWarning() << "Could not write" << temporaryName;
+      return;
+    }
+  }
+  if (std::rename(temporaryName.c_str(), finalName.c_str()) != 0) {
+    logWarning() << "Could not write" << finalName;
+  }
+}
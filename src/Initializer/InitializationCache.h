@@ -0,0 +1,140 @@
+/**
+ * @file
+ * This file is part of SeisSol.
+ *
+ * @section LICENSE
+ * Copyright (c) 2020, SeisSol Group
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @section DESCRIPTION
+ * On-disk cache of derived initialization data.
+ **/
+
+#ifndef INITIALIZER_INITIALIZATIONCACHE_H_
+#define INITIALIZER_INITIALIZATIONCACHE_H_
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+class MeshReader;
+
+namespace seissol {
+  namespace initializers {
+    class InitializationCache;
+  }
+}
+
+/**
+ * Stores derived initialization data per rank in SEISSOL_INIT_CACHE, such that
+ * subsequent runs with the same mesh, material, order, number of ranks and build
+ * configuration skip their computation.
+ *
+ * Every entry is stored in one file per rank, which all ranks read concurrently.
+ * An entry is only used if the files of all ranks match the key of the run, the
+ * fingerprint of the entry and their checksum; otherwise it is recomputed and overwritten.
+ **/
+class seissol::initializers::InitializationCache {
+public:
+  /**
+   * Reads SEISSOL_INIT_CACHE and derives the key of this run. Collective.
+   *
+   * @param meshFile The mesh file (identified by its name, size and modification time).
+   * @param materialFile The easi material file (identified by its content).
+   * @param clusterRate The LTS rate of the parameter file.
+   * @param plasticity True if plasticity is enabled, which changes the weights of the partitioning.
+   **/
+  void setUp( std::string const& meshFile,
+              std::string const& materialFile,
+              unsigned clusterRate,
+              bool plasticity );
+
+  bool enabled() const { return !m_directory.empty(); }
+
+  /**
+   * Reads an entry. Collective.
+   *
+   * @param fingerprint Identifies the input of the entry on this rank, e.g. the local mesh.
+   * @return true on all ranks if every rank has a valid entry.
+   **/
+  template<typename T>
+  bool read(std::string const& name, std::uint64_t fingerprint, std::vector<T>& data) {
+    static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types can be cached");
+    std::vector<char> bytes;
+    if (!readBytes(name, fingerprint, sizeof(T), bytes)) {
+      return false;
+    }
+    data.resize(bytes.size() / sizeof(T));
+    std::memcpy(data.data(), bytes.data(), bytes.size());
+    return true;
+  }
+
+  /**
+   * Writes an entry of this rank.
+   **/
+  template<typename T>
+  void write(std::string const& name, std::uint64_t fingerprint, std::vector<T> const& data) {
+    static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types can be cached");
+    writeBytes(name, fingerprint, sizeof(T), data.data(), data.size() * sizeof(T));
+  }
+
+  //! FNV-1a hash
+  static std::uint64_t hash( void const* data,
+                             std::size_t size,
+                             std::uint64_t seed = 14695981039346656037ull );
+
+  //! Identifies the local mesh by the coordinates and the material group of its elements
+  static std::uint64_t meshFingerprint( MeshReader const& meshReader );
+
+private:
+  std::string keyString() const;
+
+  std::string fileName( std::string const& name ) const;
+
+  bool readBytes( std::string const& name,
+                  std::uint64_t fingerprint,
+                  std::size_t elementSize,
+                  std::vector<char>& bytes );
+
+  void writeBytes( std::string const& name,
+                   std::uint64_t fingerprint,
+                   std::size_t elementSize,
+                   void const* data,
+                   std::size_t size );
+
+  //! Directory of the cache, empty if disabled
+  std::string m_directory;
+
+  //! Hash of the input and the configuration of this run
+  std::uint64_t m_key = 0;
+};
+
+#endif
@@ -103,20 +103,18 @@ struct seissol::initializers::LTS {
   Bucket                                  buffersDerivatives;
   Bucket                                  displacementsBuffer;
 
+  ScratchpadMemory                        idofsScratch;
+
 #ifdef ACL_DEVICE
   Variable<LocalIntegrationData>          localIntegrationOnDevice;
   Variable<NeighboringIntegrationData>    neighIntegrationOnDevice;
-  ScratchpadMemory                        idofsScratch;
   ScratchpadMemory                        derivativesScratch;
 #endif
   
   /// \todo Memkind
-  void addTo(LTSTree& tree) {
-#ifdef USE_PLASTICITY
-    LayerMask plasticityMask = LayerMask(Ghost);
-#else
-    LayerMask plasticityMask = LayerMask(Ghost) | LayerMask(Copy) | LayerMask(Interior);
-#endif
+  /// @param usePlasticity the plasticity data and the plastic strain are only allocated with plasticity
+  void addTo(LTSTree& tree, bool usePlasticity) {
+    LayerMask plasticityMask = usePlasticity ? LayerMask(Ghost) : LayerMask(Ghost) | LayerMask(Copy) | LayerMask(Interior);
     tree.addVar(                    dofs, LayerMask(Ghost),     PAGESIZE_HEAP,      MEMKIND_DOFS );
     if (kernels::size<tensor::Qane>() > 0) {
       tree.addVar(                 dofsAne, LayerMask(Ghost),     PAGESIZE_HEAP,      MEMKIND_DOFS );
@@ -142,6 +140,9 @@ struct seissol::initializers::LTS {
     tree.addVar(   neighIntegrationOnDevice,   LayerMask(Ghost),  1,      seissol::memory::DeviceGlobalMemory );
     tree.addScratchpadMemory(  idofsScratch,                      1,      seissol::memory::DeviceGlobalMemory);
     tree.addScratchpadMemory(derivativesScratch,                  1,      seissol::memory::DeviceGlobalMemory);
+#else
+    // only allocated for the batched neighbor integration (see MemoryManager::recordNeighborIntegration)
+    tree.addScratchpadMemory(  idofsScratch,          PAGESIZE_HEAP,      MEMKIND_TIMEDOFS );
 #endif
   }
 };
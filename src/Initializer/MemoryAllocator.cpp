@@ -70,6 +70,13 @@
  **/
 #include "MemoryAllocator.h"
 #include <Parallel/MPI.h>
+#include <Parallel/Partition.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <unistd.h>
+#include <sys/syscall.h>
 
 #include <utils/logger.h>
 
@@ -169,6 +176,113 @@ void seissol::memory::printMemoryAlignment( std::vector< std::vector<unsigned lo
   }
 }
 
+size_t seissol::memory::pageSize() {
+  static size_t const size = sysconf(_SC_PAGESIZE);
+  return size;
+}
+
+size_t seissol::memory::cellOffset( size_t i_size, unsigned i_numberOfCells, unsigned i_cell ) {
+  return i_size / i_numberOfCells * i_cell + i_size % i_numberOfCells * i_cell / i_numberOfCells;
+}
+
+void seissol::memory::touch( void* i_memory, size_t i_size, unsigned i_numberOfCells, bool i_interleave ) {
+  char* memory = static_cast<char*>(i_memory);
+  if (memory == NULL || i_size == 0) {
+    return;
+  }
+
+#ifdef _OPENMP
+  #pragma omp parallel
+#endif
+  {
+    if (i_interleave) {
+      size_t const page = pageSize();
+#ifdef _OPENMP
+      size_t const stride = omp_get_num_threads() * page;
+      size_t offset = omp_get_thread_num() * page;
+#else
+      size_t const stride = page;
+      size_t offset = 0;
+#endif
+      for (; offset < i_size; offset += stride) {
+        memset(memory + offset, 0, std::min(page, i_size - offset));
+      }
+    } else if (i_numberOfCells > 0) {
+      unsigned firstCell, lastCell;
+      seissol::parallel::staticPartition(i_numberOfCells, firstCell, lastCell);
+      size_t const begin = cellOffset(i_size, i_numberOfCells, firstCell);
+      size_t const end = cellOffset(i_size, i_numberOfCells, lastCell);
+      memset(memory + begin, 0, end - begin);
+    }
+  }
+}
+
+void seissol::memory::printNumaDomains( char const* i_name, std::vector< std::pair<void const*, size_t> > const& i_regions ) {
+  // move_pages without target nodes returns the NUMA domain of each page (or -ENOENT if it has not been touched)
+  size_t const page = pageSize();
+  unsigned const pagesPerCall = 4096;
+  std::vector<void*> pages;
+  std::vector<int> status(pagesPerCall);
+  std::vector<unsigned long long> bytesPerDomain;
+  unsigned long long untouchedBytes = 0;
+  bool available = true;
+
+  pages.reserve(pagesPerCall);
+  for (auto const& region : i_regions) {
+    if (region.first == NULL || region.second == 0 || !available) {
+      continue;
+    }
+    uintptr_t const begin = reinterpret_cast<uintptr_t>(region.first);
+    uintptr_t const end = begin + region.second;
+    for (uintptr_t first = begin - begin % page; first < end && available; first += pagesPerCall * page) {
+      pages.clear();
+      for (uintptr_t address = first; address < end && pages.size() < pagesPerCall; address += page) {
+        pages.push_back(reinterpret_cast<void*>(address));
+      }
+      if (syscall(SYS_move_pages, 0, pages.size(), pages.data(), NULL, status.data(), 0) != 0) {
+        available = false;
+        break;
+      }
+      for (unsigned p = 0; p < pages.size(); ++p) {
+        uintptr_t const address = reinterpret_cast<uintptr_t>(pages[p]);
+        unsigned long long const bytes = std::min<uintptr_t>(address + page, end) - std::max(address, begin);
+        if (status[p] >= 0) {
+          if (static_cast<size_t>(status[p]) >= bytesPerDomain.size()) {
+            bytesPerDomain.resize(status[p] + 1, 0);
+          }
+          bytesPerDomain[status[p]] += bytes;
+        } else {
+          untouchedBytes += bytes;
+        }
+      }
+    }
+  }
+
+  int numberOfDomains = available ? bytesPerDomain.size() : -1;
+#ifdef USE_MPI
+  int anyUnavailable = available ? 0 : 1;
+  MPI_Allreduce(MPI_IN_PLACE, &anyUnavailable, 1, MPI_INT, MPI_MAX, seissol::MPI::mpi.comm());
+  MPI_Allreduce(MPI_IN_PLACE, &numberOfDomains, 1, MPI_INT, MPI_MAX, seissol::MPI::mpi.comm());
+  available = (anyUnavailable == 0);
+#endif
+  if (!available) {
+    logInfo(seissol::MPI::mpi.rank()) << "NUMA domains of the" << i_name << "are not available on this system.";
+    return;
+  }
+
+  bytesPerDomain.resize(numberOfDomains, 0);
+  bytesPerDomain.push_back(untouchedBytes);
+#ifdef USE_MPI
+  MPI_Allreduce(MPI_IN_PLACE, bytesPerDomain.data(), bytesPerDomain.size(), MPI_UNSIGNED_LONG_LONG, MPI_SUM, seissol::MPI::mpi.comm());
+#endif
+
+  logInfo(seissol::MPI::mpi.rank()) << "Memory of the" << i_name << "per NUMA domain (summed over all ranks):";
+  for (int domain = 0; domain < numberOfDomains; ++domain) {
+    logInfo(seissol::MPI::mpi.rank()) << "  Domain" << domain << ":" << bytesPerDomain[domain] / (1024.0 * 1024.0) << "MiB";
+  }
+  logInfo(seissol::MPI::mpi.rank()) << "  Not touched:" << bytesPerDomain.back() / (1024.0 * 1024.0) << "MiB";
+}
+
 seissol::memory::ManagedAllocator::~ManagedAllocator()
 {
   for (AddressVector::const_iterator it = m_dataMemoryAddresses.begin(); it != m_dataMemoryAddresses.end(); ++it) {
@@ -99,6 +99,47 @@ namespace seissol {
      * @param i_memoryAlignment memory alignment.
      **/
     void printMemoryAlignment( std::vector< std::vector<unsigned long long> > i_memoryAlignment );
+
+    /**
+     * Placement of the pages of the LTS tree on the NUMA domains (SEISSOL_MEMORY_PLACEMENT).
+     **/
+    enum Placement {
+      DefaultPlacement = 0,        //!< pages are placed by the initialization of the data
+      ComputePlacement = 1,        //!< pages are first touched with the thread-to-cell mapping of the compute loops
+      InterleavedCopyPlacement = 2 //!< as ComputePlacement, but the pages of the copy layers are interleaved
+    };
+
+    //! Size of a memory page in bytes
+    size_t pageSize();
+
+    /**
+     * Offset of a cell in the memory of a layer, which is not necessarily a multiple of the number of cells (e.g. buckets).
+     *
+     * @param i_size size of the memory in bytes.
+     * @param i_numberOfCells number of cells of the layer.
+     * @param i_cell cell id, i_numberOfCells yields i_size.
+     **/
+    size_t cellOffset( size_t i_size, unsigned i_numberOfCells, unsigned i_cell );
+
+    /**
+     * Zeroes the memory of a layer in parallel, where thread i touches the part which belongs to its cells
+     * in seissol::parallel::staticPartition. With i_interleave, the pages are distributed round-robin over the threads.
+     *
+     * @param i_memory memory of the layer.
+     * @param i_size size of the memory in bytes.
+     * @param i_numberOfCells number of cells of the layer.
+     * @param i_interleave distribute the pages round-robin.
+     **/
+    void touch( void* i_memory, size_t i_size, unsigned i_numberOfCells, bool i_interleave );
+
+    /**
+     * Logs how many bytes of the given memory regions reside on each NUMA domain, summed over all ranks.
+     *
+     * @param i_name name of the data structure.
+     * @param i_regions start and size in bytes of the memory regions.
+     **/
+    void printNumaDomains( char const* i_name, std::vector< std::pair<void const*, size_t> > const& i_regions );
+
     class ManagedAllocator;
   }
 }
@@ -71,19 +71,19 @@
 #include "MemoryManager.h"
 #include "InternalState.h"
 #include "GlobalData.h"
+#include "ResultWriter/PostProcessor.h"
 #include <yateto.h>
 
 #include <Kernels/common.hpp>
 #include <generated_code/tensor.h>
 #include <unordered_set>
+#include <utils/env.h>
 
 #ifdef _OPENMP
 #include <omp.h>
 #endif
 
-#ifdef ACL_DEVICE
 #include "BatchRecorders/Recorders.h"
-#endif //ACL_DEVICE
 
 void seissol::initializers::MemoryManager::initialize()
 {
@@ -288,6 +288,84 @@ void seissol::initializers::MemoryManager::initializeCommunicationStructure() {
       l_offset += m_meshStructure[tc].numberOfCopyRegionCells[l_region];
     }
   }
+
+  /*
+   * message buffers
+   */
+  for (unsigned tc = 0; tc < m_ltsTree.numChildren(); ++tc) {
+#ifdef USE_SINGLE_PRECISION_COMMUNICATION
+    // the time clusters convert the regions from and to these buffers before sending and after receiving
+    size_t l_ghostSize = 0;
+    size_t l_copySize = 0;
+    for( unsigned int l_region = 0; l_region < m_meshStructure[tc].numberOfRegions; l_region++ ) {
+      l_ghostSize += m_meshStructure[tc].ghostRegionSizes[l_region];
+      l_copySize  += m_meshStructure[tc].copyRegionSizes[l_region];
+    }
+    comm_real* ghostMessages = static_cast<comm_real*>(m_memoryAllocator.allocateMemory( l_ghostSize * sizeof(comm_real), ALIGNMENT ));
+    comm_real* copyMessages  = static_cast<comm_real*>(m_memoryAllocator.allocateMemory( l_copySize  * sizeof(comm_real), ALIGNMENT ));
+    for( unsigned int l_region = 0; l_region < m_meshStructure[tc].numberOfRegions; l_region++ ) {
+      m_meshStructure[tc].ghostRegionMessages[l_region] = ghostMessages;
+      m_meshStructure[tc].copyRegionMessages[l_region]  = copyMessages;
+      ghostMessages += m_meshStructure[tc].ghostRegionSizes[l_region];
+      copyMessages  += m_meshStructure[tc].copyRegionSizes[l_region];
+    }
+#else
+    for( unsigned int l_region = 0; l_region < m_meshStructure[tc].numberOfRegions; l_region++ ) {
+      m_meshStructure[tc].ghostRegionMessages[l_region] = m_meshStructure[tc].ghostRegions[l_region];
+      m_meshStructure[tc].copyRegionMessages[l_region]  = m_meshStructure[tc].copyRegions[l_region];
+    }
+#endif
+  }
+
+  /*
+   * persistent requests, which are started by the time clusters in every time step
+   */
+  for (unsigned tc = 0; tc < m_ltsTree.numChildren(); ++tc) {
+    initializePersistentRequests(m_meshStructure[tc], seissol::MPI::mpi.comm());
+  }
+  m_persistentRequests = true;
+}
+
+void seissol::initializers::MemoryManager::freeCommunicationStructure() {
+  if (!m_persistentRequests) {
+    return;
+  }
+
+  for (unsigned tc = 0; tc < m_ltsTree.numChildren(); ++tc) {
+    freePersistentRequests(m_meshStructure[tc]);
+  }
+  m_persistentRequests = false;
+}
+
+void seissol::initializers::initializePersistentRequests(MeshStructure& meshStructure, MPI_Comm comm) {
+  for( unsigned int l_region = 0; l_region < meshStructure.numberOfRegions; l_region++ ) {
+    MPI_Recv_init( meshStructure.ghostRegionMessages[l_region],            // initial address
+                   meshStructure.ghostRegionSizes[l_region],               // number of elements in the receive buffer
+                   MPI_C_COMM_REAL,                                        // datatype of each receive buffer element
+                   meshStructure.neighboringClusters[l_region][0],         // rank of source
+                   timeData+meshStructure.receiveIdentifiers[l_region],    // message tag
+                   comm,                                                   // communicator
+                   meshStructure.receiveRequests + l_region );             // communication request
+
+    MPI_Send_init( meshStructure.copyRegionMessages[l_region],             // initial address
+                   meshStructure.copyRegionSizes[l_region],                // number of elements in the send buffer
+                   MPI_C_COMM_REAL,                                        // datatype of each send buffer element
+                   meshStructure.neighboringClusters[l_region][0],         // rank of destination
+                   timeData+meshStructure.sendIdentifiers[l_region],       // message tag
+                   comm,                                                   // communicator
+                   meshStructure.sendRequests + l_region );                // communication request
+  }
+}
+
+void seissol::initializers::freePersistentRequests(MeshStructure& meshStructure) {
+  for( unsigned int l_region = 0; l_region < meshStructure.numberOfRegions; l_region++ ) {
+    if (meshStructure.sendRequests[l_region] != MPI_REQUEST_NULL) {
+      MPI_Request_free( meshStructure.sendRequests + l_region );
+    }
+    if (meshStructure.receiveRequests[l_region] != MPI_REQUEST_NULL) {
+      MPI_Request_free( meshStructure.receiveRequests + l_region );
+    }
+  }
 }
 #endif
 
@@ -417,6 +495,16 @@ void seissol::initializers::MemoryManager::touchBuffersDerivatives( Layer& layer
   }
 }
 
+void seissol::initializers::MemoryManager::addLtsVariables( LTSTree&                      tree,
+                                                            LTS&                          lts,
+                                                            seissol::writer::PostProcessor& postProcessor,
+                                                            PhysicsFeatures const&        features ) {
+  lts.addTo(tree, features.plasticity);
+  if (features.integrateQuantities) {
+    postProcessor.allocateMemory(&tree);
+  }
+}
+
 void seissol::initializers::MemoryManager::fixateLtsTree(struct TimeStepping& i_timeStepping,
                                                          struct MeshStructure*i_meshStructure,
                                                          unsigned* numberOfDRCopyFaces,
@@ -424,9 +512,19 @@ void seissol::initializers::MemoryManager::fixateLtsTree(struct TimeStepping& i_
   // store mesh structure and the number of time clusters
   m_meshStructure = i_meshStructure;
 
+  std::string placement = utils::Env::get<std::string>("SEISSOL_MEMORY_PLACEMENT", "default");
+  if (placement == "compute") {
+    m_placement = seissol::memory::ComputePlacement;
+  } else if (placement == "interleave-copy") {
+    m_placement = seissol::memory::InterleavedCopyPlacement;
+  } else if (placement != "default") {
+    logError() << "Unknown memory placement" << placement << "(SEISSOL_MEMORY_PLACEMENT has to be default, compute or interleave-copy).";
+  }
+  m_ltsTree.setPlacement(m_placement);
+  m_dynRupTree.setPlacement(m_placement);
+
   // Setup tree variables
-  m_lts.addTo(m_ltsTree);
-  seissol::SeisSol::main.postProcessor().allocateMemory(&m_ltsTree);
+  addLtsVariables(m_ltsTree, m_lts, seissol::SeisSol::main.postProcessor(), seissol::SeisSol::main.physicsFeatures());
   m_ltsTree.setNumberOfTimeClusters(i_timeStepping.numberOfLocalClusters);
 
   /// From this point, the tree layout, variables, and buckets cannot be changed anymore
@@ -562,9 +660,10 @@ void seissol::initializers::MemoryManager::deriveDisplacementsBucket()
   }
 }
 
-#ifdef ACL_DEVICE
 void seissol::initializers::MemoryManager::deriveRequiredScratchpadMemory() {
+#ifdef ACL_DEVICE
   constexpr size_t totalDerivativesSize = yateto::computeFamilySize<tensor::dQ>();
+#endif
   kernels::NeighborData::Loader loader;
 
   for (auto layer = m_ltsTree.beginLeaf(Ghost); layer != m_ltsTree.endLeaf(); ++layer) {
@@ -608,11 +707,12 @@ void seissol::initializers::MemoryManager::deriveRequiredScratchpadMemory() {
     }
     layer->setScratchpadSize(m_lts.idofsScratch,
                              idofsCounter * tensor::I::size() * sizeof(real));
+#ifdef ACL_DEVICE
     layer->setScratchpadSize(m_lts.derivativesScratch,
                              derivativesCounter * totalDerivativesSize * sizeof(real));
+#endif
   }
 }
-#endif
 
 void seissol::initializers::MemoryManager::initializeDisplacements()
 {
@@ -676,6 +776,7 @@ void seissol::initializers::MemoryManager::initializeMemoryLayout(bool enableFre
   deriveDisplacementsBucket();
 
   m_ltsTree.allocateBuckets();
+  m_ltsTree.touchBuckets();
 
   // initialize the internal state
   initializeBuffersDerivatives();
@@ -693,6 +794,11 @@ void seissol::initializers::MemoryManager::initializeMemoryLayout(bool enableFre
     touchBuffersDerivatives(*it);
   }
 
+  if (m_placement != seissol::memory::DefaultPlacement) {
+    m_ltsTree.printNumaDomains("LTS tree");
+    m_dynRupTree.printNumaDomains("dynamic rupture tree");
+  }
+
 #ifdef USE_MPI
   // initialize the communication structure
   initializeCommunicationStructure();
@@ -736,10 +842,20 @@ void seissol::initializers::MemoryManager::recordExecutionPaths() {
   recorder.addRecorder(new recording::LocalIntegrationRecorder);
   recorder.addRecorder(new recording::NeighIntegrationRecorder);
 
-#ifdef USE_PLASTICITY
-  recorder.addRecorder(new recording::PlasticityRecorder);
-#endif
+  if (seissol::SeisSol::main.physicsFeatures().plasticity) {
+    recorder.addRecorder(new recording::PlasticityRecorder);
+  }
+
+  for (LTSTree::leaf_iterator it = m_ltsTree.beginLeaf(Ghost); it != m_ltsTree.endLeaf(); ++it) {
+    recorder.record(m_lts, *it);
+  }
+}
+#else // ACL_DEVICE
+void seissol::initializers::MemoryManager::recordNeighborIntegration() {
+  deriveRequiredScratchpadMemory();
+  m_ltsTree.allocateScratchPads();
 
+  recording::NeighIntegrationRecorder recorder;
   for (LTSTree::leaf_iterator it = m_ltsTree.beginLeaf(Ghost); it != m_ltsTree.endLeaf(); ++it) {
     recorder.record(m_lts, *it);
   }
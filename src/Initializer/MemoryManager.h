@@ -85,11 +85,15 @@
 #include <Initializer/DynamicRupture.h>
 #include <Initializer/Boundary.h>
 #include <Initializer/ParameterDB.h>
+#include <Initializer/PhysicsFeatures.h>
 
 namespace seissol {
   namespace initializers {
     class MemoryManager;
   }
+  namespace writer {
+    class PostProcessor;
+  }
 }
 
 /**
@@ -163,6 +167,14 @@ class seissol::initializers::MemoryManager {
 
     EasiBoundary m_easiBoundary;
 
+    //! Page placement of the LTS and dynamic rupture trees (SEISSOL_MEMORY_PLACEMENT)
+    seissol::memory::Placement m_placement = seissol::memory::DefaultPlacement;
+
+#ifdef USE_MPI
+    //! true if the persistent requests of the communication structure exist
+    bool m_persistentRequests = false;
+#endif
+
     /**
      * Corrects the LTS Setups (buffer or derivatives, never both) in the ghost region
      **/
@@ -189,12 +201,10 @@ class seissol::initializers::MemoryManager {
      */
     void deriveDisplacementsBucket();
 
-#ifdef ACL_DEVICE
     /**
      * Derives the sizes of scratch memory required during the computations
      */
     void deriveRequiredScratchpadMemory();
-#endif
     
     /**
      * Initializes the displacement accumulation buffer.
@@ -213,6 +223,11 @@ class seissol::initializers::MemoryManager {
      * Initializes the communication structure.
      **/
     void initializeCommunicationStructure();
+
+    /**
+     * Frees the persistent requests of the communication structure.
+     **/
+    void freeCommunicationStructure();
 #endif
 
   public:
@@ -222,15 +237,33 @@ class seissol::initializers::MemoryManager {
     MemoryManager() {}
 
     /**
-     * Destructor, memory is freed by managed allocator
+     * Destructor, memory is freed by managed allocator, persistent MPI requests are freed explicitly
      **/
-    ~MemoryManager() {}
+    ~MemoryManager() {
+#ifdef USE_MPI
+      freeCommunicationStructure();
+#endif
+    }
     
     /**
      * Initialization function, which allocates memory for the global matrices and initializes them.
      **/
     void initialize();
     
+    /**
+     * Registers the variables of the lts tree. The plasticity data, the plastic strain and the
+     * integrals of the post processor only get storage if the corresponding feature is enabled.
+     *
+     * @param tree lts tree.
+     * @param lts variable handles of the lts tree.
+     * @param postProcessor post processor, which registers the integrals.
+     * @param features physics features of the simulation.
+     **/
+    static void addLtsVariables( LTSTree&                      tree,
+                                 LTS&                          lts,
+                                 seissol::writer::PostProcessor& postProcessor,
+                                 PhysicsFeatures const&        features );
+
     /**
      * Sets the number of cells in each leaf of the lts tree, fixates the variables, and allocates memory.
      * Afterwards the tree cannot be changed anymore.
@@ -321,6 +354,12 @@ class seissol::initializers::MemoryManager {
 
 #ifdef ACL_DEVICE
   void recordExecutionPaths();
+#else
+  /**
+   * Records the batches of the neighbor integration of all layers, which are then executed on the host
+   * instead of the cell-wise neighbor integration (see SEISSOL_NEIGHBOR_INTEGRATION).
+   **/
+  void recordNeighborIntegration();
 #endif
 };
 
@@ -329,6 +368,17 @@ namespace seissol {
     namespace initializers {
         bool isAtElasticAcousticInterface(CellMaterialData &material, unsigned int face);
         bool requiresNodalFlux(FaceType f);
+#ifdef USE_MPI
+        /**
+         * Creates the persistent receive requests of the ghost regions and send requests of the copy regions.
+         **/
+        void initializePersistentRequests(MeshStructure& meshStructure, MPI_Comm comm);
+
+        /**
+         * Frees the persistent requests of all regions, which must not be active.
+         **/
+        void freePersistentRequests(MeshStructure& meshStructure);
+#endif
     }
 }
 
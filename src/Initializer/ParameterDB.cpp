@@ -87,25 +87,27 @@ easi::Query seissol::initializers::ElementBarycentreGeneratorPUML::generate() co
 
   int const* material = m_mesh.cellData(0);
   
-  easi::Query query(cells.size(), 3);
-  for (unsigned cell = 0; cell < cells.size(); ++cell) {
+  unsigned numberOfPoints = (m_cells != nullptr) ? m_cells->size() : cells.size();
+  easi::Query query(numberOfPoints, 3);
+  for (unsigned point = 0; point < numberOfPoints; ++point) {
+    unsigned cell = (m_cells != nullptr) ? (*m_cells)[point] : point;
     unsigned vertLids[4];
     PUML::Downward::vertices(m_mesh, cells[cell], vertLids);
     
     // Compute barycentre for each element
     for (unsigned dim = 0; dim < 3; ++dim) {
-      query.x(cell,dim) = vertices[ vertLids[0] ].coordinate()[dim];
+      query.x(point,dim) = vertices[ vertLids[0] ].coordinate()[dim];
     }
     for (unsigned vertex = 1; vertex < 4; ++vertex) {
       for (unsigned dim = 0; dim < 3; ++dim) {
-        query.x(cell,dim) += vertices[ vertLids[vertex] ].coordinate()[dim];
+        query.x(point,dim) += vertices[ vertLids[vertex] ].coordinate()[dim];
       }
     }
     for (unsigned dim = 0; dim < 3; ++dim) {
-      query.x(cell,dim) *= 0.25;
+      query.x(point,dim) *= 0.25;
     }
     // Group
-    query.group(cell) = material[cell];
+    query.group(point) = material[cell];
   }
   return query;
 }
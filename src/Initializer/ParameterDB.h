@@ -96,10 +96,12 @@ private:
 #ifdef USE_HDF
 class seissol::initializers::ElementBarycentreGeneratorPUML : public seissol::initializers::QueryGenerator {
 public:
-  explicit ElementBarycentreGeneratorPUML(PUML::TETPUML const& mesh) : m_mesh(mesh) {}
+  //! Generates the barycentres of all cells or, if given, of the listed cells only
+  explicit ElementBarycentreGeneratorPUML(PUML::TETPUML const& mesh, std::vector<unsigned> const* cells = nullptr) : m_mesh(mesh), m_cells(cells) {}
   virtual easi::Query generate() const;
 private:
   PUML::TETPUML const& m_mesh;
+  std::vector<unsigned> const* m_cells;
 };
 
 #endif
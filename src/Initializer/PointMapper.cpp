@@ -69,99 +69,115 @@
  **/
 
 #include "PointMapper.h"
-#include <cstring>
-#include <Initializer/MemoryAllocator.h>
+#include <limits>
+#include <unordered_map>
 #include <utils/logger.h>
 #include <Parallel/MPI.h>
 
-void seissol::initializers::findMeshIds(Eigen::Vector3d const* points, MeshReader const& mesh, unsigned numPoints, short* contained, unsigned* meshIds)
-{
-  std::vector<Vertex> const& vertices = mesh.getVertices();
-  std::vector<Element> const& elements = mesh.getElements();
-
-  memset(contained, 0, numPoints * sizeof(short));
-
-  double (*planeEquations)[4][4] = static_cast<double(*)[4][4]>(seissol::memory::allocate(elements.size() * sizeof(double[4][4]), ALIGNMENT));
-  for (unsigned elem = 0; elem < elements.size(); ++elem) {
+namespace {
+  /** Tests the point against the four plane equations of the tetrahedron.
+   *  Points on a face are contained in both adjacent elements.
+   */
+  bool contains(Element const& element, std::vector<Vertex> const& vertices, Eigen::Vector3d const& point)
+  {
     for (int face = 0; face < 4; ++face) {
       VrtxCoords n, p;
-      MeshTools::pointOnPlane(elements[elem], face, vertices, p);
-      MeshTools::normal(elements[elem], face, vertices, n);
+      MeshTools::pointOnPlane(element, face, vertices, p);
+      MeshTools::normal(element, face, vertices, n);
 
+      double result = 0.0;
       for (unsigned i = 0; i < 3; ++i) {
-        planeEquations[elem][i][face] = n[i];
+        result += n[i] * point(i);
+      }
+      result += - MeshTools::dot(n, p);
+      if (result > 0.0) {
+        return false;
       }
-      planeEquations[elem][3][face] = - MeshTools::dot(n, p);
     }
+    return true;
   }
 
-  double (*points1)[4] = new double[numPoints][4];
-  for (unsigned point = 0; point < numPoints; ++point) {
-    points1[point][0] = points[point](0);
-    points1[point][1] = points[point](1);
-    points1[point][2] = points[point](2);
-    points1[point][3] = 1.0;
+  /** Same test as XYZInElement in the Fortran part: Transforms the point to reference
+   *  coordinates and allows them to lie outside by "tolerance".
+   */
+  bool containsWithTolerance(Element const& element, std::vector<Vertex> const& vertices, Eigen::Vector3d const& point, double tolerance)
+  {
+    Eigen::Map<Eigen::Vector3d const> x0(vertices[element.vertices[0]].coords);
+    Eigen::Matrix3d jacobian;
+    for (int i = 0; i < 3; ++i) {
+      jacobian.col(i) = Eigen::Map<Eigen::Vector3d const>(vertices[element.vertices[i+1]].coords) - x0;
+    }
+    Eigen::Vector3d xi = jacobian.inverse() * (point - x0);
+
+    return xi(0) >= -tolerance && xi(1) >= -tolerance && xi(2) >= -tolerance
+      && xi(2) <= 1.0 - xi(0) - xi(1) + tolerance;
   }
+}
+
+void seissol::initializers::findMeshIds(Eigen::Vector3d const* points, MeshReader const& mesh, unsigned numPoints, short* contained, unsigned* meshIds)
+{
+  ElementIndex index(mesh);
+  findMeshIds(points, mesh, index, numPoints, contained, meshIds);
+}
+
+void seissol::initializers::findMeshIds(Eigen::Vector3d const* points, MeshReader const& mesh, ElementIndex const& index, unsigned numPoints, short* contained, unsigned* meshIds)
+{
+  std::vector<Vertex> const& vertices = mesh.getVertices();
+  std::vector<Element> const& elements = mesh.getElements();
 
-/// @TODO Could use the code generator for the following
 #ifdef _OPENMP
-    #pragma omp parallel for schedule(static)
+  #pragma omp parallel for schedule(dynamic, 64)
 #endif
-  for (unsigned elem = 0; elem < elements.size(); ++elem) {
-#if 0 //defined(__AVX__)
-      __m256d zero = _mm256_setzero_pd();
-      __m256d planeDims[4];
-      for (unsigned i = 0; i < 4; ++i) {
-        planeDims[i] = _mm256_load_pd(&planeEquations[elem][i][0]);
-      }
-#endif
-    for (unsigned point = 0; point < numPoints; ++point) {
-      int l_notInside = 0;
-#if 0 //defined(__AVX__)
-      // Not working because <0 => 0 should actually be  <=0 => 0
-      /*__m256d result = _mm256_setzero_pd();
-      for (unsigned dim = 0; dim < 4; ++dim) {
-        result = _mm256_add_pd(result, _mm256_mul_pd(planeDims[dim], _mm256_broadcast_sd(&points1[point][dim])) );
-      }
-      // >0 => (2^64)-1 ; <0 = 0
-      __m256d inside4 = _mm256_cmp_pd(result, zero, _CMP_GE_OQ);
-      l_notInside = _mm256_movemask_pd(inside4);*/
-#else
-      double result[4] = { 0.0, 0.0, 0.0, 0.0 };
-      for (unsigned dim = 0; dim < 4; ++dim) {
-        for (unsigned face = 0; face < 4; ++face) {
-          result[face] += planeEquations[elem][dim][face] * points1[point][dim];
-        }
-      }
-      for (unsigned face = 0; face < 4; ++face) {
-        l_notInside += (result[face] > 0.0) ? 1 : 0;
+  for (unsigned point = 0; point < numPoints; ++point) {
+    /* It might actually happen that a point is found in two tetrahedrons
+     * if it lies on the boundary. In this case we arbitrarily assign
+     * it to the one with the lower meshId.
+     * @todo Check if this is a problem with the numerical scheme. */
+    unsigned meshId = std::numeric_limits<unsigned>::max();
+    index.forEachCandidate(points[point].data(), [&](unsigned elem) {
+      if (elem < meshId && contains(elements[elem], vertices, points[point])) {
+        meshId = elem;
       }
-#endif
-      if (l_notInside == 0) {
-#ifdef _OPENMP
-        #pragma omp critical
-        {
-#endif
-          /* It might actually happen that a point is found in two tetrahedrons
-           * if it lies on the boundary. In this case we arbitrarily assign
-           * it to the one with the higher meshId.
-           * @todo Check if this is a problem with the numerical scheme. */
-          /*if (contained[point] != 0) {
-             logError() << "point with id " << point << " was already found in a different element!";
-          }*/
-          if (contained[point] == 0 || meshIds[point] > elem) {
-            contained[point] = 1;
-            meshIds[point] = elem;
-          }
+    });
+
+    contained[point] = (meshId != std::numeric_limits<unsigned>::max()) ? 1 : 0;
+    if (contained[point] != 0) {
+      meshIds[point] = meshId;
+    }
+  }
+}
+
+void seissol::initializers::findFaultIds(Eigen::Vector3d const* points, MeshReader const& mesh, unsigned numPoints, double tolerance, int* faultIds)
+{
+  std::vector<Vertex> const& vertices = mesh.getVertices();
+  std::vector<Element> const& elements = mesh.getElements();
+  std::vector<Fault> const& fault = mesh.getFault();
+
+  // First fault face of each "+" element
+  std::unordered_map<unsigned, int> firstFault;
+  std::vector<unsigned> plusElements;
+  for (unsigned i = 0; i < fault.size(); ++i) {
+    if (fault[i].element >= 0 && firstFault.emplace(fault[i].element, i).second) {
+      plusElements.push_back(fault[i].element);
+    }
+  }
+
+  ElementIndex index(mesh, plusElements);
+
 #ifdef _OPENMP
-        }
+  #pragma omp parallel for schedule(dynamic, 64)
 #endif
+  for (unsigned point = 0; point < numPoints; ++point) {
+    int faultId = std::numeric_limits<int>::max();
+    index.forEachCandidate(points[point].data(), [&](unsigned elem) {
+      int candidate = firstFault.find(elem)->second;
+      if (candidate < faultId && containsWithTolerance(elements[elem], vertices, points[point], tolerance)) {
+        faultId = candidate;
       }
-    }
-  }
+    }, tolerance);
 
-  seissol::memory::free(planeEquations);
-  delete[] points1;
+    faultIds[point] = (faultId != std::numeric_limits<int>::max()) ? faultId : -1;
+  }
 }
 
 #ifdef USE_MPI
@@ -170,26 +186,90 @@ void seissol::initializers::cleanDoubles(short* contained, unsigned numPoints)
   int myrank = seissol::MPI::mpi.rank();
   int size = seissol::MPI::mpi.size();
 
-  short* globalContained = new short[size * numPoints];
-  MPI_Allgather(contained, numPoints, MPI_SHORT, globalContained, numPoints, MPI_SHORT, seissol::MPI::mpi.comm());
+  // The lowest rank that contains the point keeps it
+  std::vector<int> owner(numPoints);
+  for (unsigned point = 0; point < numPoints; ++point) {
+    owner[point] = (contained[point] == 1) ? myrank : size;
+  }
+  MPI_Allreduce(MPI_IN_PLACE, owner.data(), numPoints, MPI_INT, MPI_MIN, seissol::MPI::mpi.comm());
 
   unsigned cleaned = 0;
   for (unsigned point = 0; point < numPoints; ++point) {
-    if (contained[point] == 1) {
-      for (int rank = 0; rank < myrank; ++rank) {
-        if (globalContained[rank * numPoints + point] == 1) {
-          contained[point] = 0;
-          ++cleaned;
-          break;
-        }
-      }
+    if (contained[point] == 1 && owner[point] != myrank) {
+      contained[point] = 0;
+      ++cleaned;
     }
   }
 
   if (cleaned > 0) {
     logInfo(myrank) << "Cleaned " << cleaned << " double occurring points on rank " << myrank << ".";
   }
+}
+
+void seissol::initializers::cleanDoubles(short* contained, unsigned long const* pointIds, unsigned numPoints)
+{
+  int myrank = seissol::MPI::mpi.rank();
+  int size = seissol::MPI::mpi.size();
+  MPI_Comm comm = seissol::MPI::mpi.comm();
+
+  // The owner of each contained point is decided by the rank pointId % size
+  std::vector<int> sendCounts(size, 0);
+  for (unsigned point = 0; point < numPoints; ++point) {
+    if (contained[point] == 1) {
+      ++sendCounts[pointIds[point] % size];
+    }
+  }
+  std::vector<int> recvCounts(size);
+  MPI_Alltoall(sendCounts.data(), 1, MPI_INT, recvCounts.data(), 1, MPI_INT, comm);
+
+  std::vector<int> sendDispls(size), recvDispls(size);
+  int numRequests = 0, numReceived = 0;
+  for (int r = 0; r < size; ++r) {
+    sendDispls[r] = numRequests;
+    recvDispls[r] = numReceived;
+    numRequests += sendCounts[r];
+    numReceived += recvCounts[r];
+  }
+
+  std::vector<unsigned long> requests(numRequests);
+  std::vector<unsigned> requestedPoints(numRequests);
+  std::vector<int> offsets(sendDispls);
+  for (unsigned point = 0; point < numPoints; ++point) {
+    if (contained[point] == 1) {
+      int position = offsets[pointIds[point] % size]++;
+      requests[position] = pointIds[point];
+      requestedPoints[position] = point;
+    }
+  }
+  std::vector<unsigned long> received(numReceived);
+  MPI_Alltoallv(requests.data(), sendCounts.data(), sendDispls.data(), MPI_UNSIGNED_LONG,
+                received.data(), recvCounts.data(), recvDispls.data(), MPI_UNSIGNED_LONG, comm);
 
-  delete[] globalContained;
+  // The lowest rank that contains the point keeps it
+  std::unordered_map<unsigned long, int> owners;
+  for (int r = 0; r < size; ++r) {
+    for (int i = recvDispls[r]; i < recvDispls[r] + recvCounts[r]; ++i) {
+      owners.emplace(received[i], r);
+    }
+  }
+  std::vector<int> replies(numReceived);
+  for (int i = 0; i < numReceived; ++i) {
+    replies[i] = owners[received[i]];
+  }
+  std::vector<int> owner(numRequests);
+  MPI_Alltoallv(replies.data(), recvCounts.data(), recvDispls.data(), MPI_INT,
+                owner.data(), sendCounts.data(), sendDispls.data(), MPI_INT, comm);
+
+  unsigned cleaned = 0;
+  for (int i = 0; i < numRequests; ++i) {
+    if (owner[i] != myrank) {
+      contained[requestedPoints[i]] = 0;
+      ++cleaned;
+    }
+  }
+
+  if (cleaned > 0) {
+    logInfo(myrank) << "Cleaned " << cleaned << " double occurring points on rank " << myrank << ".";
+  }
 }
 #endif
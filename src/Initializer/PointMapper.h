@@ -41,6 +41,7 @@
 #define INITIALIZER_POINTMAPPER_H_
 
 #include <Geometry/MeshReader.h>
+#include <Geometry/ElementIndex.h>
 #include <Eigen/Dense>
 
 namespace seissol {
@@ -54,8 +55,34 @@ namespace seissol {
                       unsigned          numPoints,
                       short*            contained,
                       unsigned*         meshId );
+
+    /** Same as above but reuses an index over the elements of the mesh.
+     *  If a point lies in several elements, the smallest meshId is chosen.
+     */
+    void findMeshIds( Eigen::Vector3d const*  points,
+                      MeshReader const& mesh,
+                      ElementIndex const& index,
+                      unsigned          numPoints,
+                      short*            contained,
+                      unsigned*         meshId );
+
+    /** Finds the first fault face whose "+" element contains the point.
+     *  Points may lie outside of the element by "tolerance" in reference coordinates.
+     *  faultIds is set to -1 for points that are not found.
+     */
+    void findFaultIds( Eigen::Vector3d const*  points,
+                       MeshReader const& mesh,
+                       unsigned          numPoints,
+                       double            tolerance,
+                       int*              faultIds );
 #ifdef USE_MPI
+    /** Keeps each point only on the lowest rank that contains it. */
     void cleanDoubles(short* contained, unsigned numPoints);
+
+    /** Same as above for points which are only known to some ranks.
+     *  The points are identified across ranks by their pointIds.
+     */
+    void cleanDoubles(short* contained, unsigned long const* pointIds, unsigned numPoints);
 #endif
   }
 }
@@ -882,32 +882,28 @@ CONTAINS
         IF(EQN%Plasticity .EQ. 1) THEN !high-order points approach
         !elementwise assignement of the initial loading
            l_initialLoading(1,1:6) = EQN%IniStress(1:6,iElem)
-        ENDIF
 
-#ifdef USE_PLASTICITY
-        ! initialize the element dependent plastic parameters
-        l_plasticParameters(1) = EQN%PlastCo(iElem) !element-dependent plastic cohesion
-        l_plasticParameters(2) = EQN%BulkFriction(iElem) !element-dependent bulk friction
-        
-        ! initialize loading in C
-        oneRankedShaped_iniloading = pack( l_initialLoading, .true. ) 
-        call c_interoperability_setInitialLoading( i_meshId = iElem, \
-                                                   i_initialLoading = oneRankedShaped_iniloading)
-
-        !initialize parameters in C
-        call c_interoperability_setPlasticParameters( i_meshId            = iElem, \
-                                                      i_plasticParameters = l_plasticParameters )
-#endif
+           ! initialize the element dependent plastic parameters
+           l_plasticParameters(1) = EQN%PlastCo(iElem) !element-dependent plastic cohesion
+           l_plasticParameters(2) = EQN%BulkFriction(iElem) !element-dependent bulk friction
+           
+           ! initialize loading in C
+           oneRankedShaped_iniloading = pack( l_initialLoading, .true. ) 
+           call c_interoperability_setInitialLoading( i_meshId = iElem, \
+                                                      i_initialLoading = oneRankedShaped_iniloading)
+
+           !initialize parameters in C
+           call c_interoperability_setPlasticParameters( i_meshId            = iElem, \
+                                                         i_plasticParameters = l_plasticParameters )
+        ENDIF
     ENDDO ! iElem
 
-#ifdef USE_PLASTICITY
-    call c_interoperability_setTv( tv = EQN%Tv )
-#endif
+    IF(EQN%Plasticity .EQ. 1) THEN
+       call c_interoperability_setTv( tv = EQN%Tv )
 
-#ifdef USE_PLASTICITY
-    ! TODO: redundant (see iniGalerkin3D_us_level2_new) call to ensure correct intitial loading in copy layers.
-    call c_interoperability_synchronizeCellLocalData();
-#endif
+       ! TODO: redundant (see iniGalerkin3D_us_level2_new) call to ensure correct intitial loading in copy layers.
+       call c_interoperability_synchronizeCellLocalData();
+    ENDIF
     !
     logInfo0(*) 'DG initial condition projection done. '
     !
@@ -196,7 +196,12 @@ CONTAINS
                                                      i_checkPointBackend = trim(io%checkpoint%backend) // c_null_char )
     endif
 
-#ifdef INTEGRATE_QUANTITIES
+    ! Set the physics which change the LTS weights and the memory layout
+    ! This has to be done before the mesh is read!
+    if( EQN%Plasticity .eq. 1 ) then
+        call c_interoperability_enablePlasticity()
+    endif
+
 	do i = 1,9
 		if ( io%IntegrationMask(i) ) then
 			IntegrationMask(i) = 1
@@ -206,7 +211,6 @@ CONTAINS
 	end do
 
 	call c_interoperability_getIntegrationMask( i_integrationMask = IntegrationMask(1:9) )
-#endif
 
     ! Start mesh reading/computing section
     EPIK_USER_START(r_read_compute_mesh)
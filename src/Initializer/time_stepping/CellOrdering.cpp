@@ -0,0 +1,218 @@
+/**
+ * @file
+ * This file is part of SeisSol.
+ *
+ * @section LICENSE
+ * Copyright (c) 2020, SeisSol Group
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @section DESCRIPTION
+ * Orderings of the cells within a layer, which improve the locality of neighbouring cells.
+ **/
+
+#include "CellOrdering.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <string>
+
+#include <utils/env.h>
+#include <utils/logger.h>
+
+seissol::initializers::time_stepping::CellOrdering::Strategy seissol::initializers::time_stepping::CellOrdering::fromEnvironment() {
+  std::string ordering = utils::Env::get<std::string>("SEISSOL_CELL_ORDERING", "mesh");
+  if (ordering == "hilbert") {
+    return Strategy::Hilbert;
+  } else if (ordering == "rcm") {
+    return Strategy::ReverseCuthillMcKee;
+  } else if (ordering != "mesh") {
+    logError() << "Unknown cell ordering" << ordering << "(SEISSOL_CELL_ORDERING has to be mesh, hilbert or rcm).";
+  }
+  return Strategy::Mesh;
+}
+
+char const* seissol::initializers::time_stepping::CellOrdering::name( Strategy strategy ) {
+  switch (strategy) {
+    case Strategy::Hilbert:
+      return "hilbert";
+    case Strategy::ReverseCuthillMcKee:
+      return "rcm";
+    default:
+      return "mesh";
+  }
+}
+
+std::uint64_t seissol::initializers::time_stepping::CellOrdering::hilbertIndex( std::array<std::uint32_t, 3> coordinates,
+                                                                                 unsigned                     bits ) {
+  // J. Skilling, Programming the Hilbert curve, AIP Conference Proceedings 707 (2004)
+  std::uint32_t const highestBit = 1u << (bits - 1);
+
+  // inverse undo excess work
+  for (std::uint32_t q = highestBit; q > 1; q >>= 1) {
+    std::uint32_t const p = q - 1;
+    for (unsigned d = 0; d < 3; ++d) {
+      if (coordinates[d] & q) {
+        coordinates[0] ^= p;
+      } else {
+        std::uint32_t const t = (coordinates[0] ^ coordinates[d]) & p;
+        coordinates[0] ^= t;
+        coordinates[d] ^= t;
+      }
+    }
+  }
+
+  // gray encode
+  for (unsigned d = 1; d < 3; ++d) {
+    coordinates[d] ^= coordinates[d-1];
+  }
+  std::uint32_t t = 0;
+  for (std::uint32_t q = highestBit; q > 1; q >>= 1) {
+    if (coordinates[2] & q) {
+      t ^= q - 1;
+    }
+  }
+  for (unsigned d = 0; d < 3; ++d) {
+    coordinates[d] ^= t;
+  }
+
+  // interleave the transposed index
+  std::uint64_t index = 0;
+  for (int bit = bits - 1; bit >= 0; --bit) {
+    for (unsigned d = 0; d < 3; ++d) {
+      index = (index << 1) | ((coordinates[d] >> bit) & 1u);
+    }
+  }
+  return index;
+}
+
+std::vector<unsigned> seissol::initializers::time_stepping::CellOrdering::hilbert( std::vector<std::array<double, 3>> const& points ) {
+  constexpr unsigned bits = 21;
+
+  std::array<double, 3> minimum, maximum;
+  minimum.fill(std::numeric_limits<double>::max());
+  maximum.fill(std::numeric_limits<double>::lowest());
+  for (auto const& point : points) {
+    for (unsigned d = 0; d < 3; ++d) {
+      minimum[d] = std::min(minimum[d], point[d]);
+      maximum[d] = std::max(maximum[d], point[d]);
+    }
+  }
+
+  // the same scaling in all dimensions preserves the shape of the curve's cells
+  double extent = 0.0;
+  for (unsigned d = 0; d < 3; ++d) {
+    extent = std::max(extent, maximum[d] - minimum[d]);
+  }
+  double const scale = (extent > 0.0) ? ((1u << bits) - 1) / extent : 0.0;
+
+  std::vector<std::uint64_t> indices(points.size());
+  for (unsigned i = 0; i < points.size(); ++i) {
+    std::array<std::uint32_t, 3> coordinates;
+    for (unsigned d = 0; d < 3; ++d) {
+      coordinates[d] = static_cast<std::uint32_t>(std::floor((points[i][d] - minimum[d]) * scale));
+    }
+    indices[i] = hilbertIndex(coordinates, bits);
+  }
+
+  std::vector<unsigned> order(points.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&](unsigned a, unsigned b) { return indices[a] < indices[b]; });
+  return order;
+}
+
+std::vector<unsigned> seissol::initializers::time_stepping::CellOrdering::reverseCuthillMcKee( std::vector<std::array<int, 4>> const& neighbors ) {
+  unsigned const numberOfCells = neighbors.size();
+
+  std::vector<unsigned> degrees(numberOfCells, 0);
+  for (unsigned cell = 0; cell < numberOfCells; ++cell) {
+    for (int neighbor : neighbors[cell]) {
+      if (neighbor >= 0) {
+        ++degrees[cell];
+      }
+    }
+  }
+
+  // start every component at a cell with the minimum degree
+  std::vector<unsigned> starts(numberOfCells);
+  std::iota(starts.begin(), starts.end(), 0);
+  std::stable_sort(starts.begin(), starts.end(), [&](unsigned a, unsigned b) { return degrees[a] < degrees[b]; });
+
+  std::vector<unsigned> order;
+  order.reserve(numberOfCells);
+  std::vector<bool> visited(numberOfCells, false);
+  for (unsigned start : starts) {
+    if (visited[start]) {
+      continue;
+    }
+    visited[start] = true;
+    order.push_back(start);
+
+    // breadth-first search, which visits the neighbours of a cell by increasing degree
+    for (unsigned next = order.size() - 1; next < order.size(); ++next) {
+      std::array<int, 4> cellNeighbors = neighbors[order[next]];
+      std::sort(cellNeighbors.begin(), cellNeighbors.end(), [&](int a, int b) {
+        if (a < 0 || b < 0) {
+          return b < 0 && a >= 0;
+        }
+        return degrees[a] < degrees[b];
+      });
+      for (int neighbor : cellNeighbors) {
+        if (neighbor >= 0 && !visited[neighbor]) {
+          visited[neighbor] = true;
+          order.push_back(neighbor);
+        }
+      }
+    }
+  }
+
+  std::reverse(order.begin(), order.end());
+  return order;
+}
+
+double seissol::initializers::time_stepping::CellOrdering::meanNeighborDistance( std::vector<std::array<int, 4>> const& neighbors,
+                                                                                  std::vector<unsigned> const&           order ) {
+  std::vector<unsigned> positions(order.size());
+  for (unsigned i = 0; i < order.size(); ++i) {
+    positions[order[i]] = i;
+  }
+
+  double distance = 0.0;
+  unsigned numberOfPairs = 0;
+  for (unsigned cell = 0; cell < neighbors.size(); ++cell) {
+    for (int neighbor : neighbors[cell]) {
+      if (neighbor >= 0) {
+        distance += std::abs(static_cast<double>(positions[cell]) - positions[neighbor]);
+        ++numberOfPairs;
+      }
+    }
+  }
+  return (numberOfPairs > 0) ? distance / numberOfPairs : 0.0;
+}
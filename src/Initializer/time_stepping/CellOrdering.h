@@ -0,0 +1,105 @@
+/**
+ * @file
+ * This file is part of SeisSol.
+ *
+ * @section LICENSE
+ * Copyright (c) 2020, SeisSol Group
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @section DESCRIPTION
+ * Orderings of the cells within a layer, which improve the locality of neighbouring cells.
+ **/
+
+#ifndef INITIALIZER_TIMESTEPPING_CELLORDERING_H_
+#define INITIALIZER_TIMESTEPPING_CELLORDERING_H_
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace seissol {
+  namespace initializers {
+    namespace time_stepping {
+      class CellOrdering;
+    }
+  }
+}
+
+/**
+ * Orders the cells of a layer, such that the buffers and derivatives of the face neighbours of a cell are likely
+ * stored close to the cell itself.
+ *
+ * All orderings return a permutation: the i-th cell of the new order is the cell order[i] of the input.
+ **/
+class seissol::initializers::time_stepping::CellOrdering {
+public:
+  enum class Strategy {
+    //! order of the mesh reader
+    Mesh,
+    //! Hilbert curve over the barycentres
+    Hilbert,
+    //! reverse Cuthill-McKee over the face graph
+    ReverseCuthillMcKee
+  };
+
+  //! Reads the strategy from SEISSOL_CELL_ORDERING (mesh, hilbert or rcm)
+  static Strategy fromEnvironment();
+
+  static char const* name( Strategy strategy );
+
+  /**
+   * Returns the index of a point on the 3D Hilbert curve.
+   *
+   * @param coordinates integer coordinates, each < 2^bits.
+   * @param bits number of bits per coordinate, at most 21.
+   **/
+  static std::uint64_t hilbertIndex( std::array<std::uint32_t, 3> coordinates,
+                                     unsigned                     bits );
+
+  /**
+   * Sorts the points along a Hilbert curve through their bounding box.
+   **/
+  static std::vector<unsigned> hilbert( std::vector<std::array<double, 3>> const& points );
+
+  /**
+   * Reverse Cuthill-McKee ordering, which minimizes the distance of neighbours in the new order.
+   * Every connected component starts at a cell with the minimum number of neighbours.
+   *
+   * @param neighbors face neighbours of every cell, -1 for faces without a neighbour in the layer.
+   **/
+  static std::vector<unsigned> reverseCuthillMcKee( std::vector<std::array<int, 4>> const& neighbors );
+
+  /**
+   * Mean distance of the face neighbours in the given order, which measures the locality of an ordering.
+   **/
+  static double meanNeighborDistance( std::vector<std::array<int, 4>> const& neighbors,
+                                      std::vector<unsigned> const&           order );
+};
+
+#endif
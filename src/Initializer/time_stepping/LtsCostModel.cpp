@@ -0,0 +1,113 @@
+/**
+ * @file
+ * This file is part of SeisSol.
+ *
+ * @section LICENSE
+ * Copyright (c) 2020, SeisSol Group
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @section DESCRIPTION
+ * Cost model for the local time stepping clustering.
+ **/
+
+#include "LtsCostModel.h"
+
+#include <algorithm>
+#include <limits>
+
+#include <SeisSol.h>
+
+#include <utils/env.h>
+#include <utils/logger.h>
+
+seissol::initializers::time_stepping::LtsCostModel seissol::initializers::time_stepping::LtsCostModel::fromEnvironment() {
+  double elementCost = utils::Env::get<double>("SEISSOL_LTS_ELEMENT_COST", 5.0e-7);
+  double clusterOverhead = utils::Env::get<double>("SEISSOL_LTS_CLUSTER_OVERHEAD", 5.0e-5);
+  double dynamicRuptureCost = utils::Env::get<double>("SEISSOL_LTS_DR_COST", 1.0);
+  double plasticityCost = 0.0;
+  if (seissol::SeisSol::main.physicsFeatures().plasticity) {
+    plasticityCost = utils::Env::get<double>("SEISSOL_LTS_PLASTICITY_COST", 0.0);
+  }
+  double gravityCost = utils::Env::get<double>("SEISSOL_LTS_GRAVITY_COST", 1.0);
+  if (elementCost <= 0.0 || clusterOverhead < 0.0) {
+    logError() << "Invalid LTS cost model: element cost" << elementCost << "and cluster overhead" << clusterOverhead;
+  }
+  if (dynamicRuptureCost < 0.0 || plasticityCost < 0.0 || gravityCost < 0.0) {
+    logError() << "Invalid LTS cost model: the relative costs of dynamic rupture (" << utils::nospace << dynamicRuptureCost
+               << "), plasticity (" << plasticityCost << ") and gravity (" << gravityCost << ") must not be negative.";
+  }
+  return LtsCostModel(elementCost, clusterOverhead, dynamicRuptureCost, plasticityCost, gravityCost);
+}
+
+double seissol::initializers::time_stepping::LtsCostModel::predict( std::vector<double> const& clusterWeights,
+                                                                     double                     minimumTimeStepWidth,
+                                                                     unsigned                   rate,
+                                                                     unsigned                   numberOfRanks ) const {
+  double time = 0.0;
+  double timeStepWidth = minimumTimeStepWidth;
+  for (double weight : clusterWeights) {
+    // empty clusters are not updated
+    if (weight > 0.0) {
+      time += (m_elementCost * weight / numberOfRanks + m_clusterOverhead) / timeStepWidth;
+    }
+    timeStepWidth *= rate;
+  }
+  return time;
+}
+
+std::vector<double> seissol::initializers::time_stepping::LtsCostModel::mergeClusters( std::vector<double> const& clusterWeights,
+                                                                                        unsigned                   maximumClusterId ) {
+  if (maximumClusterId + 1 >= clusterWeights.size()) {
+    return clusterWeights;
+  }
+  std::vector<double> merged(clusterWeights.begin(), clusterWeights.begin() + maximumClusterId + 1);
+  for (unsigned cluster = maximumClusterId + 1; cluster < clusterWeights.size(); ++cluster) {
+    merged[maximumClusterId] += clusterWeights[cluster];
+  }
+  return merged;
+}
+
+unsigned seissol::initializers::time_stepping::LtsCostModel::optimalMaximumClusterId( std::vector<double> const& clusterWeights,
+                                                                                       double                     minimumTimeStepWidth,
+                                                                                       unsigned                   rate,
+                                                                                       unsigned                   numberOfRanks,
+                                                                                       double&                    predictedTime ) const {
+  unsigned numberOfClusters = std::max<unsigned>(clusterWeights.size(), 1);
+  unsigned optimum = numberOfClusters - 1;
+  predictedTime = std::numeric_limits<double>::max();
+  // iterate downwards such that ties keep more clusters
+  for (int maximumClusterId = numberOfClusters - 1; maximumClusterId >= 0; --maximumClusterId) {
+    double time = predict(mergeClusters(clusterWeights, maximumClusterId), minimumTimeStepWidth, rate, numberOfRanks);
+    if (time < predictedTime) {
+      predictedTime = time;
+      optimum = maximumClusterId;
+    }
+  }
+  return optimum;
+}
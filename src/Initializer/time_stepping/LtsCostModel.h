@@ -0,0 +1,134 @@
+/**
+ * @file
+ * This file is part of SeisSol.
+ *
+ * @section LICENSE
+ * Copyright (c) 2020, SeisSol Group
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @section DESCRIPTION
+ * Cost model for the local time stepping clustering.
+ **/
+
+#ifndef INITIALIZER_TIMESTEPPING_LTSCOSTMODEL_H_
+#define INITIALIZER_TIMESTEPPING_LTSCOSTMODEL_H_
+
+#include <vector>
+
+namespace seissol {
+  namespace initializers {
+    namespace time_stepping {
+      class LtsCostModel;
+    }
+  }
+}
+
+/**
+ * Predicts the wall time per simulated time of a clustering.
+ *
+ * Every update of a cluster costs elementCost per (weighted) element of a rank plus the constant clusterOverhead,
+ * which covers the synchronization, the communication and the loop overhead of the update.
+ * Both coefficients correspond to the regression analysis of the loop statistics, which SeisSol prints at the end
+ * of a simulation; the default values are rough estimates for a multi-threaded rank.
+ *
+ * The weight of an element is the cost of its update relative to a plain cell update:
+ * plasticity adds to every cell, dynamic rupture and free-surface gravity faces add per face.
+ **/
+class seissol::initializers::time_stepping::LtsCostModel {
+public:
+  LtsCostModel( double elementCost,
+                double clusterOverhead,
+                double dynamicRuptureCost = 1.0,
+                double plasticityCost = 0.0,
+                double gravityCost = 1.0 )
+    : m_elementCost(elementCost),
+      m_clusterOverhead(clusterOverhead),
+      m_dynamicRuptureCost(dynamicRuptureCost),
+      m_plasticityCost(plasticityCost),
+      m_gravityCost(gravityCost) {}
+
+  /**
+   * Reads the coefficients from SEISSOL_LTS_ELEMENT_COST, SEISSOL_LTS_CLUSTER_OVERHEAD,
+   * SEISSOL_LTS_DR_COST, SEISSOL_LTS_PLASTICITY_COST and SEISSOL_LTS_GRAVITY_COST.
+   **/
+  static LtsCostModel fromEnvironment();
+
+  //! Relative cost of a cell without special faces
+  double cellCost() const { return 1.0 + m_plasticityCost; }
+
+  //! Relative cost of a cell with the given number of dynamic rupture and free-surface gravity faces
+  double elementWeight( unsigned numberOfDynamicRuptureFaces,
+                        unsigned numberOfGravityFaces ) const {
+    return cellCost() + m_dynamicRuptureCost * numberOfDynamicRuptureFaces + m_gravityCost * numberOfGravityFaces;
+  }
+
+  /**
+   * Predicts the wall time per simulated time.
+   *
+   * @param clusterWeights global sum of the element weights per cluster.
+   * @param minimumTimeStepWidth time step width of the first cluster.
+   * @param rate time step rate between neighbouring clusters.
+   * @param numberOfRanks number of ranks, among which the weights are balanced.
+   **/
+  double predict( std::vector<double> const& clusterWeights,
+                  double                     minimumTimeStepWidth,
+                  unsigned                   rate,
+                  unsigned                   numberOfRanks ) const;
+
+  /**
+   * Merges all clusters above maximumClusterId into the cluster maximumClusterId.
+   **/
+  static std::vector<double> mergeClusters( std::vector<double> const& clusterWeights,
+                                            unsigned                   maximumClusterId );
+
+  /**
+   * Returns the maximum cluster id with the lowest predicted wall time.
+   * Merging a cluster into its smaller neighbour saves the overhead of its updates,
+   * which pays off for nearly empty clusters.
+   **/
+  unsigned optimalMaximumClusterId( std::vector<double> const& clusterWeights,
+                                    double                     minimumTimeStepWidth,
+                                    unsigned                   rate,
+                                    unsigned                   numberOfRanks,
+                                    double&                    predictedTime ) const;
+
+  double elementCost() const { return m_elementCost; }
+  double clusterOverhead() const { return m_clusterOverhead; }
+  double dynamicRuptureCost() const { return m_dynamicRuptureCost; }
+  double gravityCost() const { return m_gravityCost; }
+
+private:
+  double m_elementCost;
+  double m_clusterOverhead;
+  double m_dynamicRuptureCost;
+  double m_plasticityCost;
+  double m_gravityCost;
+};
+
+#endif
@@ -45,14 +45,23 @@
 #include "utils/logger.h"
 
 #include "LtsLayout.h"
+#include "LtsCostModel.h"
 #include "MultiRate.hpp"
+#include <algorithm>
 #include <iterator>
+#include <numeric>
 
 seissol::initializers::time_stepping::LtsLayout::LtsLayout():
  m_cellTimeStepWidths(       NULL ),
+ m_cellOrdering(             CellOrdering::Strategy::Mesh ),
  m_cellClusterIds(           NULL ),
  m_globalTimeStepWidths(     NULL ),
  m_globalTimeStepRates(      NULL ),
+ m_optimizedClusterRate(     0 ),
+ m_maximumClusterId(         std::numeric_limits<unsigned int>::max() ),
+ m_predictedTimePerSimulatedTime( 0 ),
+ m_predictedCellUpdates(     0 ),
+ m_predictedDynamicRuptureUpdates( 0 ),
  m_plainCopyRegions(         NULL ),
  m_numberOfPlainGhostCells(  NULL ),
  m_plainGhostCellClusterIds( NULL ) {}
@@ -78,6 +87,14 @@ void seissol::initializers::time_stepping::LtsLayout::setMesh( const MeshReader
   m_cells = i_mesh.getElements();
   m_fault = i_mesh.getFault();
 
+  m_cellOrdering = CellOrdering::fromEnvironment();
+  if( m_cellOrdering == CellOrdering::Strategy::Hilbert ) {
+    m_cellBarycentres.resize( m_cells.size() );
+    for( unsigned int l_cell = 0; l_cell < m_cells.size(); l_cell++ ) {
+      MeshTools::center( m_cells[l_cell], i_mesh.getVertices(), m_cellBarycentres[l_cell].data() );
+    }
+  }
+
   m_cellTimeStepWidths = new double[       m_cells.size() ];
   m_cellClusterIds     = new unsigned int[ m_cells.size() ];
 
@@ -96,6 +113,13 @@ void seissol::initializers::time_stepping::LtsLayout::setTimeStepWidth( unsigned
   m_cellTimeStepWidths[i_cellId] = i_timeStepWidth;
 }
 
+void seissol::initializers::time_stepping::LtsLayout::setOptimizedClustering( unsigned int i_clusterRate,
+                                                                              unsigned int i_maximumClusterId ) {
+  assert( i_clusterRate > 0 );
+  m_optimizedClusterRate = i_clusterRate;
+  m_maximumClusterId = i_maximumClusterId;
+}
+
 FaceType seissol::initializers::time_stepping::LtsLayout::getFaceType(int i_meshFaceType) {
   if (i_meshFaceType < 0 || i_meshFaceType > 7) {
     logError() << "face type" << i_meshFaceType << "not supported.";
@@ -717,6 +741,53 @@ void seissol::initializers::time_stepping::LtsLayout::getTheoreticalSpeedup( dou
   o_clustering            = (l_globalNumberOfCells * ( m_globalTimeStepWidths[m_numberOfGlobalClusters-1] / m_globalTimeStepWidths[0] ) ) / o_clustering;
 }
 
+void seissol::initializers::time_stepping::LtsLayout::mergeClusters() {
+  if( m_maximumClusterId >= m_numberOfGlobalClusters - 1 ) {
+    return;
+  }
+
+  for( unsigned int l_cell = 0; l_cell < m_cells.size(); l_cell++ ) {
+    m_cellClusterIds[l_cell] = std::min( m_cellClusterIds[l_cell], m_maximumClusterId );
+  }
+
+  m_numberOfGlobalClusters = m_maximumClusterId + 1;
+  m_globalTimeStepRates[m_numberOfGlobalClusters-1] = 1;
+}
+
+double seissol::initializers::time_stepping::LtsLayout::predictTimePerSimulatedTime() {
+  LtsCostModel l_costModel = LtsCostModel::fromEnvironment();
+
+  // weight the cells as for the partitioning
+  std::vector<double> l_clusterWeights( m_numberOfGlobalClusters, 0.0 );
+  m_predictedCellUpdates = 0.0;
+  m_predictedDynamicRuptureUpdates = 0.0;
+  for( unsigned int l_cell = 0; l_cell < m_cells.size(); l_cell++ ) {
+    unsigned int l_dynamicRuptureFaces = 0;
+    unsigned int l_gravityFaces = 0;
+    for( unsigned int l_face = 0; l_face < 4; l_face++ ) {
+      FaceType l_faceType = getFaceType( m_cells[l_cell].boundaries[l_face] );
+      l_dynamicRuptureFaces += (l_faceType == FaceType::dynamicRupture) ? 1 : 0;
+      l_gravityFaces += (l_faceType == FaceType::freeSurfaceGravity) ? 1 : 0;
+    }
+    unsigned int l_cluster = m_cellClusterIds[l_cell];
+    l_clusterWeights[l_cluster] += l_costModel.elementWeight( l_dynamicRuptureFaces, l_gravityFaces );
+
+    // updates per simulated time of this rank
+    m_predictedCellUpdates += 1.0 / m_globalTimeStepWidths[l_cluster];
+    m_predictedDynamicRuptureUpdates += l_dynamicRuptureFaces / m_globalTimeStepWidths[l_cluster];
+  }
+
+#ifdef USE_MPI
+  MPI_Allreduce( MPI_IN_PLACE, l_clusterWeights.data(), l_clusterWeights.size(), MPI_DOUBLE, MPI_SUM, seissol::MPI::mpi.comm() );
+#endif // USE_MPI
+
+  unsigned int l_rate = (m_numberOfGlobalClusters > 1) ? m_globalTimeStepRates[0] : 1;
+  return l_costModel.predict( l_clusterWeights,
+                              m_globalTimeStepWidths[0],
+                              l_rate,
+                              seissol::MPI::mpi.size() );
+}
+
 void seissol::initializers::time_stepping::LtsLayout::addClusteredCopyCell( unsigned int i_cellId,
                                                                             unsigned int i_globalClusterId,
                                                                             unsigned int i_neighboringRank,
@@ -895,6 +966,8 @@ void seissol::initializers::time_stepping::LtsLayout::deriveClusteredCopyInterio
     }
   }
 
+  reorderClusteredInterior();
+
   /*
    * Sort GTS regions: DR and "GTS on der" comes first.
    */
@@ -953,6 +1026,78 @@ void seissol::initializers::time_stepping::LtsLayout::deriveClusteredCopyInterio
   }
 }
 
+void seissol::initializers::time_stepping::LtsLayout::reorderClusteredInterior() {
+  const int rank = seissol::MPI::mpi.rank();
+
+  if( m_cellOrdering != CellOrdering::Strategy::Mesh ) {
+    // local ids of the cells in the interior of the current cluster
+    std::vector< int > l_localIds( m_cells.size(), -1 );
+
+    double l_distanceBefore = 0.0, l_distanceAfter = 0.0;
+    unsigned int l_numberOfCells = 0;
+
+    for( unsigned int l_cluster = 0; l_cluster < m_clusteredInterior.size(); l_cluster++ ) {
+      std::vector< unsigned int > &l_interior = m_clusteredInterior[l_cluster];
+
+      for( unsigned int l_cell = 0; l_cell < l_interior.size(); l_cell++ ) {
+        l_localIds[ l_interior[l_cell] ] = l_cell;
+      }
+
+      // face graph of the interior, the neighbors in other layers do not affect the order
+      std::vector< std::array<int, 4> > l_neighbors( l_interior.size() );
+      for( unsigned int l_cell = 0; l_cell < l_interior.size(); l_cell++ ) {
+        for( unsigned int l_face = 0; l_face < 4; l_face++ ) {
+          FaceType l_faceType = getFaceType( m_cells[ l_interior[l_cell] ].boundaries[l_face] );
+          unsigned int l_neighbor = m_cells[ l_interior[l_cell] ].neighbors[l_face];
+
+          l_neighbors[l_cell][l_face] = -1;
+          if( ( l_faceType == FaceType::regular || l_faceType == FaceType::periodic ) && l_neighbor < m_cells.size() ) {
+            l_neighbors[l_cell][l_face] = l_localIds[l_neighbor];
+          }
+        }
+      }
+
+      std::vector< unsigned int > l_order;
+      if( m_cellOrdering == CellOrdering::Strategy::Hilbert ) {
+        std::vector< std::array<double, 3> > l_barycentres( l_interior.size() );
+        for( unsigned int l_cell = 0; l_cell < l_interior.size(); l_cell++ ) {
+          l_barycentres[l_cell] = m_cellBarycentres[ l_interior[l_cell] ];
+        }
+        l_order = CellOrdering::hilbert( l_barycentres );
+      } else {
+        l_order = CellOrdering::reverseCuthillMcKee( l_neighbors );
+      }
+
+      std::vector< unsigned int > l_identity( l_interior.size() );
+      std::iota( l_identity.begin(), l_identity.end(), 0 );
+      l_distanceBefore += CellOrdering::meanNeighborDistance( l_neighbors, l_identity ) * l_interior.size();
+      l_distanceAfter  += CellOrdering::meanNeighborDistance( l_neighbors, l_order ) * l_interior.size();
+      l_numberOfCells  += l_interior.size();
+
+      std::vector< unsigned int > l_reordered( l_interior.size() );
+      for( unsigned int l_cell = 0; l_cell < l_interior.size(); l_cell++ ) {
+        l_reordered[l_cell] = l_interior[ l_order[l_cell] ];
+        l_localIds[ l_interior[l_cell] ] = -1;
+      }
+      l_interior.swap( l_reordered );
+    }
+
+    if( l_numberOfCells > 0 ) {
+      logInfo(rank) << "Reordered the interior cells with the" << CellOrdering::name( m_cellOrdering )
+                    << "ordering, mean distance of neighboring cells:" << l_distanceBefore / l_numberOfCells
+                    << "before," << l_distanceAfter / l_numberOfCells << "after.";
+    }
+  }
+
+  // position of the interior cells for the neighbor search
+  m_interiorCellIds.assign( m_cells.size(), std::numeric_limits<unsigned int>::max() );
+  for( unsigned int l_cluster = 0; l_cluster < m_clusteredInterior.size(); l_cluster++ ) {
+    for( unsigned int l_cell = 0; l_cell < m_clusteredInterior[l_cluster].size(); l_cell++ ) {
+      m_interiorCellIds[ m_clusteredInterior[l_cluster][l_cell] ] = l_cell;
+    }
+  }
+}
+
 void seissol::initializers::time_stepping::LtsLayout::deriveClusteredGhost() {
   /*
    * Get sizes of the ghost regions
@@ -1153,6 +1298,14 @@ void seissol::initializers::time_stepping::LtsLayout::deriveLayout( enum TimeClu
                                                                     unsigned int        i_clusterRate ) {
 	const int rank = seissol::MPI::mpi.rank();
 
+  // use the clustering of the LTS cost model if available
+  if( m_optimizedClusterRate > 0 ) {
+    logInfo(rank) << "Using the clustering of the LTS cost model (rate" << m_optimizedClusterRate
+                  << ", at most" << m_maximumClusterId + 1 << "clusters) instead of the parameter file.";
+    i_timeClustering = (m_optimizedClusterRate == 1) ? single : multiRate;
+    i_clusterRate = m_optimizedClusterRate;
+  }
+
   m_clusteringStrategy = i_timeClustering;
 
   // derive time stepping clusters and per-cell cluster ids (w/o normalizations)
@@ -1175,6 +1328,9 @@ void seissol::initializers::time_stepping::LtsLayout::deriveLayout( enum TimeClu
                                  m_globalTimeStepRates );
   }
 
+  // merge the largest clusters
+  mergeClusters();
+
   // derive plain copy and the interior
   derivePlainCopyInterior();
 
@@ -1195,6 +1351,10 @@ void seissol::initializers::time_stepping::LtsLayout::deriveLayout( enum TimeClu
   logInfo(rank) << "maximum theoretical speedup (compared to GTS):"
                   << l_perCellSpeedup << "per cell LTS," << l_clusteringSpeedup << "with the used clustering.";
 
+  // get the prediction of the cost model
+  m_predictedTimePerSimulatedTime = predictTimePerSimulatedTime();
+  logInfo(rank) << "LTS cost model: predicted wall time per simulated time:" << m_predictedTimePerSimulatedTime;
+
   // derive clustered copy and interior layout
   deriveClusteredCopyInterior();
 
@@ -1577,6 +1737,8 @@ void seissol::initializers::time_stepping::LtsLayout::getMeshStructure( MeshStru
 #ifdef USE_MPI
     o_meshStructure[l_cluster].sendRequests    = new MPI_Request[ m_clusteredCopy[l_cluster].size() ];
     o_meshStructure[l_cluster].receiveRequests = new MPI_Request[ m_clusteredCopy[l_cluster].size() ];
+    o_meshStructure[l_cluster].ghostRegionMessages = new comm_real*[ m_clusteredCopy[l_cluster].size() ];
+    o_meshStructure[l_cluster].copyRegionMessages  = new comm_real*[ m_clusteredCopy[l_cluster].size() ];
 #endif
   }
 }
@@ -47,6 +47,8 @@
 #include <Geometry/MeshDefinition.h>
 #include <Geometry/MeshReader.h>
 
+#include "CellOrdering.h"
+
 #include <array>
 #include <limits>
 #include <cassert>
@@ -73,6 +75,12 @@ class seissol::initializers::time_stepping::LtsLayout {
     //! fault in the local domain
     std::vector<Fault> m_fault;
 
+    //! ordering of the cells within the interior of a cluster
+    CellOrdering::Strategy m_cellOrdering;
+
+    //! barycentres of the cells (only for the Hilbert ordering)
+    std::vector< std::array<double, 3> > m_cellBarycentres;
+
     //! time step widths of the cells (cfl)
     double       *m_cellTimeStepWidths;
 
@@ -88,6 +96,21 @@ class seissol::initializers::time_stepping::LtsLayout {
     //! time step rates of all clusters
     unsigned int *m_globalTimeStepRates;
 
+    //! rate chosen by the LTS cost model (0 if the rate of the parameter file is used)
+    unsigned int  m_optimizedClusterRate;
+
+    //! clusters above this id are merged into it
+    unsigned int  m_maximumClusterId;
+
+    //! wall time per simulated time predicted by the LTS cost model
+    double        m_predictedTimePerSimulatedTime;
+
+    //! cell updates per simulated time of this rank
+    double        m_predictedCellUpdates;
+
+    //! dynamic rupture face updates per simulated time of this rank (counted on both sides)
+    double        m_predictedDynamicRuptureUpdates;
+
     //! mpi tags used for communication
     enum mpiTag {
       deriveGhostPlain    = 0,
@@ -159,6 +182,12 @@ class seissol::initializers::time_stepping::LtsLayout {
      **/
     std::vector< std::vector< clusterCell > > m_clusteredInterior;
 
+    /**
+     * position of the interior cells in the interior of their cluster
+     * [*] : mesh id
+     **/
+    std::vector< unsigned int > m_interiorCellIds;
+
     /**
      * copy region of a time stepping cluster.
      * first[0]: mpi rank of the neighboring cluster
@@ -298,6 +327,17 @@ class seissol::initializers::time_stepping::LtsLayout {
     void getTheoreticalSpeedup( double &o_perCellTimeStepWidths,
                                 double &o_clustering );
 
+    /**
+     * Merges all clusters above the maximum cluster id into the maximum cluster.
+     **/
+    void mergeClusters();
+
+    /**
+     * Predicts the wall time per simulated time of the normalized clustering with the LTS cost model
+     * and the updates per simulated time of this rank.
+     **/
+    double predictTimePerSimulatedTime();
+
     /**
      * Sorts a clustered copy region neighboring to a copy region in GTS fashion.
      * Copy cells send either buffers or derivatives to neighboring cells, never both.
@@ -339,6 +379,12 @@ class seissol::initializers::time_stepping::LtsLayout {
      **/
     void deriveClusteredCopyInterior();
 
+    /**
+     * Reorders the cells in the interior of every cluster with the cell ordering (SEISSOL_CELL_ORDERING).
+     * The copy layers keep their order, which has to match the ghost layers of the neighboring ranks.
+     **/
+    void reorderClusteredInterior();
+
     /**
      * Derives the clustered ghost region (cell ids in then neighboring domain).
      **/
@@ -444,14 +490,12 @@ class seissol::initializers::time_stepping::LtsLayout {
       o_localClusterId = m_cellClusterIds[ i_meshId ];
       o_localClusterId = getLocalClusterId( o_localClusterId );
 
-      std::vector< unsigned int >::iterator l_searchResult = std::lower_bound( m_clusteredInterior[o_localClusterId].begin(), // start of the search
-                                                                               m_clusteredInterior[o_localClusterId].end(),   // end of the search
-                                                                               i_meshId );                                    // value to search for
-      o_localCellId = l_searchResult - m_clusteredInterior[o_localClusterId].begin();
+      // the interior is not sorted by mesh ids if the cells are reordered
+      o_localCellId = m_interiorCellIds[ i_meshId ];
 
       // ensure a valid value
       if( o_localCellId > m_clusteredInterior[o_localClusterId].size() - 1 ||
-          *l_searchResult != i_meshId ) logError() << "no matching neighboring interior cell";
+          m_clusteredInterior[o_localClusterId][o_localCellId] != i_meshId ) logError() << "no matching neighboring interior cell";
     }
 
   public:
@@ -481,6 +525,38 @@ class seissol::initializers::time_stepping::LtsLayout {
     void setTimeStepWidth( unsigned int i_cellId,
                            double       i_timeStepWidth );
 
+    /**
+     * Replaces the clustering of the parameter file by the clustering of the LTS cost model.
+     *
+     * @param i_clusterRate cluster rate (1 for GTS).
+     * @param i_maximumClusterId clusters above this id are merged into it.
+     **/
+    void setOptimizedClustering( unsigned int i_clusterRate,
+                                 unsigned int i_maximumClusterId );
+
+    /**
+     * Gets the wall time of the simulated time predicted by the LTS cost model.
+     *
+     * @param i_simulatedTime simulated time.
+     **/
+    double getPredictedWallTime( double i_simulatedTime ) const {
+      return m_predictedTimePerSimulatedTime * i_simulatedTime;
+    }
+
+    /**
+     * Gets the cell updates per simulated time of this rank.
+     **/
+    double getPredictedCellUpdates() const {
+      return m_predictedCellUpdates;
+    }
+
+    /**
+     * Gets the dynamic rupture face updates per simulated time of this rank.
+     **/
+    double getPredictedDynamicRuptureUpdates() const {
+      return m_predictedDynamicRuptureUpdates;
+    }
+
     /**
      * Derives the layout of the LTS scheme.
      *
@@ -46,15 +46,65 @@
 #include <PUML/Downward.h>
 #include <PUML/Upward.h>
 #include "LtsWeights.h"
+#include "LtsCostModel.h"
 
 #include <Eigen/Dense>
 
+#include <array>
+#include <cmath>
+#include <map>
+
 #include <Initializer/ParameterDB.h>
 #include <Parallel/MPI.h>
+#include <utils/env.h>
 
 #include <generated_code/tensor.h>
 #include <generated_code/init.h>
 
+namespace {
+  /**
+   * Parameters of the material of the build in the order of the model setup,
+   * see seissol::Interoperability::initializeModel.
+   **/
+  struct MaterialValues {
+#if defined USE_ANISOTROPIC
+    using Material = seissol::model::AnisotropicMaterial;
+    static constexpr MaterialLayout Layout = MaterialLayout::Anisotropic;
+    static constexpr unsigned Size = 22;
+    static void store(Material const& material, double* values) {
+      double const parameters[Size] = { material.rho,
+                                        material.c11, material.c12, material.c13, material.c14, material.c15, material.c16,
+                                        material.c22, material.c23, material.c24, material.c25, material.c26,
+                                        material.c33, material.c34, material.c35, material.c36,
+                                        material.c44, material.c45, material.c46,
+                                        material.c55, material.c56,
+                                        material.c66 };
+      std::copy(parameters, parameters + Size, values);
+    }
+#elif defined USE_VISCOELASTIC || defined USE_VISCOELASTIC2
+    using Material = seissol::model::ViscoElasticMaterial;
+    static constexpr MaterialLayout Layout = MaterialLayout::Viscoelastic;
+    static constexpr unsigned Size = 5;
+    static void store(Material const& material, double* values) {
+      values[0] = material.rho;
+      values[1] = material.mu;
+      values[2] = material.lambda;
+      values[3] = material.Qp;
+      values[4] = material.Qs;
+    }
+#else
+    using Material = seissol::model::ElasticMaterial;
+    static constexpr MaterialLayout Layout = MaterialLayout::Elastic;
+    static constexpr unsigned Size = 3;
+    static void store(Material const& material, double* values) {
+      values[0] = material.rho;
+      values[1] = material.mu;
+      values[2] = material.lambda;
+    }
+#endif
+  };
+}
+
 class FaceSorter {
 private:
 	std::vector<PUML::TETPUML::face_t> const& m_faces;
@@ -143,29 +193,126 @@ int seissol::initializers::time_stepping::LtsWeights::ipow(int x, int y) {
   return result;
 }
 
-void seissol::initializers::time_stepping::LtsWeights::computeWeights(PUML::TETPUML const& mesh) {
-  logInfo(seissol::MPI::mpi.rank()) << "Computing LTS weights.";
+void seissol::initializers::time_stepping::LtsWeights::evaluateMaterial( PUML::TETPUML const& mesh,
+                                                                         std::vector<double>& pWaveVel ) {
+  std::vector<PUML::TETPUML::cell_t> const& cells = mesh.cells();
+
+  // the model of the build, such that the model setup can reuse the parameters
+  std::vector<MaterialValues::Material> materials(cells.size());
+  seissol::initializers::MaterialParameterDB<MaterialValues::Material> parameterDB;
+  parameterDB.setMaterialVector(&materials);
+  seissol::initializers::ElementBarycentreGeneratorPUML queryGen(mesh);
+  parameterDB.evaluateModel(m_velocityModel, queryGen);
+
+  m_materialLayout = MaterialValues::Layout;
+  m_numberOfMaterialValues = MaterialValues::Size + 2;
+  m_materialValues.resize(cells.size() * m_numberOfMaterialValues);
+  for (unsigned cell = 0; cell < cells.size(); ++cell) {
+    pWaveVel[cell] = materials[cell].getMaxWaveSpeed();
+
+    double* values = &m_materialValues[cell * m_numberOfMaterialValues];
+    MaterialValues::store(materials[cell], values);
+    values[MaterialValues::Size] = materials[cell].getMaxWaveSpeed();
+    values[MaterialValues::Size + 1] = materials[cell].getSWaveSpeed();
+  }
+}
 
+void seissol::initializers::time_stepping::LtsWeights::evaluateCoarseMaterial( PUML::TETPUML const& mesh,
+                                                                               std::vector<double>& pWaveVel ) {
   std::vector<PUML::TETPUML::cell_t> const& cells = mesh.cells();
-  int const* boundaryCond = mesh.cellData(1);
+  std::vector<PUML::TETPUML::vertex_t> const& vertices = mesh.vertices();
+  int const* group = mesh.cellData(0);
+
+  unsigned numberOfBins = utils::Env::get<unsigned>("SEISSOL_LTS_MATERIAL_BINS", 32);
+  if (numberOfBins < 1) {
+    logError() << "SEISSOL_LTS_MATERIAL_BINS must be at least 1.";
+  }
+
+  std::vector<Eigen::Vector3d> barycentres(cells.size());
+  double boundingBox[6] = { std::numeric_limits<double>::max(), std::numeric_limits<double>::max(), std::numeric_limits<double>::max(),
+                            std::numeric_limits<double>::max(), std::numeric_limits<double>::max(), std::numeric_limits<double>::max() };
+  for (unsigned cell = 0; cell < cells.size(); ++cell) {
+    unsigned vertLids[4];
+    PUML::Downward::vertices(mesh, cells[cell], vertLids);
+    barycentres[cell].setZero();
+    for (unsigned vtx = 0; vtx < 4; ++vtx) {
+      for (unsigned d = 0; d < 3; ++d) {
+        barycentres[cell](d) += 0.25 * vertices[ vertLids[vtx] ].coordinate()[d];
+      }
+    }
+    // the maximum is stored negated, such that one reduction suffices
+    for (unsigned d = 0; d < 3; ++d) {
+      boundingBox[d] = std::min(boundingBox[d], barycentres[cell](d));
+      boundingBox[3 + d] = std::min(boundingBox[3 + d], -barycentres[cell](d));
+    }
+  }
+#ifdef USE_MPI
+  MPI_Allreduce(MPI_IN_PLACE, boundingBox, 6, MPI_DOUBLE, MPI_MIN, seissol::MPI::mpi.comm());
+#endif // USE_MPI
+
+  // one query per group and bin of a uniform grid over the domain, at a cell in the bin
+  std::map<std::array<long, 4>, unsigned> bins;
+  std::vector<unsigned> representatives;
+  std::vector<unsigned> binOfCell(cells.size());
+  for (unsigned cell = 0; cell < cells.size(); ++cell) {
+    std::array<long, 4> key;
+    key[0] = group[cell];
+    for (unsigned d = 0; d < 3; ++d) {
+      double extent = -boundingBox[3 + d] - boundingBox[d];
+      double position = (extent > 0.0) ? (barycentres[cell](d) - boundingBox[d]) / extent : 0.0;
+      key[1 + d] = std::min<long>(static_cast<long>(position * numberOfBins), numberOfBins - 1);
+    }
+    auto bin = bins.emplace(key, representatives.size());
+    if (bin.second) {
+      representatives.push_back(cell);
+    }
+    binOfCell[cell] = bin.first->second;
+  }
 
-  std::vector<double> pWaveVel;
-  pWaveVel.resize(cells.size());
-  
-  seissol::initializers::ElementBarycentreGeneratorPUML queryGen(mesh);  
-  //up to now we only distinguish between anisotropic elastic any other isotropic material
 #ifdef USE_ANISOTROPIC
-  std::vector<seissol::model::AnisotropicMaterial> materials(cells.size());
+  std::vector<seissol::model::AnisotropicMaterial> materials(representatives.size());
   seissol::initializers::MaterialParameterDB<seissol::model::AnisotropicMaterial> parameterDB;
 #else
-  std::vector<seissol::model::ElasticMaterial> materials(cells.size());
+  std::vector<seissol::model::ElasticMaterial> materials(representatives.size());
   seissol::initializers::MaterialParameterDB<seissol::model::ElasticMaterial> parameterDB;
-#endif 
+#endif
   parameterDB.setMaterialVector(&materials);
+  seissol::initializers::ElementBarycentreGeneratorPUML queryGen(mesh, &representatives);
   parameterDB.evaluateModel(m_velocityModel, queryGen);
-  for(unsigned cell = 0; cell < cells.size(); ++cell) {
-    pWaveVel[cell] = materials[cell].getMaxWaveSpeed();
+  for (unsigned cell = 0; cell < cells.size(); ++cell) {
+    pWaveVel[cell] = materials[ binOfCell[cell] ].getMaxWaveSpeed();
+  }
+
+  unsigned long numberOfQueries[2] = { representatives.size(), cells.size() };
+#ifdef USE_MPI
+  MPI_Allreduce(MPI_IN_PLACE, numberOfQueries, 2, MPI_UNSIGNED_LONG, MPI_SUM, seissol::MPI::mpi.comm());
+#endif // USE_MPI
+  logInfo(seissol::MPI::mpi.rank()) << "Evaluated the material for the LTS weights at" << numberOfQueries[0]
+                                    << "of" << numberOfQueries[1] << "cells.";
+
+  m_materialLayout = MaterialLayout::None;
+  m_numberOfMaterialValues = 0;
+  m_materialValues.clear();
+}
+
+void seissol::initializers::time_stepping::LtsWeights::computeWeights(PUML::TETPUML const& mesh) {
+  logInfo(seissol::MPI::mpi.rank()) << "Computing LTS weights.";
+
+  std::vector<PUML::TETPUML::cell_t> const& cells = mesh.cells();
+  int const* boundaryCond = mesh.cellData(1);
+
+  std::vector<double> pWaveVel;
+  pWaveVel.resize(cells.size());
+
+  std::string materialQuery = utils::Env::get<std::string>("SEISSOL_LTS_MATERIAL_QUERY", "full");
+  if (materialQuery == "full") {
+    evaluateMaterial(mesh, pWaveVel);
+  } else if (materialQuery == "coarse") {
+    evaluateCoarseMaterial(mesh, pWaveVel);
+  } else {
+    logError() << "Unknown LTS material query" << materialQuery;
   }
+
   std::vector<double> timestep;
   timestep.resize(cells.size());
   computeMaxTimesteps(mesh, pWaveVel, timestep);
@@ -182,34 +329,224 @@ void seissol::initializers::time_stepping::LtsWeights::computeWeights(PUML::TETP
   globalMaxTimestep = localMaxTimestep;
 #endif
 
-  int* cluster = new int[cells.size()];
-  for (unsigned cell = 0; cell < cells.size(); ++cell) {
-    cluster[cell] = getCluster(timestep[cell], globalMinTimestep, m_rate);
-  } 
-  
-  int totalNumberOfReductions = enforceMaximumDifference(mesh, cluster);
+  LtsCostModel costModel = LtsCostModel::fromEnvironment();
 
-  delete[] m_vertexWeights;
-  //m_ncon = 2;
-  m_ncon = 1;
-  m_vertexWeights = new int[cells.size() * m_ncon];
-  int maxCluster = getCluster(globalMaxTimestep, globalMinTimestep, m_rate);
-  int drToCellRatio = 1;
-  for (unsigned cell = 0; cell < cells.size(); ++cell) {    
-    int dynamicRupture = 0;
+  m_dynamicRuptureFaces.assign(cells.size(), 0);
+  m_gravityFaces.assign(cells.size(), 0);
+  std::vector<double> elementWeights(cells.size());
+  int numberOfFaces[2] = {0, 0};
+  for (unsigned cell = 0; cell < cells.size(); ++cell) {
     for (unsigned face = 0; face < 4; ++face) {
-      dynamicRupture += ( getBoundaryCondition(boundaryCond, cell, face) == 3) ? 1 : 0;
+      int boundary = getBoundaryCondition(boundaryCond, cell, face);
+      m_dynamicRuptureFaces[cell] += (boundary == 3) ? 1 : 0;
+      m_gravityFaces[cell] += (boundary == 2) ? 1 : 0;
     }
-    
-    m_vertexWeights[m_ncon * cell] = (1 + drToCellRatio*dynamicRupture) * ipow(m_rate, maxCluster - cluster[cell]);
-    //m_vertexWeights[m_ncon * cell + 1] = (dynamicRupture > 0) ? 1 : 0;
+    elementWeights[cell] = costModel.elementWeight(m_dynamicRuptureFaces[cell], m_gravityFaces[cell]);
+    numberOfFaces[0] += m_dynamicRuptureFaces[cell];
+    numberOfFaces[1] += m_gravityFaces[cell];
+  }
+#ifdef USE_MPI
+  MPI_Allreduce(MPI_IN_PLACE, numberOfFaces, 2, MPI_INT, MPI_SUM, seissol::MPI::mpi.comm());
+#endif // USE_MPI
+
+  std::string clustering = utils::Env::get<std::string>("SEISSOL_LTS_CLUSTERING", "fixed");
+
+  int* cluster = new int[cells.size()];
+  int totalNumberOfReductions = 0;
+  if (clustering == "auto") {
+    totalNumberOfReductions = optimizeClustering(mesh, timestep, elementWeights, globalMinTimestep, costModel, cluster);
+  } else if (clustering == "fixed") {
+    totalNumberOfReductions = deriveClusters(mesh, timestep, globalMinTimestep, m_rate, cluster);
+    double predictedTime = costModel.predict(computeClusterWeights(elementWeights, cluster), globalMinTimestep, m_rate, seissol::MPI::mpi.size());
+    logInfo(seissol::MPI::mpi.rank()) << "LTS cost model: predicted wall time per simulated time (CFL = 1):" << predictedTime;
+  } else {
+    logError() << "Unknown LTS clustering" << clustering;
+  }
+
+  // with several constraints, METIS balances the volume work and the work of the special faces separately
+  std::string constraints = utils::Env::get<std::string>("SEISSOL_PARTITION_CONSTRAINTS", "multi");
+  if (constraints == "multi") {
+    m_multiConstraint = true;
+  } else if (constraints == "single") {
+    m_multiConstraint = false;
+  } else {
+    logError() << "Unknown partition constraints" << constraints;
+  }
+  m_balanceDynamicRupture = m_multiConstraint && numberOfFaces[0] > 0;
+  m_balanceGravity = m_multiConstraint && numberOfFaces[1] > 0;
+
+  m_cellCost = costModel.cellCost();
+  m_dynamicRuptureCost = costModel.dynamicRuptureCost();
+  m_gravityCost = costModel.gravityCost();
+
+  m_ltsFactors.resize(cells.size());
+  int maxCluster = std::min<unsigned>(getCluster(globalMaxTimestep, globalMinTimestep, m_rate), m_maximumClusterId);
+  for (unsigned cell = 0; cell < cells.size(); ++cell) {
+    m_ltsFactors[cell] = ipow(m_rate, maxCluster - cluster[cell]);
+  }
+  computeVertexWeights(nullptr, std::vector<double>());
+
+  std::string constraintNames = "volume";
+  if (m_balanceDynamicRupture) {
+    constraintNames += ", dynamic rupture";
+  }
+  if (m_balanceGravity) {
+    constraintNames += ", free-surface gravity";
   }
+  logInfo(seissol::MPI::mpi.rank()) << "Partitioning with" << m_ncon << "constraints:" << constraintNames;
 
   delete[] cluster;
 
   logInfo(seissol::MPI::mpi.rank()) << "Computing LTS weights. Done. " << utils::nospace << '(' << totalNumberOfReductions << " reductions.)";
 }
 
+void seissol::initializers::time_stepping::LtsWeights::applyRankCosts(int const* partition, std::vector<double> const& rankCosts) {
+  logInfo(seissol::MPI::mpi.rank()) << "Rebalancing the LTS weights with the measured costs of the previous partitioning.";
+  computeVertexWeights(partition, rankCosts);
+}
+
+void seissol::initializers::time_stepping::LtsWeights::computeVertexWeights(int const* partition, std::vector<double> const& rankCosts) {
+  // relative costs of the ranks of the previous partitioning, normalized by the mean over all ranks
+  unsigned numberOfRanks = rankCosts.size() / 2;
+  std::vector<double> relativeCosts(rankCosts.size(), 1.0);
+  for (unsigned kind = 0; kind < 2; ++kind) {
+    double sum = 0.0;
+    unsigned count = 0;
+    for (unsigned rank = 0; rank < numberOfRanks; ++rank) {
+      if (rankCosts[2*rank + kind] > 0.0) {
+        sum += rankCosts[2*rank + kind];
+        ++count;
+      }
+    }
+    for (unsigned rank = 0; rank < numberOfRanks && sum > 0.0; ++rank) {
+      if (rankCosts[2*rank + kind] > 0.0) {
+        relativeCosts[2*rank + kind] = rankCosts[2*rank + kind] * count / sum;
+      }
+    }
+  }
+  // measured costs are not integral, hence we increase the resolution of the weights
+  double resolution = (partition != nullptr) ? 10.0 : 1.0;
+
+  unsigned numberOfCells = m_ltsFactors.size();
+
+  delete[] m_vertexWeights;
+  m_ncon = 1 + (m_balanceDynamicRupture ? 1 : 0) + (m_balanceGravity ? 1 : 0);
+  m_vertexWeights = new int[numberOfCells * m_ncon];
+  for (unsigned cell = 0; cell < numberOfCells; ++cell) {
+    double volumeCost = 1.0;
+    double dynamicRuptureCost = 1.0;
+    if (partition != nullptr) {
+      assert(partition[cell] >= 0 && static_cast<unsigned>(partition[cell]) < numberOfRanks);
+      volumeCost = relativeCosts[2*partition[cell]];
+      dynamicRuptureCost = relativeCosts[2*partition[cell] + 1];
+    }
+    double ltsFactor = m_ltsFactors[cell] * resolution;
+    int* weights = m_vertexWeights + m_ncon * cell;
+    if (m_multiConstraint) {
+      // plasticity is part of every cell update and scales all volume weights alike
+      *weights++ = std::max(1l, std::lround(volumeCost * ltsFactor));
+      if (m_balanceDynamicRupture) {
+        *weights++ = std::lround(m_dynamicRuptureFaces[cell] * dynamicRuptureCost * ltsFactor);
+      }
+      if (m_balanceGravity) {
+        // the gravity boundary is part of the volume integration
+        *weights++ = std::lround(m_gravityFaces[cell] * volumeCost * ltsFactor);
+      }
+    } else {
+      double weight = (m_cellCost + m_gravityCost * m_gravityFaces[cell]) * volumeCost
+                    + m_dynamicRuptureCost * m_dynamicRuptureFaces[cell] * dynamicRuptureCost;
+      *weights = std::max(1l, std::lround(weight / m_cellCost * ltsFactor));
+    }
+  }
+}
+
+int seissol::initializers::time_stepping::LtsWeights::deriveClusters( PUML::TETPUML const& mesh,
+                                                                      std::vector<double> const& timestep,
+                                                                      double globalMinTimestep,
+                                                                      unsigned rate,
+                                                                      int* cluster ) {
+  for (unsigned cell = 0; cell < timestep.size(); ++cell) {
+    cluster[cell] = getCluster(timestep[cell], globalMinTimestep, rate);
+  }
+  return enforceMaximumDifference(mesh, cluster);
+}
+
+std::vector<double> seissol::initializers::time_stepping::LtsWeights::computeClusterWeights( std::vector<double> const& elementWeights,
+                                                                                             int const* cluster ) {
+  int numberOfClusters = 0;
+  for (unsigned cell = 0; cell < elementWeights.size(); ++cell) {
+    numberOfClusters = std::max(numberOfClusters, cluster[cell] + 1);
+  }
+#ifdef USE_MPI
+  MPI_Allreduce(MPI_IN_PLACE, &numberOfClusters, 1, MPI_INT, MPI_MAX, seissol::MPI::mpi.comm());
+#endif // USE_MPI
+
+  std::vector<double> clusterWeights(numberOfClusters, 0.0);
+  for (unsigned cell = 0; cell < elementWeights.size(); ++cell) {
+    clusterWeights[ cluster[cell] ] += elementWeights[cell];
+  }
+#ifdef USE_MPI
+  MPI_Allreduce(MPI_IN_PLACE, clusterWeights.data(), numberOfClusters, MPI_DOUBLE, MPI_SUM, seissol::MPI::mpi.comm());
+#endif // USE_MPI
+  return clusterWeights;
+}
+
+int seissol::initializers::time_stepping::LtsWeights::optimizeClustering( PUML::TETPUML const& mesh,
+                                                                          std::vector<double> const& timestep,
+                                                                          std::vector<double> const& elementWeights,
+                                                                          double globalMinTimestep,
+                                                                          LtsCostModel const& costModel,
+                                                                          int* cluster ) {
+  int const rank = seissol::MPI::mpi.rank();
+  unsigned maximumRate = utils::Env::get<unsigned>("SEISSOL_LTS_MAX_RATE", 4);
+  if (maximumRate < 1) {
+    logError() << "SEISSOL_LTS_MAX_RATE must be at least 1.";
+  }
+
+  logInfo(rank) << "Optimizing the LTS clustering with an element cost of" << costModel.elementCost()
+                << "s and a cluster overhead of" << costModel.clusterOverhead() << "s.";
+
+  // the candidates are all rates up to the maximum rate and, for each rate, all merges of the largest clusters
+  std::vector<int> bestCluster(timestep.size());
+  double bestTime = std::numeric_limits<double>::max();
+  double gtsTime = std::numeric_limits<double>::max();
+  unsigned bestRate = 1;
+  unsigned bestMaximumClusterId = 0;
+  int bestNumberOfReductions = 0;
+  for (unsigned rate = 1; rate <= maximumRate; ++rate) {
+    int numberOfReductions = deriveClusters(mesh, timestep, globalMinTimestep, rate, cluster);
+    std::vector<double> clusterWeights = computeClusterWeights(elementWeights, cluster);
+
+    double predictedTime;
+    unsigned maximumClusterId = costModel.optimalMaximumClusterId(clusterWeights, globalMinTimestep, rate, seissol::MPI::mpi.size(), predictedTime);
+    logInfo(rank) << "Rate" << rate << "with" << maximumClusterId + 1 << "of" << clusterWeights.size()
+                  << "clusters: predicted wall time per simulated time (CFL = 1):" << predictedTime;
+    if (rate == 1) {
+      gtsTime = predictedTime;
+    }
+
+    if (predictedTime < bestTime) {
+      bestTime = predictedTime;
+      bestRate = rate;
+      bestMaximumClusterId = maximumClusterId;
+      bestNumberOfReductions = numberOfReductions;
+      // merging the largest clusters preserves the maximum difference between neighbours
+      for (unsigned cell = 0; cell < timestep.size(); ++cell) {
+        bestCluster[cell] = std::min<unsigned>(cluster[cell], maximumClusterId);
+      }
+    }
+  }
+
+  std::copy(bestCluster.begin(), bestCluster.end(), cluster);
+  m_rate = bestRate;
+  m_maximumClusterId = bestMaximumClusterId;
+  m_optimized = true;
+
+  logInfo(rank) << "Using LTS rate" << m_rate << "with" << m_maximumClusterId + 1 << "clusters, predicted speedup compared to GTS:" << gtsTime / bestTime;
+
+  return bestNumberOfReductions;
+}
+
 int seissol::initializers::time_stepping::LtsWeights::enforceMaximumDifference(PUML::TETPUML const& mesh, int* cluster) {
   int totalNumberOfReductions = 0;
   int globalNumberOfReductions;
@@ -42,7 +42,11 @@
 #ifndef INITIALIZER_TIMESTEPPING_LTSWEIGHTS_H_
 #define INITIALIZER_TIMESTEPPING_LTSWEIGHTS_H_
 
+#include <limits>
 #include <string>
+#include <vector>
+
+#include "Geometry/MeshDefinition.h"
 
 #ifndef PUML_PUML_H
 namespace PUML { class TETPUML; }
@@ -51,6 +55,7 @@ namespace PUML { class TETPUML; }
 namespace seissol {
   namespace initializers {
     namespace time_stepping {
+      class LtsCostModel;
       class LtsWeights;
     }
   }
@@ -65,11 +70,49 @@ public:
   }
   
   void computeWeights(PUML::TETPUML const& mesh);
+
+  /**
+   * Scales the weights of computeWeights with the measured costs of the ranks of a previous partitioning.
+   *
+   * @param partition The previous partitioning of the local cells.
+   * @param rankCosts Measured cost per cell update and per dynamic rupture face update for every rank of
+   *                  the previous partitioning (two entries per rank, non-positive if unknown).
+   */
+  void applyRankCosts(int const* partition, std::vector<double> const& rankCosts);
   
   int* vertexWeights() const { return m_vertexWeights; }
   int nWeightsPerVertex() const { return m_ncon; }
 
+  //! Rate of the clustering (chosen by the cost model with SEISSOL_LTS_CLUSTERING=auto)
+  unsigned rate() const { return m_rate; }
+  //! Clusters above this id are merged into it
+  unsigned maximumClusterId() const { return m_maximumClusterId; }
+  //! True if the clustering was chosen by the cost model
+  bool isOptimized() const { return m_optimized; }
+
+  /**
+   * Material parameters of the original cells, which were evaluated for the weights.
+   * Every cell has numberOfMaterialValues() entries: the parameters of the model setup,
+   * the maximum wave speed and the S-wave speed. Empty if the material was not evaluated completely.
+   **/
+  std::vector<double> const& materialValues() const { return m_materialValues; }
+  unsigned numberOfMaterialValues() const { return m_numberOfMaterialValues; }
+  MaterialLayout materialLayout() const { return m_materialLayout; }
+
+  //! Restores the clustering of a previous run instead of computing the weights
+  void setClustering(unsigned rate, unsigned maximumClusterId, bool optimized) {
+    m_rate = rate;
+    m_maximumClusterId = maximumClusterId;
+    m_optimized = optimized;
+  }
+
 private:
+  void evaluateMaterial( PUML::TETPUML const& mesh,
+                         std::vector<double>& pWaveVel );
+
+  void evaluateCoarseMaterial( PUML::TETPUML const& mesh,
+                               std::vector<double>& pWaveVel );
+
   void computeMaxTimesteps( PUML::TETPUML const&  mesh,
                             std::vector<double> const& pWaveVel,
                             std::vector<double>& timestep );
@@ -91,10 +134,46 @@ private:
                                       int* cluster,
                                       int maxDifference = 1 );
 
+  int deriveClusters( PUML::TETPUML const& mesh,
+                      std::vector<double> const& timestep,
+                      double globalMinTimestep,
+                      unsigned rate,
+                      int* cluster );
+
+  std::vector<double> computeClusterWeights( std::vector<double> const& elementWeights,
+                                             int const* cluster );
+
+  void computeVertexWeights( int const* partition,
+                             std::vector<double> const& rankCosts );
+
+  int optimizeClustering( PUML::TETPUML const& mesh,
+                          std::vector<double> const& timestep,
+                          std::vector<double> const& elementWeights,
+                          double globalMinTimestep,
+                          LtsCostModel const& costModel,
+                          int* cluster );
+
   std::string m_velocityModel;
   unsigned m_rate;
+  unsigned m_maximumClusterId = std::numeric_limits<unsigned>::max();
+  bool m_optimized = false;
   int* m_vertexWeights = nullptr;
   int m_ncon = 1;
+
+  std::vector<double> m_materialValues;
+  unsigned m_numberOfMaterialValues = 0;
+  MaterialLayout m_materialLayout = MaterialLayout::None;
+
+  // components of the weights, which are kept for rebalancing
+  std::vector<int> m_ltsFactors;
+  std::vector<unsigned> m_dynamicRuptureFaces;
+  std::vector<unsigned> m_gravityFaces;
+  bool m_multiConstraint = true;
+  bool m_balanceDynamicRupture = false;
+  bool m_balanceGravity = false;
+  double m_cellCost = 1.0;
+  double m_dynamicRuptureCost = 1.0;
+  double m_gravityCost = 1.0;
 };
 
 #endif
@@ -61,18 +61,17 @@ private:
   seissol::memory::ManagedAllocator m_allocator;
   std::vector<size_t> variableSizes{};  /*!< sizes of variables within the entire tree in bytes */
   std::vector<size_t> bucketSizes{};    /*!< sizes of buckets within the entire tree in bytes */
+  seissol::memory::Placement m_placement = seissol::memory::DefaultPlacement;
 
-#ifdef ACL_DEVICE
   std::vector<MemoryInfo> scratchpadMemInfo{};
   std::vector<size_t> scratchpadMemSizes{};  /*!< sizes of variables within the entire tree in bytes */
-  void** scratchpadMemories;
+  void** scratchpadMemories = nullptr;
   std::vector<int> scratchpadMemIds{};
-#endif  // ACL_DEVICE
 
 public:
   LTSTree() : m_vars(NULL), m_buckets(NULL) {}
   
-  ~LTSTree() { delete[] m_vars; delete[] m_buckets; }
+  ~LTSTree() { delete[] m_vars; delete[] m_buckets; delete[] scratchpadMemories; }
   
   void setNumberOfTimeClusters(unsigned numberOfTimeCluster) {
     setChildren<TimeCluster>(numberOfTimeCluster);
@@ -82,12 +81,15 @@ public:
     setPostOrderPointers();
     for (LTSTree::leaf_iterator it = beginLeaf(); it != endLeaf(); ++it) {
       it->allocatePointerArrays(varInfo.size(), bucketInfo.size());
-#ifdef ACL_DEVICE
       it->allocateScratchpadArrays(scratchpadMemInfo.size());
-#endif
     }
   }
   
+  /// Must be set before the variables and buckets are allocated
+  void setPlacement(seissol::memory::Placement placement) {
+    m_placement = placement;
+  }
+
   inline TimeCluster& child(unsigned index) {
     return *static_cast<TimeCluster*>(m_children[index]);
   }
@@ -131,7 +133,6 @@ public:
     bucketInfo.push_back(m);
   }
 
-#ifdef ACL_DEVICE
   void addScratchpadMemory(ScratchpadMemory& handle, size_t alignment, seissol::memory::Memkind memkind) {
     handle.index = scratchpadMemInfo.size();
     MemoryInfo memoryInfo;
@@ -139,7 +140,6 @@ public:
     memoryInfo.memkind = memkind;
     scratchpadMemInfo.push_back(memoryInfo);
   }
-#endif // ACL_DEVICE
   
   void allocateVariables() {
     m_vars = new void*[varInfo.size()];
@@ -150,7 +150,7 @@ public:
     }
 
     for (unsigned var = 0; var < varInfo.size(); ++var) {
-      m_vars[var] = m_allocator.allocateMemory(variableSizes[var], varInfo[var].alignment, varInfo[var].memkind);
+      m_vars[var] = m_allocator.allocateMemory(variableSizes[var], placementAlignment(varInfo[var].alignment), varInfo[var].memkind);
     }
     
     std::fill(variableSizes.begin(), variableSizes.end(), 0);
@@ -166,27 +166,29 @@ public:
     
     for (LTSTree::leaf_iterator it = beginLeaf(); it != endLeaf(); ++it) {
       it->addBucketSizes(bucketSizes);
+      alignBucketSizes();
     }
     
     for (unsigned bucket = 0; bucket < bucketInfo.size(); ++bucket) {
-      m_buckets[bucket] = m_allocator.allocateMemory(bucketSizes[bucket], bucketInfo[bucket].alignment, bucketInfo[bucket].memkind);
+      m_buckets[bucket] = m_allocator.allocateMemory(bucketSizes[bucket], placementAlignment(bucketInfo[bucket].alignment), bucketInfo[bucket].memkind);
     }
     
     std::fill(bucketSizes.begin(), bucketSizes.end(), 0);
       for (LTSTree::leaf_iterator it = beginLeaf(); it != endLeaf(); ++it) {
       it->setMemoryRegionsForBuckets(m_buckets, bucketSizes);
       it->addBucketSizes(bucketSizes);
+      alignBucketSizes();
     }
   }
 
-#ifdef ACL_DEVICE
   // Walks through all leaves, computes the maximum amount of memory for each scratchpad entity,
   // allocates all scratchpads based on evaluated max. scratchpad sizes, and, finally,
   // redistributes scratchpads to all leaves.
   //
   // Note, all scratchpad entities are shared between leaves.
-  // Do not update leaves in parallel inside of the same MPI rank while using GPUs.
+  // Do not update leaves in parallel inside of the same MPI rank while using batched computations.
   void allocateScratchPads() {
+    delete[] scratchpadMemories;
     scratchpadMemories = new void*[scratchpadMemInfo.size()];
     scratchpadMemSizes.resize(scratchpadMemInfo.size(), 0);
 
@@ -205,14 +207,54 @@ public:
       it->setMemoryRegionsForScratchpads(scratchpadMemories, scratchpadMemInfo.size());
     }
   }
-#endif
   
   void touchVariables() {
     for (LTSTree::leaf_iterator it = beginLeaf(); it != endLeaf(); ++it) {
-      it->touchVariables(varInfo);
+      it->touchVariables(varInfo, m_placement);
     }
   }
 
+  /// Places the pages of the buckets with the thread-to-cell mapping of the compute loops (no-op for the default placement)
+  void touchBuckets() {
+    if (m_placement != seissol::memory::DefaultPlacement) {
+      for (LTSTree::leaf_iterator it = beginLeaf(); it != endLeaf(); ++it) {
+        it->touchBuckets(bucketInfo, m_placement);
+      }
+    }
+  }
+
+  /// Logs the memory of all variables and buckets per NUMA domain
+  void printNumaDomains(char const* name) const {
+    std::vector< std::pair<void const*, size_t> > regions;
+    for (unsigned var = 0; var < varInfo.size(); ++var) {
+      if (varInfo[var].memkind != seissol::memory::DeviceGlobalMemory) {
+        regions.emplace_back(m_vars[var], variableSizes[var]);
+      }
+    }
+    for (unsigned bucket = 0; bucket < bucketInfo.size(); ++bucket) {
+      if (bucketInfo[bucket].memkind != seissol::memory::DeviceGlobalMemory) {
+        regions.emplace_back(m_buckets[bucket], bucketSizes[bucket]);
+      }
+    }
+    seissol::memory::printNumaDomains(name, regions);
+  }
+
+private:
+  size_t placementAlignment(size_t alignment) const {
+    return (m_placement == seissol::memory::DefaultPlacement) ? alignment : std::max(alignment, seissol::memory::pageSize());
+  }
+
+  /// With a placement, the buckets of different layers do not share pages
+  void alignBucketSizes() {
+    if (m_placement != seissol::memory::DefaultPlacement) {
+      size_t const page = seissol::memory::pageSize();
+      for (auto& size : bucketSizes) {
+        size = (size + page - 1) / page * page;
+      }
+    }
+  }
+
+public:
   const std::vector<size_t>& getVariableSizes() {
     return variableSizes;
   }
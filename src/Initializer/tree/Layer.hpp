@@ -63,9 +63,7 @@ namespace seissol {
     class Bucket;
     struct MemoryInfo;
     class Layer;
-#ifdef ACL_DEVICE
     struct ScratchpadMemory;
-#endif
   }
 }
 
@@ -83,9 +81,7 @@ struct seissol::initializers::Bucket {
   Bucket() : index(std::numeric_limits<unsigned>::max()) {}
 };
 
-#ifdef ACL_DEVICE
 struct seissol::initializers::ScratchpadMemory : public seissol::initializers::Bucket{};
-#endif
 
 struct seissol::initializers::MemoryInfo {
   size_t bytes;
@@ -102,15 +98,13 @@ private:
   void** m_buckets;
   size_t* m_bucketSizes;
 
-#ifdef ACL_DEVICE
   void** m_scratchpads{};
   size_t* m_scratchpadSizes{};
   ConditionalBatchTableT m_conditionalBatchTable{};
-#endif
 
 public:
   Layer() : m_numberOfCells(0), m_vars(NULL), m_buckets(NULL), m_bucketSizes(NULL) {}
-  ~Layer() { delete[] m_vars; delete[] m_buckets; delete[] m_bucketSizes; }
+  ~Layer() { delete[] m_vars; delete[] m_buckets; delete[] m_bucketSizes; delete[] m_scratchpads; delete[] m_scratchpadSizes; }
   
   template<typename T>
   T* var(Variable<T> const& handle) {
@@ -125,13 +119,11 @@ public:
     return m_buckets[handle.index];
   }
 
-#ifdef ACL_DEVICE
   void* getScratchpadMemory(ScratchpadMemory const& handle) {
     assert(handle.index != std::numeric_limits<unsigned>::max());
     assert(m_scratchpads != NULL/* && m_vars[handle.index] != NULL*/);
     return (m_scratchpads[handle.index]);
   }
-#endif
   
   /// i-th bit of layerMask shall be set if data is masked on the i-th layer
   inline bool isMasked(LayerMask layerMask) const {
@@ -164,7 +156,6 @@ public:
     std::fill(m_bucketSizes, m_bucketSizes + numBuckets, 0);
   }
 
-#ifdef ACL_DEVICE
   inline void allocateScratchpadArrays(unsigned numScratchPads) {
     assert(m_scratchpads == nullptr && m_scratchpadSizes == nullptr);
 
@@ -174,19 +165,16 @@ public:
     m_scratchpadSizes = new size_t[numScratchPads];
     std::fill(m_scratchpadSizes, m_scratchpadSizes + numScratchPads, 0);
   }
-#endif
   
   inline void setBucketSize(Bucket const& handle, size_t size) {
     assert(m_bucketSizes != NULL);
     m_bucketSizes[handle.index] = size;
   }
 
-#ifdef ACL_DEVICE
   inline void setScratchpadSize(ScratchpadMemory const& handle, size_t size) {
     assert(m_scratchpadSizes != NULL);
     m_scratchpadSizes[handle.index] = size;
   }
-#endif
 
   inline size_t getBucketSize(Bucket const& handle) {
     assert(m_bucketSizes != nullptr);
@@ -207,7 +195,6 @@ public:
     }
   }
 
-#ifdef ACL_DEVICE
   // Overrides array's elements; if the corresponding local
   // scratchpad mem. size is bigger then the one inside of the array
   void findMaxScratchpadSizes(std::vector<size_t>& bytes) {
@@ -215,7 +202,6 @@ public:
       bytes[id] = std::max(bytes[id], m_scratchpadSizes[id]);
     }
   }
-#endif
 
   void setMemoryRegionsForVariables(std::vector<MemoryInfo> const& vars, void** memory, std::vector<size_t>& offsets) {
     assert(m_vars != NULL);
@@ -233,32 +219,48 @@ public:
     }
   }
 
-#ifdef ACL_DEVICE
   void setMemoryRegionsForScratchpads(void** memory, size_t numScratchPads) {
     assert(m_scratchpads != NULL);
     for (size_t id = 0; id < numScratchPads; ++id) {
       m_scratchpads[id] = static_cast<char*>(memory[id]);
     }
   }
-#endif
   
-  void touchVariables(std::vector<MemoryInfo> const& vars) {
+  void touchVariables(std::vector<MemoryInfo> const& vars, seissol::memory::Placement placement = seissol::memory::DefaultPlacement) {
     for (unsigned var = 0; var < vars.size(); ++var) {
 
       // NOTE: we don't touch device global memory because it is in a different address space
       // we will do deep-copy from the host to a device later on
       if (!isMasked(vars[var].mask) && (vars[var].memkind != seissol::memory::DeviceGlobalMemory)) {
+        if (placement == seissol::memory::DefaultPlacement) {
 #ifdef _OPENMP
 #pragma omp parallel for schedule(static)
 #endif
-        for (unsigned cell = 0; cell < m_numberOfCells; ++cell) {
-          memset(static_cast<char*>(m_vars[var]) + cell * vars[var].bytes, 0, vars[var].bytes);
+          for (unsigned cell = 0; cell < m_numberOfCells; ++cell) {
+            memset(static_cast<char*>(m_vars[var]) + cell * vars[var].bytes, 0, vars[var].bytes);
+          }
+        } else {
+          seissol::memory::touch(m_vars[var], m_numberOfCells * vars[var].bytes, m_numberOfCells, interleaved(placement));
         }
       }
     }
   }
 
-#ifdef ACL_DEVICE
+  /// Buckets are initialized by their users; this only places their pages (see seissol::memory::Placement)
+  void touchBuckets(std::vector<MemoryInfo> const& buckets, seissol::memory::Placement placement) {
+    assert(placement != seissol::memory::DefaultPlacement);
+    for (unsigned bucket = 0; bucket < buckets.size(); ++bucket) {
+      if (buckets[bucket].memkind != seissol::memory::DeviceGlobalMemory) {
+        seissol::memory::touch(m_buckets[bucket], m_bucketSizes[bucket], m_numberOfCells, interleaved(placement));
+      }
+    }
+  }
+
+  /// Copy layers are small and accessed by the communication, hence they may be spread over all NUMA domains
+  inline bool interleaved(seissol::memory::Placement placement) const {
+    return placement == seissol::memory::InterleavedCopyPlacement && m_layerType == Copy;
+  }
+
   ConditionalBatchTableT& getCondBatchTable() {
     return m_conditionalBatchTable;
   }
@@ -266,7 +268,6 @@ public:
   const ConditionalBatchTableT& getCondBatchTable() const {
     return m_conditionalBatchTable;
   }
-#endif // ACL_DEVICE
 };
 
 #endif
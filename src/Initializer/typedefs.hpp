@@ -245,6 +245,13 @@ struct MeshStructure {
    * MPI receive requests.
    */
   MPI_Request *receiveRequests;
+
+  /*
+   * Message buffers of the ghost and copy regions.
+   *   Remark: Point to ghostRegions and copyRegions, unless the messages are converted to single precision.
+   */
+  comm_real** ghostRegionMessages;
+  comm_real** copyRegionMessages;
 #endif
 
 };
@@ -431,6 +438,8 @@ struct PlasticityData {
   real cohesionTimesCosAngularFriction;
   real sinAngularFriction;
   real mufactor;
+  // false if the cell lies outside of the region with plasticity
+  bool evaluate;
 };
 
 /** A piecewise linear function.
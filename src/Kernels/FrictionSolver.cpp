@@ -0,0 +1,462 @@
+/**
+ * @file
+ * This file is part of SeisSol.
+ *
+ * @section LICENSE
+ * Copyright (c) 2020, SeisSol Group
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @section DESCRIPTION
+ * Layer-wise friction solver for dynamic rupture.
+ **/
+
+#include "FrictionSolver.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+
+#include <generated_code/init.h>
+
+using seissol::initializers::numberOfDRPoints;
+using seissol::initializers::numberOfPaddedDRPoints;
+
+static_assert(seissol::tensor::QInterpolated::Shape[0] == seissol::tensor::resample::Shape[0], "Different number of quadrature points?");
+
+namespace {
+  //! slip rate which is considered as being zero for instantaneous healing
+  constexpr real ZeroSlipRate = 1e-13;
+}
+
+bool seissol::kernels::FrictionSolver::isSupported(int frictionLaw) {
+  switch (static_cast<Law>(frictionLaw)) {
+    case Law::NoFault:
+    case Law::LinearSlipWeakening:
+    case Law::RateAndStateAgingLaw:
+    case Law::RateAndStateSlipLaw:
+    case Law::LinearSlipWeakeningForcedRupture:
+      return true;
+    default:
+      return false;
+  }
+}
+
+void seissol::kernels::FrictionSolver::computeFaultStresses( unsigned                                    blockFace,
+                                                             real const                                  QInterpolatedPlus[CONVERGENCE_ORDER][tensor::QInterpolated::size()],
+                                                             real const                                  QInterpolatedMinus[CONVERGENCE_ORDER][tensor::QInterpolated::size()],
+                                                             seissol::model::IsotropicWaveSpeeds const&  waveSpeedsPlus,
+                                                             seissol::model::IsotropicWaveSpeeds const&  waveSpeedsMinus,
+                                                             double const                                timeWeights[CONVERGENCE_ORDER],
+                                                             FaultStresses&                              stresses,
+                                                             real                                        imposedStatePlus[tensor::QInterpolated::size()],
+                                                             real                                        imposedStateMinus[tensor::QInterpolated::size()] ) {
+  assert(blockFace < BlockSize);
+
+  real const invZp = 1.0 / (waveSpeedsPlus.density * waveSpeedsPlus.pWaveVelocity);
+  real const invZpNeig = 1.0 / (waveSpeedsMinus.density * waveSpeedsMinus.pWaveVelocity);
+  real const invZs = 1.0 / (waveSpeedsPlus.density * waveSpeedsPlus.sWaveVelocity);
+  real const invZsNeig = 1.0 / (waveSpeedsMinus.density * waveSpeedsMinus.sWaveVelocity);
+  real const etaP = 1.0 / (invZp + invZpNeig);
+  real const etaS = 1.0 / (invZs + invZsNeig);
+
+  // quantities are stored as [quantity][point], the time integrated tractions are added by evaluate
+  std::memset(imposedStatePlus, 0, tensor::QInterpolated::size() * sizeof(real));
+  std::memset(imposedStateMinus, 0, tensor::QInterpolated::size() * sizeof(real));
+
+  constexpr unsigned ld = numberOfPaddedDRPoints;
+  for (unsigned timePoint = 0; timePoint < CONVERGENCE_ORDER; ++timePoint) {
+    real const* qPlus = QInterpolatedPlus[timePoint];
+    real const* qMinus = QInterpolatedMinus[timePoint];
+    real* normalStress = stresses.normalStress[blockFace][timePoint];
+    real* xyStress = stresses.xyStress[blockFace][timePoint];
+    real* xzStress = stresses.xzStress[blockFace][timePoint];
+    real const weight = timeWeights[timePoint];
+
+    #pragma omp simd
+    for (unsigned point = 0; point < numberOfDRPoints; ++point) {
+      real const n = etaP * (qMinus[6*ld + point] - qPlus[6*ld + point] + qPlus[point] * invZp + qMinus[point] * invZpNeig);
+      normalStress[point] = n;
+      xyStress[point] = etaS * (qMinus[7*ld + point] - qPlus[7*ld + point] + qPlus[3*ld + point] * invZs + qMinus[3*ld + point] * invZsNeig);
+      xzStress[point] = etaS * (qMinus[8*ld + point] - qPlus[8*ld + point] + qPlus[5*ld + point] * invZs + qMinus[5*ld + point] * invZsNeig);
+
+      imposedStatePlus[point] += weight * n;
+      imposedStatePlus[6*ld + point] += weight * (qPlus[6*ld + point] + invZp * (n - qPlus[point]));
+      imposedStatePlus[7*ld + point] += weight * (qPlus[7*ld + point] - invZs * qPlus[3*ld + point]);
+      imposedStatePlus[8*ld + point] += weight * (qPlus[8*ld + point] - invZs * qPlus[5*ld + point]);
+
+      imposedStateMinus[point] += weight * n;
+      imposedStateMinus[6*ld + point] += weight * (qMinus[6*ld + point] - invZpNeig * (n - qMinus[point]));
+      imposedStateMinus[7*ld + point] += weight * (qMinus[7*ld + point] + invZsNeig * qMinus[3*ld + point]);
+      imposedStateMinus[8*ld + point] += weight * (qMinus[8*ld + point] + invZsNeig * qMinus[5*ld + point]);
+    }
+  }
+}
+
+seissol::kernels::FrictionSolver::BlockData seissol::kernels::FrictionSolver::loadBlock( seissol::initializers::Layer&                 layerData,
+                                                                                         seissol::initializers::DynamicRupture const*  dynRup,
+                                                                                         unsigned                                      firstFace ) {
+  BlockData block;
+  block.initialStressInFaultCS  = layerData.var(dynRup->initialStressInFaultCS) + firstFace;
+  block.cohesion                = layerData.var(dynRup->cohesion) + firstFace;
+  block.muS                     = layerData.var(dynRup->muS) + firstFace;
+  block.muD                     = layerData.var(dynRup->muD) + firstFace;
+  block.dC                      = layerData.var(dynRup->dC) + firstFace;
+  block.forcedRuptureTime       = layerData.var(dynRup->forcedRuptureTime) + firstFace;
+  block.mu                      = layerData.var(dynRup->mu) + firstFace;
+  block.slip                    = layerData.var(dynRup->slip) + firstFace;
+  block.slip1                   = layerData.var(dynRup->slip1) + firstFace;
+  block.slip2                   = layerData.var(dynRup->slip2) + firstFace;
+  block.slipRate1               = layerData.var(dynRup->slipRate1) + firstFace;
+  block.slipRate2               = layerData.var(dynRup->slipRate2) + firstFace;
+  block.stateVariable           = layerData.var(dynRup->stateVariable) + firstFace;
+  block.tractionXY              = layerData.var(dynRup->tractionXY) + firstFace;
+  block.tractionXZ              = layerData.var(dynRup->tractionXZ) + firstFace;
+  block.ruptureTime             = layerData.var(dynRup->ruptureTime) + firstFace;
+  block.dynStressTime           = layerData.var(dynRup->dynStressTime) + firstFace;
+  block.peakSlipRate            = layerData.var(dynRup->peakSlipRate) + firstFace;
+  block.ruptureFront            = layerData.var(dynRup->ruptureFront) + firstFace;
+  block.dynStressPending        = layerData.var(dynRup->dynStressPending) + firstFace;
+  block.averagedSlip            = layerData.var(dynRup->averagedSlip) + firstFace;
+  block.magnitudeOutput         = layerData.var(dynRup->magnitudeOutput) + firstFace;
+  block.waveSpeedsPlus          = layerData.var(dynRup->waveSpeedsPlus) + firstFace;
+  block.waveSpeedsMinus         = layerData.var(dynRup->waveSpeedsMinus) + firstFace;
+  block.imposedStatePlus        = layerData.var(dynRup->imposedStatePlus) + firstFace;
+  block.imposedStateMinus       = layerData.var(dynRup->imposedStateMinus) + firstFace;
+  return block;
+}
+
+void seissol::kernels::FrictionSolver::evaluate( seissol::initializers::Layer&                 layerData,
+                                                 seissol::initializers::DynamicRupture const*  dynRup,
+                                                 unsigned                                      firstFace,
+                                                 unsigned                                      numberOfFaces,
+                                                 FaultStresses const&                          stresses,
+                                                 double                                        fullUpdateTime,
+                                                 double const                                  timePoints[CONVERGENCE_ORDER],
+                                                 double const                                  timeWeights[CONVERGENCE_ORDER] ) {
+  assert(numberOfFaces <= BlockSize);
+  assert(firstFace + numberOfFaces <= layerData.getNumberOfCells());
+
+  BlockData block = loadBlock(layerData, dynRup, firstFace);
+
+  // time step sizes between the time points, the last one fills the remaining interval
+  real deltaT[CONVERGENCE_ORDER];
+  deltaT[0] = timePoints[0];
+  for (unsigned timePoint = 1; timePoint < CONVERGENCE_ORDER; ++timePoint) {
+    deltaT[timePoint] = timePoints[timePoint] - timePoints[timePoint-1];
+  }
+  deltaT[CONVERGENCE_ORDER-1] += deltaT[0];
+
+  alignas(ALIGNMENT) real tractionIntegralXY[BlockSize][numberOfPaddedDRPoints];
+  alignas(ALIGNMENT) real tractionIntegralXZ[BlockSize][numberOfPaddedDRPoints];
+  std::fill_n(&tractionIntegralXY[0][0], BlockSize * numberOfPaddedDRPoints, 0.0);
+  std::fill_n(&tractionIntegralXZ[0][0], BlockSize * numberOfPaddedDRPoints, 0.0);
+
+  switch (m_parameters.law) {
+    case Law::NoFault:
+      evaluateNoFault(stresses, numberOfFaces, timeWeights, block, tractionIntegralXY, tractionIntegralXZ);
+      break;
+    case Law::LinearSlipWeakening:
+      evaluateLinearSlipWeakening<false>(stresses, numberOfFaces, fullUpdateTime, deltaT, timeWeights, block, tractionIntegralXY, tractionIntegralXZ);
+      break;
+    case Law::LinearSlipWeakeningForcedRupture:
+      evaluateLinearSlipWeakening<true>(stresses, numberOfFaces, fullUpdateTime, deltaT, timeWeights, block, tractionIntegralXY, tractionIntegralXZ);
+      break;
+    case Law::RateAndStateAgingLaw:
+      evaluateRateAndState<false>(stresses, numberOfFaces, fullUpdateTime, deltaT, timeWeights, block, tractionIntegralXY, tractionIntegralXZ);
+      break;
+    case Law::RateAndStateSlipLaw:
+      evaluateRateAndState<true>(stresses, numberOfFaces, fullUpdateTime, deltaT, timeWeights, block, tractionIntegralXY, tractionIntegralXZ);
+      break;
+  }
+
+  // add the time integrated tractions to the imposed states
+  constexpr unsigned ld = numberOfPaddedDRPoints;
+  for (unsigned face = 0; face < numberOfFaces; ++face) {
+    real const invZs = 1.0 / (block.waveSpeedsPlus[face].density * block.waveSpeedsPlus[face].sWaveVelocity);
+    real const invZsNeig = 1.0 / (block.waveSpeedsMinus[face].density * block.waveSpeedsMinus[face].sWaveVelocity);
+    real* imposedStatePlus = block.imposedStatePlus[face];
+    real* imposedStateMinus = block.imposedStateMinus[face];
+
+    #pragma omp simd
+    for (unsigned point = 0; point < numberOfDRPoints; ++point) {
+      real const tXY = tractionIntegralXY[face][point];
+      real const tXZ = tractionIntegralXZ[face][point];
+      imposedStatePlus[3*ld + point] += tXY;
+      imposedStatePlus[5*ld + point] += tXZ;
+      imposedStatePlus[7*ld + point] += invZs * tXY;
+      imposedStatePlus[8*ld + point] += invZs * tXZ;
+      imposedStateMinus[3*ld + point] += tXY;
+      imposedStateMinus[5*ld + point] += tXZ;
+      imposedStateMinus[7*ld + point] -= invZsNeig * tXY;
+      imposedStateMinus[8*ld + point] -= invZsNeig * tXZ;
+    }
+  }
+}
+
+void seissol::kernels::FrictionSolver::evaluateNoFault( FaultStresses const& stresses,
+                                                        unsigned             numberOfFaces,
+                                                        double const         timeWeights[CONVERGENCE_ORDER],
+                                                        BlockData&           block,
+                                                        real                 tractionIntegralXY[BlockSize][numberOfPaddedDRPoints],
+                                                        real                 tractionIntegralXZ[BlockSize][numberOfPaddedDRPoints] ) {
+  for (unsigned face = 0; face < numberOfFaces; ++face) {
+    for (unsigned timePoint = 0; timePoint < CONVERGENCE_ORDER; ++timePoint) {
+      real const weight = timeWeights[timePoint];
+      #pragma omp simd
+      for (unsigned point = 0; point < numberOfDRPoints; ++point) {
+        tractionIntegralXY[face][point] += weight * stresses.xyStress[face][timePoint][point];
+        tractionIntegralXZ[face][point] += weight * stresses.xzStress[face][timePoint][point];
+        block.tractionXY[face][point] = stresses.xyStress[face][timePoint][point];
+        block.tractionXZ[face][point] = stresses.xzStress[face][timePoint][point];
+      }
+    }
+  }
+}
+
+template<bool ForcedRupture>
+void seissol::kernels::FrictionSolver::evaluateLinearSlipWeakening( FaultStresses const& stresses,
+                                                                    unsigned             numberOfFaces,
+                                                                    real                 fullUpdateTime,
+                                                                    real const           deltaT[CONVERGENCE_ORDER],
+                                                                    double const         timeWeights[CONVERGENCE_ORDER],
+                                                                    BlockData&           block,
+                                                                    real                 tractionIntegralXY[BlockSize][numberOfPaddedDRPoints],
+                                                                    real                 tractionIntegralXZ[BlockSize][numberOfPaddedDRPoints] ) {
+  auto resample = init::resample::view::create(const_cast<real*>(init::resample::Values));
+
+  alignas(ALIGNMENT) real slipRate[numberOfPaddedDRPoints];
+  alignas(ALIGNMENT) real accumulatedSlip[numberOfPaddedDRPoints];
+
+  for (unsigned face = 0; face < numberOfFaces; ++face) {
+    real const Z = block.waveSpeedsPlus[face].density * block.waveSpeedsPlus[face].sWaveVelocity;
+    real const ZNeig = block.waveSpeedsMinus[face].density * block.waveSpeedsMinus[face].sWaveVelocity;
+    real const eta = Z * ZNeig / (Z + ZNeig);
+
+    real const (&initialStress)[6][numberOfPaddedDRPoints] = block.initialStressInFaultCS[face];
+    real* mu = block.mu[face];
+    real* slip = block.slip[face];
+
+    std::fill_n(accumulatedSlip, numberOfPaddedDRPoints, 0.0);
+
+    real tn = fullUpdateTime;
+    for (unsigned timePoint = 0; timePoint < CONVERGENCE_ORDER; ++timePoint) {
+      real const dt = deltaT[timePoint];
+      real const weight = timeWeights[timePoint];
+      real const* normalStress = stresses.normalStress[face][timePoint];
+      real const* xyStress = stresses.xyStress[face][timePoint];
+      real const* xzStress = stresses.xzStress[face][timePoint];
+      tn += dt;
+
+      #pragma omp simd
+      for (unsigned point = 0; point < numberOfDRPoints; ++point) {
+        real const P = initialStress[0][point] + normalStress[point];
+        real const strength = -block.cohesion[face][point] - mu[point] * std::min(P, static_cast<real>(0.0));
+        real const shearXY = initialStress[3][point] + xyStress[point];
+        real const shearXZ = initialStress[5][point] + xzStress[point];
+        real const shTest = std::sqrt(shearXY * shearXY + shearXZ * shearXZ);
+
+        real const sr = std::max(static_cast<real>(0.0), (shTest - strength) / eta);
+        real const sr1 = sr * shearXY / (strength + eta * sr);
+        real const sr2 = sr * shearXZ / (strength + eta * sr);
+        real const tractionXY = xyStress[point] - eta * sr1;
+        real const tractionXZ = xzStress[point] - eta * sr2;
+
+        block.slip1[face][point] += sr1 * dt;
+        block.slip2[face][point] += sr2 * dt;
+        block.slipRate1[face][point] = sr1;
+        block.slipRate2[face][point] = sr2;
+        block.tractionXY[face][point] = tractionXY;
+        block.tractionXZ[face][point] = tractionXZ;
+        tractionIntegralXY[face][point] += weight * tractionXY;
+        tractionIntegralXZ[face][point] += weight * tractionXZ;
+
+        slipRate[point] = sr;
+        accumulatedSlip[point] += sr * dt;
+      }
+
+      // Resample the slip rate, such that the slip lies in the same polynomial space as the degrees of freedom
+      for (unsigned k = 0; k < numberOfDRPoints; ++k) {
+        real const increment = slipRate[k] * dt;
+        #pragma omp simd
+        for (unsigned point = 0; point < numberOfDRPoints; ++point) {
+          slip[point] += resample(point, k) * increment;
+        }
+      }
+
+      #pragma omp simd
+      for (unsigned point = 0; point < numberOfDRPoints; ++point) {
+        real const f1 = std::min(std::abs(slip[point]) / block.dC[face][point], static_cast<real>(1.0));
+        real f2 = 0.0;
+        if (ForcedRupture) {
+          if (m_parameters.t0 == 0.0) {
+            f2 = (tn >= block.forcedRuptureTime[face][point]) ? 1.0 : 0.0;
+          } else {
+            f2 = std::max(static_cast<real>(0.0), std::min((fullUpdateTime - block.forcedRuptureTime[face][point]) / m_parameters.t0, static_cast<real>(1.0)));
+          }
+        }
+        mu[point] = block.muS[face][point] - (block.muS[face][point] - block.muD[face][point]) * std::max(f1, f2);
+
+        if (m_parameters.instantaneousHealing && slipRate[point] < ZeroSlipRate) {
+          mu[point] = block.muS[face][point];
+          slip[point] = 0.0;
+        }
+      }
+    }
+
+    // Rupture front and dynamic stress output are updated once per time step (no sub time step resolution)
+    real averagedSlip = 0.0;
+    for (unsigned point = 0; point < numberOfDRPoints; ++point) {
+      if (block.ruptureFront[face][point] && slipRate[point] > 0.001) {
+        block.ruptureTime[face][point] = fullUpdateTime;
+        block.ruptureFront[face][point] = false;
+      }
+      if (block.ruptureTime[face][point] > 0.0 && block.ruptureTime[face][point] <= fullUpdateTime
+          && block.dynStressPending[face][point] && std::abs(slip[point]) >= block.dC[face][point]) {
+        block.dynStressTime[face][point] = fullUpdateTime;
+        block.dynStressPending[face][point] = false;
+      }
+      block.peakSlipRate[face][point] = std::max(block.peakSlipRate[face][point], slipRate[point]);
+      averagedSlip += accumulatedSlip[point];
+    }
+
+    if (block.magnitudeOutput[face]) {
+      block.averagedSlip[face] += averagedSlip / numberOfDRPoints;
+    }
+  }
+}
+
+template<bool SlipLaw>
+void seissol::kernels::FrictionSolver::evaluateRateAndState( FaultStresses const& stresses,
+                                                             unsigned             numberOfFaces,
+                                                             real                 fullUpdateTime,
+                                                             real const           deltaT[CONVERGENCE_ORDER],
+                                                             double const         timeWeights[CONVERGENCE_ORDER],
+                                                             BlockData&           block,
+                                                             real                 tractionIntegralXY[BlockSize][numberOfPaddedDRPoints],
+                                                             real                 tractionIntegralXZ[BlockSize][numberOfPaddedDRPoints] ) {
+  // iteration counts of Kaneko et al. (2008), fixed such that the loop over the points vectorizes
+  constexpr unsigned numberOfStateVariableUpdates = 2;
+  constexpr unsigned numberOfSlipRateUpdates = 5;
+
+  real const f0 = m_parameters.rsF0;
+  real const a = m_parameters.rsA;
+  real const b = m_parameters.rsB;
+  real const sl0 = m_parameters.rsSl0;
+  real const sr0 = m_parameters.rsSr0;
+
+  // state variable after a time step of size dt with constant slip rate
+  auto updateStateVariable = [=](real stateVariable0, real slipRate, real dt) -> real {
+    real const decay = std::exp(-slipRate * dt / sl0);
+    if (SlipLaw) {
+      return sl0 / slipRate * std::pow(slipRate * stateVariable0 / sl0, decay);
+    }
+    return stateVariable0 * decay + sl0 / slipRate * (1.0 - decay);
+  };
+
+  alignas(ALIGNMENT) real slipRate[numberOfPaddedDRPoints];
+
+  for (unsigned face = 0; face < numberOfFaces; ++face) {
+    real const invZ = 1.0 / (block.waveSpeedsPlus[face].sWaveVelocity * block.waveSpeedsPlus[face].density)
+                    + 1.0 / (block.waveSpeedsMinus[face].sWaveVelocity * block.waveSpeedsMinus[face].density);
+    real const (&initialStress)[6][numberOfPaddedDRPoints] = block.initialStressInFaultCS[face];
+
+    for (unsigned timePoint = 0; timePoint < CONVERGENCE_ORDER; ++timePoint) {
+      real const dt = deltaT[timePoint];
+      real const weight = timeWeights[timePoint];
+      real const* normalStress = stresses.normalStress[face][timePoint];
+      real const* xyStress = stresses.xyStress[face][timePoint];
+      real const* xzStress = stresses.xzStress[face][timePoint];
+
+      #pragma omp simd
+      for (unsigned point = 0; point < numberOfDRPoints; ++point) {
+        real const P = normalStress[point] + initialStress[0][point];
+        real const shearXY = initialStress[3][point] + xyStress[point];
+        real const shearXZ = initialStress[5][point] + xzStress[point];
+        real const shTest = std::sqrt(shearXY * shearXY + shearXZ * shearXZ);
+        real const stateVariable0 = block.stateVariable[face][point];
+
+        // regularized rate-and-state friction (Rice & Ben-Zion 1996), solved as described by Kaneko et al. (2008)
+        real sr = std::sqrt(block.slipRate1[face][point] * block.slipRate1[face][point]
+                          + block.slipRate2[face][point] * block.slipRate2[face][point]);
+        real srMean = std::abs(sr);
+        real stateVariable = stateVariable0;
+        for (unsigned j = 0; j < numberOfStateVariableUpdates; ++j) {
+          sr = std::abs(sr);
+          stateVariable = updateStateVariable(stateVariable0, srMean, dt);
+
+          // Newton-Raphson for the slip rate with tau = tau^G - eta * V and tau = mu(V, theta) * |P|
+          real srTest = sr;
+          for (unsigned i = 0; i < numberOfSlipRateUpdates; ++i) {
+            real const tmp = 0.5 / sr0 * std::exp((f0 + b * std::log(sr0 * stateVariable / sl0)) / a);
+            real const tmp2 = tmp * srTest;
+            real const NR = -invZ * (std::abs(P) * a * std::log(tmp2 + std::sqrt(tmp2 * tmp2 + 1.0)) - shTest) - srTest;
+            real const dNR = -invZ * (std::abs(P) * a / std::sqrt(1.0 + tmp2 * tmp2) * tmp) - 1.0;
+            srTest = std::abs(srTest - NR / dNR);
+          }
+          // the next state variable update uses the mean slip rate (Kaneko 2008, step 6)
+          srMean = 0.5 * (sr + std::abs(srTest));
+          sr = std::abs(srTest);
+        }
+        stateVariable = updateStateVariable(stateVariable0, srMean, dt);
+
+        real const tmp = 0.5 * sr / sr0 * std::exp((f0 + b * std::log(sr0 * stateVariable / sl0)) / a);
+        real const mu = a * std::log(tmp + std::sqrt(tmp * tmp + 1.0));
+        real const strength = mu * P + std::abs(block.cohesion[face][point]);
+        real const tractionXY = -(shearXY / shTest) * strength - initialStress[3][point];
+        real const tractionXZ = -(shearXZ / shTest) * strength - initialStress[5][point];
+
+        real const sr1 = -invZ * (tractionXY - xyStress[point]);
+        real const sr2 = -invZ * (tractionXZ - xzStress[point]);
+
+        block.slip[face][point] += sr * dt;
+        block.slip1[face][point] += sr1 * dt;
+        block.slip2[face][point] += sr2 * dt;
+        block.slipRate1[face][point] = sr1;
+        block.slipRate2[face][point] = sr2;
+        block.stateVariable[face][point] = stateVariable;
+        block.mu[face][point] = mu;
+        block.tractionXY[face][point] = tractionXY;
+        block.tractionXZ[face][point] = tractionXZ;
+        tractionIntegralXY[face][point] += weight * tractionXY;
+        tractionIntegralXZ[face][point] += weight * tractionXZ;
+
+        slipRate[point] = sr;
+      }
+    }
+
+    for (unsigned point = 0; point < numberOfDRPoints; ++point) {
+      if (block.ruptureFront[face][point] && slipRate[point] > 0.001) {
+        block.ruptureTime[face][point] = fullUpdateTime;
+        block.ruptureFront[face][point] = false;
+      }
+      block.peakSlipRate[face][point] = std::max(block.peakSlipRate[face][point], slipRate[point]);
+    }
+  }
+}
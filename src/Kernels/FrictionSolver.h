@@ -0,0 +1,199 @@
+/**
+ * @file
+ * This file is part of SeisSol.
+ *
+ * @section LICENSE
+ * Copyright (c) 2020, SeisSol Group
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @section DESCRIPTION
+ * Layer-wise friction solver for dynamic rupture.
+ **/
+
+#ifndef KERNELS_FRICTIONSOLVER_H_
+#define KERNELS_FRICTIONSOLVER_H_
+
+#include <Initializer/typedefs.hpp>
+#include <Initializer/DynamicRupture.h>
+#include <Initializer/tree/Layer.hpp>
+#include <generated_code/tensor.h>
+
+namespace seissol {
+  namespace kernels {
+    class FrictionSolver;
+  }
+}
+
+/**
+ * Evaluates the friction law for blocks of dynamic rupture faces of a layer.
+ *
+ * The parameters and the state of the fault are stored per Gauss point in the dynamic rupture tree
+ * (structure of arrays), such that the loops over the Gauss points of the faces vectorize.
+ * The implementation follows Evaluate_friction_law.f90.
+ **/
+class seissol::kernels::FrictionSolver {
+  public:
+    //! Supported friction laws, the values match EQN%FL of the Fortran implementation
+    enum class Law : int {
+      NoFault = 0,
+      LinearSlipWeakening = 2,
+      RateAndStateAgingLaw = 3,
+      RateAndStateSlipLaw = 4,
+      LinearSlipWeakeningForcedRupture = 16
+    };
+
+    struct Parameters {
+      Law  law = Law::NoFault;
+      bool instantaneousHealing = false;
+      //! forced rupture decay time
+      real t0 = 0.0;
+      //! rate-and-state parameters
+      real rsF0 = 0.0;
+      real rsA = 0.0;
+      real rsB = 0.0;
+      real rsSl0 = 0.0;
+      real rsSr0 = 0.0;
+    };
+
+    //! Number of faces which are processed at once
+    static constexpr unsigned BlockSize = 8;
+
+    //! Godunov state (normal and shear stress) at the space-time quadrature points of a block of faces
+    struct FaultStresses {
+      alignas(ALIGNMENT) real normalStress[BlockSize][CONVERGENCE_ORDER][seissol::initializers::numberOfPaddedDRPoints];
+      alignas(ALIGNMENT) real xyStress[BlockSize][CONVERGENCE_ORDER][seissol::initializers::numberOfPaddedDRPoints];
+      alignas(ALIGNMENT) real xzStress[BlockSize][CONVERGENCE_ORDER][seissol::initializers::numberOfPaddedDRPoints];
+    };
+
+  private:
+    //! Pointers to the friction variables of the first face of a block
+    struct BlockData {
+      real (*initialStressInFaultCS)[6][seissol::initializers::numberOfPaddedDRPoints];
+      real (*cohesion)[seissol::initializers::numberOfPaddedDRPoints];
+      real (*muS)[seissol::initializers::numberOfPaddedDRPoints];
+      real (*muD)[seissol::initializers::numberOfPaddedDRPoints];
+      real (*dC)[seissol::initializers::numberOfPaddedDRPoints];
+      real (*forcedRuptureTime)[seissol::initializers::numberOfPaddedDRPoints];
+      real (*mu)[seissol::initializers::numberOfPaddedDRPoints];
+      real (*slip)[seissol::initializers::numberOfPaddedDRPoints];
+      real (*slip1)[seissol::initializers::numberOfPaddedDRPoints];
+      real (*slip2)[seissol::initializers::numberOfPaddedDRPoints];
+      real (*slipRate1)[seissol::initializers::numberOfPaddedDRPoints];
+      real (*slipRate2)[seissol::initializers::numberOfPaddedDRPoints];
+      real (*stateVariable)[seissol::initializers::numberOfPaddedDRPoints];
+      real (*tractionXY)[seissol::initializers::numberOfPaddedDRPoints];
+      real (*tractionXZ)[seissol::initializers::numberOfPaddedDRPoints];
+      real (*ruptureTime)[seissol::initializers::numberOfPaddedDRPoints];
+      real (*dynStressTime)[seissol::initializers::numberOfPaddedDRPoints];
+      real (*peakSlipRate)[seissol::initializers::numberOfPaddedDRPoints];
+      bool (*ruptureFront)[seissol::initializers::numberOfPaddedDRPoints];
+      bool (*dynStressPending)[seissol::initializers::numberOfPaddedDRPoints];
+      real* averagedSlip;
+      bool* magnitudeOutput;
+      seissol::model::IsotropicWaveSpeeds* waveSpeedsPlus;
+      seissol::model::IsotropicWaveSpeeds* waveSpeedsMinus;
+      real (*imposedStatePlus)[tensor::QInterpolated::size()];
+      real (*imposedStateMinus)[tensor::QInterpolated::size()];
+    };
+
+    Parameters m_parameters;
+
+    static BlockData loadBlock( seissol::initializers::Layer&                 layerData,
+                                seissol::initializers::DynamicRupture const*  dynRup,
+                                unsigned                                      firstFace );
+
+    void evaluateNoFault( FaultStresses const& stresses,
+                          unsigned             numberOfFaces,
+                          double const         timeWeights[CONVERGENCE_ORDER],
+                          BlockData&           block,
+                          real                 tractionIntegralXY[BlockSize][seissol::initializers::numberOfPaddedDRPoints],
+                          real                 tractionIntegralXZ[BlockSize][seissol::initializers::numberOfPaddedDRPoints] );
+
+    template<bool ForcedRupture>
+    void evaluateLinearSlipWeakening( FaultStresses const& stresses,
+                                      unsigned             numberOfFaces,
+                                      real                 fullUpdateTime,
+                                      real const           deltaT[CONVERGENCE_ORDER],
+                                      double const         timeWeights[CONVERGENCE_ORDER],
+                                      BlockData&           block,
+                                      real                 tractionIntegralXY[BlockSize][seissol::initializers::numberOfPaddedDRPoints],
+                                      real                 tractionIntegralXZ[BlockSize][seissol::initializers::numberOfPaddedDRPoints] );
+
+    template<bool SlipLaw>
+    void evaluateRateAndState( FaultStresses const& stresses,
+                               unsigned             numberOfFaces,
+                               real                 fullUpdateTime,
+                               real const           deltaT[CONVERGENCE_ORDER],
+                               double const         timeWeights[CONVERGENCE_ORDER],
+                               BlockData&           block,
+                               real                 tractionIntegralXY[BlockSize][seissol::initializers::numberOfPaddedDRPoints],
+                               real                 tractionIntegralXZ[BlockSize][seissol::initializers::numberOfPaddedDRPoints] );
+
+  public:
+    //! Returns true if the friction law (EQN%FL) is implemented by the friction solver
+    static bool isSupported(int frictionLaw);
+
+    void setParameters(Parameters const& parameters) {
+      m_parameters = parameters;
+    }
+
+    Parameters const& getParameters() const {
+      return m_parameters;
+    }
+
+    /**
+     * Computes the Godunov state of a single face, stores it at position blockFace of the stresses and
+     * initializes the imposed states with all terms which do not depend on the fault tractions.
+     **/
+    void computeFaultStresses( unsigned                                    blockFace,
+                               real const                                  QInterpolatedPlus[CONVERGENCE_ORDER][tensor::QInterpolated::size()],
+                               real const                                  QInterpolatedMinus[CONVERGENCE_ORDER][tensor::QInterpolated::size()],
+                               seissol::model::IsotropicWaveSpeeds const&  waveSpeedsPlus,
+                               seissol::model::IsotropicWaveSpeeds const&  waveSpeedsMinus,
+                               double const                                timeWeights[CONVERGENCE_ORDER],
+                               FaultStresses&                              stresses,
+                               real                                        imposedStatePlus[tensor::QInterpolated::size()],
+                               real                                        imposedStateMinus[tensor::QInterpolated::size()] );
+
+    /**
+     * Evaluates the friction law for the faces [firstFace, firstFace+numberOfFaces) of the layer and
+     * completes their imposed states.
+     * The Godunov state of the faces has to be stored in the stresses by computeFaultStresses.
+     **/
+    void evaluate( seissol::initializers::Layer&                 layerData,
+                   seissol::initializers::DynamicRupture const*  dynRup,
+                   unsigned                                      firstFace,
+                   unsigned                                      numberOfFaces,
+                   FaultStresses const&                          stresses,
+                   double                                        fullUpdateTime,
+                   double const                                  timePoints[CONVERGENCE_ORDER],
+                   double const                                  timeWeights[CONVERGENCE_ORDER] );
+};
+
+#endif
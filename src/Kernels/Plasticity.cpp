@@ -44,8 +44,13 @@
 #include <cstring>
 #include <algorithm>
 #include <cmath>
+#include <limits>
+#include <sstream>
+#include <string>
 #include <generated_code/kernel.h>
 #include <generated_code/init.h>
+#include <utils/env.h>
+#include <utils/logger.h>
 
 unsigned seissol::kernels::Plasticity::computePlasticity( double                      relaxTime,
                                                       double                      timeStepWidth,
@@ -146,6 +151,119 @@ unsigned seissol::kernels::Plasticity::computePlasticity( double
   return 0;
 }
 
+seissol::kernels::Plasticity::ScreeningBounds seissol::kernels::Plasticity::computeScreeningBounds( GlobalData const* global )
+{
+  ScreeningBounds bounds;
+  bounds.enabled = utils::Env::get<bool>("SEISSOL_PLASTICITY_SCREENING", true);
+
+  // Evaluates every basis function at the nodes with the kernel of computePlasticity,
+  // such that the bounds do not depend on the layout of the Vandermonde matrix
+  real QStress[tensor::Q::size()] __attribute__((aligned(ALIGNMENT)));
+  real QStressNodal[tensor::QStressNodal::size()] __attribute__((aligned(ALIGNMENT)));
+  real const initialLoading[6] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+  std::fill(QStress, QStress + tensor::Q::size(), 0.0);
+
+  kernel::plConvertToNodal m2nKrnl;
+  m2nKrnl.v = global->vandermondeMatrix;
+  m2nKrnl.QStress = QStress;
+  m2nKrnl.QStressNodal = QStressNodal;
+  m2nKrnl.replicateInitialLoading = init::replicateInitialLoading::Values;
+  m2nKrnl.initialLoading = initialLoading;
+
+  for (unsigned basis = 0; basis < NUMBER_OF_BASIS_FUNCTIONS; ++basis) {
+    QStress[basis] = 1.0;
+    m2nKrnl.execute();
+    QStress[basis] = 0.0;
+
+    real minimum = std::numeric_limits<real>::max();
+    real maximum = -std::numeric_limits<real>::max();
+    bounds.maxAbsBasis[basis] = 0.0;
+    for (unsigned ip = 0; ip < tensor::yieldFactor::size(); ++ip) {
+      minimum = std::min(minimum, QStressNodal[ip]);
+      maximum = std::max(maximum, QStressNodal[ip]);
+      bounds.maxAbsBasis[basis] = std::max(bounds.maxAbsBasis[basis], std::abs(QStressNodal[ip]));
+    }
+    if (basis == 0) {
+      bounds.constantMode = maximum;
+      // the bound splits off the constant mode
+      if (maximum - minimum > 100 * std::numeric_limits<real>::epsilon() * std::abs(maximum)) {
+        bounds.enabled = false;
+      }
+    }
+  }
+
+  return bounds;
+}
+
+bool seissol::kernels::Plasticity::skipPlasticity( GlobalData const*           global,
+                                                   PlasticityData const*       plasticityData,
+                                                   real const*                 degreesOfFreedom )
+{
+  if (!plasticityData->evaluate) {
+    return true;
+  }
+
+  static ScreeningBounds const bounds = computeScreeningBounds(global);
+  if (!bounds.enabled) {
+    return false;
+  }
+
+  // @todo multiple sims
+  real center[6];
+  real radius[6];
+  for (unsigned q = 0; q < 6; ++q) {
+    real const* stress = degreesOfFreedom + q * NUMBER_OF_ALIGNED_BASIS_FUNCTIONS;
+    center[q] = bounds.constantMode * stress[0] + plasticityData->initialLoading[q];
+    radius[q] = 0.0;
+    for (unsigned basis = 1; basis < NUMBER_OF_BASIS_FUNCTIONS; ++basis) {
+      radius[q] += bounds.maxAbsBasis[basis] * std::abs(stress[basis]);
+    }
+  }
+
+  // lower bound of taulim at all nodes
+  real const meanStress = (center[0] + center[1] + center[2]) / 3.0;
+  real const meanStressRadius = (radius[0] + radius[1] + radius[2]) / 3.0;
+  real const taulim = plasticityData->cohesionTimesCosAngularFriction
+                    - meanStress * plasticityData->sinAngularFriction
+                    - meanStressRadius * std::abs(plasticityData->sinAngularFriction);
+
+  // upper bound of tau at all nodes (triangle inequality for the square root of the second invariant)
+  real const secondInvariant = 0.5 * ( (center[0] - meanStress) * (center[0] - meanStress)
+                                     + (center[1] - meanStress) * (center[1] - meanStress)
+                                     + (center[2] - meanStress) * (center[2] - meanStress) )
+                             + center[3] * center[3] + center[4] * center[4] + center[5] * center[5];
+  real const secondInvariantRadius = 0.5 * (radius[0] * radius[0] + radius[1] * radius[1] + radius[2] * radius[2])
+                                   + radius[3] * radius[3] + radius[4] * radius[4] + radius[5] * radius[5];
+  real const tau = std::sqrt(secondInvariant) + std::sqrt(secondInvariantRadius);
+
+  // margin for the rounding errors of the nodal evaluation
+  return tau < taulim * (1.0 - 1000 * std::numeric_limits<real>::epsilon());
+}
+
+std::vector<double> seissol::kernels::Plasticity::regionFromEnvironment()
+{
+  std::vector<double> region;
+  std::string bounds = utils::Env::get<std::string>("SEISSOL_PLASTICITY_REGION", "");
+  if (bounds.empty()) {
+    return region;
+  }
+
+  std::stringstream stream(bounds);
+  std::string entry;
+  while (std::getline(stream, entry, ',')) {
+    double value = 0.0;
+    std::stringstream valueStream(entry);
+    if (!(valueStream >> value)) {
+      logError() << "Invalid bound of SEISSOL_PLASTICITY_REGION:" << entry;
+    }
+    region.push_back(value);
+  }
+  if (region.size() != 6) {
+    logError() << "SEISSOL_PLASTICITY_REGION requires 6 bounds (xmin,xmax,ymin,ymax,zmin,zmax), got" << region.size();
+  }
+  return region;
+}
+
 void seissol::kernels::Plasticity::flopsPlasticity( long long&  o_NonZeroFlopsCheck,
                                                     long long&  o_HardwareFlopsCheck,
                                                     long long&  o_NonZeroFlopsYield,
@@ -181,3 +299,13 @@ void seissol::kernels::Plasticity::flopsPlasticity( long long&  o_NonZeroFlopsCh
   o_NonZeroFlopsYield  += kernel::plAdjustStresses::NonZeroFlops;
   o_HardwareFlopsYield += kernel::plAdjustStresses::HardwareFlops;
 }
+
+void seissol::kernels::Plasticity::flopsScreening( long long&  o_nonZeroFlops,
+                                                   long long&  o_hardwareFlops )
+{
+  // center (2 per stress component) and radius (2 per higher mode and stress component)
+  o_nonZeroFlops = 6 * 2 + 6 * 2 * (NUMBER_OF_BASIS_FUNCTIONS - 1);
+  // mean stress, taulim and tau (square roots counted as one flop)
+  o_nonZeroFlops += 3 + 3 + 5 + 15 + 12 + 3;
+  o_hardwareFlops = o_nonZeroFlops;
+}
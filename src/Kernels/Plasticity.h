@@ -45,6 +45,8 @@
 #include <Initializer/typedefs.hpp>
 #include <generated_code/tensor.h>
 
+#include <vector>
+
 namespace seissol {
   namespace kernels {
     class Plasticity;
@@ -62,10 +64,42 @@ public:
                                      real                        degreesOfFreedom[tensor::Q::size()],
                                      real*                       pstrain);
 
+  /**
+   * Returns true if computePlasticity would not change the cell, without converting the stresses to nodal values.
+   *
+   * This is the case if the cell lies outside of the plastic region or if a bound of the Drucker-Prager criterion
+   * in modal space guarantees that no node yields: the nodal stresses deviate from the constant mode by at most
+   * sum_k max_i |V_ik| |Q_k| (k > 0), which bounds the mean stress and the square root of the second invariant at
+   * all nodes.
+   */
+  static bool skipPlasticity( GlobalData const*           global,
+                              PlasticityData const*       plasticityData,
+                              real const*                 degreesOfFreedom );
+
+  /**
+   * Returns the bounds (xmin, xmax, ymin, ymax, zmin, zmax) of SEISSOL_PLASTICITY_REGION or an empty vector if the
+   * plasticity is evaluated everywhere.
+   */
+  static std::vector<double> regionFromEnvironment();
+
   static void flopsPlasticity(  long long&  o_nonZeroFlopsCheck,
                                 long long&  o_hardwareFlopsCheck,
                                 long long&  o_nonZeroFlopsYield,
                                 long long&  o_hardwareFlopsYield );
+
+  static void flopsScreening( long long&  o_nonZeroFlops,
+                              long long&  o_hardwareFlops );
+
+private:
+  struct ScreeningBounds {
+    bool enabled;
+    //! value of the constant basis function at the nodes
+    real constantMode;
+    //! maximum absolute value of every basis function at the nodes
+    real maxAbsBasis[NUMBER_OF_BASIS_FUNCTIONS];
+  };
+
+  static ScreeningBounds computeScreeningBounds( GlobalData const* global );
 };
 
 #endif
@@ -45,6 +45,8 @@
 #include <Monitoring/FlopCounter.hpp>
 #include <generated_code/kernel.h>
 
+#include <algorithm>
+
 void seissol::kernels::ReceiverCluster::addReceiver(  unsigned                          meshId,
                                                       unsigned                          pointId,
                                                       Eigen::Vector3d const&            point,
@@ -60,66 +62,105 @@ void seissol::kernels::ReceiverCluster::addReceiver(  unsigned
   }
   auto xiEtaZeta = seissol::transformations::tetrahedronGlobalToReference(coords[0], coords[1], coords[2], coords[3], point);
 
+  basisFunction::SampledBasisFunctions<real> basisFunctions(CONVERGENCE_ORDER, xiEtaZeta[0], xiEtaZeta[1], xiEtaZeta[2]);
+
+  auto cellId = m_cellIds.find(meshId);
+  if (cellId == m_cellIds.end()) {
+    cellId = m_cellIds.emplace(meshId, m_cells.size()).first;
+    m_cells.emplace_back(kernels::LocalData::lookup(lts, ltsLut, meshId));
+  }
+  ReceiverCell& cell = m_cells[cellId->second];
+
+  // Receivers are evaluated in batches; a new batch starts with vanishing basis functions
+  unsigned const receiversPerBatch = tensor::basisFunctionsAtPoints::Shape[1];
+  unsigned const batch = cell.receivers.size() / receiversPerBatch;
+  unsigned const receiverInBatch = cell.receivers.size() % receiversPerBatch;
+  if (receiverInBatch == 0) {
+    cell.basisFunctions.resize((batch+1) * tensor::basisFunctionsAtPoints::size(), 0.0);
+  }
+  auto basisFunctionsAtPoints = init::basisFunctionsAtPoints::view::create(&cell.basisFunctions[batch * tensor::basisFunctionsAtPoints::size()]);
+  for (unsigned k = 0; k < basisFunctions.m_data.size(); ++k) {
+    basisFunctionsAtPoints(k, receiverInBatch) = basisFunctions.m_data[k];
+  }
+  cell.receivers.push_back(m_receivers.size());
+
   // (time + number of quantities) * number of samples until sync point
   size_t reserved = ncols() * (m_syncPointInterval / m_samplingInterval + 1);
-  m_receivers.emplace_back( pointId,
-                            xiEtaZeta[0],
-                            xiEtaZeta[1],
-                            xiEtaZeta[2],
-                            kernels::LocalData::lookup(lts, ltsLut, meshId),
-                            reserved);
+  m_receivers.emplace_back(pointId, reserved);
 }
 
 double seissol::kernels::ReceiverCluster::calcReceivers(  double time,
                                                           double expansionPoint,
                                                           double timeStepWidth ) {
-  real timeEvaluated[tensor::Q::size()] __attribute__((aligned(ALIGNMENT)));
+  constexpr unsigned samplesPerBatch = tensor::QAtTimes::Shape[sizeof(tensor::QAtTimes::Shape) / sizeof(tensor::QAtTimes::Shape[0]) - 1];
+  static_assert(tensor::QAtTimes::size() == samplesPerBatch * tensor::Q::size(), "The time slices of QAtTimes must match the layout of Q.");
+  unsigned const receiversPerBatch = tensor::basisFunctionsAtPoints::Shape[1];
+
+  real timeEvaluated[tensor::QAtTimes::size()] __attribute__((aligned(ALIGNMENT))) = {};
   real timeDerivatives[yateto::computeFamilySize<tensor::dQ>()] __attribute__((aligned(ALIGNMENT)));
-  real timeEvaluatedAtPoint[tensor::QAtPoint::size()] __attribute__((aligned(ALIGNMENT)));
+  real timeEvaluatedAtPoints[tensor::QAtPoints::size()] __attribute__((aligned(ALIGNMENT)));
 
   kernels::LocalTmp tmp;
 
-  kernel::evaluateDOFSAtPoint krnl;
-  krnl.QAtPoint = timeEvaluatedAtPoint;
-  krnl.Q = timeEvaluated;
+  kernel::evaluateDOFSAtPoints krnl;
+  krnl.QAtPoints = timeEvaluatedAtPoints;
+  krnl.QAtTimes = timeEvaluated;
 
-  auto qAtPoint = init::QAtPoint::view::create(timeEvaluatedAtPoint);
+  auto qAtPoints = init::QAtPoints::view::create(timeEvaluatedAtPoints);
 
   double receiverTime = time;
-  if (time >= expansionPoint && time < expansionPoint + timeStepWidth) {
-    for (auto& receiver : m_receivers) {
-      krnl.basisFunctionsAtPoint = receiver.basisFunctions.m_data.data();
+  if (time >= expansionPoint && time < expansionPoint + timeStepWidth && !m_receivers.empty()) {
+    std::vector<double> sampleTimes;
+    while (receiverTime < expansionPoint + timeStepWidth) {
+      sampleTimes.push_back(receiverTime);
+      receiverTime += m_samplingInterval;
+    }
 
+    for (auto& cell : m_cells) {
+      // The derivatives are shared by all receivers in the cell
       m_timeKernel.computeAder( timeStepWidth,
-                                receiver.data,
+                                cell.data,
                                 tmp,
                                 timeEvaluated, // useless but the interface requires it
                                 timeDerivatives );
       g_SeisSolNonZeroFlopsOther += m_nonZeroFlops;
       g_SeisSolHardwareFlopsOther += m_hardwareFlops;
 
-      receiverTime = time;
-      while (receiverTime < expansionPoint + timeStepWidth) {
-        m_timeKernel.computeTaylorExpansion(receiverTime, expansionPoint, timeDerivatives, timeEvaluated);
-        krnl.execute();
+      for (unsigned firstSample = 0; firstSample < sampleTimes.size(); firstSample += samplesPerBatch) {
+        unsigned const numberOfSamples = std::min<unsigned>(samplesPerBatch, sampleTimes.size() - firstSample);
+        for (unsigned sample = 0; sample < numberOfSamples; ++sample) {
+          m_timeKernel.computeTaylorExpansion(sampleTimes[firstSample + sample], expansionPoint, timeDerivatives, &timeEvaluated[sample * tensor::Q::size()]);
+        }
+        g_SeisSolNonZeroFlopsOther += numberOfSamples * m_taylorNonZeroFlops;
+        g_SeisSolHardwareFlopsOther += numberOfSamples * m_taylorHardwareFlops;
+
+        for (unsigned firstReceiver = 0; firstReceiver < cell.receivers.size(); firstReceiver += receiversPerBatch) {
+          krnl.basisFunctionsAtPoints = &cell.basisFunctions[(firstReceiver / receiversPerBatch) * tensor::basisFunctionsAtPoints::size()];
+          krnl.execute();
+          g_SeisSolNonZeroFlopsOther += kernel::evaluateDOFSAtPoints::NonZeroFlops;
+          g_SeisSolHardwareFlopsOther += kernel::evaluateDOFSAtPoints::HardwareFlops;
 
-        receiver.output.push_back(receiverTime);
+          unsigned const numberOfReceivers = std::min<unsigned>(receiversPerBatch, cell.receivers.size() - firstReceiver);
+          for (unsigned r = 0; r < numberOfReceivers; ++r) {
+            auto& receiver = m_receivers[ cell.receivers[firstReceiver + r] ];
+            for (unsigned sample = 0; sample < numberOfSamples; ++sample) {
+              receiver.output.push_back(sampleTimes[firstSample + sample]);
 #ifdef MULTIPLE_SIMULATIONS
-        for (unsigned sim = init::QAtPoint::Start[0]; sim < init::QAtPoint::Stop[0]; ++sim) {
-          for (auto quantity : m_quantities) {
-            receiver.output.push_back(qAtPoint(sim, quantity));
-          }
-        }
+              for (unsigned sim = init::QAtPoints::Start[0]; sim < init::QAtPoints::Stop[0]; ++sim) {
+                for (auto quantity : m_quantities) {
+                  receiver.output.push_back(qAtPoints(sim, quantity, r, sample));
+                }
+              }
 #else
-        for (auto quantity : m_quantities) {
-          receiver.output.push_back(qAtPoint(quantity));
-        }
+              for (auto quantity : m_quantities) {
+                receiver.output.push_back(qAtPoints(quantity, r, sample));
+              }
 #endif
-
-        receiverTime += m_samplingInterval;
+            }
+          }
+        }
       }
     }
   }
   return receiverTime;
 }
-
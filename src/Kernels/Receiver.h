@@ -41,6 +41,7 @@
 #define KERNELS_RECEIVER_H_
 
 #include <vector>
+#include <unordered_map>
 #include <Eigen/Dense>
 #include <Geometry/MeshReader.h>
 #include <Numerical_aux/BasisFunction.h>
@@ -55,23 +56,32 @@ class GlobalData;
 namespace seissol {
   namespace kernels {
     struct Receiver {
-      Receiver(unsigned pointId, double xi, double eta, double zeta, kernels::LocalData data, size_t reserved)
-        : pointId(pointId),
-          basisFunctions(CONVERGENCE_ORDER, xi, eta, zeta),
-          data(data)
+      Receiver(unsigned pointId, size_t reserved)
+        : pointId(pointId)
       {
         output.reserve(reserved);
       }
       unsigned pointId;
-      basisFunction::SampledBasisFunctions<real> basisFunctions;
-      kernels::LocalData data;
       std::vector<real> output;
     };
 
+    //! All receivers which lie in the same cell share the time prediction
+    struct ReceiverCell {
+      explicit ReceiverCell(kernels::LocalData data)
+        : data(data)
+      {}
+      kernels::LocalData data;
+      //! Indices of the receivers in the cluster
+      std::vector<unsigned> receivers;
+      //! Basis functions at the receivers, zero-padded to full batches of init::basisFunctionsAtPoints
+      std::vector<real> basisFunctions;
+    };
+
     class ReceiverCluster {
     public:
       ReceiverCluster()
         : m_nonZeroFlops(0), m_hardwareFlops(0),
+          m_taylorNonZeroFlops(0), m_taylorHardwareFlops(0),
           m_samplingInterval(1.0e99), m_syncPointInterval(0.0)
       {}
 
@@ -83,6 +93,7 @@ namespace seissol {
           m_samplingInterval(samplingInterval), m_syncPointInterval(syncPointInterval) {
         m_timeKernel.setHostGlobalData(global);
         m_timeKernel.flopsAder(m_nonZeroFlops, m_hardwareFlops);
+        m_timeKernel.flopsTaylorExpansion(m_taylorNonZeroFlops, m_taylorHardwareFlops);
       }
 
       void addReceiver( unsigned          meshId,
@@ -115,10 +126,15 @@ namespace seissol {
 
     private:
       std::vector<Receiver>   m_receivers;
+      std::vector<ReceiverCell> m_cells;
+      //! Maps the mesh id to the index in m_cells
+      std::unordered_map<unsigned, unsigned> m_cellIds;
       seissol::kernels::Time  m_timeKernel;
       std::vector<unsigned>   m_quantities;
       unsigned                m_nonZeroFlops;
       unsigned                m_hardwareFlops;
+      long long               m_taylorNonZeroFlops;
+      long long               m_taylorHardwareFlops;
       double                  m_samplingInterval;
       double                  m_syncPointInterval;
     };
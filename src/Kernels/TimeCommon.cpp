@@ -40,6 +40,7 @@
 
 #include "TimeCommon.h"
 #include <stdint.h>
+#include <utility>
 
 void seissol::kernels::TimeCommon::computeIntegrals(Time& i_time,
                                                     unsigned short i_ltsSetup,
@@ -151,6 +152,28 @@ void seissol::kernels::TimeCommon::computeBatchedIntegrals(Time& i_time,
                                   (entry.content[*EntityId::Idofs])->getSize());
   }
 #else
-  assert(false && "no implementation provided");
+  // the expansion point is 'i_timeStepStart' for neighbours with the GTS relation and '0' for the LTS relation
+  std::pair<ComputationKind, double> const kinds[] = { {ComputationKind::WithGtsDerivatives, i_timeStepStart},
+                                                       {ComputationKind::WithLtsDerivatives, 0.0} };
+  for (auto const& kind : kinds) {
+    ConditionalKey key(*KernelNames::NeighborFlux, *kind.first);
+    auto found = table.find(key);
+    if (found != table.end()) {
+      BatchTable &entry = found->second;
+      const unsigned numElements = (entry.content[*EntityId::Idofs])->getSize();
+      real** derivatives = (entry.content[*EntityId::Derivatives])->getPointers();
+      real** idofs = (entry.content[*EntityId::Idofs])->getPointers();
+#ifdef _OPENMP
+      #pragma omp parallel for schedule(static)
+#endif
+      for (unsigned element = 0; element < numElements; ++element) {
+        i_time.computeIntegral(kind.second,
+                               i_timeStepStart,
+                               i_timeStepStart + i_timeStepWidth,
+                               derivatives[element],
+                               idofs[element]);
+      }
+    }
+  }
 #endif
 }
@@ -30,4 +30,20 @@ typedef double real;
 #endif
 #endif
 
+/*
+ * Type of the time-integrated buffers and derivatives in the messages of the ghost and copy layers.
+ * With USE_SINGLE_PRECISION_COMMUNICATION, double precision builds communicate them in single precision.
+ */
+#if defined(USE_SINGLE_PRECISION_COMMUNICATION) && defined(DOUBLE_PRECISION)
+typedef float comm_real;
+#ifdef USE_MPI
+#define MPI_C_COMM_REAL MPI_FLOAT
+#endif
+#else
+typedef real comm_real;
+#ifdef USE_MPI
+#define MPI_C_COMM_REAL MPI_C_REAL
+#endif
+#endif
+
 #endif
@@ -60,6 +60,8 @@ long long g_SeisSolNonZeroFlopsDynamicRupture = 0;
 long long g_SeisSolHardwareFlopsDynamicRupture = 0;
 long long g_SeisSolNonZeroFlopsPlasticity = 0;
 long long g_SeisSolHardwareFlopsPlasticity = 0;
+long long g_SeisSolPlasticityEvaluatedCells = 0;
+long long g_SeisSolPlasticitySkippedCells = 0;
 
 // prevent name mangling
 extern "C" {
@@ -87,6 +89,8 @@ extern "C" {
       DRHardwareFlops,
       PLNonZeroFlops,
       PLHardwareFlops,
+      PLEvaluatedCells,
+      PLSkippedCells,
       NUM_COUNTERS
     };
     
@@ -99,6 +103,8 @@ extern "C" {
     flops[DRHardwareFlops]  = g_SeisSolHardwareFlopsDynamicRupture;
     flops[PLNonZeroFlops]   = g_SeisSolNonZeroFlopsPlasticity;
     flops[PLHardwareFlops]  = g_SeisSolHardwareFlopsPlasticity;
+    flops[PLEvaluatedCells] = g_SeisSolPlasticityEvaluatedCells;
+    flops[PLSkippedCells]   = g_SeisSolPlasticitySkippedCells;
 
 #ifdef USE_MPI
     double totalFlops[NUM_COUNTERS];
@@ -116,5 +122,10 @@ extern "C" {
     logInfo(rank) << "DR calculated NZ-GFLOP: " << (totalFlops[DRNonZeroFlops])  * 1.e-9;
     logInfo(rank) << "PL calculated HW-GFLOP: " << (totalFlops[PLHardwareFlops]) * 1.e-9;
     logInfo(rank) << "PL calculated NZ-GFLOP: " << (totalFlops[PLNonZeroFlops])  * 1.e-9;
+    if (totalFlops[PLEvaluatedCells] + totalFlops[PLSkippedCells] > 0) {
+      logInfo(rank) << "PL evaluated cell updates:" << totalFlops[PLEvaluatedCells];
+      logInfo(rank) << "PL skipped cell updates:" << totalFlops[PLSkippedCells];
+      logInfo(rank) << "PL skipped fraction:" << totalFlops[PLSkippedCells] / (totalFlops[PLEvaluatedCells] + totalFlops[PLSkippedCells]);
+    }
   }
 }
@@ -58,6 +58,10 @@ extern long long g_SeisSolHardwareFlopsDynamicRupture;
 extern long long g_SeisSolNonZeroFlopsPlasticity;
 extern long long g_SeisSolHardwareFlopsPlasticity;
 
+// number of cell updates which evaluated or skipped the plasticity
+extern long long g_SeisSolPlasticityEvaluatedCells;
+extern long long g_SeisSolPlasticitySkippedCells;
+
 extern "C" {
   void printNodePerformance(double wallTime);
   void printFlops();
@@ -39,6 +39,7 @@
  
 #include "LoopStatistics.h"
 
+#include <algorithm>
 #include <cmath>
 #ifdef USE_NETCDF
 #include <netcdf.h>
@@ -144,6 +145,71 @@ void seissol::LoopStatistics::printSummary(MPI_Comm comm) {
     }
 
     logInfo(rank) << "Total time spent in compute kernels:" << totalTime;
+
+    // the local and neighboring integration are sampled once per layer (copy and interior) of a cluster update
+    double elementCost = 0.0, clusterOverhead = 0.0;
+    for (unsigned region = 0; region < nRegions; ++region) {
+      if (m_regions[region] == "computeLocalIntegration" || m_regions[region] == "computeNeighboringIntegration") {
+        clusterOverhead += 2.0 * std::max(regressionCoeffs[2 * region + 0], 0.0);
+        elementCost += regressionCoeffs[2 * region + 1];
+      }
+    }
+    logInfo(rank) << "Calibration of the LTS cost model: SEISSOL_LTS_ELEMENT_COST=" << utils::nospace << elementCost
+                  << utils::space << "SEISSOL_LTS_CLUSTER_OVERHEAD=" << utils::nospace << clusterOverhead;
+  }
+
+  printCounterSummary(comm);
+}
+
+std::vector<double> seissol::LoopStatistics::reduceSamples(MPI_Comm comm, bool contribute, unsigned& nClusters) const {
+  int rank;
+  MPI_Comm_rank(comm, &rank);
+
+  nClusters = getNumberOfClusters();
+  MPI_Allreduce(MPI_IN_PLACE, &nClusters, 1, MPI_UNSIGNED, MPI_MAX, comm);
+
+  auto sums = contribute ? sumSamples(nClusters) : std::vector<double>(NumSummedValues * m_times.size() * nClusters, 0.0);
+  MPI_Reduce(rank == 0 ? MPI_IN_PLACE : sums.data(), sums.data(), sums.size(), MPI_DOUBLE, MPI_SUM, 0, comm);
+  return sums;
+}
+
+void seissol::LoopStatistics::printCounterSummary(MPI_Comm comm) {
+  int rank;
+  MPI_Comm_rank(comm, &rank);
+
+  int numberOfRanksWithCounters = m_counters.isEnabled() ? 1 : 0;
+  MPI_Allreduce(MPI_IN_PLACE, &numberOfRanksWithCounters, 1, MPI_INT, MPI_SUM, comm);
+  if (numberOfRanksWithCounters == 0) {
+    return;
+  }
+
+  unsigned const nRegions = m_times.size();
+  unsigned const nValues = NumSummedValues;
+  unsigned nClusters;
+  // time, elements and counters per region and cluster, only of the ranks with counters
+  auto sums = reduceSamples(comm, m_counters.isEnabled(), nClusters);
+
+  if (rank == 0) {
+    logInfo(rank) << "Performance counters of the compute kernels (" << utils::nospace << numberOfRanksWithCounters
+                  << utils::space << "ranks, memory traffic estimated from the last level cache misses):";
+    for (unsigned region = 0; region < nRegions; ++region) {
+      for (unsigned cluster = 0; cluster < nClusters; ++cluster) {
+        double const* values = &sums[nValues * (region * nClusters + cluster)];
+        if (values[1] == 0.0 || values[2 + PerformanceCounters::Cycles] == 0.0) {
+          continue;
+        }
+        double const instructionsPerCycle = values[2 + PerformanceCounters::Instructions] / values[2 + PerformanceCounters::Cycles];
+        double const bytes = PerformanceCounters::BytesPerMiss * values[2 + PerformanceCounters::LlcMisses];
+        // the time is summed over the ranks, hence the bandwidth is the mean per rank
+        double const bandwidth = bytes / values[0] * 1.0e-9;
+        logInfo(rank) << m_regions[region] << "(cluster" << cluster << utils::nospace << "):" << utils::space
+                      << "IPC" << instructionsPerCycle
+                      << ", cycles per element" << values[2 + PerformanceCounters::Cycles] / values[1]
+                      << ", LLC misses per element" << values[2 + PerformanceCounters::LlcMisses] / values[1]
+                      << ", bytes per element" << bytes / values[1]
+                      << ", bandwidth per rank" << bandwidth << "GB/s";
+      }
+    }
   }
 }
 #endif
@@ -183,6 +249,10 @@ void seissol::LoopStatistics::writeSamples() {
       {
         stat = nc_insert_compound(ncid, sampletyp, "time", NC_COMPOUND_OFFSET(Sample,time), NC_DOUBLE);   check_err(stat,__LINE__,__FILE__);
         stat = nc_insert_compound(ncid, sampletyp, "loopLength", NC_COMPOUND_OFFSET(Sample,numIters), NC_UINT); check_err(stat,__LINE__,__FILE__);
+        stat = nc_insert_compound(ncid, sampletyp, "cluster", NC_COMPOUND_OFFSET(Sample,cluster), NC_UINT); check_err(stat,__LINE__,__FILE__);
+        for (unsigned counter = 0; counter < PerformanceCounters::NumCounters; ++counter) {
+          stat = nc_insert_compound(ncid, sampletyp, PerformanceCounters::name(counter), NC_COMPOUND_OFFSET(Sample,counters) + counter * sizeof(std::uint64_t), NC_UINT64); check_err(stat,__LINE__,__FILE__);
+        }
       }
       
       stat = nc_def_var(ncid, "offset", NC_INT,   1, &rankdim,   &offsetid); check_err(stat,__LINE__,__FILE__);
@@ -40,52 +40,160 @@
 #ifndef MONITORING_LOOPSTATISTICS_H_
 #define MONITORING_LOOPSTATISTICS_H_
 
+#include <algorithm>
 #include <unordered_map>
 #include <fstream>
 #include <iomanip>
 #include <utils/env.h>
 
 #include "Stopwatch.h"
+#include "PerformanceCounters.h"
 
 namespace seissol {
 class LoopStatistics {
 public:
+  struct Sample {
+    double time;
+    unsigned numIters;
+    unsigned cluster;
+    //! zero if the counters are disabled
+    std::uint64_t counters[PerformanceCounters::NumCounters] = {};
+  };
+
+  //! time, number of elements and counters
+  static constexpr unsigned NumSummedValues = 2 + PerformanceCounters::NumCounters;
+
   void addRegion(std::string const& name) {
     m_regions.push_back(name);
     m_stopwatch.push_back(Stopwatch());
+    m_counterStart.push_back(PerformanceCounters::Values());
     m_times.push_back(std::vector<Sample>());
   }
+
+  /**
+   * Records the hardware performance counters of all threads between begin and end.
+   * Must be called outside of parallel regions; samples added with addSample have no counters.
+   *
+   * @return false if the counters are not available.
+   */
+  bool enableCounters() {
+    return m_counters.open();
+  }
   
-  unsigned getRegion(std::string const& name) {
+  unsigned getRegion(std::string const& name) const {
     auto first = m_regions.cbegin();
     auto it = std::find(first, m_regions.cend(), name);
     return std::distance(first, it);
   }
   
   void begin(unsigned region) {
+    if (m_counters.isEnabled()) {
+      m_counters.read(m_counterStart[region]);
+    }
     m_stopwatch[region].start();
   }
   
-  void end(unsigned region, unsigned numIterations) {
+  void end(unsigned region, unsigned numIterations, unsigned cluster = 0) {
     Sample sample;
     sample.time = m_stopwatch[region].stop();
     sample.numIters = numIterations;
+    sample.cluster = cluster;
+    if (m_counters.isEnabled()) {
+      PerformanceCounters::Values counters;
+      m_counters.read(counters);
+      for (unsigned counter = 0; counter < PerformanceCounters::NumCounters; ++counter) {
+        sample.counters[counter] = counters[counter] - m_counterStart[region][counter];
+      }
+    }
     m_times[region].push_back(sample);
   }
 
+  /**
+   * Adds a sample measured outside of begin/end.
+   * Thread-safe, i.e. may be called from concurrently executed tasks.
+   */
+  void addSample(unsigned region, double time, unsigned numIterations, unsigned cluster = 0) {
+    Sample sample;
+    sample.time = time;
+    sample.numIters = numIterations;
+    sample.cluster = cluster;
+#ifdef _OPENMP
+    #pragma omp critical (LoopStatisticsSample)
+#endif
+    m_times[region].push_back(sample);
+  }
+
+  /**
+   * Returns the sum of the times of all samples of a region.
+   */
+  double getTotalTime(unsigned region) const {
+    double time = 0.0;
+    for (auto const& sample : m_times[region]) {
+      time += sample.time;
+    }
+    return time;
+  }
+
+  std::vector<Sample> const& getSamples(unsigned region) const {
+    return m_times[region];
+  }
+
+  //! 1 + the largest cluster id of the samples
+  unsigned getNumberOfClusters() const {
+    unsigned nClusters = 0;
+    for (auto const& samples : m_times) {
+      for (auto const& sample : samples) {
+        nClusters = std::max(nClusters, sample.cluster + 1);
+      }
+    }
+    return nClusters;
+  }
+
+  /**
+   * Sums up the samples per region and cluster.
+   *
+   * @param nClusters number of clusters, at least getNumberOfClusters().
+   * @return NumSummedValues values (time, number of elements, counters) for every cluster of every region,
+   *         i.e. the values of a region and cluster start at NumSummedValues * (region * nClusters + cluster).
+   */
+  std::vector<double> sumSamples(unsigned nClusters) const {
+    auto sums = std::vector<double>(NumSummedValues * m_times.size() * nClusters, 0.0);
+    for (unsigned region = 0; region < m_times.size(); ++region) {
+      for (auto const& sample : m_times[region]) {
+        double* values = &sums[NumSummedValues * (region * nClusters + sample.cluster)];
+        values[0] += sample.time;
+        values[1] += sample.numIters;
+        for (unsigned counter = 0; counter < PerformanceCounters::NumCounters; ++counter) {
+          values[2 + counter] += sample.counters[counter];
+        }
+      }
+    }
+    return sums;
+  }
+
 #ifdef USE_MPI  
   void printSummary(MPI_Comm comm);
+
+  /**
+   * Sums up the samples of all ranks on rank 0 (see sumSamples). All ranks have to use the same regions.
+   *
+   * @param contribute false if the rank adds zeros only, e.g. if its counters are disabled.
+   * @param nClusters returns the number of clusters of all ranks.
+   * @return the sums on rank 0.
+   */
+  std::vector<double> reduceSamples(MPI_Comm comm, bool contribute, unsigned& nClusters) const;
 #endif
 
   void writeSamples();
   
 private:
-  struct Sample {
-    double time;
-    unsigned numIters;
-  };
-  
+#ifdef USE_MPI
+  void printCounterSummary(MPI_Comm comm);
+#endif
+
   std::vector<Stopwatch> m_stopwatch;
+  PerformanceCounters m_counters;
+  std::vector<PerformanceCounters::Values> m_counterStart;
   std::vector<std::string> m_regions;
   std::vector<std::vector<Sample>> m_times;
 };
@@ -0,0 +1,159 @@
+/**
+ * @file
+ * This file is part of SeisSol.
+ *
+ * @section LICENSE
+ * Copyright (c) 2020, SeisSol Group
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @section DESCRIPTION
+ * Hardware performance counters of all OpenMP threads (Linux perf_event_open).
+ **/
+
+#include "PerformanceCounters.h"
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif // __linux__
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif // _OPENMP
+
+#include <cstring>
+
+seissol::PerformanceCounters::~PerformanceCounters() {
+  closeCounters();
+}
+
+void seissol::PerformanceCounters::closeCounters() {
+#ifdef __linux__
+  for (auto const& group : m_groups) {
+    for (int fd : group) {
+      if (fd >= 0) {
+        close(fd);
+      }
+    }
+  }
+#endif // __linux__
+  m_groups.clear();
+}
+
+#ifdef __linux__
+//! opens a counter of the calling thread (pid 0) on any cpu (-1)
+static int openCounter(std::uint64_t config, int groupLeader) {
+  perf_event_attr attr;
+  std::memset(&attr, 0, sizeof(attr));
+  attr.size = sizeof(attr);
+  attr.type = PERF_TYPE_HARDWARE;
+  attr.config = config;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+  return syscall(__NR_perf_event_open, &attr, 0, -1, groupLeader, 0);
+}
+#endif // __linux__
+
+bool seissol::PerformanceCounters::open() {
+#ifdef __linux__
+  // the kernel has no perf events or the system call is not permitted (e.g. filtered in containers):
+  // do not try to open the counters on every thread
+  if (access("/proc/sys/kernel/perf_event_paranoid", F_OK) != 0) {
+    return false;
+  }
+  int const probe = openCounter(PERF_COUNT_HW_CPU_CYCLES, -1);
+  if (probe < 0) {
+    return false;
+  }
+  close(probe);
+
+  unsigned numberOfThreads = 1;
+#ifdef _OPENMP
+  numberOfThreads = omp_get_max_threads();
+#endif // _OPENMP
+
+  std::vector<std::array<int, NumCounters>> groups(numberOfThreads);
+  for (auto& group : groups) {
+    group.fill(-1);
+  }
+
+  std::uint64_t const configs[NumCounters] = { PERF_COUNT_HW_CPU_CYCLES,
+                                               PERF_COUNT_HW_INSTRUCTIONS,
+                                               PERF_COUNT_HW_CACHE_MISSES };
+
+  bool success = true;
+#ifdef _OPENMP
+  #pragma omp parallel reduction(&&:success)
+#endif // _OPENMP
+  {
+    unsigned thread = 0;
+#ifdef _OPENMP
+    thread = omp_get_thread_num();
+#endif // _OPENMP
+    std::array<int, NumCounters>& group = groups[thread];
+
+    for (unsigned counter = 0; counter < NumCounters && success; ++counter) {
+      group[counter] = openCounter(configs[counter], (counter == 0) ? -1 : group[0]);
+      success = (group[counter] >= 0);
+    }
+  }
+
+  m_groups.swap(groups);
+  if (!success) {
+    closeCounters();
+  }
+  return success;
+#else
+  return false;
+#endif // __linux__
+}
+
+void seissol::PerformanceCounters::read(Values& values) const {
+  values.fill(0);
+#ifdef __linux__
+  // layout of PERF_FORMAT_GROUP: number of counters, time enabled, time running, values
+  std::uint64_t buffer[3 + NumCounters];
+  for (auto const& group : m_groups) {
+    if (::read(group[0], buffer, sizeof(buffer)) == static_cast<ssize_t>(sizeof(buffer))) {
+      double const scaling = (buffer[2] > 0) ? static_cast<double>(buffer[1]) / buffer[2] : 1.0;
+      for (unsigned counter = 0; counter < NumCounters; ++counter) {
+        values[counter] += static_cast<std::uint64_t>(buffer[3 + counter] * scaling);
+      }
+    }
+  }
+#endif // __linux__
+}
+
+char const* seissol::PerformanceCounters::name(unsigned counter) {
+  char const* names[] = { "cycles", "instructions", "llcMisses" };
+  return names[counter];
+}
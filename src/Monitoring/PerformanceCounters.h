@@ -0,0 +1,99 @@
+/**
+ * @file
+ * This file is part of SeisSol.
+ *
+ * @section LICENSE
+ * Copyright (c) 2020, SeisSol Group
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @section DESCRIPTION
+ * Hardware performance counters of all OpenMP threads (Linux perf_event_open).
+ **/
+
+#ifndef MONITORING_PERFORMANCECOUNTERS_H_
+#define MONITORING_PERFORMANCECOUNTERS_H_
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace seissol {
+  class PerformanceCounters;
+}
+
+/**
+ * Counts cycles, instructions and last level cache misses of all OpenMP threads.
+ *
+ * Every thread opens a group of counters for itself, which only counts in user space.
+ * The counters of all threads can then be read by the master thread between parallel regions.
+ **/
+class seissol::PerformanceCounters {
+public:
+  enum Counter {
+    Cycles = 0,
+    Instructions,
+    LlcMisses,
+    NumCounters
+  };
+
+  using Values = std::array<std::uint64_t, NumCounters>;
+
+  //! bytes transferred from memory per last level cache miss
+  static constexpr double BytesPerMiss = 64.0;
+
+  PerformanceCounters() = default;
+  PerformanceCounters(PerformanceCounters const&) = delete;
+  PerformanceCounters& operator=(PerformanceCounters const&) = delete;
+
+  ~PerformanceCounters();
+
+  /**
+   * Opens the counters on every OpenMP thread.
+   *
+   * @return false if the counters are not available, e.g. due to /proc/sys/kernel/perf_event_paranoid.
+   **/
+  bool open();
+
+  bool isEnabled() const { return !m_groups.empty(); }
+
+  /**
+   * Sums up the counters of all threads, scaled to the enabled time if the counters are multiplexed.
+   **/
+  void read(Values& values) const;
+
+  static char const* name(unsigned counter);
+
+private:
+  void closeCounters();
+
+  //! file descriptors of the counters per thread, the first one is the group leader
+  std::vector<std::array<int, NumCounters>> m_groups;
+};
+
+#endif // MONITORING_PERFORMANCECOUNTERS_H_
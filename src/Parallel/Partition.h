@@ -0,0 +1,72 @@
+/**
+ * @file
+ * This file is part of SeisSol.
+ *
+ * @section LICENSE
+ * Copyright (c) 2020, SeisSol Group
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @section DESCRIPTION
+ * Partition of cells among the threads of an OpenMP team.
+ **/
+
+#ifndef PARALLEL_PARTITION_H_
+#define PARALLEL_PARTITION_H_
+
+#include <algorithm>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace seissol {
+  namespace parallel {
+    /**
+     * Distributes cells contiguously among the threads of the current OpenMP team (identical to schedule(static)).
+     * The compute loops and the first touch of the LTS tree use the same partition.
+     **/
+    inline void staticPartition( unsigned  numberOfCells,
+                                 unsigned& firstCell,
+                                 unsigned& lastCell ) {
+#ifdef _OPENMP
+      unsigned numberOfThreads = omp_get_num_threads();
+      unsigned thread = omp_get_thread_num();
+      unsigned chunk = numberOfCells / numberOfThreads;
+      unsigned remainder = numberOfCells % numberOfThreads;
+      firstCell = thread * chunk + std::min(thread, remainder);
+      lastCell = firstCell + chunk + ((thread < remainder) ? 1 : 0);
+#else
+      firstCell = 0;
+      lastCell = numberOfCells;
+#endif
+    }
+  }
+}
+
+#endif
@@ -129,6 +129,7 @@ void seissol::writer::FreeSurfaceWriter::enable()
 
 void seissol::writer::FreeSurfaceWriter::init(  MeshReader const&                       meshReader,
                                                 seissol::solver::FreeSurfaceIntegrator* freeSurfaceIntegrator,
+                                                seissol::solver::GroundMotionMaps*      groundMotionMaps,
                                                 char const*                             outputPrefix,
                                                 double                                  interval,
                                                 xdmfwriter::BackendType                 backend )
@@ -139,6 +140,7 @@ void seissol::writer::FreeSurfaceWriter::init(  MeshReader const&
   int const rank = seissol::MPI::mpi.rank();
 
   m_freeSurfaceIntegrator = freeSurfaceIntegrator;
+  m_groundMotionMaps = groundMotionMaps;
 
 	logInfo(rank) << "Initializing free surface output.";
 
@@ -163,11 +165,19 @@ void seissol::writer::FreeSurfaceWriter::init(  MeshReader const&
 	bufferId = addSyncBuffer(vertices, nVertices * 3 * sizeof(double));
 	assert(bufferId == FreeSurfaceWriterExecutor::VERTICES);
 
-	for (unsigned int i = 0; i < FREESURFACE_NUMBER_OF_COMPONENTS; i++) {
-		addBuffer(m_freeSurfaceIntegrator->velocities[i], nCells * sizeof(double));
-	}
-	for (unsigned int i = 0; i < FREESURFACE_NUMBER_OF_COMPONENTS; i++) {
-		addBuffer(m_freeSurfaceIntegrator->displacements[i], nCells * sizeof(double));
+	if (m_groundMotionMaps->enabled()) {
+		m_numVariables = m_groundMotionMaps->numberOfMaps();
+		for (unsigned int i = 0; i < m_numVariables; i++) {
+			addBuffer(m_groundMotionMaps->map(i), nCells * sizeof(double));
+		}
+	} else {
+		m_numVariables = 2*FREESURFACE_NUMBER_OF_COMPONENTS;
+		for (unsigned int i = 0; i < FREESURFACE_NUMBER_OF_COMPONENTS; i++) {
+			addBuffer(m_freeSurfaceIntegrator->velocities[i], nCells * sizeof(double));
+		}
+		for (unsigned int i = 0; i < FREESURFACE_NUMBER_OF_COMPONENTS; i++) {
+			addBuffer(m_freeSurfaceIntegrator->displacements[i], nCells * sizeof(double));
+		}
 	}
 
 	//
@@ -182,6 +192,9 @@ void seissol::writer::FreeSurfaceWriter::init(  MeshReader const&
 	FreeSurfaceInitParam param;
 	param.timestep = seissol::SeisSol::main.checkPointManager().header().value(m_timestepComp);
   param.backend = backend;
+	param.groundMotionMaps = m_groundMotionMaps->enabled();
+	param.numberOfPeriods = m_groundMotionMaps->periods().size();
+	std::copy(m_groundMotionMaps->periods().begin(), m_groundMotionMaps->periods().end(), param.periods);
 	callInit(param);
 
 	// Remove unused buffers
@@ -216,7 +229,7 @@ void seissol::writer::FreeSurfaceWriter::write(double time)
 	FreeSurfaceParam param;
 	param.time = time;
 
-	for (unsigned i = 0; i < 2*FREESURFACE_NUMBER_OF_COMPONENTS; ++i) {
+	for (unsigned i = 0; i < m_numVariables; ++i) {
 		sendBuffer(FreeSurfaceWriterExecutor::VARIABLES0 + i);
 	}
 
@@ -240,6 +253,9 @@ void seissol::writer::FreeSurfaceWriter::syncPoint(double currentTime)
 {
 	SCOREP_USER_REGION("freesurfaceoutput", SCOREP_USER_REGION_TYPE_FUNCTION)
 
-  m_freeSurfaceIntegrator->calculateOutput();
+  // The ground motion maps are updated by the time clusters
+  if (!m_groundMotionMaps->enabled()) {
+    m_freeSurfaceIntegrator->calculateOutput();
+  }
 	write(currentTime);
 }
@@ -49,6 +49,7 @@
 #include <async/Module.h>
 #include <Modules/Module.h>
 #include <Solver/FreeSurfaceIntegrator.h>
+#include <Solver/GroundMotionMaps.h>
 #include "Checkpoint/DynStruct.h"
 #include "Monitoring/Stopwatch.h"
 #include "FreeSurfaceWriterExecutor.h"
@@ -76,6 +77,12 @@ private:
   /** free surface integration module. */
   seissol::solver::FreeSurfaceIntegrator* m_freeSurfaceIntegrator;
 
+  /** ground motion maps, which replace the velocities and displacements if enabled. */
+  seissol::solver::GroundMotionMaps* m_groundMotionMaps;
+
+  /** Number of variables in the output */
+  unsigned m_numVariables;
+
   void constructSurfaceMesh(  MeshReader const& meshReader,
                               unsigned*&        cells,
                               double*&          vertices,
@@ -83,7 +90,7 @@ private:
                               unsigned&         nVertices );
 
 public:
-	FreeSurfaceWriter() : m_enabled(false), m_freeSurfaceIntegrator(NULL) {}
+	FreeSurfaceWriter() : m_enabled(false), m_freeSurfaceIntegrator(NULL), m_groundMotionMaps(NULL), m_numVariables(0) {}
 
 	/**
 	 * Called by ASYNC on all ranks
@@ -94,6 +101,7 @@ public:
 
 	void init(  MeshReader const&                       meshReader,
               seissol::solver::FreeSurfaceIntegrator* freeSurfaceIntegrator,
+              seissol::solver::GroundMotionMaps*      groundMotionMaps,
               char const*                             outputPrefix,
               double                                  interval,
               xdmfwriter::BackendType                 backend );
@@ -39,6 +39,8 @@
 
 #include "Parallel/MPI.h"
 
+#include <iomanip>
+#include <sstream>
 #include <string>
 #include <vector>
 
@@ -71,10 +73,24 @@ void seissol::writer::FreeSurfaceWriterExecutor::execInit(const async::ExecInfo
 		std::string outputName(static_cast<const char*>(info.buffer(OUTPUT_PREFIX)));
 		outputName += "-surface";
 
-    m_numVariables = 2*FREESURFACE_NUMBER_OF_COMPONENTS;
 		std::vector<const char*> variables;
-		for (unsigned int i = 0; i < m_numVariables; i++) {
-      variables.push_back(LABELS[i]);
+		if (param.groundMotionMaps) {
+			outputName += "-gm";
+			m_groundMotionLabels = {"PGA", "PGV", "PGD"};
+			for (unsigned int i = 0; i < param.numberOfPeriods; i++) {
+				std::stringstream label;
+				label << "SA" << std::fixed << std::setprecision(3) << param.periods[i] << "s";
+				m_groundMotionLabels.push_back(label.str());
+			}
+			m_numVariables = m_groundMotionLabels.size();
+			for (auto const& label : m_groundMotionLabels) {
+				variables.push_back(label.c_str());
+			}
+		} else {
+			m_numVariables = 2*FREESURFACE_NUMBER_OF_COMPONENTS;
+			for (unsigned int i = 0; i < m_numVariables; i++) {
+				variables.push_back(LABELS[i]);
+			}
 		}
 
 		// TODO get the timestep from the checkpoint
@@ -44,6 +44,10 @@
 #include "async/ExecInfo.h"
 
 #include "Monitoring/Stopwatch.h"
+#include "Solver/GroundMotionMaps.h"
+
+#include <string>
+#include <vector>
 
 namespace seissol
 {
@@ -53,6 +57,10 @@ struct FreeSurfaceInitParam
 {
 	int timestep;
   xdmfwriter::BackendType backend;
+  /** Write the ground motion maps instead of the velocities and displacements */
+  bool groundMotionMaps;
+  unsigned numberOfPeriods;
+  double periods[GROUNDMOTION_MAX_PERIODS];
 };
 
 struct FreeSurfaceParam
@@ -139,6 +147,9 @@ public:
 private:
 	/** Variable names in the output */
 	static char const * const LABELS[];
+
+	/** Variable names of the ground motion maps */
+	std::vector<std::string> m_groundMotionLabels;
 };
 
 }
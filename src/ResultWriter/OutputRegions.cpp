@@ -0,0 +1,387 @@
+/**
+ * @file
+ * This file is part of SeisSol.
+ *
+ * @section LICENSE
+ * Copyright (c) 2020, SeisSol Group
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @section DESCRIPTION
+ * Regions of the wave field output with their own refinement and variables.
+ **/
+
+#include "OutputRegions.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <sstream>
+#include <unordered_map>
+
+#include <Geometry/MeshReader.h>
+#include <Geometry/MeshTools.h>
+#include <Parallel/MPI.h>
+#include <utils/env.h>
+#include <utils/logger.h>
+
+namespace {
+  std::vector<std::string> split(std::string const& string, char delimiter)
+  {
+    std::vector<std::string> tokens;
+    std::stringstream stream(string);
+    std::string token;
+    while (std::getline(stream, token, delimiter)) {
+      tokens.push_back(token);
+    }
+    return tokens;
+  }
+
+  template<typename T>
+  std::vector<T> parseList(std::string const& list, std::string const& rule)
+  {
+    std::vector<T> values;
+    for (auto const& entry : split(list, ',')) {
+      T value;
+      std::stringstream stream(entry);
+      if (!(stream >> value) || !stream.eof()) {
+        logError() << "Invalid value" << entry << "in the output region" << rule;
+      }
+      values.push_back(value);
+    }
+    return values;
+  }
+
+  //! Key of the bucket of the uniform grid which is used to find the fault faces close to a vertex
+  long long bucketKey(long long x, long long y, long long z)
+  {
+    long long const mask = (1LL << 21) - 1;
+    return ((x & mask) << 42) | ((y & mask) << 21) | (z & mask);
+  }
+}
+
+seissol::writer::OutputRegions seissol::writer::OutputRegions::fromEnvironment()
+{
+  OutputRegions outputRegions(parse(utils::Env::get<std::string>("SEISSOL_OUTPUT_REGIONS", "")));
+
+  int const rank = seissol::MPI::mpi.rank();
+  for (unsigned r = 0; r < outputRegions.size(); ++r) {
+    Region const& region = outputRegions[r];
+    logInfo(rank) << "Wave field output region" << r << "with refinement" << region.refinement
+      << (region.type == Type::Box ? "(box)" : region.type == Type::Fault ? "(fault)" : "(group)");
+  }
+
+  return outputRegions;
+}
+
+std::vector<seissol::writer::OutputRegions::Region> seissol::writer::OutputRegions::parse(std::string const& rules)
+{
+  std::vector<Region> regions;
+  for (auto const& rule : split(rules, ';')) {
+    if (rule.empty()) {
+      continue;
+    }
+
+    std::vector<std::string> fields = split(rule, ':');
+    if (fields.size() < 3 || fields.size() > 4) {
+      logError() << "Output region" << rule << "does not have the format type:parameters:refinement[:mask]";
+    }
+
+    Region region;
+    region.bounds.fill(0.0);
+    region.distance = 0.0;
+    if (fields[0] == "box") {
+      region.type = Type::Box;
+      std::vector<double> bounds = parseList<double>(fields[1], rule);
+      if (bounds.size() != 6) {
+        logError() << "The output region" << rule << "requires the bounds xMin,xMax,yMin,yMax,zMin,zMax";
+      }
+      std::copy(bounds.begin(), bounds.end(), region.bounds.begin());
+    } else if (fields[0] == "fault") {
+      region.type = Type::Fault;
+      std::vector<double> distance = parseList<double>(fields[1], rule);
+      if (distance.size() != 1 || distance[0] <= 0.0) {
+        logError() << "The output region" << rule << "requires a positive distance";
+      }
+      region.distance = distance[0];
+    } else if (fields[0] == "group") {
+      region.type = Type::Group;
+      region.groups = parseList<int>(fields[1], rule);
+      if (region.groups.empty()) {
+        logError() << "The output region" << rule << "requires at least one group";
+      }
+    } else {
+      logError() << "Unknown type of the output region" << rule << "(valid types are box, fault and group)";
+    }
+
+    std::vector<int> refinement = parseList<int>(fields[2], rule);
+    if (refinement.size() != 1 || refinement[0] < 0 || refinement[0] > 3) {
+      logError() << "The refinement of the output region" << rule << "has to be 0, 1, 2 or 3";
+    }
+    region.refinement = refinement[0];
+
+    if (fields.size() == 4) {
+      for (char flag : fields[3]) {
+        if (flag != '0' && flag != '1') {
+          logError() << "The output mask of the output region" << rule << "may only contain 0 and 1";
+        }
+        region.outputMask.push_back(flag == '1');
+      }
+    }
+
+    regions.push_back(region);
+  }
+  return regions;
+}
+
+std::vector<int> seissol::writer::OutputRegions::assign(MeshReader const& meshReader) const
+{
+  std::vector<Element> const& elements = meshReader.getElements();
+  std::vector<Vertex> const& vertices = meshReader.getVertices();
+
+  double maxDistance = 0.0;
+  for (auto const& region : m_regions) {
+    if (region.type == Type::Fault) {
+      maxDistance = std::max(maxDistance, region.distance);
+    }
+  }
+  std::vector<double> distances;
+  if (maxDistance > 0.0) {
+    distances = faultDistances(meshReader, maxDistance);
+  }
+
+  std::vector<int> elementRegions(elements.size(), NoRegion);
+#ifdef _OPENMP
+  #pragma omp parallel for schedule(static)
+#endif
+  for (unsigned e = 0; e < elements.size(); ++e) {
+    for (unsigned r = 0; r < m_regions.size() && elementRegions[e] == NoRegion; ++r) {
+      Region const& region = m_regions[r];
+      bool matches = false;
+      switch (region.type) {
+      case Type::Box:
+        for (unsigned v = 0; v < 4; ++v) {
+          double const* coords = vertices[elements[e].vertices[v]].coords;
+          matches = matches || (coords[0] >= region.bounds[0] && coords[0] <= region.bounds[1]
+                             && coords[1] >= region.bounds[2] && coords[1] <= region.bounds[3]
+                             && coords[2] >= region.bounds[4] && coords[2] <= region.bounds[5]);
+        }
+        break;
+      case Type::Fault:
+        matches = distances[e] <= region.distance;
+        break;
+      case Type::Group:
+        matches = std::find(region.groups.begin(), region.groups.end(), elements[e].material) != region.groups.end();
+        break;
+      }
+      if (matches) {
+        elementRegions[e] = r;
+      }
+    }
+  }
+
+  return elementRegions;
+}
+
+std::vector<double> seissol::writer::OutputRegions::faultDistances(MeshReader const& meshReader, double maxDistance)
+{
+  std::vector<Element> const& elements = meshReader.getElements();
+  std::vector<Vertex> const& vertices = meshReader.getVertices();
+
+  // Corners of the local fault faces
+  std::vector<double> localTriangles;
+  for (auto const& fault : meshReader.getFault()) {
+    int const element = (fault.element >= 0) ? fault.element : fault.neighborElement;
+    int const side = (fault.element >= 0) ? fault.side : fault.neighborSide;
+    for (unsigned v = 0; v < 3; ++v) {
+      double const* coords = vertices[elements[element].vertices[MeshTools::FACE2NODES[side][v]]].coords;
+      localTriangles.insert(localTriangles.end(), coords, coords + 3);
+    }
+  }
+
+#ifdef USE_MPI
+  // Send every fault face to all ranks whose part of the mesh is closer than maxDistance
+  MPI_Comm comm = seissol::MPI::mpi.comm();
+  int const size = seissol::MPI::mpi.size();
+
+  double const inf = std::numeric_limits<double>::infinity();
+  double localBounds[6] = {inf, -inf, inf, -inf, inf, -inf};
+  for (auto const& vertex : vertices) {
+    for (unsigned d = 0; d < 3; ++d) {
+      localBounds[2*d] = std::min(localBounds[2*d], vertex.coords[d] - maxDistance);
+      localBounds[2*d+1] = std::max(localBounds[2*d+1], vertex.coords[d] + maxDistance);
+    }
+  }
+  std::vector<double> bounds(6 * size);
+  MPI_Allgather(localBounds, 6, MPI_DOUBLE, bounds.data(), 6, MPI_DOUBLE, comm);
+
+  std::vector<std::vector<double>> sendTriangles(size);
+  for (unsigned t = 0; t < localTriangles.size() / 9; ++t) {
+    double const* triangle = &localTriangles[9*t];
+    for (int r = 0; r < size; ++r) {
+      bool intersects = true;
+      for (unsigned d = 0; d < 3; ++d) {
+        double const min = std::min({triangle[d], triangle[3+d], triangle[6+d]});
+        double const max = std::max({triangle[d], triangle[3+d], triangle[6+d]});
+        intersects = intersects && max >= bounds[6*r + 2*d] && min <= bounds[6*r + 2*d+1];
+      }
+      if (intersects) {
+        sendTriangles[r].insert(sendTriangles[r].end(), triangle, triangle + 9);
+      }
+    }
+  }
+
+  std::vector<int> sendCounts(size);
+  std::vector<int> sendDispls(size);
+  std::vector<double> sendBuffer;
+  for (int r = 0; r < size; ++r) {
+    sendCounts[r] = sendTriangles[r].size();
+    sendDispls[r] = sendBuffer.size();
+    sendBuffer.insert(sendBuffer.end(), sendTriangles[r].begin(), sendTriangles[r].end());
+  }
+  std::vector<int> recvCounts(size);
+  MPI_Alltoall(sendCounts.data(), 1, MPI_INT, recvCounts.data(), 1, MPI_INT, comm);
+  std::vector<int> recvDispls(size);
+  int numRecv = 0;
+  for (int r = 0; r < size; ++r) {
+    recvDispls[r] = numRecv;
+    numRecv += recvCounts[r];
+  }
+  std::vector<double> triangles(numRecv);
+  MPI_Alltoallv(sendBuffer.data(), sendCounts.data(), sendDispls.data(), MPI_DOUBLE,
+                triangles.data(), recvCounts.data(), recvDispls.data(), MPI_DOUBLE, comm);
+#else // USE_MPI
+  std::vector<double> const& triangles = localTriangles;
+#endif // USE_MPI
+
+  // Sort the triangles into a uniform grid with a spacing of maxDistance, such that all faces within
+  // maxDistance of a vertex are found in the 27 buckets around it
+  unsigned const numTriangles = triangles.size() / 9;
+  std::unordered_map<long long, std::vector<unsigned>> buckets;
+  for (unsigned t = 0; t < numTriangles; ++t) {
+    long long min[3], max[3];
+    for (unsigned d = 0; d < 3; ++d) {
+      min[d] = std::floor(std::min({triangles[9*t+d], triangles[9*t+3+d], triangles[9*t+6+d]}) / maxDistance);
+      max[d] = std::floor(std::max({triangles[9*t+d], triangles[9*t+3+d], triangles[9*t+6+d]}) / maxDistance);
+    }
+    for (long long x = min[0]; x <= max[0]; ++x) {
+      for (long long y = min[1]; y <= max[1]; ++y) {
+        for (long long z = min[2]; z <= max[2]; ++z) {
+          buckets[bucketKey(x, y, z)].push_back(t);
+        }
+      }
+    }
+  }
+
+  std::vector<double> vertexDistances(vertices.size());
+#ifdef _OPENMP
+  #pragma omp parallel for schedule(static)
+#endif
+  for (unsigned v = 0; v < vertices.size(); ++v) {
+    Eigen::Map<const Eigen::Vector3d> p(vertices[v].coords);
+    long long const x = std::floor(p(0) / maxDistance);
+    long long const y = std::floor(p(1) / maxDistance);
+    long long const z = std::floor(p(2) / maxDistance);
+
+    double distance = std::numeric_limits<double>::infinity();
+    for (long long dx = -1; dx <= 1; ++dx) {
+      for (long long dy = -1; dy <= 1; ++dy) {
+        for (long long dz = -1; dz <= 1; ++dz) {
+          auto bucket = buckets.find(bucketKey(x+dx, y+dy, z+dz));
+          if (bucket == buckets.end()) {
+            continue;
+          }
+          for (unsigned t : bucket->second) {
+            distance = std::min(distance, distanceToTriangle(p,
+              Eigen::Map<const Eigen::Vector3d>(&triangles[9*t]),
+              Eigen::Map<const Eigen::Vector3d>(&triangles[9*t+3]),
+              Eigen::Map<const Eigen::Vector3d>(&triangles[9*t+6])));
+          }
+        }
+      }
+    }
+    vertexDistances[v] = (distance <= maxDistance) ? distance : std::numeric_limits<double>::infinity();
+  }
+
+  std::vector<double> distances(elements.size());
+  for (unsigned e = 0; e < elements.size(); ++e) {
+    distances[e] = std::min({vertexDistances[elements[e].vertices[0]], vertexDistances[elements[e].vertices[1]],
+                             vertexDistances[elements[e].vertices[2]], vertexDistances[elements[e].vertices[3]]});
+  }
+  return distances;
+}
+
+double seissol::writer::OutputRegions::distanceToTriangle(Eigen::Vector3d const& p,
+                                                          Eigen::Vector3d const& a,
+                                                          Eigen::Vector3d const& b,
+                                                          Eigen::Vector3d const& c)
+{
+  // Closest point on the triangle by its Voronoi regions (Ericson, Real-Time Collision Detection, 5.1.5)
+  Eigen::Vector3d const ab = b - a;
+  Eigen::Vector3d const ac = c - a;
+  Eigen::Vector3d const ap = p - a;
+  double const d1 = ab.dot(ap);
+  double const d2 = ac.dot(ap);
+  if (d1 <= 0.0 && d2 <= 0.0) {
+    return ap.norm();
+  }
+
+  Eigen::Vector3d const bp = p - b;
+  double const d3 = ab.dot(bp);
+  double const d4 = ac.dot(bp);
+  if (d3 >= 0.0 && d4 <= d3) {
+    return bp.norm();
+  }
+
+  double const vc = d1*d4 - d3*d2;
+  if (vc <= 0.0 && d1 >= 0.0 && d3 <= 0.0) {
+    return (p - (a + d1 / (d1 - d3) * ab)).norm();
+  }
+
+  Eigen::Vector3d const cp = p - c;
+  double const d5 = ab.dot(cp);
+  double const d6 = ac.dot(cp);
+  if (d6 >= 0.0 && d5 <= d6) {
+    return cp.norm();
+  }
+
+  double const vb = d5*d2 - d1*d6;
+  if (vb <= 0.0 && d2 >= 0.0 && d6 <= 0.0) {
+    return (p - (a + d2 / (d2 - d6) * ac)).norm();
+  }
+
+  double const va = d3*d6 - d5*d4;
+  if (va <= 0.0 && d4 - d3 >= 0.0 && d5 - d6 >= 0.0) {
+    return (p - (b + (d4 - d3) / ((d4 - d3) + (d5 - d6)) * (c - b))).norm();
+  }
+
+  double const denominator = 1.0 / (va + vb + vc);
+  double const v = vb * denominator;
+  double const w = vc * denominator;
+  return (p - (a + v * ab + w * ac)).norm();
+}
@@ -0,0 +1,135 @@
+/**
+ * @file
+ * This file is part of SeisSol.
+ *
+ * @section LICENSE
+ * Copyright (c) 2020, SeisSol Group
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @section DESCRIPTION
+ * Regions of the wave field output with their own refinement and variables.
+ **/
+
+#ifndef RESULTWRITER_OUTPUTREGIONS_H_
+#define RESULTWRITER_OUTPUTREGIONS_H_
+
+#include <array>
+#include <string>
+#include <vector>
+
+#include <Eigen/Dense>
+
+class MeshReader;
+
+namespace seissol {
+  namespace writer {
+    class OutputRegions;
+  }
+}
+
+/**
+ * Assigns the elements of the mesh to regions of the wave field output. A region is an axis-aligned box, the
+ * neighbourhood of the fault or a set of element groups (the group tags of the mesh, which are also used by easi)
+ * and defines the refinement level and the output mask of its elements.
+ *
+ * The regions are given as a ';'-separated list of rules, the first matching rule wins:
+ *   box:xMin,xMax,yMin,yMax,zMin,zMax:refinement[:mask]
+ *   fault:distance:refinement[:mask]
+ *   group:group[,group...]:refinement[:mask]
+ * The optional mask is a string of 0 and 1 in the order of iOutputMask, e.g. 000000111 for the velocities only.
+ **/
+class seissol::writer::OutputRegions {
+public:
+  enum class Type {
+    Box,
+    Fault,
+    Group
+  };
+
+  struct Region {
+    Type type;
+    //! xMin, xMax, yMin, yMax, zMin, zMax (box only)
+    std::array<double, 6> bounds;
+    //! Maximum distance of a vertex to the fault (fault only)
+    double distance;
+    //! Element groups (group only)
+    std::vector<int> groups;
+    //! Refinement strategy, see WaveFieldWriter::createRefiner
+    int refinement;
+    //! Restricts the variables of the parameter file; empty if all variables are written
+    std::vector<bool> outputMask;
+
+    //! @return True if the variable is written for the elements of this region
+    bool isOutput(unsigned variable) const {
+      return outputMask.empty() || (variable < outputMask.size() && outputMask[variable]);
+    }
+  };
+
+  static constexpr int NoRegion = -1;
+
+private:
+  std::vector<Region> m_regions;
+
+public:
+  OutputRegions() = default;
+
+  explicit OutputRegions(std::vector<Region> const& regions) : m_regions(regions) {}
+
+  //! Reads the regions from SEISSOL_OUTPUT_REGIONS
+  static OutputRegions fromEnvironment();
+
+  bool empty() const { return m_regions.empty(); }
+
+  unsigned size() const { return m_regions.size(); }
+
+  Region const& operator[](unsigned region) const { return m_regions[region]; }
+
+  /**
+   * @return The index of the first matching region for every element or NoRegion.
+   *
+   * Collective if one of the regions refers to the fault, since the fault faces of all ranks are required.
+   **/
+  std::vector<int> assign(MeshReader const& meshReader) const;
+
+  static std::vector<Region> parse(std::string const& rules);
+
+  //! Distance between a point and the triangle (a, b, c)
+  static double distanceToTriangle(Eigen::Vector3d const& p,
+                                   Eigen::Vector3d const& a,
+                                   Eigen::Vector3d const& b,
+                                   Eigen::Vector3d const& c);
+
+private:
+  /**
+   * @return The distance of the closest vertex of every element to the fault, or infinity if it exceeds maxDistance.
+   **/
+  static std::vector<double> faultDistances(MeshReader const& meshReader, double maxDistance);
+};
+
+#endif
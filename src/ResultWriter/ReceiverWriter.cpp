@@ -39,12 +39,18 @@
 
 #include "ReceiverWriter.h"
 
+#include <algorithm>
+#include <cstring>
 #include <sstream>
 #include <iomanip>
 #include <fstream>
+#include <iterator>
 #include <sys/stat.h>
 #include <Parallel/MPI.h>
+#include <Parallel/Pin.h>
 #include <Modules/Modules.h>
+#include <SeisSol.h>
+#include <utils/env.h>
 
 std::string seissol::writer::ReceiverWriter::fileName(unsigned pointId) const {
   std::stringstream fns;
@@ -56,12 +62,29 @@ std::string seissol::writer::ReceiverWriter::fileName(unsigned pointId) const {
   return fns.str();
 }
 
+std::string seissol::writer::ReceiverWriter::variables() const {
+  std::vector<std::string> names({"xx", "yy", "zz", "xy", "yz", "xz", "u", "v", "w"});
+
+  std::stringstream variables;
+  variables << "\"Time\"";
+#ifdef MULTIPLE_SIMULATIONS
+  for (unsigned sim = init::QAtPoint::Start[0]; sim < init::QAtPoint::Stop[0]; ++sim) {
+    for (auto const& name : names) {
+      variables << ",\"" << name << sim << "\"";
+    }
+  }
+#else
+  for (auto const& name : names) {
+    variables << ",\"" << name << "\"";
+  }
+#endif
+  return variables.str();
+}
+
 void seissol::writer::ReceiverWriter::writeHeader( unsigned               pointId,
                                                    Eigen::Vector3d const& point   ) {
   auto name = fileName(pointId);
 
-  std::vector<std::string> names({"xx", "yy", "zz", "xy", "yz", "xz", "u", "v", "w"});
-
   /// \todo Find a nicer solution that is not so hard-coded.
   struct stat fileStat;
   // Write header if file does not exist
@@ -69,19 +92,7 @@ void seissol::writer::ReceiverWriter::writeHeader( unsigned               pointI
     std::ofstream file;
     file.open(name);
     file << "TITLE = \"Temporal Signal for receiver number " << std::setfill('0') << std::setw(5) << (pointId+1) << "\"" << std::endl;
-    file << "VARIABLES = \"Time\"";
-#ifdef MULTIPLE_SIMULATIONS
-    for (unsigned sim = init::QAtPoint::Start[0]; sim < init::QAtPoint::Stop[0]; ++sim) {
-      for (auto const& name : names) {
-        file << ",\"" << name << sim << "\"";
-      }
-    }
-#else
-    for (auto const& name : names) {
-      file << ",\"" << name << "\"";
-    }
-#endif
-    file << std::endl;
+    file << "VARIABLES = " << variables() << std::endl;
     for (int d = 0; d < 3; ++d) {
       file << "# x" << (d+1) << "       " << std::scientific << std::setprecision(12) << point[d] << std::endl;
     }
@@ -89,14 +100,126 @@ void seissol::writer::ReceiverWriter::writeHeader( unsigned               pointI
   }
 }
 
-void seissol::writer::ReceiverWriter::syncPoint(double)
-{
-  if (m_receiverClusters.empty()) {
-    return;
+void seissol::writer::ReceiverWriter::setUp() {
+  setExecutor(m_executor);
+  if (isAffinityNecessary()) {
+    const auto freeCpus = SeisSol::main.getPinning().getFreeCPUsMask();
+    logInfo(seissol::MPI::mpi.rank()) << "Receiver writer thread affinity:" <<
+      parallel::Pinning::maskToString(freeCpus);
+    if (parallel::Pinning::freeCPUsMaskEmpty(freeCpus)) {
+      logError() << "There are no free CPUs left. Make sure to leave one for the I/O thread(s).";
+    }
+  }
+}
+
+void seissol::writer::ReceiverWriter::initBinary( std::vector<Eigen::Vector3d> const& points,
+                                                  std::vector<short> const&           contained ) {
+  std::string const names = variables();
+  size_t const paddedNames = (names.size() + 7) / 8 * 8;
+
+  // The buffer holds either the header records or all samples between two synchronization points
+  size_t headerSize = sizeof(uint64_t) + sizeof(ReceiverRecord) + paddedNames;
+  for (auto isContained : contained) {
+    if (isContained == 1) {
+      headerSize += sizeof(ReceiverRecord) + 4 * sizeof(double);
+    }
+  }
+  size_t samplesSize = sizeof(uint64_t);
+  size_t const maxSamples = syncInterval() / m_samplingInterval + 2;
+  for (auto& cluster : m_receiverClusters) {
+    size_t const numberOfReceivers = std::distance(cluster.begin(), cluster.end());
+    samplesSize += numberOfReceivers * (sizeof(ReceiverRecord) + maxSamples * cluster.ncols() * sizeof(double));
+  }
+  unsigned long bufferSize = std::max(headerSize, samplesSize);
+#ifdef USE_MPI
+  // All ranks use the same buffer size, the executor splits the concatenated buffers with ASYNC_MODE=MPI
+  MPI_Allreduce(MPI_IN_PLACE, &bufferSize, 1, MPI_UNSIGNED_LONG, MPI_MAX, seissol::MPI::mpi.comm());
+#endif // USE_MPI
+  m_buffer.resize(bufferSize);
+
+  // Initialize the asynchronous module
+  async::Module<ReceiverWriterExecutor, ReceiverInitParam, ReceiverParam>::init();
+
+  unsigned int bufferId = addSyncBuffer(m_fileNamePrefix.c_str(), m_fileNamePrefix.size()+1, true);
+  assert(bufferId == ReceiverWriterExecutor::OUTPUT_PREFIX); NDBG_UNUSED(bufferId);
+  bufferId = addBuffer(m_buffer.data(), m_buffer.size());
+  assert(bufferId == ReceiverWriterExecutor::RECORDS);
+
+  sendBuffer(ReceiverWriterExecutor::OUTPUT_PREFIX);
+
+  ReceiverInitParam param;
+  param.bufferSize = bufferSize;
+  callInit(param);
+
+  removeBuffer(ReceiverWriterExecutor::OUTPUT_PREFIX);
+
+  // Header records, ranks without receivers do not write anything
+  m_bufferUsed = sizeof(uint64_t);
+  if (std::find(contained.begin(), contained.end(), 1) != contained.end()) {
+    std::vector<char> paddedNameBuffer(paddedNames, ' ');
+    std::copy(names.begin(), names.end(), paddedNameBuffer.begin());
+    addRecord(ReceiverRecord::VARIABLES, 0, paddedNameBuffer.data(), paddedNames);
   }
+  for (unsigned point = 0; point < points.size(); ++point) {
+    if (contained[point] == 1) {
+      double coordinates[4] = {points[point](0), points[point](1), points[point](2), 0.0};
+#ifdef PARALLEL
+      int64_t rank = seissol::MPI::mpi.rank();
+#else
+      int64_t rank = -1;
+#endif
+      std::memcpy(&coordinates[3], &rank, sizeof(int64_t));
+      addRecord(ReceiverRecord::POINT, point, coordinates, sizeof(coordinates));
+    }
+  }
+  flush(0.0);
+}
+
+void seissol::writer::ReceiverWriter::addRecord(  ReceiverRecord::Type  type,
+                                                  unsigned              pointId,
+                                                  void const*           payload,
+                                                  size_t                size ) {
+  assert(m_bufferUsed + sizeof(ReceiverRecord) + size <= m_buffer.size());
+
+  m_bufferUsed += ReceiverRecord::write(&m_buffer[m_bufferUsed], type, pointId, payload, size);
+}
 
-  m_stopwatch.start();
+void seissol::writer::ReceiverWriter::flush(double time) {
+  uint64_t used = m_bufferUsed - sizeof(uint64_t);
+  std::memcpy(m_buffer.data(), &used, sizeof(uint64_t));
 
+  sendBuffer(ReceiverWriterExecutor::RECORDS);
+
+  ReceiverParam param;
+  param.time = time;
+  call(param);
+
+  m_bufferUsed = sizeof(uint64_t);
+}
+
+void seissol::writer::ReceiverWriter::writeBinary(double time) {
+  // The previous write has to finish before the buffer can be reused
+  wait();
+
+  std::vector<double> samples;
+  for (auto& cluster : m_receiverClusters) {
+    for (auto& receiver : cluster) {
+      if (receiver.output.empty()) {
+        continue;
+      }
+      samples.assign(receiver.output.begin(), receiver.output.end());
+      if (m_bufferUsed + sizeof(ReceiverRecord) + samples.size() * sizeof(double) > m_buffer.size()) {
+        logError() << "The receiver buffer is too small for" << samples.size() / cluster.ncols() << "samples.";
+      }
+      addRecord(ReceiverRecord::SAMPLES, receiver.pointId, samples.data(), samples.size() * sizeof(double));
+      receiver.output.clear();
+    }
+  }
+
+  flush(time);
+}
+
+void seissol::writer::ReceiverWriter::writeAscii() {
   for (auto& cluster : m_receiverClusters) {
     auto ncols = cluster.ncols();
     for (auto& receiver : cluster) {
@@ -116,11 +239,28 @@ void seissol::writer::ReceiverWriter::syncPoint(double)
       receiver.output.clear();
     }
   }
+}
+
+void seissol::writer::ReceiverWriter::syncPoint(double currentTime)
+{
+  if (m_binary) {
+    // All ranks take part in the asynchronous output
+    m_stopwatch.start();
+    writeBinary(currentTime);
+  } else {
+    if (m_receiverClusters.empty()) {
+      return;
+    }
+
+    m_stopwatch.start();
+    writeAscii();
+  }
 
   auto time = m_stopwatch.stop();
   int const rank = seissol::MPI::mpi.rank();
   logInfo(rank) << "Wrote receivers in" << time << "seconds.";
 }
+
 void seissol::writer::ReceiverWriter::init( std::string const&  fileNamePrefix,
                                             double              samplingInterval,
                                             double              syncPointInterval)
@@ -128,6 +268,13 @@ void seissol::writer::ReceiverWriter::init( std::string const&  fileNamePrefix,
   m_fileNamePrefix = fileNamePrefix;
   m_samplingInterval = samplingInterval;
   setSyncInterval(syncPointInterval);
+
+  std::string output = utils::Env::get<std::string>("SEISSOL_RECEIVER_OUTPUT", "ascii");
+  if (output == "binary") {
+    m_binary = true;
+  } else if (output != "ascii") {
+    logError() << "Unknown receiver output" << output << "(SEISSOL_RECEIVER_OUTPUT has to be ascii or binary).";
+  }
   Modules::registerHook(*this, SYNCHRONIZATION_POINT);
 }
 
@@ -161,8 +308,14 @@ void seissol::writer::ReceiverWriter::addPoints(  std::vector<Eigen::Vector3d> c
         m_receiverClusters.emplace_back(global, quantities, m_samplingInterval, syncInterval());
       }
 
-      writeHeader(point, points[point]);
+      if (!m_binary) {
+        writeHeader(point, points[point]);
+      }
       m_receiverClusters[cluster].addReceiver(meshId, point, points[point], mesh, ltsLut, lts);
     }
   }
+
+  if (m_binary) {
+    initBinary(points, contained);
+  }
 }
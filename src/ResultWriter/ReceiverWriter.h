@@ -40,21 +40,31 @@
 #ifndef RESULTWRITER_RECEIVERWRITER_H_
 #define RESULTWRITER_RECEIVERWRITER_H_
 
+#include <string>
 #include <vector>
 #include <Eigen/Dense>
+#include <async/Module.h>
 #include <Geometry/MeshReader.h>
 #include <Initializer/tree/Lut.hpp>
 #include <Initializer/LTS.h>
 #include <Kernels/Receiver.h>
 #include <Modules/Module.h>
 #include <Monitoring/Stopwatch.h>
+#include "ReceiverWriterExecutor.h"
 
 class LocalIntegrationData;
 class GlobalData;
 namespace seissol {
   namespace writer {
-    class ReceiverWriter : public seissol::Module {
+    class ReceiverWriter : private async::Module<ReceiverWriterExecutor, ReceiverInitParam, ReceiverParam>, public seissol::Module {
     public:
+      ReceiverWriter() : m_binary(false), m_bufferUsed(0) {}
+
+      /**
+       * Called by ASYNC on all ranks
+       */
+      void setUp();
+
       void init(  std::string const&  fileNamePrefix,
                   double              samplingInterval,
                   double              syncPointInterval);
@@ -71,6 +81,19 @@ namespace seissol {
         }
         return nullptr;
       }
+
+      void close() {
+        if (m_binary) {
+          wait();
+        }
+
+        finalize();
+      }
+
+      void tearDown() {
+        m_executor.finalize();
+      }
+
       //
       // Hooks
       //
@@ -78,12 +101,30 @@ namespace seissol {
 
     private:
       std::string fileName(unsigned pointId) const;
+      /** Names of all columns, separated by commas */
+      std::string variables() const;
       void writeHeader(unsigned pointId, Eigen::Vector3d const& point);
 
+      /** Initializes the asynchronous executor and sends the receiver coordinates */
+      void initBinary(std::vector<Eigen::Vector3d> const& points, std::vector<short> const& contained);
+      /** Appends a record to the buffer */
+      void addRecord(ReceiverRecord::Type type, unsigned pointId, void const* payload, size_t size);
+      /** Sends the buffer to the executor */
+      void flush(double time);
+      void writeBinary(double time);
+      void writeAscii();
+
       std::string m_fileNamePrefix;
       double      m_samplingInterval;
       std::vector<kernels::ReceiverCluster> m_receiverClusters;
       Stopwatch   m_stopwatch;
+
+      /** Write all receivers of a rank to a binary file with the asynchronous executor */
+      bool        m_binary;
+      /** The records that are sent to the executor, starts with the number of bytes used */
+      std::vector<char> m_buffer;
+      size_t      m_bufferUsed;
+      ReceiverWriterExecutor m_executor;
     };
   }
 }
@@ -0,0 +1,129 @@
+/**
+ * @file
+ * This file is part of SeisSol.
+ *
+ * @section LICENSE
+ * Copyright (c) 2020, SeisSol Group
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @section DESCRIPTION
+ * Executor for the binary receiver output
+ */
+
+#include "Parallel/MPI.h"
+
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+
+#include "utils/logger.h"
+
+#include "ReceiverWriterExecutor.h"
+
+const char seissol::writer::ReceiverRecord::MAGIC[8] = {'S', 'E', 'I', 'S', 'R', 'E', 'C', 'V'};
+const uint64_t seissol::writer::ReceiverRecord::VERSION;
+
+size_t seissol::writer::ReceiverRecord::write(char* buffer, Type type, unsigned pointId, const void* payload, size_t size)
+{
+	ReceiverRecord record;
+	record.type = type;
+	record.pointId = pointId;
+	record.size = size;
+	std::memcpy(buffer, &record, sizeof(ReceiverRecord));
+	std::memcpy(buffer + sizeof(ReceiverRecord), payload, size);
+	return sizeof(ReceiverRecord) + size;
+}
+
+void seissol::writer::ReceiverWriterExecutor::execInit(const async::ExecInfo &info, const seissol::writer::ReceiverInitParam &param)
+{
+	m_bufferSize = param.bufferSize;
+
+	std::stringstream fileName;
+	fileName << static_cast<const char*>(info.buffer(OUTPUT_PREFIX)) << "-receivers-"
+		<< std::setfill('0') << std::setw(5) << seissol::MPI::mpi.rank() << ".bin";
+	m_fileName = fileName.str();
+}
+
+void seissol::writer::ReceiverWriterExecutor::exec(const async::ExecInfo &info, const seissol::writer::ReceiverParam &param)
+{
+	m_stopwatch.start();
+
+	// With ASYNC_MODE=MPI, the buffers of all ranks in the group are concatenated
+	const char* buffer = static_cast<const char*>(info.buffer(RECORDS));
+	const size_t numBuffers = info.bufferSize(RECORDS) / m_bufferSize;
+
+	for (size_t i = 0; i < numBuffers; i++) {
+		const char* records = buffer + i * m_bufferSize;
+		const uint64_t size = *reinterpret_cast<const uint64_t*>(records);
+		if (size == 0)
+			continue;
+
+		if (!m_file) {
+			m_file = fopen(m_fileName.c_str(), "ab");
+			if (!m_file)
+				logError() << "Could not open receiver file" << m_fileName;
+		}
+
+		if (!appendRecords(m_file, records))
+			logError() << "Could not write receivers at time" << param.time << "to" << m_fileName;
+	}
+
+	if (m_file)
+		fflush(m_file);
+
+	m_stopwatch.pause();
+}
+
+bool seissol::writer::ReceiverWriterExecutor::appendRecords(FILE* file, const char* records)
+{
+	uint64_t size;
+	std::memcpy(&size, records, sizeof(uint64_t));
+
+	// Write the header for new files, restarted simulations append to the existing file
+	fseek(file, 0, SEEK_END);
+	if (ftell(file) == 0) {
+		if (fwrite(ReceiverRecord::MAGIC, sizeof(ReceiverRecord::MAGIC), 1, file) != 1
+			|| fwrite(&ReceiverRecord::VERSION, sizeof(uint64_t), 1, file) != 1)
+			return false;
+	}
+
+	return fwrite(records + sizeof(uint64_t), 1, size, file) == size;
+}
+
+void seissol::writer::ReceiverWriterExecutor::finalize()
+{
+	if (m_bufferSize > 0)
+		m_stopwatch.printTime("Time receiver writer backend:");
+
+	if (m_file) {
+		fclose(m_file);
+		m_file = 0L;
+	}
+	m_bufferSize = 0;
+}
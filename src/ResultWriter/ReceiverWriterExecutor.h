@@ -0,0 +1,149 @@
+/**
+ * @file
+ * This file is part of SeisSol.
+ *
+ * @section LICENSE
+ * Copyright (c) 2020, SeisSol Group
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @section DESCRIPTION
+ * Executor for the binary receiver output
+ */
+
+#ifndef RESULTWRITER_RECEIVERWRITEREXECUTOR_H_
+#define RESULTWRITER_RECEIVERWRITEREXECUTOR_H_
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+#include "async/ExecInfo.h"
+
+#include "Monitoring/Stopwatch.h"
+
+namespace seissol
+{
+namespace writer
+{
+
+/**
+ * Header of a record in the binary receiver files.
+ *
+ * A file starts with the magic number and the version, followed by records
+ * that are only appended. The payload of a record is padded to 8 bytes.
+ */
+struct ReceiverRecord
+{
+	enum Type : uint32_t {
+		/** Comma separated names of the columns (as in the ASCII header) */
+		VARIABLES = 0,
+		/** Coordinates of the receiver (3 doubles) and the rank (int64) */
+		POINT = 1,
+		/** Rows of samples (doubles), each row starts with the time */
+		SAMPLES = 2
+	};
+
+	uint32_t type;
+	/** Receiver id (starting at 0) */
+	uint32_t pointId;
+	/** Size of the payload in bytes */
+	uint64_t size;
+
+	static const char MAGIC[8];
+	static const uint64_t VERSION = 1;
+
+	/**
+	 * Writes the header and the payload of a record to the buffer.
+	 *
+	 * @return The number of bytes written
+	 */
+	static size_t write(char* buffer, Type type, unsigned pointId, const void* payload, size_t size);
+};
+
+struct ReceiverInitParam
+{
+	/** Size of the record buffer on each rank */
+	unsigned long bufferSize;
+};
+
+struct ReceiverParam
+{
+	double time;
+};
+
+class ReceiverWriterExecutor
+{
+public:
+	enum BufferIds {
+		OUTPUT_PREFIX = 0,
+		RECORDS = 1
+	};
+
+private:
+	/** The output file, only opened if this executor gets any records */
+	FILE* m_file;
+
+	/** Output file name */
+	std::string m_fileName;
+
+	/** Size of the record buffer of each rank */
+	unsigned long m_bufferSize;
+
+	/** Backend stopwatch */
+	Stopwatch m_stopwatch;
+
+public:
+	ReceiverWriterExecutor()
+		: m_file(0L), m_bufferSize(0)
+	{}
+
+	void execInit(const async::ExecInfo &info, const ReceiverInitParam &param);
+
+	/**
+	 * Appends the records of all ranks to the file.
+	 */
+	void exec(const async::ExecInfo &info, const ReceiverParam &param);
+
+	/**
+	 * Appends the records of a rank to the file. Writes the magic number
+	 * and the version first if the file is empty.
+	 *
+	 * @param records The number of bytes used (uint64_t) followed by the records
+	 * @return False if the records could not be written
+	 */
+	static bool appendRecords(FILE* file, const char* records);
+
+	void finalize();
+};
+
+}
+
+}
+
+#endif // RESULTWRITER_RECEIVERWRITEREXECUTOR_H_
@@ -39,14 +39,44 @@
 
 #include <cassert>
 #include <cstring>
+#include <limits>
+#include <map>
 
 #include "SeisSol.h"
 #include "WaveFieldWriter.h"
+#include "OutputRegions.h"
 #include "Geometry/MeshReader.h"
 #include "Geometry/refinement/MeshRefiner.h"
 #include "Monitoring/instrumentation.fpp"
 #include <Modules/Modules.h>
 
+namespace {
+	/**
+	 * Extracts the elements and their vertices from the mesh. The oldToNewVertexMap maps
+	 * the vertex index of the mesh to the index in subVertices.
+	 */
+	void extractElements(const std::vector<Element>& allElements, const std::vector<Vertex>& allVertices,
+		const std::vector<unsigned int>& elements,
+		std::vector<const Element*>& subElements, std::vector<const Vertex*>& subVertices,
+		std::map<int, int>& oldToNewVertexMap)
+	{
+		for (unsigned int i : elements) {
+			// Push the address of the element into the vector
+			subElements.push_back(&(allElements[i]));
+
+			// Push the vertices into the map which makes sure that the entries are unique
+			for (unsigned int j = 0; j < 4; j++)
+				oldToNewVertexMap.insert(std::pair<int,int>(allElements[i].vertices[j], oldToNewVertexMap.size()));
+		}
+
+		subVertices.resize(oldToNewVertexMap.size());
+
+		// Loop over the map and assign the vertices
+		for (std::map<int,int>::iterator it=oldToNewVertexMap.begin(); it!=oldToNewVertexMap.end(); ++it)
+			subVertices.at(it->second) = &allVertices[it->first];
+	}
+}
+
 void seissol::writer::WaveFieldWriter::setUp()
 {
   setExecutor(m_executor);
@@ -99,24 +129,28 @@ seissol::refinement::TetrahedronRefiner<double>* seissol::writer::WaveFieldWrite
 }
 
 unsigned const* seissol::writer::WaveFieldWriter::adjustOffsets(refinement::MeshRefiner<double>* meshRefiner) {
+  return adjustOffsets(meshRefiner->getCellData(), meshRefiner->getNumCells(), meshRefiner->getNumVertices());
+}
+
+unsigned const* seissol::writer::WaveFieldWriter::adjustOffsets(const unsigned int* cellData, size_t numCells, size_t numVertices) {
   unsigned const* const_cells;
 // Cells are a bit complicated because the vertex filter will now longer work if we just use the buffer
 // We will add the offset later
 #ifdef USE_MPI
 	// Add the offset to the cells
 	MPI_Comm groupComm = seissol::SeisSol::main.asyncIO().groupComm();
-	unsigned int offset = meshRefiner->getNumVertices();
+	unsigned int offset = numVertices;
 	MPI_Scan(MPI_IN_PLACE, &offset, 1, MPI_UNSIGNED, MPI_SUM, groupComm);
-	offset -= meshRefiner->getNumVertices();
+	offset -= numVertices;
 
 	// Add the offset to all cells
-	unsigned int* cells = new unsigned int[meshRefiner->getNumCells() * 4];
-	for (unsigned int i = 0; i < meshRefiner->getNumCells() * 4; i++) {
-		cells[i] = meshRefiner->getCellData()[i] + offset;
+	unsigned int* cells = new unsigned int[numCells * 4];
+	for (unsigned int i = 0; i < numCells * 4; i++) {
+		cells[i] = cellData[i] + offset;
   }
 	const_cells = cells;
 #else // USE_MPI
-	const_cells = meshRefiner->getCellData();
+	const_cells = cellData;
 #endif // USE_MPI
   return const_cells;
 }
@@ -163,9 +197,6 @@ void seissol::writer::WaveFieldWriter::init(unsigned int numVars,
 	// Do not modify this array after the following line
 	param.bufferIds[OUTPUT_FLAGS] = addSyncBuffer(m_outputFlags, numVars*sizeof(bool), true);
 
-	// Setup the tetrahedron refinement strategy
-	refinement::TetrahedronRefiner<double>* tetRefiner = createRefiner(refinement);
-
 	unsigned int numElems = meshReader.getElements().size();
 	unsigned int numVerts = meshReader.getVertices().size();
 
@@ -178,96 +209,149 @@ void seissol::writer::WaveFieldWriter::init(unsigned int numVars,
 	std::map<int, int> oldToNewVertexMap;
 	// Vertices of the extracted region
 	std::vector<const Vertex*> subVertices;
-	// Mesh refiner
+	// Refined cells and vertices of all output parts
+	std::vector<unsigned int> refinedCells;
+	std::vector<double> refinedVertices;
+	// Mesh refiner (only used for the entire region)
 	refinement::MeshRefiner<double>* meshRefiner = 0L;
 
-	// If at least one of the outputRegionBounds is non-zero then extract.
-	// Otherwise use the entire region.
+	// Output regions with their own refinement and output mask
+	OutputRegions outputRegions = OutputRegions::fromEnvironment();
+
+	// If at least one of the outputRegionBounds is non-zero or output regions
+	// are given then extract. Otherwise use the entire region.
 	// m_extractRegion = true  : Extract region
 	// m_extractRegion = false : Entire region
-	m_extractRegion = outputRegionBounds[0] != 0.0 ||
+	bool const useBounds = outputRegionBounds[0] != 0.0 ||
 		outputRegionBounds[1] != 0.0 || outputRegionBounds[2] != 0.0 ||
 		outputRegionBounds[3] != 0.0 || outputRegionBounds[4] != 0.0 ||
 		outputRegionBounds[5] != 0.0;
+	m_extractRegion = useBounds || !outputRegions.empty();
 
 	if (m_extractRegion) {
-		/** Extract the elements and vertices based on user given bounds */
+		/** Extract the elements and vertices based on the output regions and the user given bounds */
 		// Reference to the vector containing all the elements
 		const std::vector<Element>& allElements = meshReader.getElements();
 
 		// Reference to the vector containing all the vertices
 		const std::vector<Vertex>& allVertices = meshReader.getVertices();
 
+		// Sort the elements into the output parts. The last part contains the elements
+		// which are in no output region; they are only written if they are inside the bounds.
+		std::vector<int> elementRegions = outputRegions.assign(meshReader);
+		std::vector<std::vector<unsigned int> > partElements(outputRegions.size() + 1);
+		for (size_t i = 0; i < numElems; i++) {
+			int region = elementRegions[i];
+			if (region == OutputRegions::NoRegion) {
+				if (useBounds &&
+					!vertexInBox(outputRegionBounds, allVertices[allElements[i].vertices[0]].coords) &&
+					!vertexInBox(outputRegionBounds, allVertices[allElements[i].vertices[1]].coords) &&
+					!vertexInBox(outputRegionBounds, allVertices[allElements[i].vertices[2]].coords) &&
+					!vertexInBox(outputRegionBounds, allVertices[allElements[i].vertices[3]].coords))
+					continue;
+				region = outputRegions.size();
+			}
+			partElements[region].push_back(i);
+		}
+
 		// m_map will store a new map from new cell index to dof index
 		// the old map is contained in the "map" variable - which is a map from old
 		//    cell index to dof index
 		m_map = new unsigned int[numElems];
 
-		// Extract elements based on the region specified
-		for (size_t i = 0; i < numElems; i++) {
-			// Store the current number of elements to check if new was added
-			if (vertexInBox(outputRegionBounds, allVertices[allElements[i].vertices[0]].coords) ||
-				vertexInBox(outputRegionBounds, allVertices[allElements[i].vertices[1]].coords) ||
-				vertexInBox(outputRegionBounds, allVertices[allElements[i].vertices[2]].coords) ||
-				vertexInBox(outputRegionBounds, allVertices[allElements[i].vertices[3]].coords)) {
-
-				// Assign the new map
-				m_map[subElements.size()] = map[i];
-
-				// Push the address of the element into the vector
-				subElements.push_back(&(allElements[i]));
-
-				// Push the vertices into the map which makes sure that the entries are unique
-				oldToNewVertexMap.insert(std::pair<int,int>(allElements[i].vertices[0], oldToNewVertexMap.size()));
-				oldToNewVertexMap.insert(std::pair<int,int>(allElements[i].vertices[1], oldToNewVertexMap.size()));
-				oldToNewVertexMap.insert(std::pair<int,int>(allElements[i].vertices[2], oldToNewVertexMap.size()));
-				oldToNewVertexMap.insert(std::pair<int,int>(allElements[i].vertices[3], oldToNewVertexMap.size()));
+		// The cells are ordered by output part
+		std::vector<unsigned int> elements;
+		for (unsigned int p = 0; p < partElements.size(); p++) {
+			if (partElements[p].empty())
+				continue;
+
+			OutputPart part;
+			part.firstCell = elements.size();
+			part.firstSubCell = refinedCells.size() / 4;
+			for (unsigned int i = 0; i < numVars; i++)
+				part.outputFlags.push_back(m_outputFlags[i] && (p == outputRegions.size() || outputRegions[p].isOutput(i)));
+
+			for (unsigned int i : partElements[p]) {
+				m_map[elements.size()] = map[i];
+				elements.push_back(i);
 			}
-		}
 
-		subVertices.resize(oldToNewVertexMap.size());
+			// Refine the part with its own strategy
+			refinement::TetrahedronRefiner<double>* tetRefiner = createRefiner(
+				p < outputRegions.size() ? outputRegions[p].refinement : refinement);
 
-		// Loop over the map and assign the vertices
-		for (std::map<int,int>::iterator it=oldToNewVertexMap.begin(); it!=oldToNewVertexMap.end(); ++it)
-			subVertices.at(it->second) = &allVertices[it->first];
+			std::vector<const Element*> partSubElements;
+			std::map<int, int> partVertexMap;
+			std::vector<const Vertex*> partSubVertices;
+			extractElements(allElements, allVertices, partElements[p], partSubElements, partSubVertices, partVertexMap);
+
+			refinement::MeshRefiner<double> partRefiner(partSubElements, partSubVertices,
+				partVertexMap, *tetRefiner);
+
+			// The vertices of each part are numbered after the vertices of the previous parts
+			const unsigned int vertexOffset = refinedVertices.size() / 3;
+			for (size_t i = 0; i < partRefiner.getNumCells() * 4; i++)
+				refinedCells.push_back(partRefiner.getCellData()[i] + vertexOffset);
+			refinedVertices.insert(refinedVertices.end(), partRefiner.getVertexData(),
+				partRefiner.getVertexData() + partRefiner.getNumVertices() * 3);
+
+			part.numSubCells = partRefiner.getNumCells();
+			part.subsampler = new refinement::VariableSubsampler<double>(
+				partElements[p].size(), *tetRefiner, order, numVars, numAlignedDOF);
+			m_parts.push_back(part);
+
+			delete tetRefiner;
+		}
+
+		extractElements(allElements, allVertices, elements, subElements, subVertices, oldToNewVertexMap);
 
 		numElems = subElements.size();
 		numVerts = subVertices.size();
-
-		meshRefiner = new refinement::MeshRefiner<double>(subElements, subVertices,
-			oldToNewVertexMap, *tetRefiner);
 	} else {
+		// Setup the tetrahedron refinement strategy
+		refinement::TetrahedronRefiner<double>* tetRefiner = createRefiner(refinement);
+
 		meshRefiner = new refinement::MeshRefiner<double>(meshReader, *tetRefiner);
+
+		OutputPart part;
+		part.firstCell = 0;
+		part.firstSubCell = 0;
+		part.numSubCells = meshRefiner->getNumCells();
+		part.outputFlags.assign(m_outputFlags, m_outputFlags + numVars);
+		part.subsampler = new refinement::VariableSubsampler<double>(
+			numElems, *tetRefiner, order, numVars, numAlignedDOF);
+		m_parts.push_back(part);
+
+		// Delete the tetRefiner since it is no longer required
+		delete tetRefiner;
 	}
 
+	const size_t numCells = meshRefiner ? meshRefiner->getNumCells() : refinedCells.size() / 4;
+	const size_t numVertices = meshRefiner ? meshRefiner->getNumVertices() : refinedVertices.size() / 3;
+	const unsigned int* cellData = meshRefiner ? meshRefiner->getCellData() : refinedCells.data();
+	const double* vertexData = meshRefiner ? meshRefiner->getVertexData() : refinedVertices.data();
+
 	logInfo(rank) << "Refinement class initialized";
 	logDebug() << "Cells : "
 			<< numElems << "refined-to ->"
-			<< meshRefiner->getNumCells();
+			<< numCells;
 	logDebug() << "Vertices : "
 			<< numVerts << "refined-to ->"
-			<< meshRefiner->getNumVertices();
-
-	// Initialize the variable subsampler
-	m_variableSubsampler = new refinement::VariableSubsampler<double>(
-			numElems, *tetRefiner, order, numVars, numAlignedDOF);
+			<< numVertices;
 
 	logInfo(rank) << "VariableSubsampler initialized";
 
-	// Delete the tetRefiner since it is no longer required
-	delete tetRefiner;
-
-	const unsigned int* const_cells = adjustOffsets(meshRefiner);
+	const unsigned int* const_cells = adjustOffsets(cellData, numCells, numVertices);
 
 	// Create mesh buffers
-	param.bufferIds[CELLS] = addSyncBuffer(const_cells, meshRefiner->getNumCells() * 4 * sizeof(unsigned int));
-	param.bufferIds[VERTICES] = addSyncBuffer(meshRefiner->getVertexData(), meshRefiner->getNumVertices() * 3 * sizeof(double));
+	param.bufferIds[CELLS] = addSyncBuffer(const_cells, numCells * 4 * sizeof(unsigned int));
+	param.bufferIds[VERTICES] = addSyncBuffer(vertexData, numVertices * 3 * sizeof(double));
 
 	// Create data buffers
 	bool first = false;
 	for (unsigned int i = 0; i < numVars; i++) {
 		if (m_outputFlags[i]) {
-			unsigned int id = addBuffer(0L, meshRefiner->getNumCells() * sizeof(double));
+			unsigned int id = addBuffer(0L, numCells * sizeof(double));
 			if (!first) {
 				param.bufferIds[VARIABLE0] = id;
 				first = true;
@@ -276,7 +360,7 @@ void seissol::writer::WaveFieldWriter::init(unsigned int numVars,
 	}
 
 	// Save number of cells
-	m_numCells = meshRefiner->getNumCells();
+	m_numCells = numCells;
 	// Set up for low order output flags
 	m_lowOutputFlags = new bool[WaveFieldWriterExecutor::NUM_LOWVARIABLES];
 	m_numIntegratedVariables = seissol::SeisSol::main.postProcessor().getNumberOfVariables();
@@ -339,8 +423,8 @@ void seissol::writer::WaveFieldWriter::init(unsigned int numVars,
 
 	sendBuffer(param.bufferIds[OUTPUT_FLAGS], numVars*sizeof(bool));
 
-	sendBuffer(param.bufferIds[CELLS], meshRefiner->getNumCells() * 4 * sizeof(unsigned int));
-	sendBuffer(param.bufferIds[VERTICES], meshRefiner->getNumVertices() * 3 * sizeof(double));
+	sendBuffer(param.bufferIds[CELLS], numCells * 4 * sizeof(unsigned int));
+	sendBuffer(param.bufferIds[VERTICES], numVertices * 3 * sizeof(double));
 
 	if (pstrain || integrals) {
 		sendBuffer(param.bufferIds[LOWCELLS], pLowMeshRefiner->getNumCells() * 4 * sizeof(unsigned int));
@@ -403,17 +487,39 @@ void seissol::writer::WaveFieldWriter::write(double time)
 
 	logInfo(rank) << "Writing wave field at time" << utils::nospace <<  time << '.';
 
+	// Subsample all variables in one pass, directly into the managed buffers
+	std::vector<double*> managedBuffers(m_numVariables, nullptr);
 	unsigned int nextId = m_variableBufferIds[0];
 	for (unsigned int i = 0; i < m_numVariables; i++) {
 		if (!m_outputFlags[i])
 			continue;
 
-		double* managedBuffer = async::Module<WaveFieldWriterExecutor,
+		managedBuffers[i] = async::Module<WaveFieldWriterExecutor,
 				WaveFieldInitParam, WaveFieldParam>::managedBuffer<double*>(nextId);
-		m_variableSubsampler->get(m_dofs, m_map, i, managedBuffer);
+		nextId++;
+	}
+	std::vector<double*> partBuffers(m_numVariables);
+	for (auto const& part : m_parts) {
+		for (unsigned int i = 0; i < m_numVariables; i++) {
+			partBuffers[i] = (managedBuffers[i] && part.outputFlags[i]) ? managedBuffers[i] + part.firstSubCell : nullptr;
+		}
+		part.subsampler->get(m_dofs, m_map + part.firstCell, partBuffers.data());
 
-		sendBuffer(nextId, m_numCells*sizeof(double));
+		// Variables which are not written in this part (but in another one)
+		for (unsigned int i = 0; i < m_numVariables; i++) {
+			if (managedBuffers[i] && !part.outputFlags[i]) {
+				std::fill_n(managedBuffers[i] + part.firstSubCell, part.numSubCells,
+					std::numeric_limits<double>::quiet_NaN());
+			}
+		}
+	}
+
+	nextId = m_variableBufferIds[0];
+	for (unsigned int i = 0; i < m_numVariables; i++) {
+		if (!m_outputFlags[i])
+			continue;
 
+		sendBuffer(nextId, m_numCells*sizeof(double));
 		nextId++;
 	}
 
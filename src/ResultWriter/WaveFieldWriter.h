@@ -88,8 +88,22 @@ class WaveFieldWriter : private async::Module<WaveFieldWriterExecutor, WaveField
 	/** The output prefix for the filename */
 	std::string m_outputPrefix;
 
-	/** The variable subsampler for the refined mesh */
-	refinement::VariableSubsampler<double>* m_variableSubsampler;
+	/** Cells of the output with the same refinement and output mask */
+	struct OutputPart {
+		/** The variable subsampler for the refined cells */
+		refinement::VariableSubsampler<double>* subsampler;
+		/** First cell of the part in m_map */
+		unsigned int firstCell;
+		/** First refined cell of the part in the output */
+		unsigned int firstSubCell;
+		/** Number of refined cells */
+		unsigned int numSubCells;
+		/** Variables written for this part (a subset of m_outputFlags) */
+		std::vector<bool> outputFlags;
+	};
+
+	/** The output parts, one for each output region and one for the remaining cells */
+	std::vector<OutputPart> m_parts;
 
 	/** Number of variables */
 	unsigned int m_numVariables;
@@ -140,11 +154,13 @@ class WaveFieldWriter : private async::Module<WaveFieldWriterExecutor, WaveField
   
   unsigned const* adjustOffsets(refinement::MeshRefiner<double>* meshRefiner);
 
+  /** Adds the vertex offset of this rank to the cells */
+  unsigned const* adjustOffsets(const unsigned int* cellData, size_t numCells, size_t numVertices);
+
 public:
 	WaveFieldWriter()
 		: m_enabled(false),
 		  m_extractRegion(false),
-		  m_variableSubsampler(0L),
 		  m_numVariables(0),
 		  m_outputFlags(0L),
 		  m_lowOutputFlags(0L),
@@ -187,6 +203,9 @@ public:
 	/**
 	 * Initialize the wave field ouput
 	 *
+	 * The output regions given by SEISSOL_OUTPUT_REGIONS (see OutputRegions) overwrite
+	 * the refinement and the output mask for their cells.
+	 *
 	 * @param map The mapping from the cell order to dofs order
 	 * @param timeTolerance The tolerance in the time for ignoring duplicate time steps
 	 */
@@ -218,8 +237,9 @@ public:
 
 		m_stopwatch.printTime("Time wave field writer frontend:");
 
-		delete m_variableSubsampler;
-		m_variableSubsampler = 0L;
+		for (auto& part : m_parts)
+			delete part.subsampler;
+		m_parts.clear();
 		delete [] m_outputFlags;
 		m_outputFlags = 0L;
 		delete [] m_lowOutputFlags;
@@ -79,6 +79,8 @@ CONTAINS
     USE TypesDef
     USE create_fault_rotationmatrix_mod
     USE DGBasis_mod
+    USE f_ftoc_bind_interoperability
+    USE iso_c_binding
 
     IMPLICIT NONE
 
@@ -89,31 +91,25 @@ CONTAINS
 
     !local variables
     REAL                    :: tolerance  ! tolerance if the receiver belongs to this element
-    REAL                    :: xmin,xmax,ymin,ymax,zmin,zmax ! Maximum extend of computational domain
-    INTEGER                 :: i, j, iFault, iElem, iSide
+    INTEGER                 :: i, iFault, iElem, nOutPoints
     REAL                    :: io_x, io_y, io_z              ! temp store of receiver location
     REAL                    :: xV(MESH%nVertexMax)
     REAL                    :: yV(MESH%nVertexMax)
     REAL                    :: zV(MESH%nVertexMax)
     REAL                    :: xi,eta,zeta
+    REAL(kind=c_double), ALLOCATABLE    :: points(:,:)
+    INTEGER(kind=c_int), ALLOCATABLE    :: faultIds(:)
 
     ! tolerance if the receiver belongs to this element
     tolerance = 1.0e-5
-    !
-    ! Maximum extend of computational domain
-    xmin = MINVAL( MESH%VRTX%xyNode(1,:) )
-    xmax = MAXVAL( MESH%VRTX%xyNode(1,:) )
-    ymin = MINVAL( MESH%VRTX%xyNode(2,:) )
-    ymax = MAXVAL( MESH%VRTX%xyNode(2,:) )
-    zmin = MINVAL( MESH%VRTX%xyNode(3,:) )
-    zmax = MAXVAL( MESH%VRTX%xyNode(3,:) )
+    nOutPoints = DISC%DynRup%DynRup_out_atPickpoint%nOutPoints
     !
     ! Assume that the point is not inside the domain
     DISC%DynRup%DynRup_out_atPickpoint%RecPoint(:)%inside =.false.
     DISC%DynRup%DynRup_out_atPickpoint%RecPoint(:)%index  = -1
     !
     ! ALLOCATE local list
-    ALLOCATE(LocalRecPoint(DISC%DynRup%DynRup_out_atPickpoint%nOutPoints))
+    ALLOCATE(LocalRecPoint(nOutPoints))
     LocalRecPoint(:)%inside = .false.
     LocalRecPoint(:)%index = -1
     LocalRecPoint(:)%globalreceiverindex = -1
@@ -121,47 +117,42 @@ CONTAINS
     LocalRecPoint(:)%Y = 0.0D0
     LocalRecPoint(:)%Z = 0.0D0
 
+    ! Find the first fault face whose '+' element contains the receiver
+    ALLOCATE(points(3,nOutPoints), faultIds(nOutPoints))
+    points(1,:) = DISC%DynRup%DynRup_out_atPickpoint%RecPoint(:)%X
+    points(2,:) = DISC%DynRup%DynRup_out_atPickpoint%RecPoint(:)%Y
+    points(3,:) = DISC%DynRup%DynRup_out_atPickpoint%RecPoint(:)%Z
+    CALL c_interoperability_findFaultReceivers(nOutPoints, points, tolerance, faultIds)
+
     ! Loop over all fault output receivers (i)
     in = 0
-    DO i=1, DISC%DynRup%DynRup_out_atPickpoint%nOutPoints
+    DO i=1, nOutPoints
+       iFault = faultIds(i)
+       IF (iFault == 0) CYCLE   ! receiver not on this rank
        !
        io_x = DISC%DynRup%DynRup_out_atPickpoint%RecPoint(i)%X
        io_y = DISC%DynRup%DynRup_out_atPickpoint%RecPoint(i)%Y
        io_z = DISC%DynRup%DynRup_out_atPickpoint%RecPoint(i)%Z
+       iElem = MESH%Fault%Face(iFault,1,1)
        !
-       IF (     (io_x.GE.xmin).and.(io_x.LE.xmax)   &
-           .and.(io_y.GE.ymin).and.(io_y.LE.ymax)   &
-           .and.(io_z.GE.zmin).and.(io_z.LE.zmax)    ) THEN
-          !
-          DO iFault = 1, MESH%Fault%nSide
-             !
-             iElem               = MESH%Fault%Face(iFault,1,1)
-             iSide               = MESH%Fault%Face(iFault,2,1)
-             IF (iElem == 0) CYCLE   ! put receiver only in '+' elements
-             !
-             IF (XYZInElement(io_x, io_y, io_z, iElem,tolerance,MESH,DISC)) THEN
-                LocalRecPoint(i)%inside = .true. ! Point is located in an element
-                LocalRecPoint(i)%globalreceiverindex = i
-                LocalRecPoint(i)%X = io_x
-                LocalRecPoint(i)%Y = io_y
-                LocalRecPoint(i)%Z = io_z
-                LocalRecPoint(i)%index  = iFault  ! number in Fault%Face list!
-                xV(1:4) = MESH%VRTX%xyNode(1,MESH%ELEM%Vertex(1:4,iElem))
-                yV(1:4) = MESH%VRTX%xyNode(2,MESH%ELEM%Vertex(1:4,iElem))
-                zV(1:4) = MESH%VRTX%xyNode(3,MESH%ELEM%Vertex(1:4,iElem))
-                CALL TrafoXYZ2XiEtaZeta(xi,eta,zeta,io_x,io_y,io_z,xV,yV,zV,MESH%LocalVrtxType(iElem))
-                LocalRecPoint(i)%xi   = xi
-                LocalRecPoint(i)%eta  = eta
-                LocalRecPoint(i)%zeta = zeta
-                in = in + 1
-                EXIT
-             ENDIF
-          ENDDO ! iFace loop
-          !
-       ENDIF ! receiver within domain
-       !
+       LocalRecPoint(i)%inside = .true. ! Point is located in an element
+       LocalRecPoint(i)%globalreceiverindex = i
+       LocalRecPoint(i)%X = io_x
+       LocalRecPoint(i)%Y = io_y
+       LocalRecPoint(i)%Z = io_z
+       LocalRecPoint(i)%index  = iFault  ! number in Fault%Face list!
+       xV(1:4) = MESH%VRTX%xyNode(1,MESH%ELEM%Vertex(1:4,iElem))
+       yV(1:4) = MESH%VRTX%xyNode(2,MESH%ELEM%Vertex(1:4,iElem))
+       zV(1:4) = MESH%VRTX%xyNode(3,MESH%ELEM%Vertex(1:4,iElem))
+       CALL TrafoXYZ2XiEtaZeta(xi,eta,zeta,io_x,io_y,io_z,xV,yV,zV,MESH%LocalVrtxType(iElem))
+       LocalRecPoint(i)%xi   = xi
+       LocalRecPoint(i)%eta  = eta
+       LocalRecPoint(i)%zeta = zeta
+       in = in + 1
     ENDDO ! Loop over all fault output receivers (i)
 
+    DEALLOCATE(points, faultIds)
+
   END SUBROUTINE
 
 
@@ -71,6 +71,7 @@ CONTAINS
       !-------------------------------------------------------------------------!
       USE JacobiNormal_mod
       USE magnitude_output_mod
+      USE f_ftoc_bind_interoperability
       !-------------------------------------------------------------------------!
       IMPLICIT NONE
       !-------------------------------------------------------------------------!
@@ -102,6 +103,8 @@ CONTAINS
       IF (DISC%DynRup%energy_rate_output_on.EQ.1) THEN
          IF ( MOD(DISC%iterationstep,DISC%DynRup%energy_rate_printtimeinterval).EQ.0 &
          .OR. (DISC%EndTime-time).LE.(dt*1.005d0) ) THEN
+            ! the layer-wise friction solver keeps the friction state in C++
+            CALL c_interoperability_synchronizeFrictionState()
             CALL energy_rate_output(MaterialVal,time,DISC,MESH,MPI,IO)
          ENDIF
       ENDIF
@@ -133,6 +136,7 @@ CONTAINS
          ELSE
             RETURN
          ENDIF
+         CALL c_interoperability_synchronizeFrictionState()
          CALL calc_FaultOutput(DISC%DynRup%DynRup_out_atPickpoint, DISC, EQN, MESH, MaterialVal, BND, time)
          CALL write_FaultOutput_atPickpoint(EQN, DISC, MESH, IO, MPI, MaterialVal, BND, time, dt)
 
@@ -193,6 +197,7 @@ CONTAINS
          ENDIF
          !
          IF (isOnPickpoint) THEN
+           CALL c_interoperability_synchronizeFrictionState()
            CALL calc_FaultOutput(DISC%DynRup%DynRup_out_atPickpoint, DISC, EQN, MESH, MaterialVal, BND, time)
            CALL write_FaultOutput_atPickpoint(EQN, DISC, MESH, IO, MPI, MaterialVal, BND, time, dt)
          ENDIF
@@ -86,6 +86,7 @@ bool seissol::SeisSol::init(int argc, char* argv[])
 #endif
 
 	MPI::mpi.init(argc, argv);
+	m_setupStopwatch.start();
 
 	// TODO is there a reason to have this here?
 	// If not please move it to the end if this function
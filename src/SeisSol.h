@@ -48,7 +48,10 @@
 #include "Solver/time_stepping/TimeManager.h"
 #include "Solver/Simulator.h"
 #include "Solver/FreeSurfaceIntegrator.h"
+#include "Solver/GroundMotionMaps.h"
 #include "Initializer/time_stepping/LtsLayout.h"
+#include "Initializer/InitializationCache.h"
+#include "Initializer/PhysicsFeatures.h"
 #include "Checkpoint/Manager.h"
 #include "SourceTerm/Manager.h"
 #include "ResultWriter/PostProcessor.h"
@@ -62,6 +65,7 @@
 #include <memory>
 
 #include "Parallel/Pin.h"
+#include "Monitoring/Stopwatch.h"
 
 class MeshReader;
 
@@ -115,6 +119,9 @@ private:
         
   /** Free surface integrator module **/
   solver::FreeSurfaceIntegrator m_freeSurfaceIntegrator;
+
+  /** Peak ground motions on the free surface **/
+  solver::GroundMotionMaps m_groundMotionMaps;
         
   /** Free surface writer module **/
   writer::FreeSurfaceWriter m_freeSurfaceWriter;
@@ -132,6 +139,15 @@ private:
   //! Receiver writer module
   writer::ReceiverWriter m_receiverWriter;
 
+  //! Measures the time since the initialization of MPI
+  Stopwatch m_setupStopwatch;
+
+  //! Cache of derived initialization data
+  initializers::InitializationCache m_initializationCache;
+
+  //! Optional physics of the simulation
+  initializers::PhysicsFeatures m_physicsFeatures;
+
 
 private:
 	/**
@@ -166,6 +182,14 @@ public:
 	 */
 	void finalize();
 
+	/**
+	 * Wall time since the initialization of MPI
+	 */
+	double setupTime()
+	{
+		return m_setupStopwatch.split();
+	}
+
 	const char* parameterFile() const
 	{
 		return m_parameterFile.c_str();
@@ -184,6 +208,16 @@ public:
 
 	Simulator& simulator() { return m_simulator; }
 
+	initializers::InitializationCache& initializationCache()
+	{
+		return m_initializationCache;
+	}
+
+	initializers::PhysicsFeatures& physicsFeatures()
+	{
+		return m_physicsFeatures;
+	}
+
 	checkpoint::Manager& checkPointManager()
 	{
 		return m_checkPointManager;
@@ -199,6 +233,11 @@ public:
 		return m_freeSurfaceIntegrator;
 	}
 
+	solver::GroundMotionMaps& groundMotionMaps()
+	{
+		return m_groundMotionMaps;
+	}
+
 	writer::FreeSurfaceWriter& freeSurfaceWriter()
 	{
 		return m_freeSurfaceWriter;
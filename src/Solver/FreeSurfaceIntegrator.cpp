@@ -119,40 +119,48 @@ void seissol::solver::FreeSurfaceIntegrator::calculateOutput()
     #pragma omp parallel for schedule(static)
 #endif // _OPENMP
     for (unsigned face = 0; face < surfaceLayer->getNumberOfCells(); ++face) {
-      real subTriangleDofs[tensor::subTriangleDofs::size(FREESURFACE_MAX_REFINEMENT)] __attribute__((aligned(ALIGNMENT)));
+      real subTriangleVelocities[tensor::subTriangleDofs::size(FREESURFACE_MAX_REFINEMENT)] __attribute__((aligned(ALIGNMENT)));
+      real subTriangleDisplacements[tensor::subTriangleDofs::size(FREESURFACE_MAX_REFINEMENT)] __attribute__((aligned(ALIGNMENT)));
 
-      kernel::subTriangleVelocity vkrnl;
-      vkrnl.Q = dofs[face];
-      vkrnl.selectVelocity = init::selectVelocity::Values;
-      vkrnl.subTriangleProjection(triRefiner.maxDepth) = projectionMatrix[ side[face] ];
-      vkrnl.subTriangleDofs(triRefiner.maxDepth) = subTriangleDofs;
-      vkrnl.execute(triRefiner.maxDepth);
+      projectOntoSubTriangles(dofs[face], displacementDofs[face], side[face], subTriangleVelocities, subTriangleDisplacements);
 
-      auto addOutput = [&] (double* output[FREESURFACE_NUMBER_OF_COMPONENTS]) {
+      auto addOutput = [&] (double* output[FREESURFACE_NUMBER_OF_COMPONENTS], real const* subTriangleDofs) {
         for (unsigned component = 0; component < FREESURFACE_NUMBER_OF_COMPONENTS; ++component) {
           double* target = output[component] + offset + face * numberOfSubTriangles;
           /// @yateto_todo fix for multiple simulations
-          real* source = subTriangleDofs + component * numberOfAlignedSubTriangles; 
+          real const* source = subTriangleDofs + component * numberOfAlignedSubTriangles; 
           for (unsigned subtri = 0; subtri < numberOfSubTriangles; ++subtri) {
             target[subtri] = source[subtri];
           }
         }
       };
 
-      addOutput(velocities);
-
-      kernel::subTriangleDisplacement dkrnl;
-      dkrnl.displacement = displacementDofs[face];
-      dkrnl.subTriangleProjection(triRefiner.maxDepth) = projectionMatrix[ side[face] ];
-      dkrnl.subTriangleDofs(triRefiner.maxDepth) = subTriangleDofs;
-      dkrnl.execute(triRefiner.maxDepth);
-
-      addOutput(displacements);
+      addOutput(velocities, subTriangleVelocities);
+      addOutput(displacements, subTriangleDisplacements);
     }
     offset += surfaceLayer->getNumberOfCells() * numberOfSubTriangles;
   }
 }
 
+void seissol::solver::FreeSurfaceIntegrator::projectOntoSubTriangles( real const* dofs,
+                                                                      real const* displacementDofs,
+                                                                      unsigned side,
+                                                                      real* subTriangleVelocities,
+                                                                      real* subTriangleDisplacements ) const
+{
+  kernel::subTriangleVelocity vkrnl;
+  vkrnl.Q = dofs;
+  vkrnl.selectVelocity = init::selectVelocity::Values;
+  vkrnl.subTriangleProjection(triRefiner.maxDepth) = projectionMatrix[side];
+  vkrnl.subTriangleDofs(triRefiner.maxDepth) = subTriangleVelocities;
+  vkrnl.execute(triRefiner.maxDepth);
+
+  kernel::subTriangleDisplacement dkrnl;
+  dkrnl.displacement = displacementDofs;
+  dkrnl.subTriangleProjection(triRefiner.maxDepth) = projectionMatrix[side];
+  dkrnl.subTriangleDofs(triRefiner.maxDepth) = subTriangleDisplacements;
+  dkrnl.execute(triRefiner.maxDepth);
+}
 
 void seissol::solver::FreeSurfaceIntegrator::initializeProjectionMatrices(unsigned maxRefinementDepth)
 {
@@ -105,6 +105,19 @@ public:
                     seissol::initializers::Lut* ltsLut );
 
   void calculateOutput();
+
+  /**
+   * Projects the velocity and the displacement of one free surface face onto its sub triangles.
+   * Both outputs hold FREESURFACE_NUMBER_OF_COMPONENTS rows of getNumberOfAlignedSubTriangles() entries.
+   **/
+  void projectOntoSubTriangles( real const* dofs,
+                                real const* displacementDofs,
+                                unsigned side,
+                                real* subTriangleVelocities,
+                                real* subTriangleDisplacements ) const;
+
+  unsigned getNumberOfSubTriangles() const { return numberOfSubTriangles; }
+  unsigned getNumberOfAlignedSubTriangles() const { return numberOfAlignedSubTriangles; }
   
   bool enabled() const { return m_enabled; }
 };
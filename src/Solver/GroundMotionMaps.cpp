@@ -0,0 +1,188 @@
+/**
+ * @file
+ * This file is part of SeisSol.
+ *
+ * @section LICENSE
+ * Copyright (c) 2020, SeisSol Group
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @section DESCRIPTION
+ * In-situ peak ground motions and response spectra on the free surface.
+ **/
+
+#include "GroundMotionMaps.h"
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+#include <sstream>
+
+#include <Initializer/tree/Layer.hpp>
+#include <Kernels/common.hpp>
+#include <Parallel/MPI.h>
+#include <Solver/FreeSurfaceIntegrator.h>
+#include <utils/env.h>
+#include <utils/logger.h>
+
+void seissol::solver::GroundMotionMaps::initialize(FreeSurfaceIntegrator* freeSurfaceIntegrator)
+{
+  if (!utils::Env::get<bool>("SEISSOL_GROUND_MOTION_MAPS", false)) {
+    return;
+  }
+  if constexpr (seissol::isDeviceOn()) {
+    logWarning(seissol::MPI::mpi.rank()) << "Ground motion maps are not supported on GPUs.";
+    return;
+  }
+
+  std::vector<double> periods = parsePeriods(utils::Env::get<std::string>("SEISSOL_GROUND_MOTION_PERIODS", "0.3,1.0,3.0"));
+  if (periods.size() > GROUNDMOTION_MAX_PERIODS) {
+    logError() << "At most" << GROUNDMOTION_MAX_PERIODS << "periods are supported for the ground motion maps.";
+  }
+  initialize(freeSurfaceIntegrator, periods);
+}
+
+void seissol::solver::GroundMotionMaps::initialize(FreeSurfaceIntegrator* freeSurfaceIntegrator, std::vector<double> const& periods)
+{
+  m_freeSurfaceIntegrator = freeSurfaceIntegrator;
+  m_periods = periods;
+
+  seissol::initializers::LTSTree& surfaceLtsTree = m_freeSurfaceIntegrator->surfaceLtsTree;
+  unsigned const numberOfSubTriangles = m_freeSurfaceIntegrator->getNumberOfSubTriangles();
+  unsigned offset = 0;
+  m_clusterOffsets.resize(surfaceLtsTree.numChildren());
+  for (unsigned cluster = 0; cluster < surfaceLtsTree.numChildren(); ++cluster) {
+    m_clusterOffsets[cluster] = offset;
+    offset += (surfaceLtsTree.child(cluster).child<Copy>().getNumberOfCells()
+             + surfaceLtsTree.child(cluster).child<Interior>().getNumberOfCells()) * numberOfSubTriangles;
+  }
+  unsigned const numberOfTriangles = m_freeSurfaceIntegrator->totalNumberOfTriangles;
+  assert(offset == numberOfTriangles);
+
+  allocate(numberOfTriangles);
+
+  std::stringstream periodList;
+  for (auto period : m_periods) {
+    periodList << ' ' << period;
+  }
+  logInfo(seissol::MPI::mpi.rank()) << "Ground motion maps enabled. Periods of the response spectra:" << periodList.str();
+}
+
+void seissol::solver::GroundMotionMaps::allocate(unsigned numberOfTriangles)
+{
+  // The first update of a triangle only stores its velocity, which may be non-zero after a restart or due to the
+  // initial condition
+  for (unsigned dim = 0; dim < 2; ++dim) {
+    m_lastVelocities[dim].assign(numberOfTriangles, std::numeric_limits<double>::quiet_NaN());
+  }
+  m_oscillators.assign(4 * m_periods.size() * numberOfTriangles, 0.0);
+  m_maps.assign(SA0 + m_periods.size(), std::vector<double>(numberOfTriangles, 0.0));
+}
+
+void seissol::solver::GroundMotionMaps::accumulate(unsigned cluster, double timeStepWidth)
+{
+  std::vector<Oscillator> oscillators;
+  for (auto period : m_periods) {
+    oscillators.emplace_back(period, Damping, timeStepWidth);
+  }
+  unsigned const numberOfPeriods = m_periods.size();
+  unsigned const numberOfSubTriangles = m_freeSurfaceIntegrator->getNumberOfSubTriangles();
+  unsigned const numberOfAlignedSubTriangles = m_freeSurfaceIntegrator->getNumberOfAlignedSubTriangles();
+  auto const& surfaceLts = m_freeSurfaceIntegrator->surfaceLts;
+  auto& surfaceCluster = m_freeSurfaceIntegrator->surfaceLtsTree.child(cluster);
+
+  unsigned offset = m_clusterOffsets[cluster];
+  for (auto* surfaceLayer : {&surfaceCluster.child<Copy>(), &surfaceCluster.child<Interior>()}) {
+    real** dofs             = surfaceLayer->var(surfaceLts.dofs);
+    real** displacementDofs = surfaceLayer->var(surfaceLts.displacementDofs);
+    unsigned* side          = surfaceLayer->var(surfaceLts.side);
+
+#ifdef _OPENMP
+    #pragma omp parallel for schedule(static)
+#endif // _OPENMP
+    for (unsigned face = 0; face < surfaceLayer->getNumberOfCells(); ++face) {
+      real subTriangleVelocities[tensor::subTriangleDofs::size(FREESURFACE_MAX_REFINEMENT)] __attribute__((aligned(ALIGNMENT)));
+      real subTriangleDisplacements[tensor::subTriangleDofs::size(FREESURFACE_MAX_REFINEMENT)] __attribute__((aligned(ALIGNMENT)));
+
+      m_freeSurfaceIntegrator->projectOntoSubTriangles(dofs[face], displacementDofs[face], side[face], subTriangleVelocities, subTriangleDisplacements);
+
+      for (unsigned subtri = 0; subtri < numberOfSubTriangles; ++subtri) {
+        double velocity[2], displacement[2];
+        for (unsigned dim = 0; dim < 2; ++dim) {
+          velocity[dim] = subTriangleVelocities[dim * numberOfAlignedSubTriangles + subtri];
+          displacement[dim] = subTriangleDisplacements[dim * numberOfAlignedSubTriangles + subtri];
+        }
+        update(offset + face * numberOfSubTriangles + subtri, velocity, displacement, timeStepWidth, oscillators);
+      }
+    }
+    offset += surfaceLayer->getNumberOfCells() * numberOfSubTriangles;
+  }
+}
+
+void seissol::solver::GroundMotionMaps::update(unsigned triangle,
+                                               double const velocity[2],
+                                               double const displacement[2],
+                                               double timeStepWidth,
+                                               std::vector<Oscillator> const& oscillators)
+{
+  bool const first = std::isnan(m_lastVelocities[0][triangle]);
+  double acceleration[2];
+  for (unsigned dim = 0; dim < 2; ++dim) {
+    acceleration[dim] = first ? 0.0 : (velocity[dim] - m_lastVelocities[dim][triangle]) / timeStepWidth;
+    m_lastVelocities[dim][triangle] = velocity[dim];
+  }
+
+  m_maps[PGA][triangle] = std::max(m_maps[PGA][triangle], std::hypot(acceleration[0], acceleration[1]));
+  m_maps[PGV][triangle] = std::max(m_maps[PGV][triangle], std::hypot(velocity[0], velocity[1]));
+  m_maps[PGD][triangle] = std::max(m_maps[PGD][triangle], std::hypot(displacement[0], displacement[1]));
+
+  unsigned const numberOfPeriods = m_periods.size();
+  double* state = &m_oscillators[4 * numberOfPeriods * triangle];
+  for (unsigned period = 0; period < numberOfPeriods; ++period, state += 4) {
+    oscillators[period].update(acceleration[0], state[0], state[1]);
+    oscillators[period].update(acceleration[1], state[2], state[3]);
+    double const sa = oscillators[period].omega2 * std::hypot(state[0], state[2]);
+    m_maps[SA0 + period][triangle] = std::max(m_maps[SA0 + period][triangle], sa);
+  }
+}
+
+std::vector<double> seissol::solver::GroundMotionMaps::parsePeriods(std::string const& list)
+{
+  std::vector<double> periods;
+  std::stringstream stream(list);
+  std::string entry;
+  while (std::getline(stream, entry, ',')) {
+    double period = 0.0;
+    std::stringstream value(entry);
+    if (!(value >> period) || period <= 0.0) {
+      logError() << "Invalid period of the ground motion maps:" << entry;
+    }
+    periods.push_back(period);
+  }
+  return periods;
+}
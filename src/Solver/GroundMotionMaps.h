@@ -0,0 +1,167 @@
+/**
+ * @file
+ * This file is part of SeisSol.
+ *
+ * @section LICENSE
+ * Copyright (c) 2020, SeisSol Group
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @section DESCRIPTION
+ * In-situ peak ground motions and response spectra on the free surface.
+ **/
+
+#ifndef SOLVER_GROUNDMOTIONMAPS_H_
+#define SOLVER_GROUNDMOTIONMAPS_H_
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+#define GROUNDMOTION_MAX_PERIODS 16
+
+namespace seissol {
+  namespace solver {
+    class FreeSurfaceIntegrator;
+    class GroundMotionMaps;
+  }
+}
+
+/**
+ * Accumulates the peak ground acceleration, velocity and displacement and the pseudo-spectral acceleration of
+ * damped oscillators on the sub triangles of the free surface after every time step of a cluster.
+ *
+ * The maps use the horizontal (x and y) components; a peak is the maximum norm of the horizontal vector, which is
+ * independent of the orientation of the mesh (RotD100). The ground acceleration is the difference quotient of the
+ * velocities of two subsequent time steps and is constant within a time step; it is zero in the first time step.
+ **/
+class seissol::solver::GroundMotionMaps {
+public:
+  //! Fraction of critical damping of the oscillators
+  static constexpr double Damping = 0.05;
+
+  enum Map {
+    PGA = 0,
+    PGV = 1,
+    PGD = 2,
+    //! first pseudo-spectral acceleration
+    SA0 = 3
+  };
+
+  /**
+   * Exact propagator of the oscillator x'' + 2 zeta omega x' + omega^2 x = -a over a time step of constant
+   * ground acceleration a (Nigam and Jennings, 1969).
+   **/
+  struct Oscillator {
+    double omega2;
+    double a11, a12, a21, a22;
+
+    Oscillator(double period, double damping, double timeStepWidth) {
+      double const omega = 2.0 * M_PI / period;
+      double const omegaD = omega * std::sqrt(1.0 - damping * damping);
+      double const decay = std::exp(-damping * omega * timeStepWidth);
+      double const c = std::cos(omegaD * timeStepWidth);
+      double const s = std::sin(omegaD * timeStepWidth);
+      omega2 = omega * omega;
+      a11 = decay * (c + damping * omega / omegaD * s);
+      a12 = decay * s / omegaD;
+      a21 = -decay * omega2 / omegaD * s;
+      a22 = decay * (c - damping * omega / omegaD * s);
+    }
+
+    //! Advances the relative displacement x and velocity v by one time step
+    void update(double groundAcceleration, double& x, double& v) const {
+      double const equilibrium = -groundAcceleration / omega2;
+      double const u = x - equilibrium;
+      x = equilibrium + a11 * u + a12 * v;
+      v = a21 * u + a22 * v;
+    }
+  };
+
+private:
+  FreeSurfaceIntegrator* m_freeSurfaceIntegrator;
+
+  std::vector<double> m_periods;
+
+  //! Index of the first sub triangle of the copy layer of every cluster
+  std::vector<unsigned> m_clusterOffsets;
+
+  //! Horizontal velocities of the previous time step
+  std::vector<double> m_lastVelocities[2];
+
+  //! Displacement and velocity of the x and y oscillators for every sub triangle and period
+  std::vector<double> m_oscillators;
+
+  std::vector<std::vector<double>> m_maps;
+
+public:
+  GroundMotionMaps() : m_freeSurfaceIntegrator(nullptr) {}
+
+  /**
+   * Reads the periods from SEISSOL_GROUND_MOTION_PERIODS and allocates the maps if SEISSOL_GROUND_MOTION_MAPS is set.
+   **/
+  void initialize(FreeSurfaceIntegrator* freeSurfaceIntegrator);
+
+  void initialize(FreeSurfaceIntegrator* freeSurfaceIntegrator, std::vector<double> const& periods);
+
+  //! Allocates the maps and the oscillators for the current periods
+  void allocate(unsigned numberOfTriangles);
+
+  //! Sets the periods without a free surface, e.g. to call update directly
+  void setPeriods(std::vector<double> const& periods) { m_periods = periods; }
+
+  bool enabled() const { return m_freeSurfaceIntegrator != nullptr; }
+
+  std::vector<double> const& periods() const { return m_periods; }
+
+  unsigned numberOfMaps() const { return m_maps.size(); }
+
+  double* map(unsigned index) { return m_maps[index].data(); }
+
+  /**
+   * Updates the peaks and the oscillators of all free surface faces of a cluster.
+   * Has to be called after the full update of the cluster.
+   **/
+  void accumulate(unsigned cluster, double timeStepWidth);
+
+  /**
+   * Updates the maps and the oscillators of a sub triangle with its current horizontal velocity and displacement.
+   * The first update of a triangle only stores the velocity, such that velocities which are present at the start
+   * (restart, initial condition) do not show up as ground acceleration.
+   **/
+  void update(unsigned triangle,
+              double const velocity[2],
+              double const displacement[2],
+              double timeStepWidth,
+              std::vector<Oscillator> const& oscillators);
+
+  //! Parses a comma-separated list of positive periods
+  static std::vector<double> parsePeriods(std::string const& list);
+};
+
+#endif
@@ -42,19 +42,28 @@
 
 #include <cstddef>
 #include <cstring>
+#include <limits>
+#include <algorithm>
+#include <vector>
 
 #include "Interoperability.h"
 #include "time_stepping/TimeManager.h"
 #include "SeisSol.h"
 #include <Initializer/CellLocalMatrices.h>
 #include <Initializer/InitialFieldProjection.h>
+#include <Initializer/PointMapper.h>
 #include <Initializer/ParameterDB.h>
 #include <Initializer/time_stepping/common.hpp>
 #include <Initializer/typedefs.hpp>
 #include <Equations/Setup.h>
+#include <Geometry/MeshTools.h>
+#include <Kernels/Plasticity.h>
 #include <Numerical_aux/BasisFunction.h>
 #include <Monitoring/FlopCounter.hpp>
 #include <ResultWriter/common.hpp>
+#include <Kernels/FrictionSolver.h>
+#include <Parallel/MPI.h>
+#include <utils/env.h>
 
 seissol::Interoperability e_interoperability;
 
@@ -169,10 +178,21 @@ extern "C" {
     e_interoperability.addRecPoint(x, y, z);
   }
 
+  void c_interoperability_findFaultReceivers( int     numberOfPoints,
+                                              double* points,
+                                              double  tolerance,
+                                              int*    faultIds ) {
+    e_interoperability.findFaultReceivers(numberOfPoints, points, tolerance, faultIds);
+  }
+
   void c_interoperability_enableDynamicRupture() {
     e_interoperability.enableDynamicRupture();
   }
 
+  void c_interoperability_enablePlasticity() {
+    e_interoperability.enablePlasticity();
+  }
+
   void c_interoperability_setMaterial( int    i_meshId,
                                        int    i_side,
                                        double* i_materialVal,
@@ -180,7 +200,6 @@ extern "C" {
     e_interoperability.setMaterial(i_meshId, i_side, i_materialVal, i_numMaterialVals);
   }
       
-#ifdef USE_PLASTICITY
  void c_interoperability_setInitialLoading( int    i_meshId,
                                             double *i_initialLoading ) {
     e_interoperability.setInitialLoading( i_meshId, i_initialLoading );
@@ -194,7 +213,6 @@ extern "C" {
   void c_interoperability_setTv(double tv) {
     e_interoperability.setTv(tv);
   }
-#endif
 
   void c_interoperability_initializeCellLocalMatrices() {
     e_interoperability.initializeCellLocalMatrices();
@@ -265,6 +283,10 @@ extern "C" {
 	  e_interoperability.finalizeIO();
   }
 
+  void c_interoperability_synchronizeFrictionState() {
+    e_interoperability.synchronizeFrictionStateToFortran();
+  }
+
 void c_interoperability_report_device_memory_status() {
   e_interoperability.reportDeviceMemoryStatus();
 }
@@ -346,6 +368,71 @@ void c_interoperability_report_device_memory_status() {
   extern void f_interoperability_calcElementwiseFaultoutput( void *domain,
 	                                                     double time );
 
+  extern void f_interoperability_getFrictionLawParameters( void*   i_domain,
+                                                           int*    o_frictionLaw,
+                                                           int*    o_instantaneousHealing,
+                                                           double* o_t0,
+                                                           double* o_rsF0,
+                                                           double* o_rsA,
+                                                           double* o_rsB,
+                                                           double* o_rsSl0,
+                                                           double* o_rsSr0 );
+
+  extern void f_interoperability_getDynamicRuptureParameters( void*  i_domain,
+                                                              int    i_numberOfFaces,
+                                                              int*   i_meshFaces,
+                                                              int    i_numberOfPoints,
+                                                              int    i_ld,
+                                                              real*  o_initialStressInFaultCS,
+                                                              real*  o_cohesion,
+                                                              real*  o_muS,
+                                                              real*  o_muD,
+                                                              real*  o_dC,
+                                                              real*  o_forcedRuptureTime,
+                                                              int*   o_magnitudeOutput );
+
+  extern void f_interoperability_getDynamicRuptureState( void*  i_domain,
+                                                         int    i_numberOfFaces,
+                                                         int*   i_meshFaces,
+                                                         int    i_numberOfPoints,
+                                                         int    i_ld,
+                                                         real*  o_mu,
+                                                         real*  o_slip,
+                                                         real*  o_slip1,
+                                                         real*  o_slip2,
+                                                         real*  o_slipRate1,
+                                                         real*  o_slipRate2,
+                                                         real*  o_stateVariable,
+                                                         real*  o_tractionXY,
+                                                         real*  o_tractionXZ,
+                                                         real*  o_ruptureTime,
+                                                         real*  o_dynStressTime,
+                                                         real*  o_peakSlipRate,
+                                                         int*   o_ruptureFront,
+                                                         int*   o_dynStressPending,
+                                                         real*  o_averagedSlip );
+
+  extern void f_interoperability_setDynamicRuptureState( void*  i_domain,
+                                                         int    i_numberOfFaces,
+                                                         int*   i_meshFaces,
+                                                         int    i_numberOfPoints,
+                                                         int    i_ld,
+                                                         real*  i_mu,
+                                                         real*  i_slip,
+                                                         real*  i_slip1,
+                                                         real*  i_slip2,
+                                                         real*  i_slipRate1,
+                                                         real*  i_slipRate2,
+                                                         real*  i_stateVariable,
+                                                         real*  i_tractionXY,
+                                                         real*  i_tractionXZ,
+                                                         real*  i_ruptureTime,
+                                                         real*  i_dynStressTime,
+                                                         real*  i_peakSlipRate,
+                                                         int*   i_ruptureFront,
+                                                         int*   i_dynStressPending,
+                                                         real*  i_averagedSlip );
+
   extern void f_interoperability_fitAttenuation(  void*  i_domain,
                                                   double  rho,
                                                   double  mu,
@@ -508,6 +595,24 @@ void seissol::Interoperability::setupFSRMPointSources( double const* momentTenso
   );
 }
 
+void seissol::Interoperability::findFaultReceivers( int           numberOfPoints,
+                                                    double const* points,
+                                                    double        tolerance,
+                                                    int*          faultIds )
+{
+  std::vector<Eigen::Vector3d> receivers(numberOfPoints);
+  for (int point = 0; point < numberOfPoints; ++point) {
+    receivers[point] = Eigen::Vector3d(points[3*point], points[3*point+1], points[3*point+2]);
+  }
+
+  seissol::initializers::findFaultIds(receivers.data(), seissol::SeisSol::main.meshReader(), numberOfPoints, tolerance, faultIds);
+
+  // Fortran numbering
+  for (int point = 0; point < numberOfPoints; ++point) {
+    ++faultIds[point];
+  }
+}
+
 void seissol::Interoperability::initializeModel(  char*   materialFileName,
                                                   bool    anelasticity,
                                                   bool    plasticity,
@@ -526,18 +631,70 @@ void seissol::Interoperability::initializeModel(  char*   materialFileName,
   // anisotropic elastic materials
   
 
-  //first initialize the (visco-)elastic part
   auto nElements = seissol::SeisSol::main.meshReader().getElements().size();
-  seissol::initializers::ElementBarycentreGenerator queryGen(seissol::SeisSol::main.meshReader());
+  unsigned const numberOfMaterialValues = anisotropy ? 22 : (anelasticity ? 5 : 3);
+
+  // the output arrays of the model, which are stored in the initialization cache
+  std::vector<std::pair<double*, std::size_t>> modelArrays;
+  modelArrays.emplace_back(materialVal, numberOfMaterialValues * nElements);
+  modelArrays.emplace_back(waveSpeeds, 3 * nElements);
+  if (plasticity) {
+    modelArrays.emplace_back(bulkFriction, nElements);
+    modelArrays.emplace_back(plastCo, nElements);
+    modelArrays.emplace_back(iniStress, 6 * nElements);
+  }
+
+  auto& initializationCache = seissol::SeisSol::main.initializationCache();
+  std::uint64_t modelFingerprint = 0;
+  if (initializationCache.enabled()) {
+    unsigned const modelFlags = (anelasticity ? 1 : 0) | (plasticity ? 2 : 0) | (anisotropy ? 4 : 0);
+    modelFingerprint = seissol::initializers::InitializationCache::meshFingerprint(seissol::SeisSol::main.meshReader());
+    modelFingerprint = seissol::initializers::InitializationCache::hash(&modelFlags, sizeof(modelFlags), modelFingerprint);
+
+    std::vector<double> cachedModel;
+    if (initializationCache.read("material", modelFingerprint, cachedModel)) {
+      double const* cached = cachedModel.data();
+      for (auto const& array : modelArrays) {
+        std::copy(cached, cached + array.second, array.first);
+        cached += array.second;
+      }
+      return;
+    }
+  }
+
+  // the material was evaluated for the LTS weights while reading the mesh
+  MeshReader& meshReader = seissol::SeisSol::main.meshReader();
+  MaterialLayout const materialLayout = anisotropy ? MaterialLayout::Anisotropic
+                                      : (anelasticity ? MaterialLayout::Viscoelastic : MaterialLayout::Elastic);
+  bool const sharedMaterial = (meshReader.getMaterialLayout() == materialLayout);
+  if (sharedMaterial && meshReader.getNumberOfMaterialValues() != numberOfMaterialValues + 2) {
+    logError() << "The mesh reader provides" << meshReader.getNumberOfMaterialValues()
+               << "material values per cell instead of" << numberOfMaterialValues + 2;
+  }
+
+  //first initialize the (visco-)elastic part
+  seissol::initializers::ElementBarycentreGenerator queryGen(meshReader);
   auto calcWaveSpeeds = [&] (seissol::model::Material* material, int pos) {
     waveSpeeds[pos] = material->getMaxWaveSpeed();
     waveSpeeds[nElements + pos] = material->getSWaveSpeed();
     waveSpeeds[2*nElements + pos] = material->getSWaveSpeed();
   };
-  if (anisotropy) { 
-    if(anelasticity || plasticity) {
-      logError() << "Anisotropy can not be combined with anelasticity or plasticity";
+  if (anisotropy && (anelasticity || plasticity)) {
+    logError() << "Anisotropy can not be combined with anelasticity or plasticity";
+  }
+  if (sharedMaterial) {
+    std::vector<double> const& values = meshReader.getMaterialValues();
+    for (unsigned int i = 0; i < nElements; i++) {
+      double const* cellValues = &values[i * (numberOfMaterialValues + 2)];
+      for (unsigned int v = 0; v < numberOfMaterialValues; v++) {
+        materialVal[v*nElements + i] = cellValues[v];
+      }
+      waveSpeeds[i] = cellValues[numberOfMaterialValues];
+      waveSpeeds[nElements + i] = cellValues[numberOfMaterialValues + 1];
+      waveSpeeds[2*nElements + i] = cellValues[numberOfMaterialValues + 1];
     }
+    meshReader.discardMaterialValues();
+  } else if (anisotropy) {
     auto materials = std::vector<seissol::model::AnisotropicMaterial>(nElements);
     seissol::initializers::MaterialParameterDB<seissol::model::AnisotropicMaterial> parameterDB;
     parameterDB.setMaterialVector(&materials);
@@ -567,50 +724,56 @@ void seissol::Interoperability::initializeModel(  char*   materialFileName,
       materialVal[21*nElements + i] = materials[i].c66;
       calcWaveSpeeds(&materials[i], i);
     }
+  } else if (anelasticity) {
+    auto materials = std::vector<seissol::model::ViscoElasticMaterial>(nElements);
+    seissol::initializers::MaterialParameterDB<seissol::model::ViscoElasticMaterial> parameterDB;
+    parameterDB.setMaterialVector(&materials);
+    parameterDB.evaluateModel(std::string(materialFileName), queryGen);
+    for (unsigned int i = 0; i < nElements; i++) {
+      materialVal[i] = materials[i].rho;
+      materialVal[nElements + i] = materials[i].mu;
+      materialVal[2*nElements + i] = materials[i].lambda;
+      materialVal[3*nElements + i] = materials[i].Qp;
+      materialVal[4*nElements + i] = materials[i].Qs;
+      calcWaveSpeeds(&materials[i], i);
+    }
   } else {
-    if (anelasticity) {
-      auto materials = std::vector<seissol::model::ViscoElasticMaterial>(nElements);
-      seissol::initializers::MaterialParameterDB<seissol::model::ViscoElasticMaterial> parameterDB;
-      parameterDB.setMaterialVector(&materials);
-      parameterDB.evaluateModel(std::string(materialFileName), queryGen);
-      for (unsigned int i = 0; i < nElements; i++) {
-        materialVal[i] = materials[i].rho;
-        materialVal[nElements + i] = materials[i].mu;
-        materialVal[2*nElements + i] = materials[i].lambda;
-        materialVal[3*nElements + i] = materials[i].Qp;
-        materialVal[4*nElements + i] = materials[i].Qs;
-        calcWaveSpeeds(&materials[i], i);
-      }
-    } else {
-      auto materials = std::vector<seissol::model::ElasticMaterial>(nElements);
-      seissol::initializers::MaterialParameterDB<seissol::model::ElasticMaterial> parameterDB;
-      parameterDB.setMaterialVector(&materials);
-      parameterDB.evaluateModel(std::string(materialFileName), queryGen);
-      for (unsigned int i = 0; i < nElements; i++) {
-        materialVal[i] = materials[i].rho;
-        materialVal[nElements + i] = materials[i].mu;
-        materialVal[2*nElements + i] = materials[i].lambda;
-        calcWaveSpeeds(&materials[i], i);
-      }
-    } 
-
-    //now initialize the plasticity data
-    if (plasticity) {
-      auto materials = std::vector<seissol::model::Plasticity>(nElements);
-      seissol::initializers::MaterialParameterDB<seissol::model::Plasticity> parameterDB;
-      parameterDB.setMaterialVector(&materials);
-      parameterDB.evaluateModel(std::string(materialFileName), queryGen);
-      for (unsigned int i = 0; i < nElements; i++) {
-        bulkFriction[i] = materials[i].bulkFriction;
-        plastCo[i] = materials[i].plastCo;
-        iniStress[i*6+0] = materials[i].s_xx;
-        iniStress[i*6+1] = materials[i].s_yy;
-        iniStress[i*6+2] = materials[i].s_zz;
-        iniStress[i*6+3] = materials[i].s_xy;
-        iniStress[i*6+4] = materials[i].s_yz;
-        iniStress[i*6+5] = materials[i].s_xz;
-      }
-    } 
+    auto materials = std::vector<seissol::model::ElasticMaterial>(nElements);
+    seissol::initializers::MaterialParameterDB<seissol::model::ElasticMaterial> parameterDB;
+    parameterDB.setMaterialVector(&materials);
+    parameterDB.evaluateModel(std::string(materialFileName), queryGen);
+    for (unsigned int i = 0; i < nElements; i++) {
+      materialVal[i] = materials[i].rho;
+      materialVal[nElements + i] = materials[i].mu;
+      materialVal[2*nElements + i] = materials[i].lambda;
+      calcWaveSpeeds(&materials[i], i);
+    }
+  }
+
+  //now initialize the plasticity data
+  if (plasticity) {
+    auto materials = std::vector<seissol::model::Plasticity>(nElements);
+    seissol::initializers::MaterialParameterDB<seissol::model::Plasticity> parameterDB;
+    parameterDB.setMaterialVector(&materials);
+    parameterDB.evaluateModel(std::string(materialFileName), queryGen);
+    for (unsigned int i = 0; i < nElements; i++) {
+      bulkFriction[i] = materials[i].bulkFriction;
+      plastCo[i] = materials[i].plastCo;
+      iniStress[i*6+0] = materials[i].s_xx;
+      iniStress[i*6+1] = materials[i].s_yy;
+      iniStress[i*6+2] = materials[i].s_zz;
+      iniStress[i*6+3] = materials[i].s_xy;
+      iniStress[i*6+4] = materials[i].s_yz;
+      iniStress[i*6+5] = materials[i].s_xz;
+    }
+  }
+
+  if (initializationCache.enabled()) {
+    std::vector<double> model;
+    for (auto const& array : modelArrays) {
+      model.insert(model.end(), array.first, array.first + array.second);
+    }
+    initializationCache.write("material", modelFingerprint, model);
   }
 }
 
@@ -655,6 +818,10 @@ void seissol::Interoperability::enableDynamicRupture() {
   // DR is always enabled if there are dynamic rupture cells
 }
 
+void seissol::Interoperability::enablePlasticity() {
+  seissol::SeisSol::main.physicsFeatures().plasticity = true;
+}
+
 void seissol::Interoperability::setMaterial(int i_meshId, int i_side, double* i_materialVal, int i_numMaterialVals)
 {
   int side = i_side - 1;
@@ -678,7 +845,6 @@ void seissol::Interoperability::setMaterial(int i_meshId, int i_side, double* i_
 #endif
 }
 
-#ifdef USE_PLASTICITY
 void seissol::Interoperability::setInitialLoading( int i_meshId, double *i_initialLoading ) {
   PlasticityData& plasticity = m_ltsLut.lookup(m_lts->plasticity, i_meshId - 1);
 
@@ -701,22 +867,80 @@ void seissol::Interoperability::setPlasticParameters( int i_meshId, double* i_pl
 #else
   plasticity.mufactor = 3.0 / (2.0 * (material.local.c44 + material.local.c55 + material.local.c66));
 #endif
+
+  // cells with the barycentre outside of the plastic region skip the plasticity
+  static std::vector<double> const region = seissol::kernels::Plasticity::regionFromEnvironment();
+  plasticity.evaluate = true;
+  if (!region.empty()) {
+    MeshReader const& meshReader = seissol::SeisSol::main.meshReader();
+    VrtxCoords barycentre;
+    MeshTools::center(meshReader.getElements()[i_meshId - 1], meshReader.getVertices(), barycentre);
+    for (unsigned dim = 0; dim < 3; ++dim) {
+      plasticity.evaluate = plasticity.evaluate && barycentre[dim] >= region[2*dim] && barycentre[dim] <= region[2*dim+1];
+    }
+  }
 }
 
 
 void seissol::Interoperability::setTv(double tv) {
   seissol::SeisSol::main.timeManager().setTv(tv);
 }
-#endif
 
 void seissol::Interoperability::initializeCellLocalMatrices()
 {
   // \todo Move this to some common initialization place
   MeshReader& meshReader = seissol::SeisSol::main.meshReader();
-  seissol::initializers::initializeCellLocalMatrices( meshReader,
-                                                      m_ltsTree,
-                                                      m_lts,
-                                                      &m_ltsLut );
+  auto& initializationCache = seissol::SeisSol::main.initializationCache();
+  seissol::initializers::LayerMask ghostMask(Ghost);
+  bool cachedMatrices = false;
+  std::uint64_t matricesFingerprint = 0;
+  if (initializationCache.enabled()) {
+    // the matrices depend on the mesh, the face types and the order of the cells in the LTS tree
+    matricesFingerprint = seissol::initializers::InitializationCache::meshFingerprint(meshReader);
+    for (auto it = m_ltsTree->beginLeaf(ghostMask); it != m_ltsTree->endLeaf(); ++it) {
+      CellLocalInformation* cellInformation = it->var(m_lts->cellInformation);
+      for (unsigned cell = 0; cell < it->getNumberOfCells(); ++cell) {
+        matricesFingerprint = seissol::initializers::InitializationCache::hash( cellInformation[cell].faceTypes,
+                                                                               sizeof(cellInformation[cell].faceTypes),
+                                                                               matricesFingerprint );
+      }
+    }
+    unsigned* ltsToMesh = m_ltsLut.getLtsToMeshLut(m_lts->material.mask);
+    matricesFingerprint = seissol::initializers::InitializationCache::hash( ltsToMesh,
+                                                                           m_ltsTree->getNumberOfCells(m_lts->material.mask) * sizeof(unsigned),
+                                                                           matricesFingerprint );
+
+    std::vector<LocalIntegrationData> localIntegration;
+    std::vector<NeighboringIntegrationData> neighboringIntegration;
+    if (initializationCache.read("localIntegration", matricesFingerprint, localIntegration)
+        && initializationCache.read("neighboringIntegration", matricesFingerprint, neighboringIntegration)) {
+      std::size_t offset = 0;
+      for (auto it = m_ltsTree->beginLeaf(ghostMask); it != m_ltsTree->endLeaf(); ++it) {
+        std::copy_n(localIntegration.begin() + offset, it->getNumberOfCells(), it->var(m_lts->localIntegration));
+        std::copy_n(neighboringIntegration.begin() + offset, it->getNumberOfCells(), it->var(m_lts->neighboringIntegration));
+        offset += it->getNumberOfCells();
+      }
+      cachedMatrices = true;
+    }
+  }
+
+  if (!cachedMatrices) {
+    seissol::initializers::initializeCellLocalMatrices( meshReader,
+                                                        m_ltsTree,
+                                                        m_lts,
+                                                        &m_ltsLut );
+
+    if (initializationCache.enabled()) {
+      std::vector<LocalIntegrationData> localIntegration;
+      std::vector<NeighboringIntegrationData> neighboringIntegration;
+      for (auto it = m_ltsTree->beginLeaf(ghostMask); it != m_ltsTree->endLeaf(); ++it) {
+        localIntegration.insert(localIntegration.end(), it->var(m_lts->localIntegration), it->var(m_lts->localIntegration) + it->getNumberOfCells());
+        neighboringIntegration.insert(neighboringIntegration.end(), it->var(m_lts->neighboringIntegration), it->var(m_lts->neighboringIntegration) + it->getNumberOfCells());
+      }
+      initializationCache.write("localIntegration", matricesFingerprint, localIntegration);
+      initializationCache.write("neighboringIntegration", matricesFingerprint, neighboringIntegration);
+    }
+  }
 
   initializers::MemoryManager& memoryManager = seissol::SeisSol::main.getMemoryManager();
   seissol::initializers::initializeDynamicRuptureMatrices( meshReader,
@@ -744,6 +968,20 @@ void seissol::Interoperability::initializeCellLocalMatrices()
                                          memoryManager.getBoundary());
 
   memoryManager.recordExecutionPaths();
+#else
+  std::string neighborIntegration = utils::Env::get<std::string>("SEISSOL_NEIGHBOR_INTEGRATION", "cell");
+  if (neighborIntegration == "batched") {
+#ifdef USE_VISCOELASTIC2
+    logWarning(seissol::MPI::mpi.rank()) << "The batched neighbor integration is not supported for viscoelastic2, using the cell-wise neighbor integration.";
+#else
+    if (seissol::SeisSol::main.timeManager().enableBatchedNeighborIntegration()) {
+      logInfo(seissol::MPI::mpi.rank()) << "Recording the batches of the neighbor integration.";
+      memoryManager.recordNeighborIntegration();
+    }
+#endif
+  } else if (neighborIntegration != "cell") {
+    logError() << "Unknown neighbor integration" << neighborIntegration << "(SEISSOL_NEIGHBOR_INTEGRATION has to be cell or batched).";
+  }
 #endif
 }
 
@@ -768,9 +1006,9 @@ void seissol::Interoperability::synchronize(seissol::initializers::Variable<T> c
 
 void seissol::Interoperability::synchronizeCellLocalData() {
   synchronize(m_lts->material);
-#ifdef USE_PLASTICITY
-  synchronize(m_lts->plasticity);
-#endif
+  if (seissol::SeisSol::main.physicsFeatures().plasticity) {
+    synchronize(m_lts->plasticity);
+  }
 }
 
 void seissol::Interoperability::synchronizeCopyLayerDofs() {
@@ -794,6 +1032,8 @@ void seissol::Interoperability::enableFreeSurfaceOutput(int maxRefinementDepth)
 								m_lts,
 								m_ltsTree,
 								&m_ltsLut );
+
+	seissol::SeisSol::main.groundMotionMaps().initialize(&seissol::SeisSol::main.freeSurfaceIntegrator());
 }
 
 
@@ -817,6 +1057,7 @@ void seissol::Interoperability::enableCheckPointing( double i_checkPointInterval
 
 void seissol::Interoperability::getIntegrationMask( int* i_integrationMask ) {
   seissol::SeisSol::main.postProcessor().setIntegrationMask(i_integrationMask);
+  seissol::SeisSol::main.physicsFeatures().integrateQuantities = (seissol::SeisSol::main.postProcessor().getNumberOfVariables() > 0);
 }
 
 void seissol::Interoperability::initializeIO(
@@ -830,12 +1071,37 @@ void seissol::Interoperability::initializeIO(
 {
   auto type = writer::backendType(xdmfWriterBackend);
   
+  // Global ids allow to restart from checkpoints with a different partitioning
+  MeshReader const& meshReader = seissol::SeisSol::main.meshReader();
+  unsigned numberOfCheckpointCells = m_ltsTree->getNumberOfCells(m_lts->dofs.mask);
+  std::vector<unsigned long> checkpointCellIds;
+  std::vector<unsigned long> checkpointFaceIds;
+  if (meshReader.hasGlobalIds()) {
+    std::vector<Element> const& elements = meshReader.getElements();
+    unsigned* ltsToMesh = m_ltsLut.getLtsToMeshLut(m_lts->dofs.mask);
+    checkpointCellIds.resize(numberOfCheckpointCells);
+    for (unsigned cell = 0; cell < numberOfCheckpointCells; ++cell) {
+      checkpointCellIds[cell] = (ltsToMesh[cell] == std::numeric_limits<unsigned>::max())
+                                ? std::numeric_limits<unsigned long>::max()
+                                : elements[ ltsToMesh[cell] ].globalId;
+    }
+
+    std::vector<Fault> const& fault = meshReader.getFault();
+    if (fault.size() == static_cast<size_t>(numSides)) {
+      for (auto const& face : fault) {
+        checkpointFaceIds.push_back(face.globalId);
+      }
+    }
+  }
+
 	// Initialize checkpointing
 	int faultTimeStep;
 	bool hasCheckpoint = seissol::SeisSol::main.checkPointManager().init(reinterpret_cast<real*>(m_ltsTree->var(m_lts->dofs)),
-			m_ltsTree->getNumberOfCells(m_lts->dofs.mask) * tensor::Q::size(),
+			numberOfCheckpointCells * tensor::Q::size(),
+			checkpointCellIds.empty() ? nullptr : checkpointCellIds.data(), numberOfCheckpointCells,
 			mu, slipRate1, slipRate2, slip, slip1, slip2,
 			state, strength, numSides, numBndGP,
+			checkpointFaceIds.empty() ? nullptr : checkpointFaceIds.data(),
 			faultTimeStep);
 	if (hasCheckpoint) {
 		seissol::SeisSol::main.simulator().setCurrentTime(
@@ -869,8 +1135,16 @@ void seissol::Interoperability::initializeIO(
 	seissol::SeisSol::main.freeSurfaceWriter().init(
 		seissol::SeisSol::main.meshReader(),
 		&seissol::SeisSol::main.freeSurfaceIntegrator(),
+		&seissol::SeisSol::main.groundMotionMaps(),
 		freeSurfaceFilename, freeSurfaceInterval, type);
 
+  if (seissol::SeisSol::main.groundMotionMaps().enabled()) {
+    if (hasCheckpoint) {
+      logWarning(seissol::MPI::mpi.rank()) << "Ground motion maps are not stored in checkpoints, the peaks only cover the time after the restart. The acceleration of the first time step after the restart is not included.";
+    }
+    seissol::SeisSol::main.timeManager().setGroundMotionMaps(seissol::SeisSol::main.groundMotionMaps());
+  }
+
   auto& receiverWriter = seissol::SeisSol::main.receiverWriter();
   // Initialize receiver output
   receiverWriter.init(
@@ -992,6 +1266,7 @@ void seissol::Interoperability::finalizeIO()
 	seissol::SeisSol::main.checkPointManager().close();
 	seissol::SeisSol::main.faultWriter().close();
 	seissol::SeisSol::main.freeSurfaceWriter().close();
+	seissol::SeisSol::main.receiverWriter().close();
 }
 
 void seissol::Interoperability::deallocateMemoryManager() {
@@ -1041,8 +1316,220 @@ void seissol::Interoperability::evaluateFrictionLaw(  int face,
                                           init::resample::Values );
 }
 
+void seissol::Interoperability::initializeFrictionSolver() {
+  auto& memoryManager = seissol::SeisSol::main.getMemoryManager();
+  seissol::initializers::LTSTree* dynRupTree = memoryManager.getDynamicRuptureTree();
+  seissol::initializers::DynamicRupture* dynRup = memoryManager.getDynamicRupture();
+
+  unsigned long numberOfFaces = dynRupTree->getNumberOfCells(LayerMask(Ghost));
+#ifdef USE_MPI
+  MPI_Allreduce(MPI_IN_PLACE, &numberOfFaces, 1, MPI_UNSIGNED_LONG, MPI_SUM, seissol::MPI::mpi.comm());
+#endif
+  if (numberOfFaces == 0) {
+    return;
+  }
+
+  int frictionLaw = 0;
+  int instantaneousHealing = 0;
+  double t0 = 0.0, rsF0 = 0.0, rsA = 0.0, rsB = 0.0, rsSl0 = 0.0, rsSr0 = 0.0;
+  f_interoperability_getFrictionLawParameters( m_domain, &frictionLaw, &instantaneousHealing, &t0, &rsF0, &rsA, &rsB, &rsSl0, &rsSr0 );
+
+  const int rank = seissol::MPI::mpi.rank();
+  std::string solver = utils::Env::get<std::string>("SEISSOL_FRICTION_SOLVER", "batched");
+  if (solver == "fortran") {
+    logInfo(rank) << "Evaluating friction law" << frictionLaw << "with the Fortran implementation.";
+    return;
+  }
+  if (solver != "batched") {
+    logError() << "Unknown friction solver" << solver << "(SEISSOL_FRICTION_SOLVER has to be batched or fortran).";
+  }
+  if (!seissol::kernels::FrictionSolver::isSupported(frictionLaw)) {
+    logInfo(rank) << "Friction law" << frictionLaw << "is not supported by the layer-wise friction solver, using the Fortran implementation.";
+    return;
+  }
+
+  seissol::kernels::FrictionSolver::Parameters parameters;
+  parameters.law = static_cast<seissol::kernels::FrictionSolver::Law>(frictionLaw);
+  parameters.instantaneousHealing = (instantaneousHealing == 1);
+  parameters.t0 = t0;
+  parameters.rsF0 = rsF0;
+  parameters.rsA = rsA;
+  parameters.rsB = rsB;
+  parameters.rsSl0 = rsSl0;
+  parameters.rsSr0 = rsSr0;
+
+  constexpr unsigned ld = seissol::initializers::numberOfPaddedDRPoints;
+  for (seissol::initializers::LTSTree::leaf_iterator it = dynRupTree->beginLeaf(LayerMask(Ghost)); it != dynRupTree->endLeaf(); ++it) {
+    DRFaceInformation*  faceInformation         = it->var(dynRup->faceInformation);
+    real              (*initialStressInFaultCS)[6][ld] = it->var(dynRup->initialStressInFaultCS);
+    real              (*cohesion)[ld]           = it->var(dynRup->cohesion);
+    real              (*muS)[ld]                = it->var(dynRup->muS);
+    real              (*muD)[ld]                = it->var(dynRup->muD);
+    real              (*dC)[ld]                 = it->var(dynRup->dC);
+    real              (*forcedRuptureTime)[ld]  = it->var(dynRup->forcedRuptureTime);
+    bool*               magnitudeOutput         = it->var(dynRup->magnitudeOutput);
+
+    unsigned numberOfLayerFaces = it->getNumberOfCells();
+    if (numberOfLayerFaces == 0) {
+      continue;
+    }
+
+    std::vector<int> meshFaces(numberOfLayerFaces);
+    std::vector<int> magnitudeOutputFlags(numberOfLayerFaces);
+    for (unsigned face = 0; face < numberOfLayerFaces; ++face) {
+      meshFaces[face] = static_cast<int>(faceInformation[face].meshFace) + 1;
+    }
+
+    // padded points are not touched by Fortran and get parameters which keep the friction laws finite
+    std::fill_n(&initialStressInFaultCS[0][0][0], numberOfLayerFaces * 6 * ld, 0.0);
+    std::fill_n(&cohesion[0][0], numberOfLayerFaces * ld, 0.0);
+    std::fill_n(&muS[0][0], numberOfLayerFaces * ld, 0.0);
+    std::fill_n(&muD[0][0], numberOfLayerFaces * ld, 0.0);
+    std::fill_n(&dC[0][0], numberOfLayerFaces * ld, 1.0);
+    std::fill_n(&forcedRuptureTime[0][0], numberOfLayerFaces * ld, 0.0);
+
+    f_interoperability_getDynamicRuptureParameters( m_domain,
+                                                    numberOfLayerFaces,
+                                                    meshFaces.data(),
+                                                    seissol::initializers::numberOfDRPoints,
+                                                    ld,
+                                                   &initialStressInFaultCS[0][0][0],
+                                                   &cohesion[0][0],
+                                                   &muS[0][0],
+                                                   &muD[0][0],
+                                                   &dC[0][0],
+                                                   &forcedRuptureTime[0][0],
+                                                    magnitudeOutputFlags.data() );
+
+    for (unsigned face = 0; face < numberOfLayerFaces; ++face) {
+      magnitudeOutput[face] = (magnitudeOutputFlags[face] != 0);
+    }
+
+    unsigned const blockSize = seissol::kernels::FrictionSolver::BlockSize;
+    for (unsigned firstFace = 0; firstFace < numberOfLayerFaces; firstFace += blockSize) {
+      copyFrictionStateFromFortran( *it, dynRup, firstFace, std::min(blockSize, numberOfLayerFaces - firstFace) );
+    }
+  }
+
+  logInfo(rank) << "Evaluating friction law" << frictionLaw << "with the layer-wise friction solver.";
+  seissol::SeisSol::main.timeManager().enableFrictionSolver(parameters);
+  m_useFrictionSolver = true;
+}
+
+void seissol::Interoperability::synchronizeFrictionStateToFortran() {
+  if (!m_useFrictionSolver) {
+    return;
+  }
+
+  auto& memoryManager = seissol::SeisSol::main.getMemoryManager();
+  seissol::initializers::LTSTree* dynRupTree = memoryManager.getDynamicRuptureTree();
+  seissol::initializers::DynamicRupture* dynRup = memoryManager.getDynamicRupture();
+
+  unsigned const blockSize = seissol::kernels::FrictionSolver::BlockSize;
+  for (seissol::initializers::LTSTree::leaf_iterator it = dynRupTree->beginLeaf(LayerMask(Ghost)); it != dynRupTree->endLeaf(); ++it) {
+    unsigned numberOfLayerFaces = it->getNumberOfCells();
+    for (unsigned firstFace = 0; firstFace < numberOfLayerFaces; firstFace += blockSize) {
+      copyFrictionStateToFortran( *it, dynRup, firstFace, std::min(blockSize, numberOfLayerFaces - firstFace) );
+    }
+  }
+}
+
+void seissol::Interoperability::copyFrictionStateFromFortran( seissol::initializers::Layer&                 layerData,
+                                                              seissol::initializers::DynamicRupture const*  dynRup,
+                                                              unsigned                                      firstFace,
+                                                              unsigned                                      numberOfFaces ) {
+  constexpr unsigned ld = seissol::initializers::numberOfPaddedDRPoints;
+  constexpr unsigned blockSize = seissol::kernels::FrictionSolver::BlockSize;
+  assert(numberOfFaces <= blockSize);
+
+  DRFaceInformation* faceInformation = layerData.var(dynRup->faceInformation) + firstFace;
+  bool (*ruptureFront)[ld] = layerData.var(dynRup->ruptureFront) + firstFace;
+  bool (*dynStressPending)[ld] = layerData.var(dynRup->dynStressPending) + firstFace;
+
+  int meshFaces[blockSize];
+  int ruptureFrontFlags[blockSize][ld] = {};
+  int dynStressPendingFlags[blockSize][ld] = {};
+  for (unsigned face = 0; face < numberOfFaces; ++face) {
+    meshFaces[face] = static_cast<int>(faceInformation[face].meshFace) + 1;
+  }
+
+  f_interoperability_getDynamicRuptureState( m_domain,
+                                             numberOfFaces,
+                                             meshFaces,
+                                             seissol::initializers::numberOfDRPoints,
+                                             ld,
+                                             layerData.var(dynRup->mu)[firstFace],
+                                             layerData.var(dynRup->slip)[firstFace],
+                                             layerData.var(dynRup->slip1)[firstFace],
+                                             layerData.var(dynRup->slip2)[firstFace],
+                                             layerData.var(dynRup->slipRate1)[firstFace],
+                                             layerData.var(dynRup->slipRate2)[firstFace],
+                                             layerData.var(dynRup->stateVariable)[firstFace],
+                                             layerData.var(dynRup->tractionXY)[firstFace],
+                                             layerData.var(dynRup->tractionXZ)[firstFace],
+                                             layerData.var(dynRup->ruptureTime)[firstFace],
+                                             layerData.var(dynRup->dynStressTime)[firstFace],
+                                             layerData.var(dynRup->peakSlipRate)[firstFace],
+                                             ruptureFrontFlags[0],
+                                             dynStressPendingFlags[0],
+                                             layerData.var(dynRup->averagedSlip) + firstFace );
+
+  for (unsigned face = 0; face < numberOfFaces; ++face) {
+    for (unsigned point = 0; point < ld; ++point) {
+      ruptureFront[face][point] = (ruptureFrontFlags[face][point] != 0);
+      dynStressPending[face][point] = (dynStressPendingFlags[face][point] != 0);
+    }
+  }
+}
+
+void seissol::Interoperability::copyFrictionStateToFortran( seissol::initializers::Layer&                 layerData,
+                                                            seissol::initializers::DynamicRupture const*  dynRup,
+                                                            unsigned                                      firstFace,
+                                                            unsigned                                      numberOfFaces ) {
+  constexpr unsigned ld = seissol::initializers::numberOfPaddedDRPoints;
+  constexpr unsigned blockSize = seissol::kernels::FrictionSolver::BlockSize;
+  assert(numberOfFaces <= blockSize);
+
+  DRFaceInformation* faceInformation = layerData.var(dynRup->faceInformation) + firstFace;
+  bool (*ruptureFront)[ld] = layerData.var(dynRup->ruptureFront) + firstFace;
+  bool (*dynStressPending)[ld] = layerData.var(dynRup->dynStressPending) + firstFace;
+
+  int meshFaces[blockSize];
+  int ruptureFrontFlags[blockSize][ld];
+  int dynStressPendingFlags[blockSize][ld];
+  for (unsigned face = 0; face < numberOfFaces; ++face) {
+    meshFaces[face] = static_cast<int>(faceInformation[face].meshFace) + 1;
+    for (unsigned point = 0; point < ld; ++point) {
+      ruptureFrontFlags[face][point] = ruptureFront[face][point] ? 1 : 0;
+      dynStressPendingFlags[face][point] = dynStressPending[face][point] ? 1 : 0;
+    }
+  }
+
+  f_interoperability_setDynamicRuptureState( m_domain,
+                                             numberOfFaces,
+                                             meshFaces,
+                                             seissol::initializers::numberOfDRPoints,
+                                             ld,
+                                             layerData.var(dynRup->mu)[firstFace],
+                                             layerData.var(dynRup->slip)[firstFace],
+                                             layerData.var(dynRup->slip1)[firstFace],
+                                             layerData.var(dynRup->slip2)[firstFace],
+                                             layerData.var(dynRup->slipRate1)[firstFace],
+                                             layerData.var(dynRup->slipRate2)[firstFace],
+                                             layerData.var(dynRup->stateVariable)[firstFace],
+                                             layerData.var(dynRup->tractionXY)[firstFace],
+                                             layerData.var(dynRup->tractionXZ)[firstFace],
+                                             layerData.var(dynRup->ruptureTime)[firstFace],
+                                             layerData.var(dynRup->dynStressTime)[firstFace],
+                                             layerData.var(dynRup->peakSlipRate)[firstFace],
+                                             ruptureFrontFlags[0],
+                                             dynStressPendingFlags[0],
+                                             layerData.var(dynRup->averagedSlip) + firstFace );
+}
+
 void seissol::Interoperability::calcElementwiseFaultoutput(double time)
 {
+	synchronizeFrictionStateToFortran();
 	f_interoperability_calcElementwiseFaultoutput(m_domain, time);
 }
 
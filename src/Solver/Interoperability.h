@@ -50,6 +50,7 @@
 #include <Initializer/typedefs.hpp>
 #include <SourceTerm/NRF.h>
 #include <Initializer/LTS.h>
+#include <Initializer/DynamicRupture.h>
 #include <Initializer/tree/LTSTree.hpp>
 #include <Initializer/tree/Lut.hpp>
 #include <Physics/InitialField.h>
@@ -103,6 +104,9 @@ class seissol::Interoperability {
     //! Vector of initial conditions
     std::vector<std::unique_ptr<physics::InitialField>> m_iniConds;
 
+    //! true if the friction state is kept in the dynamic rupture tree by the layer-wise friction solver
+    bool m_useFrictionSolver = false;
+
     void initInitialConditions();
  public:
    /**
@@ -209,11 +213,28 @@ class seissol::Interoperability {
      m_recPoints.emplace_back(Eigen::Vector3d(x, y, z));
    }
 
+   /**
+    * Finds the fault faces whose "+" element contains the fault receivers.
+    *
+    * @param points coordinates of the receivers (3 x numberOfPoints)
+    * @param tolerance tolerance in reference coordinates
+    * @param faultIds fault face of each receiver (1-based, 0 if not found on this rank)
+    **/
+   void findFaultReceivers( int           numberOfPoints,
+                            double const* points,
+                            double        tolerance,
+                            int*          faultIds );
+
    /**
     * Enables dynamic rupture.
     **/
    void enableDynamicRupture();
 
+   /**
+    * Enables plasticity, has to be called before the mesh is read.
+    **/
+   void enablePlasticity();
+
    /**
     * Set material parameters for cell
     **/
@@ -234,10 +255,8 @@ class seissol::Interoperability {
     * @param i_meshId mesh id.
     * @param i_initialLoading initial loading (stress tensor).
     **/
-#ifdef USE_PLASTICITY
    void setInitialLoading( int    i_meshId,
                            double *i_initialLoading );
-#endif
 
    /**
     * Sets the parameters for a cell (plasticity).
@@ -245,12 +264,10 @@ class seissol::Interoperability {
     * @param i_meshId mesh id.
     * @param i_plasticParameters cell dependent plastic Parameters (volume, cohesion...).
     **/
-#ifdef USE_PLASTICITY
    void setPlasticParameters( int    i_meshId,
                               double *i_plasticParameters );
 
    void setTv(double tv);
-#endif
 
    /**
     * \todo Move this somewhere else when we have a C++ main loop.
@@ -390,6 +407,46 @@ class seissol::Interoperability {
     */
    void calcElementwiseFaultoutput( double time );
 
+   /**
+    * Loads friction parameters and state from Fortran into the dynamic rupture tree
+    * and switches the time clusters to the layer-wise friction solver if the
+    * friction law is supported (see SEISSOL_FRICTION_SOLVER).
+    **/
+   void initializeFrictionSolver();
+
+   /**
+    * Copies the friction state of a block of dynamic rupture faces from Fortran.
+    *
+    * @param layerData dynamic rupture layer.
+    * @param dynRup dynamic rupture variable handles.
+    * @param firstFace first face of the block (layer-local).
+    * @param numberOfFaces number of faces in the block (at most FrictionSolver::BlockSize).
+    **/
+   void copyFrictionStateFromFortran( seissol::initializers::Layer&                 layerData,
+                                      seissol::initializers::DynamicRupture const*  dynRup,
+                                      unsigned                                      firstFace,
+                                      unsigned                                      numberOfFaces );
+
+   /**
+    * Copies the friction state of all dynamic rupture faces to Fortran if the
+    * layer-wise friction solver is used. Called before the fault output and the
+    * checkpoints read the Fortran data structures.
+    **/
+   void synchronizeFrictionStateToFortran();
+
+   /**
+    * Copies the friction state of a block of dynamic rupture faces to Fortran.
+    *
+    * @param layerData dynamic rupture layer.
+    * @param dynRup dynamic rupture variable handles.
+    * @param firstFace first face of the block (layer-local).
+    * @param numberOfFaces number of faces in the block (at most FrictionSolver::BlockSize).
+    **/
+   void copyFrictionStateToFortran( seissol::initializers::Layer&                 layerData,
+                                    seissol::initializers::DynamicRupture const*  dynRup,
+                                    unsigned                                      firstFace,
+                                    unsigned                                      numberOfFaces );
+
    /**
     * Simulates until the final time is reached.
     *
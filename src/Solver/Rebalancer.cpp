@@ -0,0 +1,157 @@
+/**
+ * @file
+ * This file is part of SeisSol.
+ *
+ * @section LICENSE
+ * Copyright (c) 2020, SeisSol Group
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @section DESCRIPTION
+ * Rebalancing of the partitioning via restarts from checkpoints.
+ **/
+
+#include "Rebalancer.h"
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "SeisSol.h"
+#include "Parallel/MPI.h"
+#include "Numerical_aux/Statistics.h"
+#if defined(USE_METIS) && defined(USE_HDF) && defined(USE_MPI)
+#include "Geometry/PUMLReader.h"
+#endif // defined(USE_METIS) && defined(USE_HDF) && defined(USE_MPI)
+
+#include <utils/env.h>
+#include <utils/logger.h>
+
+void seissol::Rebalancer::setUp( double currentTime, double finalTime ) {
+  const int rank = seissol::MPI::mpi.rank();
+
+  std::string mode = utils::Env::get<std::string>("SEISSOL_REBALANCE", "none");
+  if (mode == "none") {
+    return;
+  } else if (mode != "restart") {
+    logError() << "Unknown rebalancing mode" << mode;
+  }
+
+#if defined(USE_METIS) && defined(USE_HDF) && defined(USE_MPI)
+  // the restart has to read the partition file and the checkpoint with a different partitioning
+  checkpoint::Manager const& checkPointManager = seissol::SeisSol::main.checkPointManager();
+  if (checkPointManager.backend() != checkpoint::HDF5) {
+    logWarning(rank) << "Rebalancing requires the HDF5 checkpoint backend. Rebalancing disabled.";
+    return;
+  }
+  std::ifstream partitionFile(PUMLReader::partitionFileName(checkPointManager.filename().c_str()));
+  if (!partitionFile) {
+    logWarning(rank) << "Rebalancing requires a PUML mesh with checkpointing. Rebalancing disabled.";
+    return;
+  }
+
+  // the setup reads and partitions the mesh, initializes the data structures and,
+  // for a restarted run, loads the checkpoint
+  m_restarted = (currentTime > 0.0);
+  m_setupCost = seissol::SeisSol::main.setupTime();
+  MPI_Allreduce(MPI_IN_PLACE, &m_setupCost, 1, MPI_DOUBLE, MPI_MAX, seissol::MPI::mpi.comm());
+  m_launchCost = utils::Env::get<double>("SEISSOL_REBALANCE_COST", 0.0);
+
+  m_enabled = true;
+  m_finalTime = finalTime;
+  m_lastTime = currentTime;
+  seissol::SeisSol::main.timeManager().getComputeTimes(m_lastVolumeTime, m_lastDynamicRuptureTime);
+
+  logInfo(rank) << "Rebalancing by restarts at checkpoints enabled, setup time of this run:" << m_setupCost
+                << "seconds, additional launch cost:" << m_launchCost << "seconds.";
+#else // defined(USE_METIS) && defined(USE_HDF) && defined(USE_MPI)
+  logWarning(rank) << "Rebalancing requires MPI, METIS and HDF5. Rebalancing disabled.";
+#endif // defined(USE_METIS) && defined(USE_HDF) && defined(USE_MPI)
+}
+
+bool seissol::Rebalancer::checkpointWritten( double currentTime, double checkPointWriteTime ) {
+  if (!m_enabled) {
+    return false;
+  }
+
+#if defined(USE_METIS) && defined(USE_HDF) && defined(USE_MPI)
+  const int rank = seissol::MPI::mpi.rank();
+
+  // the setup of a restarted run includes loading the checkpoint, otherwise
+  // loading is estimated by writing the same checkpoint
+  double checkPointLoadCost = 0.0;
+  if (!m_restarted) {
+    checkPointLoadCost = checkPointWriteTime;
+    MPI_Allreduce(MPI_IN_PLACE, &checkPointLoadCost, 1, MPI_DOUBLE, MPI_MAX, seissol::MPI::mpi.comm());
+  }
+  double const restartCost = m_setupCost + checkPointLoadCost + m_launchCost;
+
+  double volumeTime;
+  double dynamicRuptureTime;
+  seissol::SeisSol::main.timeManager().getComputeTimes(volumeTime, dynamicRuptureTime);
+  double const interval = currentTime - m_lastTime;
+  double const volumeDelta = volumeTime - m_lastVolumeTime;
+  double const dynamicRuptureDelta = dynamicRuptureTime - m_lastDynamicRuptureTime;
+  m_lastTime = currentTime;
+  m_lastVolumeTime = volumeTime;
+  m_lastDynamicRuptureTime = dynamicRuptureTime;
+
+  if (interval <= 0.0) {
+    return false;
+  }
+
+  // with a perfect balance, every rank would need the mean time
+  const auto load = seissol::statistics::parallelSummary(volumeDelta + dynamicRuptureDelta);
+  double const gain = (load.max - load.mean) / interval * (m_finalTime - currentTime);
+  double const imbalance = (load.max > 0.0) ? 100.0 * (1.0 - load.mean / load.max) : 0.0;
+  logInfo(rank) << "Load imbalance since the last checkpoint:" << imbalance << "%, predicted gain of rebalancing:"
+                << gain << "seconds, cost of a restart:" << restartCost << "seconds (setup:" << m_setupCost
+                << utils::nospace << ", checkpoint load: " << checkPointLoadCost << ", launch: " << m_launchCost << ").";
+  if (gain <= restartCost) {
+    return false;
+  }
+
+  // time per predicted update, only the ratios between the ranks matter
+  auto const& ltsLayout = seissol::SeisSol::main.getLtsLayout();
+  double const cellUpdates = ltsLayout.getPredictedCellUpdates();
+  double const dynamicRuptureUpdates = ltsLayout.getPredictedDynamicRuptureUpdates();
+  double costs[2] = { (cellUpdates > 0.0) ? volumeDelta / cellUpdates : 0.0,
+                      (dynamicRuptureUpdates > 0.0) ? dynamicRuptureDelta / dynamicRuptureUpdates : 0.0 };
+  std::vector<double> rankCosts(2 * seissol::MPI::mpi.size());
+  MPI_Allgather(costs, 2, MPI_DOUBLE, rankCosts.data(), 2, MPI_DOUBLE, seissol::MPI::mpi.comm());
+
+  PUMLReader::writeRankCosts(seissol::SeisSol::main.checkPointManager().filename().c_str(), rankCosts);
+
+  logInfo(rank) << "Stopping the simulation at" << currentTime << "for rebalancing."
+                << "Restart SeisSol to continue from the checkpoint with a rebalanced partitioning"
+                << utils::nospace << " (exit status " << RestartExitStatus << ").";
+  return true;
+#else // defined(USE_METIS) && defined(USE_HDF) && defined(USE_MPI)
+  return false;
+#endif // defined(USE_METIS) && defined(USE_HDF) && defined(USE_MPI)
+}
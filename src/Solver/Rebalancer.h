@@ -0,0 +1,102 @@
+/**
+ * @file
+ * This file is part of SeisSol.
+ *
+ * @section LICENSE
+ * Copyright (c) 2020, SeisSol Group
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @section DESCRIPTION
+ * Rebalancing of the partitioning via restarts from checkpoints.
+ **/
+
+#ifndef SOLVER_REBALANCER_H_
+#define SOLVER_REBALANCER_H_
+
+namespace seissol {
+  class Rebalancer;
+}
+
+/**
+ * Measures the load of the ranks between checkpoints and stops the simulation
+ * if a restart with a rebalanced partitioning pays off until the end of the simulation.
+ *
+ * The rebalancing itself happens in the next run, i.e. the interface of this mode
+ * is the stop/restart contract: after the checkpoint, the measured costs of the ranks
+ * are stored in the partition file, SeisSol exits with RestartExitStatus and the job
+ * script restarts it with the same parameters and number of ranks. The restarted run
+ * derives the new partitioning from the costs (see PUMLReader) and continues from the checkpoint.
+ **/
+class seissol::Rebalancer {
+  private:
+    //! True if rebalancing is possible and requested
+    bool m_enabled = false;
+
+    //! final time of the simulation
+    double m_finalTime = 0.0;
+
+    //! true if this run continued from a checkpoint, i.e. its setup is a measured restart
+    bool m_restarted = false;
+
+    //! wall time of the setup of this run (maximum over all ranks)
+    double m_setupCost = 0.0;
+
+    //! additional cost of a restart which is not visible to SeisSol, e.g. the job launch (SEISSOL_REBALANCE_COST)
+    double m_launchCost = 0.0;
+
+    //! simulation time of the last measurement
+    double m_lastTime = 0.0;
+
+    //! compute times of this rank at the last measurement
+    double m_lastVolumeTime = 0.0;
+    double m_lastDynamicRuptureTime = 0.0;
+
+  public:
+    //! Exit status of SeisSol if it stopped for a rebalanced restart (EX_TEMPFAIL of sysexits.h)
+    static constexpr int RestartExitStatus = 75;
+
+    /**
+     * Reads SEISSOL_REBALANCE and checks that the restart can repartition. Collective.
+     *
+     * @param currentTime start time of the simulation.
+     * @param finalTime final time of the simulation.
+     **/
+    void setUp( double currentTime, double finalTime );
+
+    /**
+     * Decides whether to rebalance after a checkpoint was written. Collective.
+     *
+     * @param currentTime time of the checkpoint.
+     * @param checkPointWriteTime wall time this rank spent writing the checkpoint.
+     * @return true if the simulation should stop for a rebalanced restart.
+     **/
+    bool checkpointWritten( double currentTime, double checkPointWriteTime );
+};
+
+#endif
@@ -42,6 +42,7 @@
 #include <limits>
 
 #include "Simulator.h"
+#include "Rebalancer.h"
 #include "SeisSol.h"
 #include "Interoperability.h"
 #include "time_stepping/TimeManager.h"
@@ -57,7 +58,8 @@ seissol::Simulator::Simulator():
   m_finalTime(          0 ),
   m_checkPointTime(     0 ),
   m_checkPointInterval( std::numeric_limits< double >::max() ),
-  m_loadCheckPoint( false ) {}
+  m_loadCheckPoint( false ),
+  m_stoppedForRebalancing( false ) {}
 
 void seissol::Simulator::setCheckPointInterval( double i_checkPointInterval ) {
   assert( m_checkPointInterval > 0 );
@@ -86,10 +88,14 @@ void seissol::Simulator::simulate() {
 
   // Set start time (required for checkpointing)
   seissol::SeisSol::main.timeManager().setInitialTimes(m_currentTime);
+  double const simulationStartTime = m_currentTime;
 
   // tolerance in time which is neglected
   double l_timeTolerance = seissol::SeisSol::main.timeManager().getTimeTolerance();
 
+  // Load the (possibly restarted) friction state into the layer-wise friction solver
+  e_interoperability.initializeFrictionSolver();
+
   // Copy initial dynamic rupture in order to ensure correct initial fault output
   e_interoperability.copyDynamicRuptureState();
 
@@ -113,6 +119,10 @@ void seissol::Simulator::simulate() {
   upcomingTime = std::min( upcomingTime, Modules::callSyncHook(m_currentTime, 0.0) );
   upcomingTime = std::min( upcomingTime, std::abs(m_checkPointTime + m_checkPointInterval) );
 
+  Rebalancer rebalancer;
+  rebalancer.setUp(m_currentTime, m_finalTime);
+
+  bool loadBalanceReported = false;
   while( m_finalTime > m_currentTime + l_timeTolerance ) {
     if (upcomingTime < m_currentTime + l_timeTolerance)
       logError() << "Simulator did not advance in time from" << m_currentTime << "to" << upcomingTime;
@@ -130,16 +140,36 @@ void seissol::Simulator::simulate() {
     upcomingTime = std::min(upcomingTime, Modules::callSyncHook(m_currentTime, l_timeTolerance));
 
     // write checkpoint if required
+    bool rebalance = false;
     if( std::abs( m_currentTime - ( m_checkPointTime + m_checkPointInterval ) ) < l_timeTolerance ) {
       const unsigned int faultTimeStep = seissol::SeisSol::main.faultWriter().timestep();
+      e_interoperability.synchronizeFrictionStateToFortran();
+      Stopwatch checkPointStopwatch;
+      checkPointStopwatch.start();
       seissol::SeisSol::main.checkPointManager().write(m_currentTime, faultTimeStep);
+      double const checkPointWriteTime = checkPointStopwatch.stop();
       m_checkPointTime += m_checkPointInterval;
+      rebalance = rebalancer.checkpointWritten(m_currentTime, checkPointWriteTime);
     }
     upcomingTime = std::min(upcomingTime, m_checkPointTime + m_checkPointInterval);
 
     printNodePerformance( stopwatch.split() );
+
+    // compare the predicted and measured load once the first synchronization interval is complete
+    if (!loadBalanceReported) {
+      seissol::SeisSol::main.timeManager().printLoadBalance();
+      loadBalanceReported = true;
+    }
+
+    // the simulation continues from the checkpoint with a new partitioning
+    if (rebalance) {
+      m_stoppedForRebalancing = true;
+      break;
+    }
   }
   
+  // the magnitude output after the simulation reads the final friction state from Fortran
+  e_interoperability.synchronizeFrictionStateToFortran();
   Modules::callSyncHook(m_currentTime, l_timeTolerance, true);
 
   // stop the communication thread (if applicable)
@@ -147,6 +177,8 @@ void seissol::Simulator::simulate() {
 
   double wallTime = stopwatch.split();
   logInfo(seissol::MPI::mpi.rank()) << "Elapsed time (via clock_gettime):" << wallTime << "seconds.";
+  logInfo(seissol::MPI::mpi.rank()) << "Predicted time (LTS cost model):"
+    << seissol::SeisSol::main.getLtsLayout().getPredictedWallTime(m_currentTime - simulationStartTime) << "seconds.";
 
   seissol::SeisSol::main.timeManager().printComputationTime();
 
@@ -66,6 +66,9 @@ class seissol::Simulator {
     //! If true, a checkpoint is loaded before the simulation
     bool m_loadCheckPoint;
 
+    //! True if the simulation stopped at a checkpoint for a rebalanced restart
+    bool m_stoppedForRebalancing;
+
   public:
     /**
      * Constructor, which initializes all values.
@@ -110,6 +113,13 @@ class seissol::Simulator {
      * Simulates until finished.
      **/
     void simulate();
+
+    /**
+     * Returns true if the simulation stopped before the final time for a rebalanced restart.
+     */
+    bool stoppedForRebalancing() const {
+      return m_stoppedForRebalancing;
+    }
 };
 
 #endif
@@ -286,4 +286,306 @@ module f_ctof_bind_interoperability
       material(:) = (/ rho, mu, lambda, Qp, Qs /)
       call fitAttenuation(material, l_materialFitted, l_domain%EQN)
     end subroutine
+
+    subroutine f_interoperability_getFrictionLawParameters( i_domain, o_frictionLaw, o_instantaneousHealing, o_t0, &
+      o_rsF0, o_rsA, o_rsB, o_rsSl0, o_rsSr0 ) bind (c, name='f_interoperability_getFrictionLawParameters')
+      use iso_c_binding
+      use typesDef
+      implicit none
+
+      type(c_ptr), value                     :: i_domain
+      type(tUnstructDomainDescript), pointer :: l_domain
+
+      integer(kind=c_int)                    :: o_frictionLaw, o_instantaneousHealing
+      real(kind=c_double)                    :: o_t0, o_rsF0, o_rsA, o_rsB, o_rsSl0, o_rsSr0
+
+      call c_f_pointer( i_domain, l_domain )
+
+      o_frictionLaw          = l_domain%EQN%FL
+      o_instantaneousHealing = l_domain%DISC%DynRup%inst_healing
+      o_t0                   = l_domain%DISC%DynRup%t_0
+      o_rsF0                 = l_domain%DISC%DynRup%RS_f0
+      o_rsA                  = l_domain%DISC%DynRup%RS_a
+      o_rsB                  = l_domain%DISC%DynRup%RS_b
+      o_rsSl0                = l_domain%DISC%DynRup%RS_sl0
+      o_rsSr0                = l_domain%DISC%DynRup%RS_sr0
+    end subroutine
+
+    subroutine f_interoperability_getDynamicRuptureParameters( i_domain, i_numberOfFaces, i_meshFaces, i_numberOfPoints, i_ld, &
+      o_initialStressInFaultCS, o_cohesion, o_muS, o_muD, o_dC, o_forcedRuptureTime, o_magnitudeOutput ) &
+      bind (c, name='f_interoperability_getDynamicRuptureParameters')
+      use iso_c_binding
+      use typesDef
+      implicit none
+
+      type(c_ptr), value                     :: i_domain
+      type(tUnstructDomainDescript), pointer :: l_domain
+
+      integer(kind=c_int), value             :: i_numberOfFaces
+      integer(kind=c_int), value             :: i_numberOfPoints
+      integer(kind=c_int), value             :: i_ld
+
+      type(c_ptr), value                     :: i_meshFaces
+      integer(kind=c_int), pointer           :: l_meshFaces(:)
+
+      type(c_ptr), value                     :: o_initialStressInFaultCS, o_cohesion, o_muS, o_muD, o_dC, &
+                                                o_forcedRuptureTime, o_magnitudeOutput
+      REAL_TYPE, pointer                     :: l_initialStressInFaultCS(:,:,:)
+      REAL_TYPE, pointer                     :: l_cohesion(:,:), l_muS(:,:), l_muD(:,:), l_dC(:,:), l_forcedRuptureTime(:,:)
+      integer(kind=c_int), pointer           :: l_magnitudeOutput(:)
+
+      integer :: iFace, meshFace, nPoints
+
+      call c_f_pointer( i_domain,                 l_domain )
+      call c_f_pointer( i_meshFaces,              l_meshFaces,              [i_numberOfFaces] )
+      call c_f_pointer( o_initialStressInFaultCS, l_initialStressInFaultCS, [i_ld, 6, i_numberOfFaces] )
+      call c_f_pointer( o_cohesion,               l_cohesion,               [i_ld, i_numberOfFaces] )
+      call c_f_pointer( o_muS,                    l_muS,                    [i_ld, i_numberOfFaces] )
+      call c_f_pointer( o_muD,                    l_muD,                    [i_ld, i_numberOfFaces] )
+      call c_f_pointer( o_dC,                     l_dC,                     [i_ld, i_numberOfFaces] )
+      call c_f_pointer( o_forcedRuptureTime,      l_forcedRuptureTime,      [i_ld, i_numberOfFaces] )
+      call c_f_pointer( o_magnitudeOutput,        l_magnitudeOutput,        [i_numberOfFaces] )
+
+      nPoints = i_numberOfPoints
+      do iFace = 1, i_numberOfFaces
+        meshFace = l_meshFaces(iFace)
+        l_initialStressInFaultCS(1:nPoints,:,iFace) = l_domain%EQN%InitialStressInFaultCS(1:nPoints,:,meshFace)
+        if (allocated(l_domain%DISC%DynRup%cohesion)) then
+          l_cohesion(1:nPoints,iFace) = l_domain%DISC%DynRup%cohesion(1:nPoints,meshFace)
+        endif
+        if (allocated(l_domain%DISC%DynRup%Mu_S)) then
+          l_muS(1:nPoints,iFace) = l_domain%DISC%DynRup%Mu_S(1:nPoints,meshFace)
+        endif
+        if (allocated(l_domain%DISC%DynRup%Mu_D)) then
+          l_muD(1:nPoints,iFace) = l_domain%DISC%DynRup%Mu_D(1:nPoints,meshFace)
+        endif
+        if (allocated(l_domain%DISC%DynRup%D_C)) then
+          l_dC(1:nPoints,iFace) = l_domain%DISC%DynRup%D_C(1:nPoints,meshFace)
+        endif
+        if (allocated(l_domain%DISC%DynRup%forced_rupture_time)) then
+          l_forcedRuptureTime(1:nPoints,iFace) = l_domain%DISC%DynRup%forced_rupture_time(1:nPoints,meshFace)
+        endif
+        l_magnitudeOutput(iFace) = 0
+        if (allocated(l_domain%DISC%DynRup%magnitude_out)) then
+          if (l_domain%DISC%DynRup%magnitude_out(meshFace)) then
+            l_magnitudeOutput(iFace) = 1
+          endif
+        endif
+      enddo
+    end subroutine
+
+    subroutine f_interoperability_getDynamicRuptureState( i_domain, i_numberOfFaces, i_meshFaces, i_numberOfPoints, i_ld, &
+      o_mu, o_slip, o_slip1, o_slip2, o_slipRate1, o_slipRate2, o_stateVariable, o_tractionXY, o_tractionXZ, &
+      o_ruptureTime, o_dynStressTime, o_peakSlipRate, o_ruptureFront, o_dynStressPending, o_averagedSlip ) &
+      bind (c, name='f_interoperability_getDynamicRuptureState')
+      use iso_c_binding
+      use typesDef
+      implicit none
+
+      type(c_ptr), value                     :: i_domain
+      type(tUnstructDomainDescript), pointer :: l_domain
+
+      integer(kind=c_int), value             :: i_numberOfFaces
+      integer(kind=c_int), value             :: i_numberOfPoints
+      integer(kind=c_int), value             :: i_ld
+
+      type(c_ptr), value                     :: i_meshFaces
+      integer(kind=c_int), pointer           :: l_meshFaces(:)
+
+      type(c_ptr), value                     :: o_mu, o_slip, o_slip1, o_slip2, o_slipRate1, o_slipRate2, &
+                                                o_stateVariable, o_tractionXY, o_tractionXZ, o_ruptureTime, &
+                                                o_dynStressTime, o_peakSlipRate, o_ruptureFront, o_dynStressPending, &
+                                                o_averagedSlip
+      REAL_TYPE, pointer                     :: l_mu(:,:), l_slip(:,:), l_slip1(:,:), l_slip2(:,:), l_slipRate1(:,:), l_slipRate2(:,:), &
+                                                l_stateVariable(:,:), l_tractionXY(:,:), l_tractionXZ(:,:), l_ruptureTime(:,:), &
+                                                l_dynStressTime(:,:), l_peakSlipRate(:,:)
+      integer(kind=c_int), pointer           :: l_ruptureFront(:,:), l_dynStressPending(:,:)
+      REAL_TYPE, pointer                     :: l_averagedSlip(:)
+
+      integer :: iFace, meshFace, nPoints
+
+      call c_f_pointer( i_domain,    l_domain )
+      call c_f_pointer( i_meshFaces, l_meshFaces, [i_numberOfFaces] )
+      call c_f_pointer( o_mu, l_mu, [i_ld, i_numberOfFaces] )
+      call c_f_pointer( o_slip, l_slip, [i_ld, i_numberOfFaces] )
+      call c_f_pointer( o_slip1, l_slip1, [i_ld, i_numberOfFaces] )
+      call c_f_pointer( o_slip2, l_slip2, [i_ld, i_numberOfFaces] )
+      call c_f_pointer( o_slipRate1, l_slipRate1, [i_ld, i_numberOfFaces] )
+      call c_f_pointer( o_slipRate2, l_slipRate2, [i_ld, i_numberOfFaces] )
+      call c_f_pointer( o_stateVariable, l_stateVariable, [i_ld, i_numberOfFaces] )
+      call c_f_pointer( o_tractionXY, l_tractionXY, [i_ld, i_numberOfFaces] )
+      call c_f_pointer( o_tractionXZ, l_tractionXZ, [i_ld, i_numberOfFaces] )
+      call c_f_pointer( o_ruptureTime, l_ruptureTime, [i_ld, i_numberOfFaces] )
+      call c_f_pointer( o_dynStressTime, l_dynStressTime, [i_ld, i_numberOfFaces] )
+      call c_f_pointer( o_peakSlipRate, l_peakSlipRate, [i_ld, i_numberOfFaces] )
+      call c_f_pointer( o_ruptureFront, l_ruptureFront, [i_ld, i_numberOfFaces] )
+      call c_f_pointer( o_dynStressPending, l_dynStressPending, [i_ld, i_numberOfFaces] )
+      call c_f_pointer( o_averagedSlip, l_averagedSlip, [i_numberOfFaces] )
+
+      nPoints = i_numberOfPoints
+      do iFace = 1, i_numberOfFaces
+        meshFace = l_meshFaces(iFace)
+        l_mu(:,iFace) = 0.0
+        if (allocated(l_domain%DISC%DynRup%Mu)) then
+          l_mu(1:nPoints,iFace) = l_domain%DISC%DynRup%Mu(1:nPoints,meshFace)
+        endif
+        l_slip(:,iFace) = 0.0
+        if (allocated(l_domain%DISC%DynRup%Slip)) then
+          l_slip(1:nPoints,iFace) = l_domain%DISC%DynRup%Slip(1:nPoints,meshFace)
+        endif
+        l_slip1(:,iFace) = 0.0
+        if (allocated(l_domain%DISC%DynRup%Slip1)) then
+          l_slip1(1:nPoints,iFace) = l_domain%DISC%DynRup%Slip1(1:nPoints,meshFace)
+        endif
+        l_slip2(:,iFace) = 0.0
+        if (allocated(l_domain%DISC%DynRup%Slip2)) then
+          l_slip2(1:nPoints,iFace) = l_domain%DISC%DynRup%Slip2(1:nPoints,meshFace)
+        endif
+        l_slipRate1(:,iFace) = 0.0
+        if (allocated(l_domain%DISC%DynRup%SlipRate1)) then
+          l_slipRate1(1:nPoints,iFace) = l_domain%DISC%DynRup%SlipRate1(1:nPoints,meshFace)
+        endif
+        l_slipRate2(:,iFace) = 0.0
+        if (allocated(l_domain%DISC%DynRup%SlipRate2)) then
+          l_slipRate2(1:nPoints,iFace) = l_domain%DISC%DynRup%SlipRate2(1:nPoints,meshFace)
+        endif
+        l_stateVariable(:,iFace) = 0.0
+        if (allocated(l_domain%DISC%DynRup%StateVar)) then
+          l_stateVariable(1:nPoints,iFace) = l_domain%DISC%DynRup%StateVar(1:nPoints,meshFace)
+        endif
+        l_tractionXY(:,iFace) = 0.0
+        if (allocated(l_domain%DISC%DynRup%TracXY)) then
+          l_tractionXY(1:nPoints,iFace) = l_domain%DISC%DynRup%TracXY(1:nPoints,meshFace)
+        endif
+        l_tractionXZ(:,iFace) = 0.0
+        if (allocated(l_domain%DISC%DynRup%TracXZ)) then
+          l_tractionXZ(1:nPoints,iFace) = l_domain%DISC%DynRup%TracXZ(1:nPoints,meshFace)
+        endif
+        l_ruptureTime(:,iFace) = 0.0
+        if (allocated(l_domain%DISC%DynRup%rupture_time)) then
+          l_ruptureTime(1:nPoints,iFace) = l_domain%DISC%DynRup%rupture_time(1:nPoints,meshFace)
+        endif
+        l_dynStressTime(:,iFace) = 0.0
+        if (allocated(l_domain%DISC%DynRup%dynStress_time)) then
+          l_dynStressTime(1:nPoints,iFace) = l_domain%DISC%DynRup%dynStress_time(1:nPoints,meshFace)
+        endif
+        l_peakSlipRate(:,iFace) = 0.0
+        if (allocated(l_domain%DISC%DynRup%PeakSR)) then
+          l_peakSlipRate(1:nPoints,iFace) = l_domain%DISC%DynRup%PeakSR(1:nPoints,meshFace)
+        endif
+        l_ruptureFront(:,iFace) = 0
+        l_dynStressPending(:,iFace) = 0
+        if (allocated(l_domain%DISC%DynRup%RF)) then
+          where (l_domain%DISC%DynRup%RF(1:nPoints,meshFace)) l_ruptureFront(1:nPoints,iFace) = 1
+        endif
+        if (allocated(l_domain%DISC%DynRup%DS)) then
+          where (l_domain%DISC%DynRup%DS(1:nPoints,meshFace)) l_dynStressPending(1:nPoints,iFace) = 1
+        endif
+        l_averagedSlip(iFace) = 0.0
+        if (allocated(l_domain%DISC%DynRup%averaged_Slip)) then
+          l_averagedSlip(iFace) = l_domain%DISC%DynRup%averaged_Slip(meshFace)
+        endif
+      enddo
+    end subroutine
+
+    subroutine f_interoperability_setDynamicRuptureState( i_domain, i_numberOfFaces, i_meshFaces, i_numberOfPoints, i_ld, &
+      i_mu, i_slip, i_slip1, i_slip2, i_slipRate1, i_slipRate2, i_stateVariable, i_tractionXY, i_tractionXZ, &
+      i_ruptureTime, i_dynStressTime, i_peakSlipRate, i_ruptureFront, i_dynStressPending, i_averagedSlip ) &
+      bind (c, name='f_interoperability_setDynamicRuptureState')
+      use iso_c_binding
+      use typesDef
+      implicit none
+
+      type(c_ptr), value                     :: i_domain
+      type(tUnstructDomainDescript), pointer :: l_domain
+
+      integer(kind=c_int), value             :: i_numberOfFaces
+      integer(kind=c_int), value             :: i_numberOfPoints
+      integer(kind=c_int), value             :: i_ld
+
+      type(c_ptr), value                     :: i_meshFaces
+      integer(kind=c_int), pointer           :: l_meshFaces(:)
+
+      type(c_ptr), value                     :: i_mu, i_slip, i_slip1, i_slip2, i_slipRate1, i_slipRate2, &
+                                                i_stateVariable, i_tractionXY, i_tractionXZ, i_ruptureTime, &
+                                                i_dynStressTime, i_peakSlipRate, i_ruptureFront, i_dynStressPending, &
+                                                i_averagedSlip
+      REAL_TYPE, pointer                     :: l_mu(:,:), l_slip(:,:), l_slip1(:,:), l_slip2(:,:), l_slipRate1(:,:), l_slipRate2(:,:), &
+                                                l_stateVariable(:,:), l_tractionXY(:,:), l_tractionXZ(:,:), l_ruptureTime(:,:), &
+                                                l_dynStressTime(:,:), l_peakSlipRate(:,:)
+      integer(kind=c_int), pointer           :: l_ruptureFront(:,:), l_dynStressPending(:,:)
+      REAL_TYPE, pointer                     :: l_averagedSlip(:)
+
+      integer :: iFace, meshFace, nPoints
+
+      call c_f_pointer( i_domain,    l_domain )
+      call c_f_pointer( i_meshFaces, l_meshFaces, [i_numberOfFaces] )
+      call c_f_pointer( i_mu, l_mu, [i_ld, i_numberOfFaces] )
+      call c_f_pointer( i_slip, l_slip, [i_ld, i_numberOfFaces] )
+      call c_f_pointer( i_slip1, l_slip1, [i_ld, i_numberOfFaces] )
+      call c_f_pointer( i_slip2, l_slip2, [i_ld, i_numberOfFaces] )
+      call c_f_pointer( i_slipRate1, l_slipRate1, [i_ld, i_numberOfFaces] )
+      call c_f_pointer( i_slipRate2, l_slipRate2, [i_ld, i_numberOfFaces] )
+      call c_f_pointer( i_stateVariable, l_stateVariable, [i_ld, i_numberOfFaces] )
+      call c_f_pointer( i_tractionXY, l_tractionXY, [i_ld, i_numberOfFaces] )
+      call c_f_pointer( i_tractionXZ, l_tractionXZ, [i_ld, i_numberOfFaces] )
+      call c_f_pointer( i_ruptureTime, l_ruptureTime, [i_ld, i_numberOfFaces] )
+      call c_f_pointer( i_dynStressTime, l_dynStressTime, [i_ld, i_numberOfFaces] )
+      call c_f_pointer( i_peakSlipRate, l_peakSlipRate, [i_ld, i_numberOfFaces] )
+      call c_f_pointer( i_ruptureFront, l_ruptureFront, [i_ld, i_numberOfFaces] )
+      call c_f_pointer( i_dynStressPending, l_dynStressPending, [i_ld, i_numberOfFaces] )
+      call c_f_pointer( i_averagedSlip, l_averagedSlip, [i_numberOfFaces] )
+
+      nPoints = i_numberOfPoints
+      do iFace = 1, i_numberOfFaces
+        meshFace = l_meshFaces(iFace)
+        ! keep the one step delay of the output arrays of the Fortran friction law
+        call copyDynamicRuptureState(l_domain, meshFace, meshFace)
+        if (allocated(l_domain%DISC%DynRup%Mu)) then
+          l_domain%DISC%DynRup%Mu(1:nPoints,meshFace) = l_mu(1:nPoints,iFace)
+        endif
+        if (allocated(l_domain%DISC%DynRup%Slip)) then
+          l_domain%DISC%DynRup%Slip(1:nPoints,meshFace) = l_slip(1:nPoints,iFace)
+        endif
+        if (allocated(l_domain%DISC%DynRup%Slip1)) then
+          l_domain%DISC%DynRup%Slip1(1:nPoints,meshFace) = l_slip1(1:nPoints,iFace)
+        endif
+        if (allocated(l_domain%DISC%DynRup%Slip2)) then
+          l_domain%DISC%DynRup%Slip2(1:nPoints,meshFace) = l_slip2(1:nPoints,iFace)
+        endif
+        if (allocated(l_domain%DISC%DynRup%SlipRate1)) then
+          l_domain%DISC%DynRup%SlipRate1(1:nPoints,meshFace) = l_slipRate1(1:nPoints,iFace)
+        endif
+        if (allocated(l_domain%DISC%DynRup%SlipRate2)) then
+          l_domain%DISC%DynRup%SlipRate2(1:nPoints,meshFace) = l_slipRate2(1:nPoints,iFace)
+        endif
+        if (allocated(l_domain%DISC%DynRup%StateVar)) then
+          l_domain%DISC%DynRup%StateVar(1:nPoints,meshFace) = l_stateVariable(1:nPoints,iFace)
+        endif
+        if (allocated(l_domain%DISC%DynRup%TracXY)) then
+          l_domain%DISC%DynRup%TracXY(1:nPoints,meshFace) = l_tractionXY(1:nPoints,iFace)
+        endif
+        if (allocated(l_domain%DISC%DynRup%TracXZ)) then
+          l_domain%DISC%DynRup%TracXZ(1:nPoints,meshFace) = l_tractionXZ(1:nPoints,iFace)
+        endif
+        if (allocated(l_domain%DISC%DynRup%rupture_time)) then
+          l_domain%DISC%DynRup%rupture_time(1:nPoints,meshFace) = l_ruptureTime(1:nPoints,iFace)
+        endif
+        if (allocated(l_domain%DISC%DynRup%dynStress_time)) then
+          l_domain%DISC%DynRup%dynStress_time(1:nPoints,meshFace) = l_dynStressTime(1:nPoints,iFace)
+        endif
+        if (allocated(l_domain%DISC%DynRup%PeakSR)) then
+          l_domain%DISC%DynRup%PeakSR(1:nPoints,meshFace) = l_peakSlipRate(1:nPoints,iFace)
+        endif
+        if (allocated(l_domain%DISC%DynRup%RF)) then
+          l_domain%DISC%DynRup%RF(1:nPoints,meshFace) = (l_ruptureFront(1:nPoints,iFace) .ne. 0)
+        endif
+        if (allocated(l_domain%DISC%DynRup%DS)) then
+          l_domain%DISC%DynRup%DS(1:nPoints,meshFace) = (l_dynStressPending(1:nPoints,iFace) .ne. 0)
+        endif
+        if (allocated(l_domain%DISC%DynRup%averaged_Slip)) then
+          l_domain%DISC%DynRup%averaged_Slip(meshFace) = l_averagedSlip(iFace)
+        endif
+      enddo
+    end subroutine
 end module
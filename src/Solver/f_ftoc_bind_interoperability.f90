@@ -187,6 +187,17 @@ module f_ftoc_bind_interoperability
     end subroutine
   end interface
 
+  interface
+    subroutine c_interoperability_findFaultReceivers( numberOfPoints, points, tolerance, faultIds ) bind( C, name='c_interoperability_findFaultReceivers' )
+      use iso_c_binding, only: c_int, c_double
+      implicit none
+      integer(kind=c_int), value                      :: numberOfPoints
+      real(kind=c_double), dimension(*), intent(in)   :: points
+      real(kind=c_double), value                      :: tolerance
+      integer(kind=c_int), dimension(*), intent(out)  :: faultIds
+    end subroutine
+  end interface
+
   interface c_interoperability_setMaterial
     subroutine c_interoperability_setMaterial( i_elem, i_side, i_materialVal, i_numMaterialVals ) bind( C, name='c_interoperability_setMaterial' )
     use iso_c_binding
@@ -245,6 +256,11 @@ module f_ftoc_bind_interoperability
     end subroutine
   end interface
 
+  interface c_interoperability_enablePlasticity
+    subroutine c_interoperability_enablePlasticity() bind( C, name='c_interoperability_enablePlasticity' )
+    end subroutine
+  end interface
+
   interface
     subroutine c_interoperability_enableWaveFieldOutput( i_waveFieldInterval, i_waveFieldFilename ) bind( C, name='c_interoperability_enableWaveFieldOutput' )
       use iso_c_binding
@@ -382,6 +398,12 @@ module f_ftoc_bind_interoperability
       end subroutine
   end interface
 
+  interface
+    subroutine c_interoperability_synchronizeFrictionState() bind( C, name='c_interoperability_synchronizeFrictionState' )
+      implicit none
+    end subroutine
+  end interface
+
   interface
     real(kind=c_double) function c_interoperability_M2invDiagonal(no) bind( C, name='c_interoperability_M2invDiagonal' )
       use iso_c_binding, only: c_int, c_double
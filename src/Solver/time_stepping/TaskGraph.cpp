@@ -0,0 +1,231 @@
+/**
+ * @file
+ * This file is part of SeisSol.
+ *
+ * @section LICENSE
+ * Copyright (c) 2020, SeisSol Group
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @section DESCRIPTION
+ * Task graph based scheduling of the time cluster updates.
+ **/
+
+#include "TaskGraph.h"
+#include "TimeCluster.h"
+
+#include <algorithm>
+#include <utils/env.h>
+#include <utils/logger.h>
+
+seissol::time_stepping::TaskGraph::ClusterState::ClusterState():
+  phase(Idle),
+  copyLayerSent(false),
+  copyDynamicRuptureSpawned(false),
+  copyNeighboringSpawned(false),
+  interiorNeighboringSpawned(false),
+  openCopyChunks(0),
+  openInteriorChunks(0),
+  openCopyDynamicRuptureChunks(0),
+  openInteriorDynamicRuptureChunks(0),
+  numberOfYieldingCells(0)
+{}
+
+seissol::time_stepping::TaskGraph::TaskGraph():
+  m_chunkSize(utils::Env::get<unsigned>("SEISSOL_TASKGRAPH_CHUNK_SIZE", 256))
+{
+  if (m_chunkSize == 0) {
+    logError() << "SEISSOL_TASKGRAPH_CHUNK_SIZE has to be positive.";
+  }
+}
+
+void seissol::time_stepping::TaskGraph::setClusters( std::vector<TimeCluster*> const& i_clusters ) {
+  m_clusters = i_clusters;
+  m_states.reset(new ClusterState[m_clusters.size()]);
+}
+
+#ifndef ACL_DEVICE
+void seissol::time_stepping::TaskGraph::spawnLocalIntegration( TimeCluster*           i_cluster,
+                                                               enum LayerType         i_layer,
+                                                               std::atomic<unsigned>* io_openChunks,
+                                                               int                    i_priority ) {
+  unsigned l_numberOfCells = i_cluster->getNumberOfCells(i_layer);
+  *io_openChunks += numberOfChunks(l_numberOfCells);
+
+  for (unsigned l_firstCell = 0; l_firstCell < l_numberOfCells; l_firstCell += m_chunkSize) {
+    unsigned l_lastCell = std::min(l_firstCell + m_chunkSize, l_numberOfCells);
+#ifdef _OPENMP
+    #pragma omp task firstprivate(i_cluster, i_layer, io_openChunks, l_firstCell, l_lastCell) priority(i_priority)
+#endif
+    {
+      i_cluster->computeLocalIntegrationChunk(i_layer, l_firstCell, l_lastCell);
+      --(*io_openChunks);
+    }
+  }
+}
+
+void seissol::time_stepping::TaskGraph::spawnNeighboringIntegration( TimeCluster*           i_cluster,
+                                                                     enum LayerType         i_layer,
+                                                                     std::atomic<unsigned>* io_openChunks,
+                                                                     std::atomic<unsigned>* io_numberOfYieldingCells,
+                                                                     int                    i_priority ) {
+  unsigned l_numberOfCells = i_cluster->getNumberOfCells(i_layer);
+  *io_openChunks += numberOfChunks(l_numberOfCells);
+
+  for (unsigned l_firstCell = 0; l_firstCell < l_numberOfCells; l_firstCell += m_chunkSize) {
+    unsigned l_lastCell = std::min(l_firstCell + m_chunkSize, l_numberOfCells);
+#ifdef _OPENMP
+    #pragma omp task firstprivate(i_cluster, i_layer, io_openChunks, io_numberOfYieldingCells, l_firstCell, l_lastCell) priority(i_priority)
+#endif
+    {
+      *io_numberOfYieldingCells += i_cluster->computeNeighboringIntegrationChunk(i_layer, l_firstCell, l_lastCell);
+      --(*io_openChunks);
+    }
+  }
+}
+
+void seissol::time_stepping::TaskGraph::spawnDynamicRupture( TimeCluster*           i_cluster,
+                                                             enum LayerType         i_layer,
+                                                             std::atomic<unsigned>* io_openChunks,
+                                                             int                    i_priority ) {
+  unsigned l_numberOfFaces = i_cluster->getNumberOfDynamicRuptureFaces(i_layer);
+  *io_openChunks += numberOfChunks(l_numberOfFaces);
+
+  for (unsigned l_firstFace = 0; l_firstFace < l_numberOfFaces; l_firstFace += m_chunkSize) {
+    unsigned l_lastFace = std::min(l_firstFace + m_chunkSize, l_numberOfFaces);
+#ifdef _OPENMP
+    #pragma omp task firstprivate(i_cluster, i_layer, io_openChunks, l_firstFace, l_lastFace) priority(i_priority)
+#endif
+    {
+      i_cluster->computeDynamicRuptureChunk(i_layer, l_firstFace, l_lastFace);
+      --(*io_openChunks);
+    }
+  }
+}
+
+#endif // ACL_DEVICE
+
+bool seissol::time_stepping::TaskGraph::advance( unsigned int i_localClusterId ) {
+#ifdef ACL_DEVICE
+  logError() << "The task graph scheduler is not supported for accelerators.";
+  return false;
+#else
+  TimeCluster*  l_cluster = m_clusters[i_localClusterId];
+  ClusterState& l_state   = m_states[i_localClusterId];
+
+  // copy layers (and dynamic rupture) are on the critical path of the communication
+  int const l_highPriority = 1;
+  int const l_lowPriority  = 0;
+
+  switch (l_state.phase) {
+    case Idle:
+      if (l_cluster->m_updatable.localInterior) {
+        // start the local update as soon as the previous sends of the copy layer are complete
+        if (l_cluster->beginLocalUpdate()) {
+          l_state.phase = LocalUpdate;
+#ifdef USE_MPI
+          l_state.copyLayerSent = false;
+          spawnLocalIntegration(l_cluster, Copy, &l_state.openCopyChunks, l_highPriority);
+#else
+          l_state.copyLayerSent = true;
+#endif
+          spawnLocalIntegration(l_cluster, Interior, &l_state.openInteriorChunks, l_lowPriority);
+        }
+      } else if (l_cluster->m_updatable.neighboringInterior) {
+        l_state.phase = NeighboringUpdate;
+        l_state.numberOfYieldingCells = 0;
+        l_state.interiorNeighboringSpawned = false;
+#ifdef USE_MPI
+        l_state.copyDynamicRuptureSpawned = false;
+        l_state.copyNeighboringSpawned = false;
+#else
+        l_state.copyDynamicRuptureSpawned = true;
+        l_state.copyNeighboringSpawned = true;
+#endif
+        spawnDynamicRupture(l_cluster, Interior, &l_state.openInteriorDynamicRuptureChunks, l_highPriority);
+      }
+      return false;
+
+    case LocalUpdate:
+#ifdef USE_MPI
+      if (!l_state.copyLayerSent && l_state.openCopyChunks == 0) {
+        l_cluster->sendCopyLayerUpdate();
+        l_state.copyLayerSent = true;
+      }
+#endif
+      if (l_state.copyLayerSent && l_state.openInteriorChunks == 0) {
+        l_cluster->endLocalUpdate();
+        l_state.phase = Idle;
+        return true;
+      }
+      return false;
+
+    case NeighboringUpdate:
+#ifdef USE_MPI
+      if (!l_state.copyDynamicRuptureSpawned && l_cluster->ghostLayerReceived()) {
+        spawnDynamicRupture(l_cluster, Copy, &l_state.openCopyDynamicRuptureChunks, l_highPriority);
+        l_state.copyDynamicRuptureSpawned = true;
+      }
+#endif
+      if (l_state.openInteriorDynamicRuptureChunks == 0) {
+        if (!l_state.interiorNeighboringSpawned) {
+          spawnNeighboringIntegration(l_cluster, Interior, &l_state.openInteriorChunks, &l_state.numberOfYieldingCells, l_lowPriority);
+          l_state.interiorNeighboringSpawned = true;
+        }
+#ifdef USE_MPI
+        // cells of the copy layer might be adjacent to dynamic rupture faces of the interior
+        if (l_state.copyDynamicRuptureSpawned && !l_state.copyNeighboringSpawned && l_state.openCopyDynamicRuptureChunks == 0) {
+          spawnNeighboringIntegration(l_cluster, Copy, &l_state.openCopyChunks, &l_state.numberOfYieldingCells, l_highPriority);
+          l_state.copyNeighboringSpawned = true;
+        }
+#endif
+      }
+
+      if (l_state.interiorNeighboringSpawned && l_state.copyNeighboringSpawned &&
+          l_state.openInteriorChunks == 0 && l_state.openCopyChunks == 0) {
+        l_cluster->endNeighboringUpdate(l_state.numberOfYieldingCells);
+        l_state.phase = Idle;
+        return true;
+      }
+      return false;
+  }
+
+  return false;
+#endif // ACL_DEVICE
+}
+
+bool seissol::time_stepping::TaskGraph::finished() const {
+  for (unsigned l_cluster = 0; l_cluster < m_clusters.size(); ++l_cluster) {
+    if (m_states[l_cluster].phase != Idle ||
+        m_clusters[l_cluster]->m_updatable.localInterior ||
+        m_clusters[l_cluster]->m_updatable.neighboringInterior) {
+      return false;
+    }
+  }
+  return true;
+}
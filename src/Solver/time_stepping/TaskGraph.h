@@ -0,0 +1,161 @@
+/**
+ * @file
+ * This file is part of SeisSol.
+ *
+ * @section LICENSE
+ * Copyright (c) 2020, SeisSol Group
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @section DESCRIPTION
+ * Task graph based scheduling of the time cluster updates.
+ **/
+
+#ifndef TASKGRAPH_H_
+#define TASKGRAPH_H_
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include <Initializer/tree/Layer.hpp>
+
+namespace seissol {
+  namespace time_stepping {
+    class TimeCluster;
+    class TaskGraph;
+  }
+}
+
+/**
+ * Dependency-driven execution of the time cluster updates.
+ *
+ * The local and neighboring updates of a time cluster are split into chunks of cells of the copy layer and the interior.
+ * Chunks are executed as OpenMP tasks, such that the interior of a large cluster overlaps with the copy layer of a small cluster.
+ * The serial parts of an update (communication, receivers, sources, time bookkeeping) and the MPI calls are executed by the
+ * thread calling advance(), which has to be the master thread of the enclosing parallel region.
+ *
+ * Dependencies within a neighboring update:
+ *   dynamic rupture (interior) -> neighboring integration (interior)
+ *   ghost layer received -> dynamic rupture (copy)
+ *   dynamic rupture (interior) + dynamic rupture (copy) -> neighboring integration (copy)
+ * Dependencies between clusters are derived by the time manager, which sets the m_updatable flags of the clusters.
+ **/
+class seissol::time_stepping::TaskGraph {
+  private:
+    enum Phase {
+      Idle = 0,
+      LocalUpdate,
+      NeighboringUpdate
+    };
+
+    struct ClusterState {
+      Phase phase;
+
+      //! true if the copy layer was sent (local update)
+      bool copyLayerSent;
+
+      //! true if the respective chunks were spawned (neighboring update)
+      bool copyDynamicRuptureSpawned;
+      bool copyNeighboringSpawned;
+      bool interiorNeighboringSpawned;
+
+      //! number of unfinished chunks
+      std::atomic<unsigned> openCopyChunks;
+      std::atomic<unsigned> openInteriorChunks;
+      std::atomic<unsigned> openCopyDynamicRuptureChunks;
+      std::atomic<unsigned> openInteriorDynamicRuptureChunks;
+
+      //! number of cells with plastic yielding in the current neighboring update
+      std::atomic<unsigned> numberOfYieldingCells;
+
+      ClusterState();
+    };
+
+    //! clusters under control of the task graph
+    std::vector<TimeCluster*> m_clusters;
+
+    //! state of the clusters' updates
+    std::unique_ptr<ClusterState[]> m_states;
+
+    //! maximum number of cells (or dynamic rupture faces) per chunk
+    unsigned m_chunkSize;
+
+    /**
+     * Spawns one task per chunk of the local integration.
+     **/
+    void spawnLocalIntegration( TimeCluster*           i_cluster,
+                                enum LayerType         i_layer,
+                                std::atomic<unsigned>* io_openChunks,
+                                int                    i_priority );
+
+    /**
+     * Spawns one task per chunk of the neighboring integration.
+     **/
+    void spawnNeighboringIntegration( TimeCluster*           i_cluster,
+                                      enum LayerType         i_layer,
+                                      std::atomic<unsigned>* io_openChunks,
+                                      std::atomic<unsigned>* io_numberOfYieldingCells,
+                                      int                    i_priority );
+
+    /**
+     * Spawns one task per chunk of dynamic rupture faces.
+     **/
+    void spawnDynamicRupture( TimeCluster*           i_cluster,
+                              enum LayerType         i_layer,
+                              std::atomic<unsigned>* io_openChunks,
+                              int                    i_priority );
+
+    unsigned numberOfChunks( unsigned i_numberOfCells ) const {
+      return (i_numberOfCells + m_chunkSize - 1) / m_chunkSize;
+    }
+
+  public:
+    TaskGraph();
+
+    /**
+     * Sets the clusters under control of the task graph.
+     **/
+    void setClusters( std::vector<TimeCluster*> const& i_clusters );
+
+    /**
+     * Starts updates of the cluster if allowed, spawns chunks whose dependencies are fulfilled
+     * and finishes updates whose chunks are complete.
+     *
+     * @param i_localClusterId local id of the cluster.
+     * @return true if an update of the cluster finished, i.e. the dependencies of the clusters have to be updated.
+     **/
+    bool advance( unsigned int i_localClusterId );
+
+    /**
+     * @return true if no update is in progress or allowed for any cluster.
+     **/
+    bool finished() const;
+};
+
+#endif
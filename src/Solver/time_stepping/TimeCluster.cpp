@@ -70,6 +70,7 @@
  **/
 
 #include "Parallel/MPI.h"
+#include "Parallel/Partition.h"
 
 #ifdef _OPENMP
 #include <omp.h>
@@ -84,6 +85,7 @@
 #include <Kernels/Receiver.h>
 #include <Monitoring/FlopCounter.hpp>
 
+#include <algorithm>
 #include <cassert>
 #include <cstring>
 
@@ -121,8 +123,13 @@ seissol::time_stepping::TimeCluster::TimeCluster( unsigned int
  m_numberOfCellToPointSourcesMappings(0                ),
  m_pointSources(            NULL                       ),
 
+ m_numberOfSkippedPlasticityCells(0                    ),
+ m_usePlasticity(           seissol::SeisSol::main.physicsFeatures().plasticity ),
+ m_integrateQuantities(     seissol::SeisSol::main.physicsFeatures().integrateQuantities ),
+
  m_loopStatistics(          i_loopStatistics           ),
- m_receiverCluster(          nullptr                   )
+ m_receiverCluster(          nullptr                   ),
+ m_groundMotionMaps(         nullptr                   )
 {
     // assert all pointers are valid
     assert( m_meshStructure                            != nullptr );
@@ -139,6 +146,9 @@ seissol::time_stepping::TimeCluster::TimeCluster( unsigned int
   m_updatable.neighboringInterior = false;
 #ifdef USE_MPI
   m_sendLtsBuffers                = false;
+  m_pendingSends                  = 0;
+  m_pendingReceives               = 0;
+  m_completedRequests.resize( m_meshStructure->numberOfRegions );
 #endif
   m_resetLtsBuffers               = false;
   // set timings to zero
@@ -165,6 +175,7 @@ seissol::time_stepping::TimeCluster::TimeCluster( unsigned int
   m_regionComputeLocalIntegration = m_loopStatistics->getRegion("computeLocalIntegration");
   m_regionComputeNeighboringIntegration = m_loopStatistics->getRegion("computeNeighboringIntegration");
   m_regionComputeDynamicRupture = m_loopStatistics->getRegion("computeDynamicRupture");
+  m_regionComputeSources = m_loopStatistics->getRegion("computeSources");
 }
 
 seissol::time_stepping::TimeCluster::~TimeCluster() {
@@ -180,6 +191,9 @@ void seissol::time_stepping::TimeCluster::setPointSources( sourceterm::CellToPoi
   m_cellToPointSources = i_cellToPointSources;
   m_numberOfCellToPointSourcesMappings = i_numberOfCellToPointSourcesMappings;
   m_pointSources = i_pointSources;
+  if (m_pointSources != NULL) {
+    m_sourceTimeIntegrals.resize(m_pointSources->slipRates.numberOfFunctions());
+  }
 }
 
 void seissol::time_stepping::TimeCluster::writeReceivers() {
@@ -199,34 +213,51 @@ void seissol::time_stepping::TimeCluster::computeSources() {
   // Return when point sources not initialised. This might happen if there
   // are no point sources on this rank.
   if (m_numberOfCellToPointSourcesMappings != 0) {
+    Stopwatch l_stopwatch;
+    l_stopwatch.start();
+
+    real* timeIntegrals = m_sourceTimeIntegrals.data();
 #ifdef _OPENMP
-  #pragma omp parallel for schedule(static)
+  #pragma omp parallel
 #endif
-    for (unsigned mapping = 0; mapping < m_numberOfCellToPointSourcesMappings; ++mapping) {
-      unsigned startSource = m_cellToPointSources[mapping].pointSourcesOffset;
-      unsigned endSource = m_cellToPointSources[mapping].pointSourcesOffset + m_cellToPointSources[mapping].numberOfPointSources;
-      if (m_pointSources->mode == sourceterm::PointSources::NRF) {
-        for (unsigned source = startSource; source < endSource; ++source) {
-          sourceterm::addTimeIntegratedPointSourceNRF( m_pointSources->mInvJInvPhisAtSources[source],
-                                                       m_pointSources->tensor[source],
-                                                       m_pointSources->A[source],
-                                                       m_pointSources->stiffnessTensor[source],
-                                                       m_pointSources->slipRates[source],
-                                                       m_fullUpdateTime,
-                                                       m_fullUpdateTime + m_timeStepWidth,
-                                                       *m_cellToPointSources[mapping].dofs );
-        }
-      } else {
-        for (unsigned source = startSource; source < endSource; ++source) {
-          sourceterm::addTimeIntegratedPointSourceFSRM( m_pointSources->mInvJInvPhisAtSources[source],
-                                                        m_pointSources->tensor[source],
-                                                        m_pointSources->slipRates[source][0],
-                                                        m_fullUpdateTime,
-                                                        m_fullUpdateTime + m_timeStepWidth,
-                                                        *m_cellToPointSources[mapping].dofs );
+    {
+      // integrate the slip rates of all sources in one sweep over the table
+      unsigned firstFunction, lastFunction;
+      staticPartition(m_pointSources->slipRates.numberOfFunctions(), firstFunction, lastFunction);
+      sourceterm::computePwLFTimeIntegrals( m_pointSources->slipRates,
+                                            firstFunction,
+                                            lastFunction,
+                                            m_fullUpdateTime,
+                                            m_fullUpdateTime + m_timeStepWidth,
+                                            timeIntegrals + firstFunction );
+#ifdef _OPENMP
+      #pragma omp barrier
+      #pragma omp for schedule(static)
+#endif
+      for (unsigned mapping = 0; mapping < m_numberOfCellToPointSourcesMappings; ++mapping) {
+        unsigned startSource = m_cellToPointSources[mapping].pointSourcesOffset;
+        unsigned endSource = m_cellToPointSources[mapping].pointSourcesOffset + m_cellToPointSources[mapping].numberOfPointSources;
+        if (m_pointSources->mode == sourceterm::PointSources::NRF) {
+          for (unsigned source = startSource; source < endSource; ++source) {
+            sourceterm::addTimeIntegratedPointSourceNRF( m_pointSources->mInvJInvPhisAtSources[source],
+                                                         m_pointSources->tensor[source],
+                                                         m_pointSources->A[source],
+                                                         m_pointSources->stiffnessTensor[source],
+                                                         timeIntegrals + 3*source,
+                                                         *m_cellToPointSources[mapping].dofs );
+          }
+        } else {
+          for (unsigned source = startSource; source < endSource; ++source) {
+            sourceterm::addTimeIntegratedPointSourceFSRM( m_pointSources->mInvJInvPhisAtSources[source],
+                                                          m_pointSources->tensor[source],
+                                                          timeIntegrals[source],
+                                                          *m_cellToPointSources[mapping].dofs );
+          }
         }
       }
     }
+
+    m_loopStatistics->addSample( m_regionComputeSources, l_stopwatch.stop(), m_pointSources->numberOfSources, m_globalClusterId );
   }
 #ifdef ACL_DEVICE
   device.api->popLastProfilingMark();
@@ -241,6 +272,29 @@ void seissol::time_stepping::TimeCluster::computeDynamicRupture( seissol::initia
 
   m_loopStatistics->begin(m_regionComputeDynamicRupture);
 
+#ifdef _OPENMP
+  #pragma omp parallel
+#endif
+  {
+    unsigned firstFace, lastFace;
+    staticPartition(layerData.getNumberOfCells(), firstFace, lastFace);
+    computeDynamicRupture(layerData, firstFace, lastFace);
+  }
+
+  m_loopStatistics->end(m_regionComputeDynamicRupture, layerData.getNumberOfCells(), m_globalClusterId);
+#ifdef ACL_DEVICE
+  device.api->popLastProfilingMark();
+#endif
+}
+
+void seissol::time_stepping::TimeCluster::computeDynamicRupture( seissol::initializers::Layer&  layerData,
+                                                                 unsigned                       firstFace,
+                                                                 unsigned                       lastFace ) {
+  if (m_useFrictionSolver) {
+    computeDynamicRuptureBlocked(layerData, firstFace, lastFace);
+    return;
+  }
+
   DRFaceInformation*                    faceInformation                                                   = layerData.var(m_dynRup->faceInformation);
   DRGodunovData*                        godunovData                                                       = layerData.var(m_dynRup->godunovData);
   real**                                timeDerivativePlus                                                = layerData.var(m_dynRup->timeDerivativePlus);
@@ -253,11 +307,8 @@ void seissol::time_stepping::TimeCluster::computeDynamicRupture( seissol::initia
   alignas(ALIGNMENT) real QInterpolatedPlus[CONVERGENCE_ORDER][tensor::QInterpolated::size()];
   alignas(ALIGNMENT) real QInterpolatedMinus[CONVERGENCE_ORDER][tensor::QInterpolated::size()];
 
-#ifdef _OPENMP
-  #pragma omp parallel for schedule(static) private(QInterpolatedPlus,QInterpolatedMinus)
-#endif
-  for (unsigned face = 0; face < layerData.getNumberOfCells(); ++face) {
-    unsigned prefetchFace = (face < layerData.getNumberOfCells()-1) ? face+1 : face;
+  for (unsigned face = firstFace; face < lastFace; ++face) {
+    unsigned prefetchFace = (face < lastFace-1) ? face+1 : face;
     m_dynamicRuptureKernel.spaceTimeInterpolation(  faceInformation[face],
                                                     m_globalDataOnHost,
                                                    &godunovData[face],
@@ -279,11 +330,62 @@ void seissol::time_stepping::TimeCluster::computeDynamicRupture( seissol::initia
                                             waveSpeedsPlus[face],
                                             waveSpeedsMinus[face] );
   }
+}
 
-  m_loopStatistics->end(m_regionComputeDynamicRupture, layerData.getNumberOfCells());
-#ifdef ACL_DEVICE
-  device.api->popLastProfilingMark();
-#endif
+
+void seissol::time_stepping::TimeCluster::computeDynamicRuptureBlocked( seissol::initializers::Layer&  layerData,
+                                                                        unsigned                       firstFace,
+                                                                        unsigned                       lastFace ) {
+  DRFaceInformation*                    faceInformation                                                   = layerData.var(m_dynRup->faceInformation);
+  DRGodunovData*                        godunovData                                                       = layerData.var(m_dynRup->godunovData);
+  real**                                timeDerivativePlus                                                = layerData.var(m_dynRup->timeDerivativePlus);
+  real**                                timeDerivativeMinus                                               = layerData.var(m_dynRup->timeDerivativeMinus);
+  real                                (*imposedStatePlus)[tensor::QInterpolated::size()]                  = layerData.var(m_dynRup->imposedStatePlus);
+  real                                (*imposedStateMinus)[tensor::QInterpolated::size()]                 = layerData.var(m_dynRup->imposedStateMinus);
+  seissol::model::IsotropicWaveSpeeds*  waveSpeedsPlus                                                    = layerData.var(m_dynRup->waveSpeedsPlus);
+  seissol::model::IsotropicWaveSpeeds*  waveSpeedsMinus                                                   = layerData.var(m_dynRup->waveSpeedsMinus);
+
+  alignas(ALIGNMENT) real QInterpolatedPlus[CONVERGENCE_ORDER][tensor::QInterpolated::size()];
+  alignas(ALIGNMENT) real QInterpolatedMinus[CONVERGENCE_ORDER][tensor::QInterpolated::size()];
+  kernels::FrictionSolver::FaultStresses faultStresses;
+
+  unsigned const blockSize = kernels::FrictionSolver::BlockSize;
+  for (unsigned blockStart = firstFace; blockStart < lastFace; blockStart += blockSize) {
+    unsigned numberOfFaces = std::min(blockSize, lastFace - blockStart);
+
+    for (unsigned blockFace = 0; blockFace < numberOfFaces; ++blockFace) {
+      unsigned face = blockStart + blockFace;
+      unsigned prefetchFace = (face < lastFace-1) ? face+1 : face;
+      m_dynamicRuptureKernel.spaceTimeInterpolation(  faceInformation[face],
+                                                      m_globalDataOnHost,
+                                                     &godunovData[face],
+                                                      timeDerivativePlus[face],
+                                                      timeDerivativeMinus[face],
+                                                      QInterpolatedPlus,
+                                                      QInterpolatedMinus,
+                                                      timeDerivativePlus[prefetchFace],
+                                                      timeDerivativeMinus[prefetchFace] );
+
+      m_frictionSolver.computeFaultStresses(  blockFace,
+                                              QInterpolatedPlus,
+                                              QInterpolatedMinus,
+                                              waveSpeedsPlus[face],
+                                              waveSpeedsMinus[face],
+                                              m_dynamicRuptureKernel.timeWeights,
+                                              faultStresses,
+                                              imposedStatePlus[face],
+                                              imposedStateMinus[face] );
+    }
+
+    m_frictionSolver.evaluate(  layerData,
+                                m_dynRup,
+                                blockStart,
+                                numberOfFaces,
+                                faultStresses,
+                                m_fullUpdateTime,
+                                m_dynamicRuptureKernel.timePoints,
+                                m_dynamicRuptureKernel.timeWeights );
+  }
 }
 
 
@@ -308,6 +410,7 @@ void seissol::time_stepping::TimeCluster::computeDynamicRuptureFlops( seissol::i
 #ifdef USE_MPI
 /*
  * MPI-Communication during the simulation; exchange of DOFs.
+ * The persistent requests of all regions are created in MemoryManager::initializeCommunicationStructure.
  */
 void seissol::time_stepping::TimeCluster::receiveGhostLayer(){
   SCOREP_USER_REGION( "receiveGhostLayer", SCOREP_USER_REGION_TYPE_FUNCTION )
@@ -318,18 +421,9 @@ void seissol::time_stepping::TimeCluster::receiveGhostLayer(){
   for( unsigned int l_region = 0; l_region < m_meshStructure->numberOfRegions; l_region++ ) {
     // continue only if the cluster qualifies for communication
     if( m_resetLtsBuffers || m_meshStructure->neighboringClusters[l_region][1] <= static_cast<int>(m_globalClusterId) ) {
-      // post receive request
-      MPI_Irecv(   m_meshStructure->ghostRegions[l_region],                // initial address
-                   m_meshStructure->ghostRegionSizes[l_region],            // number of elements in the receive buffer
-                   MPI_C_REAL,                                               // datatype of each receive buffer element
-                   m_meshStructure->neighboringClusters[l_region][0],      // rank of source
-                   timeData+m_meshStructure->receiveIdentifiers[l_region], // message tag
-                   seissol::MPI::mpi.comm(),                               // communicator
-                   m_meshStructure->receiveRequests + l_region             // communication request
-               );
-
-      // add receive request to list of receives
-      m_receiveQueue.push_back( m_meshStructure->receiveRequests + l_region );
+      // start receive request
+      MPI_Start( m_meshStructure->receiveRequests + l_region );
+      m_pendingReceives++;
     }
   }
 }
@@ -342,22 +436,53 @@ void seissol::time_stepping::TimeCluster::sendCopyLayer(){
    */
   for( unsigned int l_region = 0; l_region < m_meshStructure->numberOfRegions; l_region++ ) {
     if( m_sendLtsBuffers || m_meshStructure->neighboringClusters[l_region][1] <= static_cast<int>(m_globalClusterId) ) {
-      // post send request
-      MPI_Isend(   m_meshStructure->copyRegions[l_region],              // initial address
-                   m_meshStructure->copyRegionSizes[l_region],          // number of elements in the send buffer
-                   MPI_C_REAL,                                            // datatype of each send buffer element
-                   m_meshStructure->neighboringClusters[l_region][0],   // rank of destination
-                   timeData+m_meshStructure->sendIdentifiers[l_region], // message tag
-                   seissol::MPI::mpi.comm(),                            // communicator
-                   m_meshStructure->sendRequests + l_region             // communication request
-               );
-
-      // add send request to list of sends
-      m_sendQueue.push_back(m_meshStructure->sendRequests + l_region );
+#ifdef USE_SINGLE_PRECISION_COMMUNICATION
+      // convert the region to the single precision message
+      std::copy_n( m_meshStructure->copyRegions[l_region],
+                   m_meshStructure->copyRegionSizes[l_region],
+                   m_meshStructure->copyRegionMessages[l_region] );
+#endif
+      // start send request
+      MPI_Start( m_meshStructure->sendRequests + l_region );
+      m_pendingSends++;
     }
   }
 }
 
+bool seissol::time_stepping::TimeCluster::testForCompletion( MeshStructure const& i_meshStructure,
+                                                             MPI_Request*         io_requests,
+                                                             unsigned&            io_pending,
+                                                             std::vector<int>&    io_completedRequests,
+                                                             bool                 i_receives ) {
+  assert( io_completedRequests.size() >= i_meshStructure.numberOfRegions );
+  if( io_pending > 0 ) {
+    int l_completed = 0;
+    MPI_Testsome( i_meshStructure.numberOfRegions, io_requests, &l_completed, io_completedRequests.data(), MPI_STATUSES_IGNORE );
+
+    // MPI_UNDEFINED: no request is active
+    if( l_completed == MPI_UNDEFINED ) {
+      io_pending = 0;
+    } else {
+      assert( static_cast<unsigned>(l_completed) <= io_pending );
+      io_pending -= l_completed;
+#ifdef USE_SINGLE_PRECISION_COMMUNICATION
+      // convert the received single precision messages to the ghost regions
+      if( i_receives ) {
+        for( int l_request = 0; l_request < l_completed; l_request++ ) {
+          unsigned l_region = io_completedRequests[l_request];
+          std::copy_n( i_meshStructure.ghostRegionMessages[l_region],
+                       i_meshStructure.ghostRegionSizes[l_region],
+                       i_meshStructure.ghostRegions[l_region] );
+        }
+      }
+#endif
+    }
+  }
+
+  // return true if the communication is finished
+  return io_pending == 0;
+}
+
 bool seissol::time_stepping::TimeCluster::testForGhostLayerReceives(){
   SCOREP_USER_REGION( "testForGhostLayerReceives", SCOREP_USER_REGION_TYPE_FUNCTION )
 
@@ -370,21 +495,7 @@ bool seissol::time_stepping::TimeCluster::testForGhostLayerReceives(){
   }
   return l_return;
 #else
-  // iterate over all pending receives
-  for( std::list<MPI_Request*>::iterator l_receive = m_receiveQueue.begin(); l_receive != m_receiveQueue.end(); ) {
-    int l_mpiStatus = 0;
-
-    // check if the receive is complete
-    MPI_Test( *l_receive, &l_mpiStatus, MPI_STATUS_IGNORE );
-
-    // remove from list of pending receives if completed
-    if( l_mpiStatus == 1 )   l_receive = m_receiveQueue.erase( l_receive );
-    // continue otherwise
-    else                   ++l_receive;
-  }
-
-  // return true if the communication is finished
-  return m_receiveQueue.empty();
+  return testForCompletion( *m_meshStructure, m_meshStructure->receiveRequests, m_pendingReceives, m_completedRequests, true );
 #endif
 }
 
@@ -400,20 +511,7 @@ bool seissol::time_stepping::TimeCluster::testForCopyLayerSends(){
   }
   return l_return;
 #else
-  for( std::list<MPI_Request*>::iterator l_send = m_sendQueue.begin(); l_send != m_sendQueue.end(); ) {
-    int l_mpiStatus = 0;
-
-    // check if the send is complete
-    MPI_Test( *l_send, &l_mpiStatus, MPI_STATUS_IGNORE );
-
-    // remove from list of pending sends if completed
-    if( l_mpiStatus == 1 )   l_send = m_sendQueue.erase( l_send );
-    // continue otherwise
-    else                   ++l_send;
-  }
-
-  // return true if the communication is finished
-  return m_sendQueue.empty();
+  return testForCompletion( *m_meshStructure, m_meshStructure->sendRequests, m_pendingSends, m_completedRequests, false );
 #endif
 }
 
@@ -439,6 +537,21 @@ void seissol::time_stepping::TimeCluster::computeLocalIntegration( seissol::init
 
   m_loopStatistics->begin(m_regionComputeLocalIntegration);
 
+#ifdef _OPENMP
+  #pragma omp parallel
+#endif
+  {
+    unsigned l_firstCell, l_lastCell;
+    staticPartition(i_layerData.getNumberOfCells(), l_firstCell, l_lastCell);
+    computeLocalIntegration(i_layerData, l_firstCell, l_lastCell);
+  }
+
+  m_loopStatistics->end(m_regionComputeLocalIntegration, i_layerData.getNumberOfCells(), m_globalClusterId);
+}
+
+void seissol::time_stepping::TimeCluster::computeLocalIntegration( seissol::initializers::Layer&  i_layerData,
+                                                                   unsigned                       i_firstCell,
+                                                                   unsigned                       i_lastCell ) {
   // local integration buffer
   real l_integrationBuffer[tensor::I::size()] __attribute__((aligned(ALIGNMENT)));
 
@@ -454,10 +567,7 @@ void seissol::time_stepping::TimeCluster::computeLocalIntegration( seissol::init
   loader.load(*m_lts, i_layerData);
   kernels::LocalTmp tmp;
 
-#ifdef _OPENMP
-  #pragma omp parallel for private(l_bufferPointer, l_integrationBuffer, tmp) schedule(static)
-#endif
-  for( unsigned int l_cell = 0; l_cell < i_layerData.getNumberOfCells(); l_cell++ ) {
+  for( unsigned int l_cell = i_firstCell; l_cell < i_lastCell; l_cell++ ) {
     auto data = loader.entry(l_cell);
     // overwrite cell buffer
     // TODO: Integrate this step into the kernel
@@ -511,8 +621,6 @@ void seissol::time_stepping::TimeCluster::computeLocalIntegration( seissol::init
       }
     }
   }
-
-  m_loopStatistics->end(m_regionComputeLocalIntegration, i_layerData.getNumberOfCells());
 }
 #else // ACL_DEVICE
 void seissol::time_stepping::TimeCluster::computeLocalIntegration( seissol::initializers::Layer&  i_layerData ) {
@@ -557,7 +665,7 @@ void seissol::time_stepping::TimeCluster::computeLocalIntegration( seissol::init
   }
 
   device.api->synchDevice();
-  m_loopStatistics->end(m_regionComputeLocalIntegration, i_layerData.getNumberOfCells());
+  m_loopStatistics->end(m_regionComputeLocalIntegration, i_layerData.getNumberOfCells(), m_globalClusterId);
   device.api->popLastProfilingMark();
 }
 #endif // ACL_DEVICE
@@ -568,14 +676,48 @@ void seissol::time_stepping::TimeCluster::computeNeighboringIntegration( seissol
 
   m_loopStatistics->begin(m_regionComputeNeighboringIntegration);
 
+  unsigned numberOTetsWithPlasticYielding = 0;
+
+  if (m_useBatchedNeighborIntegration) {
+    numberOTetsWithPlasticYielding = computeBatchedNeighboringIntegration(i_layerData);
+  } else {
+#ifdef _OPENMP
+  #pragma omp parallel reduction(+:numberOTetsWithPlasticYielding)
+#endif
+    {
+      unsigned l_firstCell, l_lastCell;
+      staticPartition(i_layerData.getNumberOfCells(), l_firstCell, l_lastCell);
+      numberOTetsWithPlasticYielding += computeNeighboringIntegration(i_layerData, l_firstCell, l_lastCell);
+    }
+  }
+
+  addPlasticityFlops(i_layerData.getNumberOfCells(), numberOTetsWithPlasticYielding);
+
+  m_loopStatistics->end(m_regionComputeNeighboringIntegration, i_layerData.getNumberOfCells(), m_globalClusterId);
+}
+
+unsigned seissol::time_stepping::TimeCluster::computeNeighboringIntegration( seissol::initializers::Layer&  i_layerData,
+                                                                             unsigned                       i_firstCell,
+                                                                             unsigned                       i_lastCell ) {
+  if (m_usePlasticity) {
+    return m_integrateQuantities ? computeNeighboringIntegrationCells<true, true>(i_layerData, i_firstCell, i_lastCell)
+                                 : computeNeighboringIntegrationCells<true, false>(i_layerData, i_firstCell, i_lastCell);
+  }
+  return m_integrateQuantities ? computeNeighboringIntegrationCells<false, true>(i_layerData, i_firstCell, i_lastCell)
+                               : computeNeighboringIntegrationCells<false, false>(i_layerData, i_firstCell, i_lastCell);
+}
+
+template<bool UsePlasticity, bool IntegrateQuantities>
+unsigned seissol::time_stepping::TimeCluster::computeNeighboringIntegrationCells( seissol::initializers::Layer&  i_layerData,
+                                                                                  unsigned                       i_firstCell,
+                                                                                  unsigned                       i_lastCell ) {
   real* (*faceNeighbors)[4] = i_layerData.var(m_lts->faceNeighbors);
   CellDRMapping (*drMapping)[4] = i_layerData.var(m_lts->drMapping);
   CellLocalInformation* cellInformation = i_layerData.var(m_lts->cellInformation);
-#ifdef USE_PLASTICITY
+  unsigned numberOTetsWithPlasticYielding = 0;
   PlasticityData* plasticity = i_layerData.var(m_lts->plasticity);
   real (*pstrain)[7] = i_layerData.var(m_lts->pstrain);
-  unsigned numberOTetsWithPlasticYielding = 0;
-#endif
+  unsigned numberOfSkippedCells = 0;
 
   kernels::NeighborData::Loader loader;
   loader.load(*m_lts, i_layerData);
@@ -583,14 +725,7 @@ void seissol::time_stepping::TimeCluster::computeNeighboringIntegration( seissol
   real *l_timeIntegrated[4];
   real *l_faceNeighbors_prefetch[4];
 
-#ifdef _OPENMP
-#ifdef USE_PLASTICITY
-  #pragma omp parallel for schedule(static) private(l_timeIntegrated, l_faceNeighbors_prefetch) reduction(+:numberOTetsWithPlasticYielding)
-#else
-  #pragma omp parallel for schedule(static) private(l_timeIntegrated, l_faceNeighbors_prefetch)
-#endif
-#endif
-  for( unsigned int l_cell = 0; l_cell < i_layerData.getNumberOfCells(); l_cell++ ) {
+  for( unsigned int l_cell = i_firstCell; l_cell < i_lastCell; l_cell++ ) {
     auto data = loader.entry(l_cell);
     seissol::kernels::TimeCommon::computeIntegrals(m_timeKernel,
                                                    data.cellInformation.ltsSetup,
@@ -618,7 +753,7 @@ void seissol::time_stepping::TimeCluster::computeNeighboringIntegration( seissol
       drMapping[l_cell][3].godunov;
 
     // fourth face's prefetches
-    if (l_cell < (i_layerData.getNumberOfCells()-1) ) {
+    if (l_cell < (i_lastCell-1) ) {
       l_faceNeighbors_prefetch[3] = (cellInformation[l_cell+1].faceTypes[0] != FaceType::dynamicRupture) ?
 	faceNeighbors[l_cell+1][0] :
 	drMapping[l_cell+1][0].godunov;
@@ -636,28 +771,81 @@ void seissol::time_stepping::TimeCluster::computeNeighboringIntegration( seissol
 #endif
                                                );
 
-#ifdef USE_PLASTICITY
-  numberOTetsWithPlasticYielding += seissol::kernels::Plasticity::computePlasticity( m_relaxTime,
-                                                                                     m_timeStepWidth,
-                                                                                     m_globalDataOnHost,
-                                                                                     &plasticity[l_cell],
-                                                                                     data.dofs,
-                                                                                     pstrain[l_cell] );
+    if constexpr (UsePlasticity) {
+      if (seissol::kernels::Plasticity::skipPlasticity(m_globalDataOnHost, &plasticity[l_cell], data.dofs)) {
+        ++numberOfSkippedCells;
+      } else {
+        numberOTetsWithPlasticYielding += seissol::kernels::Plasticity::computePlasticity( m_relaxTime,
+                                                                                           m_timeStepWidth,
+                                                                                           m_globalDataOnHost,
+                                                                                           &plasticity[l_cell],
+                                                                                           data.dofs,
+                                                                                           pstrain[l_cell] );
+      }
+    }
+    if constexpr (IntegrateQuantities) {
+      seissol::SeisSol::main.postProcessor().integrateQuantities( m_timeStepWidth,
+                                                                  i_layerData,
+                                                                  l_cell,
+                                                                  data.dofs );
+    }
+  }
+
+  if constexpr (UsePlasticity) {
+    m_numberOfSkippedPlasticityCells += numberOfSkippedCells;
+  }
+
+  return numberOTetsWithPlasticYielding;
+}
+
+unsigned seissol::time_stepping::TimeCluster::computeBatchedNeighboringIntegration( seissol::initializers::Layer&  i_layerData ) {
+  ConditionalBatchTableT &table = i_layerData.getCondBatchTable();
+
+  // time integrals of the neighbors which provide derivatives, the other neighbors provide their buffers
+  seissol::kernels::TimeCommon::computeBatchedIntegrals(m_timeKernel,
+                                                        m_subTimeStart,
+                                                        m_timeStepWidth,
+                                                        table);
+  m_neighborKernel.computeBatchedNeighborsIntegral(table);
+
+  unsigned numberOTetsWithPlasticYielding = 0;
+  real (*dofs)[tensor::Q::size()] = i_layerData.var(m_lts->dofs);
+  if (m_usePlasticity) {
+    PlasticityData* plasticity = i_layerData.var(m_lts->plasticity);
+    real (*pstrain)[7] = i_layerData.var(m_lts->pstrain);
+    unsigned numberOfSkippedCells = 0;
+
+#ifdef _OPENMP
+    #pragma omp parallel for schedule(static) reduction(+:numberOTetsWithPlasticYielding,numberOfSkippedCells)
 #endif
-#ifdef INTEGRATE_QUANTITIES
-  seissol::SeisSol::main.postProcessor().integrateQuantities( m_timeStepWidth,
-                                                              i_layerData,
-                                                              l_cell,
-                                                              dofs[l_cell] );
-#endif // INTEGRATE_QUANTITIES
+    for (unsigned l_cell = 0; l_cell < i_layerData.getNumberOfCells(); ++l_cell) {
+      if (seissol::kernels::Plasticity::skipPlasticity(m_globalDataOnHost, &plasticity[l_cell], dofs[l_cell])) {
+        ++numberOfSkippedCells;
+      } else {
+        numberOTetsWithPlasticYielding += seissol::kernels::Plasticity::computePlasticity( m_relaxTime,
+                                                                                           m_timeStepWidth,
+                                                                                           m_globalDataOnHost,
+                                                                                           &plasticity[l_cell],
+                                                                                           dofs[l_cell],
+                                                                                           pstrain[l_cell] );
+      }
+    }
+    m_numberOfSkippedPlasticityCells += numberOfSkippedCells;
   }
 
-  #ifdef USE_PLASTICITY
-  g_SeisSolNonZeroFlopsPlasticity += i_layerData.getNumberOfCells() * m_flops_nonZero[PlasticityCheck] + numberOTetsWithPlasticYielding * m_flops_nonZero[PlasticityYield];
-  g_SeisSolHardwareFlopsPlasticity += i_layerData.getNumberOfCells() * m_flops_hardware[PlasticityCheck] + numberOTetsWithPlasticYielding * m_flops_hardware[PlasticityYield];
-  #endif
+  if (m_integrateQuantities) {
+#ifdef _OPENMP
+    #pragma omp parallel for schedule(static)
+#endif
+    for (unsigned l_cell = 0; l_cell < i_layerData.getNumberOfCells(); ++l_cell) {
+      seissol::SeisSol::main.postProcessor().integrateQuantities( m_timeStepWidth,
+                                                                  i_layerData,
+                                                                  l_cell,
+                                                                  dofs[l_cell] );
+    }
+  }
 
-  m_loopStatistics->end(m_regionComputeNeighboringIntegration, i_layerData.getNumberOfCells());
+  return numberOTetsWithPlasticYielding;
 }
 #else // ACL_DEVICE
 void seissol::time_stepping::TimeCluster::computeNeighboringIntegration( seissol::initializers::Layer&  i_layerData ) {
@@ -673,13 +861,11 @@ void seissol::time_stepping::TimeCluster::computeNeighboringIntegration( seissol
                                                         table);
   m_neighborKernel.computeBatchedNeighborsIntegral(table);
 
-#ifdef USE_PLASTICITY
-  assert(false && "plasticity is not currently supported for batched computations");
-#endif
+  assert(!m_usePlasticity && "plasticity is not currently supported for batched computations");
 
   device.api->synchDevice();
   device.api->popLastProfilingMark();
-  m_loopStatistics->end(m_regionComputeNeighboringIntegration, i_layerData.getNumberOfCells());
+  m_loopStatistics->end(m_regionComputeNeighboringIntegration, i_layerData.getNumberOfCells(), m_globalClusterId);
 }
 #endif // ACL_DEVICE
 
@@ -833,16 +1019,7 @@ bool seissol::time_stepping::TimeCluster::computeNeighboringCopy() {
 
   // compute dynamic rupture, update simulation time and statistics
   if( !m_updatable.neighboringInterior ) {
-    // First cluster calls fault receiver output
-    // TODO: Change from iteration based to time based
-    if (m_clusterId == 0) {
-      e_interoperability.faultOutput( m_fullUpdateTime, m_timeStepWidth );
-    }
-
-    m_fullUpdateTime      += m_timeStepWidth;
-    m_subTimeStart        += m_timeStepWidth;
-    m_numberOfFullUpdates += 1;
-    m_numberOfTimeSteps   += 1;
+    finishFullUpdate();
   }
 
   // update finished
@@ -877,21 +1054,196 @@ void seissol::time_stepping::TimeCluster::computeNeighboringInterior() {
 
   // compute dynamic rupture, update simulation time and statistics
   if( !m_updatable.neighboringCopy ) {
-    // First cluster calls fault receiver output
-    // TODO: Change from iteration based to time based
-    if (m_clusterId == 0) {
-      e_interoperability.faultOutput( m_fullUpdateTime, m_timeStepWidth );
-    }
+    finishFullUpdate();
+  }
+
+  // update finished
+  m_updatable.neighboringInterior = false;
+}
+
+void seissol::time_stepping::TimeCluster::finishFullUpdate() {
+  // First cluster calls fault receiver output
+  // TODO: Change from iteration based to time based
+  if (m_clusterId == 0) {
+    e_interoperability.faultOutput( m_fullUpdateTime, m_timeStepWidth );
+  }
+
+  if (m_groundMotionMaps != nullptr) {
+    m_groundMotionMaps->accumulate( m_clusterId, m_timeStepWidth );
+  }
+
+  m_fullUpdateTime      += m_timeStepWidth;
+  m_subTimeStart        += m_timeStepWidth;
+  m_numberOfFullUpdates += 1;
+  m_numberOfTimeSteps   += 1;
+}
+
+void seissol::time_stepping::TimeCluster::staticPartition( unsigned  i_numberOfCells,
+                                                           unsigned& o_firstCell,
+                                                           unsigned& o_lastCell ) {
+  seissol::parallel::staticPartition(i_numberOfCells, o_firstCell, o_lastCell);
+}
+
+void seissol::time_stepping::TimeCluster::addPlasticityFlops( unsigned i_numberOfCells,
+                                                              unsigned i_numberOfYieldingCells ) {
+  if (!m_usePlasticity) {
+    return;
+  }
+  unsigned l_numberOfSkippedCells = m_numberOfSkippedPlasticityCells.exchange(0);
+  unsigned l_numberOfEvaluatedCells = i_numberOfCells - l_numberOfSkippedCells;
+  g_SeisSolNonZeroFlopsPlasticity += i_numberOfCells * m_flops_nonZero[PlasticityScreen] + l_numberOfEvaluatedCells * m_flops_nonZero[PlasticityCheck] + i_numberOfYieldingCells * m_flops_nonZero[PlasticityYield];
+  g_SeisSolHardwareFlopsPlasticity += i_numberOfCells * m_flops_hardware[PlasticityScreen] + l_numberOfEvaluatedCells * m_flops_hardware[PlasticityCheck] + i_numberOfYieldingCells * m_flops_hardware[PlasticityYield];
+  g_SeisSolPlasticityEvaluatedCells += l_numberOfEvaluatedCells;
+  g_SeisSolPlasticitySkippedCells += l_numberOfSkippedCells;
+}
+
+#ifndef ACL_DEVICE
+seissol::initializers::Layer& seissol::time_stepping::TimeCluster::clusterLayer( enum LayerType i_layer ) {
+  assert( i_layer == Copy || i_layer == Interior );
+  return (i_layer == Copy) ? m_clusterData->child<Copy>() : m_clusterData->child<Interior>();
+}
+
+seissol::initializers::Layer& seissol::time_stepping::TimeCluster::dynamicRuptureLayer( enum LayerType i_layer ) {
+  assert( i_layer == Copy || i_layer == Interior );
+  return (i_layer == Copy) ? m_dynRupClusterData->child<Copy>() : m_dynRupClusterData->child<Interior>();
+}
+
+unsigned seissol::time_stepping::TimeCluster::getNumberOfCells( enum LayerType i_layer ) {
+  return clusterLayer(i_layer).getNumberOfCells();
+}
+
+unsigned seissol::time_stepping::TimeCluster::getNumberOfDynamicRuptureFaces( enum LayerType i_layer ) {
+  return m_dynamicRuptureFaces ? dynamicRuptureLayer(i_layer).getNumberOfCells() : 0;
+}
+
+bool seissol::time_stepping::TimeCluster::beginLocalUpdate() {
+  SCOREP_USER_REGION( "beginLocalUpdate", SCOREP_USER_REGION_TYPE_FUNCTION )
+
+  // ensure a valid call
+  if( !m_updatable.localInterior ) {
+    logError() << "Invalid call of beginLocalUpdate, aborting:"
+      << this             << m_clusterId      << m_globalClusterId << m_numberOfTimeSteps
+      << m_fullUpdateTime << m_predictionTime << m_timeStepWidth   << m_subTimeStart      << m_resetLtsBuffers;
+  }
+
+#ifdef USE_MPI
+  // continue only if copy layer sends are complete
+  if( !testForCopyLayerSends() ) return false;
+
+  // post receive requests
+#if defined(_OPENMP) && defined(USE_COMM_THREAD)
+  initReceiveGhostLayer();
+#else
+  receiveGhostLayer();
+#endif
+#endif
+
+  writeReceivers();
+
+  return true;
+}
+
+void seissol::time_stepping::TimeCluster::computeLocalIntegrationChunk( enum LayerType i_layer,
+                                                                        unsigned       i_firstCell,
+                                                                        unsigned       i_lastCell ) {
+  Stopwatch l_stopwatch;
+  l_stopwatch.start();
+
+  computeLocalIntegration( clusterLayer(i_layer), i_firstCell, i_lastCell );
+
+  m_loopStatistics->addSample( m_regionComputeLocalIntegration, l_stopwatch.stop(), i_lastCell - i_firstCell, m_globalClusterId );
+}
+
+#ifdef USE_MPI
+void seissol::time_stepping::TimeCluster::sendCopyLayerUpdate() {
+  g_SeisSolNonZeroFlopsLocal += m_flops_nonZero[LocalCopy];
+  g_SeisSolHardwareFlopsLocal += m_flops_hardware[LocalCopy];
+
+#if defined(_OPENMP) && defined(USE_COMM_THREAD)
+  initSendCopyLayer();
+  // wait until communication thread finished initializing the receives
+  waitForInits();
+#else
+  sendCopyLayer();
+  // continue with communication
+  testForGhostLayerReceives();
+#endif
+
+  m_updatable.localCopy = false;
+}
+
+bool seissol::time_stepping::TimeCluster::ghostLayerReceived() {
+  return testForGhostLayerReceives();
+}
+#endif
+
+void seissol::time_stepping::TimeCluster::endLocalUpdate() {
+  g_SeisSolNonZeroFlopsLocal += m_flops_nonZero[LocalInterior];
+  g_SeisSolHardwareFlopsLocal += m_flops_hardware[LocalInterior];
+
+  // compute sources, update simulation time
+  computeSources();
+  m_predictionTime += m_timeStepWidth;
+
+  // update finished
+  m_updatable.localInterior = false;
+}
+
+void seissol::time_stepping::TimeCluster::computeDynamicRuptureChunk( enum LayerType i_layer,
+                                                                      unsigned       i_firstFace,
+                                                                      unsigned       i_lastFace ) {
+  Stopwatch l_stopwatch;
+  l_stopwatch.start();
+
+  computeDynamicRupture( dynamicRuptureLayer(i_layer), i_firstFace, i_lastFace );
+
+  m_loopStatistics->addSample( m_regionComputeDynamicRupture, l_stopwatch.stop(), i_lastFace - i_firstFace, m_globalClusterId );
+}
+
+unsigned seissol::time_stepping::TimeCluster::computeNeighboringIntegrationChunk( enum LayerType i_layer,
+                                                                                  unsigned       i_firstCell,
+                                                                                  unsigned       i_lastCell ) {
+  Stopwatch l_stopwatch;
+  l_stopwatch.start();
+
+  unsigned l_numberOfYieldingCells = computeNeighboringIntegration( clusterLayer(i_layer), i_firstCell, i_lastCell );
+
+  m_loopStatistics->addSample( m_regionComputeNeighboringIntegration, l_stopwatch.stop(), i_lastCell - i_firstCell, m_globalClusterId );
+
+  return l_numberOfYieldingCells;
+}
 
-    m_fullUpdateTime      += m_timeStepWidth;
-    m_subTimeStart        += m_timeStepWidth;
-    m_numberOfFullUpdates += 1;
-    m_numberOfTimeSteps   += 1;
+void seissol::time_stepping::TimeCluster::endNeighboringUpdate( unsigned i_numberOfYieldingCells ) {
+  if (m_dynamicRuptureFaces == true) {
+#ifdef USE_MPI
+    g_SeisSolNonZeroFlopsDynamicRupture += m_flops_nonZero[DRFrictionLawCopy];
+    g_SeisSolHardwareFlopsDynamicRupture += m_flops_hardware[DRFrictionLawCopy];
+#endif
+    g_SeisSolNonZeroFlopsDynamicRupture += m_flops_nonZero[DRFrictionLawInterior];
+    g_SeisSolHardwareFlopsDynamicRupture += m_flops_hardware[DRFrictionLawInterior];
   }
 
+#ifdef USE_MPI
+  g_SeisSolNonZeroFlopsNeighbor += m_flops_nonZero[NeighborCopy];
+  g_SeisSolHardwareFlopsNeighbor += m_flops_hardware[NeighborCopy];
+  g_SeisSolNonZeroFlopsDynamicRupture += m_flops_nonZero[DRNeighborCopy];
+  g_SeisSolHardwareFlopsDynamicRupture += m_flops_hardware[DRNeighborCopy];
+#endif
+  g_SeisSolNonZeroFlopsNeighbor += m_flops_nonZero[NeighborInterior];
+  g_SeisSolHardwareFlopsNeighbor += m_flops_hardware[NeighborInterior];
+  g_SeisSolNonZeroFlopsDynamicRupture += m_flops_nonZero[DRNeighborInterior];
+  g_SeisSolHardwareFlopsDynamicRupture += m_flops_hardware[DRNeighborInterior];
+
+  addPlasticityFlops( m_clusterData->child<Copy>().getNumberOfCells() + m_clusterData->child<Interior>().getNumberOfCells(),
+                      i_numberOfYieldingCells );
+
+  finishFullUpdate();
+
   // update finished
+  m_updatable.neighboringCopy     = false;
   m_updatable.neighboringInterior = false;
 }
+#endif // ACL_DEVICE
 
 void seissol::time_stepping::TimeCluster::computeLocalIntegrationFlops( unsigned                    numberOfCells,
                                                                         CellLocalInformation const* cellInformation,
@@ -985,42 +1337,19 @@ void seissol::time_stepping::TimeCluster::computeFlops()
                                                   m_flops_hardware[PlasticityCheck],
                                                   m_flops_nonZero[PlasticityYield],
                                                   m_flops_hardware[PlasticityYield] );
+  seissol::kernels::Plasticity::flopsScreening( m_flops_nonZero[PlasticityScreen],
+                                                m_flops_hardware[PlasticityScreen] );
 }
 
 #if defined(_OPENMP) && defined(USE_MPI) && defined(USE_COMM_THREAD)
 void seissol::time_stepping::TimeCluster::pollForCopyLayerSends(){
-  for( std::list<MPI_Request*>::iterator l_send = m_sendQueue.begin(); l_send != m_sendQueue.end(); ) {
-    int l_mpiStatus = 0;
-
-    // check if the send is complete
-    MPI_Test( *l_send, &l_mpiStatus, MPI_STATUS_IGNORE );
-
-    // remove from list of pending sends if completed
-    if( l_mpiStatus == 1 )   l_send = m_sendQueue.erase( l_send );
-    // continue otherwise
-    else                   ++l_send;
-  }
-
-  if (m_sendQueue.empty()) {
+  if (testForCompletion( *m_meshStructure, m_meshStructure->sendRequests, m_pendingSends, m_completedRequests, false )) {
     g_handleSends[m_clusterId] = 0;
   }
 }
 
 void seissol::time_stepping::TimeCluster::pollForGhostLayerReceives(){
-  // iterate over all pending receives
-  for( std::list<MPI_Request*>::iterator l_receive = m_receiveQueue.begin(); l_receive != m_receiveQueue.end(); ) {
-    int l_mpiStatus = 0;
-
-    // check if the receive is complete
-    MPI_Test( *l_receive, &l_mpiStatus, MPI_STATUS_IGNORE );
-
-    // remove from list of pending receives if completed
-    if( l_mpiStatus == 1 )   l_receive = m_receiveQueue.erase( l_receive );
-    // continue otherwise
-    else                   ++l_receive;
-  }
-
-  if (m_receiveQueue.empty()) {
+  if (testForCompletion( *m_meshStructure, m_meshStructure->receiveRequests, m_pendingReceives, m_completedRequests, true )) {
     g_handleRecvs[m_clusterId] = 0;
   }
 }
@@ -76,6 +76,8 @@
 #include <list>
 #endif
 
+#include <atomic>
+
 #include <Initializer/typedefs.hpp>
 #include <SourceTerm/typedefs.hpp>
 #include <utils/logger.h>
@@ -86,8 +88,10 @@
 #include <Kernels/Local.h>
 #include <Kernels/Neighbor.h>
 #include <Kernels/DynamicRupture.h>
+#include <Kernels/FrictionSolver.h>
 #include <Kernels/Plasticity.h>
 #include <Solver/FreeSurfaceIntegrator.h>
+#include <Solver/GroundMotionMaps.h>
 #include <Monitoring/LoopStatistics.h>
 
 namespace seissol {
@@ -130,6 +134,13 @@ private:
     
     kernels::DynamicRupture m_dynamicRuptureKernel;
 
+    //! layer-wise friction solver, the friction law is evaluated by the Fortran implementation if disabled
+    kernels::FrictionSolver m_frictionSolver;
+    bool m_useFrictionSolver{false};
+
+    //! neighbor integration with the recorded batches instead of cell by cell
+    bool m_useBatchedNeighborIntegration{false};
+
     /*
      * mesh structure
      */
@@ -149,11 +160,14 @@ private:
      * element data and mpi queues
      */     
 #ifdef USE_MPI
-    //! pending copy region sends
-    std::list< MPI_Request* > m_sendQueue;
+    //! number of started copy region sends, which are not complete
+    unsigned m_pendingSends;
 
-    //! pending ghost region receives
-    std::list< MPI_Request* > m_receiveQueue;
+    //! number of started ghost region receives, which are not complete
+    unsigned m_pendingReceives;
+
+    //! indices of the requests completed in MPI_Testsome
+    std::vector<int> m_completedRequests;
 #endif    
     seissol::initializers::TimeCluster* m_clusterData;
     seissol::initializers::TimeCluster* m_dynRupClusterData;
@@ -172,6 +186,9 @@ private:
     //! Point sources
     sourceterm::PointSources const* m_pointSources;
 
+    //! Time integrals of the slip rates of the point sources over the current time step
+    std::vector<real> m_sourceTimeIntegrals;
+
     //! true if dynamic rupture faces are present
     bool m_dynamicRuptureFaces;
     
@@ -188,26 +205,40 @@ private:
       DRFrictionLawInterior,
       PlasticityCheck,
       PlasticityYield,
+      PlasticityScreen,
       NUM_COMPUTE_PARTS
     };
     
     long long m_flops_nonZero[NUM_COMPUTE_PARTS];
     long long m_flops_hardware[NUM_COMPUTE_PARTS];
+
+    //! cells which skipped the plasticity since the last call of addPlasticityFlops
+    std::atomic<unsigned> m_numberOfSkippedPlasticityCells;
     
     //! Tv parameter for plasticity
     double m_tv;
     
     //! Relax time for plasticity
     double m_relaxTime;
+
+    //! Drucker-Prager plasticity is applied after the neighbor integration
+    bool m_usePlasticity;
+
+    //! the wave field is integrated over time after the neighbor integration
+    bool m_integrateQuantities;
     
     //! Stopwatch of TimeManager
     LoopStatistics* m_loopStatistics;
     unsigned        m_regionComputeLocalIntegration;
     unsigned        m_regionComputeNeighboringIntegration;
     unsigned        m_regionComputeDynamicRupture;
+    unsigned        m_regionComputeSources;
 
     kernels::ReceiverCluster* m_receiverCluster;
 
+    //! ground motion maps, which are updated after every full update (if enabled)
+    solver::GroundMotionMaps* m_groundMotionMaps;
+
 #ifdef USE_MPI
     /**
      * Receives the copy layer data from relevant neighboring MPI clusters.
@@ -262,6 +293,22 @@ private:
      **/
     void computeDynamicRupture( seissol::initializers::Layer&  layerData );
 
+    /**
+     * Computes dynamic rupture for the faces [firstFace, lastFace) of the layer.
+     * Remark: Called by the executing thread only, i.e. this function does not spawn any threads.
+     **/
+    void computeDynamicRupture( seissol::initializers::Layer&  layerData,
+                                unsigned                       firstFace,
+                                unsigned                       lastFace );
+
+    /**
+     * Computes dynamic rupture for the faces [firstFace, lastFace) of the layer with the layer-wise friction solver.
+     * The faces are processed in blocks of kernels::FrictionSolver::BlockSize faces.
+     **/
+    void computeDynamicRuptureBlocked( seissol::initializers::Layer&  layerData,
+                                       unsigned                       firstFace,
+                                       unsigned                       lastFace );
+
     /**
      * Computes all cell local integration.
      *
@@ -282,6 +329,14 @@ private:
      **/
     void computeLocalIntegration( seissol::initializers::Layer&  i_layerData );
 
+    /**
+     * Computes the cell local integration of the cells [i_firstCell, i_lastCell) of the layer.
+     * Remark: Called by the executing thread only, i.e. this function does not spawn any threads.
+     **/
+    void computeLocalIntegration( seissol::initializers::Layer&  i_layerData,
+                                  unsigned                       i_firstCell,
+                                  unsigned                       i_lastCell );
+
     /**
      * Computes the contribution of the neighboring cells to the boundary integral.
      *
@@ -296,6 +351,58 @@ private:
      **/
     void computeNeighboringIntegration( seissol::initializers::Layer&  i_layerData );
 
+    /**
+     * Computes the neighboring contribution of the cells [i_firstCell, i_lastCell) of the layer.
+     * Remark: Called by the executing thread only, i.e. this function does not spawn any threads.
+     *
+     * @return number of cells with plastic yielding.
+     **/
+    unsigned computeNeighboringIntegration( seissol::initializers::Layer&  i_layerData,
+                                            unsigned                       i_firstCell,
+                                            unsigned                       i_lastCell );
+
+    /**
+     * Cell loop of computeNeighboringIntegration, instantiated for every combination of the physics features,
+     * such that the features do not branch per cell.
+     **/
+    template<bool UsePlasticity, bool IntegrateQuantities>
+    unsigned computeNeighboringIntegrationCells( seissol::initializers::Layer&  i_layerData,
+                                                 unsigned                       i_firstCell,
+                                                 unsigned                       i_lastCell );
+
+    /**
+     * Computes the neighboring contribution of the layer with the batches of MemoryManager::recordNeighborIntegration,
+     * i.e. every variant of the flux kernels is applied to all cells of its batch at once.
+     *
+     * @return number of cells with plastic yielding.
+     **/
+    unsigned computeBatchedNeighboringIntegration( seissol::initializers::Layer&  i_layerData );
+
+    /**
+     * Distributes cells contiguously among the threads of the current OpenMP team (identical to schedule(static)).
+     **/
+    static void staticPartition( unsigned  i_numberOfCells,
+                                 unsigned& o_firstCell,
+                                 unsigned& o_lastCell );
+
+    /**
+     * Adds the flops and the cell counts of the plasticity; cells which skipped the plasticity are taken from
+     * m_numberOfSkippedPlasticityCells.
+     **/
+    void addPlasticityFlops( unsigned i_numberOfCells,
+                             unsigned i_numberOfYieldingCells );
+
+    /**
+     * Advances the simulation time after a full update of copy layer and interior.
+     **/
+    void finishFullUpdate();
+
+#ifndef ACL_DEVICE
+    seissol::initializers::Layer& clusterLayer( enum LayerType i_layer );
+
+    seissol::initializers::Layer& dynamicRuptureLayer( enum LayerType i_layer );
+#endif
+
     void computeLocalIntegrationFlops(  unsigned                    numberOfCells,
                                         CellLocalInformation const* cellInformation,
                                         long long&                  nonZeroFlops,
@@ -334,6 +441,24 @@ private:
     volatile bool m_sendLtsBuffers;
 #endif
 
+#ifdef USE_MPI
+    /**
+     * Completes the started persistent requests of the regions.
+     *
+     * @param i_meshStructure mesh structure, which holds the regions of the requests.
+     * @param io_requests persistent requests of all regions; inactive requests are ignored.
+     * @param io_pending number of started requests, which are not complete.
+     * @param io_completedRequests workspace for the indices of the completed requests, one entry per region.
+     * @param i_receives true if the requests are the ghost region receives; completed single precision messages are then converted.
+     * @return true if all started requests are complete.
+     **/
+    static bool testForCompletion( MeshStructure const& i_meshStructure,
+                                   MPI_Request*         io_requests,
+                                   unsigned&            io_pending,
+                                   std::vector<int>&    io_completedRequests,
+                                   bool                 i_receives );
+#endif
+
     //! reset lts buffers before performing time predictions
     volatile bool m_resetLtsBuffers;
 
@@ -434,6 +559,27 @@ private:
       m_receiverCluster = receiverCluster;
     }
 
+    void setGroundMotionMaps( solver::GroundMotionMaps* groundMotionMaps ) {
+      m_groundMotionMaps = groundMotionMaps;
+    }
+
+    /**
+     * Evaluates the friction law with the layer-wise friction solver instead of the Fortran implementation.
+     * The parameters and the state of the fault have to be stored in the dynamic rupture tree.
+     **/
+    void enableFrictionSolver( kernels::FrictionSolver::Parameters const& parameters ) {
+      m_frictionSolver.setParameters(parameters);
+      m_useFrictionSolver = true;
+    }
+
+    /**
+     * Computes the neighbor integration with the batches of the layers, which have to be recorded
+     * (see MemoryManager::recordNeighborIntegration).
+     **/
+    void enableBatchedNeighborIntegration() {
+      m_useBatchedNeighborIntegration = true;
+    }
+
     /**
      * Set Tv constant for plasticity.
      */
@@ -482,6 +628,61 @@ private:
      **/
     void computeNeighboringInterior();
 
+#ifndef ACL_DEVICE
+    /*
+     * Interface of the task graph scheduler (see TaskGraph.h).
+     * A local or neighboring update is split into a serial begin/end and chunks of cells, which may be executed
+     * concurrently with chunks of other clusters.
+     */
+
+    unsigned getNumberOfCells( enum LayerType i_layer );
+
+    unsigned getNumberOfDynamicRuptureFaces( enum LayerType i_layer );
+
+    /**
+     * Starts the local update of copy layer and interior: Posts the ghost layer receives and writes the receivers.
+     *
+     * @return false if the update can't be started due to unfinished sends of copy data to MPI neighbors.
+     **/
+    bool beginLocalUpdate();
+
+    void computeLocalIntegrationChunk( enum LayerType i_layer,
+                                       unsigned       i_firstCell,
+                                       unsigned       i_lastCell );
+
+#ifdef USE_MPI
+    /**
+     * Sends the copy layer after all local chunks of the copy layer are finished.
+     **/
+    void sendCopyLayerUpdate();
+
+    /**
+     * @return true if all ghost layer receives are complete.
+     **/
+    bool ghostLayerReceived();
+#endif
+
+    /**
+     * Finishes the local update after all local chunks are finished: Computes the sources and advances the prediction time.
+     **/
+    void endLocalUpdate();
+
+    void computeDynamicRuptureChunk( enum LayerType i_layer,
+                                     unsigned       i_firstFace,
+                                     unsigned       i_lastFace );
+
+    unsigned computeNeighboringIntegrationChunk( enum LayerType i_layer,
+                                                 unsigned       i_firstCell,
+                                                 unsigned       i_lastCell );
+
+    /**
+     * Finishes the neighboring update after all chunks are finished: Advances the simulation time.
+     *
+     * @param i_numberOfYieldingCells number of cells with plastic yielding in all chunks.
+     **/
+    void endNeighboringUpdate( unsigned i_numberOfYieldingCells );
+#endif
+
 #if defined(_OPENMP) && defined(USE_MPI) && defined(USE_COMM_THREAD)
     /**
      * Tests for pending ghost layer communication, active when using communication thread 
@@ -44,7 +44,10 @@
 #include "TimeManager.h"
 #include <Initializer/preProcessorMacros.fpp>
 #include <Initializer/time_stepping/common.hpp>
+#include <Initializer/time_stepping/LtsCostModel.h>
+#include <Numerical_aux/Statistics.h>
 #include "SeisSol.h"
+#include <utils/env.h>
 
 #if defined(_OPENMP) && defined(USE_MPI) && defined(USE_COMM_THREAD)
 #include <Parallel/Pin.h>
@@ -55,11 +58,24 @@ pthread_t g_commThread;
 #endif
 
 seissol::time_stepping::TimeManager::TimeManager():
-  m_logUpdates(std::numeric_limits<unsigned int>::max())
+  m_logUpdates(std::numeric_limits<unsigned int>::max()),
+  m_useTaskGraph(false)
 {
   m_loopStatistics.addRegion("computeLocalIntegration");
   m_loopStatistics.addRegion("computeNeighboringIntegration");
   m_loopStatistics.addRegion("computeDynamicRupture");
+  m_loopStatistics.addRegion("computeSources");
+
+  std::string scheduler = utils::Env::get<std::string>("SEISSOL_SCHEDULER", "queues");
+  if (scheduler == "taskgraph") {
+#ifdef ACL_DEVICE
+    logWarning(MPI::mpi.rank()) << "The task graph scheduler is not supported for accelerators, falling back to the queues.";
+#else
+    m_useTaskGraph = true;
+#endif
+  } else if (scheduler != "queues") {
+    logError() << "Unknown scheduler" << scheduler << "(SEISSOL_SCHEDULER has to be queues or taskgraph).";
+  }
 }
 
 seissol::time_stepping::TimeManager::~TimeManager() {
@@ -100,6 +116,23 @@ void seissol::time_stepping::TimeManager::addClusters( struct TimeStepping&
                                            &m_loopStatistics )
                         );
   }
+
+  if (m_useTaskGraph) {
+    logInfo(MPI::mpi.rank()) << "Using the task graph scheduler.";
+    m_taskGraph.setClusters(m_clusters);
+  }
+
+  if (utils::Env::get<bool>("SEISSOL_PERF_COUNTERS", false)) {
+    const int rank = MPI::mpi.rank();
+    if (m_useTaskGraph) {
+      // the chunks of different regions are executed concurrently
+      logWarning(rank) << "The performance counters are not supported with the task graph scheduler.";
+    } else if (m_loopStatistics.enableCounters()) {
+      logInfo(rank) << "Recording the performance counters of the compute kernels.";
+    } else {
+      logWarning(rank) << "Could not open the performance counters, check /proc/sys/kernel/perf_event_paranoid.";
+    }
+  }
 }
 
 void seissol::time_stepping::TimeManager::startCommunicationThread() {
@@ -194,10 +227,16 @@ void seissol::time_stepping::TimeManager::updateClusterDependencies( unsigned in
        // enqueue the cluster
 #ifdef USE_MPI
        m_clusters[l_cluster]->m_updatable.neighboringCopy     = true;
-       m_neighboringCopyQueue.push_back( m_clusters[l_cluster] );
 #endif
        m_clusters[l_cluster]->m_updatable.neighboringInterior = true;
-       m_neighboringInteriorQueue.push( m_clusters[l_cluster] );
+
+       // the task graph polls the flags
+       if( !m_useTaskGraph ) {
+#ifdef USE_MPI
+         m_neighboringCopyQueue.push_back( m_clusters[l_cluster] );
+#endif
+         m_neighboringInteriorQueue.push( m_clusters[l_cluster] );
+       }
      }
 
      /*
@@ -232,10 +271,16 @@ void seissol::time_stepping::TimeManager::updateClusterDependencies( unsigned in
         // enqueue the cluster
 #ifdef USE_MPI
         m_clusters[l_cluster]->m_updatable.localCopy = true;
-        m_localCopyQueue.push_back( m_clusters[l_cluster] );
 #endif
         m_clusters[l_cluster]->m_updatable.localInterior = true;
-        m_localInteriorQueue.push( m_clusters[l_cluster] );
+
+        // the task graph polls the flags
+        if( !m_useTaskGraph ) {
+#ifdef USE_MPI
+          m_localCopyQueue.push_back( m_clusters[l_cluster] );
+#endif
+          m_localInteriorQueue.push( m_clusters[l_cluster] );
+        }
 
         // derive next time step width of the cluster
         unsigned int l_globalClusterId = m_timeStepping.clusterIds[l_cluster];
@@ -304,6 +349,17 @@ void seissol::time_stepping::TimeManager::advanceInTime( const double &i_synchro
   device::DeviceInstance &device = device::DeviceInstance::getInstance();
   device.api->putProfilingMark("advanceInTime", device::ProfilingColors::Blue);
 #endif
+  if( m_useTaskGraph ) {
+    advanceInTimeWithTaskGraph();
+  } else {
+    advanceInTimeWithQueues();
+  }
+#ifdef ACL_DEVICE
+  device.api->popLastProfilingMark();
+#endif
+}
+
+void seissol::time_stepping::TimeManager::advanceInTimeWithQueues() {
   // iterate until all queues are empty and the next synchronization point in time is reached
   while( !( m_localCopyQueue.empty()       && m_localInteriorQueue.empty() &&
             m_neighboringCopyQueue.empty() && m_neighboringInteriorQueue.empty() ) ) {
@@ -346,19 +402,51 @@ void seissol::time_stepping::TimeManager::advanceInTime( const double &i_synchro
     }
 
     // print progress of largest time cluster
-    if( m_clusters[m_timeStepping.numberOfLocalClusters-1]->m_numberOfFullUpdates != m_logUpdates &&
-        m_clusters[m_timeStepping.numberOfLocalClusters-1]->m_numberOfFullUpdates % 100 == 0 ) {
-      m_logUpdates = m_clusters[m_timeStepping.numberOfLocalClusters-1]->m_numberOfFullUpdates;
+    logProgress();
+  }
+}
 
-      const int rank = MPI::mpi.rank();
+void seissol::time_stepping::TimeManager::advanceInTimeWithTaskGraph() {
+  SCOREP_USER_REGION( "advanceInTimeWithTaskGraph", SCOREP_USER_REGION_TYPE_FUNCTION )
 
-      logInfo(rank) << "#max-updates since sync: " << m_logUpdates
-                         << " @ "                  << m_clusters[m_timeStepping.numberOfLocalClusters-1]->m_fullUpdateTime;
+  // the master thread resolves the dependencies and communicates, all threads execute the chunks
+#ifdef _OPENMP
+  #pragma omp parallel
+  #pragma omp master
+#endif
+  {
+    while( !m_taskGraph.finished() ) {
+      bool l_progress = false;
+
+      for( unsigned int l_cluster = 0; l_cluster < m_timeStepping.numberOfLocalClusters; l_cluster++ ) {
+        if( m_taskGraph.advance( l_cluster ) ) {
+          updateClusterDependencies( l_cluster );
+          l_progress = true;
+        }
+      }
+
+      logProgress();
+
+      // help with the execution of the chunks while waiting for dependencies
+      if( !l_progress ) {
+#ifdef _OPENMP
+        #pragma omp taskyield
+#endif
+      }
     }
   }
-#ifdef ACL_DEVICE
-  device.api->popLastProfilingMark();
-#endif
+}
+
+void seissol::time_stepping::TimeManager::logProgress() {
+  if( m_clusters[m_timeStepping.numberOfLocalClusters-1]->m_numberOfFullUpdates != m_logUpdates &&
+      m_clusters[m_timeStepping.numberOfLocalClusters-1]->m_numberOfFullUpdates % 100 == 0 ) {
+    m_logUpdates = m_clusters[m_timeStepping.numberOfLocalClusters-1]->m_numberOfFullUpdates;
+
+    const int rank = MPI::mpi.rank();
+
+    logInfo(rank) << "#max-updates since sync: " << m_logUpdates
+                       << " @ "                  << m_clusters[m_timeStepping.numberOfLocalClusters-1]->m_fullUpdateTime;
+  }
 }
 
 void seissol::time_stepping::TimeManager::printComputationTime()
@@ -369,6 +457,59 @@ void seissol::time_stepping::TimeManager::printComputationTime()
   m_loopStatistics.writeSamples();
 }
 
+void seissol::time_stepping::TimeManager::printLoadBalance()
+{
+#ifdef USE_MPI
+  const int rank = MPI::mpi.rank();
+  auto const& ltsLayout = seissol::SeisSol::main.getLtsLayout();
+  auto const costModel = seissol::initializers::time_stepping::LtsCostModel::fromEnvironment();
+
+  double const cellUpdates = ltsLayout.getPredictedCellUpdates();
+  double const dynamicRuptureUpdates = ltsLayout.getPredictedDynamicRuptureUpdates();
+  double volumeTime;
+  double dynamicRuptureTime;
+  getComputeTimes(volumeTime, dynamicRuptureTime);
+
+  auto imbalance = [](seissol::statistics::Summary const& summary) {
+    return (summary.max > 0.0) ? 100.0 * (1.0 - summary.mean / summary.max) : 0.0;
+  };
+
+  const auto predicted = seissol::statistics::parallelSummary(costModel.cellCost() * cellUpdates
+                                                              + costModel.dynamicRuptureCost() * dynamicRuptureUpdates);
+  const auto measured = seissol::statistics::parallelSummary(volumeTime + dynamicRuptureTime);
+  logInfo(rank) << "Load imbalance after the first synchronization: predicted" << imbalance(predicted)
+                << "%, measured" << imbalance(measured) << "%";
+
+  const auto predictedVolume = seissol::statistics::parallelSummary(cellUpdates);
+  const auto measuredVolume = seissol::statistics::parallelSummary(volumeTime);
+  logInfo(rank) << "Load imbalance of the volume integration: predicted" << imbalance(predictedVolume)
+                << "%, measured" << imbalance(measuredVolume) << "%";
+
+  double sums[4] = {cellUpdates, dynamicRuptureUpdates, volumeTime, dynamicRuptureTime};
+  MPI_Allreduce(MPI_IN_PLACE, sums, 4, MPI_DOUBLE, MPI_SUM, MPI::mpi.comm());
+  if (sums[1] > 0.0) {
+    const auto predictedDynamicRupture = seissol::statistics::parallelSummary(dynamicRuptureUpdates);
+    const auto measuredDynamicRupture = seissol::statistics::parallelSummary(dynamicRuptureTime);
+    logInfo(rank) << "Load imbalance of the dynamic rupture: predicted" << imbalance(predictedDynamicRupture)
+                  << "%, measured" << imbalance(measuredDynamicRupture) << "%";
+
+    if (sums[0] > 0.0 && sums[2] > 0.0) {
+      // time per face update relative to the time per cell update
+      double const dynamicRuptureCost = (sums[3] / sums[1]) / (sums[2] / sums[0]) * costModel.cellCost();
+      logInfo(rank) << "Measured cost of a dynamic rupture face relative to a cell: SEISSOL_LTS_DR_COST=" << utils::nospace
+                    << dynamicRuptureCost;
+    }
+  }
+#endif
+}
+
+void seissol::time_stepping::TimeManager::getComputeTimes( double& volumeTime, double& dynamicRuptureTime ) const
+{
+  volumeTime = m_loopStatistics.getTotalTime(m_loopStatistics.getRegion("computeLocalIntegration"))
+             + m_loopStatistics.getTotalTime(m_loopStatistics.getRegion("computeNeighboringIntegration"));
+  dynamicRuptureTime = m_loopStatistics.getTotalTime(m_loopStatistics.getRegion("computeDynamicRupture"));
+}
+
 double seissol::time_stepping::TimeManager::getTimeTolerance() {
   return 1E-5 * m_timeStepping.globalCflTimeStepWidths[0];
 }
@@ -389,6 +530,13 @@ void seissol::time_stepping::TimeManager::setReceiverClusters(writer::ReceiverWr
   }
 }
 
+void seissol::time_stepping::TimeManager::setGroundMotionMaps(solver::GroundMotionMaps& groundMotionMaps)
+{
+  for (unsigned cluster = 0; cluster < m_clusters.size(); ++cluster) {
+    m_clusters[cluster]->setGroundMotionMaps(&groundMotionMaps);
+  }
+}
+
 void seissol::time_stepping::TimeManager::setInitialTimes( double i_time ) {
   assert( i_time >= 0 );
 
@@ -405,6 +553,23 @@ void seissol::time_stepping::TimeManager::setTv(double tv) {
   }
 }
 
+void seissol::time_stepping::TimeManager::enableFrictionSolver(kernels::FrictionSolver::Parameters const& parameters) {
+  for( unsigned int l_cluster = 0; l_cluster < m_clusters.size(); l_cluster++ ) {
+    m_clusters[l_cluster]->enableFrictionSolver(parameters);
+  }
+}
+
+bool seissol::time_stepping::TimeManager::enableBatchedNeighborIntegration() {
+  if (m_useTaskGraph) {
+    logWarning(MPI::mpi.rank()) << "The batched neighbor integration is not supported by the task graph scheduler, using the cell-wise neighbor integration.";
+    return false;
+  }
+  for( unsigned int l_cluster = 0; l_cluster < m_clusters.size(); l_cluster++ ) {
+    m_clusters[l_cluster]->enableBatchedNeighborIntegration();
+  }
+  return true;
+}
+
 #if defined(_OPENMP) && defined(USE_MPI) && defined(USE_COMM_THREAD)
 void seissol::time_stepping::TimeManager::pollForCommunication() {
   // pin this thread to the last core
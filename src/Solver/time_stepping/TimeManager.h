@@ -54,6 +54,7 @@
 #include <Solver/FreeSurfaceIntegrator.h>
 #include <ResultWriter/ReceiverWriter.h>
 #include "TimeCluster.h"
+#include "TaskGraph.h"
 #include "Monitoring/Stopwatch.h"
 
 namespace seissol {
@@ -99,6 +100,27 @@ class seissol::time_stepping::TimeManager {
     
     //! Stopwatch
     LoopStatistics m_loopStatistics;
+
+    //! true if the clusters are updated by the task graph instead of the queues
+    bool m_useTaskGraph;
+
+    //! task graph scheduler
+    TaskGraph m_taskGraph;
+
+    /**
+     * Prints the progress of the largest time cluster.
+     **/
+    void logProgress();
+
+    /**
+     * Executes the updates with the queues until all clusters reached the synchronization time.
+     **/
+    void advanceInTimeWithQueues();
+
+    /**
+     * Executes the updates with the task graph until all clusters reached the synchronization time.
+     **/
+    void advanceInTimeWithTaskGraph();
     
     /**
      * Checks if the time stepping restrictions for this cluster and its neighbors changed.
@@ -180,11 +202,28 @@ class seissol::time_stepping::TimeManager {
      */
     void setReceiverClusters(writer::ReceiverWriter& receiverWriter); 
 
+    /**
+     * Lets all clusters update the ground motion maps after their full updates.
+     */
+    void setGroundMotionMaps(solver::GroundMotionMaps& groundMotionMaps);
+
     /**
      * Set Tv constant for plasticity.
      */
     void setTv(double tv);
 
+    /**
+     * Enables the layer-wise friction solver in all time clusters.
+     */
+    void enableFrictionSolver(kernels::FrictionSolver::Parameters const& parameters);
+
+    /**
+     * Enables the batched neighbor integration in all time clusters.
+     *
+     * @return false if the scheduler updates chunks of layers, which cannot use the batches of a layer.
+     */
+    bool enableBatchedNeighborIntegration();
+
     /**
      * Sets the initial time (time DOFS/DOFs/receivers) of all time clusters.
      * Required only if different from zero, for example in checkpointing.
@@ -203,6 +242,16 @@ class seissol::time_stepping::TimeManager {
 #endif
 
     void printComputationTime();
+
+    /**
+     * Compares the predicted and the measured load of the ranks.
+     **/
+    void printLoadBalance();
+
+    /**
+     * Gets the accumulated time of this rank spent in the volume integration and in the dynamic rupture.
+     **/
+    void getComputeTimes( double& volumeTime, double& dynamicRuptureTime ) const;
 };
 
 #endif
@@ -81,7 +81,10 @@
 #include <Initializer/PointMapper.h>
 #include <Solver/Interoperability.h>
 #include <utils/logger.h>
+#include <cassert>
 #include <cstring>
+#include <limits>
+#include <vector>
 
 template<typename T>
 class index_sort_by_value
@@ -166,13 +169,15 @@ void seissol::sourceterm::transformNRFSourceToInternalSource( Eigen::Vector3d co
   }
  
   for (unsigned sr = 0; sr < 3; ++sr) {
+    // the slip rates are appended in the order of the sources
+    assert(pointSources.slipRates.numberOfFunctions() == 3*index + sr);
     unsigned numSamples = nextOffsets[sr] - offsets[sr];
     double const* samples = (numSamples > 0) ? &sliprates[sr][ offsets[sr] ] : NULL;
-    samplesToPiecewiseLinearFunction1D( samples,
-                                        numSamples,
-                                        subfault.tinit,
-                                        subfault.timestep,
-                                        &pointSources.slipRates[index][sr] );
+    samplesToPiecewiseLinearFunctionTable( samples,
+                                           numSamples,
+                                           subfault.tinit,
+                                           subfault.timestep,
+                                           pointSources.slipRates );
   }
 }
 
@@ -323,7 +328,6 @@ void seissol::sourceterm::Manager::loadSourcesFromFSRM( double const*
     if (error) {
       logError() << "posix_memalign failed in source term manager.";
     }
-    sources[cluster].slipRates.resize(cmps[cluster].numberOfSources);
 
     for (unsigned clusterSource = 0; clusterSource < cmps[cluster].numberOfSources; ++clusterSource) {
       unsigned sourceIndex = cmps[cluster].sources[clusterSource];
@@ -348,11 +352,11 @@ void seissol::sourceterm::Manager::loadSourcesFromFSRM( double const*
         sources[cluster].tensor[clusterSource][6+i] /= material.rho;
       }
 
-      samplesToPiecewiseLinearFunction1D( &timeHistories[fsrmIndex * numberOfSamples],
-                                          numberOfSamples,
-                                          onsets[fsrmIndex],
-                                          timestep,
-                                          &sources[cluster].slipRates[clusterSource][0] );
+      samplesToPiecewiseLinearFunctionTable( &timeHistories[fsrmIndex * numberOfSamples],
+                                             numberOfSamples,
+                                             onsets[fsrmIndex],
+                                             timestep,
+                                             sources[cluster].slipRates );
     }
   }
   delete[] originalIndex;
@@ -383,7 +387,20 @@ void seissol::sourceterm::Manager::loadSourcesFromNRF(  char const*
 
   logInfo(rank) << "Reading" << fileName;
   NRF nrf;
+#ifdef USE_MPI
+  // every rank only keeps the sources in the bounding box of its partition
+  Eigen::Vector3d boundsMin = Eigen::Vector3d::Constant(std::numeric_limits<double>::max());
+  Eigen::Vector3d boundsMax = Eigen::Vector3d::Constant(std::numeric_limits<double>::lowest());
+  for (Vertex const& vertex : mesh.getVertices()) {
+    Eigen::Map<Eigen::Vector3d const> coords(vertex.coords);
+    boundsMin = boundsMin.cwiseMin(coords);
+    boundsMax = boundsMax.cwiseMax(coords);
+  }
+  std::vector<unsigned long> sourceIds;
+  readNRF(fileName, boundsMin, boundsMax, nrf, sourceIds);
+#else
   readNRF(fileName, nrf);
+#endif
 
   short* contained = new short[nrf.source];
   unsigned* meshIds = new unsigned[nrf.source];
@@ -393,7 +410,7 @@ void seissol::sourceterm::Manager::loadSourcesFromNRF(  char const*
 
 #ifdef USE_MPI
   logInfo(rank) << "Cleaning possible double occurring point sources for MPI...";
-  initializers::cleanDoubles(contained, nrf.source);
+  initializers::cleanDoubles(contained, sourceIds.data(), nrf.source);
 #endif
 
   unsigned* originalIndex = new unsigned[nrf.source];
@@ -422,7 +439,6 @@ void seissol::sourceterm::Manager::loadSourcesFromNRF(  char const*
     }
     sources[cluster].A.resize(cmps[cluster].numberOfSources);
     sources[cluster].stiffnessTensor.resize(cmps[cluster].numberOfSources);
-    sources[cluster].slipRates.resize(cmps[cluster].numberOfSources);
 
     for (unsigned clusterSource = 0; clusterSource < cmps[cluster].numberOfSources; ++clusterSource) {
       unsigned sourceIndex = cmps[cluster].sources[clusterSource];
@@ -41,122 +41,360 @@
 #include <utils/logger.h>
 
 #include <netcdf.h>
+#include <netcdf_meta.h>
 
 #include <cassert>
 
+#ifdef USE_MPI
+#include "Parallel/MPI.h"
+#include <algorithm>
+#include <climits>
+
+// Without a parallel netCDF, rank 0 reads the whole file and the routing scatters the sources
+#if !defined(NETCDF_PASSIVE) && defined(NC_HAS_PARALLEL) && NC_HAS_PARALLEL
+#define NRF_PARALLEL_READ
+#include <netcdf_par.h>
+#endif // !defined(NETCDF_PASSIVE) && defined(NC_HAS_PARALLEL) && NC_HAS_PARALLEL
+#endif // USE_MPI
+
 void check_err(const int stat, const int line, const char *file) {
   if (stat != NC_NOERR) {
     logError() << "line" << line << "of" << file << ":" << nc_strerror(stat) << std::endl;
   }
 }
 
-void seissol::sourceterm::readNRF(char const* filename, NRF& nrf)
-{
-  int ncid;
-  int stat;
+namespace {
+  struct NRFFile {
+    /* dimension lengths */
+    size_t source;
+    size_t sample_len[3];
 
-  /* dimension ids */
-  int source_dim;
-  int sroffset_dim;
-  int sample1_dim;
-  int sample2_dim;
-  int sample3_dim;
-
-  /* dimension lengths */
-  size_t sroffset_len;
-  size_t sample_len[3];
-
-  /* variable ids */
-  int centres_id;
-  int subfaults_id;
-  int sroffsets_id;
-  int sliprates1_id;
-  int sliprates2_id;
-  int sliprates3_id;
+    /* variable ids */
+    int centres_id;
+    int subfaults_id;
+    int sroffsets_id;
+    int sliprates_id[3];
+  };
 
-  /* open nrf */
-  stat = nc_open(filename, NC_NOWRITE, &ncid);
-  check_err(stat,__LINE__,__FILE__);
+  void inquireNRF(int ncid, NRFFile& file)
+  {
+    int stat;
 
-  /* get dimensions */
-  stat = nc_inq_dimid(ncid, "source", &source_dim);
-  check_err(stat,__LINE__,__FILE__);
-  stat = nc_inq_dimlen(ncid, source_dim, &nrf.source);
-  check_err(stat,__LINE__,__FILE__);
+    /* dimension ids */
+    int source_dim;
+    int sroffset_dim;
+    int sample_dim[3];
+    size_t sroffset_len;
 
-  stat = nc_inq_dimid(ncid, "sroffset", &sroffset_dim);
-  check_err(stat,__LINE__,__FILE__);
-  stat = nc_inq_dimlen(ncid, sroffset_dim, &sroffset_len);
-  check_err(stat,__LINE__,__FILE__);
+    /* get dimensions */
+    stat = nc_inq_dimid(ncid, "source", &source_dim);
+    check_err(stat,__LINE__,__FILE__);
+    stat = nc_inq_dimlen(ncid, source_dim, &file.source);
+    check_err(stat,__LINE__,__FILE__);
 
-  stat = nc_inq_dimid(ncid, "sample1", &sample1_dim);
-  check_err(stat,__LINE__,__FILE__);
-  stat = nc_inq_dimlen(ncid, sample1_dim, &sample_len[0]);
-  check_err(stat,__LINE__,__FILE__);
+    stat = nc_inq_dimid(ncid, "sroffset", &sroffset_dim);
+    check_err(stat,__LINE__,__FILE__);
+    stat = nc_inq_dimlen(ncid, sroffset_dim, &sroffset_len);
+    check_err(stat,__LINE__,__FILE__);
 
-  stat = nc_inq_dimid(ncid, "sample2", &sample2_dim);
-  check_err(stat,__LINE__,__FILE__);
-  stat = nc_inq_dimlen(ncid, sample2_dim, &sample_len[1]);
-  check_err(stat,__LINE__,__FILE__);
+    stat = nc_inq_dimid(ncid, "sample1", &sample_dim[0]);
+    check_err(stat,__LINE__,__FILE__);
+    stat = nc_inq_dimlen(ncid, sample_dim[0], &file.sample_len[0]);
+    check_err(stat,__LINE__,__FILE__);
 
-  stat = nc_inq_dimid(ncid, "sample3", &sample3_dim);
-  check_err(stat,__LINE__,__FILE__);
-  stat = nc_inq_dimlen(ncid, sample3_dim, &sample_len[2]);
-  check_err(stat,__LINE__,__FILE__);
+    stat = nc_inq_dimid(ncid, "sample2", &sample_dim[1]);
+    check_err(stat,__LINE__,__FILE__);
+    stat = nc_inq_dimlen(ncid, sample_dim[1], &file.sample_len[1]);
+    check_err(stat,__LINE__,__FILE__);
 
-  assert( nrf.source + 1 == sroffset_len );
+    stat = nc_inq_dimid(ncid, "sample3", &sample_dim[2]);
+    check_err(stat,__LINE__,__FILE__);
+    stat = nc_inq_dimlen(ncid, sample_dim[2], &file.sample_len[2]);
+    check_err(stat,__LINE__,__FILE__);
 
-  /* get varids */
-  stat = nc_inq_varid(ncid, "centres", &centres_id);
-  check_err(stat,__LINE__,__FILE__);
+    assert( file.source + 1 == sroffset_len );
 
-  stat = nc_inq_varid(ncid, "subfaults", &subfaults_id);
-  check_err(stat,__LINE__,__FILE__);
+    /* get varids */
+    stat = nc_inq_varid(ncid, "centres", &file.centres_id);
+    check_err(stat,__LINE__,__FILE__);
 
-  stat = nc_inq_varid(ncid, "sroffsets", &sroffsets_id);
-  check_err(stat,__LINE__,__FILE__);
+    stat = nc_inq_varid(ncid, "subfaults", &file.subfaults_id);
+    check_err(stat,__LINE__,__FILE__);
 
-  stat = nc_inq_varid(ncid, "sliprates1", &sliprates1_id);
-  check_err(stat,__LINE__,__FILE__);
+    stat = nc_inq_varid(ncid, "sroffsets", &file.sroffsets_id);
+    check_err(stat,__LINE__,__FILE__);
 
-  stat = nc_inq_varid(ncid, "sliprates2", &sliprates2_id);
-  check_err(stat,__LINE__,__FILE__);
+    stat = nc_inq_varid(ncid, "sliprates1", &file.sliprates_id[0]);
+    check_err(stat,__LINE__,__FILE__);
+
+    stat = nc_inq_varid(ncid, "sliprates2", &file.sliprates_id[1]);
+    check_err(stat,__LINE__,__FILE__);
+
+    stat = nc_inq_varid(ncid, "sliprates3", &file.sliprates_id[2]);
+    check_err(stat,__LINE__,__FILE__);
+  }
+}
+
+void seissol::sourceterm::readNRF(char const* filename, NRF& nrf)
+{
+  int ncid;
+  int stat;
+  NRFFile file;
 
-  stat = nc_inq_varid(ncid, "sliprates3", &sliprates3_id);
+  /* open nrf */
+  stat = nc_open(filename, NC_NOWRITE, &ncid);
   check_err(stat,__LINE__,__FILE__);
 
+  inquireNRF(ncid, file);
+  nrf.source = file.source;
+
   /* allocate memory */
   static_assert(sizeof(Eigen::Vector3d) == 3*sizeof(double), 
       "sizeof(Eigen::Vector3d) does not equal 3*sizeof(double).");
   nrf.centres = new Eigen::Vector3d[nrf.source];
   nrf.sroffsets = new Offsets[nrf.source + 1];
   nrf.subfaults = new Subfault[nrf.source];
-  for (unsigned i = 0; i < 3; ++i) {
-    nrf.sliprates[0] = new double[sample_len[0]];
-    nrf.sliprates[1] = new double[sample_len[1]];
-    nrf.sliprates[2] = new double[sample_len[2]];
+  for (unsigned sr = 0; sr < 3; ++sr) {
+    nrf.sliprates[sr] = new double[file.sample_len[sr]];
   }
 
   /* get values */
-  stat = nc_get_var(ncid, centres_id, nrf.centres);
+  stat = nc_get_var(ncid, file.centres_id, nrf.centres);
   check_err(stat,__LINE__,__FILE__);
 
-  stat = nc_get_var(ncid, sroffsets_id, nrf.sroffsets);
+  stat = nc_get_var(ncid, file.sroffsets_id, nrf.sroffsets);
   check_err(stat,__LINE__,__FILE__);
 
-  stat = nc_get_var(ncid, subfaults_id, nrf.subfaults);
+  stat = nc_get_var(ncid, file.subfaults_id, nrf.subfaults);
   check_err(stat,__LINE__,__FILE__);
 
-  stat = nc_get_var_double(ncid, sliprates1_id, nrf.sliprates[0]);
-  check_err(stat,__LINE__,__FILE__);
+  for (unsigned sr = 0; sr < 3; ++sr) {
+    stat = nc_get_var_double(ncid, file.sliprates_id[sr], nrf.sliprates[sr]);
+    check_err(stat,__LINE__,__FILE__);
+  }
 
-  stat = nc_get_var_double(ncid, sliprates2_id, nrf.sliprates[1]);
+  /* close nrf */
+  stat = nc_close(ncid);
   check_err(stat,__LINE__,__FILE__);
+}
 
-  stat = nc_get_var_double(ncid, sliprates3_id, nrf.sliprates[2]);
-  check_err(stat,__LINE__,__FILE__);
+#ifdef USE_MPI
+namespace {
+  /** Fixed size part of a source which is sent to the ranks containing its centre. */
+  struct SourceHeader {
+    unsigned long id;
+    Eigen::Vector3d centre;
+    seissol::sourceterm::Subfault subfault;
+    unsigned numberOfSamples[3];
+  };
 
-  /* close nrf */
-  stat = nc_close(ncid);
+  int checkedCount(size_t count) {
+    if (count > INT_MAX) {
+      logError() << "NRF: Message of" << count << "elements exceeds the MPI count limit.";
+    }
+    return static_cast<int>(count);
+  }
+}
+
+void seissol::sourceterm::readNRF( char const*             filename,
+                                   Eigen::Vector3d const&  boundsMin,
+                                   Eigen::Vector3d const&  boundsMax,
+                                   NRF&                    nrf,
+                                   std::vector<unsigned long>& sourceIds )
+{
+  int const rank = seissol::MPI::mpi.rank();
+  int const size = seissol::MPI::mpi.size();
+  MPI_Comm comm = seissol::MPI::mpi.comm();
+
+  int ncid;
+  int stat;
+  NRFFile file;
+
+#ifdef NRF_PARALLEL_READ
+  /* open nrf collectively */
+  stat = nc_open_par(filename, NC_NETCDF4 | NC_MPIIO, comm, MPI_INFO_NULL, &ncid);
   check_err(stat,__LINE__,__FILE__);
+
+  inquireNRF(ncid, file);
+
+  int const variables[] = {file.centres_id, file.subfaults_id, file.sroffsets_id,
+                           file.sliprates_id[0], file.sliprates_id[1], file.sliprates_id[2]};
+  for (int variable : variables) {
+    stat = nc_var_par_access(ncid, variable, NC_COLLECTIVE);
+    check_err(stat,__LINE__,__FILE__);
+  }
+
+  /* read the slice [first, last) of this rank */
+  bool const reader = true;
+  size_t const first = file.source * rank / size;
+  size_t const last = file.source * (rank+1) / size;
+#else // NRF_PARALLEL_READ
+  /* only rank 0 reads, its slice contains all sources */
+  bool const reader = (rank == 0);
+  if (reader) {
+    stat = nc_open(filename, NC_NOWRITE, &ncid);
+    check_err(stat,__LINE__,__FILE__);
+
+    inquireNRF(ncid, file);
+  }
+  unsigned long numberOfSources = reader ? file.source : 0;
+  MPI_Bcast(&numberOfSources, 1, MPI_UNSIGNED_LONG, 0, comm);
+  file.source = numberOfSources;
+
+  size_t const first = 0;
+  size_t const last = reader ? file.source : 0;
+#endif // NRF_PARALLEL_READ
+  size_t const numberOfSlicedSources = last - first;
+
+  std::vector<Eigen::Vector3d> centres(numberOfSlicedSources);
+  std::vector<Subfault> subfaults(numberOfSlicedSources);
+  std::vector<Offsets> sroffsets(numberOfSlicedSources + 1);
+  std::vector<double> sliprates[3];
+
+  if (reader) {
+    size_t start[2] = {first, 0};
+    size_t count[2] = {numberOfSlicedSources, 3};
+    stat = nc_get_vara(ncid, file.centres_id, start, count, centres.data());
+    check_err(stat,__LINE__,__FILE__);
+
+    stat = nc_get_vara(ncid, file.subfaults_id, start, count, subfaults.data());
+    check_err(stat,__LINE__,__FILE__);
+
+    count[0] = numberOfSlicedSources + 1;
+    stat = nc_get_vara(ncid, file.sroffsets_id, start, count, sroffsets.data());
+    check_err(stat,__LINE__,__FILE__);
+
+    for (unsigned sr = 0; sr < 3; ++sr) {
+      size_t sampleStart = sroffsets[0][sr];
+      size_t sampleCount = sroffsets[numberOfSlicedSources][sr] - sroffsets[0][sr];
+      sliprates[sr].resize(sampleCount);
+      stat = nc_get_vara_double(ncid, file.sliprates_id[sr], &sampleStart, &sampleCount, sliprates[sr].data());
+      check_err(stat,__LINE__,__FILE__);
+    }
+
+    /* close nrf */
+    stat = nc_close(ncid);
+    check_err(stat,__LINE__,__FILE__);
+  } else {
+    for (unsigned sr = 0; sr < 3; ++sr) {
+      sroffsets[0][sr] = 0;
+    }
+  }
+
+  /* gather the bounding boxes, which are slightly extended for centres on the boundary */
+  double const tolerance = 1.0e-8 * (boundsMax - boundsMin).cwiseAbs().maxCoeff();
+  double localBounds[6];
+  for (unsigned d = 0; d < 3; ++d) {
+    localBounds[d] = boundsMin(d) - tolerance;
+    localBounds[3+d] = boundsMax(d) + tolerance;
+  }
+  std::vector<double> bounds(6 * size);
+  MPI_Allgather(localBounds, 6, MPI_DOUBLE, bounds.data(), 6, MPI_DOUBLE, comm);
+
+  /* route the sources */
+  std::vector<std::vector<unsigned>> sourcesPerRank(size);
+  for (unsigned source = 0; source < numberOfSlicedSources; ++source) {
+    for (int r = 0; r < size; ++r) {
+      double const* b = &bounds[6*r];
+      if (centres[source](0) >= b[0] && centres[source](1) >= b[1] && centres[source](2) >= b[2]
+       && centres[source](0) <= b[3] && centres[source](1) <= b[4] && centres[source](2) <= b[5]) {
+        sourcesPerRank[r].push_back(source);
+      }
+    }
+  }
+
+  std::vector<int> sendCounts(2*size);
+  for (int r = 0; r < size; ++r) {
+    size_t numberOfSamples = 0;
+    for (unsigned source : sourcesPerRank[r]) {
+      for (unsigned sr = 0; sr < 3; ++sr) {
+        numberOfSamples += sroffsets[source+1][sr] - sroffsets[source][sr];
+      }
+    }
+    sendCounts[2*r] = checkedCount(sourcesPerRank[r].size() * sizeof(SourceHeader));
+    sendCounts[2*r+1] = checkedCount(numberOfSamples);
+  }
+  std::vector<int> recvCounts(2*size);
+  MPI_Alltoall(sendCounts.data(), 2, MPI_INT, recvCounts.data(), 2, MPI_INT, comm);
+
+  std::vector<int> headerSendCounts(size), headerSendDispls(size), headerRecvCounts(size), headerRecvDispls(size);
+  std::vector<int> sampleSendCounts(size), sampleSendDispls(size), sampleRecvCounts(size), sampleRecvDispls(size);
+  size_t headerSendSize = 0, sampleSendSize = 0, headerRecvSize = 0, sampleRecvSize = 0;
+  for (int r = 0; r < size; ++r) {
+    headerSendCounts[r] = sendCounts[2*r];
+    sampleSendCounts[r] = sendCounts[2*r+1];
+    headerRecvCounts[r] = recvCounts[2*r];
+    sampleRecvCounts[r] = recvCounts[2*r+1];
+    headerSendDispls[r] = checkedCount(headerSendSize);
+    sampleSendDispls[r] = checkedCount(sampleSendSize);
+    headerRecvDispls[r] = checkedCount(headerRecvSize);
+    sampleRecvDispls[r] = checkedCount(sampleRecvSize);
+    headerSendSize += headerSendCounts[r];
+    sampleSendSize += sampleSendCounts[r];
+    headerRecvSize += headerRecvCounts[r];
+    sampleRecvSize += sampleRecvCounts[r];
+  }
+
+  std::vector<SourceHeader> headerSendBuffer(headerSendSize / sizeof(SourceHeader));
+  std::vector<double> sampleSendBuffer(sampleSendSize);
+  SourceHeader* header = headerSendBuffer.data();
+  double* samples = sampleSendBuffer.data();
+  for (int r = 0; r < size; ++r) {
+    for (unsigned source : sourcesPerRank[r]) {
+      header->id = first + source;
+      header->centre = centres[source];
+      header->subfault = subfaults[source];
+      for (unsigned sr = 0; sr < 3; ++sr) {
+        unsigned begin = sroffsets[source][sr] - sroffsets[0][sr];
+        header->numberOfSamples[sr] = sroffsets[source+1][sr] - sroffsets[source][sr];
+        samples = std::copy_n(&sliprates[sr][begin], header->numberOfSamples[sr], samples);
+      }
+      ++header;
+    }
+  }
+
+  std::vector<SourceHeader> headerRecvBuffer(headerRecvSize / sizeof(SourceHeader));
+  std::vector<double> sampleRecvBuffer(sampleRecvSize);
+  MPI_Alltoallv(headerSendBuffer.data(), headerSendCounts.data(), headerSendDispls.data(), MPI_BYTE,
+                headerRecvBuffer.data(), headerRecvCounts.data(), headerRecvDispls.data(), MPI_BYTE, comm);
+  MPI_Alltoallv(sampleSendBuffer.data(), sampleSendCounts.data(), sampleSendDispls.data(), MPI_DOUBLE,
+                sampleRecvBuffer.data(), sampleRecvCounts.data(), sampleRecvDispls.data(), MPI_DOUBLE, comm);
+
+  /* unpack the received sources, which are sorted by their index in the file */
+  nrf.source = headerRecvBuffer.size();
+  nrf.centres = new Eigen::Vector3d[nrf.source];
+  nrf.sroffsets = new Offsets[nrf.source + 1];
+  nrf.subfaults = new Subfault[nrf.source];
+  sourceIds.resize(nrf.source);
+
+  for (unsigned sr = 0; sr < 3; ++sr) {
+    nrf.sroffsets[0][sr] = 0;
+  }
+  for (unsigned source = 0; source < nrf.source; ++source) {
+    for (unsigned sr = 0; sr < 3; ++sr) {
+      nrf.sroffsets[source+1][sr] = nrf.sroffsets[source][sr] + headerRecvBuffer[source].numberOfSamples[sr];
+    }
+  }
+  for (unsigned sr = 0; sr < 3; ++sr) {
+    nrf.sliprates[sr] = new double[nrf.sroffsets[nrf.source][sr]];
+  }
+
+  double const* receivedSamples = sampleRecvBuffer.data();
+  for (unsigned source = 0; source < nrf.source; ++source) {
+    sourceIds[source] = headerRecvBuffer[source].id;
+    nrf.centres[source] = headerRecvBuffer[source].centre;
+    nrf.subfaults[source] = headerRecvBuffer[source].subfault;
+    for (unsigned sr = 0; sr < 3; ++sr) {
+      unsigned numberOfSamples = headerRecvBuffer[source].numberOfSamples[sr];
+      std::copy_n(receivedSamples, numberOfSamples, &nrf.sliprates[sr][ nrf.sroffsets[source][sr] ]);
+      receivedSamples += numberOfSamples;
+    }
+  }
+
+#ifdef NRF_PARALLEL_READ
+  logInfo(rank) << "Distributed" << file.source << "sources read in slices of at most" << (file.source + size - 1) / size << "sources.";
+#else // NRF_PARALLEL_READ
+  logInfo(rank) << "Distributed" << file.source << "sources read by rank 0 (no parallel netCDF).";
+#endif // NRF_PARALLEL_READ
 }
+#endif
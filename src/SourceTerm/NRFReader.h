@@ -43,9 +43,26 @@
 
 #include "NRF.h"
 
+#ifdef USE_MPI
+#include <vector>
+#endif
+
 namespace seissol {
   namespace sourceterm {
     void readNRF(char const* filename, NRF& nrf);
+
+#ifdef USE_MPI
+    /** Reads the NRF file collectively: Each rank reads a disjoint slice of the sources
+     *  and sends every source to all ranks whose bounding box contains its centre.
+     *  On return, nrf holds the sources in the bounding box [boundsMin, boundsMax] of this rank
+     *  and sourceIds their index in the file.
+     */
+    void readNRF( char const*             filename,
+                  Eigen::Vector3d const&  boundsMin,
+                  Eigen::Vector3d const&  boundsMax,
+                  NRF&                    nrf,
+                  std::vector<unsigned long>& sourceIds );
+#endif
   }
 }
 
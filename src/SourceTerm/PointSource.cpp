@@ -141,22 +141,59 @@ real seissol::sourceterm::computePwLFTimeIntegral(PiecewiseLinearFunction1D cons
    return l_integral;
 }
 
+namespace {
+  /* F(t) := int_{t_o}^t f(s) ds = C_j + (S_j + 1/2 * (S_{j+1} - S_j) / dt * tau) * tau,
+   * where j is the piece containing t, tau = t - t_o - j*dt, and C_j the cumulative integral.
+   */
+  inline double cumulativePwLFIntegral(double time,
+                                       double onsetTime,
+                                       double samplingInterval,
+                                       double numberOfPieces,
+                                       unsigned sampleOffset,
+                                       double const* samples,
+                                       double const* cumulativeIntegrals)
+  {
+    // x >= 0, hence truncation rounds down
+    double x = std::min(std::max((time - onsetTime) / samplingInterval, 0.0), numberOfPieces);
+    int j = std::min(static_cast<int>(x), static_cast<int>(numberOfPieces) - 1);
+    unsigned sample = sampleOffset + j;
+    double tau = (x - j) * samplingInterval;
+    return cumulativeIntegrals[sample]
+         + (samples[sample] + 0.5 * (samples[sample+1] - samples[sample]) / samplingInterval * tau) * tau;
+  }
+}
+
+void seissol::sourceterm::computePwLFTimeIntegrals(PiecewiseLinearFunctionTable const& i_table,
+                                                   unsigned i_firstFunction,
+                                                   unsigned i_lastFunction,
+                                                   double i_fromTime,
+                                                   double i_toTime,
+                                                   real* o_integrals)
+{
+  double const* onsetTime = i_table.onsetTime.data();
+  double const* samplingInterval = i_table.samplingInterval.data();
+  unsigned const* sampleOffset = i_table.sampleOffset.data();
+  double const* samples = i_table.samples.data();
+  double const* cumulativeIntegrals = i_table.cumulativeIntegrals.data();
+
+#ifdef _OPENMP
+  #pragma omp simd
+#endif
+  for (unsigned f = i_firstFunction; f < i_lastFunction; ++f) {
+    // every function has at least one piece
+    double numberOfPieces = sampleOffset[f+1] - sampleOffset[f] - 1;
+    o_integrals[f - i_firstFunction] = cumulativePwLFIntegral(i_toTime, onsetTime[f], samplingInterval[f], numberOfPieces, sampleOffset[f], samples, cumulativeIntegrals)
+                                     - cumulativePwLFIntegral(i_fromTime, onsetTime[f], samplingInterval[f], numberOfPieces, sampleOffset[f], samples, cumulativeIntegrals);
+  }
+}
+
 void seissol::sourceterm::addTimeIntegratedPointSourceNRF( real const i_mInvJInvPhisAtSources[tensor::mInvJInvPhisAtSources::size()],
                                                            real const faultBasis[9],
                                                            real A,
                                                            std::array<real, 81> const &stiffnessTensor,
-                                                           std::array<PiecewiseLinearFunction1D, 3> const &slipRates,
-                                                           double i_fromTime,
-                                                           double i_toTime,
+                                                           real const slip[3],
                                                            real o_dofUpdate[tensor::Q::size()] )
 {  
-  real slip[] = { 0.0, 0.0, 0.0};
-  for (unsigned i = 0; i < 3; ++i) {
-    if (slipRates[i].numberOfPieces > 0) {
-      slip[i] = computePwLFTimeIntegral(slipRates[i], i_fromTime, i_toTime);
-    }
-  }
-  
   real rotatedSlip[] = { 0.0, 0.0, 0.0 };
   for (unsigned i = 0; i < 3; ++i) {
     for (unsigned j = 0; j < 3; ++j) {
@@ -180,16 +217,14 @@ void seissol::sourceterm::addTimeIntegratedPointSourceNRF( real const i_mInvJInv
 
 void seissol::sourceterm::addTimeIntegratedPointSourceFSRM( real const i_mInvJInvPhisAtSources[tensor::mInvJInvPhisAtSources::size()],
                                                             real const i_forceComponents[tensor::momentFSRM::size()],
-                                                            PiecewiseLinearFunction1D const& i_pwLF,
-                                                            double i_fromTime,
-                                                            double i_toTime,
+                                                            real i_stfIntegral,
                                                             real o_dofUpdate[tensor::Q::size()] )
 {
   kernel::sourceFSRM krnl;
   krnl.Q = o_dofUpdate;
   krnl.mInvJInvPhisAtSources = i_mInvJInvPhisAtSources;
   krnl.momentFSRM = i_forceComponents;
-  krnl.stfIntegral = computePwLFTimeIntegral(i_pwLF, i_fromTime, i_toTime);
+  krnl.stfIntegral = i_stfIntegral;
 #ifdef MULTIPLE_SIMULATIONS
   krnl.oneSimToMultSim = init::oneSimToMultSim::Values;
 #endif
@@ -43,6 +43,7 @@
 #define SOURCETERM_POINTSOURCE_H_
 
 #include <Initializer/typedefs.hpp>
+#include <SourceTerm/typedefs.hpp>
 
 namespace seissol {
   namespace sourceterm {
@@ -120,32 +121,74 @@ namespace seissol {
       }
     }
 
+    /** Appends equally spaced time samples as piecewise linear function to the table.
+     *  Functions with less than two samples vanish.
+     */
+    template<typename real_from>
+    void samplesToPiecewiseLinearFunctionTable(real_from const* i_samples,
+                                               unsigned i_numberOfSamples,
+                                               double i_onsetTime,
+                                               double i_samplingInterval,
+                                               PiecewiseLinearFunctionTable& io_table)
+    {
+      io_table.onsetTime.push_back(i_onsetTime);
+      io_table.samplingInterval.push_back(i_samplingInterval);
+
+      if (i_numberOfSamples < 2) {
+        io_table.samples.insert(io_table.samples.end(), 2, 0.0);
+        io_table.cumulativeIntegrals.insert(io_table.cumulativeIntegrals.end(), 2, 0.0);
+      } else {
+        /* The integral of a linear piece is exactly given by the trapezoidal rule, i.e.
+         *   int_{t_o + j*dt}^{t_o + (j+1)*dt} f(t) dt = dt/2 * (S_j + S_{j+1})
+         */
+        double integral = 0.0;
+        for (unsigned j = 0; j < i_numberOfSamples; ++j) {
+          io_table.samples.push_back(i_samples[j]);
+          io_table.cumulativeIntegrals.push_back(integral);
+          if (j+1 < i_numberOfSamples) {
+            integral += 0.5 * i_samplingInterval * (i_samples[j] + i_samples[j+1]);
+          }
+        }
+      }
+      io_table.sampleOffset.push_back(io_table.samples.size());
+    }
+
     /** Returns integral_fromTime^toTime i_pwLF dt. */
     real computePwLFTimeIntegral(PiecewiseLinearFunction1D const& i_pwLF,
                                  double i_fromTime,
                                  double i_toTime);
 
+    /** Computes o_integrals[f - i_firstFunction] = integral_fromTime^toTime f dt
+     *  for the functions [i_firstFunction, i_lastFunction) of the table.
+     */
+    void computePwLFTimeIntegrals(PiecewiseLinearFunctionTable const& i_table,
+                                  unsigned i_firstFunction,
+                                  unsigned i_lastFunction,
+                                  double i_fromTime,
+                                  double i_toTime,
+                                  real* o_integrals);
+
+    /** Adds the moment tensor of an NRF source with the time-integrated slip
+     *  in direction of Tan1, Tan2, and Normal.
+     */
     void addTimeIntegratedPointSourceNRF( real const i_mInvJInvPhisAtSources[tensor::mInvJInvPhisAtSources::size()],
                                           real const faultBasis[9],
                                           real A,
                                           std::array<real, 81> const &stiffnessTensor,
-                                          std::array<PiecewiseLinearFunction1D, 3> const &slipRates,
-                                          double i_fromTime,
-                                          double i_toTime,
+                                          real const slip[3],
                                           real o_dofUpdate[tensor::Q::size()] );
     /**
      * Point sources in SeisSol (\delta(x-x_s) * S(t)).
      * 
      * Computes Q_kl += int_a^b S(t) dt * phiAtSource[k] * momentTensor[l], where
+     * i_stfIntegral = int_a^b S(t) dt and
      * Q_kl is a DOF. phiAtSource times momentTensor is to be understood
      * as outer product of two vectors (i.e. yields a rank-1 dof-update-matrix that shall
      * be scaled with the time integral of the source term).
      **/                                      
     void addTimeIntegratedPointSourceFSRM( real const i_mInvJInvPhisAtSources[tensor::mInvJInvPhisAtSources::size()],
                                            real const i_forceComponents[tensor::momentFSRM::size()],
-                                           PiecewiseLinearFunction1D const& i_pwLF,
-                                           double i_fromTime,
-                                           double i_toTime,
+                                           real i_stfIntegral,
                                            real o_dofUpdate[tensor::Q::size()] );
   }
 }
@@ -49,6 +49,29 @@
 
 namespace seissol {
   namespace sourceterm {    
+    /** Piecewise linear functions given by equally spaced samples in structure of arrays layout.
+     *  The integral from the onset to every sample is precomputed, such that a time integral
+     *  only needs two lookups, independent of the number of pieces in the integration interval.
+     **/
+    struct PiecewiseLinearFunctionTable {
+      //! onsetTime[f] = t_o of the f-th function
+      std::vector<double> onsetTime;
+
+      //! samplingInterval[f] = dt of the f-th function
+      std::vector<double> samplingInterval;
+
+      //! The samples of the f-th function reside in [sampleOffset[f], sampleOffset[f+1])
+      std::vector<unsigned> sampleOffset = std::vector<unsigned>(1, 0);
+
+      //! samples[sampleOffset[f] + j] = S_j = f(t_o + j*dt)
+      std::vector<double> samples;
+
+      //! cumulativeIntegrals[sampleOffset[f] + j] = int_{t_o}^{t_o + j*dt} f(t) dt
+      std::vector<double> cumulativeIntegrals;
+
+      unsigned numberOfFunctions() const { return onsetTime.size(); }
+    };
+
     /** Models point sources of the form
      *    S(xi, eta, zeta, t) := (1 / |J|) * S(t) * M * delta(xi-xi_s, eta-eta_s, zeta-zeta_s),
      * where S(t) : t -> \mathbb R is the moment time history,
@@ -83,13 +106,13 @@ namespace seissol {
       /// elasticity tensor
       std::vector<std::array<real, 81>> stiffnessTensor;
 
-      /** NRF: slip rate in
-       * 0: Tan1 direction
-       * 1: Tan2 direction
-       * 2: Normal direction
+      /** NRF: slip rate of source s in
+       * 3*s + 0: Tan1 direction
+       * 3*s + 1: Tan2 direction
+       * 3*s + 2: Normal direction
        * 
-       * FSRM: 0: slip rate (all directions) */
-      std::vector<std::array<PiecewiseLinearFunction1D, 3>> slipRates;
+       * FSRM: s: slip rate (all directions) */
+      PiecewiseLinearFunctionTable slipRates;
 
       /** Number of point sources in this struct. */
       unsigned numberOfSources;
@@ -38,6 +38,7 @@
  */
 
 #include "SeisSol.h"
+#include "Solver/Rebalancer.h"
 
 extern "C" {
   void fortran_main();
@@ -57,4 +58,10 @@ int main(int argc, char* argv[])
 
 	// Finalize SeisSol
 	seissol::SeisSol::main.finalize();
+
+	// The simulation did not reach the final time and has to be restarted from the checkpoint
+	if (seissol::SeisSol::main.simulator().stoppedForRebalancing())
+		return seissol::Rebalancer::RestartExitStatus;
+
+	return 0;
 }
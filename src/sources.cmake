@@ -5,7 +5,10 @@ src/Initializer/GlobalData.cpp
 src/Initializer/InternalState.cpp
 src/Initializer/MemoryAllocator.cpp
 src/Initializer/CellLocalMatrices.cpp
+src/Initializer/InitializationCache.cpp
 
+src/Initializer/time_stepping/LtsCostModel.cpp
+src/Initializer/time_stepping/CellOrdering.cpp
 src/Initializer/time_stepping/LtsLayout.cpp
 src/Initializer/tree/Lut.cpp
 src/Initializer/MemoryManager.cpp
@@ -28,12 +31,16 @@ src/generated_code/kernel.h
 src/generated_code/kernel.cpp
 
 src/Solver/Simulator.cpp
+src/Solver/Rebalancer.cpp
 src/Solver/FreeSurfaceIntegrator.cpp
+src/Solver/GroundMotionMaps.cpp
 src/Solver/Interoperability.cpp
 src/Solver/time_stepping/MiniSeisSol.cpp
 src/Solver/time_stepping/TimeCluster.cpp
 src/Solver/time_stepping/TimeManager.cpp
+src/Solver/time_stepping/TaskGraph.cpp
 src/Kernels/DynamicRupture.cpp
+src/Kernels/FrictionSolver.cpp
 src/Kernels/Plasticity.cpp
 src/Kernels/TimeCommon.cpp
 src/Kernels/Receiver.cpp
@@ -49,11 +56,14 @@ src/Geometry/GambitReader.cpp
 
 src/Geometry/MeshReaderFBinding.cpp
 src/Geometry/MeshTools.cpp
+src/Geometry/ElementIndex.cpp
 src/Monitoring/FlopCounter.cpp
 src/Monitoring/LoopStatistics.cpp
+src/Monitoring/PerformanceCounters.cpp
 src/Reader/readparC.cpp
 #Reader/StressReaderC.cpp
 src/Checkpoint/Manager.cpp
+src/Checkpoint/Redistributor.cpp
 
 # TODO: Only if mpi?
 src/Checkpoint/mpio/Wavefield.cpp
@@ -73,9 +83,11 @@ src/ResultWriter/FreeSurfaceWriterExecutor.cpp
 src/ResultWriter/PostProcessor.cpp
 src/ResultWriter/FaultWriterC.cpp
 src/ResultWriter/ReceiverWriter.cpp
+src/ResultWriter/ReceiverWriterExecutor.cpp
 src/ResultWriter/FaultWriterExecutor.cpp
 src/ResultWriter/FaultWriter.cpp
 src/ResultWriter/WaveFieldWriter.cpp
+src/ResultWriter/OutputRegions.cpp
 src/ResultWriter/FreeSurfaceWriter.cpp
 
 # Fortran:
@@ -197,11 +209,14 @@ endif()
 target_include_directories(SeisSol-lib PUBLIC
         ${CMAKE_CURRENT_SOURCE_DIR}/src/Initializer/BatchRecorders)
 
+# also used by the batched neighbor integration on the host
+target_sources(SeisSol-lib PUBLIC
+        ${CMAKE_CURRENT_SOURCE_DIR}/src/Initializer/BatchRecorders/NeighIntegrationRecorder.cpp)
+
 if ("${DEVICE_BACKEND}" STREQUAL "CUDA")
 
   target_sources(SeisSol-lib PUBLIC
           ${CMAKE_CURRENT_SOURCE_DIR}/src/Initializer/BatchRecorders/LocalIntegrationRecorder.cpp
-          ${CMAKE_CURRENT_SOURCE_DIR}/src/Initializer/BatchRecorders/NeighIntegrationRecorder.cpp
           ${CMAKE_CURRENT_SOURCE_DIR}/src/Initializer/BatchRecorders/PlasticityRecorder.cpp)
 
   find_package(CUDA REQUIRED)
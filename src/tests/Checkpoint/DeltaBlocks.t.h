@@ -0,0 +1,134 @@
+#include <cxxtest/TestSuite.h>
+
+#include <Checkpoint/DeltaBlocks.h>
+
+#include <vector>
+
+namespace seissol {
+  namespace unit_test {
+    class DeltaBlocksTestSuite;
+  }
+}
+
+class seissol::unit_test::DeltaBlocksTestSuite : public CxxTest::TestSuite
+{
+  private:
+    //! The last block is partial
+    static constexpr unsigned long size = 1000;
+    static constexpr unsigned long blockSize = 64;
+    static constexpr unsigned long lastBlockSize = size % blockSize;
+
+    std::vector<unsigned char> data;
+
+    unsigned long numberOfChangedBlocks(seissol::checkpoint::DeltaBlocks const& deltaBlocks) {
+      unsigned long changed = 0;
+      for (unsigned long block = 0; block < deltaBlocks.numBlocks(); ++block) {
+        if (deltaBlocks.changed(block)) {
+          ++changed;
+        }
+      }
+      return changed;
+    }
+
+  public:
+    void setUp() {
+      data.resize(size);
+      for (unsigned long i = 0; i < size; ++i) {
+        data[i] = static_cast<unsigned char>(7 * i + 3);
+      }
+    }
+
+    void testBlocks()
+    {
+      seissol::checkpoint::DeltaBlocks deltaBlocks;
+      deltaBlocks.init(size, blockSize);
+      TS_ASSERT_EQUALS(16ul, deltaBlocks.numBlocks());
+      TS_ASSERT_EQUALS(blockSize, deltaBlocks.blockSize());
+      TS_ASSERT_EQUALS(blockSize, deltaBlocks.blockEnd(0));
+      TS_ASSERT_EQUALS(size, deltaBlocks.blockEnd(deltaBlocks.numBlocks() - 1));
+    }
+
+    //! Only the blocks that changed since the checkpoint in the same file are written
+    void testChangedBlocks()
+    {
+      seissol::checkpoint::DeltaBlocks deltaBlocks;
+      deltaBlocks.init(size, blockSize);
+
+      // both files are written completely the first time
+      TS_ASSERT_EQUALS(size, deltaBlocks.update(0, data.data()));
+      TS_ASSERT_EQUALS(deltaBlocks.numBlocks(), numberOfChangedBlocks(deltaBlocks));
+      TS_ASSERT_EQUALS(size, deltaBlocks.update(1, data.data()));
+      TS_ASSERT_EQUALS(deltaBlocks.numBlocks(), numberOfChangedBlocks(deltaBlocks));
+
+      // unchanged data
+      TS_ASSERT_EQUALS(0ul, deltaBlocks.update(0, data.data()));
+      TS_ASSERT_EQUALS(0ul, numberOfChangedBlocks(deltaBlocks));
+
+      // change a single byte in block 3 and in the partial last block
+      data[3 * blockSize + 17] ^= 1;
+      data[size - 1] ^= 0x80;
+      TS_ASSERT_EQUALS(blockSize + lastBlockSize, deltaBlocks.update(1, data.data()));
+      TS_ASSERT_EQUALS(2ul, numberOfChangedBlocks(deltaBlocks));
+      TS_ASSERT(deltaBlocks.changed(3));
+      TS_ASSERT(deltaBlocks.changed(deltaBlocks.numBlocks() - 1));
+
+      // the even file still holds the old content of the blocks
+      TS_ASSERT_EQUALS(blockSize + lastBlockSize, deltaBlocks.update(0, data.data()));
+      TS_ASSERT_EQUALS(2ul, numberOfChangedBlocks(deltaBlocks));
+
+      // both files are up to date
+      TS_ASSERT_EQUALS(0ul, deltaBlocks.update(1, data.data()));
+      TS_ASSERT_EQUALS(0ul, deltaBlocks.update(0, data.data()));
+
+      // a new initialization invalidates both files
+      deltaBlocks.init(size, blockSize);
+      TS_ASSERT_EQUALS(size, deltaBlocks.update(0, data.data()));
+      TS_ASSERT_EQUALS(size, deltaBlocks.update(1, data.data()));
+    }
+
+    //! Every fullInterval-th update of a file writes all blocks
+    void testFullInterval()
+    {
+      constexpr unsigned long fullInterval = 3;
+      seissol::checkpoint::DeltaBlocks deltaBlocks;
+      deltaBlocks.init(size, blockSize, fullInterval);
+
+      for (unsigned long update = 0; update < 4 * fullInterval; ++update) {
+        unsigned long const expected = (update % fullInterval == 0) ? size : 0;
+        TS_ASSERT_EQUALS(expected, deltaBlocks.update(0, data.data()));
+        // the updates of the odd file are counted separately
+        if (update < 2) {
+          TS_ASSERT_EQUALS(update == 0 ? size : 0ul, deltaBlocks.update(1, data.data()));
+        }
+      }
+    }
+
+    void testInvalidBlockSize()
+    {
+      TS_ASSERT(seissol::checkpoint::DeltaBlocks::validBlockSize(1, 8));
+      TS_ASSERT(seissol::checkpoint::DeltaBlocks::validBlockSize(8, 8));
+      TS_ASSERT(seissol::checkpoint::DeltaBlocks::validBlockSize(4096, 8));
+      TS_ASSERT(seissol::checkpoint::DeltaBlocks::validBlockSize(12, 4));
+      TS_ASSERT(!seissol::checkpoint::DeltaBlocks::validBlockSize(0, 8));
+      TS_ASSERT(!seissol::checkpoint::DeltaBlocks::validBlockSize(-8, 8));
+      TS_ASSERT(!seissol::checkpoint::DeltaBlocks::validBlockSize(4, 8));
+      TS_ASSERT(!seissol::checkpoint::DeltaBlocks::validBlockSize(12, 8));
+
+      // a block size of zero falls back to single bytes
+      seissol::checkpoint::DeltaBlocks deltaBlocks;
+      deltaBlocks.init(size, 0);
+      TS_ASSERT_EQUALS(1ul, deltaBlocks.blockSize());
+      TS_ASSERT_EQUALS(size, deltaBlocks.numBlocks());
+      TS_ASSERT_EQUALS(size, deltaBlocks.update(0, data.data()));
+      data[42] ^= 1;
+      deltaBlocks.update(1, data.data());
+      TS_ASSERT_EQUALS(1ul, deltaBlocks.update(0, data.data()));
+      TS_ASSERT(deltaBlocks.changed(42));
+
+      // blocks larger than the data
+      deltaBlocks.init(size, 2 * size);
+      TS_ASSERT_EQUALS(1ul, deltaBlocks.numBlocks());
+      TS_ASSERT_EQUALS(size, deltaBlocks.blockEnd(0));
+      TS_ASSERT_EQUALS(size, deltaBlocks.update(0, data.data()));
+    }
+};
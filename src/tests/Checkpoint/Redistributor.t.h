@@ -0,0 +1,112 @@
+#include <cxxtest/TestSuite.h>
+
+#include <Checkpoint/Redistributor.h>
+#include <Parallel/MPI.h>
+
+#include <vector>
+
+namespace seissol {
+  namespace unit_test {
+    class RedistributorTestSuite;
+  }
+}
+
+class seissol::unit_test::RedistributorTestSuite : public CxxTest::TestSuite
+{
+  private:
+    static constexpr unsigned long numberOfIds = 97;
+
+    struct Value {
+      double x[3];
+    };
+
+    static Value value(unsigned long id) {
+      Value v = {{1.0 * id, -2.0 * id, 0.5 * id + 3.0}};
+      return v;
+    }
+
+#ifdef USE_MPI
+    /**
+     * Redistributes the ids [0, numberOfIds) between the ranks of comm.
+     * The ids are read in contiguous slabs (like a checkpoint file) by all
+     * ranks except the last one and are required in a strided pattern by all
+     * ranks except the first one.
+     */
+    void redistribute(MPI_Comm comm) {
+      int rank;
+      int size;
+      MPI_Comm_rank(comm, &rank);
+      MPI_Comm_size(comm, &size);
+
+      int const readers = (size > 1) ? size - 1 : 1;
+      std::vector<unsigned long> availableIds;
+      std::vector<Value> availableValues;
+      if (rank < readers) {
+        unsigned long const first = numberOfIds * rank / readers;
+        unsigned long const last = numberOfIds * (rank + 1) / readers;
+        for (unsigned long id = first; id < last; ++id) {
+          availableIds.push_back(id);
+          availableValues.push_back(value(id));
+        }
+      }
+
+      // the required ids contain duplicates and invalid entries
+      std::vector<unsigned long> requiredIds;
+      if (size == 1 || rank > 0) {
+        int const requirers = (size > 1) ? size - 1 : 1;
+        int const requirer = (size > 1) ? rank - 1 : 0;
+        for (unsigned long id = numberOfIds; id-- > 0; ) {
+          if (static_cast<int>(id % requirers) == requirer) {
+            requiredIds.push_back(id);
+          }
+        }
+        requiredIds.push_back(requiredIds.front());
+        requiredIds.push_back(seissol::checkpoint::Redistributor::INVALID_ID);
+      }
+
+      Value const untouched = {{-1.0, -1.0, -1.0}};
+      std::vector<Value> requiredValues(requiredIds.size(), untouched);
+
+      seissol::checkpoint::Redistributor redistributor(comm);
+      unsigned long missing = redistributor.redistribute(sizeof(Value),
+        availableIds.size(), availableIds.data(), availableValues.data(),
+        requiredIds.size(), requiredIds.data(), requiredValues.data());
+      TS_ASSERT_EQUALS(missing, 0ul);
+
+      for (unsigned i = 0; i < requiredIds.size(); ++i) {
+        Value const expected = (requiredIds[i] == seissol::checkpoint::Redistributor::INVALID_ID) ? untouched : value(requiredIds[i]);
+        for (unsigned j = 0; j < 3; ++j) {
+          TS_ASSERT_EQUALS(requiredValues[i].x[j], expected.x[j]);
+        }
+      }
+
+      // ids which are not available on any rank are counted on all ranks
+      std::vector<unsigned long> unknownIds(rank + 1, numberOfIds + rank);
+      std::vector<Value> unknownValues(unknownIds.size(), untouched);
+      missing = redistributor.redistribute(sizeof(Value),
+        availableIds.size(), availableIds.data(), availableValues.data(),
+        unknownIds.size(), unknownIds.data(), unknownValues.data());
+      TS_ASSERT_EQUALS(missing, static_cast<unsigned long>(size * (size + 1) / 2));
+      TS_ASSERT_EQUALS(unknownValues[0].x[0], untouched.x[0]);
+    }
+#endif
+
+  public:
+    void testRedistribute()
+    {
+#ifdef USE_MPI
+      int const rank = seissol::MPI::mpi.rank();
+      int const size = seissol::MPI::mpi.size();
+
+      // all numbers of ranks up to the size of the test
+      for (int ranks = 1; ranks <= size; ++ranks) {
+        MPI_Comm comm;
+        MPI_Comm_split(seissol::MPI::mpi.comm(), (rank < ranks) ? 0 : MPI_UNDEFINED, rank, &comm);
+        if (comm != MPI_COMM_NULL) {
+          redistribute(comm);
+          MPI_Comm_free(&comm);
+        }
+      }
+#endif
+    }
+};
@@ -26,4 +26,65 @@ namespace seissol
 
       }
   };
+
+  /** Unit cubes in [0,n]^3, each split into 6 positively oriented tetrahedra */
+  class GridMockReader : public MeshReader
+  {
+    public:
+      GridMockReader(int n) : MeshReader(0) {
+        auto vertex = [n](int x, int y, int z) { return (z * (n+1) + y) * (n+1) + x; };
+
+        m_vertices.resize((n+1) * (n+1) * (n+1));
+        for (int z = 0; z <= n; z++) {
+          for (int y = 0; y <= n; y++) {
+            for (int x = 0; x <= n; x++) {
+              m_vertices.at(vertex(x, y, z)).coords[0] = x;
+              m_vertices.at(vertex(x, y, z)).coords[1] = y;
+              m_vertices.at(vertex(x, y, z)).coords[2] = z;
+            }
+          }
+        }
+
+        // Paths from (0,0,0) to (1,1,1) along the axes
+        const int paths[6][3] = {{0, 1, 2}, {0, 2, 1}, {1, 0, 2}, {1, 2, 0}, {2, 0, 1}, {2, 1, 0}};
+        for (int z = 0; z < n; z++) {
+          for (int y = 0; y < n; y++) {
+            for (int x = 0; x < n; x++) {
+              for (auto const& path : paths) {
+                int corner[3] = {x, y, z};
+                Element element;
+                element.material = 0;
+                element.vertices[0] = vertex(corner[0], corner[1], corner[2]);
+                for (int i = 0; i < 3; i++) {
+                  corner[path[i]]++;
+                  element.vertices[i+1] = vertex(corner[0], corner[1], corner[2]);
+                }
+
+                Eigen::Vector3d v[4];
+                for (int i = 0; i < 4; i++) {
+                  v[i] = Eigen::Map<const Eigen::Vector3d>(m_vertices.at(element.vertices[i]).coords);
+                }
+                if ((v[1] - v[0]).cross(v[2] - v[0]).dot(v[3] - v[0]) < 0) {
+                  std::swap(element.vertices[1], element.vertices[2]);
+                }
+                m_elements.push_back(element);
+              }
+            }
+          }
+        }
+      }
+
+      void setMaterial(int element, int material) {
+        m_elements.at(element).material = material;
+      }
+
+      void addFault(int element, int side) {
+        Fault fault;
+        fault.element = element;
+        fault.side = side;
+        fault.neighborElement = -1;
+        fault.neighborSide = -1;
+        m_fault.push_back(fault);
+      }
+  };
 }
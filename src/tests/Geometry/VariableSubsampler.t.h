@@ -1,6 +1,7 @@
 #include <array>
 #include <iostream>
 #include <iomanip>
+#include <vector>
 
 #include <cxxtest/TestSuite.h>
 #include <Eigen/Dense>
@@ -84,4 +85,39 @@ class seissol::unit_test::VariableSubsamplerTestSuite : public CxxTest::TestSuit
         TS_ASSERT_DELTA(outDofs[i], expectedDOFs[i], epsilon);
       }
     };
+
+    void testFusedDivideBy32() {
+      std::srand(4321);
+      seissol::refinement::DivideTetrahedronBy32<double> refineBy32;
+      // more cells than one block, order 4 with 20 basis functions aligned to 24 DOFs
+      const unsigned int numCells = 37;
+      seissol::refinement::VariableSubsampler<double> subsampler(numCells, refineBy32, 4, 9, 24);
+
+      std::vector<double> dofs(numCells * 9 * 24);
+      for (auto& dof : dofs) {
+        dof = (double)std::rand()/RAND_MAX;
+      }
+      std::vector<unsigned int> cellMap(numCells);
+      for (unsigned int cell = 0; cell < numCells; cell++) {
+        cellMap[cell] = (cell * 5) % numCells;
+      }
+
+      std::vector<std::vector<double>> expected(9, std::vector<double>(numCells * 32));
+      std::vector<std::vector<double>> fused(9, std::vector<double>(numCells * 32, 0.0));
+      std::vector<double*> outData(9, nullptr);
+      for (unsigned int var = 0; var < 9; var++) {
+        subsampler.get(dofs.data(), cellMap.data(), var, expected[var].data());
+        // skip some variables
+        if (var % 3 != 1) {
+          outData[var] = fused[var].data();
+        }
+      }
+      subsampler.get(dofs.data(), cellMap.data(), outData.data());
+
+      for (unsigned int var = 0; var < 9; var++) {
+        for (unsigned int i = 0; i < numCells * 32; i++) {
+          TS_ASSERT_DELTA(fused[var][i], (var % 3 != 1) ? expected[var][i] : 0.0, 1e-12);
+        }
+      }
+    };
 }; 
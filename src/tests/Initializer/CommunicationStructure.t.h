@@ -0,0 +1,175 @@
+#include <cxxtest/TestSuite.h>
+
+#include <Initializer/MemoryManager.h>
+#include <Parallel/MPI.h>
+#include <Solver/time_stepping/TimeCluster.h>
+
+#include <vector>
+
+namespace seissol {
+  namespace unit_test {
+    class CommunicationStructureTestSuite;
+  }
+}
+
+class seissol::unit_test::CommunicationStructureTestSuite : public CxxTest::TestSuite
+{
+#ifdef USE_MPI
+  private:
+    /**
+     * Two regions per rank on a ring: region 0 exchanges with the left neighbor, region 1 with the right neighbor.
+     * The copy regions have different sizes, such that a mismatch of the regions yields a truncated message.
+     */
+    static constexpr unsigned copyRegionSizes[2] = {3, 5};
+
+    MeshStructure meshStructure{};
+    int neighboringClusters[2][2];
+    unsigned ghostRegionSizes[2];
+    unsigned copySizes[2];
+    int sendIdentifiers[2];
+    int receiveIdentifiers[2];
+    MPI_Request sendRequests[2];
+    MPI_Request receiveRequests[2];
+    real* ghostRegions[2];
+    comm_real* ghostRegionMessages[2];
+    comm_real* copyRegionMessages[2];
+    std::vector<real> ghostRegionData[2];
+    std::vector<comm_real> ghostMessageData[2];
+    std::vector<comm_real> copyMessageData[2];
+    std::vector<int> completedRequests;
+    int rank;
+    int size;
+
+    static comm_real value(int rank, unsigned region, unsigned i, unsigned step) {
+      return 1000.0 * rank + 100.0 * region + 10.0 * step + i;
+    }
+
+    int neighbor(unsigned region) const {
+      return (region == 0) ? (rank + size - 1) % size : (rank + 1) % size;
+    }
+
+    void fillCopyRegions(unsigned step) {
+      for (unsigned region = 0; region < 2; ++region) {
+        for (unsigned i = 0; i < copySizes[region]; ++i) {
+          copyRegionMessages[region][i] = value(rank, region, i, step);
+        }
+      }
+    }
+
+    //! The ghost region 0 holds the copy region 1 of the left neighbor and vice versa
+    void checkGhostRegion(unsigned region, unsigned step) {
+      for (unsigned i = 0; i < ghostRegionSizes[region]; ++i) {
+        TS_ASSERT_EQUALS(static_cast<real>(value(neighbor(region), 1 - region, i, step)), ghostRegions[region][i]);
+      }
+    }
+
+    void checkFreed() {
+      for (unsigned region = 0; region < 2; ++region) {
+        TS_ASSERT(sendRequests[region] == MPI_REQUEST_NULL);
+        TS_ASSERT(receiveRequests[region] == MPI_REQUEST_NULL);
+      }
+    }
+
+    //! Completes the started requests the way the time clusters do
+    void complete(unsigned pendingSends, unsigned pendingReceives) {
+      bool sendsComplete = false;
+      bool receivesComplete = false;
+      while (!sendsComplete || !receivesComplete) {
+        sendsComplete = seissol::time_stepping::TimeCluster::testForCompletion(meshStructure, sendRequests, pendingSends, completedRequests, false);
+        receivesComplete = seissol::time_stepping::TimeCluster::testForCompletion(meshStructure, receiveRequests, pendingReceives, completedRequests, true);
+      }
+      TS_ASSERT_EQUALS(0u, pendingSends);
+      TS_ASSERT_EQUALS(0u, pendingReceives);
+    }
+#endif
+
+  public:
+    void setUp() {
+#ifdef USE_MPI
+      MPI_Comm_rank(seissol::MPI::mpi.comm(), &rank);
+      MPI_Comm_size(seissol::MPI::mpi.comm(), &size);
+
+      for (unsigned region = 0; region < 2; ++region) {
+        neighboringClusters[region][0] = neighbor(region);
+        neighboringClusters[region][1] = 0;
+        copySizes[region] = copyRegionSizes[region];
+        ghostRegionSizes[region] = copyRegionSizes[1 - region];
+        // the left neighbor sends with identifier 1 to its right neighbor and vice versa
+        sendIdentifiers[region] = region;
+        receiveIdentifiers[region] = 1 - region;
+        sendRequests[region] = MPI_REQUEST_NULL;
+        receiveRequests[region] = MPI_REQUEST_NULL;
+
+        ghostMessageData[region].assign(ghostRegionSizes[region], 0.0);
+        copyMessageData[region].assign(copySizes[region], 0.0);
+        ghostRegionMessages[region] = ghostMessageData[region].data();
+        copyRegionMessages[region] = copyMessageData[region].data();
+#ifdef USE_SINGLE_PRECISION_COMMUNICATION
+        ghostRegionData[region].assign(ghostRegionSizes[region], 0.0);
+        ghostRegions[region] = ghostRegionData[region].data();
+#else
+        ghostRegions[region] = ghostRegionMessages[region];
+#endif
+      }
+
+      meshStructure.numberOfRegions = 2;
+      meshStructure.neighboringClusters = neighboringClusters;
+      meshStructure.ghostRegions = ghostRegions;
+      meshStructure.ghostRegionSizes = ghostRegionSizes;
+      meshStructure.copyRegionSizes = copySizes;
+      meshStructure.sendIdentifiers = sendIdentifiers;
+      meshStructure.receiveIdentifiers = receiveIdentifiers;
+      meshStructure.sendRequests = sendRequests;
+      meshStructure.receiveRequests = receiveRequests;
+      meshStructure.ghostRegionMessages = ghostRegionMessages;
+      meshStructure.copyRegionMessages = copyRegionMessages;
+
+      completedRequests.resize(meshStructure.numberOfRegions);
+#endif
+    }
+
+    //! Requests which have never been started are freed
+    void testFreeInactiveRequests()
+    {
+#ifdef USE_MPI
+      seissol::initializers::initializePersistentRequests(meshStructure, seissol::MPI::mpi.comm());
+      for (unsigned region = 0; region < 2; ++region) {
+        TS_ASSERT(sendRequests[region] != MPI_REQUEST_NULL);
+        TS_ASSERT(receiveRequests[region] != MPI_REQUEST_NULL);
+      }
+      seissol::initializers::freePersistentRequests(meshStructure);
+      checkFreed();
+#endif
+    }
+
+    //! The requests are started repeatedly; the requests, which are not started in a step, are ignored
+    void testRestartRequests()
+    {
+#ifdef USE_MPI
+      seissol::initializers::initializePersistentRequests(meshStructure, seissol::MPI::mpi.comm());
+
+      // step 0: only the messages to the right neighbor, i.e. sends of region 1 and receives of region 0
+      fillCopyRegions(0);
+      MPI_Start(receiveRequests + 0);
+      MPI_Start(sendRequests + 1);
+      complete(1, 1);
+      checkGhostRegion(0, 0);
+
+      // steps 1 and 2: all regions
+      for (unsigned step = 1; step < 3; ++step) {
+        fillCopyRegions(step);
+        for (unsigned region = 0; region < 2; ++region) {
+          MPI_Start(receiveRequests + region);
+          MPI_Start(sendRequests + region);
+        }
+        complete(2, 2);
+        checkGhostRegion(0, step);
+        checkGhostRegion(1, step);
+      }
+
+      // all requests are inactive after the completion and are freed before MPI_Finalize
+      seissol::initializers::freePersistentRequests(meshStructure);
+      checkFreed();
+#endif
+    }
+};
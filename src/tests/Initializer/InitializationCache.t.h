@@ -0,0 +1,78 @@
+#include <cxxtest/TestSuite.h>
+
+#include <cstdlib>
+#include <vector>
+
+#include "Initializer/InitializationCache.h"
+
+namespace seissol {
+  namespace unit_test {
+    class InitializationCacheTestSuite;
+  }
+}
+
+class seissol::unit_test::InitializationCacheTestSuite : public CxxTest::TestSuite
+{
+  public:
+    void setUp()
+    {
+      setenv("SEISSOL_INIT_CACHE", "Testing/initializationCache", 1);
+    }
+
+    void tearDown()
+    {
+      unsetenv("SEISSOL_INIT_CACHE");
+    }
+
+    void testHash()
+    {
+      using seissol::initializers::InitializationCache;
+      TS_ASSERT_EQUALS(InitializationCache::hash(nullptr, 0), 14695981039346656037ull);
+      TS_ASSERT_EQUALS(InitializationCache::hash("a", 1), 0xaf63dc4c8601ec8cull);
+      // hashing in parts equals hashing at once
+      TS_ASSERT_EQUALS(InitializationCache::hash("ab", 2), InitializationCache::hash("b", 1, InitializationCache::hash("a", 1)));
+    }
+
+    void testDisabled()
+    {
+      unsetenv("SEISSOL_INIT_CACHE");
+      seissol::initializers::InitializationCache cache;
+      cache.setUp("Testing/mesh.h5", "Testing/material.yaml", 2, false);
+      TS_ASSERT(!cache.enabled());
+
+      std::vector<double> values;
+      TS_ASSERT(!cache.read("values", 42, values));
+    }
+
+    void testReadWrite()
+    {
+      std::vector<double> const expected = {1.0, 2.5, -3.0};
+
+      seissol::initializers::InitializationCache cache;
+      cache.setUp("Testing/mesh.h5", "Testing/material.yaml", 2, false);
+      TS_ASSERT(cache.enabled());
+      cache.write("values", 42, expected);
+
+      std::vector<double> values;
+      TS_ASSERT(cache.read("values", 42, values));
+      TS_ASSERT_EQUALS(values, expected);
+
+      // different input on this rank
+      TS_ASSERT(!cache.read("values", 43, values));
+      // different type
+      std::vector<float> floats;
+      TS_ASSERT(!cache.read("values", 42, floats));
+      // missing entry
+      TS_ASSERT(!cache.read("others", 42, values));
+
+      // different configuration
+      seissol::initializers::InitializationCache otherCache;
+      otherCache.setUp("Testing/mesh.h5", "Testing/material.yaml", 3, false);
+      TS_ASSERT(!otherCache.read("values", 42, values));
+
+      // different physics
+      seissol::initializers::InitializationCache plasticCache;
+      plasticCache.setUp("Testing/mesh.h5", "Testing/material.yaml", 2, true);
+      TS_ASSERT(!plasticCache.read("values", 42, values));
+    }
+};
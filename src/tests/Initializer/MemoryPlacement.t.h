@@ -0,0 +1,126 @@
+#include <cxxtest/TestSuite.h>
+
+#include <Initializer/MemoryAllocator.h>
+#include <Parallel/Partition.h>
+
+#include <algorithm>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace seissol {
+  namespace unit_test {
+    class MemoryPlacementTestSuite;
+  }
+}
+
+class seissol::unit_test::MemoryPlacementTestSuite : public CxxTest::TestSuite
+{
+  private:
+    static constexpr unsigned maxNumberOfThreads = 7;
+    static constexpr unsigned numberOfCellCounts = 6;
+    static constexpr unsigned cellCounts[numberOfCellCounts] = {0, 1, 3, 7, 97, 1000};
+
+    //! Cells of each thread of a team with numberOfThreads threads, as used by the compute loops
+    static std::vector<std::pair<unsigned, unsigned>> computePartition(unsigned numberOfCells, unsigned numberOfThreads) {
+      std::vector<std::pair<unsigned, unsigned>> partition(numberOfThreads, std::make_pair(0u, 0u));
+#ifdef _OPENMP
+      #pragma omp parallel num_threads(numberOfThreads)
+#endif
+      {
+        unsigned thread = 0;
+#ifdef _OPENMP
+        thread = omp_get_thread_num();
+#endif
+        seissol::parallel::staticPartition(numberOfCells, partition[thread].first, partition[thread].second);
+      }
+      return partition;
+    }
+
+    static unsigned numberOfThreads(unsigned requested) {
+#ifdef _OPENMP
+      return requested;
+#else
+      return 1;
+#endif
+    }
+
+  public:
+    //! The threads get contiguous, balanced and ascending ranges of cells
+    void testStaticPartition()
+    {
+      for (unsigned numberOfCells : cellCounts) {
+        for (unsigned requested = 1; requested <= maxNumberOfThreads; ++requested) {
+          unsigned const threads = numberOfThreads(requested);
+          auto partition = computePartition(numberOfCells, threads);
+          TS_ASSERT_EQUALS(0u, partition[0].first);
+          TS_ASSERT_EQUALS(numberOfCells, partition[threads - 1].second);
+          for (unsigned thread = 0; thread < threads; ++thread) {
+            unsigned const cells = partition[thread].second - partition[thread].first;
+            TS_ASSERT(cells == numberOfCells / threads || cells == numberOfCells / threads + 1);
+            if (thread > 0) {
+              TS_ASSERT_EQUALS(partition[thread - 1].second, partition[thread].first);
+            }
+          }
+        }
+      }
+    }
+
+    //! The first touch of a thread covers exactly the variables of the cells it computes
+    void testFirstTouchMatchesComputePartition()
+    {
+      size_t const cellSizes[] = {8, 72, 4096 + 24};
+      for (unsigned numberOfCells : cellCounts) {
+        if (numberOfCells == 0) {
+          continue;
+        }
+        for (size_t cellSize : cellSizes) {
+          size_t const size = numberOfCells * cellSize;
+          for (unsigned requested = 1; requested <= maxNumberOfThreads; ++requested) {
+            auto partition = computePartition(numberOfCells, numberOfThreads(requested));
+            for (auto const& cells : partition) {
+              TS_ASSERT_EQUALS(cells.first * cellSize, seissol::memory::cellOffset(size, numberOfCells, cells.first));
+              TS_ASSERT_EQUALS(cells.second * cellSize, seissol::memory::cellOffset(size, numberOfCells, cells.second));
+            }
+          }
+        }
+      }
+    }
+
+    //! Memory which is not a multiple of the number of cells (e.g. buckets) is split without gaps
+    void testCellOffsets()
+    {
+      size_t const sizes[] = {1, 5, 1001, 4096 * 3 + 17};
+      for (unsigned numberOfCells : cellCounts) {
+        if (numberOfCells == 0) {
+          continue;
+        }
+        for (size_t size : sizes) {
+          TS_ASSERT_EQUALS(0u, seissol::memory::cellOffset(size, numberOfCells, 0));
+          TS_ASSERT_EQUALS(size, seissol::memory::cellOffset(size, numberOfCells, numberOfCells));
+          for (unsigned cell = 0; cell < numberOfCells; ++cell) {
+            size_t const begin = seissol::memory::cellOffset(size, numberOfCells, cell);
+            size_t const end = seissol::memory::cellOffset(size, numberOfCells, cell + 1);
+            TS_ASSERT(begin <= end);
+            TS_ASSERT(end - begin <= size / numberOfCells + 1);
+          }
+        }
+      }
+    }
+
+    //! All bytes are zeroed, with the compute partition and with interleaved pages
+    void testTouch()
+    {
+      size_t const size = 5 * seissol::memory::pageSize() + 123;
+      std::vector<char> memory(size);
+      for (unsigned numberOfCells : {1u, 7u, 97u}) {
+        for (bool interleave : {false, true}) {
+          std::fill(memory.begin(), memory.end(), 1);
+          seissol::memory::touch(memory.data(), size, numberOfCells, interleave);
+          TS_ASSERT(std::all_of(memory.begin(), memory.end(), [](char value) { return value == 0; }));
+        }
+      }
+    }
+};
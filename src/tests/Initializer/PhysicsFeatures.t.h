@@ -0,0 +1,80 @@
+#include <cxxtest/TestSuite.h>
+
+#include <Initializer/LTS.h>
+#include <Initializer/MemoryManager.h>
+#include <Initializer/PhysicsFeatures.h>
+#include <Initializer/tree/LTSTree.hpp>
+#include <ResultWriter/PostProcessor.h>
+
+namespace seissol {
+  namespace unit_test {
+    class PhysicsFeaturesTestSuite;
+  }
+}
+
+class seissol::unit_test::PhysicsFeaturesTestSuite : public CxxTest::TestSuite
+{
+  private:
+    //! Registers and allocates the variables of a tree with one cluster for the features
+    static void allocate( seissol::initializers::LTSTree& tree,
+                          seissol::initializers::LTS& lts,
+                          seissol::writer::PostProcessor& postProcessor,
+                          seissol::initializers::PhysicsFeatures const& features ) {
+      seissol::initializers::MemoryManager::addLtsVariables(tree, lts, postProcessor, features);
+      tree.setNumberOfTimeClusters(1);
+      tree.fixate();
+      tree.child(0).child<Ghost>().setNumberOfCells(2);
+      tree.child(0).child<Copy>().setNumberOfCells(3);
+      tree.child(0).child<Interior>().setNumberOfCells(5);
+      tree.allocateVariables();
+    }
+
+  public:
+    void testPlasticityStorage()
+    {
+      for (bool plasticity : {false, true}) {
+        seissol::initializers::LTSTree tree;
+        seissol::initializers::LTS lts;
+        seissol::writer::PostProcessor postProcessor;
+        seissol::initializers::PhysicsFeatures features;
+        features.plasticity = plasticity;
+        allocate(tree, lts, postProcessor, features);
+
+        auto& cluster = tree.child(0);
+        TS_ASSERT(cluster.child<Ghost>().var(lts.plasticity) == nullptr);
+        TS_ASSERT(cluster.child<Ghost>().var(lts.pstrain) == nullptr);
+        TS_ASSERT_EQUALS(cluster.child<Copy>().var(lts.plasticity) != nullptr, plasticity);
+        TS_ASSERT_EQUALS(cluster.child<Copy>().var(lts.pstrain) != nullptr, plasticity);
+        TS_ASSERT_EQUALS(cluster.child<Interior>().var(lts.plasticity) != nullptr, plasticity);
+        TS_ASSERT_EQUALS(cluster.child<Interior>().var(lts.pstrain) != nullptr, plasticity);
+
+        // the other variables do not depend on the feature
+        TS_ASSERT(cluster.child<Copy>().var(lts.dofs) != nullptr);
+        TS_ASSERT(cluster.child<Interior>().var(lts.dofs) != nullptr);
+      }
+    }
+
+    void testIntegralsRegistration()
+    {
+      int integrationMask[9] = {0, 0, 0, 0, 0, 0, 1, 1, 1};
+
+      seissol::initializers::LTSTree elasticTree;
+      seissol::initializers::LTS elasticLts;
+      seissol::writer::PostProcessor elasticPostProcessor;
+      elasticPostProcessor.setIntegrationMask(integrationMask);
+      allocate(elasticTree, elasticLts, elasticPostProcessor, seissol::initializers::PhysicsFeatures());
+
+      seissol::initializers::LTSTree tree;
+      seissol::initializers::LTS lts;
+      seissol::writer::PostProcessor postProcessor;
+      postProcessor.setIntegrationMask(integrationMask);
+      seissol::initializers::PhysicsFeatures features;
+      features.integrateQuantities = true;
+      allocate(tree, lts, postProcessor, features);
+
+      // the integrals are the only additional variable
+      TS_ASSERT_EQUALS(tree.getNumberOfVariables(), elasticTree.getNumberOfVariables() + 1);
+      TS_ASSERT(postProcessor.getIntegrals(&tree) != nullptr);
+      TS_ASSERT_EQUALS(tree.info(tree.getNumberOfVariables() - 1).bytes, 3 * sizeof(real));
+    }
+};
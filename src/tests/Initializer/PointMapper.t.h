@@ -3,6 +3,7 @@
 
 #include "tests/Geometry/MockReader.h"
 #include "Initializer/PointMapper.h"
+#include "Geometry/MeshTools.h"
 
 namespace unit_tests {
   class PointMapperTestSuite;
@@ -50,5 +51,95 @@ class unit_tests::PointMapperTestSuite: public CxxTest::TestSuite {
         TS_ASSERT_EQUALS(contained[i], expectedContained[i]);
         TS_ASSERT_EQUALS(meshId[i], expectedMeshId[i]);
       }
-  };
+    }
+
+    void testFindMeshIdsGrid() {
+      const seissol::GridMockReader mockReader(4);
+      auto const& elements = mockReader.getElements();
+      auto const& vertices = mockReader.getVertices();
+
+      // Random points inside and outside of the mesh and a grid with spacing 0.5,
+      // which includes the vertices and points on the edges and faces
+      std::vector<Eigen::Vector3d> points;
+      for (int i = 0; i < 200; i++) {
+        points.push_back(Eigen::Vector3d(-0.5 + 5.0*std::rand()/RAND_MAX, -0.5 + 5.0*std::rand()/RAND_MAX, -0.5 + 5.0*std::rand()/RAND_MAX));
+      }
+      for (int z = -1; z <= 9; z++) {
+        for (int y = -1; y <= 9; y++) {
+          for (int x = -1; x <= 9; x++) {
+            points.push_back(0.5 * Eigen::Vector3d(x, y, z));
+          }
+        }
+      }
+
+      std::vector<short> contained(points.size());
+      std::vector<unsigned> meshIds(points.size(), std::numeric_limits<unsigned>::max());
+      seissol::initializers::findMeshIds(points.data(), mockReader, points.size(), contained.data(), meshIds.data());
+
+      // Compare with the smallest element that contains the point
+      for (unsigned i = 0; i < points.size(); i++) {
+        unsigned expectedMeshId = std::numeric_limits<unsigned>::max();
+        for (unsigned elem = 0; elem < elements.size() && expectedMeshId == std::numeric_limits<unsigned>::max(); elem++) {
+          if (MeshTools::inside(elements[elem], vertices, points[i].data())) {
+            expectedMeshId = elem;
+          }
+        }
+
+        TS_ASSERT_EQUALS(contained[i], (expectedMeshId != std::numeric_limits<unsigned>::max()) ? 1 : 0);
+        TS_ASSERT_EQUALS(meshIds[i], expectedMeshId);
+      }
+    }
+
+    void testFindFaultIds() {
+      seissol::GridMockReader mockReader(2);
+      mockReader.addFault(-1, 0);
+      mockReader.addFault(5, 0);
+      mockReader.addFault(42, 1);
+      mockReader.addFault(5, 2);
+      auto const& elements = mockReader.getElements();
+      auto const& vertices = mockReader.getVertices();
+
+      VrtxCoords centre5, centre42;
+      MeshTools::center(elements[5], vertices, centre5);
+      MeshTools::center(elements[42], vertices, centre42);
+      // Slightly outside of the mesh at the corner (2,2,2) of element 42
+      Eigen::Vector3d corner(2.0, 2.0, 2.0);
+      Eigen::Vector3d outside = corner + 1.0e-7 * (corner - Eigen::Vector3d(centre42[0], centre42[1], centre42[2]));
+
+      const Eigen::Vector3d points[4] = {
+        Eigen::Vector3d(centre5[0], centre5[1], centre5[2]),
+        Eigen::Vector3d(centre42[0], centre42[1], centre42[2]),
+        outside,
+        Eigen::Vector3d(1.9, 0.1, 1.9)
+      };
+      int faultIds[4];
+      seissol::initializers::findFaultIds(points, mockReader, 4, 1.0e-5, faultIds);
+
+      TS_ASSERT_EQUALS(faultIds[0], 1);
+      TS_ASSERT_EQUALS(faultIds[1], 2);
+      TS_ASSERT_EQUALS(faultIds[2], 2);
+      TS_ASSERT_EQUALS(faultIds[3], -1);
+    }
+
+    void testFindFaultIdsTolerance() {
+      seissol::GridMockReader mockReader(2);
+      mockReader.addFault(42, 0);
+      auto const& elements = mockReader.getElements();
+      auto const& vertices = mockReader.getVertices();
+
+      // Barycentric coordinates (1 + 3t, -t, -t, -t) at the corner (2,2,2) of element 42 lie up to
+      // 3t times the element extent outside of its bounding box
+      double const tolerance = 0.1;
+      double const t = 0.99 * tolerance;
+      Eigen::Vector3d point(0.0, 0.0, 0.0);
+      for (int i = 0; i < 4; i++) {
+        Eigen::Vector3d vertex(vertices[elements[42].vertices[i]].coords);
+        bool const corner = (vertex - Eigen::Vector3d(2.0, 2.0, 2.0)).norm() < epsilon;
+        point += (corner ? 1.0 + 3.0 * t : -t) * vertex;
+      }
+
+      int faultId;
+      seissol::initializers::findFaultIds(&point, mockReader, 1, tolerance, &faultId);
+      TS_ASSERT_EQUALS(faultId, 0);
+    }
 };
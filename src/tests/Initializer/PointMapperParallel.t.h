@@ -0,0 +1,76 @@
+#include <cxxtest/TestSuite.h>
+
+#include <Initializer/PointMapper.h>
+#include <Parallel/MPI.h>
+
+#include <vector>
+
+namespace seissol {
+  namespace unit_test {
+    class PointMapperParallelTestSuite;
+  }
+}
+
+class seissol::unit_test::PointMapperParallelTestSuite : public CxxTest::TestSuite
+{
+  private:
+    static constexpr unsigned long numberOfPoints = 100;
+
+    //! Rank r knows the points whose id is divisible by r+1, the last rank knows none
+    static bool knows(int rank, int size, unsigned long id) {
+      if (size > 1 && rank == size - 1) {
+        return false;
+      }
+      return id % (rank + 1) == 0;
+    }
+
+    static bool contains(int rank, unsigned long id) {
+      return (id + rank) % 3 != 0;
+    }
+
+  public:
+    void testCleanDoublesWithIds()
+    {
+#ifdef USE_MPI
+      int const rank = seissol::MPI::mpi.rank();
+      int const size = seissol::MPI::mpi.size();
+
+      // the ids are not sorted
+      std::vector<unsigned long> ids;
+      std::vector<short> contained;
+      for (unsigned long id = numberOfPoints; id-- > 0;) {
+        if (knows(rank, size, id)) {
+          ids.push_back(id);
+          contained.push_back(contains(rank, id) ? 1 : 0);
+        }
+      }
+
+      seissol::initializers::cleanDoubles(contained.data(), ids.data(), ids.size());
+
+      // the lowest rank that contains the point keeps it
+      for (unsigned point = 0; point < ids.size(); ++point) {
+        int owner = size;
+        for (int r = 0; r < size && owner == size; ++r) {
+          if (knows(r, size, ids[point]) && contains(r, ids[point])) {
+            owner = r;
+          }
+        }
+        TS_ASSERT_EQUALS(contained[point], (owner == rank) ? 1 : 0);
+      }
+
+      // every contained point is kept exactly once
+      std::vector<int> kept(numberOfPoints, 0);
+      for (unsigned point = 0; point < ids.size(); ++point) {
+        kept[ids[point]] = contained[point];
+      }
+      MPI_Allreduce(MPI_IN_PLACE, kept.data(), numberOfPoints, MPI_INT, MPI_SUM, seissol::MPI::mpi.comm());
+      for (unsigned long id = 0; id < numberOfPoints; ++id) {
+        bool containedSomewhere = false;
+        for (int r = 0; r < size; ++r) {
+          containedSomewhere |= knows(r, size, id) && contains(r, id);
+        }
+        TS_ASSERT_EQUALS(kept[id], containedSomewhere ? 1 : 0);
+      }
+#endif // USE_MPI
+    }
+};
@@ -0,0 +1,74 @@
+#include <cxxtest/TestSuite.h>
+
+#include "Initializer/time_stepping/CellOrdering.h"
+
+#include <cstdlib>
+#include <set>
+
+namespace seissol {
+  namespace unit_test {
+    class CellOrderingTestSuite;
+  }
+}
+
+class seissol::unit_test::CellOrderingTestSuite : public CxxTest::TestSuite
+{
+  public:
+    void testHilbertIndex()
+    {
+      // the curve visits every cell of a 4x4x4 grid once, moving to a face neighbour in every step
+      std::vector<std::array<std::uint32_t, 3>> cells(64);
+      for (std::uint32_t x = 0; x < 4; ++x) {
+        for (std::uint32_t y = 0; y < 4; ++y) {
+          for (std::uint32_t z = 0; z < 4; ++z) {
+            std::array<std::uint32_t, 3> coordinates = {x, y, z};
+            std::uint64_t index = seissol::initializers::time_stepping::CellOrdering::hilbertIndex(coordinates, 2);
+            TS_ASSERT(index < 64);
+            cells[index] = coordinates;
+          }
+        }
+      }
+      std::set<std::array<std::uint32_t, 3>> visited(cells.begin(), cells.end());
+      TS_ASSERT_EQUALS(visited.size(), 64);
+      for (unsigned i = 1; i < cells.size(); ++i) {
+        int distance = 0;
+        for (unsigned d = 0; d < 3; ++d) {
+          distance += std::abs(static_cast<int>(cells[i][d]) - static_cast<int>(cells[i-1][d]));
+        }
+        TS_ASSERT_EQUALS(distance, 1);
+      }
+    }
+
+    void testHilbert()
+    {
+      // a line of points in reverse order
+      std::vector<std::array<double, 3>> points;
+      for (int i = 9; i >= 0; --i) {
+        points.push_back({0.5, 0.5, static_cast<double>(i)});
+      }
+      auto order = seissol::initializers::time_stepping::CellOrdering::hilbert(points);
+      TS_ASSERT_EQUALS(order.size(), 10);
+      for (unsigned i = 1; i < order.size(); ++i) {
+        TS_ASSERT_EQUALS(std::abs(static_cast<int>(order[i]) - static_cast<int>(order[i-1])), 1);
+      }
+    }
+
+    void testReverseCuthillMcKee()
+    {
+      // a chain 0 - 2 - 4 - 1 - 3 and an isolated cell 5
+      std::vector<std::array<int, 4>> neighbors = { {2, -1, -1, -1},
+                                                    {4, 3, -1, -1},
+                                                    {0, 4, -1, -1},
+                                                    {-1, 1, -1, -1},
+                                                    {2, -1, 1, -1},
+                                                    {-1, -1, -1, -1} };
+      auto order = seissol::initializers::time_stepping::CellOrdering::reverseCuthillMcKee(neighbors);
+      TS_ASSERT_EQUALS(order.size(), 6);
+      std::set<unsigned> cells(order.begin(), order.end());
+      TS_ASSERT_EQUALS(cells.size(), 6);
+
+      TS_ASSERT_DELTA(seissol::initializers::time_stepping::CellOrdering::meanNeighborDistance(neighbors, order), 1.0, 1.0e-12);
+      std::vector<unsigned> identity = {0, 1, 2, 3, 4, 5};
+      TS_ASSERT(seissol::initializers::time_stepping::CellOrdering::meanNeighborDistance(neighbors, identity) > 1.0);
+    }
+};
@@ -1,5 +1,9 @@
 #include <cxxtest/TestSuite.h>
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+
 #include "Geometry/PUMLReader.h"
 #include "Initializer/time_stepping/LtsWeights.h"
 
@@ -29,4 +33,71 @@ class seissol::unit_test::LTSWeightsTestSuite : public CxxTest::TestSuite
       }
     }
 
+    void testMaterialRedistribution()
+    {
+      std::cout.setstate(std::ios_base::failbit);
+      seissol::initializers::time_stepping::LtsWeights ltsWeights("Testing/material.yaml", 2);
+      PUMLReader pumlReader("Testing/mesh.h5", "", &ltsWeights);
+      std::cout.clear();
+
+      // the material was evaluated for the original cells and moved to the partitioned cells
+      TS_ASSERT_EQUALS(pumlReader.getMaterialLayout(), MaterialLayout::Elastic);
+      TS_ASSERT_EQUALS(pumlReader.getNumberOfMaterialValues(), 5u);
+      auto const& elements = pumlReader.getElements();
+      auto const& vertices = pumlReader.getVertices();
+      auto const& values = pumlReader.getMaterialValues();
+      TS_ASSERT_EQUALS(values.size(), 5 * elements.size());
+
+      for (unsigned elem = 0; elem < elements.size(); elem++) {
+        VrtxCoords centre;
+        MeshTools::center(elements[elem], vertices, centre);
+        // see material.yaml
+        bool const lower = centre[1] <= 0.5;
+        double const rho = lower ? 2500.0 : 1000.0;
+        double const mu = lower ? 1.0e10 : 3.0e10;
+        double const lambda = lower ? 1.0e10 : 3.0e10;
+
+        double const* cellValues = &values[5 * elem];
+        TS_ASSERT_DELTA(cellValues[0], rho, 1.0e-12 * rho);
+        TS_ASSERT_DELTA(cellValues[1], mu, 1.0e-12 * mu);
+        TS_ASSERT_DELTA(cellValues[2], lambda, 1.0e-12 * lambda);
+        TS_ASSERT_DELTA(cellValues[3], std::sqrt((lambda + 2.0 * mu) / rho), 1.0e-9);
+        TS_ASSERT_DELTA(cellValues[4], std::sqrt(mu / rho), 1.0e-9);
+      }
+
+      // the model setup does not reuse discarded values
+      pumlReader.discardMaterialValues();
+      TS_ASSERT_EQUALS(pumlReader.getMaterialLayout(), MaterialLayout::None);
+      TS_ASSERT_EQUALS(pumlReader.getNumberOfMaterialValues(), 0u);
+    }
+
+    void testRankCosts()
+    {
+      std::cout.setstate(std::ios_base::failbit);
+      seissol::initializers::time_stepping::LtsWeights ltsWeights("Testing/material.yaml", 2);
+      PUMLReader pumlReader("Testing/mesh.h5", "", &ltsWeights);
+      std::cout.clear();
+
+      int const ncon = ltsWeights.nWeightsPerVertex();
+      std::array<int, 24> ltsFactors;
+      std::copy(ltsWeights.vertexWeights(), ltsWeights.vertexWeights() + 24, ltsFactors.begin());
+      std::array<int, 24> partition;
+      for (int i = 0; i < 24; i++) {
+        partition[i] = i % 2;
+      }
+
+      // equal costs only increase the resolution of the weights
+      ltsWeights.applyRankCosts(partition.data(), {2.0, 0.5, 2.0, 0.5});
+      for (int i = 0; i < 24; i += ncon) {
+        TS_ASSERT_EQUALS(ltsWeights.vertexWeights()[i], 10 * ltsFactors[i]);
+      }
+
+      // the rank costs are relative to the mean cost, unknown costs count as the mean
+      ltsWeights.applyRankCosts(partition.data(), {3.0, 0.0, 1.0, -1.0});
+      for (int i = 0; i < 24; i += ncon) {
+        double const relativeCost = (partition[i / ncon] == 0) ? 1.5 : 0.5;
+        TS_ASSERT_EQUALS(ltsWeights.vertexWeights()[i], std::lround(relativeCost * 10 * ltsFactors[i]));
+      }
+    }
+
 };
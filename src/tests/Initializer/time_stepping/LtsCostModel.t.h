@@ -0,0 +1,63 @@
+#include <cxxtest/TestSuite.h>
+
+#include "Initializer/time_stepping/LtsCostModel.h"
+
+namespace seissol {
+  namespace unit_test {
+    class LtsCostModelTestSuite;
+  }
+}
+
+class seissol::unit_test::LtsCostModelTestSuite : public CxxTest::TestSuite
+{
+  public:
+    void testPredict()
+    {
+      seissol::initializers::time_stepping::LtsCostModel costModel(1.0e-6, 1.0e-4);
+
+      // 1000 elements with dt = 0.1, empty cluster with dt = 0.2, 400 elements with dt = 0.4 on 2 ranks
+      std::vector<double> clusterWeights = {1000.0, 0.0, 400.0};
+      double expected = (1.0e-6 * 500.0 + 1.0e-4) / 0.1 + (1.0e-6 * 200.0 + 1.0e-4) / 0.4;
+      TS_ASSERT_DELTA(costModel.predict(clusterWeights, 0.1, 2, 2), expected, 1.0e-12);
+    }
+
+    void testElementWeight()
+    {
+      seissol::initializers::time_stepping::LtsCostModel costModel(1.0e-6, 1.0e-4, 2.0, 0.5, 0.25);
+      TS_ASSERT_DELTA(costModel.cellCost(), 1.5, 1.0e-12);
+      TS_ASSERT_DELTA(costModel.elementWeight(0, 0), 1.5, 1.0e-12);
+      TS_ASSERT_DELTA(costModel.elementWeight(2, 1), 1.5 + 4.0 + 0.25, 1.0e-12);
+    }
+
+    void testMergeClusters()
+    {
+      std::vector<double> clusterWeights = {10.0, 20.0, 30.0, 40.0};
+      auto merged = seissol::initializers::time_stepping::LtsCostModel::mergeClusters(clusterWeights, 1);
+      TS_ASSERT_EQUALS(merged.size(), 2);
+      TS_ASSERT_DELTA(merged[0], 10.0, 1.0e-12);
+      TS_ASSERT_DELTA(merged[1], 90.0, 1.0e-12);
+
+      merged = seissol::initializers::time_stepping::LtsCostModel::mergeClusters(clusterWeights, 5);
+      TS_ASSERT_EQUALS(merged.size(), 4);
+    }
+
+    void testOptimalMaximumClusterId()
+    {
+      seissol::initializers::time_stepping::LtsCostModel costModel(1.0e-6, 1.0e-4);
+      double predictedTime;
+
+      // well-filled clusters are kept
+      std::vector<double> clusterWeights = {1.0e5, 1.0e5, 1.0e5};
+      TS_ASSERT_EQUALS(costModel.optimalMaximumClusterId(clusterWeights, 1.0, 2, 1, predictedTime), 2);
+      TS_ASSERT_DELTA(predictedTime, costModel.predict(clusterWeights, 1.0, 2, 1), 1.0e-12);
+
+      // a nearly empty cluster costs more overhead than it saves
+      clusterWeights = {1.0e5, 1.0e5, 10.0};
+      TS_ASSERT_EQUALS(costModel.optimalMaximumClusterId(clusterWeights, 1.0, 2, 1, predictedTime), 1);
+      TS_ASSERT(predictedTime < costModel.predict(clusterWeights, 1.0, 2, 1));
+
+      // without overhead, every cluster pays off
+      seissol::initializers::time_stepping::LtsCostModel noOverhead(1.0e-6, 0.0);
+      TS_ASSERT_EQUALS(noOverhead.optimalMaximumClusterId(clusterWeights, 1.0, 2, 1, predictedTime), 2);
+    }
+};
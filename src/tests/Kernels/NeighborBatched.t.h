@@ -0,0 +1,197 @@
+#include <cxxtest/TestSuite.h>
+
+#include <Initializer/BatchRecorders/Recorders.h>
+#include <Initializer/GlobalData.h>
+#include <Initializer/LTS.h>
+#include <Initializer/MemoryAllocator.h>
+#include <Initializer/tree/LTSTree.hpp>
+#include <Kernels/Neighbor.h>
+#include <Kernels/Time.h>
+#include <Kernels/TimeCommon.h>
+#include <Solver/time_stepping/MiniSeisSol.h>
+#include <generated_code/tensor.h>
+#include <yateto.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace seissol {
+  namespace unit_test {
+    class NeighborBatchedTestSuite;
+  }
+}
+
+class seissol::unit_test::NeighborBatchedTestSuite : public CxxTest::TestSuite
+{
+  private:
+    static constexpr unsigned numberOfCells = 97;
+    static constexpr double timeStepStart = 0.3;
+    static constexpr double timeStepWidth = 0.1;
+
+    //! Kind of the data a cell provides to its face neighbors
+    enum class Provides { Buffer, LtsDerivatives, GtsDerivatives };
+
+    std::mt19937 generator;
+
+    void fillRandom(real* values, std::size_t numberOfValues) {
+      std::uniform_real_distribution<real> distribution(-1.0, 1.0);
+      for (std::size_t i = 0; i < numberOfValues; ++i) {
+        values[i] = distribution(generator);
+      }
+    }
+
+    static Provides provides(unsigned cell) {
+      return static_cast<Provides>(cell % 3);
+    }
+
+    static bool isDynamicRuptureFace(unsigned cell, unsigned face) {
+      return (cell + face) % 5 == 0;
+    }
+
+  public:
+    void setUp() {
+      generator.seed(5489u);
+      srand48(5489);
+    }
+
+    //! Compares the batched neighbor integration of a layer with the cell-wise one.
+    //! The neighbors provide buffers, derivatives with the LTS relation or derivatives with the GTS relation;
+    //! every fifth face is a dynamic rupture face.
+    void testBatchedEqualsCellwise()
+    {
+#ifndef USE_VISCOELASTIC2
+      constexpr unsigned derivativesSize = yateto::computeFamilySize<tensor::dQ>();
+
+      seissol::memory::ManagedAllocator allocator;
+      GlobalData global;
+      seissol::initializers::GlobalDataInitializerOnHost::init(global, allocator, seissol::memory::Standard);
+
+      seissol::kernels::Time timeKernel;
+      timeKernel.setHostGlobalData(&global);
+      seissol::kernels::Neighbor neighborKernel;
+      neighborKernel.setHostGlobalData(&global);
+
+      seissol::initializers::LTSTree tree;
+      seissol::initializers::LTS lts;
+      lts.addTo(tree, false);
+      tree.setNumberOfTimeClusters(1);
+      tree.fixate();
+
+      seissol::initializers::TimeCluster& cluster = tree.child(0);
+      cluster.child<Ghost>().setNumberOfCells(0);
+      cluster.child<Copy>().setNumberOfCells(0);
+      cluster.child<Interior>().setNumberOfCells(numberOfCells);
+      seissol::initializers::Layer& layer = cluster.child<Interior>();
+      layer.setBucketSize(lts.buffersDerivatives, sizeof(real) * (tensor::I::size() + derivativesSize) * numberOfCells);
+
+      tree.allocateVariables();
+      tree.touchVariables();
+      tree.allocateBuckets();
+
+      seissol::fakeData(lts, layer);
+
+      real (*dofs)[tensor::Q::size()] = layer.var(lts.dofs);
+      real** buffers = layer.var(lts.buffers);
+      real** derivatives = layer.var(lts.derivatives);
+      real* (*faceNeighbors)[4] = layer.var(lts.faceNeighbors);
+      NeighboringIntegrationData* neighboringIntegration = layer.var(lts.neighboringIntegration);
+      CellLocalInformation* cellInformation = layer.var(lts.cellInformation);
+      CellDRMapping (*drMapping)[4] = layer.var(lts.drMapping);
+      real* bucket = static_cast<real*>(layer.bucket(lts.buffersDerivatives));
+
+      real* godunov = static_cast<real*>(allocator.allocateMemory(4 * numberOfCells * tensor::QInterpolated::size() * sizeof(real), ALIGNMENT));
+      real* fluxSolver = static_cast<real*>(allocator.allocateMemory(4 * numberOfCells * tensor::fluxSolver::size() * sizeof(real), ALIGNMENT));
+
+      // the derivatives follow the buffers in the bucket
+      for (unsigned cell = 0; cell < numberOfCells; ++cell) {
+        derivatives[cell] = bucket + numberOfCells * tensor::I::size() + cell * derivativesSize;
+      }
+
+      unsigned numberOfDynamicRuptureFaces = 0;
+      for (unsigned cell = 0; cell < numberOfCells; ++cell) {
+        cellInformation[cell].ltsSetup = 0;
+        for (unsigned face = 0; face < 4; ++face) {
+          unsigned neighbor = cellInformation[cell].faceNeighborIds[face];
+          if (isDynamicRuptureFace(cell, face)) {
+            cellInformation[cell].faceTypes[face] = FaceType::dynamicRupture;
+            faceNeighbors[cell][face] = buffers[neighbor];
+            drMapping[cell][face].side = (unsigned)lrand48() % 4;
+            drMapping[cell][face].faceRelation = (unsigned)lrand48() % 3;
+            drMapping[cell][face].godunov = godunov + (4 * cell + face) * tensor::QInterpolated::size();
+            drMapping[cell][face].fluxSolver = fluxSolver + (4 * cell + face) * tensor::fluxSolver::size();
+            ++numberOfDynamicRuptureFaces;
+            continue;
+          }
+          cellInformation[cell].faceTypes[face] = FaceType::regular;
+          switch (provides(neighbor)) {
+            case Provides::Buffer:
+              faceNeighbors[cell][face] = buffers[neighbor];
+              break;
+            case Provides::GtsDerivatives:
+              cellInformation[cell].ltsSetup |= (1 << (face + 4));
+              // Fallthrough intended
+            case Provides::LtsDerivatives:
+              cellInformation[cell].ltsSetup |= (1 << face);
+              faceNeighbors[cell][face] = derivatives[neighbor];
+              break;
+          }
+        }
+      }
+      TS_ASSERT_LESS_THAN(0u, numberOfDynamicRuptureFaces);
+
+      fillRandom(&dofs[0][0], numberOfCells * tensor::Q::size());
+      fillRandom(bucket, numberOfCells * (tensor::I::size() + derivativesSize));
+      fillRandom(reinterpret_cast<real*>(neighboringIntegration), sizeof(NeighboringIntegrationData) / sizeof(real) * numberOfCells);
+      fillRandom(godunov, 4 * numberOfCells * tensor::QInterpolated::size());
+      fillRandom(fluxSolver, 4 * numberOfCells * tensor::fluxSolver::size());
+      std::vector<real> initialDofs(&dofs[0][0], &dofs[0][0] + numberOfCells * tensor::Q::size());
+
+      // cell-wise neighbor integration
+      seissol::kernels::NeighborData::Loader loader;
+      loader.load(lts, layer);
+      real integrationBuffer[4][tensor::I::size()] __attribute__((aligned(ALIGNMENT)));
+      real* timeIntegrated[4];
+      for (unsigned cell = 0; cell < numberOfCells; ++cell) {
+        auto data = loader.entry(cell);
+        seissol::kernels::TimeCommon::computeIntegrals(timeKernel,
+                                                       data.cellInformation.ltsSetup,
+                                                       data.cellInformation.faceTypes,
+                                                       timeStepStart,
+                                                       timeStepWidth,
+                                                       faceNeighbors[cell],
+                                                       integrationBuffer,
+                                                       timeIntegrated);
+        neighborKernel.computeNeighborsIntegral(data, drMapping[cell], timeIntegrated, faceNeighbors[cell]);
+      }
+      std::vector<real> cellwiseDofs(&dofs[0][0], &dofs[0][0] + numberOfCells * tensor::Q::size());
+
+      // batched neighbor integration of the same layer
+      std::copy(initialDofs.begin(), initialDofs.end(), &dofs[0][0]);
+      layer.setScratchpadSize(lts.idofsScratch, 4 * numberOfCells * tensor::I::size() * sizeof(real));
+      tree.allocateScratchPads();
+      seissol::initializers::recording::NeighIntegrationRecorder recorder;
+      recorder.record(lts, layer);
+
+      ConditionalBatchTableT& table = layer.getCondBatchTable();
+      TS_ASSERT(table.find(ConditionalKey(*KernelNames::NeighborFlux, *ComputationKind::WithGtsDerivatives)) != table.end());
+      TS_ASSERT(table.find(ConditionalKey(*KernelNames::NeighborFlux, *ComputationKind::WithLtsDerivatives)) != table.end());
+
+      seissol::kernels::TimeCommon::computeBatchedIntegrals(timeKernel, timeStepStart, timeStepWidth, table);
+      neighborKernel.computeBatchedNeighborsIntegral(table);
+
+      real maxValue = 0.0;
+      for (real value : cellwiseDofs) {
+        maxValue = std::max(maxValue, std::abs(value));
+      }
+      real const epsilon = 100.0 * std::numeric_limits<real>::epsilon() * maxValue;
+      for (unsigned i = 0; i < numberOfCells * tensor::Q::size(); ++i) {
+        TS_ASSERT_DELTA(cellwiseDofs[i], (&dofs[0][0])[i], epsilon);
+      }
+      // the neighbor integration has to change the degrees of freedom
+      TS_ASSERT(!std::equal(initialDofs.begin(), initialDofs.end(), cellwiseDofs.begin()));
+#endif
+    }
+};
@@ -0,0 +1,121 @@
+#include <cxxtest/TestSuite.h>
+
+#include <Kernels/Plasticity.h>
+#include <generated_code/init.h>
+#include <generated_code/tensor.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+namespace seissol {
+  namespace unit_test {
+    class PlasticityTestSuite;
+  }
+}
+
+class seissol::unit_test::PlasticityTestSuite : public CxxTest::TestSuite
+{
+  private:
+    static constexpr unsigned numberOfSamples = 2000;
+
+    real vandermondeMatrix[tensor::v::size()] __attribute__((aligned(ALIGNMENT)));
+    real vandermondeMatrixInverse[tensor::vInv::size()] __attribute__((aligned(ALIGNMENT)));
+    real degreesOfFreedom[tensor::Q::size()] __attribute__((aligned(ALIGNMENT)));
+    GlobalData global;
+    PlasticityData plasticityData;
+    std::mt19937 generator;
+
+    //! Draws random modes of the stresses; the constant mode is scaled with constantScale, all other modes with modeScale
+    void drawStresses(real constantScale, real modeScale) {
+      std::uniform_real_distribution<real> distribution(-1.0, 1.0);
+      std::fill(degreesOfFreedom, degreesOfFreedom + tensor::Q::size(), 0.0);
+      for (unsigned q = 0; q < 6; ++q) {
+        real* stress = degreesOfFreedom + q * NUMBER_OF_ALIGNED_BASIS_FUNCTIONS;
+        stress[0] = constantScale * distribution(generator);
+        for (unsigned basis = 1; basis < NUMBER_OF_BASIS_FUNCTIONS; ++basis) {
+          stress[basis] = modeScale * distribution(generator) / (basis + 1);
+        }
+      }
+    }
+
+    //! Hydrostatic initial loading with a random deviatoric part
+    void drawInitialLoading(real deviatoricScale) {
+      std::uniform_real_distribution<real> distribution(-1.0, 1.0);
+      for (unsigned q = 0; q < 6; ++q) {
+        plasticityData.initialLoading[q] = deviatoricScale * distribution(generator);
+      }
+      for (unsigned q = 0; q < 3; ++q) {
+        plasticityData.initialLoading[q] -= 50.0e6;
+      }
+    }
+
+    //! Returns true if computePlasticity yields the current degrees of freedom
+    bool yields() {
+      real copy[tensor::Q::size()] __attribute__((aligned(ALIGNMENT)));
+      real pstrain[7] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+      std::copy(degreesOfFreedom, degreesOfFreedom + tensor::Q::size(), copy);
+      return seissol::kernels::Plasticity::computePlasticity(0.5, 1.0e-3, &global, &plasticityData, copy, pstrain) != 0;
+    }
+
+  public:
+    void setUp() {
+      std::copy(init::v::Values, init::v::Values + tensor::v::size(), vandermondeMatrix);
+      std::copy(init::vInv::Values, init::vInv::Values + tensor::vInv::size(), vandermondeMatrixInverse);
+      global.vandermondeMatrix = vandermondeMatrix;
+      global.vandermondeMatrixInverse = vandermondeMatrixInverse;
+
+      double const angularFriction = std::atan(0.6);
+      plasticityData.cohesionTimesCosAngularFriction = 1.0e6 * std::cos(angularFriction);
+      plasticityData.sinAngularFriction = std::sin(angularFriction);
+      plasticityData.mufactor = 1.0 / (2.0 * 3.0e10);
+      plasticityData.evaluate = true;
+
+      generator.seed(5489u);
+    }
+
+    void testNoSkipIfYielding()
+    {
+      unsigned numberOfYieldingStates = 0;
+      for (unsigned sample = 0; sample < numberOfSamples; ++sample) {
+        // spans clearly elastic to clearly yielding states
+        real const scale = std::pow(10.0, 5.0 + 3.0 * sample / numberOfSamples);
+        drawInitialLoading(0.5 * scale);
+        drawStresses(scale, scale);
+
+        bool const skip = seissol::kernels::Plasticity::skipPlasticity(&global, &plasticityData, degreesOfFreedom);
+        bool const yield = yields();
+        TS_ASSERT(!(skip && yield));
+        if (yield) {
+          ++numberOfYieldingStates;
+        }
+      }
+      // the samples have to cover the yielding states
+      TS_ASSERT_LESS_THAN(numberOfSamples / 10, numberOfYieldingStates);
+    }
+
+    void testSkipElasticStates()
+    {
+      unsigned numberOfSkippedStates = 0;
+      for (unsigned sample = 0; sample < numberOfSamples; ++sample) {
+        // small perturbations of a confined initial loading are far away from the yield surface
+        drawInitialLoading(1.0e5);
+        drawStresses(1.0e5, 1.0e5);
+
+        bool const skip = seissol::kernels::Plasticity::skipPlasticity(&global, &plasticityData, degreesOfFreedom);
+        TS_ASSERT(!(skip && yields()));
+        if (skip) {
+          ++numberOfSkippedStates;
+        }
+      }
+      TS_ASSERT_LESS_THAN(numberOfSamples / 2, numberOfSkippedStates);
+    }
+
+    void testOutsideOfPlasticRegion()
+    {
+      plasticityData.evaluate = false;
+      drawInitialLoading(1.0e8);
+      drawStresses(1.0e8, 1.0e8);
+      TS_ASSERT(seissol::kernels::Plasticity::skipPlasticity(&global, &plasticityData, degreesOfFreedom));
+    }
+};
@@ -0,0 +1,166 @@
+#include <cxxtest/TestSuite.h>
+
+#include "tests/Geometry/MockReader.h"
+#include <Initializer/GlobalData.h>
+#include <Initializer/LTS.h>
+#include <Initializer/MemoryAllocator.h>
+#include <Initializer/tree/LTSTree.hpp>
+#include <Initializer/tree/Lut.hpp>
+#include <Kernels/Receiver.h>
+#include <Numerical_aux/BasisFunction.h>
+#include <generated_code/init.h>
+#include <generated_code/kernel.h>
+#include <generated_code/tensor.h>
+#include <yateto.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace seissol {
+  namespace unit_test {
+    class ReceiverTestSuite;
+  }
+}
+
+class seissol::unit_test::ReceiverTestSuite : public CxxTest::TestSuite
+{
+  private:
+    //! Not a multiple of the receivers per batch, such that the last batch is partial
+    static constexpr unsigned numberOfReceivers = 6;
+    static constexpr unsigned numberOfQuantities = 9;
+    static constexpr double timeStepWidth = 0.1;
+    //! Yields 7 samples per time step, i.e. a partial batch of sample times as well
+    static constexpr double samplingInterval = 0.015;
+
+    std::mt19937 generator;
+
+    void fillRandom(real* values, std::size_t numberOfValues) {
+      std::uniform_real_distribution<real> distribution(-1.0, 1.0);
+      for (std::size_t i = 0; i < numberOfValues; ++i) {
+        values[i] = distribution(generator);
+      }
+    }
+
+  public:
+    void setUp() {
+      generator.seed(5489u);
+    }
+
+    //! Compares the batched evaluation of several receivers in the same cell with the evaluation
+    //! of every receiver on its own (evaluateDOFSAtPoint)
+    void testBatchedEqualsSingleEvaluation()
+    {
+      TS_ASSERT_DIFFERS(0u, numberOfReceivers % tensor::basisFunctionsAtPoints::Shape[1]);
+
+      seissol::memory::ManagedAllocator allocator;
+      GlobalData global;
+      seissol::initializers::GlobalDataInitializerOnHost::init(global, allocator, seissol::memory::Standard);
+
+      // a single cell on the interior layer, which is the reference tetrahedron
+      seissol::initializers::LTSTree tree;
+      seissol::initializers::LTS lts;
+      lts.addTo(tree, false);
+      tree.setNumberOfTimeClusters(1);
+      tree.fixate();
+      seissol::initializers::TimeCluster& cluster = tree.child(0);
+      cluster.child<Ghost>().setNumberOfCells(0);
+      cluster.child<Copy>().setNumberOfCells(0);
+      cluster.child<Interior>().setNumberOfCells(1);
+      tree.allocateVariables();
+      tree.touchVariables();
+
+      seissol::initializers::Layer& layer = cluster.child<Interior>();
+      fillRandom(layer.var(lts.dofs)[0], tensor::Q::size());
+      if (kernels::size<tensor::Qane>() > 0) {
+        fillRandom(layer.var(lts.dofsAne)[0], kernels::size<tensor::Qane>());
+      }
+      fillRandom(reinterpret_cast<real*>(layer.var(lts.localIntegration)), sizeof(LocalIntegrationData) / sizeof(real));
+
+      unsigned ltsToMesh[1] = {0};
+      seissol::initializers::Lut ltsLut;
+      ltsLut.createLuts(&tree, ltsToMesh, 1);
+
+      seissol::MockReader mesh({{
+        Eigen::Vector3d(0.0, 0.0, 0.0),
+        Eigen::Vector3d(1.0, 0.0, 0.0),
+        Eigen::Vector3d(0.0, 1.0, 0.0),
+        Eigen::Vector3d(0.0, 0.0, 1.0)}});
+
+      std::vector<unsigned> quantities;
+      for (unsigned quantity = 0; quantity < numberOfQuantities; ++quantity) {
+        quantities.push_back(quantity);
+      }
+      seissol::kernels::ReceiverCluster receiverCluster(&global, quantities, samplingInterval, timeStepWidth);
+
+      // random points in the reference tetrahedron
+      std::uniform_real_distribution<double> distribution(0.0, 1.0);
+      std::vector<Eigen::Vector3d> points;
+      for (unsigned r = 0; r < numberOfReceivers; ++r) {
+        Eigen::Vector3d point(distribution(generator), distribution(generator), distribution(generator));
+        point *= 0.9 * distribution(generator) / point.sum();
+        points.push_back(point);
+        receiverCluster.addReceiver(0, r, point, mesh, ltsLut, lts);
+      }
+
+      receiverCluster.calcReceivers(0.0, 0.0, timeStepWidth);
+
+      // reference: Taylor expansion and evaluation at a single point per receiver and sample
+      seissol::kernels::Time timeKernel;
+      timeKernel.setHostGlobalData(&global);
+      auto data = seissol::kernels::LocalData::lookup(lts, ltsLut, 0);
+      seissol::kernels::LocalTmp tmp;
+      real timeIntegrated[tensor::I::size()] __attribute__((aligned(ALIGNMENT)));
+      real timeDerivatives[yateto::computeFamilySize<tensor::dQ>()] __attribute__((aligned(ALIGNMENT)));
+      real timeEvaluated[tensor::Q::size()] __attribute__((aligned(ALIGNMENT)));
+      real qAtPointValues[tensor::QAtPoint::size()] __attribute__((aligned(ALIGNMENT)));
+      timeKernel.computeAder(timeStepWidth, data, tmp, timeIntegrated, timeDerivatives);
+
+      kernel::evaluateDOFSAtPoint krnl;
+      krnl.QAtPoint = qAtPointValues;
+      krnl.Q = timeEvaluated;
+      auto qAtPoint = init::QAtPoint::view::create(qAtPointValues);
+
+      unsigned const numberOfColumns = receiverCluster.ncols();
+      unsigned receiverIndex = 0;
+      for (auto& receiver : receiverCluster) {
+        TS_ASSERT_EQUALS(receiverIndex, receiver.pointId);
+        TS_ASSERT_EQUALS(7 * numberOfColumns, receiver.output.size());
+
+        Eigen::Vector3d const& point = points[receiver.pointId];
+        basisFunction::SampledBasisFunctions<real> basisFunctions(CONVERGENCE_ORDER, point[0], point[1], point[2]);
+        krnl.basisFunctionsAtPoint = basisFunctions.m_data.data();
+
+        for (unsigned row = 0; row * numberOfColumns < receiver.output.size(); ++row) {
+          real const* sample = &receiver.output[row * numberOfColumns];
+          TS_ASSERT_DELTA(row * samplingInterval, sample[0], 1.0e-6);
+
+          timeKernel.computeTaylorExpansion(sample[0], 0.0, timeDerivatives, timeEvaluated);
+          krnl.execute();
+
+          real maxValue = 0.0;
+          for (unsigned i = 0; i < tensor::QAtPoint::size(); ++i) {
+            maxValue = std::max(maxValue, std::abs(qAtPointValues[i]));
+          }
+          real const epsilon = 1.0e3 * std::numeric_limits<real>::epsilon() * maxValue;
+
+          unsigned column = 1;
+#ifdef MULTIPLE_SIMULATIONS
+          for (unsigned sim = init::QAtPoint::Start[0]; sim < init::QAtPoint::Stop[0]; ++sim) {
+            for (auto quantity : quantities) {
+              TS_ASSERT_DELTA(qAtPoint(sim, quantity), sample[column++], epsilon);
+            }
+          }
+#else
+          for (auto quantity : quantities) {
+            TS_ASSERT_DELTA(qAtPoint(quantity), sample[column++], epsilon);
+          }
+#endif
+        }
+        ++receiverIndex;
+      }
+      TS_ASSERT_EQUALS(numberOfReceivers, receiverIndex);
+    }
+};
@@ -0,0 +1,101 @@
+#include <cxxtest/TestSuite.h>
+
+#include <Monitoring/LoopStatistics.h>
+#include <Monitoring/PerformanceCounters.h>
+
+namespace seissol {
+  namespace unit_test {
+    class LoopStatisticsTestSuite;
+  }
+}
+
+class seissol::unit_test::LoopStatisticsTestSuite : public CxxTest::TestSuite
+{
+  public:
+    //! Without counters the samples record the time, the elements and the cluster
+    void testCountersDisabled()
+    {
+      seissol::LoopStatistics loopStatistics;
+      loopStatistics.addRegion("local");
+      loopStatistics.addRegion("neighbor");
+      unsigned const local = loopStatistics.getRegion("local");
+      unsigned const neighbor = loopStatistics.getRegion("neighbor");
+      TS_ASSERT_EQUALS(0u, local);
+      TS_ASSERT_EQUALS(1u, neighbor);
+
+      loopStatistics.begin(local);
+      loopStatistics.end(local, 10, 2);
+      loopStatistics.begin(local);
+      loopStatistics.end(local, 20);
+      loopStatistics.addSample(neighbor, 0.5, 30, 1);
+
+      auto const& localSamples = loopStatistics.getSamples(local);
+      TS_ASSERT_EQUALS(2u, localSamples.size());
+      TS_ASSERT_EQUALS(10u, localSamples[0].numIters);
+      TS_ASSERT_EQUALS(2u, localSamples[0].cluster);
+      TS_ASSERT_EQUALS(20u, localSamples[1].numIters);
+      TS_ASSERT_EQUALS(0u, localSamples[1].cluster);
+
+      auto const& neighborSamples = loopStatistics.getSamples(neighbor);
+      TS_ASSERT_EQUALS(1u, neighborSamples.size());
+      TS_ASSERT_EQUALS(0.5, neighborSamples[0].time);
+      TS_ASSERT_EQUALS(30u, neighborSamples[0].numIters);
+      TS_ASSERT_EQUALS(1u, neighborSamples[0].cluster);
+
+      for (unsigned region = 0; region < 2; ++region) {
+        for (auto const& sample : loopStatistics.getSamples(region)) {
+          TS_ASSERT(sample.time >= 0.0);
+          for (unsigned counter = 0; counter < seissol::PerformanceCounters::NumCounters; ++counter) {
+            TS_ASSERT_EQUALS(0u, sample.counters[counter]);
+          }
+        }
+      }
+      TS_ASSERT_EQUALS(3u, loopStatistics.getNumberOfClusters());
+    }
+
+    //! The sums of a region and cluster are contiguous; unused clusters stay zero
+    void testSumLayout()
+    {
+      seissol::LoopStatistics loopStatistics;
+      loopStatistics.addRegion("local");
+      loopStatistics.addRegion("neighbor");
+      loopStatistics.addSample(0, 1.0, 10, 0);
+      loopStatistics.addSample(0, 2.0, 20, 0);
+      loopStatistics.addSample(0, 4.0, 40, 2);
+      loopStatistics.addSample(1, 8.0, 80, 1);
+
+      unsigned const nClusters = 4;
+      unsigned const nValues = seissol::LoopStatistics::NumSummedValues;
+      auto sums = loopStatistics.sumSamples(nClusters);
+      TS_ASSERT_EQUALS(nValues * 2 * nClusters, sums.size());
+
+      double const expectedTimes[2][nClusters] = {{3.0, 0.0, 4.0, 0.0}, {0.0, 8.0, 0.0, 0.0}};
+      for (unsigned region = 0; region < 2; ++region) {
+        for (unsigned cluster = 0; cluster < nClusters; ++cluster) {
+          double const* values = &sums[nValues * (region * nClusters + cluster)];
+          TS_ASSERT_EQUALS(expectedTimes[region][cluster], values[0]);
+          TS_ASSERT_EQUALS(10.0 * expectedTimes[region][cluster], values[1]);
+          for (unsigned counter = 0; counter < seissol::PerformanceCounters::NumCounters; ++counter) {
+            TS_ASSERT_EQUALS(0.0, values[2 + counter]);
+          }
+        }
+      }
+    }
+
+    //! Opening the counters fails gracefully if perf events are not available
+    void testPerformanceCounters()
+    {
+      seissol::PerformanceCounters counters;
+      bool const opened = counters.open();
+      TS_ASSERT_EQUALS(opened, counters.isEnabled());
+
+      seissol::PerformanceCounters::Values values;
+      values.fill(1);
+      counters.read(values);
+      if (!opened) {
+        for (unsigned counter = 0; counter < seissol::PerformanceCounters::NumCounters; ++counter) {
+          TS_ASSERT_EQUALS(0u, values[counter]);
+        }
+      }
+    }
+};
@@ -0,0 +1,53 @@
+#include <cxxtest/TestSuite.h>
+
+#include <Monitoring/LoopStatistics.h>
+#include <Parallel/MPI.h>
+
+namespace seissol {
+  namespace unit_test {
+    class LoopStatisticsParallelTestSuite;
+  }
+}
+
+class seissol::unit_test::LoopStatisticsParallelTestSuite : public CxxTest::TestSuite
+{
+  public:
+    //! Rank 0 holds the sums of the contributing ranks in the layout of sumSamples
+    void testReduceSamples()
+    {
+#ifdef USE_MPI
+      MPI_Comm const comm = seissol::MPI::mpi.comm();
+      int rank;
+      int size;
+      MPI_Comm_rank(comm, &rank);
+      MPI_Comm_size(comm, &size);
+
+      // every rank samples its own cluster in region 0 and cluster 0 in region 1; the last rank does not contribute
+      seissol::LoopStatistics loopStatistics;
+      loopStatistics.addRegion("local");
+      loopStatistics.addRegion("neighbor");
+      loopStatistics.addSample(0, 1.0 + rank, 10 * (1 + rank), rank);
+      loopStatistics.addSample(1, 2.0, 5, 0);
+      bool const contribute = (size == 1 || rank < size - 1);
+
+      unsigned nClusters = 0;
+      auto sums = loopStatistics.reduceSamples(comm, contribute, nClusters);
+      TS_ASSERT_EQUALS(static_cast<unsigned>(size), nClusters);
+
+      if (rank == 0) {
+        unsigned const nValues = seissol::LoopStatistics::NumSummedValues;
+        int const contributors = (size == 1) ? 1 : size - 1;
+        TS_ASSERT_EQUALS(nValues * 2 * nClusters, sums.size());
+        for (unsigned cluster = 0; cluster < nClusters; ++cluster) {
+          double const* local = &sums[nValues * cluster];
+          double const* neighbor = &sums[nValues * (nClusters + cluster)];
+          bool const contributed = static_cast<int>(cluster) < contributors;
+          TS_ASSERT_EQUALS(contributed ? 1.0 + cluster : 0.0, local[0]);
+          TS_ASSERT_EQUALS(contributed ? 10.0 * (1 + cluster) : 0.0, local[1]);
+          TS_ASSERT_EQUALS(cluster == 0 ? 2.0 * contributors : 0.0, neighbor[0]);
+          TS_ASSERT_EQUALS(cluster == 0 ? 5.0 * contributors : 0.0, neighbor[1]);
+        }
+      }
+#endif
+    }
+};
@@ -0,0 +1,204 @@
+#include <cxxtest/TestSuite.h>
+#include <cmath>
+#include <memory>
+
+#include <Kernels/FrictionSolver.h>
+#include <Initializer/DynamicRupture.h>
+#include <Initializer/tree/LTSTree.hpp>
+
+namespace seissol {
+  namespace unit_test {
+    class FrictionSolverTestSuite;
+  }
+}
+
+class seissol::unit_test::FrictionSolverTestSuite : public CxxTest::TestSuite
+{
+  private:
+    static constexpr unsigned ld = seissol::initializers::numberOfPaddedDRPoints;
+    static constexpr unsigned numberOfFaces = 3;
+
+    std::unique_ptr<seissol::initializers::LTSTree> tree;
+    seissol::initializers::DynamicRupture dynRup;
+    seissol::kernels::FrictionSolver solver;
+    seissol::kernels::FrictionSolver::FaultStresses stresses;
+    double timePoints[CONVERGENCE_ORDER];
+    double timeWeights[CONVERGENCE_ORDER];
+    double const timeStepWidth = 1.0e-3;
+
+    seissol::initializers::Layer& layer() {
+      return tree->child(0).child<Interior>();
+    }
+
+    //! TPV5-like homogeneous fault, the initial shear stress is given per face
+    void initialize(seissol::kernels::FrictionSolver::Parameters const& parameters, real const initialShearStress[numberOfFaces]) {
+      solver.setParameters(parameters);
+
+      tree = std::make_unique<seissol::initializers::LTSTree>();
+      dynRup.addTo(*tree);
+      tree->setNumberOfTimeClusters(1);
+      tree->fixate();
+      tree->child(0).child<Ghost>().setNumberOfCells(0);
+      tree->child(0).child<Copy>().setNumberOfCells(0);
+      tree->child(0).child<Interior>().setNumberOfCells(numberOfFaces);
+      tree->allocateVariables();
+      tree->touchVariables();
+
+      seissol::initializers::Layer& interior = layer();
+      for (unsigned face = 0; face < numberOfFaces; ++face) {
+        interior.var(dynRup.waveSpeedsPlus)[face] = {2670.0, 6000.0, 3464.0};
+        interior.var(dynRup.waveSpeedsMinus)[face] = {2670.0, 6000.0, 3464.0};
+        interior.var(dynRup.magnitudeOutput)[face] = true;
+        interior.var(dynRup.averagedSlip)[face] = 0.0;
+        for (unsigned point = 0; point < ld; ++point) {
+          for (unsigned s = 0; s < 6; ++s) {
+            interior.var(dynRup.initialStressInFaultCS)[face][s][point] = 0.0;
+          }
+          interior.var(dynRup.initialStressInFaultCS)[face][0][point] = -120.0e6;
+          interior.var(dynRup.initialStressInFaultCS)[face][3][point] = initialShearStress[face];
+          interior.var(dynRup.cohesion)[face][point] = 0.0;
+          interior.var(dynRup.muS)[face][point] = 0.677;
+          interior.var(dynRup.muD)[face][point] = 0.525;
+          interior.var(dynRup.dC)[face][point] = 0.4;
+          interior.var(dynRup.forcedRuptureTime)[face][point] = 1.0e9;
+          interior.var(dynRup.mu)[face][point] = 0.677;
+          interior.var(dynRup.slip)[face][point] = 0.0;
+          interior.var(dynRup.slip1)[face][point] = 0.0;
+          interior.var(dynRup.slip2)[face][point] = 0.0;
+          interior.var(dynRup.slipRate1)[face][point] = parameters.rsSr0;
+          interior.var(dynRup.slipRate2)[face][point] = 0.0;
+          interior.var(dynRup.stateVariable)[face][point] = (parameters.rsSr0 > 0.0) ? parameters.rsSl0 / parameters.rsSr0 : 0.0;
+          interior.var(dynRup.tractionXY)[face][point] = 0.0;
+          interior.var(dynRup.tractionXZ)[face][point] = 0.0;
+          interior.var(dynRup.ruptureTime)[face][point] = 0.0;
+          interior.var(dynRup.dynStressTime)[face][point] = 0.0;
+          interior.var(dynRup.peakSlipRate)[face][point] = 0.0;
+          interior.var(dynRup.ruptureFront)[face][point] = true;
+          interior.var(dynRup.dynStressPending)[face][point] = true;
+        }
+      }
+
+      for (unsigned timePoint = 0; timePoint < CONVERGENCE_ORDER; ++timePoint) {
+        timeWeights[timePoint] = timeStepWidth / CONVERGENCE_ORDER;
+        timePoints[timePoint] = (timePoint + 0.5) * timeWeights[timePoint];
+      }
+    }
+
+    //! Evaluates the friction law for an unperturbed wave field
+    void evaluate(double fullUpdateTime) {
+      alignas(ALIGNMENT) real QInterpolatedPlus[CONVERGENCE_ORDER][tensor::QInterpolated::size()] = {};
+      alignas(ALIGNMENT) real QInterpolatedMinus[CONVERGENCE_ORDER][tensor::QInterpolated::size()] = {};
+
+      seissol::initializers::Layer& interior = layer();
+      for (unsigned face = 0; face < numberOfFaces; ++face) {
+        solver.computeFaultStresses(  face,
+                                      QInterpolatedPlus,
+                                      QInterpolatedMinus,
+                                      interior.var(dynRup.waveSpeedsPlus)[face],
+                                      interior.var(dynRup.waveSpeedsMinus)[face],
+                                      timeWeights,
+                                      stresses,
+                                      interior.var(dynRup.imposedStatePlus)[face],
+                                      interior.var(dynRup.imposedStateMinus)[face] );
+      }
+      solver.evaluate(interior, &dynRup, 0, numberOfFaces, stresses, fullUpdateTime, timePoints, timeWeights);
+    }
+
+  public:
+    void testSupportedLaws()
+    {
+      TS_ASSERT(seissol::kernels::FrictionSolver::isSupported(0));
+      TS_ASSERT(seissol::kernels::FrictionSolver::isSupported(2));
+      TS_ASSERT(seissol::kernels::FrictionSolver::isSupported(3));
+      TS_ASSERT(seissol::kernels::FrictionSolver::isSupported(4));
+      TS_ASSERT(seissol::kernels::FrictionSolver::isSupported(16));
+      TS_ASSERT(!seissol::kernels::FrictionSolver::isSupported(6));
+      TS_ASSERT(!seissol::kernels::FrictionSolver::isSupported(103));
+    }
+
+    void testNoFault()
+    {
+      seissol::kernels::FrictionSolver::Parameters parameters;
+      parameters.law = seissol::kernels::FrictionSolver::Law::NoFault;
+      real const initialShearStress[numberOfFaces] = {70.0e6, 70.0e6, 70.0e6};
+      initialize(parameters, initialShearStress);
+      evaluate(0.0);
+
+      // a vanishing wave field imposes a vanishing state
+      real (*imposedStatePlus)[tensor::QInterpolated::size()] = layer().var(dynRup.imposedStatePlus);
+      real (*imposedStateMinus)[tensor::QInterpolated::size()] = layer().var(dynRup.imposedStateMinus);
+      for (unsigned face = 0; face < numberOfFaces; ++face) {
+        for (unsigned i = 0; i < tensor::QInterpolated::size(); ++i) {
+          TS_ASSERT_DELTA(imposedStatePlus[face][i], 0.0, 1.0e-12);
+          TS_ASSERT_DELTA(imposedStateMinus[face][i], 0.0, 1.0e-12);
+        }
+      }
+    }
+
+    void testLinearSlipWeakening()
+    {
+      seissol::kernels::FrictionSolver::Parameters parameters;
+      parameters.law = seissol::kernels::FrictionSolver::Law::LinearSlipWeakening;
+      // the second face is loaded above its static strength of 0.677 * 120 MPa
+      real const initialShearStress[numberOfFaces] = {70.0e6, 90.0e6, 70.0e6};
+      initialize(parameters, initialShearStress);
+      evaluate(0.5);
+
+      seissol::initializers::Layer& interior = layer();
+      real (*imposedStatePlus)[tensor::QInterpolated::size()] = interior.var(dynRup.imposedStatePlus);
+      real const eta = 0.5 * 2670.0 * 3464.0;
+      // the stress excess is radiated away, the strength drops slightly within the time step
+      real const stressExcess = 90.0e6 - 0.677 * 120.0e6;
+      real const slipRate = stressExcess / eta;
+      for (unsigned point = 0; point < seissol::initializers::numberOfDRPoints; ++point) {
+        // locked faces keep their state
+        for (unsigned face : {0u, 2u}) {
+          TS_ASSERT_DELTA(interior.var(dynRup.slipRate1)[face][point], 0.0, 1.0e-12);
+          TS_ASSERT_DELTA(interior.var(dynRup.slip)[face][point], 0.0, 1.0e-12);
+          TS_ASSERT_DELTA(interior.var(dynRup.tractionXY)[face][point], 0.0, 1.0e-6);
+          TS_ASSERT_DELTA(imposedStatePlus[face][3*ld + point], 0.0, 1.0e-6);
+          TS_ASSERT_DELTA(interior.var(dynRup.mu)[face][point], 0.677, 1.0e-6);
+          TS_ASSERT(interior.var(dynRup.ruptureFront)[face][point]);
+        }
+
+        TS_ASSERT_DELTA(interior.var(dynRup.slipRate1)[1][point], slipRate, 5.0e-2 * slipRate);
+        TS_ASSERT_DELTA(interior.var(dynRup.slip1)[1][point], slipRate * timeStepWidth, 5.0e-2 * slipRate * timeStepWidth);
+        TS_ASSERT_DELTA(interior.var(dynRup.tractionXY)[1][point], -stressExcess, 5.0e-2 * stressExcess);
+        TS_ASSERT_DELTA(imposedStatePlus[1][3*ld + point], -stressExcess * timeStepWidth, 5.0e-2 * stressExcess * timeStepWidth);
+        TS_ASSERT(interior.var(dynRup.mu)[1][point] < 0.677);
+        TS_ASSERT(!interior.var(dynRup.ruptureFront)[1][point]);
+        TS_ASSERT_DELTA(interior.var(dynRup.ruptureTime)[1][point], 0.5, 1.0e-12);
+        TS_ASSERT_DELTA(interior.var(dynRup.peakSlipRate)[1][point], slipRate, 5.0e-2 * slipRate);
+      }
+      TS_ASSERT_DELTA(interior.var(dynRup.averagedSlip)[0], 0.0, 1.0e-12);
+      TS_ASSERT_DELTA(interior.var(dynRup.averagedSlip)[1], slipRate * timeStepWidth, 5.0e-2 * slipRate * timeStepWidth);
+    }
+
+    void testRateAndStateSteadyState()
+    {
+      for (auto law : { seissol::kernels::FrictionSolver::Law::RateAndStateAgingLaw,
+                        seissol::kernels::FrictionSolver::Law::RateAndStateSlipLaw }) {
+        seissol::kernels::FrictionSolver::Parameters parameters;
+        parameters.law = law;
+        parameters.rsF0 = 0.6;
+        parameters.rsA = 0.008;
+        parameters.rsB = 0.012;
+        parameters.rsSl0 = 0.02;
+        parameters.rsSr0 = 1.0e-6;
+        // steady sliding with the reference slip rate
+        real const initialShearStress[numberOfFaces] = {72.0e6, 72.0e6, 72.0e6};
+        initialize(parameters, initialShearStress);
+        evaluate(0.0);
+
+        seissol::initializers::Layer& interior = layer();
+        for (unsigned face = 0; face < numberOfFaces; ++face) {
+          for (unsigned point = 0; point < seissol::initializers::numberOfDRPoints; ++point) {
+            TS_ASSERT_DELTA(interior.var(dynRup.mu)[face][point], 0.6, 1.0e-4);
+            TS_ASSERT_DELTA(interior.var(dynRup.slipRate1)[face][point], 1.0e-6, 1.0e-8);
+            TS_ASSERT_DELTA(interior.var(dynRup.stateVariable)[face][point], 0.02 / 1.0e-6, 1.0e2);
+            TS_ASSERT(interior.var(dynRup.ruptureFront)[face][point]);
+          }
+        }
+      }
+    }
+};
@@ -166,6 +166,28 @@ public:
       800 * EPSILON);
   }
   
+  void testComputePwLFTimeIntegrals()
+  {
+    // same function as above, preceded by a vanishing function with a single sample
+    real l_samples[] = { 1.0,  3.0,  -1.0,  2.0,  2.5 };
+    unsigned l_numberOfSamples = sizeof(l_samples) / sizeof(real);
+    seissol::sourceterm::PiecewiseLinearFunctionTable l_table;
+    seissol::sourceterm::samplesToPiecewiseLinearFunctionTable(l_samples, 1, 0.0, 1.0, l_table);
+    seissol::sourceterm::samplesToPiecewiseLinearFunctionTable(l_samples, l_numberOfSamples, 1.0, 0.05, l_table);
+    PiecewiseLinearFunction1D l_pwlf;
+    seissol::sourceterm::samplesToPiecewiseLinearFunction1D(l_samples, l_numberOfSamples, 1.0, 0.05, &l_pwlf);
+
+    TS_ASSERT_EQUALS(l_table.numberOfFunctions(), 2);
+
+    double l_intervals[][2] = { {-2.0, 1.05}, {1.04, 1.06}, {1.1, 1.1}, {1.19, 100.0}, {-100.0, 100.0}, {1.01, 1.19}, {3.0, 4.0} };
+    for (auto const& l_interval : l_intervals) {
+      real l_integrals[2];
+      seissol::sourceterm::computePwLFTimeIntegrals(l_table, 0, 2, l_interval[0], l_interval[1], l_integrals);
+      TS_ASSERT_EQUALS(l_integrals[0], 0.0);
+      TS_ASSERT_DELTA(l_integrals[1], seissol::sourceterm::computePwLFTimeIntegral(l_pwlf, l_interval[0], l_interval[1]), 800 * EPSILON);
+    }
+  }
+  
   void addPointSourceToDOFs()
   {
     /// \todo Write a test if the function's implementation gets non-trivial.
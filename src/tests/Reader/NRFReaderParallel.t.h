@@ -0,0 +1,63 @@
+#include <cxxtest/TestSuite.h>
+
+#include <Initializer/PointMapper.h>
+#include <Parallel/MPI.h>
+#include <SourceTerm/NRFReader.h>
+#include <SourceTerm/NRF.h>
+
+#include <vector>
+
+namespace seissol {
+  namespace unit_test {
+    class NRFReaderParallelTestSuite;
+  }
+}
+
+class seissol::unit_test::NRFReaderParallelTestSuite : public CxxTest::TestSuite
+{
+public:
+  void testSourceRouting()
+  {
+#ifdef USE_MPI
+    int const rank = seissol::MPI::mpi.rank();
+
+    // the single source of the file lies at (0, 0, 2000), only the even ranks contain it
+    Eigen::Vector3d const offset = (rank % 2 == 0) ? Eigen::Vector3d(0.0, 0.0, 0.0) : Eigen::Vector3d(1.0e4, 0.0, 0.0);
+    Eigen::Vector3d const boundsMin = offset + Eigen::Vector3d(-100.0, -100.0, 1900.0);
+    Eigen::Vector3d const boundsMax = offset + Eigen::Vector3d(100.0, 100.0, 2100.0);
+
+    seissol::sourceterm::NRF nrf;
+    std::vector<unsigned long> sourceIds;
+    seissol::sourceterm::readNRF("Testing/source_loh.nrf", boundsMin, boundsMax, nrf, sourceIds);
+
+    seissol::sourceterm::NRF reference;
+    seissol::sourceterm::readNRF("Testing/source_loh.nrf", reference);
+
+    unsigned const expectedSources = (rank % 2 == 0) ? 1 : 0;
+    TS_ASSERT_EQUALS(nrf.source, expectedSources);
+    TS_ASSERT_EQUALS(sourceIds.size(), expectedSources);
+    for (unsigned source = 0; source < nrf.source; ++source) {
+      unsigned long const id = sourceIds[source];
+      TS_ASSERT_EQUALS(id, 0ul);
+      TS_ASSERT_EQUALS(nrf.centres[source], reference.centres[id]);
+      TS_ASSERT_EQUALS(nrf.subfaults[source].area, reference.subfaults[id].area);
+      TS_ASSERT_EQUALS(nrf.subfaults[source].normal, reference.subfaults[id].normal);
+      for (unsigned sr = 0; sr < 3; ++sr) {
+        unsigned const numberOfSamples = nrf.sroffsets[source+1][sr] - nrf.sroffsets[source][sr];
+        TS_ASSERT_EQUALS(numberOfSamples, reference.sroffsets[id+1][sr] - reference.sroffsets[id][sr]);
+        for (unsigned sample = 0; sample < numberOfSamples; ++sample) {
+          TS_ASSERT_EQUALS(nrf.sliprates[sr][nrf.sroffsets[source][sr] + sample],
+                           reference.sliprates[sr][reference.sroffsets[id][sr] + sample]);
+        }
+      }
+    }
+
+    // all even ranks contain the source, rank 0 keeps it
+    std::vector<short> contained(nrf.source, 1);
+    seissol::initializers::cleanDoubles(contained.data(), sourceIds.data(), nrf.source);
+    for (unsigned source = 0; source < nrf.source; ++source) {
+      TS_ASSERT_EQUALS(contained[source], (rank == 0) ? 1 : 0);
+    }
+#endif // USE_MPI
+  }
+};
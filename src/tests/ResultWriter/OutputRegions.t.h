@@ -0,0 +1,116 @@
+#include <cxxtest/TestSuite.h>
+
+#include "tests/Geometry/MockReader.h"
+#include "ResultWriter/OutputRegions.h"
+
+#include <cmath>
+
+namespace seissol {
+  namespace unit_test {
+    class OutputRegionsTestSuite;
+  }
+}
+
+class seissol::unit_test::OutputRegionsTestSuite : public CxxTest::TestSuite
+{
+  public:
+    void testParse()
+    {
+      using seissol::writer::OutputRegions;
+      auto regions = OutputRegions::parse("box:0,1,0,2,-3,0:2;fault:500:3:000000111;group:1,4:0;");
+      TS_ASSERT_EQUALS(regions.size(), 3);
+
+      TS_ASSERT(regions[0].type == OutputRegions::Type::Box);
+      TS_ASSERT_DELTA(regions[0].bounds[3], 2.0, 1.0e-12);
+      TS_ASSERT_DELTA(regions[0].bounds[4], -3.0, 1.0e-12);
+      TS_ASSERT_EQUALS(regions[0].refinement, 2);
+      TS_ASSERT(regions[0].isOutput(0));
+
+      TS_ASSERT(regions[1].type == OutputRegions::Type::Fault);
+      TS_ASSERT_DELTA(regions[1].distance, 500.0, 1.0e-12);
+      TS_ASSERT_EQUALS(regions[1].refinement, 3);
+      TS_ASSERT(!regions[1].isOutput(0));
+      TS_ASSERT(regions[1].isOutput(8));
+      TS_ASSERT(!regions[1].isOutput(9));
+
+      TS_ASSERT(regions[2].type == OutputRegions::Type::Group);
+      TS_ASSERT_EQUALS(regions[2].groups.size(), 2);
+      TS_ASSERT_EQUALS(regions[2].groups[1], 4);
+      TS_ASSERT_EQUALS(regions[2].refinement, 0);
+
+      TS_ASSERT(OutputRegions::parse("").empty());
+    }
+
+    void testDistanceToTriangle()
+    {
+      Eigen::Vector3d const a(0.0, 0.0, 0.0);
+      Eigen::Vector3d const b(1.0, 0.0, 0.0);
+      Eigen::Vector3d const c(0.0, 1.0, 0.0);
+      auto distance = [&](double x, double y, double z) {
+        return seissol::writer::OutputRegions::distanceToTriangle(Eigen::Vector3d(x, y, z), a, b, c);
+      };
+      // face, vertices and edges
+      TS_ASSERT_DELTA(distance(0.2, 0.2, -1.0), 1.0, 1.0e-12);
+      TS_ASSERT_DELTA(distance(2.0, 0.0, 0.0), 1.0, 1.0e-12);
+      TS_ASSERT_DELTA(distance(-1.0, -1.0, 0.0), std::sqrt(2.0), 1.0e-12);
+      TS_ASSERT_DELTA(distance(0.0, 3.0, 0.0), 2.0, 1.0e-12);
+      TS_ASSERT_DELTA(distance(0.5, -1.0, 0.0), 1.0, 1.0e-12);
+      TS_ASSERT_DELTA(distance(-1.0, 0.5, 0.0), 1.0, 1.0e-12);
+      TS_ASSERT_DELTA(distance(1.0, 1.0, 0.0), std::sqrt(0.5), 1.0e-12);
+    }
+
+    void testAssign()
+    {
+      using seissol::writer::OutputRegions;
+      seissol::GridMockReader mesh(4);
+      std::vector<Element> const& elements = mesh.getElements();
+      std::vector<Vertex> const& vertices = mesh.getVertices();
+
+      mesh.setMaterial(5, 4);
+      mesh.setMaterial(200, 4);
+
+      // Fault on the plane x = 2
+      for (unsigned e = 0; e < elements.size(); ++e) {
+        double centerX = 0.0;
+        for (unsigned v = 0; v < 4; ++v) {
+          centerX += 0.25 * vertices[elements[e].vertices[v]].coords[0];
+        }
+        for (int side = 0; side < 4; ++side) {
+          bool onFault = centerX < 2.0;
+          for (unsigned v = 0; v < 3; ++v) {
+            onFault = onFault && vertices[elements[e].vertices[MeshTools::FACE2NODES[side][v]]].coords[0] == 2.0;
+          }
+          if (onFault) {
+            mesh.addFault(e, side);
+          }
+        }
+      }
+
+      OutputRegions outputRegions(OutputRegions::parse("group:4:0;box:0,1,0,1,0,1:1;fault:0.5:3"));
+      std::vector<int> regions = outputRegions.assign(mesh);
+      TS_ASSERT_EQUALS(regions.size(), elements.size());
+
+      unsigned numFault = 0;
+      for (unsigned e = 0; e < elements.size(); ++e) {
+        bool inBox = false;
+        bool nearFault = false;
+        for (unsigned v = 0; v < 4; ++v) {
+          double const* coords = vertices[elements[e].vertices[v]].coords;
+          inBox = inBox || (coords[0] <= 1.0 && coords[1] <= 1.0 && coords[2] <= 1.0);
+          nearFault = nearFault || coords[0] == 2.0;
+        }
+
+        int expected = OutputRegions::NoRegion;
+        if (elements[e].material == 4) {
+          expected = 0;
+        } else if (inBox) {
+          expected = 1;
+        } else if (nearFault) {
+          expected = 2;
+          ++numFault;
+        }
+        TS_ASSERT_EQUALS(regions[e], expected);
+      }
+      TS_ASSERT(numFault > 0);
+    }
+};
@@ -0,0 +1,178 @@
+#include <cxxtest/TestSuite.h>
+
+#include <ResultWriter/ReceiverWriterExecutor.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace seissol {
+  namespace unit_test {
+    class ReceiverRecordsTestSuite;
+  }
+}
+
+class seissol::unit_test::ReceiverRecordsTestSuite : public CxxTest::TestSuite
+{
+  private:
+    static constexpr unsigned numberOfColumns = 4;
+
+    std::vector<char> buffer;
+    size_t bufferUsed;
+
+    //! Decodes an unsigned little endian integer, as struct.unpack_from('<I'/'<Q') in receivers2dat.py
+    static uint64_t readUnsigned(std::vector<unsigned char> const& data, size_t offset, unsigned bytes) {
+      uint64_t value = 0;
+      for (unsigned i = 0; i < bytes; ++i) {
+        value |= static_cast<uint64_t>(data[offset + i]) << (8 * i);
+      }
+      return value;
+    }
+
+    static double readDouble(std::vector<unsigned char> const& data, size_t offset) {
+      uint64_t bits = readUnsigned(data, offset, 8);
+      double value;
+      std::memcpy(&value, &bits, sizeof(double));
+      return value;
+    }
+
+    static double sample(unsigned pointId, unsigned row, unsigned column) {
+      return (column == 0) ? 0.25 * row : 100.0 * pointId + 10.0 * row + column + 0.125;
+    }
+
+    //! Appends a record to the buffer the way the receiver writer does
+    void addRecord(seissol::writer::ReceiverRecord::Type type, unsigned pointId, void const* payload, size_t size) {
+      buffer.resize(bufferUsed + sizeof(seissol::writer::ReceiverRecord) + size);
+      bufferUsed += seissol::writer::ReceiverRecord::write(&buffer[bufferUsed], type, pointId, payload, size);
+    }
+
+    void addSamples(unsigned pointId, unsigned firstRow, unsigned numberOfRows) {
+      std::vector<double> samples;
+      for (unsigned row = firstRow; row < firstRow + numberOfRows; ++row) {
+        for (unsigned column = 0; column < numberOfColumns; ++column) {
+          samples.push_back(sample(pointId, row, column));
+        }
+      }
+      addRecord(seissol::writer::ReceiverRecord::SAMPLES, pointId, samples.data(), samples.size() * sizeof(double));
+    }
+
+    //! Writes the records of the buffer to the file and resets the buffer
+    bool flush(FILE* file) {
+      uint64_t used = bufferUsed - sizeof(uint64_t);
+      std::memcpy(buffer.data(), &used, sizeof(uint64_t));
+      bool const written = seissol::writer::ReceiverWriterExecutor::appendRecords(file, buffer.data());
+      bufferUsed = sizeof(uint64_t);
+      return written;
+    }
+
+  public:
+    void setUp() {
+      buffer.assign(sizeof(uint64_t), 0);
+      bufferUsed = sizeof(uint64_t);
+    }
+
+    void testRecordHeader()
+    {
+      TS_ASSERT_EQUALS(16u, sizeof(seissol::writer::ReceiverRecord));
+      TS_ASSERT_EQUALS(0u, offsetof(seissol::writer::ReceiverRecord, type));
+      TS_ASSERT_EQUALS(4u, offsetof(seissol::writer::ReceiverRecord, pointId));
+      TS_ASSERT_EQUALS(8u, offsetof(seissol::writer::ReceiverRecord, size));
+    }
+
+    //! Writes the records of two synchronization points and decodes the file as receivers2dat.py does
+    void testRoundTrip()
+    {
+      FILE* file = tmpfile();
+      TS_ASSERT(file != nullptr);
+      if (file == nullptr) {
+        return;
+      }
+
+      // header records, the names are padded to 8 bytes
+      std::string variables = "\"Time\",\"u\",\"v\",\"w\"";
+      variables.resize((variables.size() + 7) / 8 * 8, ' ');
+      addRecord(seissol::writer::ReceiverRecord::VARIABLES, 0, variables.data(), variables.size());
+      unsigned const pointIds[2] = {3, 7};
+      for (unsigned pointId : pointIds) {
+        double coordinates[4] = {1.0 * pointId, -2.0 * pointId, 0.5, 0.0};
+        int64_t const rank = 5;
+        std::memcpy(&coordinates[3], &rank, sizeof(int64_t));
+        addRecord(seissol::writer::ReceiverRecord::POINT, pointId, coordinates, sizeof(coordinates));
+      }
+      TS_ASSERT(flush(file));
+
+      // the samples of two synchronization points; the magic number is only written once
+      addSamples(3, 0, 2);
+      addSamples(7, 0, 1);
+      TS_ASSERT(flush(file));
+      addSamples(3, 2, 3);
+      TS_ASSERT(flush(file));
+
+      // an empty flush does not change the file
+      TS_ASSERT(flush(file));
+
+      long const fileSize = ftell(file);
+      rewind(file);
+      std::vector<unsigned char> data(fileSize);
+      TS_ASSERT_EQUALS(static_cast<size_t>(fileSize), fread(data.data(), 1, fileSize, file));
+      fclose(file);
+
+      TS_ASSERT_EQUALS(0, std::memcmp(data.data(), "SEISRECV", 8));
+      TS_ASSERT_EQUALS(1u, readUnsigned(data, 8, 8));
+
+      std::string readVariables;
+      std::vector<unsigned> points;
+      std::vector<std::vector<double>> samples(8);
+      size_t offset = 16;
+      while (offset + 16 <= data.size()) {
+        uint64_t const type = readUnsigned(data, offset, 4);
+        unsigned const pointId = readUnsigned(data, offset + 4, 4);
+        uint64_t const size = readUnsigned(data, offset + 8, 8);
+        offset += 16;
+        TS_ASSERT_LESS_THAN(offset + size - 1, data.size());
+        TS_ASSERT_EQUALS(0u, size % 8);
+
+        switch (type) {
+          case seissol::writer::ReceiverRecord::VARIABLES:
+            readVariables.assign(data.begin() + offset, data.begin() + offset + size);
+            break;
+          case seissol::writer::ReceiverRecord::POINT:
+            TS_ASSERT_EQUALS(32u, size);
+            TS_ASSERT_EQUALS(1.0 * pointId, readDouble(data, offset));
+            TS_ASSERT_EQUALS(-2.0 * pointId, readDouble(data, offset + 8));
+            TS_ASSERT_EQUALS(0.5, readDouble(data, offset + 16));
+            TS_ASSERT_EQUALS(5u, readUnsigned(data, offset + 24, 8));
+            points.push_back(pointId);
+            break;
+          case seissol::writer::ReceiverRecord::SAMPLES:
+            TS_ASSERT_LESS_THAN(pointId, samples.size());
+            for (size_t value = 0; value < size / 8; ++value) {
+              samples[pointId].push_back(readDouble(data, offset + 8 * value));
+            }
+            break;
+          default:
+            TS_ASSERT(false);
+        }
+        offset += size;
+      }
+      TS_ASSERT_EQUALS(data.size(), offset);
+
+      TS_ASSERT_EQUALS(variables, readVariables);
+      TS_ASSERT_EQUALS(2u, points.size());
+      TS_ASSERT_EQUALS(3u, points[0]);
+      TS_ASSERT_EQUALS(7u, points[1]);
+
+      unsigned const numberOfRows[8] = {0, 0, 0, 5, 0, 0, 0, 1};
+      for (unsigned pointId = 0; pointId < 8; ++pointId) {
+        TS_ASSERT_EQUALS(numberOfRows[pointId] * numberOfColumns, samples[pointId].size());
+        for (unsigned row = 0; row < numberOfRows[pointId]; ++row) {
+          for (unsigned column = 0; column < numberOfColumns; ++column) {
+            TS_ASSERT_EQUALS(sample(pointId, row, column), samples[pointId][row * numberOfColumns + column]);
+          }
+        }
+      }
+    }
+};
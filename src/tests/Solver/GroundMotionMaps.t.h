@@ -0,0 +1,92 @@
+#include <cxxtest/TestSuite.h>
+
+#include "Solver/GroundMotionMaps.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace seissol {
+  namespace unit_test {
+    class GroundMotionMapsTestSuite;
+  }
+}
+
+class seissol::unit_test::GroundMotionMapsTestSuite : public CxxTest::TestSuite
+{
+  public:
+    void testStaticResponse()
+    {
+      // a constant ground acceleration displaces the oscillator by -a / omega^2, even for time steps much larger than
+      // the period
+      double const period = 0.5;
+      double const acceleration = 2.0;
+      for (double timeStepWidth : {0.001, 0.1, 50.0}) {
+        seissol::solver::GroundMotionMaps::Oscillator oscillator(period, seissol::solver::GroundMotionMaps::Damping, timeStepWidth);
+        double x = 0.0, v = 0.0;
+        for (unsigned step = 0; step * timeStepWidth < 100.0; ++step) {
+          oscillator.update(acceleration, x, v);
+        }
+        TS_ASSERT_DELTA(oscillator.omega2 * x, -acceleration, 1.0e-8);
+        TS_ASSERT_DELTA(v, 0.0, 1.0e-8);
+      }
+    }
+
+    void testResonance()
+    {
+      // at resonance, the steady state amplitude of the pseudo-spectral acceleration is 1 / (2 zeta)
+      double const period = 1.0;
+      double const omega = 2.0 * M_PI / period;
+      unsigned const stepsPerPeriod = 200;
+      double const timeStepWidth = period / stepsPerPeriod;
+      seissol::solver::GroundMotionMaps::Oscillator oscillator(period, seissol::solver::GroundMotionMaps::Damping, timeStepWidth);
+
+      double x = 0.0, v = 0.0, sa = 0.0;
+      for (unsigned step = 0; step < 60 * stepsPerPeriod; ++step) {
+        double const t = (step + 0.5) * timeStepWidth;
+        oscillator.update(std::sin(omega * t), x, v);
+        if (step >= 50 * stepsPerPeriod) {
+          sa = std::max(sa, oscillator.omega2 * std::abs(x));
+        }
+      }
+      TS_ASSERT_DELTA(sa, 0.5 / seissol::solver::GroundMotionMaps::Damping, 0.01 * sa);
+    }
+
+    void testConstantVelocity()
+    {
+      // a constant velocity (e.g. after a restart) is no ground acceleration, also in the first time step
+      seissol::solver::GroundMotionMaps maps;
+      maps.setPeriods({0.5, 2.0});
+      maps.allocate(1);
+      double const timeStepWidth = 0.01;
+      std::vector<seissol::solver::GroundMotionMaps::Oscillator> oscillators;
+      for (double period : {0.5, 2.0}) {
+        oscillators.emplace_back(period, seissol::solver::GroundMotionMaps::Damping, timeStepWidth);
+      }
+
+      double const velocity[2] = {1.0, -2.0};
+      double const displacement[2] = {0.5, 0.0};
+      for (unsigned step = 0; step < 2; ++step) {
+        maps.update(0, velocity, displacement, timeStepWidth, oscillators);
+      }
+      TS_ASSERT_EQUALS(maps.map(seissol::solver::GroundMotionMaps::PGA)[0], 0.0);
+      TS_ASSERT_DELTA(maps.map(seissol::solver::GroundMotionMaps::PGV)[0], std::sqrt(5.0), 1.0e-12);
+      TS_ASSERT_DELTA(maps.map(seissol::solver::GroundMotionMaps::PGD)[0], 0.5, 1.0e-12);
+      TS_ASSERT_EQUALS(maps.map(seissol::solver::GroundMotionMaps::SA0)[0], 0.0);
+      TS_ASSERT_EQUALS(maps.map(seissol::solver::GroundMotionMaps::SA0 + 1)[0], 0.0);
+
+      // a change of the velocity is an acceleration
+      double const newVelocity[2] = {1.0, -1.0};
+      maps.update(0, newVelocity, displacement, timeStepWidth, oscillators);
+      TS_ASSERT_DELTA(maps.map(seissol::solver::GroundMotionMaps::PGA)[0], 1.0 / timeStepWidth, 1.0e-9);
+    }
+
+    void testParsePeriods()
+    {
+      auto periods = seissol::solver::GroundMotionMaps::parsePeriods("0.3,1,3.5");
+      TS_ASSERT_EQUALS(periods.size(), 3);
+      TS_ASSERT_DELTA(periods[0], 0.3, 1.0e-12);
+      TS_ASSERT_DELTA(periods[1], 1.0, 1.0e-12);
+      TS_ASSERT_DELTA(periods[2], 3.5, 1.0e-12);
+      TS_ASSERT(seissol::solver::GroundMotionMaps::parsePeriods("").empty());
+    }
+};